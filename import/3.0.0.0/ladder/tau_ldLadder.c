@@ -3099,19 +3099,9 @@ TRDP_ERR_T tau_ldTerminate (
         pComIdDsIdMap   = NULL;
         numComId        = 0;
     }
-    /* Free Dataset */
+    /* Free Dataset, released with the document */
     if (apDataset)
     {
-        /* Free dataset structures */
-        pTRDP_DATASET_T pDataset;
-        UINT32          i;
-        for (i = numDataset - 1; i > 0; i--)
-        {
-            pDataset = apDataset[i];
-            vos_memFree(pDataset);
-        }
-        /*  Free array of pointers to dataset structures    */
-        vos_memFree(apDataset);
         apDataset   = NULL;
         numDataset  = 0;
     }
@@ -33,6 +33,7 @@
  */
 
 #include "trdp_types.h"
+#include "vos_thread.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -49,6 +50,8 @@ extern "C" {
 #endif
 
 #define TAU_MAX_NO_CACHE_ENTRY      50u
+#define TAU_DNR_HASH_SIZE           64u     /**< Number of hash buckets of the cache, power of 2                */
+#define TAU_DNR_NEGATIVE_TTL        10u     /**< Seconds an unresolvable URI is not asked for again             */
 
 /***********************************************************************************************************************
  * TYPEDEFS
@@ -75,6 +78,12 @@ typedef struct tau_dnr_cache
     UINT32          etbTopoCnt;
     UINT32          opTrnTopoCnt;
     BOOL8           fixedEntry;
+    UINT8           state;                          /**< unresolved, pending, resolved or failed    */
+    BOOL8           queued;                         /**< waiting for the resolver thread            */
+    UINT16          hashNext;                       /**< next entry in the same hash bucket         */
+    UINT16          lruPrev;                        /**< more recently used entry                   */
+    UINT16          lruNext;                        /**< less recently used entry                   */
+    VOS_TIMEVAL_T   retryTime;                      /**< failed entries: do not ask again before    */
 } TAU_DNR_ENTRY_T;
 
 typedef struct tau_dnr_data
@@ -85,6 +94,14 @@ typedef struct tau_dnr_data
     TRDP_DNR_OPTS_T useTCN_DNS;                     /**< how to use TCN DNR                         */
     UINT32          noOfCachedEntries;              /**< no of items currently in the cache         */
     TAU_DNR_ENTRY_T cache[TAU_MAX_NO_CACHE_ENTRY];  /**< if != 0 use TCN DNS as resolver            */
+    UINT16          hashTable[TAU_DNR_HASH_SIZE];   /**< first entry of each hash bucket            */
+    UINT16          lruHead;                        /**< most recently used (not fixed) entry       */
+    UINT16          lruTail;                        /**< least recently used entry, evicted first   */
+    VOS_MUTEX_T     mutex;                          /**< protects the cache                         */
+    VOS_SEMA_T      resolverSema;                   /**< wakes the resolver thread                  */
+    VOS_THREAD_T    resolverThread;                 /**< resolves for tau_uri2AddrNoWait()          */
+    BOOL8           resolverStop;                   /**< resolver thread shall terminate            */
+    BOOL8           resolverRunning;                /**< resolver thread was started and runs       */
 } TAU_DNR_DATA_T;
     
 /***********************************************************************************************************************
@@ -158,6 +175,9 @@ EXT_DECL  TRDP_IP_ADDR_T tau_getOwnAddr (
  *  Receives a URI as input variable and translates this URI to an IP-Address. 
  *  The URI may specify either a unicast or a multicast IP-Address.
  *  The caller may specify a topographic counter, which will be checked.
+ *  On a cache miss the resolver is asked and the call waits for its reply. If another thread is already waiting
+ *  for the same URI, the reply is shared. URIs which could not be resolved are not asked for again for
+ *  TAU_DNR_NEGATIVE_TTL seconds.
  * 
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[out]     pAddr           Pointer to return the IP address
@@ -165,6 +185,7 @@ EXT_DECL  TRDP_IP_ADDR_T tau_getOwnAddr (
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_UNRESOLVED_ERR could not be resolved
  *
  */
 EXT_DECL TRDP_ERR_T tau_uri2Addr (
@@ -176,6 +197,30 @@ EXT_DECL TRDP_IP_ADDR_T tau_ipFromURI (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_URI_HOST_T     uri);
 
+/**********************************************************************************************************************/
+/**    Function to convert a URI to an IP address without waiting for the resolver.
+ *  Same as tau_uri2Addr(), but never sends a request itself. If the address is not cached or out of date, the URI
+ *  is handed to a resolver thread and TRDP_BLOCK_ERR is returned; call again later. Concurrent requests for the
+ *  same URI are coalesced. URIs which could not be resolved are not asked for again for TAU_DNR_NEGATIVE_TTL
+ *  seconds, TRDP_UNRESOLVED_ERR is returned meanwhile.
+ *  Suitable for the communication thread, e.g. for URI addressed telegrams.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession().
+ *  @param[out]     pAddr               Pointer to return the IP address
+ *  @param[in]      pUri                Pointer to a URI or an IP Address string, NULL==own URI
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_BLOCK_ERR      resolution in progress, try again later
+ *  @retval         TRDP_UNRESOLVED_ERR could not be resolved
+ *  @retval         TRDP_THREAD_ERR     resolver thread could not be started
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrNoWait (
+    TRDP_APP_SESSION_T   appHandle,
+    TRDP_IP_ADDR_T      *pAddr,
+    const TRDP_URI_T     pUri);
+
 /**********************************************************************************************************************/
 /**    Function to convert an IP address to a URI.
  *  Receives an IP-Address and translates it into the host part of the corresponding URI.
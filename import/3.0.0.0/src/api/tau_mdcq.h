@@ -0,0 +1,202 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_mdcq.h
+ *
+ * @brief           TRDP utility interface definitions
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - MD request completion queue
+ *
+ *                  Requests are submitted tagged with a user token. Replies, time-outs and errors are not handed
+ *                  to a callback, but queued as completions inside tlc_process(). Any application thread may reap
+ *                  them in batches, so many request/reply round trips can be in flight concurrently without
+ *                  serialising the application on the TRDP thread.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+#ifndef TAU_MDCQ_H
+#define TAU_MDCQ_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if MD_SUPPORT
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#ifndef TAU_MDCQ_MAX_IN_FLIGHT
+#define TAU_MDCQ_MAX_IN_FLIGHT  1024u   /**< Upper limit of concurrently pending requests per completion queue  */
+#endif
+
+#ifndef TAU_MDCQ_MAX_QUEUES
+#define TAU_MDCQ_MAX_QUEUES     16u     /**< Upper limit of completion queues existing at the same time         */
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Opaque handle of a completion queue */
+typedef struct TAU_MDCQ *TAU_MDCQ_T;
+
+/** One completion as returned by tau_mdcqReap() */
+typedef struct
+{
+    const void      *pToken;        /**< user token given with tau_mdcqRequest()                                    */
+    TRDP_ERR_T      resultCode;     /**< TRDP_NO_ERR for a reply, time-out or error code otherwise                  */
+    BOOL8           isFinal;        /**< TRUE if this is the last completion of the request                         */
+    TRDP_MD_INFO_T  msgInfo;        /**< message info as it would have been passed to a callback (pUserRef = token) */
+    UINT8           *pData;         /**< copy of the reply data (NULL if none), release with tau_mdcqRelease()      */
+    UINT32          dataSize;       /**< size of the reply data                                                     */
+} TAU_MDCQ_ENTRY_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Create a completion queue for MD requests of a session.
+ *
+ *  @param[in]      appHandle           Application handle
+ *  @param[in]      maxInFlight         Max. number of requests pending at the same time (1...TAU_MDCQ_MAX_IN_FLIGHT)
+ *  @param[out]     pCq                 Pointer to the completion queue handle
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        out of memory, or TAU_MDCQ_MAX_QUEUES queues exist already
+ *  @retval         TRDP_SEMA_ERR       semaphore or mutex could not be created
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqCreate (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              maxInFlight,
+    TAU_MDCQ_T          *pCq);
+
+/**********************************************************************************************************************/
+/**    Destroy a completion queue.
+ *  Requests still pending, and Mq sessions still awaiting their confirmation, are aborted. Completions not yet
+ *  reaped are discarded. Must not be called from within tlc_process() (i.e. from a TRDP callback).
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqDestroy (
+    TAU_MDCQ_T cq);
+
+/**********************************************************************************************************************/
+/**    Submit a MD request, its reply will be queued as completion.
+ *  The parameters are the same as for tlm_request(), the callback is replaced by the user token.
+ *  May be called from any thread.
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *  @param[in]      pToken              user token returned with each completion of this request
+ *  @param[out]     pSessionId          return session ID, may be NULL
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      destIpAddr          where to send the packet to
+ *  @param[in]      pktFlags            OPTION: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_TCP
+ *  @param[in]      numReplies          number of expected replies, 0 if unknown
+ *  @param[in]      replyTimeout        timeout for reply, 0 for the session default
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pData               pointer to packet data / dataset
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI
+ *  @param[in]      destURI             only functional group of destination URI
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_QUEUE_FULL_ERR maxInFlight requests are already pending
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqRequest (
+    TAU_MDCQ_T              cq,
+    const void              *pToken,
+    TRDP_UUID_T             *pSessionId,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    UINT32                  numReplies,
+    UINT32                  replyTimeout,
+    const TRDP_COM_PARAM_T  *pSendParam,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI);
+
+/**********************************************************************************************************************/
+/**    Reap completions.
+ *  Up to maxEntries completions are returned in submission order of their events. If none is available, the
+ *  call waits up to timeout us for the first one. May be called from any thread.
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *  @param[out]     pEntries            Array receiving the completions
+ *  @param[in]      maxEntries          Size of the array
+ *  @param[in]      timeout             Max. time in us to wait, 0 = don't wait, VOS_SEMA_WAIT_FOREVER
+ *  @param[out]     pNumEntries         Number of completions returned
+ *
+ *  @retval         TRDP_NO_ERR         no error, at least one completion returned
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_TIMEOUT_ERR    no completion available in time
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqReap (
+    TAU_MDCQ_T          cq,
+    TAU_MDCQ_ENTRY_T    *pEntries,
+    UINT32              maxEntries,
+    UINT32              timeout,
+    UINT32              *pNumEntries);
+
+/**********************************************************************************************************************/
+/**    Release the reply data of reaped completions.
+ *
+ *  @param[in]      pEntries            Array of completions returned by tau_mdcqReap()
+ *  @param[in]      numEntries          Number of completions
+ */
+EXT_DECL void tau_mdcqRelease (
+    TAU_MDCQ_ENTRY_T    *pEntries,
+    UINT32              numEntries);
+
+/**********************************************************************************************************************/
+/**    Return the number of submitted requests which have not yet reported their final completion.
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *
+ *  @retval         number of requests in flight
+ */
+EXT_DECL UINT32 tau_mdcqInFlight (
+    TAU_MDCQ_T cq);
+
+#endif /* MD_SUPPORT */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_MDCQ_H */
@@ -0,0 +1,219 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_tstore.h
+ *
+ * @brief           TRDP utility interface definitions
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - shared memory traffic store
+ *
+ *                  One process (the owner) runs the TRDP session and writes the latest payload of each telegram
+ *                  into a named shared memory area, e.g. from its PD callback (tau_tsPdCallback) or after tlp_get().
+ *                  Any number of local processes attach to that area read-only and read the telegrams without
+ *                  opening sockets themselves, so N consumers cost one receive.
+ *                  Every slot carries its own sequence counter (seqlock): the owner never waits for readers,
+ *                  readers retry if the slot was written while they copied it. There is no store-wide lock.
+ *
+ *                  The store is fixed in size: the number of slots and the maximum payload per slot are set when
+ *                  it is created, slots are added by the owner only and never removed. If the owner closes the
+ *                  store or restarts, readers get TRDP_NOINIT_ERR and have to attach again.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+#ifndef TAU_TSTORE_H
+#define TAU_TSTORE_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_TS_VERSION      1u      /**< Version of the shared memory layout, other versions are rejected      */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Opaque handle of an opened (owner) or attached (reader) traffic store */
+typedef struct TAU_TSTORE *TAU_TSTORE_T;
+
+/** Status of a slot, returned with its payload */
+typedef struct
+{
+    UINT32      comId;          /**< ComId of the telegram                                                      */
+    UINT32      srcIpAddr;      /**< source IP address, 0 for any                                               */
+    TRDP_ERR_T  resultCode;     /**< result of the last update, e.g. TRDP_TIMEOUT_ERR                           */
+    UINT32      seqCount;       /**< sequence counter of the last received telegram                            */
+    UINT32      updates;        /**< number of updates written by the owner                                     */
+    TRDP_TIME_T timeStamp;      /**< time of the last update (vos_getTime() time base)                          */
+} TAU_TS_INFO_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/** Create a traffic store (owner).
+ *  Creates the shared memory area with the given name or takes over an existing one (left behind by a crashed
+ *  owner); its contents are cleared.
+ *
+ *  @param[out]     pStore          Pointer to returned handle
+ *  @param[in]      pName           Name of the shared memory area (e.g. "/trdp_ts")
+ *  @param[in]      noOfSlots       Maximum number of telegrams
+ *  @param[in]      maxDataSize     Maximum payload size of a telegram (<= TRDP_MAX_PD_DATA_SIZE)
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MEM_ERR    shared memory could not be created
+ */
+EXT_DECL TRDP_ERR_T tau_tsCreate (
+    TAU_TSTORE_T    *pStore,
+    const CHAR8     *pName,
+    UINT32          noOfSlots,
+    UINT32          maxDataSize);
+
+/**********************************************************************************************************************/
+/** Attach read-only to a traffic store (reader).
+ *
+ *  @param[out]     pStore          Pointer to returned handle
+ *  @param[in]      pName           Name of the shared memory area used by the owner
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_IO_ERR     store does not exist
+ *  @retval         TRDP_INIT_ERR   store not yet initialized by its owner or of a different layout
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_tsAttach (
+    TAU_TSTORE_T    *pStore,
+    const CHAR8     *pName);
+
+/**********************************************************************************************************************/
+/** Close a traffic store.
+ *  The owner invalidates and removes the store, attached readers get TRDP_NOINIT_ERR from then on.
+ *  A reader just detaches.
+ *
+ *  @param[in]      store           Handle returned by tau_tsCreate() or tau_tsAttach()
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ */
+EXT_DECL TRDP_ERR_T tau_tsClose (
+    TAU_TSTORE_T store);
+
+/**********************************************************************************************************************/
+/** Add a slot for a telegram (owner only).
+ *  Adding a telegram which is already stored returns its slot.
+ *
+ *  @param[in]      store           Handle returned by tau_tsCreate()
+ *  @param[in]      comId           ComId of the telegram
+ *  @param[in]      srcIpAddr       Source IP address, 0 for any
+ *  @param[out]     pSlot           Pointer to returned slot index
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error or not the owner
+ *  @retval         TRDP_MEM_ERR    all slots in use
+ */
+EXT_DECL TRDP_ERR_T tau_tsAddSlot (
+    TAU_TSTORE_T    store,
+    UINT32          comId,
+    UINT32          srcIpAddr,
+    UINT32          *pSlot);
+
+/**********************************************************************************************************************/
+/** Find the slot of a telegram.
+ *
+ *  @param[in]      store           Traffic store handle
+ *  @param[in]      comId           ComId of the telegram
+ *  @param[in]      srcIpAddr       Source IP address, 0 matches the first slot of the ComId
+ *  @param[out]     pSlot           Pointer to returned slot index
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_COMID_ERR  telegram not stored
+ *  @retval         TRDP_NOINIT_ERR store was closed by its owner
+ */
+EXT_DECL TRDP_ERR_T tau_tsFindSlot (
+    TAU_TSTORE_T    store,
+    UINT32          comId,
+    UINT32          srcIpAddr,
+    UINT32          *pSlot);
+
+/**********************************************************************************************************************/
+/** Write the latest state of a telegram (owner only).
+ *  Never blocks: readers copying the slot meanwhile retry.
+ *
+ *  @param[in]      store           Handle returned by tau_tsCreate()
+ *  @param[in]      slot            Slot index
+ *  @param[in]      pInfo           Receive info (result code, sequence counter), NULL for TRDP_NO_ERR
+ *  @param[in]      pData           Payload, NULL to update the result code only and keep the last payload
+ *  @param[in]      dataSize        Payload size
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error, not the owner or payload too big
+ */
+EXT_DECL TRDP_ERR_T tau_tsWrite (
+    TAU_TSTORE_T            store,
+    UINT32                  slot,
+    const TRDP_PD_INFO_T    *pInfo,
+    const UINT8             *pData,
+    UINT32                  dataSize);
+
+/**********************************************************************************************************************/
+/** Read the latest state of a telegram.
+ *  Returns a consistent copy of the slot, retrying while the owner writes it.
+ *
+ *  @param[in]      store           Traffic store handle
+ *  @param[in]      slot            Slot index
+ *  @param[out]     pInfo           Pointer to returned slot status, may be NULL
+ *  @param[out]     pData           Pointer to payload buffer, may be NULL
+ *  @param[in,out]  pDataSize       In: size of the buffer, out: payload size (may be NULL if pData is NULL)
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error or buffer too small (*pDataSize holds the needed size)
+ *  @retval         TRDP_NOINIT_ERR store was closed by its owner
+ *  @retval         TRDP_BLOCK_ERR  slot is permanently being written (owner died while writing)
+ */
+EXT_DECL TRDP_ERR_T tau_tsRead (
+    TAU_TSTORE_T    store,
+    UINT32          slot,
+    TAU_TS_INFO_T   *pInfo,
+    UINT8           *pData,
+    UINT32          *pDataSize);
+
+/**********************************************************************************************************************/
+/** PD callback writing received telegrams into the traffic store.
+ *  Pass the owner's store handle as pUserRef of the subscription and add a slot for each subscribed telegram;
+ *  telegrams without a slot are ignored.
+ *
+ *  @param[in]      pRefCon         Session context (unused)
+ *  @param[in]      appHandle       Session handle (unused)
+ *  @param[in]      pMsg            Receive info, pUserRef is the handle returned by tau_tsCreate()
+ *  @param[in]      pData           Payload
+ *  @param[in]      dataSize        Payload size
+ */
+EXT_DECL void tau_tsPdCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_TSTORE_H */
@@ -55,6 +55,8 @@ extern "C" {
  * TYPEDEFS
  */
 
+/** Immutable copy of the consist information and its indexes, see tau_acquireTTISnapshot() */
+typedef struct TAU_TTI_SNAPSHOT TAU_TTI_SNAPSHOT_T;
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -412,6 +414,88 @@ EXT_DECL UINT8 tau_getOwnOpCstNo (
 EXT_DECL UINT8 tau_getOwnTrnCstNo (
     TRDP_APP_SESSION_T appHandle);
 
+/**********************************************************************************************************************/
+/*    Snapshot access                                                                                                 */
+/**********************************************************************************************************************/
+
+/*
+    The TTI keeps an immutable snapshot of the received consist information, indexed by consist UUID and label.
+    A new snapshot replaces the current one whenever the TTDB changes (inauguration, topocount change, new consist
+    info). Readers do not take a lock and can use a snapshot from any thread, e.g. web server threads, as long as
+    they hold it:
+
+        const TAU_TTI_SNAPSHOT_T *pSnap = tau_acquireTTISnapshot(appHandle);
+        const TRDP_CONSIST_INFO_T *pCst = tau_findCstInfoByLabel(pSnap, "cst01");
+        ...
+        tau_releaseTTISnapshot(appHandle, pSnap);
+
+    A snapshot only contains consist infos which have been received already, use tau_getCstInfo() or
+    tau_getStaticCstInfo() to request missing ones. All snapshots must be released before tau_deInitTTI().
+ */
+
+/**********************************************************************************************************************/
+/**    Get the current TTI snapshot.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *
+ *  @retval         pointer to the snapshot, must be released with tau_releaseTTISnapshot()
+ *  @retval         NULL                TTI not initialised
+ */
+EXT_DECL const TAU_TTI_SNAPSHOT_T *tau_acquireTTISnapshot (
+    TRDP_APP_SESSION_T appHandle);
+
+/**********************************************************************************************************************/
+/**    Release a TTI snapshot.
+ *  The snapshot and the consist infos found in it must not be used afterwards.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ */
+EXT_DECL void tau_releaseTTISnapshot (
+    TRDP_APP_SESSION_T          appHandle,
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot);
+
+/**********************************************************************************************************************/
+/**    Get the topocounts a snapshot was taken with.
+ *
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ *  @param[out]     pEtbTopoCnt         Returns the ETB topocount, may be NULL
+ *  @param[out]     pOpTrnTopoCnt       Returns the operational train topocount, may be NULL
+ *
+ *  @retval         number of consist infos in the snapshot
+ */
+EXT_DECL UINT32 tau_getTTISnapshotInfo (
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot,
+    UINT32                      *pEtbTopoCnt,
+    UINT32                      *pOpTrnTopoCnt);
+
+/**********************************************************************************************************************/
+/**    Find a consist info by UUID in a snapshot.
+ *
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ *  @param[in]      cstUUID             UUID of the consist, NULL means own consist
+ *
+ *  @retval         pointer to the consist info, valid until the snapshot is released
+ *  @retval         NULL                not found
+ */
+EXT_DECL const TRDP_CONSIST_INFO_T *tau_findCstInfoByUUID (
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot,
+    const TRDP_UUID_T           cstUUID);
+
+/**********************************************************************************************************************/
+/**    Find a consist info by label in a snapshot.
+ *  The label is compared case insensitive.
+ *
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ *  @param[in]      cstLabel            Label of the consist, NULL means own consist
+ *
+ *  @retval         pointer to the consist info, valid until the snapshot is released
+ *  @retval         NULL                not found
+ */
+EXT_DECL const TRDP_CONSIST_INFO_T *tau_findCstInfoByLabel (
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot,
+    const TRDP_LABEL_T          cstLabel);
+
 #endif
 
 #endif 
@@ -338,6 +338,7 @@ EXT_DECL TRDP_ERR_T tau_prepareXmlMem (
 
 /**********************************************************************************************************************/
 /**    Free all the memory allocated by tau_prepareXmlDoc
+ *  This includes the telegram, dataset and service configurations read from the document.
  *
  *
  *  @param[in]        pDocHnd           Handle of the parsed XML file
@@ -376,7 +377,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
 
 /**********************************************************************************************************************/
 /**    Read the interface relevant telegram parameters (except data set configuration) out of the configuration file .
- *
+ *  The telegram configurations are allocated from the document and stay valid until tau_freeXmlDoc.
  *
  *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
  *  @param[in]      pIfName           Interface name
@@ -403,7 +404,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
 
 /**********************************************************************************************************************/
 /**    Function to read the DataSet configuration out of the XML configuration file.
- *
+ *  The DataSet configuration is allocated from the document and stays valid until tau_freeXmlDoc.
  *
  *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
  *  @param[out]     pNumComId         Pointer to the number of entries in the ComId DatasetId mapping list
@@ -427,7 +428,8 @@ EXT_DECL TRDP_ERR_T tau_readXmlDatasetConfig (
 /**********************************************************************************************************************/
 /**    Function to free the memory for the DataSet configuration
  *
- *  Free the memory for the DataSet configuration which was allocated when parsing the XML configuration file.
+ *  The DataSet configuration is allocated from the document (or cache) it was read from and is released with it
+ *  by tau_freeXmlDoc (tau_closeXmlCache), nothing is freed here.
  *
  *
  *  @param[in]      numComId            The number of entries in the ComId DatasetId mapping list
@@ -446,6 +448,8 @@ EXT_DECL void tau_freeXmlDatasetConfig (
 
 /**********************************************************************************************************************/
 /**    Free array of telegram configurations allocated by tau_readXmlInterfaceConfig
+ *  The telegram configurations are allocated from the document (or cache) they were read from and are released
+ *  with it by tau_freeXmlDoc (tau_closeXmlCache), nothing is freed here.
  *
  *  @param[in]      numExchgPar       Number of telegram configurations in the array
  *  @param[in]      pExchgPar         Pointer to array of telegram configurations
@@ -457,7 +461,7 @@ EXT_DECL void tau_freeTelegrams (
 
 /**********************************************************************************************************************/
 /**    Function to read the TRDP device service definitions out of the XML configuration file.
- *  The user must release the memory for pServiceDefs (using vos_memFree)
+ *  The service definitions are allocated from the document and released by tau_freeXmlDoc.
  *
  *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
  *  @param[out]     pNumServiceDefs   Number of defined Services
@@ -514,7 +518,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedDeviceConfig(
 /**********************************************************************************************************************/
 /**    Read the interface relevant mapped telegram parameters for a particular host and it's interface
  *  out of the configuration file .
- *
+ *  The telegram configurations are allocated from the document and stay valid until tau_freeXmlDoc.
  *
  *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
  *  @param[in]      pHostname         Host name
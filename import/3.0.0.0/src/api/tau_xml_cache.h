@@ -0,0 +1,178 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_xml_cache.h
+ *
+ * @brief           TRDP utility interface definitions
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - precompiled binary cache of the xml configuration
+ *
+ *                  The device, interface and dataset configuration of an XML file is compiled once into a
+ *                  relocatable binary image (offsets instead of pointers, versioned, checksummed) and stored next
+ *                  to the XML file. Later starts map that image and read the configuration without running the
+ *                  XML tokenizer. The image records a hash of the XML source; if the XML was changed, the cache
+ *                  is silently recompiled from it.
+ *                  The tau_readCached...() functions return the same structures as their tau_readXml...()
+ *                  counterparts; telegram and dataset configurations are allocated from the cache and released by
+ *                  tau_closeXmlCache(), the device configuration is released with vos_memFree() as before.
+ *                  Service definitions and mapped devices are not part of the cache, use tau_xml.h for them.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+#ifndef TAU_XML_CACHE_H
+#define TAU_XML_CACHE_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "tau_xml.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_XML_CACHE_VERSION   1u      /**< Version of the binary image layout, older images are recompiled  */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Opaque handle of a loaded configuration cache */
+typedef struct TAU_XML_CACHE *TAU_XML_CACHE_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Open the configuration cache of an XML file.
+ *  The XML file is hashed and compared to the hash stored in the cache file. If the cache file is valid and up to
+ *  date it is mapped into memory. Otherwise the XML file is parsed, compiled and the cache file is (re-)written;
+ *  if writing fails, the compiled image is used from memory.
+ *
+ *  @param[in]      pXmlFileName        Path of the XML configuration file
+ *  @param[in]      pCacheFileName      Path of the cache file (e.g. "<config>.xml.bin")
+ *  @param[out]     pCache              Pointer to the returned cache handle
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, XML file not readable
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_IO_ERR         XML parsing failed
+ */
+EXT_DECL TRDP_ERR_T tau_openXmlCache (
+    const CHAR8         *pXmlFileName,
+    const CHAR8         *pCacheFileName,
+    TAU_XML_CACHE_T     *pCache);
+
+/**********************************************************************************************************************/
+/**    Release a configuration cache opened by tau_openXmlCache().
+ *  Releases the telegram and dataset configurations read from it, the device configuration stays valid.
+ *
+ *  @param[in]      cache               Cache handle
+ */
+EXT_DECL void tau_closeXmlCache (
+    TAU_XML_CACHE_T cache);
+
+/**********************************************************************************************************************/
+/**    Tell if the configuration was loaded from an up-to-date cache file.
+ *
+ *  @param[in]      cache               Cache handle
+ *
+ *  @retval         TRUE                loaded from the cache file
+ *  @retval         FALSE               compiled from the XML file
+ */
+EXT_DECL BOOL8 tau_isXmlCacheHit (
+    TAU_XML_CACHE_T cache);
+
+/**********************************************************************************************************************/
+/**    Read the TRDP device configuration parameters from the cache.
+ *  Same as tau_readXmlDeviceConfig().
+ *
+ *  @param[in]      cache             Cache handle
+ *  @param[out]     pMemConfig        Memory configuration
+ *  @param[out]     pDbgConfig        Debug printout configuration for application use
+ *  @param[out]     pNumComPar        Number of configured com parameters
+ *  @param[out]     ppComPar          Pointer to array of com parameters
+ *  @param[out]     pNumIfConfig      Number of configured interfaces
+ *  @param[out]     ppIfConfig        Pointer to an array of interface parameter sets
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      provided buffer to small
+ */
+EXT_DECL TRDP_ERR_T tau_readCachedDeviceConfig (
+    TAU_XML_CACHE_T             cache,
+    TRDP_MEM_CONFIG_T           *pMemConfig,
+    TRDP_DBG_CONFIG_T           *pDbgConfig,
+    UINT32                      *pNumComPar,
+    TRDP_COM_PAR_T              * *ppComPar,
+    UINT32                      *pNumIfConfig,
+    TRDP_IF_CONFIG_T            * *ppIfConfig);
+
+/**********************************************************************************************************************/
+/**    Read the configuration of one interface from the cache.
+ *  Same as tau_readXmlInterfaceConfig().
+ *
+ *  @param[in]      cache             Cache handle
+ *  @param[in]      pIfName           Interface name
+ *  @param[out]     pProcessConfig    TRDP main process configuration
+ *  @param[out]     pPdConfig         PD default configuration
+ *  @param[out]     pMdConfig         MD default configuration
+ *  @param[out]     pNumExchgPar      Number of configured telegrams
+ *  @param[out]     ppExchgPar        Pointer to array of telegram configurations
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_readCachedInterfaceConfig (
+    TAU_XML_CACHE_T             cache,
+    const CHAR8                 *pIfName,
+    TRDP_PROCESS_CONFIG_T       *pProcessConfig,
+    TRDP_PD_CONFIG_T            *pPdConfig,
+    TRDP_MD_CONFIG_T            *pMdConfig,
+    UINT32                      *pNumExchgPar,
+    TRDP_EXCHG_PAR_T            * *ppExchgPar);
+
+/**********************************************************************************************************************/
+/**    Read the dataset and comId mapping configuration from the cache.
+ *  Same as tau_readXmlDatasetConfig().
+ *
+ *  @param[in]      cache             Cache handle
+ *  @param[out]     pNumComId         Number of entries in the ComId DatasetId mapping list
+ *  @param[out]     ppComIdDsIdMap    Pointer to an array of structures of type TRDP_COMID_DSID_MAP_T
+ *  @param[out]     pNumDataset       Number of datasets found in the configuration
+ *  @param[out]     papDataset        Pointer to an array of pointers to a structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_readCachedDatasetConfig (
+    TAU_XML_CACHE_T             cache,
+    UINT32                      *pNumComId,
+    TRDP_COMID_DSID_MAP_T       * *ppComIdDsIdMap,
+    UINT32                      *pNumDataset,
+    papTRDP_DATASET_T           papDataset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_XML_CACHE_H */
@@ -127,6 +127,12 @@ EXT_DECL TRDP_ERR_T tlc_process (
     TRDP_FDS_T          *pRfds,
     INT32               *pCount);
 
+#ifdef IO_URING_SUPPORT
+EXT_DECL TRDP_ERR_T tlc_processRing (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_TIME_T   *pMaxWait);
+#endif
+
 EXT_DECL TRDP_IP_ADDR_T tlc_getOwnIpAddress (
     TRDP_APP_SESSION_T appHandle);
 
@@ -161,6 +167,11 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     const UINT8             *pData,
     UINT32                  dataSize);
 
+EXT_DECL TRDP_ERR_T tlp_publishBulk (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_DEF_T      *pPubDef,
+    UINT32              noOfPub);
+
 EXT_DECL TRDP_ERR_T tlp_republish (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_PUB_T          pubHandle,
@@ -242,6 +253,11 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     UINT32                  timeout,
     TRDP_TO_BEHAVIOR_T      toBehavior);
 
+EXT_DECL TRDP_ERR_T tlp_subscribeBulk (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_DEF_T      *pSubDef,
+    UINT32              noOfSub);
+
 
 EXT_DECL TRDP_ERR_T tlp_resubscribe (
     TRDP_APP_SESSION_T  appHandle,
@@ -399,6 +415,20 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
     UINT16                  *pNumPub,
     TRDP_PUB_STATISTICS_T   *pStatistics);
 
+EXT_DECL TRDP_ERR_T tlc_getSubsTiming (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_TIMING_T    *pTiming);
+
+EXT_DECL TRDP_ERR_T tlc_getPubTiming (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_PD_TIMING_T    *pTiming);
+
+EXT_DECL UINT32 tlc_getHistogramPercentile (
+    const TRDP_HISTOGRAM_T  *pHist,
+    UINT32                  permille);
+
 #if MD_SUPPORT
 EXT_DECL TRDP_ERR_T tlc_getUdpListStatistics (
     TRDP_APP_SESSION_T      appHandle,
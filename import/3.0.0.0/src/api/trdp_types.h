@@ -255,6 +255,11 @@ typedef enum
     TRDP_TO_KEEP_LAST_VALUE = 2u     /**< If set, last received values will be returned              */
 } TRDP_TO_BEHAVIOR_T;
 
+/** Source of the receive time of a telegram (TRDP_PD_INFO_T.rxTime) */
+#define TRDP_TIMESTAMP_APP          VOS_TS_APPLICATION  /**< taken by the stack after reading the packet        */
+#define TRDP_TIMESTAMP_SOFTWARE     VOS_TS_SOFTWARE     /**< kernel software time stamp                         */
+#define TRDP_TIMESTAMP_HARDWARE     VOS_TS_HARDWARE     /**< network interface hardware time stamp              */
+
 /**    Process data info from received telegram; allows the application to generate responses.
  *
  * Note: Not all fields are relevant for each message type!
@@ -277,6 +282,8 @@ typedef struct
     TRDP_URI_HOST_T     destHostURI;    /**< destination URI host part (unused)                         */
     TRDP_TO_BEHAVIOR_T  toBehavior;     /**< callback can decide about handling of data on timeout      */
     UINT32              serviceId;      /**< the reserved field of the PD header                        */
+    TRDP_TIME_T         rxTime;         /**< receive time (vos_getTime() time base)                     */
+    UINT8               rxTimeSource;   /**< source of rxTime (TRDP_TIMESTAMP_...)                      */
 } TRDP_PD_INFO_T;
 
 
@@ -536,6 +543,34 @@ typedef struct
 #pragma pack(pop)
 #endif
 
+#define TRDP_HIST_SUB_BITS      3u      /**< Linear sub-buckets per power of two: 2^3 = 8 (<= 12.5% error) */
+#define TRDP_HIST_BUCKETS       184u    /**< Number of buckets, values >= 2^25 us (33.5s) share the last one */
+
+/** Log-linear histogram of time values in us (fixed size, not transmitted on the wire).
+    Values below 8us have their own bucket, above that each power of two is split into 8 equal sub-buckets. */
+typedef struct
+{
+    UINT32  count;                      /**< Number of recorded values                  */
+    UINT32  min;                        /**< Smallest recorded value in us              */
+    UINT32  max;                        /**< Largest recorded value in us               */
+    UINT64  sum;                        /**< Sum of the recorded values in us           */
+    UINT32  bucket[TRDP_HIST_BUCKETS];  /**< Number of values per bucket                */
+} TRDP_HISTOGRAM_T;
+
+/** Timing statistics of a subscription or a publisher (not transmitted on the wire) */
+typedef struct
+{
+    TRDP_HISTOGRAM_T    interval;   /**< Subscriber: inter-arrival time,
+                                         Publisher: deviation of the send period from the cycle time          */
+    TRDP_HISTOGRAM_T    latency;    /**< Subscriber: time from reception (kernel time stamp with
+                                                     TRDP_OPTION_TIMESTAMPING) to the call of the callback function,
+                                         Publisher: time from the send call (the launch time with
+                                                    TRDP_OPTION_TXTIME) to the kernel transmit time stamp
+                                                    (TRDP_OPTION_TIMESTAMPING only)                           */
+    UINT32              numLate;    /**< Subscriber: inter-arrivals longer than half of the time-out,
+                                         Publisher: send periods overrunning the cycle by more than half of it */
+} TRDP_PD_TIMING_T;
+
 
 typedef struct TRDP_SESSION *TRDP_APP_SESSION_T;
 typedef struct PD_ELE *TRDP_PUB_T;
@@ -661,6 +696,45 @@ typedef struct
 } TRDP_PD_CONFIG_T;
 
 
+/**********************************************************************************************************************/
+/** Telegram to publish with tlp_publishBulk(), the parameters of tlp_publish()    */
+typedef struct
+{
+    TRDP_PUB_T          pubHandle;              /**< returned handle for related re/unpublish   */
+    const void          *pUserRef;              /**< user supplied value returned with callback */
+    TRDP_PD_CALLBACK_T  pfCbFunction;           /**< pre-send callback function, NULL if unused */
+    UINT32              serviceId;              /**< optional serviceId (default = 0)           */
+    UINT32              comId;                  /**< comId of packet to send                    */
+    UINT32              etbTopoCnt;             /**< ETB topocount, 0 if consist local          */
+    UINT32              opTrnTopoCnt;           /**< operational topocount                      */
+    TRDP_IP_ADDR_T      srcIpAddr;              /**< own IP address, 0 - set by the stack       */
+    TRDP_IP_ADDR_T      destIpAddr;             /**< where to send the packet to                */
+    UINT32              interval;               /**< interval in us, 0 for PULL only            */
+    UINT32              redId;                  /**< 0 - Non-redundant, > 0 redundancy group    */
+    TRDP_FLAGS_T        pktFlags;               /**< TRDP_FLAGS_DEFAULT, _NONE, _MARSHALL...    */
+    const UINT8         *pData;                 /**< optional initial data, NULL if none        */
+    UINT32              dataSize;               /**< size of data packet                        */
+} TRDP_PUB_DEF_T;
+
+/** Telegram to subscribe with tlp_subscribeBulk(), the parameters of tlp_subscribe()    */
+typedef struct
+{
+    TRDP_SUB_T          subHandle;              /**< returned handle for this subscription      */
+    const void          *pUserRef;              /**< user supplied value returned with callback */
+    TRDP_PD_CALLBACK_T  pfCbFunction;           /**< callback function, NULL for default        */
+    UINT32              serviceId;              /**< optional serviceId (default = 0)           */
+    UINT32              comId;                  /**< comId of packet to receive                 */
+    UINT32              etbTopoCnt;             /**< ETB topocount, 0 if consist local          */
+    UINT32              opTrnTopoCnt;           /**< operational topocount                      */
+    TRDP_IP_ADDR_T      srcIpAddr1;             /**< source IP address, lower address of range  */
+    TRDP_IP_ADDR_T      srcIpAddr2;             /**< upper address of range, 0 if not used      */
+    TRDP_IP_ADDR_T      destIpAddr;             /**< IP address to join                         */
+    TRDP_FLAGS_T        pktFlags;               /**< TRDP_FLAGS_DEFAULT, _NONE, _MARSHALL...    */
+    UINT32              timeout;                /**< timeout in us, 0 for default               */
+    TRDP_TO_BEHAVIOR_T  toBehavior;             /**< timeout behavior                           */
+} TRDP_SUB_DEF_T;
+
+
 /**********************************************************************************************************************/
 /**    Callback for receiving indications, timeouts, releases, responses.
  *
@@ -732,8 +806,19 @@ typedef struct
 #define TRDP_OPTION_NO_PD_STATS         0x40u   /**< Suppress PD statistics \
                                                   Default: Don't suppress                                   */
 #define TRDP_OPTION_DEFAULT_CONFIG      0x80u   /**< no XML process config, defaults were used              */
-
-typedef UINT8 TRDP_OPTION_T;
+#define TRDP_OPTION_TIMESTAMPING        0x100u  /**< Kernel time stamps of received and sent PD (Linux)
+                                                  Default: time taken by the stack                          */
+#define TRDP_OPTION_TXTIME              0x200u  /**< Cyclic PD handed to the kernel one interval ahead with its
+                                                  launch time (SO_TXTIME, Linux, fq or etf qdisc; not with
+                                                  HIGH_PERF_INDEXED)  Default: sent when due                */
+#define TRDP_OPTION_PACKET_RING         0x400u  /**< PD received through a memory mapped packet ring (Linux,
+                                                  PACKET_MMAP_SUPPORT, CAP_NET_RAW; not with tlc_processRing();
+                                                  cannot be cleared again once the ring is open)
+                                                  Default: read from the UDP sockets                        */
+
+/** Session options. Was UINT8 up to the options above 0x80: this changes the layout of TRDP_PROCESS_CONFIG_T
+    (and of structures embedding it), applications and libraries must be rebuilt against this header.    */
+typedef UINT16 TRDP_OPTION_T;
 
 /**********************************************************************************************************************/
 /** Various flags/general TRDP options for library initialization
@@ -72,6 +72,14 @@ extern "C" {
 #define TAU_MAX_NAME_SIZE           256u    /* Allocated on stack */
 #define TAU_DNS_TIME_OUT_LONG       10u     /**< Timeout in seconds for DNS server reply, if no hosts file provided   */
 #define TAU_DNS_TIME_OUT_SHORT      1u      /**< Timeout in seconds for DNS server reply, if hosts file was provided  */
+#define TAU_DNR_NO_ENTRY            0xFFFFu /**< End of a hash chain or of the LRU list                             */
+#define TAU_DNR_WAIT_POLL_US        10000u  /**< Poll interval while waiting for a request of another thread        */
+
+/* States of a cache entry */
+#define TAU_DNR_UNRESOLVED          0u      /**< no or outdated address, not asked for yet      */
+#define TAU_DNR_PENDING             1u      /**< request in flight                              */
+#define TAU_DNR_RESOLVED            2u      /**< address valid for the stored topocounts        */
+#define TAU_DNR_FAILED              3u      /**< not resolvable, do not ask before retryTime    */
 
 /***********************************************************************************************************************
  * TYPEDEFS
@@ -235,9 +243,325 @@ static void changetoDnsNameFormat (UINT8 *pDns, CHAR8 *pHost)
     *pDns++ = '\0';
 }
 
-static int compareURI ( const void *arg1, const void *arg2 )
+/**********************************************************************************************************************/
+/**    Case insensitive hash of a host name (FNV-1a)
+ *
+ *  @param[in]      pUri            Host name
+ *
+ *  @retval         hash bucket
+ */
+static UINT32 dnrHash (
+    const CHAR8 *pUri)
+{
+    UINT32  hash = 2166136261u;
+    UINT32  i;
+
+    for (i = 0u; (i < TRDP_MAX_URI_HOST_LEN) && (pUri[i] != '\0'); i++)
+    {
+        hash    ^= (UINT32) tolower((unsigned char) pUri[i]);
+        hash    *= 16777619u;
+    }
+    return hash & (TAU_DNR_HASH_SIZE - 1u);
+}
+
+/**********************************************************************************************************************/
+/**    Remove an entry from the LRU list
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      idx             Index of the entry
+ */
+static void dnrLruUnlink (
+    TAU_DNR_DATA_T  *pDNR,
+    UINT16          idx)
+{
+    TAU_DNR_ENTRY_T *pEntry = &pDNR->cache[idx];
+
+    if (pEntry->lruPrev != TAU_DNR_NO_ENTRY)
+    {
+        pDNR->cache[pEntry->lruPrev].lruNext = pEntry->lruNext;
+    }
+    else
+    {
+        pDNR->lruHead = pEntry->lruNext;
+    }
+    if (pEntry->lruNext != TAU_DNR_NO_ENTRY)
+    {
+        pDNR->cache[pEntry->lruNext].lruPrev = pEntry->lruPrev;
+    }
+    else
+    {
+        pDNR->lruTail = pEntry->lruPrev;
+    }
+    pEntry->lruPrev = TAU_DNR_NO_ENTRY;
+    pEntry->lruNext = TAU_DNR_NO_ENTRY;
+}
+
+/**********************************************************************************************************************/
+/**    Insert an entry as most recently used
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      idx             Index of the entry
+ */
+static void dnrLruPushFront (
+    TAU_DNR_DATA_T  *pDNR,
+    UINT16          idx)
+{
+    TAU_DNR_ENTRY_T *pEntry = &pDNR->cache[idx];
+
+    pEntry->lruPrev = TAU_DNR_NO_ENTRY;
+    pEntry->lruNext = pDNR->lruHead;
+    if (pDNR->lruHead != TAU_DNR_NO_ENTRY)
+    {
+        pDNR->cache[pDNR->lruHead].lruPrev = idx;
+    }
+    else
+    {
+        pDNR->lruTail = idx;
+    }
+    pDNR->lruHead = idx;
+}
+
+/**********************************************************************************************************************/
+/**    Find a host name in the cache and mark it as most recently used. Call with the cache mutex held.
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pUri            Host name
+ *
+ *  @retval         cache entry or NULL
+ */
+static TAU_DNR_ENTRY_T *dnrFind (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pUri)
+{
+    UINT16 idx = pDNR->hashTable[dnrHash(pUri)];
+
+    while (idx != TAU_DNR_NO_ENTRY)
+    {
+        if (vos_strnicmp(pDNR->cache[idx].uri, pUri, TRDP_MAX_URI_HOST_LEN) == 0)
+        {
+            if ((pDNR->cache[idx].fixedEntry == FALSE) && (pDNR->lruHead != idx))
+            {
+                dnrLruUnlink(pDNR, idx);
+                dnrLruPushFront(pDNR, idx);
+            }
+            return &pDNR->cache[idx];
+        }
+        idx = pDNR->cache[idx].hashNext;
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Add a host name to the cache. If the cache is full, the least recently used entry is replaced; entries
+ *  read from the hosts file are never replaced. Call with the cache mutex held.
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pUri            Host name
+ *  @param[in]      fixedEntry      TRUE for hosts file entries
+ *
+ *  @retval         new cache entry (unresolved) or NULL if all entries are fixed
+ */
+static TAU_DNR_ENTRY_T *dnrAdd (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pUri,
+    BOOL8           fixedEntry)
+{
+    TAU_DNR_ENTRY_T *pEntry;
+    UINT16          idx;
+    UINT16          *pLink;
+
+    if (pDNR->noOfCachedEntries < TAU_MAX_NO_CACHE_ENTRY)
+    {
+        idx = (UINT16) pDNR->noOfCachedEntries++;
+    }
+    else
+    {
+        idx = pDNR->lruTail;
+        if (idx == TAU_DNR_NO_ENTRY)
+        {
+            return NULL;
+        }
+        vos_printLog(VOS_LOG_DBG, "DNR cache full, replacing %s\n", pDNR->cache[idx].uri);
+
+        /* Remove the evicted entry from its hash chain and from the LRU list */
+        pLink = &pDNR->hashTable[dnrHash(pDNR->cache[idx].uri)];
+        while (*pLink != idx)
+        {
+            pLink = &pDNR->cache[*pLink].hashNext;
+        }
+        *pLink = pDNR->cache[idx].hashNext;
+        dnrLruUnlink(pDNR, idx);
+    }
+
+    pEntry = &pDNR->cache[idx];
+    memset(pEntry, 0, sizeof(TAU_DNR_ENTRY_T));
+    vos_strncpy(pEntry->uri, pUri, TRDP_MAX_URI_HOST_LEN - 1);
+    pEntry->fixedEntry  = fixedEntry;
+    pEntry->state       = TAU_DNR_UNRESOLVED;
+    pEntry->hashNext    = pDNR->hashTable[dnrHash(pEntry->uri)];
+    pDNR->hashTable[dnrHash(pEntry->uri)] = idx;
+    pEntry->lruPrev     = TAU_DNR_NO_ENTRY;
+    pEntry->lruNext     = TAU_DNR_NO_ENTRY;
+    if (fixedEntry == FALSE)
+    {
+        dnrLruPushFront(pDNR, idx);
+    }
+    return pEntry;
+}
+
+/**********************************************************************************************************************/
+/**    Check if a cache entry holds a valid address for the current topocounts
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pEntry          Cache entry
+ *
+ *  @retval         TRUE            address can be used
+ */
+static BOOL8 dnrIsValid (
+    TRDP_APP_SESSION_T      appHandle,
+    const TAU_DNR_ENTRY_T   *pEntry)
+{
+    return (((pEntry->fixedEntry == TRUE) ||
+             ((pEntry->state == TAU_DNR_RESOLVED) &&
+              /* #367: Do both topocounts match? */
+              (((pEntry->etbTopoCnt == appHandle->etbTopoCnt) && (pEntry->opTrnTopoCnt == appHandle->opTrnTopoCnt)) ||
+               /* Or do we not care?       */
+               ((appHandle->etbTopoCnt == 0u) && (appHandle->opTrnTopoCnt == 0u))))) &&
+            (pEntry->ipAddr != 0u)) ? TRUE : FALSE;                       /* 0 is only a placeholder */
+}
+
+/**********************************************************************************************************************/
+/**    Check if a cache entry failed recently (negative caching). A topology change allows a new attempt.
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pEntry          Cache entry
+ *
+ *  @retval         TRUE            do not ask the resolver again yet
+ */
+static BOOL8 dnrIsFailed (
+    TRDP_APP_SESSION_T      appHandle,
+    const TAU_DNR_ENTRY_T   *pEntry)
+{
+    VOS_TIMEVAL_T now;
+
+    if ((pEntry->state != TAU_DNR_FAILED) ||
+        (pEntry->etbTopoCnt != appHandle->etbTopoCnt) ||
+        (pEntry->opTrnTopoCnt != appHandle->opTrnTopoCnt))
+    {
+        return FALSE;
+    }
+    vos_getTime(&now);
+    return (vos_cmpTime(&now, &pEntry->retryTime) < 0) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/**    Mark a cache entry as not resolvable for TAU_DNR_NEGATIVE_TTL seconds
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pEntry          Cache entry
+ */
+static void dnrSetFailed (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_ENTRY_T     *pEntry)
+{
+    const VOS_TIMEVAL_T ttl = {TAU_DNR_NEGATIVE_TTL, 0};
+
+    pEntry->state           = TAU_DNR_FAILED;
+    pEntry->ipAddr          = VOS_INADDR_ANY;
+    pEntry->etbTopoCnt      = appHandle->etbTopoCnt;
+    pEntry->opTrnTopoCnt    = appHandle->opTrnTopoCnt;
+    vos_getTime(&pEntry->retryTime);
+    vos_addTime(&pEntry->retryTime, &ttl);
+}
+
+/**********************************************************************************************************************/
+/**    Look up a host name in the cache
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pUri            Host name
+ *  @param[out]     pAddr           Pointer to return the IP address
+ *  @param[in]      queue           TRUE: hand a miss to the resolver thread
+ *
+ *  @retval         TRDP_NO_ERR         address found
+ *  @retval         TRDP_UNRESOLVED_ERR failed recently or no cache entry available
+ *  @retval         TRDP_BLOCK_ERR      request in flight (or queued)
+ *  @retval         TRDP_NODATA_ERR     not cached, the caller shall resolve it
+ */
+static TRDP_ERR_T dnrLookup (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      *pAddr,
+    BOOL8               queue)
+{
+    TRDP_ERR_T      err;
+    TAU_DNR_ENTRY_T *pEntry;
+
+    (void) vos_mutexLock(pDNR->mutex);
+    pEntry = dnrFind(pDNR, pUri);
+    if ((pEntry != NULL) && (dnrIsValid(appHandle, pEntry) == TRUE))
+    {
+        *pAddr  = pEntry->ipAddr;
+        err     = TRDP_NO_ERR;
+    }
+    else if ((pEntry != NULL) && (dnrIsFailed(appHandle, pEntry) == TRUE))
+    {
+        err = TRDP_UNRESOLVED_ERR;
+    }
+    else if ((pEntry != NULL) && ((pEntry->state == TAU_DNR_PENDING) || (pEntry->queued == TRUE)))
+    {
+        err = TRDP_BLOCK_ERR;
+    }
+    else
+    {
+        if (pEntry == NULL)
+        {
+            pEntry = dnrAdd(pDNR, pUri, FALSE);
+        }
+        if (pEntry == NULL)
+        {
+            vos_printLog(VOS_LOG_WARNING, "DNR cache full of fixed entries, cannot resolve %s\n", pUri);
+            err = TRDP_UNRESOLVED_ERR;
+        }
+        else if (queue == TRUE)
+        {
+            pEntry->queued  = TRUE;
+            err             = TRDP_BLOCK_ERR;
+        }
+        else
+        {
+            err = TRDP_NODATA_ERR;
+        }
+    }
+    (void) vos_mutexUnlock(pDNR->mutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Wait until a request of another thread for the same host name finished
+ *
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pUri            Host name
+ */
+static void dnrWaitPending (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pUri)
 {
-    return vos_strnicmp((const CHAR8 *)arg1, (const CHAR8 *)arg2, TRDP_MAX_URI_HOST_LEN);
+    UINT32          waited;
+    const UINT32    maxWait = (UINT32) pDNR->timeout * 1000000u + 2u * TCN_DNS_REQ_TO_US;
+    TAU_DNR_ENTRY_T *pEntry;
+    BOOL8           pending = TRUE;
+
+    for (waited = 0u; (pending == TRUE) && (waited < maxWait); waited += TAU_DNR_WAIT_POLL_US)
+    {
+        vos_threadDelay(TAU_DNR_WAIT_POLL_US);
+        (void) vos_mutexLock(pDNR->mutex);
+        pEntry  = dnrFind(pDNR, pUri);
+        pending = ((pEntry != NULL) &&
+                   ((pEntry->state == TAU_DNR_PENDING) || (pEntry->queued == TRUE))) ? TRUE : FALSE;
+        (void) vos_mutexUnlock(pDNR->mutex);
+    }
 }
 
 static void printDNRcache (TAU_DNR_DATA_T *pDNR)
@@ -283,9 +607,12 @@ static TRDP_ERR_T readHostsFile (
             /* get a line from the file */
             if (fgets(line, TAU_MAX_HOSTS_LINE_LENGTH, fp) != NULL)
             {
-                UINT32  start       = 0u;
-                UINT32  l_index       = 0u;
-                UINT32  maxIndex    = (UINT32) strlen(line);
+                UINT32          start       = 0u;
+                UINT32          l_index       = 0u;
+                UINT32          maxIndex    = (UINT32) strlen(line);
+                TRDP_IP_ADDR_T  ipAddr;
+                CHAR8           uri[TRDP_MAX_URI_HOST_LEN];
+                TAU_DNR_ENTRY_T *pEntry;
 
                 /* Skip empty lines, comment lines */
                 if (line[l_index] == '#' ||
@@ -296,9 +623,9 @@ static TRDP_ERR_T readHostsFile (
                 }
 
                 /* Try to get IP */
-                pDNR->cache[pDNR->noOfCachedEntries].ipAddr = vos_dottedIP(&line[l_index]);
+                ipAddr = vos_dottedIP(&line[l_index]);
 
-                if (pDNR->cache[pDNR->noOfCachedEntries].ipAddr == VOS_INADDR_ANY)
+                if (ipAddr == VOS_INADDR_ANY)
                 {
                     continue;
                 }
@@ -322,22 +649,30 @@ static TRDP_ERR_T readHostsFile (
                 {
                     l_index++;
                 }
-                if (l_index < maxIndex)
+                memset(uri, 0, sizeof(uri));
+                if ((l_index < maxIndex) && (l_index - start < TRDP_MAX_URI_HOST_LEN))
                 {
-                    vos_strncpy(pDNR->cache[pDNR->noOfCachedEntries].uri, &line[start], l_index - start);
+                    vos_strncpy(uri, &line[start], l_index - start);
                 }
-                /* increment only if entry is valid */
-                if (strlen(pDNR->cache[pDNR->noOfCachedEntries].uri) > 0u)
+                /* add only if entry is valid */
+                if (strlen(uri) > 0u)
                 {
-                    pDNR->cache[pDNR->noOfCachedEntries].etbTopoCnt     = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].opTrnTopoCnt   = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].fixedEntry     = TRUE;
-                    pDNR->noOfCachedEntries++;
+                    pEntry = dnrFind(pDNR, uri);
+                    if (pEntry == NULL)
+                    {
+                        pEntry = dnrAdd(pDNR, uri, TRUE);
+                    }
+                    if ((pEntry != NULL) && (pEntry->fixedEntry == TRUE))
+                    {
+                        pEntry->ipAddr          = ipAddr;
+                        pEntry->etbTopoCnt      = 0u;
+                        pEntry->opTrnTopoCnt    = 0u;
+                        pEntry->state           = TAU_DNR_RESOLVED;
+                    }
                 }
             }
         }
         vos_printLog(VOS_LOG_DBG, "readHostsFile: %d entries processed\n", pDNR->noOfCachedEntries);
-        vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
         fclose(fp);
         printDNRcache(pDNR);
         err = TRDP_NO_ERR;
@@ -565,19 +900,15 @@ static void parseResponse (
 
 /**********************************************************************************************************************/
 /**    Query the DNS server for the addresses
+ *  The cache entry is marked pending while the query is in flight, concurrent requests for the same host name
+ *  wait for it. The cache mutex is not held while waiting for the reply.
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
- *  @param[in]      pTemp               Last entry which was invalid, can be NULL
  *  @param[in]      pUri                Pointer to host name
  *
- *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
- *  @retval         TRDP_INIT_ERR   initialisation error
- *
  */
 static void updateDNSentry (
     TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_ENTRY_T     *pTemp,
     const CHAR8         *pUri)
 {
     VOS_SOCK_T      my_socket;
@@ -586,9 +917,26 @@ static void updateDNSentry (
     UINT32          size;
     UINT32          querySize;
     VOS_SOCK_OPT_T  opts;
-    UINT16          id      = sRequesterId++;
+    UINT16          id;
     TAU_DNR_DATA_T  *pDNR   = (TAU_DNR_DATA_T *) appHandle->pUser;
     TRDP_IP_ADDR_T  ip_addr = VOS_INADDR_ANY;
+    TAU_DNR_ENTRY_T *pTemp;
+
+    /* Claim the entry, unless another thread asks for it already */
+    (void) vos_mutexLock(pDNR->mutex);
+    pTemp = dnrFind(pDNR, pUri);
+    if (pTemp == NULL)
+    {
+        pTemp = dnrAdd(pDNR, pUri, FALSE);
+    }
+    if ((pTemp == NULL) || (pTemp->fixedEntry == TRUE) || (pTemp->state == TAU_DNR_PENDING))
+    {
+        (void) vos_mutexUnlock(pDNR->mutex);
+        return;
+    }
+    pTemp->state = TAU_DNR_PENDING;
+    id = sRequesterId++;
+    (void) vos_mutexUnlock(pDNR->mutex);
 
     memset(&opts, 0, sizeof(opts));
 
@@ -597,7 +945,7 @@ static void updateDNSentry (
     if (err != VOS_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_ERROR, "updateDNSentry failed to open socket\n");
-        return;
+        goto store;
     }
 
     err = (VOS_ERR_T) createSendQuery(pDNR, my_socket, pUri, id, &querySize);
@@ -627,12 +975,15 @@ static void updateDNSentry (
                                                          signed/unsigned division in macro /
                                                          Redundant left argument to comma */
         {
+            TRDP_IP_ADDR_T  srcIpAddr   = VOS_INADDR_ANY;
+            UINT16          srcPort     = 0u;
+
             /* Clear our packet buffer  */
             memset(packetBuffer, 0, TAU_MAX_DNS_BUFFER_SIZE);
             size = TAU_MAX_DNS_BUFFER_SIZE;
 
             /* Get what was announced */
-            (void) vos_sockReceiveUDP(my_socket, packetBuffer, &size, &pDNR->dnsIpAddr, &pDNR->dnsPort, NULL, NULL, FALSE); /* 322 */
+            (void) vos_sockReceiveUDP(my_socket, packetBuffer, &size, &srcIpAddr, &srcPort, NULL, NULL, FALSE); /* 322 */
 
             VOS_FD_CLR(my_socket, &rfds); /*lint !e573 !e502 !e505 Signed/unsigned mix in std-header */
 
@@ -643,56 +994,39 @@ static void updateDNSentry (
 
             /*  Get and convert response */
             parseResponse(packetBuffer, size, id, querySize, &ip_addr);
+        }
+        break;
+    }
 
-            if ((pTemp != NULL) &&
-                (ip_addr != VOS_INADDR_ANY) &&
-                (pTemp->fixedEntry == FALSE))
-            {
-                /* Overwrite outdated entry */
-                pTemp->ipAddr       = ip_addr;
-                pTemp->etbTopoCnt   = appHandle->etbTopoCnt;
-                pTemp->opTrnTopoCnt = appHandle->opTrnTopoCnt;
-                break;
-            }
-            else /* It's a new one, update our cache */
-            {
-                UINT32 cacheEntry = pDNR->noOfCachedEntries;
-
-                if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
-                {
-                    cacheEntry = 0u;                        /* Overwrite first */
-                    // tbd: cacheEntry = cacheGetOldest();
-                }
-                else
-                {
-                    pDNR->noOfCachedEntries++;
-                }
+exit:
+    (void) vos_sockClose(my_socket);
 
-                /* Position found, store everything */
-                vos_strncpy(pDNR->cache[cacheEntry].uri, pUri, TRDP_MAX_URI_HOST_LEN-1);
-                pDNR->cache[cacheEntry].ipAddr          = ip_addr;
-                pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-                pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-                pDNR->cache[cacheEntry].fixedEntry      = FALSE;
-
-                /* Sort the entries to get faster hits  */
-                vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
-                break;
-            }
+store:
+    /* Store the result, the entry may have been replaced meanwhile */
+    (void) vos_mutexLock(pDNR->mutex);
+    pTemp = dnrFind(pDNR, pUri);
+    if ((pTemp != NULL) && (pTemp->fixedEntry == FALSE))
+    {
+        if (ip_addr != VOS_INADDR_ANY)
+        {
+            pTemp->ipAddr       = ip_addr;
+            pTemp->etbTopoCnt   = appHandle->etbTopoCnt;
+            pTemp->opTrnTopoCnt = appHandle->opTrnTopoCnt;
+            pTemp->state        = TAU_DNR_RESOLVED;
         }
         else
         {
-            break;
+            dnrSetFailed(appHandle, pTemp);
         }
     }
-
-exit:
-    (void) vos_sockClose(my_socket);
+    (void) vos_mutexUnlock(pDNR->mutex);
     return;
 }
 
 /**********************************************************************************************************************/
 /**    Build the request payload
+ *  Asks for all outdated entries, which are not in flight already, and marks them pending.
+ *  Call with the cache mutex held.
  *
  *  @param[in]      pDNR            Reference Context
  *  @param[in]      pRequest        Handle returned by tlc_openSession()
@@ -725,6 +1059,12 @@ static void buildRequest (
         {
             continue;
         }
+        /* Already asked for, or failed recently? */
+        else if ((pDNR->cache[cacheEntry].state == TAU_DNR_PENDING) ||
+                 (dnrIsFailed(appHandle, &pDNR->cache[cacheEntry]) == TRUE))
+        {
+            continue;
+        }
         /* Needs update? Only when there is no address or the topocounts do not match */
         else if ((pDNR->cache[cacheEntry].ipAddr == 0u) ||
             ((pDNR->cache[cacheEntry].etbTopoCnt != appHandle->etbTopoCnt) ||
@@ -733,6 +1073,7 @@ static void buildRequest (
             /* Make sure the string is not longer than 79 chars (+ trailing zero) */
             vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pDNR->cache[cacheEntry].uri, TRDP_MAX_URI_HOST_LEN-1);
             pRequest->tcnUriCnt++;
+            pDNR->cache[cacheEntry].state = TAU_DNR_PENDING;
         }
     }
     /* tbd: add SDT trailer
@@ -742,47 +1083,10 @@ static void buildRequest (
     *pSize = sizeof(TRDP_DNS_REQUEST_T) - (255u - pRequest->tcnUriCnt) * sizeof(TCN_URI_T);
 }
 
-/**********************************************************************************************************************/
-/**    Add an entry to the DNS cache to be resolved
- *
- *  @param[in]      appHandle       Session context
- *  @param[in]      pDNR            DNR context
- *  @param[in]      pURI            URI to add
- *
- *
- */
-static void addEntry (
-    TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_DATA_T      *pDNR,
-    const CHAR8         *pURI)
-{
-    /* It's a new one, update our cache */
-    UINT32 cacheEntry = pDNR->noOfCachedEntries;
-
-    if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
-    {
-        cacheEntry = 0u;                        /* Overwrite first */
-        // tbd: cacheEntry = cacheGetOldest();
-    }
-    else
-    {
-        pDNR->noOfCachedEntries++;
-    }
-
-    /* Position found, store everything */
-    vos_strncpy(pDNR->cache[cacheEntry].uri, pURI, TRDP_MAX_URI_HOST_LEN-1);
-    pDNR->cache[cacheEntry].ipAddr          = 0u;
-    pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-    pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-    pDNR->cache[cacheEntry].fixedEntry      = FALSE;
-
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
-}
-
 /**********************************************************************************************************************/
 /**    Parse the reply payload and update the DNS cache
  *
+ *  @param[in]      appHandle       Session context
  *  @param[in]      pDNR            DNR context
  *  @param[in]      pReply          Handle returned by tlc_openSession()
  *  @param[in]      size            Pointer to Message Info
@@ -790,6 +1094,7 @@ static void addEntry (
  *
  */
 static void parseUpdateTCNResponse (
+                                    TRDP_APP_SESSION_T  appHandle,
                                     TAU_DNR_DATA_T      *pDNR,
                                     TRDP_DNS_REPLY_T    *pReply,
                                     UINT32              size)
@@ -799,24 +1104,23 @@ static void parseUpdateTCNResponse (
 
     (void)size;
 
+    (void) vos_mutexLock(pDNR->mutex);
     for (i = 0u; i < pReply->tcnUriCnt; i++)
     {
+        pTemp = dnrFind(pDNR, pReply->tcnUriList[i].tcnUriStr);
         if (pReply->tcnUriList[i].resolvState != -1)
         {
-            pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pReply->tcnUriList[i].tcnUriStr,
-                                                pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                compareURI);
-            if (pTemp != NULL)
+            if ((pTemp != NULL) && (pTemp->fixedEntry == FALSE))
             {
                 /* Position found, store everything */
-                vos_strncpy(pTemp->uri, pReply->tcnUriList[i].tcnUriStr, TRDP_MAX_URI_HOST_LEN-1);
                 pTemp->ipAddr          = vos_ntohl(pReply->tcnUriList[i].tcnUriIpAddr);
                 pTemp->etbTopoCnt      = vos_ntohl(pReply->etbTopoCnt);
                 pTemp->opTrnTopoCnt    = vos_ntohl(pReply->opTrnTopoCnt);
-                pTemp->fixedEntry      = FALSE;
+                pTemp->state           = TAU_DNR_RESOLVED;
                 if (pTemp->ipAddr == VOS_INADDR_ANY)
                 {
                     vos_printLog(VOS_LOG_WARNING, "%s resolved to INADDR_ANY\n", pReply->tcnUriList[i].tcnUriStr);
+                    dnrSetFailed(appHandle, pTemp);
                 }
             }
             else
@@ -827,10 +1131,13 @@ static void parseUpdateTCNResponse (
         else
         {
             vos_printLog(VOS_LOG_WARNING, "%s could not be resolved\n", pReply->tcnUriList[i].tcnUriStr);
+            if ((pTemp != NULL) && (pTemp->fixedEntry == FALSE))
+            {
+                dnrSetFailed(appHandle, pTemp);
+            }
         }
     }
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
+    (void) vos_mutexUnlock(pDNR->mutex);
 }
 
 /**********************************************************************************************************************/
@@ -872,7 +1179,7 @@ static void dnrMDCallback (
         // if (sdt_isvalid(appHandle, pData, dataSize)) ...
 
         /* update the cache */
-        parseUpdateTCNResponse((TAU_DNR_DATA_T *) appHandle->pUser, (TRDP_DNS_REPLY_T *)pData, dataSize);
+        parseUpdateTCNResponse(appHandle, (TAU_DNR_DATA_T *) appHandle->pUser, (TRDP_DNS_REPLY_T *)pData, dataSize);
 
         (void) vos_semaGive(*pDnsSema);
     }
@@ -884,29 +1191,25 @@ static void dnrMDCallback (
 
 /**********************************************************************************************************************/
 /**    Query the TCN-DNS server for the addresses
+ *  One request asks for all outdated cache entries, which are marked pending meanwhile. Entries without an
+ *  answer are marked as failed.
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
- *  @param[in]      pTemp               Last entry which was invalid, can be NULL
  *  @param[in]      pUri                Pointer to host name
  *
- *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
- *  @retval         TRDP_INIT_ERR   initialisation error
- *
  */
 static void updateTCNDNSentry (
     TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_ENTRY_T     *pTemp,
     const CHAR8         *pUri)
 {
     TRDP_ERR_T      err;
     UINT32          querySize;
+    UINT32          i;
     TAU_DNR_DATA_T  *pDNR   = (TAU_DNR_DATA_T *) appHandle->pUser;
     VOS_SEMA_T      dnsSema;
+    TAU_DNR_ENTRY_T *pTemp;
 
-    static UINT8 sTCN_DNS_Buffer[sizeof(TRDP_DNS_REQUEST_T)];
-
-    TRDP_DNS_REQUEST_T  *pDNS_REQ = (TRDP_DNS_REQUEST_T *)sTCN_DNS_Buffer;
+    TRDP_DNS_REQUEST_T  *pDNS_REQ;
     TRDP_UUID_T         sessionId;
 
     /* Create semaphore */
@@ -918,19 +1221,28 @@ static void updateTCNDNSentry (
         return;
     }
 
-    /* Is this URI already in the cache? If not, add it! Eventually remove the oldest  */
+    /* Several threads may ask at the same time, each needs its own request buffer */
+    pDNS_REQ = (TRDP_DNS_REQUEST_T *) vos_memAlloc(sizeof(TRDP_DNS_REQUEST_T));
+    if (pDNS_REQ == NULL)
+    {
+        vos_semaDelete(dnsSema);
+        return;
+    }
 
-    if (pTemp == NULL)
+    /* Is this URI already in the cache? If not, add it! Eventually remove the least recently used  */
+    (void) vos_mutexLock(pDNR->mutex);
+    if (dnrFind(pDNR, pUri) == NULL)
     {
-        addEntry(appHandle, pDNR, pUri);
+        (void) dnrAdd(pDNR, pUri, FALSE);
     }
-    /* build the request telegram with all possible outdated entries */
 
+    /* build the request telegram with all possible outdated entries */
     buildRequest(appHandle, pDNR, pDNS_REQ, &querySize);
+    (void) vos_mutexUnlock(pDNR->mutex);
 
-    if (querySize == 0u)
+    if (pDNS_REQ->tcnUriCnt == 0u)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "updateTCNDNSentry failed to send request\n");
+        /* nothing to ask for, the URI is in flight already */
         goto exit;
     }
     /* send the MD request */
@@ -942,14 +1254,14 @@ static void updateTCNDNSentry (
                         1u,
                         TCN_DNS_REQ_TO_US,
                         NULL,
-                        sTCN_DNS_Buffer,
+                        (UINT8 *) pDNS_REQ,
                         querySize,
                         NULL,
                         NULL);
     if (err != TRDP_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_ERROR, "updateTCNDNSentry failed to send request\n");
-        goto exit;
+        goto fail;
     }
 
     /* how do we get the reply? */
@@ -1027,11 +1339,82 @@ static void updateTCNDNSentry (
     /* kill the session to avoid dangeling semaphore */
     (void) tlm_abortSession(appHandle, (const TRDP_UUID_T*)&sessionId); /*lint !e545 suspicious use of & parameter 2 */
 
+fail:
+    /* URIs without an answer are not asked for again before TAU_DNR_NEGATIVE_TTL */
+    (void) vos_mutexLock(pDNR->mutex);
+    for (i = 0u; i < pDNS_REQ->tcnUriCnt; i++)
+    {
+        pTemp = dnrFind(pDNR, pDNS_REQ->tcnUriList[i].tcnUriStr);
+        if ((pTemp != NULL) && (pTemp->state == TAU_DNR_PENDING))
+        {
+            dnrSetFailed(appHandle, pTemp);
+        }
+    }
+    (void) vos_mutexUnlock(pDNR->mutex);
+
 exit:
+    vos_memFree(pDNS_REQ);
     vos_semaDelete(dnsSema);
     return;
 }
 
+/**********************************************************************************************************************/
+/**    Resolver thread for tau_uri2AddrNoWait
+ *  Resolves the queued cache entries one after the other, until it is told to stop.
+ *
+ *  @param[in]      pArg                Handle returned by tlc_openSession()
+ *
+ */
+static void dnrResolverThread (
+    void *pArg)
+{
+    TRDP_APP_SESSION_T  appHandle   = (TRDP_APP_SESSION_T) pArg;
+    TAU_DNR_DATA_T      *pDNR       = (TAU_DNR_DATA_T *) appHandle->pUser;
+    TRDP_URI_HOST_T     uri;
+    UINT32              i;
+    BOOL8               found;
+
+    while (pDNR->resolverStop == FALSE)
+    {
+        (void) vos_semaTake(pDNR->resolverSema, VOS_SEMA_WAIT_FOREVER);
+
+        do
+        {
+            found = FALSE;
+            (void) vos_mutexLock(pDNR->mutex);
+            for (i = 0u; (i < pDNR->noOfCachedEntries) && (pDNR->resolverStop == FALSE); i++)
+            {
+                if (pDNR->cache[i].queued == TRUE)
+                {
+                    pDNR->cache[i].queued = FALSE;
+                    /* someone else is asking for it already */
+                    if (pDNR->cache[i].state != TAU_DNR_PENDING)
+                    {
+                        vos_strncpy(uri, pDNR->cache[i].uri, TRDP_MAX_URI_HOST_LEN - 1);
+                        found = TRUE;
+                        break;
+                    }
+                }
+            }
+            (void) vos_mutexUnlock(pDNR->mutex);
+
+            if (found == TRUE)
+            {
+                if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
+                {
+                    updateTCNDNSentry(appHandle, uri);
+                }
+                else
+                {
+                    updateDNSentry(appHandle, uri);
+                }
+            }
+        }
+        while (found == TRUE);
+    }
+    pDNR->resolverRunning = FALSE;
+}
+
 #pragma mark ----------------------- Public -----------------------------
 
 /***********************************************************************************************************************
@@ -1099,7 +1482,23 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
 
     pDNR->useTCN_DNS = dnsOptions;
     pDNR->noOfCachedEntries = 0u;
-    
+    pDNR->lruHead   = TAU_DNR_NO_ENTRY;
+    pDNR->lruTail   = TAU_DNR_NO_ENTRY;
+    memset(pDNR->hashTable, 0xFF, sizeof(pDNR->hashTable));     /* all TAU_DNR_NO_ENTRY */
+
+    if ((vos_mutexCreate(&pDNR->mutex) != VOS_NO_ERR) ||
+        (vos_semaCreate(&pDNR->resolverSema, VOS_SEMA_EMPTY) != VOS_NO_ERR))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "tau_initDnr failed to create mutex or semaphore\n");
+        if (pDNR->mutex != NULL)
+        {
+            vos_mutexDelete(pDNR->mutex);
+        }
+        vos_memFree(pDNR);
+        appHandle->pUser = NULL;
+        return TRDP_INIT_ERR;
+    }
+
     if (waitForDnr > 0)
     {
         pDNR->timeout = TAU_DNS_TIME_OUT_LONG;
@@ -1134,9 +1533,31 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
 EXT_DECL void tau_deInitDnr (
     TRDP_APP_SESSION_T appHandle)
 {
+    TAU_DNR_DATA_T  *pDNR;
+    UINT32          waited;
 
     if (appHandle != NULL && appHandle->pUser != NULL)
     {
+        pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+        /* Stop the resolver thread, a running query is finished first */
+        if (pDNR->resolverRunning == TRUE)
+        {
+            const UINT32 maxWait = (UINT32) pDNR->timeout * 1000000u + 3u * TCN_DNS_REQ_TO_US;
+
+            pDNR->resolverStop = TRUE;
+            vos_semaGive(pDNR->resolverSema);
+            for (waited = 0u; (pDNR->resolverRunning == TRUE) && (waited < maxWait); waited += TAU_DNR_WAIT_POLL_US)
+            {
+                vos_threadDelay(TAU_DNR_WAIT_POLL_US);
+            }
+            if (pDNR->resolverRunning == TRUE)
+            {
+                (void) vos_threadTerminate(pDNR->resolverThread);
+            }
+        }
+        vos_semaDelete(pDNR->resolverSema);
+        vos_mutexDelete(pDNR->mutex);
         vos_memFree(appHandle->pUser);
         appHandle->pUser = NULL;
     }
@@ -1229,6 +1650,8 @@ EXT_DECL TRDP_IP_ADDR_T tau_getOwnAddr (
  *
  *  Receives an URI as input variable and translates this URI to an IP-Address.
  *  The URI may specify either a unicast or a multicast IP-Address.
+ *  If the URI is being resolved by another thread already, the call waits for that answer instead of sending its
+ *  own query. A failed URI is not asked for again before TAU_DNR_NEGATIVE_TTL seconds or a topology change.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession()
  *  @param[out]     pAddr           Pointer to return the IP address
@@ -1246,7 +1669,7 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     const TRDP_URI_T    pUri)
 {
     TAU_DNR_DATA_T  *pDNR;
-    TAU_DNR_ENTRY_T *pTemp;
+    TRDP_ERR_T      err;
     int i;
 
     if (appHandle == NULL ||
@@ -1273,33 +1696,31 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     if (pDNR != NULL)
     {
         /* Look inside the cache    */
-        for (i = 0; i < 2; ++i)
+        for (i = 0; ; ++i)
         {
-            pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pUri, pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                    compareURI);
-            if ((pTemp != NULL) &&
-                ((pTemp->fixedEntry == TRUE) ||
-                 /* #367: Do both topocounts match? */
-                 ((pTemp->etbTopoCnt == appHandle->etbTopoCnt) && (pTemp->opTrnTopoCnt == appHandle->opTrnTopoCnt)) ||
-                 /* Or do we not care?       */
-                 ((appHandle->etbTopoCnt == 0u) && (appHandle->opTrnTopoCnt == 0u))) &&  
-                (pTemp->ipAddr != 0))                                                     /* 0 is only a placeholder */
+            err = dnrLookup(appHandle, pDNR, pUri, pAddr, FALSE);
+            if (err == TRDP_NO_ERR)
             {
-                *pAddr = pTemp->ipAddr;
                 return TRDP_NO_ERR;
             }
-            else    /* address is not known or out of date (topocounts differ)  */
+            if ((err == TRDP_UNRESOLVED_ERR) || (i == 2))
             {
-                if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
-                {
-                    updateTCNDNSentry(appHandle, pTemp, pUri);   /* Update everything, at least this URI */
-                }
-                else
-                {
-                    updateDNSentry(appHandle, pTemp, pUri);
-                }
-                /* try resolving again... */
+                break;
             }
+            if (err == TRDP_BLOCK_ERR)
+            {
+                /* another thread is asking for it, share its answer    */
+                dnrWaitPending(pDNR, pUri);
+            }
+            else if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
+            {
+                updateTCNDNSentry(appHandle, pUri);   /* Update everything, at least this URI */
+            }
+            else
+            {
+                updateDNSentry(appHandle, pUri);
+            }
+            /* try resolving again... */
         }
     }
 
@@ -1307,6 +1728,82 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     return TRDP_UNRESOLVED_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Function to convert a URI to an IP address without waiting for the name server.
+ *
+ *  Same as tau_uri2Addr, but returns at once if the URI is not in the cache. The query is then sent by a resolver
+ *  thread (started with the first call) and the address can be read by calling again later.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[out]     pAddr           Pointer to return the IP address
+ *  @param[in]      pUri            Pointer to an URI or an IP Address string, NULL==own URI
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_BLOCK_ERR      Resolution in progress, try again later
+ *  @retval         TRDP_UNRESOLVED_ERR Could not resolve error
+ *  @retval         TRDP_THREAD_ERR     Resolver thread could not be started
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrNoWait (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      *pAddr,
+    const TRDP_URI_T    pUri)
+{
+    TAU_DNR_DATA_T  *pDNR;
+    TRDP_ERR_T      err;
+
+    if (appHandle == NULL ||
+        pAddr == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* If no URI given, we return our own address   */
+    if (pUri == NULL)
+    {
+        *pAddr = tau_getOwnAddr(appHandle);
+        return TRDP_NO_ERR;
+    }
+
+    /* Check for dotted IP address  */
+    if ((*pAddr = vos_dottedIP(pUri)) != VOS_INADDR_ANY)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    if (pDNR == NULL)
+    {
+        return TRDP_UNRESOLVED_ERR;
+    }
+
+    err = dnrLookup(appHandle, pDNR, pUri, pAddr, TRUE);
+    if (err == TRDP_BLOCK_ERR)
+    {
+        (void) vos_mutexLock(pDNR->mutex);
+        if (pDNR->resolverRunning == FALSE)
+        {
+            pDNR->resolverStop      = FALSE;
+            pDNR->resolverRunning   = TRUE;
+            if (vos_threadCreate(&pDNR->resolverThread, "DNR resolver", VOS_THREAD_POLICY_OTHER,
+                                 VOS_THREAD_PRIORITY_DEFAULT, 0u, 0u, dnrResolverThread, appHandle) != VOS_NO_ERR)
+            {
+                pDNR->resolverRunning = FALSE;
+                vos_printLogStr(VOS_LOG_ERROR, "tau_uri2AddrNoWait failed to start resolver thread\n");
+                err = TRDP_THREAD_ERR;
+            }
+        }
+        (void) vos_mutexUnlock(pDNR->mutex);
+        vos_semaGive(pDNR->resolverSema);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        *pAddr = VOS_INADDR_ANY;
+    }
+    return err;
+}
+
 EXT_DECL TRDP_IP_ADDR_T tau_ipFromURI (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_URI_HOST_T     uri)
@@ -1348,6 +1845,7 @@ EXT_DECL TRDP_ERR_T tau_addr2Uri (
     if ((addr != VOS_INADDR_ANY) && (pDNR != NULL))
     {
         UINT32 i;
+        (void) vos_mutexLock(pDNR->mutex);
         for (i = 0u; i < pDNR->noOfCachedEntries; ++i)
         {
             if ((pDNR->cache[i].ipAddr == addr) &&
@@ -1355,9 +1853,11 @@ EXT_DECL TRDP_ERR_T tau_addr2Uri (
                 ((appHandle->opTrnTopoCnt == 0u) || (pDNR->cache[i].opTrnTopoCnt == appHandle->opTrnTopoCnt)))
             {
                 vos_strncpy(pUri, pDNR->cache[i].uri, TRDP_MAX_URI_HOST_LEN - 1);
+                (void) vos_mutexUnlock(pDNR->mutex);
                 return TRDP_NO_ERR;
             }
         }
+        (void) vos_mutexUnlock(pDNR->mutex);
         /* address not in cache: Make reverse request */
         /* tbd */
 
@@ -0,0 +1,661 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_mdcq.c
+ *
+ * @brief           MD request completion queue
+ *
+ * @details         Requests are sent with tlm_request() using an internal callback. The callback runs inside
+ *                  tlc_process() and only copies the message info and data into a FIFO, which is drained by
+ *                  tau_mdcqReap() from any application thread.
+ *
+ *                  Each pending request occupies a slot. The pUserRef of the MD session is not a pointer but
+ *                  encodes the queue, the slot index and the slot's generation; events whose generation does not
+ *                  match (late events of a recycled slot, e.g. the confirm time-out of an Mq reply) are dropped.
+ *                  The queues are found through a small registry. Callbacks run with the session's MD mutex held,
+ *                  tau_mdcqDestroy() aborts the sessions of its queue and unregisters it under the same mutex.
+ *                  The queue mutex is never held while calling into the stack (tlc_process() holds the session
+ *                  mutexes while calling back into us).
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "trdp_types.h"
+#include "trdp_utils.h"
+#include "trdp_if_light.h"
+#include "tlc_if.h"
+#include "tau_mdcq.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if MD_SUPPORT
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_MDCQ_NO_SLOT    0xFFFFFFFFu
+
+/** Generations of a slot are counted modulo this, the user reference then fits 32 bits with the default limits */
+#define TAU_MDCQ_GEN_MASK   0x1FFFFu
+
+/** Atomic access to the registry of queues */
+#define MDCQ_CLAIM(pp, pExp, pNew)  __atomic_compare_exchange_n((pp), (pExp), (pNew), FALSE, __ATOMIC_SEQ_CST, \
+                                                                __ATOMIC_SEQ_CST)
+#define MDCQ_LOAD(pp)               __atomic_load_n((pp), __ATOMIC_SEQ_CST)
+#define MDCQ_STORE(pp, p)           __atomic_store_n((pp), (p), __ATOMIC_SEQ_CST)
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** State of a request slot */
+typedef enum
+{
+    TAU_MDCQ_SLOT_FREE      = 0,    /**< unused, in free list                                   */
+    TAU_MDCQ_SLOT_SUBMITTED = 1,    /**< tlm_request() called, session ID not yet known         */
+    TAU_MDCQ_SLOT_ACTIVE    = 2     /**< session ID known, waiting for the final completion     */
+} TAU_MDCQ_SLOT_STATE_T;
+
+/** One pending request */
+typedef struct
+{
+    const void              *pToken;
+    TRDP_UUID_T             sessionId;
+    size_t                  userRef;        /**< pUserRef of the current request                        */
+    UINT32                  generation;     /**< incremented on each allocation                         */
+    UINT32                  nextFree;       /**< index of next free slot                                */
+    TAU_MDCQ_SLOT_STATE_T   state;
+} TAU_MDCQ_SLOT_T;
+
+/** One queued completion */
+typedef struct TAU_MDCQ_NODE
+{
+    struct TAU_MDCQ_NODE    *pNext;
+    TAU_MDCQ_ENTRY_T        entry;
+} TAU_MDCQ_NODE_T;
+
+/** Completion queue */
+struct TAU_MDCQ
+{
+    TRDP_APP_SESSION_T  appHandle;
+    UINT32              queueIdx;       /**< index into the registry                                    */
+    VOS_MUTEX_T         mutex;          /**< protects slots and FIFO                                    */
+    VOS_SEMA_T          sema;           /**< counts the completions in the FIFO                         */
+    TAU_MDCQ_SLOT_T     *pSlots;
+    UINT32              numSlots;
+    UINT32              freeHead;
+    UINT32              inFlight;
+    TAU_MDCQ_NODE_T     *pHead;
+    TAU_MDCQ_NODE_T     *pTail;
+};
+
+/***********************************************************************************************************************
+ *   Locals
+ */
+
+static struct TAU_MDCQ *sMdcq[TAU_MDCQ_MAX_QUEUES];     /**< registry, to find a queue by the user reference   */
+
+/**********************************************************************************************************************/
+/**    Build the user reference of a request from queue, slot index and generation (never 0).
+ *
+ *  @param[in]      queueIdx            Index of the queue in the registry
+ *  @param[in]      slotIdx             Index of the slot
+ *  @param[in]      generation          Generation of the slot
+ *
+ *  @retval         user reference
+ */
+static size_t tau_mdcqUserRef (
+    UINT32  queueIdx,
+    UINT32  slotIdx,
+    UINT32  generation)
+{
+    return ((size_t) generation * TAU_MDCQ_MAX_IN_FLIGHT + slotIdx) * TAU_MDCQ_MAX_QUEUES + queueIdx + 1u;
+}
+
+/**********************************************************************************************************************/
+/**    Free a queued completion together with its data copy.
+ *
+ *  @param[in]      pNode               Node to free
+ */
+static void tau_mdcqFreeNode (
+    TAU_MDCQ_NODE_T *pNode)
+{
+    if (pNode->entry.pData != NULL)
+    {
+        vos_memFree(pNode->entry.pData);
+    }
+    vos_memFree(pNode);
+}
+
+/**********************************************************************************************************************/
+/**    Return a slot to the free list, called with the queue mutex held.
+ *
+ *  @param[in]      pCq                 Completion queue
+ *  @param[in]      pSlot               Slot to release
+ */
+static void tau_mdcqFreeSlot (
+    struct TAU_MDCQ *pCq,
+    TAU_MDCQ_SLOT_T *pSlot)
+{
+    pSlot->state    = TAU_MDCQ_SLOT_FREE;
+    pSlot->pToken   = NULL;
+    pSlot->userRef  = 0u;
+    pSlot->nextFree = pCq->freeHead;
+    pCq->freeHead   = (UINT32) (pSlot - pCq->pSlots);
+    pCq->inFlight--;
+}
+
+/**********************************************************************************************************************/
+/**    MD callback of all requests of a completion queue.
+ *  Runs inside tlc_process(), queues the event and wakes up a reaper.
+ *
+ *  @param[in]      pRefCon         unused (session default)
+ *  @param[in]      appHandle       application handle
+ *  @param[in]      pMsg            message info, pUserRef identifies queue, slot and generation
+ *  @param[in]      pData           reply data
+ *  @param[in]      dataSize        size of reply data
+ */
+static void tau_mdcqCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    size_t          userRef = (size_t) pMsg->pUserRef;
+    struct TAU_MDCQ *pCq;
+    TAU_MDCQ_SLOT_T *pSlot;
+    TAU_MDCQ_NODE_T *pNode;
+    UINT32          slotIdx;
+    BOOL8           isFinal;
+
+    (void) pRefCon;
+    (void) appHandle;
+
+    if (userRef == 0u)
+    {
+        return;
+    }
+    /*  The queue cannot go away meanwhile: tau_mdcqDestroy() unregisters it under the MD mutex we are called with */
+    pCq     = MDCQ_LOAD(&sMdcq[(userRef - 1u) % TAU_MDCQ_MAX_QUEUES]);
+    slotIdx = (UINT32) (((userRef - 1u) / TAU_MDCQ_MAX_QUEUES) % TAU_MDCQ_MAX_IN_FLIGHT);
+    if ((pCq == NULL) || (slotIdx >= pCq->numSlots))
+    {
+        return;
+    }
+    pSlot = &pCq->pSlots[slotIdx];
+
+    /*  Copy outside the lock, the reply data is only valid during the callback    */
+    pNode = (TAU_MDCQ_NODE_T *) vos_memAlloc(sizeof(TAU_MDCQ_NODE_T));
+    if (pNode != NULL)
+    {
+        pNode->entry.resultCode = pMsg->resultCode;
+        pNode->entry.msgInfo    = *pMsg;
+        if ((pData != NULL) && (dataSize > 0u))
+        {
+            pNode->entry.pData = (UINT8 *) vos_memAlloc(dataSize);
+            if (pNode->entry.pData != NULL)
+            {
+                memcpy(pNode->entry.pData, pData, dataSize);
+                pNode->entry.dataSize = dataSize;
+            }
+            else
+            {
+                pNode->entry.resultCode = TRDP_MEM_ERR;
+            }
+        }
+    }
+
+    /*  A Mq reply ends the request for us, the application still has to confirm it    */
+    isFinal = (pMsg->aboutToDie == TRUE) ||
+        (pMsg->resultCode != TRDP_NO_ERR) ||
+        (pMsg->msgType == TRDP_MSG_MQ);
+
+    if (vos_mutexLock(pCq->mutex) != VOS_NO_ERR)
+    {
+        if (pNode != NULL)
+        {
+            tau_mdcqFreeNode(pNode);
+        }
+        return;
+    }
+
+    /*  Drop late events of a request which already completed (the slot may have been reused since)   */
+    if ((pSlot->userRef != userRef) ||
+        (pSlot->state == TAU_MDCQ_SLOT_FREE) ||
+        ((pSlot->state == TAU_MDCQ_SLOT_ACTIVE) &&
+         (memcmp(pSlot->sessionId, pMsg->sessionId, TRDP_SESS_ID_SIZE) != 0)))
+    {
+        (void) vos_mutexUnlock(pCq->mutex);
+        if (pNode != NULL)
+        {
+            tau_mdcqFreeNode(pNode);
+        }
+        return;
+    }
+
+    if (pSlot->state == TAU_MDCQ_SLOT_SUBMITTED)
+    {
+        /*  Event arrived before tlm_request() returned   */
+        memcpy(pSlot->sessionId, pMsg->sessionId, TRDP_SESS_ID_SIZE);
+        pSlot->state = TAU_MDCQ_SLOT_ACTIVE;
+    }
+
+    if (pNode != NULL)
+    {
+        pNode->entry.pToken             = pSlot->pToken;
+        pNode->entry.isFinal            = isFinal;
+        pNode->entry.msgInfo.pUserRef   = pSlot->pToken;
+        if (pCq->pTail != NULL)
+        {
+            pCq->pTail->pNext = pNode;
+        }
+        else
+        {
+            pCq->pHead = pNode;
+        }
+        pCq->pTail = pNode;
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_mdcq: completion of comId %u lost (out of memory)\n", pMsg->comId);
+    }
+
+    if (isFinal == TRUE)
+    {
+        tau_mdcqFreeSlot(pCq, pSlot);
+    }
+
+    (void) vos_mutexUnlock(pCq->mutex);
+
+    if (pNode != NULL)
+    {
+        vos_semaGive(pCq->sema);
+    }
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Create a completion queue for MD requests of a session.
+ *
+ *  @param[in]      appHandle           Application handle
+ *  @param[in]      maxInFlight         Max. number of requests pending at the same time (1...TAU_MDCQ_MAX_IN_FLIGHT)
+ *  @param[out]     pCq                 Pointer to the completion queue handle
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_SEMA_ERR       semaphore or mutex could not be created
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqCreate (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              maxInFlight,
+    TAU_MDCQ_T          *pCq)
+{
+    struct TAU_MDCQ *pNew;
+    struct TAU_MDCQ *pExpected;
+    UINT32          i;
+
+    if ((pCq == NULL) || (maxInFlight == 0u) || (maxInFlight > TAU_MDCQ_MAX_IN_FLIGHT))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (appHandle == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pNew = (struct TAU_MDCQ *) vos_memAlloc(sizeof(struct TAU_MDCQ));
+    if (pNew == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pNew->pSlots = (TAU_MDCQ_SLOT_T *) vos_memAlloc(maxInFlight * sizeof(TAU_MDCQ_SLOT_T));
+    if (pNew->pSlots == NULL)
+    {
+        vos_memFree(pNew);
+        return TRDP_MEM_ERR;
+    }
+    if (vos_mutexCreate(&pNew->mutex) != VOS_NO_ERR)
+    {
+        vos_memFree(pNew->pSlots);
+        vos_memFree(pNew);
+        return TRDP_SEMA_ERR;
+    }
+    if (vos_semaCreate(&pNew->sema, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_mutexDelete(pNew->mutex);
+        vos_memFree(pNew->pSlots);
+        vos_memFree(pNew);
+        return TRDP_SEMA_ERR;
+    }
+
+    for (i = 0u; i < maxInFlight; i++)
+    {
+        pNew->pSlots[i].nextFree = (i + 1u < maxInFlight) ? (i + 1u) : TAU_MDCQ_NO_SLOT;
+    }
+    pNew->appHandle = appHandle;
+    pNew->numSlots  = maxInFlight;
+    pNew->freeHead  = 0u;
+
+    /*  Register, the index becomes part of the user references  */
+    for (i = 0u; i < TAU_MDCQ_MAX_QUEUES; i++)
+    {
+        pExpected = NULL;
+        if (MDCQ_CLAIM(&sMdcq[i], &pExpected, pNew))
+        {
+            pNew->queueIdx = i;
+            *pCq = pNew;
+            return TRDP_NO_ERR;
+        }
+    }
+    vos_semaDelete(pNew->sema);
+    vos_mutexDelete(pNew->mutex);
+    vos_memFree(pNew->pSlots);
+    vos_memFree(pNew);
+    return TRDP_MEM_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Destroy a completion queue.
+ *  Requests still pending, and Mq sessions still awaiting their confirmation, are aborted. Completions not yet
+ *  reaped are discarded. Must not be called from within tlc_process() (i.e. from a TRDP callback).
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqDestroy (
+    TAU_MDCQ_T cq)
+{
+    TAU_MDCQ_NODE_T *pNode;
+    MD_ELE_T        *iterMD;
+    BOOL8           locked = FALSE;
+    UINT32          i;
+
+    if (cq == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*  Abort every session still calling back into this queue, pending requests as well as Mq replies awaiting
+        their confirmation, and unregister the queue. Callbacks run with the MD mutex held, hence none can reach
+        the queue afterwards. Our own mutex is not taken, it must not nest inside the MD mutex.   */
+    if (trdp_isValidSession(cq->appHandle) && (vos_mutexLock(cq->appHandle->mutexMD) == VOS_NO_ERR))
+    {
+        locked = TRUE;
+        for (i = 0u; i < 2u; i++)
+        {
+            for (iterMD = (i == 0u) ? cq->appHandle->pMDSndQueue : cq->appHandle->pMDRcvQueue;
+                 iterMD != NULL;
+                 iterMD = iterMD->pNext)
+            {
+                if ((iterMD->pfCbFunction == tau_mdcqCallback) &&
+                    (((size_t) iterMD->pUserRef - 1u) % TAU_MDCQ_MAX_QUEUES == cq->queueIdx))
+                {
+                    (void) tlm_abortSession(cq->appHandle, (const TRDP_UUID_T *) &iterMD->sessionID);
+                }
+            }
+        }
+    }
+    MDCQ_STORE(&sMdcq[cq->queueIdx], NULL);
+    if (locked == TRUE)
+    {
+        (void) vos_mutexUnlock(cq->appHandle->mutexMD);
+    }
+
+    while (cq->pHead != NULL)
+    {
+        pNode       = cq->pHead;
+        cq->pHead   = pNode->pNext;
+        tau_mdcqFreeNode(pNode);
+    }
+
+    vos_semaDelete(cq->sema);
+    vos_mutexDelete(cq->mutex);
+    vos_memFree(cq->pSlots);
+    vos_memFree(cq);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Submit a MD request, its reply will be queued as completion.
+ *  The parameters are the same as for tlm_request(), the callback is replaced by the user token.
+ *  May be called from any thread.
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *  @param[in]      pToken              user token returned with each completion of this request
+ *  @param[out]     pSessionId          return session ID, may be NULL
+ *  @param[in]      comId               comId of packet to be sent
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
+ *  @param[in]      destIpAddr          where to send the packet to
+ *  @param[in]      pktFlags            OPTION: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_TCP
+ *  @param[in]      numReplies          number of expected replies, 0 if unknown
+ *  @param[in]      replyTimeout        timeout for reply, 0 for the session default
+ *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
+ *  @param[in]      pData               pointer to packet data / dataset
+ *  @param[in]      dataSize            size of packet data
+ *  @param[in]      srcURI              only functional group of source URI
+ *  @param[in]      destURI             only functional group of destination URI
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_QUEUE_FULL_ERR maxInFlight requests are already pending
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqRequest (
+    TAU_MDCQ_T              cq,
+    const void              *pToken,
+    TRDP_UUID_T             *pSessionId,
+    UINT32                  comId,
+    UINT32                  etbTopoCnt,
+    UINT32                  opTrnTopoCnt,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          destIpAddr,
+    TRDP_FLAGS_T            pktFlags,
+    UINT32                  numReplies,
+    UINT32                  replyTimeout,
+    const TRDP_COM_PARAM_T  *pSendParam,
+    const UINT8             *pData,
+    UINT32                  dataSize,
+    const TRDP_URI_USER_T   srcURI,
+    const TRDP_URI_USER_T   destURI)
+{
+    TAU_MDCQ_SLOT_T *pSlot;
+    TRDP_UUID_T     sessionId;
+    size_t          userRef;
+    TRDP_ERR_T      err;
+
+    if (cq == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(cq->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (cq->freeHead == TAU_MDCQ_NO_SLOT)
+    {
+        (void) vos_mutexUnlock(cq->mutex);
+        return TRDP_QUEUE_FULL_ERR;
+    }
+    pSlot           = &cq->pSlots[cq->freeHead];
+    cq->freeHead    = pSlot->nextFree;
+    cq->inFlight++;
+    pSlot->generation   = (pSlot->generation + 1u) & TAU_MDCQ_GEN_MASK;
+    userRef             = tau_mdcqUserRef(cq->queueIdx, (UINT32) (pSlot - cq->pSlots), pSlot->generation);
+    pSlot->userRef      = userRef;
+    pSlot->pToken       = pToken;
+    pSlot->state        = TAU_MDCQ_SLOT_SUBMITTED;
+    memset(pSlot->sessionId, 0, TRDP_SESS_ID_SIZE);
+    (void) vos_mutexUnlock(cq->mutex);
+
+    err = tlm_request(cq->appHandle, (const void *) userRef, tau_mdcqCallback, &sessionId, comId, etbTopoCnt, opTrnTopoCnt,
+                      srcIpAddr, destIpAddr, pktFlags, numReplies, replyTimeout, pSendParam, pData, dataSize,
+                      srcURI, destURI);
+
+    if (vos_mutexLock(cq->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    /*  The callback may already have completed (and someone else reused) the slot  */
+    if ((pSlot->userRef == userRef) && (pSlot->state == TAU_MDCQ_SLOT_SUBMITTED))
+    {
+        if (err == TRDP_NO_ERR)
+        {
+            memcpy(pSlot->sessionId, sessionId, TRDP_SESS_ID_SIZE);
+            pSlot->state = TAU_MDCQ_SLOT_ACTIVE;
+        }
+        else
+        {
+            tau_mdcqFreeSlot(cq, pSlot);
+        }
+    }
+    (void) vos_mutexUnlock(cq->mutex);
+
+    if ((err == TRDP_NO_ERR) && (pSessionId != NULL))
+    {
+        memcpy(*pSessionId, sessionId, TRDP_SESS_ID_SIZE);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Reap completions.
+ *  Up to maxEntries completions are returned in submission order of their events. If none is available, the
+ *  call waits up to timeout us for the first one. May be called from any thread.
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *  @param[out]     pEntries            Array receiving the completions
+ *  @param[in]      maxEntries          Size of the array
+ *  @param[in]      timeout             Max. time in us to wait, 0 = don't wait, VOS_SEMA_WAIT_FOREVER
+ *  @param[out]     pNumEntries         Number of completions returned
+ *
+ *  @retval         TRDP_NO_ERR         no error, at least one completion returned
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_TIMEOUT_ERR    no completion available in time
+ */
+EXT_DECL TRDP_ERR_T tau_mdcqReap (
+    TAU_MDCQ_T          cq,
+    TAU_MDCQ_ENTRY_T    *pEntries,
+    UINT32              maxEntries,
+    UINT32              timeout,
+    UINT32              *pNumEntries)
+{
+    TAU_MDCQ_NODE_T *pNode;
+    UINT32          n = 0u;
+
+    if ((cq == NULL) || (pEntries == NULL) || (maxEntries == 0u) || (pNumEntries == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pNumEntries = 0u;
+
+    /*  Each semaphore count stands for one node already linked into the FIFO   */
+    if (vos_semaTake(cq->sema, timeout) != VOS_NO_ERR)
+    {
+        return TRDP_TIMEOUT_ERR;
+    }
+
+    if (vos_mutexLock(cq->mutex) != VOS_NO_ERR)
+    {
+        vos_semaGive(cq->sema);
+        return TRDP_NOINIT_ERR;
+    }
+    do
+    {
+        pNode       = cq->pHead;
+        cq->pHead   = pNode->pNext;
+        if (cq->pHead == NULL)
+        {
+            cq->pTail = NULL;
+        }
+        pEntries[n++] = pNode->entry;
+        vos_memFree(pNode);
+    }
+    while ((n < maxEntries) && (vos_semaTake(cq->sema, 0u) == VOS_NO_ERR));
+    (void) vos_mutexUnlock(cq->mutex);
+
+    *pNumEntries = n;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Release the reply data of reaped completions.
+ *
+ *  @param[in]      pEntries            Array of completions returned by tau_mdcqReap()
+ *  @param[in]      numEntries          Number of completions
+ */
+EXT_DECL void tau_mdcqRelease (
+    TAU_MDCQ_ENTRY_T    *pEntries,
+    UINT32              numEntries)
+{
+    UINT32 i;
+
+    if (pEntries == NULL)
+    {
+        return;
+    }
+    for (i = 0u; i < numEntries; i++)
+    {
+        if (pEntries[i].pData != NULL)
+        {
+            vos_memFree(pEntries[i].pData);
+            pEntries[i].pData = NULL;
+        }
+        pEntries[i].dataSize = 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Return the number of submitted requests which have not yet reported their final completion.
+ *
+ *  @param[in]      cq                  Completion queue handle
+ *
+ *  @retval         number of requests in flight
+ */
+EXT_DECL UINT32 tau_mdcqInFlight (
+    TAU_MDCQ_T cq)
+{
+    UINT32 inFlight = 0u;
+
+    if ((cq != NULL) && (vos_mutexLock(cq->mutex) == VOS_NO_ERR))
+    {
+        inFlight = cq->inFlight;
+        (void) vos_mutexUnlock(cq->mutex);
+    }
+    return inFlight;
+}
+
+#endif /* MD_SUPPORT */
+
+#ifdef __cplusplus
+}
+#endif
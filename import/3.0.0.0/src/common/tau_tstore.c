@@ -0,0 +1,594 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_tstore.c
+ *
+ * @brief           Shared memory traffic store
+ *
+ * @details         The shared memory area holds a header followed by noOfSlots slots of slotSize bytes each. A slot
+ *                  starts with its sequence counter and the telegram status, the payload follows 8 byte aligned.
+ *                  The owner increments the sequence counter before and after writing a slot, an odd value marks
+ *                  a write in progress. Readers copy the slot and accept the copy only if the counter was even
+ *                  and unchanged; the owner never waits for them and they never write to the area.
+ *                  ComId and source address of a slot are set once before the slot is published by incrementing
+ *                  usedSlots and are not protected by the sequence counter.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "trdp_types.h"
+#include "trdp_utils.h"
+#include "vos_shared_mem.h"
+#include "tau_tstore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TS_MAGIC            0x53545254u             /**< 'TRTS'                                                 */
+#define TS_ALIGN            8u
+#define TS_READ_SPINS       64u                     /**< attempts before the reader yields the CPU              */
+#define TS_READ_RETRIES     (TS_READ_SPINS * 1000u) /**< attempts before a slot is considered stuck             */
+
+/* The sequence counters are shared between processes, a process-local mutex cannot protect them. Without GCC/clang
+   atomics the counters are accessed as volatile, which orders them on compilers treating volatile as
+   acquire/release (e.g. MSVC /volatile:ms on x86/x64). */
+#if defined(__GNUC__) || defined(__clang__)
+#define TS_LOAD(p)          __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define TS_STORE(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define TS_SEQ_INC(p)       ((void) __atomic_add_fetch((p), 1u, __ATOMIC_SEQ_CST))
+#define TS_FENCE()          __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define TS_LOAD(p)          (*(volatile const UINT32 *)(p))
+#define TS_STORE(p, v)      ((void) (*(volatile UINT32 *)(p) = (v)))
+#define TS_SEQ_INC(p)       ((void) (++(*(volatile UINT32 *)(p))))
+#define TS_FENCE()
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Store header, at offset 0 */
+typedef struct
+{
+    UINT32  magic;              /**< TS_MAGIC, written last by the owner, 0 once closed                 */
+    UINT16  version;
+    UINT16  headerSize;
+    UINT32  slotHeaderSize;     /**< sizeof(TS_SLOT_T), rejects readers of a different build             */
+    UINT32  slotSize;           /**< distance between slots                                              */
+    UINT32  maxDataSize;
+    UINT32  noOfSlots;
+    UINT32  usedSlots;          /**< slots with valid comId, incremented after the slot is set up        */
+    UINT32  reserved;
+} TS_HEADER_T;
+
+/** Slot header, followed by the payload */
+typedef struct
+{
+    UINT32  seq;                /**< odd while the owner writes the slot                                 */
+    UINT32  comId;
+    UINT32  srcIpAddr;
+    INT32   resultCode;
+    UINT32  seqCount;
+    UINT32  dataSize;
+    UINT32  updates;
+    UINT32  usec;
+    INT64   sec;
+} TS_SLOT_T;
+
+/** Process-local handle */
+struct TAU_TSTORE
+{
+    UINT8       *pArea;         /**< mapped area, read-only for readers                                  */
+    UINT32      size;           /**< size of the mapping                                                  */
+    UINT32      noOfSlots;      /**< geometry seen at open/attach                                         */
+    UINT32      slotSize;
+    UINT32      maxDataSize;
+    VOS_SHRD_T  shrd;           /**< owner only, NULL for readers                                         */
+};
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+#define TS_SLOT_DATA_OFS    ((UINT32) ((sizeof(TS_SLOT_T) + TS_ALIGN - 1u) & ~(TS_ALIGN - 1u)))
+#define TS_HEADER_SIZE      ((UINT32) ((sizeof(TS_HEADER_T) + TS_ALIGN - 1u) & ~(TS_ALIGN - 1u)))
+
+/**********************************************************************************************************************/
+/** Slot by index
+ *
+ *  @param[in]      pStore          Traffic store handle
+ *  @param[in]      slot            Slot index (checked by the caller)
+ *  @retval         pointer to the slot
+ */
+static TS_SLOT_T *ts_slot (
+    const struct TAU_TSTORE *pStore,
+    UINT32                  slot)
+{
+    return (TS_SLOT_T *) (pStore->pArea + TS_HEADER_SIZE + slot * pStore->slotSize);
+}
+
+/**********************************************************************************************************************/
+/** Check that the store is still the one we opened/attached
+ *
+ *  @param[in]      pStore          Traffic store handle
+ *  @retval         TRUE            valid
+ */
+static BOOL8 ts_valid (
+    const struct TAU_TSTORE *pStore)
+{
+    const TS_HEADER_T *pHeader = (const TS_HEADER_T *) pStore->pArea;
+
+    return (TS_LOAD(&pHeader->magic) == TS_MAGIC)
+           && (pHeader->noOfSlots == pStore->noOfSlots)
+           && (pHeader->slotSize == pStore->slotSize);
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of a telegram
+ *
+ *  @param[in]      pStore          Traffic store handle
+ *  @param[in]      comId           ComId of the telegram
+ *  @param[in]      srcIpAddr       Source IP address
+ *  @param[in]      anySource       TRUE: match the first slot of the ComId regardless of srcIpAddr
+ *  @param[out]     pSlot           Pointer to returned slot index
+ *  @retval         TRUE            found
+ */
+static BOOL8 ts_find (
+    const struct TAU_TSTORE *pStore,
+    UINT32                  comId,
+    UINT32                  srcIpAddr,
+    BOOL8                   anySource,
+    UINT32                  *pSlot)
+{
+    const TS_SLOT_T *pSlotHdr;
+    UINT32          used;
+    UINT32          i;
+
+    used = TS_LOAD(&((const TS_HEADER_T *) pStore->pArea)->usedSlots);
+    if (used > pStore->noOfSlots)
+    {
+        used = pStore->noOfSlots;
+    }
+    for (i = 0u; i < used; i++)
+    {
+        pSlotHdr = ts_slot(pStore, i);
+        if ((pSlotHdr->comId == comId)
+            && (anySource || (pSlotHdr->srcIpAddr == srcIpAddr)))
+        {
+            *pSlot = i;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Create a traffic store (owner).
+ *
+ *  @param[out]     pStore          Pointer to returned handle
+ *  @param[in]      pName           Name of the shared memory area (e.g. "/trdp_ts")
+ *  @param[in]      noOfSlots       Maximum number of telegrams
+ *  @param[in]      maxDataSize     Maximum payload size of a telegram (<= TRDP_MAX_PD_DATA_SIZE)
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_MEM_ERR    shared memory could not be created
+ */
+EXT_DECL TRDP_ERR_T tau_tsCreate (
+    TAU_TSTORE_T    *pStore,
+    const CHAR8     *pName,
+    UINT32          noOfSlots,
+    UINT32          maxDataSize)
+{
+    struct TAU_TSTORE   *pNew;
+    TS_HEADER_T         *pHeader;
+    UINT32              slotSize;
+    UINT32              size;
+
+    if ((pStore == NULL) || (pName == NULL) || (noOfSlots == 0u) || (noOfSlots > 0xFFFFu)
+        || (maxDataSize == 0u) || (maxDataSize > TRDP_MAX_PD_DATA_SIZE))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    slotSize    = (TS_SLOT_DATA_OFS + maxDataSize + TS_ALIGN - 1u) & ~(TS_ALIGN - 1u);
+    size        = TS_HEADER_SIZE + noOfSlots * slotSize;
+
+    pNew = (struct TAU_TSTORE *) vos_memAlloc(sizeof(struct TAU_TSTORE));
+    if (pNew == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pNew->size = size;
+    if ((vos_sharedOpen(pName, &pNew->shrd, &pNew->pArea, &pNew->size) != VOS_NO_ERR)
+        || (pNew->size < size))
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_tsCreate() could not create traffic store %s\n", pName);
+        vos_memFree(pNew);
+        return TRDP_MEM_ERR;
+    }
+    pNew->noOfSlots     = noOfSlots;
+    pNew->slotSize      = slotSize;
+    pNew->maxDataSize   = maxDataSize;
+
+    /* Readers still attached to a previous store see the magic vanish while it is set up again */
+    pHeader = (TS_HEADER_T *) pNew->pArea;
+    TS_STORE(&pHeader->magic, 0u);
+    memset(pNew->pArea + sizeof(pHeader->magic), 0, size - sizeof(pHeader->magic));
+    pHeader->version        = TAU_TS_VERSION;
+    pHeader->headerSize     = (UINT16) TS_HEADER_SIZE;
+    pHeader->slotHeaderSize = (UINT32) sizeof(TS_SLOT_T);
+    pHeader->slotSize       = slotSize;
+    pHeader->maxDataSize    = maxDataSize;
+    pHeader->noOfSlots      = noOfSlots;
+    TS_STORE(&pHeader->magic, TS_MAGIC);
+
+    *pStore = pNew;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Attach read-only to a traffic store (reader).
+ *
+ *  @param[out]     pStore          Pointer to returned handle
+ *  @param[in]      pName           Name of the shared memory area used by the owner
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_IO_ERR     store does not exist
+ *  @retval         TRDP_INIT_ERR   store not yet initialized by its owner or of a different layout
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_tsAttach (
+    TAU_TSTORE_T    *pStore,
+    const CHAR8     *pName)
+{
+    struct TAU_TSTORE   *pNew;
+    const TS_HEADER_T   *pHeader;
+    const UINT8         *pArea;
+    UINT32              size;
+    VOS_ERR_T           err;
+
+    if ((pStore == NULL) || (pName == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    err = vos_sharedAttach(pName, &pArea, &size);
+    if (err != VOS_NO_ERR)
+    {
+        return (err == VOS_IO_ERR) ? TRDP_IO_ERR : TRDP_MEM_ERR;
+    }
+
+    pHeader = (const TS_HEADER_T *) pArea;
+    if ((size < TS_HEADER_SIZE)
+        || (TS_LOAD(&pHeader->magic) != TS_MAGIC)
+        || (pHeader->version != TAU_TS_VERSION)
+        || (pHeader->headerSize != TS_HEADER_SIZE)
+        || (pHeader->slotHeaderSize != sizeof(TS_SLOT_T))
+        || (pHeader->slotSize < TS_SLOT_DATA_OFS + pHeader->maxDataSize)
+        || ((UINT64) TS_HEADER_SIZE + (UINT64) pHeader->noOfSlots * pHeader->slotSize > size))
+    {
+        (void) vos_fileUnmap(pArea, size);
+        return TRDP_INIT_ERR;
+    }
+
+    pNew = (struct TAU_TSTORE *) vos_memAlloc(sizeof(struct TAU_TSTORE));
+    if (pNew == NULL)
+    {
+        (void) vos_fileUnmap(pArea, size);
+        return TRDP_MEM_ERR;
+    }
+    pNew->pArea         = (UINT8 *) pArea;      /* never written through, the mapping is read-only */
+    pNew->size          = size;
+    pNew->noOfSlots     = pHeader->noOfSlots;
+    pNew->slotSize      = pHeader->slotSize;
+    pNew->maxDataSize   = pHeader->maxDataSize;
+    pNew->shrd          = NULL;
+
+    *pStore = pNew;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Close a traffic store.
+ *
+ *  @param[in]      store           Handle returned by tau_tsCreate() or tau_tsAttach()
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ */
+EXT_DECL TRDP_ERR_T tau_tsClose (
+    TAU_TSTORE_T store)
+{
+    if (store == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (store->shrd != NULL)
+    {
+        TS_STORE(&((TS_HEADER_T *) store->pArea)->magic, 0u);
+        (void) vos_sharedClose(store->shrd, store->pArea);
+    }
+    else
+    {
+        (void) vos_fileUnmap(store->pArea, store->size);
+    }
+    vos_memFree(store);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add a slot for a telegram (owner only).
+ *
+ *  @param[in]      store           Handle returned by tau_tsCreate()
+ *  @param[in]      comId           ComId of the telegram
+ *  @param[in]      srcIpAddr       Source IP address, 0 for any
+ *  @param[out]     pSlot           Pointer to returned slot index
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error or not the owner
+ *  @retval         TRDP_MEM_ERR    all slots in use
+ */
+EXT_DECL TRDP_ERR_T tau_tsAddSlot (
+    TAU_TSTORE_T    store,
+    UINT32          comId,
+    UINT32          srcIpAddr,
+    UINT32          *pSlot)
+{
+    TS_HEADER_T *pHeader;
+    TS_SLOT_T   *pSlotHdr;
+    UINT32      used;
+
+    if ((store == NULL) || (store->shrd == NULL) || (pSlot == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (ts_find(store, comId, srcIpAddr, FALSE, pSlot))
+    {
+        return TRDP_NO_ERR;
+    }
+
+    pHeader = (TS_HEADER_T *) store->pArea;
+    used    = pHeader->usedSlots;
+    if (used >= store->noOfSlots)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    pSlotHdr = ts_slot(store, used);
+    pSlotHdr->comId         = comId;
+    pSlotHdr->srcIpAddr     = srcIpAddr;
+    pSlotHdr->resultCode    = (INT32) TRDP_NODATA_ERR;
+    TS_STORE(&pHeader->usedSlots, used + 1u);
+
+    *pSlot = used;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of a telegram.
+ *
+ *  @param[in]      store           Traffic store handle
+ *  @param[in]      comId           ComId of the telegram
+ *  @param[in]      srcIpAddr       Source IP address, 0 matches the first slot of the ComId
+ *  @param[out]     pSlot           Pointer to returned slot index
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error
+ *  @retval         TRDP_COMID_ERR  telegram not stored
+ *  @retval         TRDP_NOINIT_ERR store was closed by its owner
+ */
+EXT_DECL TRDP_ERR_T tau_tsFindSlot (
+    TAU_TSTORE_T    store,
+    UINT32          comId,
+    UINT32          srcIpAddr,
+    UINT32          *pSlot)
+{
+    if ((store == NULL) || (pSlot == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!ts_valid(store))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    return ts_find(store, comId, srcIpAddr, (srcIpAddr == 0u), pSlot) ? TRDP_NO_ERR : TRDP_COMID_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Write the latest state of a telegram (owner only).
+ *
+ *  @param[in]      store           Handle returned by tau_tsCreate()
+ *  @param[in]      slot            Slot index
+ *  @param[in]      pInfo           Receive info (result code, sequence counter), NULL for TRDP_NO_ERR
+ *  @param[in]      pData           Payload, NULL to update the result code only and keep the last payload
+ *  @param[in]      dataSize        Payload size
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error, not the owner or payload too big
+ */
+EXT_DECL TRDP_ERR_T tau_tsWrite (
+    TAU_TSTORE_T            store,
+    UINT32                  slot,
+    const TRDP_PD_INFO_T    *pInfo,
+    const UINT8             *pData,
+    UINT32                  dataSize)
+{
+    TS_SLOT_T   *pSlotHdr;
+    TRDP_TIME_T now;
+
+    if ((store == NULL) || (store->shrd == NULL) || (slot >= store->noOfSlots)
+        || ((pData != NULL) && (dataSize > store->maxDataSize)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    vos_getTime(&now);
+    pSlotHdr = ts_slot(store, slot);
+
+    TS_SEQ_INC(&pSlotHdr->seq);
+    TS_FENCE();
+    pSlotHdr->resultCode    = (INT32) ((pInfo != NULL) ? pInfo->resultCode : TRDP_NO_ERR);
+    pSlotHdr->updates++;
+    pSlotHdr->sec           = (INT64) now.tv_sec;
+    pSlotHdr->usec          = (UINT32) now.tv_usec;
+    if (pData != NULL)
+    {
+        pSlotHdr->seqCount  = (pInfo != NULL) ? pInfo->seqCount : 0u;
+        pSlotHdr->dataSize  = dataSize;
+        memcpy((UINT8 *) pSlotHdr + TS_SLOT_DATA_OFS, pData, dataSize);
+    }
+    TS_FENCE();
+    TS_SEQ_INC(&pSlotHdr->seq);
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Read the latest state of a telegram.
+ *
+ *  @param[in]      store           Traffic store handle
+ *  @param[in]      slot            Slot index
+ *  @param[out]     pInfo           Pointer to returned slot status, may be NULL
+ *  @param[out]     pData           Pointer to payload buffer, may be NULL
+ *  @param[in,out]  pDataSize       In: size of the buffer, out: payload size (may be NULL if pData is NULL)
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  parameter error or buffer too small (*pDataSize holds the needed size)
+ *  @retval         TRDP_NOINIT_ERR store was closed by its owner
+ *  @retval         TRDP_BLOCK_ERR  slot is permanently being written (owner died while writing)
+ */
+EXT_DECL TRDP_ERR_T tau_tsRead (
+    TAU_TSTORE_T    store,
+    UINT32          slot,
+    TAU_TS_INFO_T   *pInfo,
+    UINT8           *pData,
+    UINT32          *pDataSize)
+{
+    const TS_SLOT_T *pSlotHdr;
+    TAU_TS_INFO_T   info;
+    UINT32          seq;
+    UINT32          dataSize;
+    UINT32          attempt;
+
+    if ((store == NULL) || (slot >= store->noOfSlots) || ((pData != NULL) && (pDataSize == NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!ts_valid(store))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pSlotHdr = ts_slot(store, slot);
+    for (attempt = 0u; attempt < TS_READ_RETRIES; attempt++)
+    {
+        if ((attempt != 0u) && ((attempt % TS_READ_SPINS) == 0u))
+        {
+            (void) vos_threadDelay(0u);         /* let a preempted owner finish its write */
+        }
+        seq = TS_LOAD(&pSlotHdr->seq);
+        if ((seq & 1u) != 0u)
+        {
+            continue;
+        }
+        TS_FENCE();
+
+        info.comId              = pSlotHdr->comId;
+        info.srcIpAddr          = pSlotHdr->srcIpAddr;
+        info.resultCode         = (TRDP_ERR_T) pSlotHdr->resultCode;
+        info.seqCount           = pSlotHdr->seqCount;
+        info.updates            = pSlotHdr->updates;
+        info.timeStamp.tv_sec   = pSlotHdr->sec;
+        info.timeStamp.tv_usec  = (INT32) pSlotHdr->usec;
+        dataSize                = pSlotHdr->dataSize;
+        if (dataSize > store->maxDataSize)
+        {
+            dataSize = store->maxDataSize;      /* torn read, discarded below */
+        }
+        if ((pData != NULL) && (dataSize <= *pDataSize))
+        {
+            memcpy(pData, (const UINT8 *) pSlotHdr + TS_SLOT_DATA_OFS, dataSize);
+        }
+
+        TS_FENCE();
+        if (TS_LOAD(&pSlotHdr->seq) == seq)
+        {
+            if (pInfo != NULL)
+            {
+                *pInfo = info;
+            }
+            if (pDataSize != NULL)
+            {
+                if ((pData != NULL) && (dataSize > *pDataSize))
+                {
+                    *pDataSize = dataSize;
+                    return TRDP_PARAM_ERR;
+                }
+                *pDataSize = dataSize;
+            }
+            return TRDP_NO_ERR;
+        }
+    }
+    return TRDP_BLOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** PD callback writing received telegrams into the traffic store.
+ *
+ *  @param[in]      pRefCon         Session context (unused)
+ *  @param[in]      appHandle       Session handle (unused)
+ *  @param[in]      pMsg            Receive info, pUserRef is the handle returned by tau_tsCreate()
+ *  @param[in]      pData           Payload
+ *  @param[in]      dataSize        Payload size
+ */
+EXT_DECL void tau_tsPdCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TAU_TSTORE_T    store;
+    UINT32          slot;
+
+    (void) pRefCon;
+    (void) appHandle;
+
+    if ((pMsg == NULL) || (pMsg->pUserRef == NULL))
+    {
+        return;
+    }
+    store = (TAU_TSTORE_T) pMsg->pUserRef;
+    /* A slot for the sender takes precedence over one for any source */
+    if (!ts_find(store, pMsg->comId, pMsg->srcIpAddr, FALSE, &slot)
+        && !ts_find(store, pMsg->comId, 0u, FALSE, &slot))
+    {
+        return;
+    }
+    /* A timeout keeps the last payload, only the result code changes */
+    (void) tau_tsWrite(store, slot, pMsg, (pMsg->resultCode == TRDP_NO_ERR) ? pData : NULL, dataSize);
+}
+
+#ifdef __cplusplus
+}
+#endif
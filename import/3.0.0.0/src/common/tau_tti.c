@@ -87,6 +87,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <ctype.h>
 
 #include "trdp_if_light.h"
 #include "trdp_utils.h"
@@ -106,12 +107,55 @@ extern "C" {
  * DEFINES
  */
 
-
+#define TAU_TTI_HASH_SIZE       128u    /**< Buckets of the consist indexes, power of 2 > TRDP_MAX_CST_CNT */
+
+/* Snapshot readers rely on the compiler's atomic builtins, without them they take the snapshot mutex */
+#if defined(__GNUC__) || defined(__clang__)
+#define TTI_SNAP_LOAD(p)        __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define TTI_SNAP_STORE(p, v)    __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define TTI_SNAP_INC(p)         __atomic_add_fetch((p), 1u, __ATOMIC_SEQ_CST)
+#define TTI_SNAP_DEC(p)         __atomic_sub_fetch((p), 1u, __ATOMIC_SEQ_CST)
+#else
+#define TTI_SNAP_LOCKED_READERS
+#define TTI_SNAP_LOAD(p)        (*(p))
+#define TTI_SNAP_STORE(p, v)    (*(p) = (v))
+#define TTI_SNAP_INC(p)         (++(*(p)))
+#define TTI_SNAP_DEC(p)         (--(*(p)))
+#endif
 
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+/** Index of a consist info array by UUID and by label (open addressing, slot + 1, 0 = empty) */
+typedef struct
+{
+    UINT8   byUUID[TAU_TTI_HASH_SIZE];
+    UINT8   byLabel[TAU_TTI_HASH_SIZE];
+} TAU_TTI_INDEX_T;
+
+/** Copy of a consist info shared by the snapshots, refCnt is changed with the snapshot mutex held */
+typedef struct
+{
+    UINT32              refCnt;
+    TRDP_CONSIST_INFO_T *pCstInfo;      /**< one memory block, see ttiCopyCstInfo()  */
+} TAU_TTI_CST_COPY_T;
+
+struct TAU_TTI_SNAPSHOT
+{
+    struct TAU_TTI_SNAPSHOT *pNext;                     /**< next replaced snapshot waiting to be freed */
+    UINT32              readers;                        /**< number of acquisitions of this snapshot    */
+    UINT32              retireEpoch;                    /**< snapEpoch when it was replaced             */
+    UINT32              etbTopoCnt;
+    UINT32              opTrnTopoCnt;
+    UINT32              cstCnt;
+    BOOL8               ownCstValid;
+    TRDP_UUID_T         ownCstUUID;
+    TAU_TTI_CST_COPY_T  *pCopy[TRDP_MAX_CST_CNT];
+    TRDP_CONSIST_INFO_T *pCstInfo[TRDP_MAX_CST_CNT];    /**< pCopy[]->pCstInfo, for the index functions */
+    TAU_TTI_INDEX_T     index;
+};
+
 typedef struct TAU_TTDB
 {
     TRDP_SUB_T                      pd100SubHandle1;
@@ -124,6 +168,17 @@ typedef struct TAU_TTDB
     TRDP_TRAIN_NET_DIR_T            trnNetDir;
     TRDP_CONSIST_INFO_T             *cstInfo[TRDP_MAX_CST_CNT];     /**< NOTE: the consist info is a variable sized
                                                             struct / array and is stored in network representation */
+    TAU_TTI_INDEX_T                 index;                          /**< index of cstInfo[]                         */
+    BOOL8                           ownCstValid;                    /**< ownCstUUID was found in trnDir             */
+    UINT8                           ownTrnCstNo;                    /**< ownTrnCstNo ownCstUUID was searched for    */
+    TRDP_UUID_T                     ownCstUUID;
+    TAU_TTI_CST_COPY_T              *pCstCopy[TRDP_MAX_CST_CNT];    /**< copies of cstInfo[] for the snapshots      */
+    VOS_MUTEX_T                     snapMutex;                      /**< serialises snapshot updates                */
+    TAU_TTI_SNAPSHOT_T              *pSnapshot;                     /**< current snapshot, read without lock        */
+    TAU_TTI_SNAPSHOT_T              *pRetired;                      /**< replaced snapshots, not yet freed          */
+    UINT32                          snapEpoch;                      /**< advanced by ttiReclaimSnapshots()          */
+    UINT32                          snapLoading[2];                 /**< readers between loading pSnapshot and
+                                                                         counting it, by parity of their epoch      */
 } TAU_TTDB_T;
 
 /***********************************************************************************************************************
@@ -146,6 +201,24 @@ static TRDP_ERR_T ttiGetOwnCstUUID(
 static void ttiFreeCstInfoEntry(
     TRDP_CONSIST_INFO_T* pData);
 
+static TRDP_ERR_T ttiCopyCstInfo(
+    TRDP_CONSIST_INFO_T** ppDstCstInfo,
+    TRDP_CONSIST_INFO_T* pSrcCstInfo);
+
+static void ttiFreeCstSlot (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              slot);
+
+static void ttiUpdateOwnCstUUID (
+    TRDP_APP_SESSION_T  appHandle);
+
+static void ttiIndexBuild (
+    TAU_TTI_INDEX_T             *pIndex,
+    TRDP_CONSIST_INFO_T * const *ppCstInfo);
+
+static void ttiPublishSnapshot (
+    TRDP_APP_SESSION_T  appHandle);
+
 /**********************************************************************************************************************/
 /**    Function returns the UUID for the given UIC ID
  *      We need to search in the OP_TRAIN_DIR the OP_VEHICLE where the vehicle is the
@@ -227,6 +300,7 @@ static void ttiPDCallback (
     UINT32                  dataSize)
 {
     int         changed         = 0;
+    BOOL8       ownCstChanged   = FALSE;
     VOS_SEMA_T  waitForInaug    = (VOS_SEMA_T) pMsg->pUserRef;
     static      TRDP_IP_ADDR_T  sDestMC = VOS_INADDR_ANY;
 
@@ -293,13 +367,15 @@ static void ttiPDCallback (
                 /* Remove old consist info */
                 for (i = 0; i < TRDP_MAX_CST_CNT; i++)
                 {
-                    if (appHandle->pTTDB->cstInfo[i] != NULL)
-                    {
-                        ttiFreeCstInfoEntry(appHandle->pTTDB->cstInfo[i]);
-                        vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                        appHandle->pTTDB->cstInfo[i] = NULL;
-                    }
+                    ttiFreeCstSlot(appHandle, i);
                 }
+                ttiIndexBuild(&appHandle->pTTDB->index, appHandle->pTTDB->cstInfo);
+                ttiUpdateOwnCstUUID(appHandle);
+            }
+            else if (appHandle->pTTDB->ownTrnCstNo != appHandle->pTTDB->opTrnState.ownTrnCstNo)
+            {
+                ttiUpdateOwnCstUUID(appHandle);
+                ownCstChanged = TRUE;
             }
 
             /* Has the opTopoCnt changed? */
@@ -345,6 +421,10 @@ static void ttiPDCallback (
             vos_printLog(VOS_LOG_INFO, "---> Unsolicited msg received on %p!\n",
                          (void *)appHandle);
         }
+        if ((changed > 0) || (ownCstChanged == TRUE))
+        {
+            ttiPublishSnapshot(appHandle);
+        }
         if ((changed > 0) && (waitForInaug != NULL))
         {
             vos_semaGive(waitForInaug);
@@ -369,11 +449,6 @@ static TRDP_ERR_T ttiGetOwnCstUUID(
     TRDP_APP_SESSION_T  appHandle,
     TRDP_UUID_T cstUUID)
 {
-    int i;
-    static int savedIndex = -1;
-
-    memset(cstUUID, 0, sizeof(TRDP_UUID_T));
-
     if ((appHandle == NULL) ||
         (appHandle->pTTDB == NULL) ||
         (cstUUID == NULL))
@@ -381,32 +456,398 @@ static TRDP_ERR_T ttiGetOwnCstUUID(
         return TRDP_PARAM_ERR;
     }
 
+    memset(cstUUID, 0, sizeof(TRDP_UUID_T));
+
     if (appHandle->pTTDB->trnDir.cstCnt == 0)     /* need update? */
     {
-        savedIndex = -1;
         ttiRequestTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
         return TRDP_NODATA_ERR;
     }
 
-    if (savedIndex >= 0)
+    /* searched for on reception of the train directory or a new ownTrnCstNo */
+    if (appHandle->pTTDB->ownCstValid == TRUE)
     {
-        /* Use saved index */
-        memcpy(cstUUID, appHandle->pTTDB->trnDir.cstList[savedIndex].cstUUID, sizeof(TRDP_UUID_T));
+        memcpy(cstUUID, appHandle->pTTDB->ownCstUUID, sizeof(TRDP_UUID_T));
     }
-    else
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/*  Consist indexes and snapshots                                                                                     */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/** Hash of a consist UUID
+ *
+ *  @param[in]      pUUID           UUID
+ *
+ *  @retval         bucket of the index
+ */
+static UINT32 ttiHashUUID (
+    const UINT8 *pUUID)
+{
+    UINT32  hash = 2166136261u;         /* FNV-1a */
+    UINT32  i;
+
+    for (i = 0u; i < sizeof(TRDP_UUID_T); i++)
     {
-        for (i = 0u; i < appHandle->pTTDB->trnDir.cstCnt; i++)
+        hash = (hash ^ pUUID[i]) * 16777619u;
+    }
+    return hash & (TAU_TTI_HASH_SIZE - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Case insensitive hash of a consist label
+ *
+ *  @param[in]      pLabel          label, not necessarily zero terminated
+ *
+ *  @retval         bucket of the index
+ */
+static UINT32 ttiHashLabel (
+    const CHAR8 *pLabel)
+{
+    UINT32  hash = 2166136261u;         /* FNV-1a */
+    UINT32  i;
+
+    for (i = 0u; (i < sizeof(TRDP_NET_LABEL_T)) && (pLabel[i] != '\0'); i++)
+    {
+        hash = (hash ^ (UINT8) tolower((UINT8) pLabel[i])) * 16777619u;
+    }
+    return hash & (TAU_TTI_HASH_SIZE - 1u);
+}
+
+/**********************************************************************************************************************/
+/** (Re-)build the index of a consist info array
+ *  Equal UUIDs or labels are found in the order of the array, as the linear search did.
+ *
+ *  @param[out]     pIndex          index to build
+ *  @param[in]      ppCstInfo       array of TRDP_MAX_CST_CNT consist infos, may contain NULL
+ *
+ */
+static void ttiIndexBuild (
+    TAU_TTI_INDEX_T             *pIndex,
+    TRDP_CONSIST_INFO_T * const *ppCstInfo)
+{
+    UINT32  slot;
+    UINT32  bucket;
+
+    memset(pIndex, 0, sizeof(TAU_TTI_INDEX_T));
+
+    for (slot = 0u; slot < TRDP_MAX_CST_CNT; slot++)
+    {
+        if (ppCstInfo[slot] == NULL)
         {
-            if (appHandle->pTTDB->opTrnState.ownTrnCstNo == appHandle->pTTDB->trnDir.cstList[i].trnCstNo)
-            {
-                memcpy(cstUUID, appHandle->pTTDB->trnDir.cstList[i].cstUUID, sizeof(TRDP_UUID_T));
-                savedIndex = i;
-                break;
-            }
+            continue;
         }
+        for (bucket = ttiHashUUID(ppCstInfo[slot]->cstUUID);
+             pIndex->byUUID[bucket] != 0u;
+             bucket = (bucket + 1u) & (TAU_TTI_HASH_SIZE - 1u))
+        {
+            ;
+        }
+        pIndex->byUUID[bucket] = (UINT8) (slot + 1u);
+
+        for (bucket = ttiHashLabel(ppCstInfo[slot]->cstId);
+             pIndex->byLabel[bucket] != 0u;
+             bucket = (bucket + 1u) & (TAU_TTI_HASH_SIZE - 1u))
+        {
+            ;
+        }
+        pIndex->byLabel[bucket] = (UINT8) (slot + 1u);
     }
+}
 
-    return TRDP_NO_ERR;
+/**********************************************************************************************************************/
+/** Find a consist info by UUID using an index
+ *
+ *  @param[in]      pIndex          index of ppCstInfo
+ *  @param[in]      ppCstInfo       array of TRDP_MAX_CST_CNT consist infos
+ *  @param[in]      pUUID           UUID to look for
+ *
+ *  @retval         consist info or NULL
+ */
+static TRDP_CONSIST_INFO_T *ttiIndexFindUUID (
+    const TAU_TTI_INDEX_T       *pIndex,
+    TRDP_CONSIST_INFO_T * const *ppCstInfo,
+    const UINT8                 *pUUID)
+{
+    UINT32              bucket;
+    TRDP_CONSIST_INFO_T *pCstInfo;
+
+    for (bucket = ttiHashUUID(pUUID);
+         pIndex->byUUID[bucket] != 0u;
+         bucket = (bucket + 1u) & (TAU_TTI_HASH_SIZE - 1u))
+    {
+        pCstInfo = ppCstInfo[pIndex->byUUID[bucket] - 1u];
+        if ((pCstInfo != NULL) && (memcmp(pCstInfo->cstUUID, pUUID, sizeof(TRDP_UUID_T)) == 0))
+        {
+            return pCstInfo;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Find a consist info by label using an index
+ *
+ *  @param[in]      pIndex          index of ppCstInfo
+ *  @param[in]      ppCstInfo       array of TRDP_MAX_CST_CNT consist infos
+ *  @param[in]      pLabel          label to look for, case insensitive
+ *
+ *  @retval         consist info or NULL
+ */
+static TRDP_CONSIST_INFO_T *ttiIndexFindLabel (
+    const TAU_TTI_INDEX_T       *pIndex,
+    TRDP_CONSIST_INFO_T * const *ppCstInfo,
+    const CHAR8                 *pLabel)
+{
+    UINT32              bucket;
+    TRDP_CONSIST_INFO_T *pCstInfo;
+
+    for (bucket = ttiHashLabel(pLabel);
+         pIndex->byLabel[bucket] != 0u;
+         bucket = (bucket + 1u) & (TAU_TTI_HASH_SIZE - 1u))
+    {
+        pCstInfo = ppCstInfo[pIndex->byLabel[bucket] - 1u];
+        if ((pCstInfo != NULL) && (vos_strnicmp(pCstInfo->cstId, pLabel, sizeof(TRDP_NET_LABEL_T)) == 0))
+        {
+            return pCstInfo;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Search the own consist UUID in the train directory
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *
+ */
+static void ttiUpdateOwnCstUUID (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_TTDB_T  *pTTDB = appHandle->pTTDB;
+    UINT32      i;
+
+    pTTDB->ownTrnCstNo  = pTTDB->opTrnState.ownTrnCstNo;
+    pTTDB->ownCstValid  = FALSE;
+    memset(pTTDB->ownCstUUID, 0, sizeof(TRDP_UUID_T));
+
+    for (i = 0u; i < pTTDB->trnDir.cstCnt; i++)
+    {
+        if (pTTDB->ownTrnCstNo == pTTDB->trnDir.cstList[i].trnCstNo)
+        {
+            memcpy(pTTDB->ownCstUUID, pTTDB->trnDir.cstList[i].cstUUID, sizeof(TRDP_UUID_T));
+            pTTDB->ownCstValid = TRUE;
+            break;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Drop a reference to a consist info copy, snapshot mutex must be held
+ *
+ *  @param[in]      pCopy           consist info copy
+ *
+ */
+static void ttiPutCstCopy (
+    TAU_TTI_CST_COPY_T *pCopy)
+{
+    if (--pCopy->refCnt == 0u)
+    {
+        vos_memFree(pCopy->pCstInfo);
+        vos_memFree(pCopy);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Free a snapshot, snapshot mutex must be held
+ *
+ *  @param[in]      pSnapshot       snapshot no reader can see anymore
+ *
+ */
+static void ttiFreeSnapshot (
+    TAU_TTI_SNAPSHOT_T *pSnapshot)
+{
+    UINT32 slot;
+
+    for (slot = 0u; slot < TRDP_MAX_CST_CNT; slot++)
+    {
+        if (pSnapshot->pCopy[slot] != NULL)
+        {
+            ttiPutCstCopy(pSnapshot->pCopy[slot]);
+        }
+    }
+    vos_memFree(pSnapshot);
+}
+
+/**********************************************************************************************************************/
+/** Free the replaced snapshots nobody holds any more, snapshot mutex must be held
+ *  A reader counts itself in snapLoading[] of the current epoch while it loads pSnapshot and increments the readers
+ *  of the snapshot found. The epoch advances once the loading readers of the previous epoch are gone, so two epochs
+ *  after its replacement nobody can be about to count a snapshot, it is freed when its own readers are zero.
+ *  Readers of newer snapshots never hold back the older ones.
+ *
+ *  @param[in]      pTTDB           TTDB of the session
+ *
+ */
+static void ttiReclaimSnapshots (
+    TAU_TTDB_T *pTTDB)
+{
+    TAU_TTI_SNAPSHOT_T  **ppIter;
+    TAU_TTI_SNAPSHOT_T  *pSnapshot;
+    UINT32              epoch = pTTDB->snapEpoch;
+    UINT32              i;
+
+    /* the previous epoch has the parity of the next one */
+    for (i = 0u; (i < 2u) && (pTTDB->pRetired != NULL); i++)
+    {
+        if (TTI_SNAP_LOAD(&pTTDB->snapLoading[(epoch + 1u) & 1u]) != 0u)
+        {
+            break;
+        }
+        epoch++;
+        TTI_SNAP_STORE(&pTTDB->snapEpoch, epoch);
+    }
+
+    ppIter = &pTTDB->pRetired;
+    while (*ppIter != NULL)
+    {
+        pSnapshot = *ppIter;
+        if (((epoch - pSnapshot->retireEpoch) >= 2u) && (TTI_SNAP_LOAD(&pSnapshot->readers) == 0u))
+        {
+            *ppIter = pSnapshot->pNext;
+            ttiFreeSnapshot(pSnapshot);
+        }
+        else
+        {
+            ppIter = &pSnapshot->pNext;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Replace the current snapshot by one of the actual TTDB content
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *
+ */
+static void ttiPublishSnapshot (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_TTDB_T          *pTTDB = appHandle->pTTDB;
+    TAU_TTI_SNAPSHOT_T  *pNew;
+    TAU_TTI_SNAPSHOT_T  *pOld;
+    UINT32              slot;
+
+    pNew = (TAU_TTI_SNAPSHOT_T *) vos_memAlloc(sizeof(TAU_TTI_SNAPSHOT_T));
+    if (pNew == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "TTI snapshot could not be updated!\n");
+        return;
+    }
+
+    (void) vos_mutexLock(pTTDB->snapMutex);
+
+    pNew->etbTopoCnt    = appHandle->etbTopoCnt;
+    pNew->opTrnTopoCnt  = appHandle->opTrnTopoCnt;
+    pNew->ownCstValid   = pTTDB->ownCstValid;
+    memcpy(pNew->ownCstUUID, pTTDB->ownCstUUID, sizeof(TRDP_UUID_T));
+
+    /* the consist infos are shared with the previous snapshot   */
+    for (slot = 0u; slot < TRDP_MAX_CST_CNT; slot++)
+    {
+        if (pTTDB->pCstCopy[slot] != NULL)
+        {
+            pTTDB->pCstCopy[slot]->refCnt++;
+            pNew->pCopy[slot]       = pTTDB->pCstCopy[slot];
+            pNew->pCstInfo[slot]    = pTTDB->pCstCopy[slot]->pCstInfo;
+            pNew->cstCnt++;
+        }
+    }
+    ttiIndexBuild(&pNew->index, pNew->pCstInfo);
+
+    pOld = pTTDB->pSnapshot;
+    TTI_SNAP_STORE(&pTTDB->pSnapshot, pNew);
+    if (pOld != NULL)
+    {
+        pOld->retireEpoch   = pTTDB->snapEpoch;
+        pOld->pNext         = pTTDB->pRetired;
+        pTTDB->pRetired     = pOld;
+    }
+    ttiReclaimSnapshots(pTTDB);
+
+    (void) vos_mutexUnlock(pTTDB->snapMutex);
+}
+
+/**********************************************************************************************************************/
+/** Free a consist info slot and its copy
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      slot            index into cstInfo[]
+ *
+ */
+static void ttiFreeCstSlot (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              slot)
+{
+    TAU_TTDB_T *pTTDB = appHandle->pTTDB;
+
+    if (pTTDB->cstInfo[slot] != NULL)
+    {
+        ttiFreeCstInfoEntry(pTTDB->cstInfo[slot]);
+        vos_memFree(pTTDB->cstInfo[slot]);
+        pTTDB->cstInfo[slot] = NULL;
+    }
+    if (pTTDB->pCstCopy[slot] != NULL)
+    {
+        (void) vos_mutexLock(pTTDB->snapMutex);
+        ttiPutCstCopy(pTTDB->pCstCopy[slot]);
+        pTTDB->pCstCopy[slot] = NULL;
+        (void) vos_mutexUnlock(pTTDB->snapMutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Release all TTDB memory, subscriptions and listeners must be removed before
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *
+ */
+static void ttiFreeTTDB (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_TTDB_T  *pTTDB = appHandle->pTTDB;
+    UINT32      slot;
+
+    for (slot = 0u; slot < TRDP_MAX_CST_CNT; slot++)
+    {
+        ttiFreeCstSlot(appHandle, slot);
+    }
+
+    (void) vos_mutexLock(pTTDB->snapMutex);
+    if (pTTDB->pSnapshot != NULL)
+    {
+        pTTDB->pSnapshot->pNext = pTTDB->pRetired;
+        pTTDB->pRetired         = pTTDB->pSnapshot;
+        pTTDB->pSnapshot        = NULL;
+    }
+    while (pTTDB->pRetired != NULL)
+    {
+        TAU_TTI_SNAPSHOT_T *pSnapshot = pTTDB->pRetired;
+        if (pSnapshot->readers != 0u)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "TTI snapshot still acquired on deinit!\n");
+        }
+        pTTDB->pRetired = pSnapshot->pNext;
+        ttiFreeSnapshot(pSnapshot);
+    }
+    (void) vos_mutexUnlock(pTTDB->snapMutex);
+
+    vos_mutexDelete(pTTDB->snapMutex);
+    vos_memFree(pTTDB);
+    appHandle->pTTDB = NULL;
 }
 
 /**********************************************************************************************************************/
@@ -496,6 +937,8 @@ static void ttiStoreTrnDir (
     {
         appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt = vos_ntohl(appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt);
     }
+
+    ttiUpdateOwnCstUUID(appHandle);
 }
 
 /**********************************************************************************************************************/
@@ -955,6 +1398,7 @@ static void ttiStoreCstInfo (
 {
     TRDP_CONSIST_INFO_T *pTelegram = (TRDP_CONSIST_INFO_T *) pData;
     INT32 curEntry = -1;
+    TAU_TTI_CST_COPY_T  *pCopy;
 
     //Skip to store own cst on position 0
     UINT32 l_index;
@@ -972,9 +1416,7 @@ static void ttiStoreCstInfo (
             memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, pTelegram->cstUUID, sizeof(TRDP_UUID_T)) == 0)
         {
             //UUID already exist, update
-            ttiFreeCstInfoEntry(appHandle->pTTDB->cstInfo[l_index]);
-            vos_memFree(appHandle->pTTDB->cstInfo[l_index]);
-            appHandle->pTTDB->cstInfo[l_index] = NULL;
+            ttiFreeCstSlot(appHandle, l_index);
             curEntry = l_index;
             break;
         }
@@ -998,11 +1440,30 @@ static void ttiStoreCstInfo (
     /* We do convert and allocate more memory for the several parts of the consist info inside. */
     if (ttiCreateCstInfoEntry(appHandle->pTTDB->cstInfo[curEntry], pData, dataSize) != TRDP_NO_ERR)
     {
-        ttiFreeCstInfoEntry(appHandle->pTTDB->cstInfo[curEntry]);
-        vos_memFree(appHandle->pTTDB->cstInfo[curEntry]);
+        ttiFreeCstSlot(appHandle, (UINT32) curEntry);
+        ttiIndexBuild(&appHandle->pTTDB->index, appHandle->pTTDB->cstInfo);
         vos_printLogStr(VOS_LOG_ERROR, "Parts of consist info could not be stored!");
         return;
     }
+    ttiIndexBuild(&appHandle->pTTDB->index, appHandle->pTTDB->cstInfo);
+
+    /* The snapshots share one copy of it */
+    pCopy = (TAU_TTI_CST_COPY_T *) vos_memAlloc(sizeof(TAU_TTI_CST_COPY_T));
+    if ((pCopy != NULL) &&
+        (ttiCopyCstInfo(&pCopy->pCstInfo, appHandle->pTTDB->cstInfo[curEntry]) != TRDP_NO_ERR))
+    {
+        vos_memFree(pCopy);
+        pCopy = NULL;
+    }
+    if (pCopy == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Consist info could not be added to the TTI snapshot!");
+        return;
+    }
+    pCopy->refCnt = 1u;
+    (void) vos_mutexLock(appHandle->pTTDB->snapMutex);
+    appHandle->pTTDB->pCstCopy[curEntry] = pCopy;
+    (void) vos_mutexUnlock(appHandle->pTTDB->snapMutex);
  }
 
 /**********************************************************************************************************************/
@@ -1027,6 +1488,7 @@ static void ttiMDCallback (
     UINT32                  dataSize)
 {
     VOS_SEMA_T waitForInaug = (VOS_SEMA_T) pMsg->pUserRef;
+    BOOL8      republish    = FALSE;
 
     (void) pRefCon;
 
@@ -1051,6 +1513,7 @@ static void ttiMDCallback (
             if (dataSize <= sizeof(TRDP_TRAIN_DIR_T))
             {
                 ttiStoreTrnDir(appHandle, pData);
+                republish = TRUE;
             }
         }
         else if (pMsg->comId == TTDB_NET_DIR_REP_COMID)
@@ -1090,6 +1553,7 @@ static void ttiMDCallback (
                 (void) ttiStoreOpTrnDir(appHandle, (UINT8 *) &pTelegram->opTrnDir);
                 ttiStoreTrnDir(appHandle, (UINT8 *) &pTelegram->trnDir);
                 ttiStoreTrnNetDir(appHandle, (UINT8 *) &pTelegram->trnNetDir);
+                republish = TRUE;
             }
         }
         else if (pMsg->comId == TTDB_STAT_CST_REP_COMID)
@@ -1105,6 +1569,7 @@ static void ttiMDCallback (
             {
                 /* find a free place in the cache, or overwrite oldest entry   */
                 (void) ttiStoreCstInfo(appHandle, pData, dataSize);
+                republish = TRUE;
             }
             else
             {
@@ -1121,6 +1586,10 @@ static void ttiMDCallback (
         return;
 
     }
+    if (republish == TRUE)
+    {
+        ttiPublishSnapshot(appHandle);
+    }
 }
 
 /**********************************************************************************************************************/
@@ -1386,7 +1855,6 @@ static TRDP_ERR_T ttiGetCstInfoByUUID(
     const TRDP_UUID_T     cstUUID
     )
 {
-    UINT32             l_index;
     const TRDP_UUID_T* pReqCstUUID = (const TRDP_UUID_T*) cstUUID;
     TRDP_UUID_T        ownUUID;
 
@@ -1405,20 +1873,7 @@ static TRDP_ERR_T ttiGetCstInfoByUUID(
     }
 
     /* find the consist in our cache list */
-    for (l_index = 0; l_index < TRDP_MAX_CST_CNT; l_index++)
-    {
-        if (appHandle->pTTDB->cstInfo[l_index] == NULL)
-        {
-            //No more entries
-            break;
-        }
-        if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-            memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, *pReqCstUUID, sizeof(TRDP_UUID_T)) == 0)
-        {
-            *ppCstInfo = appHandle->pTTDB->cstInfo[l_index];
-            break;
-        }
-    }
+    *ppCstInfo = ttiIndexFindUUID(&appHandle->pTTDB->index, appHandle->pTTDB->cstInfo, *pReqCstUUID);
 
     return TRDP_NO_ERR;
 }
@@ -1442,8 +1897,6 @@ static TRDP_ERR_T ttiGetCstInfoByLable(
     const TRDP_LABEL_T  pCstLabel
 )
 {
-    UINT32 l_index;
-
     *ppCstInfo = NULL;
 
     if (pCstLabel == NULL)
@@ -1452,21 +1905,7 @@ static TRDP_ERR_T ttiGetCstInfoByLable(
     }
 
     /* find the consist in our cache list */
-    for (l_index = 0; l_index < TRDP_MAX_CST_CNT; l_index++)
-    {
-        if (appHandle->pTTDB->cstInfo[l_index] == NULL)
-        {
-            //No more entries
-            break;
-        }
-
-        if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-            vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-        {
-            *ppCstInfo = appHandle->pTTDB->cstInfo[l_index];
-            break;
-        }
-    }
+    *ppCstInfo = ttiIndexFindLabel(&appHandle->pTTDB->index, appHandle->pTTDB->cstInfo, pCstLabel);
 
     return TRDP_NO_ERR;
 }
@@ -1511,6 +1950,16 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
         return TRDP_MEM_ERR;
     }
 
+    if (vos_mutexCreate(&appHandle->pTTDB->snapMutex) != VOS_NO_ERR)
+    {
+        vos_memFree(appHandle->pTTDB);
+        appHandle->pTTDB = NULL;
+        return TRDP_INIT_ERR;
+    }
+
+    /* readers always find a (maybe empty) snapshot */
+    ttiPublishSnapshot(appHandle);
+
     /*  subscribe to PD 100 */
 
     if (tlp_subscribe(appHandle,
@@ -1525,7 +1974,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
                       TTDB_STATUS_TO_US,
                       TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR)
     {
-        vos_memFree(appHandle->pTTDB);
+        ttiFreeTTDB(appHandle);
         return TRDP_INIT_ERR;
     }
 
@@ -1542,7 +1991,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
                       TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR)
     {
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle1);
-        vos_memFree(appHandle->pTTDB);
+        ttiFreeTTDB(appHandle);
         return TRDP_INIT_ERR;
     }
 
@@ -1562,7 +2011,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
     {
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle1);
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle2);
-        vos_memFree(appHandle->pTTDB);
+        ttiFreeTTDB(appHandle);
         return TRDP_INIT_ERR;
     }
 
@@ -1581,7 +2030,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle1);
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle2);
         (void) tlm_delListener(appHandle, appHandle->pTTDB->md101Listener1);
-        vos_memFree(appHandle->pTTDB);
+        ttiFreeTTDB(appHandle);
         return TRDP_INIT_ERR;
     }
     return TRDP_NO_ERR;
@@ -1589,7 +2038,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
 
 /**********************************************************************************************************************/
 /**    Release any resources allocated by TTI
- *  Must be called before closing the session.
+ *  Must be called before closing the session. All TTI snapshots must have been released.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *
@@ -1601,23 +2050,11 @@ EXT_DECL void tau_deInitTTI (
 {
     if (appHandle->pTTDB != NULL)
     {
-        UINT32 i;
-        for (i = 0; i < TRDP_MAX_CST_CNT; i++)
-        {
-            if (appHandle->pTTDB->cstInfo[i] != NULL)
-            {
-                ttiFreeCstInfoEntry(appHandle->pTTDB->cstInfo[i]);
-                vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                appHandle->pTTDB->cstInfo[i] = NULL;
-            }
-        }
-
         (void) tlm_delListener(appHandle, appHandle->pTTDB->md101Listener1);
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle1);
         (void) tlm_delListener(appHandle, appHandle->pTTDB->md101Listener2);
         (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle2);
-        vos_memFree(appHandle->pTTDB);
-        appHandle->pTTDB = NULL;
+        ttiFreeTTDB(appHandle);
     }
 }
 
@@ -2613,6 +3050,168 @@ EXT_DECL UINT8 tau_getOwnTrnCstNo (
     return 0u;
 }
 
+/**********************************************************************************************************************/
+/*    Snapshot access                                                                                                 */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/**    Get the current TTI snapshot.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *
+ *  @retval         pointer to the snapshot, must be released with tau_releaseTTISnapshot()
+ *  @retval         NULL                TTI not initialised
+ */
+EXT_DECL const TAU_TTI_SNAPSHOT_T *tau_acquireTTISnapshot (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_TTDB_T          *pTTDB;
+    TAU_TTI_SNAPSHOT_T  *pSnapshot;
+    UINT32              parity;
+
+    if ((appHandle == NULL) ||
+        (appHandle->pTTDB == NULL))
+    {
+        return NULL;
+    }
+    pTTDB = appHandle->pTTDB;
+
+#ifdef TTI_SNAP_LOCKED_READERS
+    (void) vos_mutexLock(pTTDB->snapMutex);
+#endif
+    /* announce the load first, a snapshot replaced meanwhile is not freed before the epoch moved on twice */
+    parity = TTI_SNAP_LOAD(&pTTDB->snapEpoch) & 1u;
+    (void) TTI_SNAP_INC(&pTTDB->snapLoading[parity]);
+    pSnapshot = TTI_SNAP_LOAD(&pTTDB->pSnapshot);
+    (void) TTI_SNAP_INC(&pSnapshot->readers);
+    (void) TTI_SNAP_DEC(&pTTDB->snapLoading[parity]);
+#ifdef TTI_SNAP_LOCKED_READERS
+    (void) vos_mutexUnlock(pTTDB->snapMutex);
+#endif
+
+    return pSnapshot;
+}
+
+/**********************************************************************************************************************/
+/**    Release a TTI snapshot.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ */
+EXT_DECL void tau_releaseTTISnapshot (
+    TRDP_APP_SESSION_T          appHandle,
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot)
+{
+    TAU_TTDB_T  *pTTDB;
+    UINT32      readers;
+
+    if ((appHandle == NULL) ||
+        (appHandle->pTTDB == NULL) ||
+        (pSnapshot == NULL))
+    {
+        return;
+    }
+    pTTDB = appHandle->pTTDB;
+
+#ifdef TTI_SNAP_LOCKED_READERS
+    (void) vos_mutexLock(pTTDB->snapMutex);
+#endif
+    readers = TTI_SNAP_DEC(&((TAU_TTI_SNAPSHOT_T *) pSnapshot)->readers);
+#ifdef TTI_SNAP_LOCKED_READERS
+    (void) vos_mutexUnlock(pTTDB->snapMutex);
+#endif
+
+    /* the last reader of a snapshot frees the replaced ones, unless the TTI is busy */
+    if ((readers == 0u) &&
+        (TTI_SNAP_LOAD(&pTTDB->pRetired) != NULL) &&
+        (vos_mutexTryLock(pTTDB->snapMutex) == VOS_NO_ERR))
+    {
+        ttiReclaimSnapshots(pTTDB);
+        (void) vos_mutexUnlock(pTTDB->snapMutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Get the topocounts a snapshot was taken with.
+ *
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ *  @param[out]     pEtbTopoCnt         Returns the ETB topocount, may be NULL
+ *  @param[out]     pOpTrnTopoCnt       Returns the operational train topocount, may be NULL
+ *
+ *  @retval         number of consist infos in the snapshot
+ */
+EXT_DECL UINT32 tau_getTTISnapshotInfo (
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot,
+    UINT32                      *pEtbTopoCnt,
+    UINT32                      *pOpTrnTopoCnt)
+{
+    if (pSnapshot == NULL)
+    {
+        return 0u;
+    }
+    if (pEtbTopoCnt != NULL)
+    {
+        *pEtbTopoCnt = pSnapshot->etbTopoCnt;
+    }
+    if (pOpTrnTopoCnt != NULL)
+    {
+        *pOpTrnTopoCnt = pSnapshot->opTrnTopoCnt;
+    }
+    return pSnapshot->cstCnt;
+}
+
+/**********************************************************************************************************************/
+/**    Find a consist info by UUID in a snapshot.
+ *
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ *  @param[in]      cstUUID             UUID of the consist, NULL means own consist
+ *
+ *  @retval         pointer to the consist info, valid until the snapshot is released
+ *  @retval         NULL                not found
+ */
+EXT_DECL const TRDP_CONSIST_INFO_T *tau_findCstInfoByUUID (
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot,
+    const TRDP_UUID_T           cstUUID)
+{
+    if (pSnapshot == NULL)
+    {
+        return NULL;
+    }
+    if (cstUUID == NULL)
+    {
+        if (pSnapshot->ownCstValid == FALSE)
+        {
+            return NULL;
+        }
+        cstUUID = pSnapshot->ownCstUUID;
+    }
+    return ttiIndexFindUUID(&pSnapshot->index, pSnapshot->pCstInfo, cstUUID);
+}
+
+/**********************************************************************************************************************/
+/**    Find a consist info by label in a snapshot.
+ *
+ *  @param[in]      pSnapshot           Snapshot returned by tau_acquireTTISnapshot()
+ *  @param[in]      cstLabel            Label of the consist, NULL means own consist
+ *
+ *  @retval         pointer to the consist info, valid until the snapshot is released
+ *  @retval         NULL                not found
+ */
+EXT_DECL const TRDP_CONSIST_INFO_T *tau_findCstInfoByLabel (
+    const TAU_TTI_SNAPSHOT_T    *pSnapshot,
+    const TRDP_LABEL_T          cstLabel)
+{
+    if (pSnapshot == NULL)
+    {
+        return NULL;
+    }
+    if (cstLabel == NULL)
+    {
+        return tau_findCstInfoByUUID(pSnapshot, NULL);
+    }
+    return ttiIndexFindLabel(&pSnapshot->index, pSnapshot->pCstInfo, cstLabel);
+}
+
 #endif
 
 #ifdef __cplusplus
@@ -116,6 +116,8 @@
 #define TRDP_SDTV4_DEFAULT_SAFE_CHAN_VERS  0u                       /**< Default SDTv4 Safety Channel Version      */
 #endif
 
+#define XML_ARRAY_MIN_CAPACITY  4u                                  /**< Initial number of elements of a table     */
+
 /*******************************************************************************
  * TYPEDEFS
  */
@@ -143,6 +145,47 @@ static TRDP_DATA_TYPE_T string2type (const CHAR8 *pTypeStr)
     return TRDP_INVALID;
 }
 
+/*
+ * Make room for one more element of a table.
+ * Tables are filled in the same pass that finds their elements, so their size is not known beforehand.
+ * The capacity is not stored, it is the element count rounded up to a power of two (at least
+ * XML_ARRAY_MIN_CAPACITY): the array is moved to a block of twice the size whenever count reaches it.
+ * headerSize bytes in front of the elements are copied along (dataset header), 0 for plain arrays.
+ * Tables handed out with the document (telegrams, datasets) live in its arena, pArena is NULL for tables the
+ * caller releases with vos_memFree.
+ * Returns the array to use, which may be pArray, or NULL if out of memory (pArray is still valid then).
+ */
+static void *growArray (
+    XML_ARENA_T *pArena,
+    void        *pArray,
+    UINT32      headerSize,
+    UINT32      count,
+    UINT32      elemSize)
+{
+    UINT32  newSize;
+    UINT8   *pNew;
+
+    if ((pArray != NULL) &&
+        ((count < XML_ARRAY_MIN_CAPACITY) || ((count & (count - 1u)) != 0u)))
+    {
+        return pArray;
+    }
+
+    newSize = headerSize + ((count < XML_ARRAY_MIN_CAPACITY) ? XML_ARRAY_MIN_CAPACITY : 2u * count) * elemSize;
+    if (pArena != NULL)
+    {
+        return trdp_XMLArenaRealloc(pArena, pArray, headerSize + count * elemSize, newSize);
+    }
+
+    pNew = vos_memAlloc(newSize);
+    if ((pNew != NULL) && (pArray != NULL))
+    {
+        memcpy(pNew, pArray, headerSize + count * elemSize);    /* the new tail is zeroed by vos_memAlloc */
+        vos_memFree(pArray);
+    }
+    return pNew;
+}
+
 
 /*
  * Set default values to device parameters
@@ -292,6 +335,171 @@ static void dbgPrint (UINT32 num, TRDP_EXCHG_PAR_T *pArray)
 }
 #endif
 
+/**********************************************************************************************************************/
+/*
+ * Read the optional SDT parameters of a <source> or <destination> element in one scan of its children.
+ * Only the first <sdt-parameter> and the first <sdtv4-parameter> are read, SDTv2 parameters take precedence.
+ */
+static TRDP_ERR_T readSdtPar (
+    XML_HANDLE_T        *pXML,
+    TRDP_SDT_PAR_T      * *ppSdtPar,
+    TRDP_SDTV4_PAR_T    * *ppSdtv4Par,
+    const CHAR8         *pWhat)
+{
+    CHAR8   tag[MAX_TAG_LEN];
+    CHAR8   attribute[MAX_TOK_LEN];
+    CHAR8   value[MAX_TOK_LEN];
+    UINT32  valueInt;
+
+    trdp_XMLEnter(pXML);
+
+    while (trdp_XMLSeekStartTagAny(pXML, tag, MAX_TAG_LEN) == 0)
+    {
+        if ((*ppSdtPar == NULL) && (vos_strnicmp(tag, "sdt-parameter", MAX_TAG_LEN) == 0))
+        {
+            *ppSdtPar = (TRDP_SDT_PAR_T *)trdp_XMLArenaAlloc(&pXML->arena, sizeof(TRDP_SDT_PAR_T));
+
+            if (*ppSdtPar == NULL)
+            {
+                vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML %s sdt parameter definitions!\n",
+                             (unsigned long) sizeof(TRDP_SDT_PAR_T), pWhat);
+                return TRDP_MEM_ERR;
+            }
+
+            (*ppSdtPar)->smi2 = TRDP_SDT_DEFAULT_SMI2;
+            (*ppSdtPar)->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
+            (*ppSdtPar)->nGuard = TRDP_SDT_DEFAULT_NGUARD;
+            (*ppSdtPar)->cmThr = TRDP_SDT_DEFAULT_CMTHR;
+            (*ppSdtPar)->lmiMax = TRDP_SDT_DEFAULT_LMIMAX;
+
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+            {
+                if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->smi1 = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->smi2 = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "udv", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->udv = (UINT16) valueInt;
+                }
+                else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->rxPeriod = (UINT16) valueInt;
+                }
+                else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->txPeriod = (UINT16) valueInt;
+                }
+                else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->nrxSafe = (UINT8) valueInt;
+                }
+                else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->nGuard = (UINT16) valueInt;
+                }
+                else if (vos_strnicmp(attribute, "cm-thr", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->cmThr = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "lmi-max", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->lmiMax = (UINT8)valueInt;
+                }
+            }
+        }
+        else if ((*ppSdtv4Par == NULL) && (vos_strnicmp(tag, "sdtv4-parameter", MAX_TAG_LEN) == 0))
+        {
+            *ppSdtv4Par = (TRDP_SDTV4_PAR_T*)trdp_XMLArenaAlloc(&pXML->arena, sizeof(TRDP_SDTV4_PAR_T));
+
+            if (*ppSdtv4Par == NULL)
+            {
+                vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML %s sdtv4 parameter definitions!\n",
+                    (unsigned long)sizeof(TRDP_SDTV4_PAR_T), pWhat);
+                return TRDP_MEM_ERR;
+            }
+
+            (*ppSdtv4Par)->smi2 = TRDP_SDT_DEFAULT_SMI2;
+            (*ppSdtv4Par)->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
+            (*ppSdtv4Par)->nGuard = TRDP_SDT_DEFAULT_NGUARD;
+            (*ppSdtv4Par)->udv_sub = TRDP_SDTV4_DEFAULT_UDV_SUB;
+            (*ppSdtv4Par)->proto_var = TRDP_SDTV4_DEFAULT_PROTO_VAR;
+            (*ppSdtv4Par)->safe_func_id = TRDP_SDTV4_DEFAULT_SAFE_FUNC_ID;
+            (*ppSdtv4Par)->safe_func_vers = TRDP_SDTV4_DEFAULT_SAFE_FUNC_VERS;
+            (*ppSdtv4Par)->safe_channel_id = TRDP_SDTV4_DEFAULT_SAFE_CHAN_ID;
+            (*ppSdtv4Par)->safe_channel_vers = TRDP_SDTV4_DEFAULT_SAFE_CHAN_VERS;
+
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+            {
+                if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->smi1 = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->smi2 = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "udv-main", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->udv_main = (UINT8)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "udv-sub", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->udv_sub = (UINT8)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->rxPeriod = (UINT16)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->txPeriod = (UINT16)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->nrxSafe = (UINT8)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->nGuard = (UINT16)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "proto-var", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->proto_var = (UINT8)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "safe-func-id", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->safe_func_id = (UINT16)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "safe-func-vers", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->safe_func_vers = (UINT16)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "safe-channel-id", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->safe_channel_id = (UINT16)valueInt;
+                }
+                else if (vos_strnicmp(attribute, "safe-channel-vers", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtv4Par)->safe_channel_vers = (UINT16)valueInt;
+                }
+            }
+        }
+    }
+
+    trdp_XMLLeave(pXML);
+
+    if ((*ppSdtPar != NULL) && (*ppSdtv4Par != NULL))
+    {
+        *ppSdtv4Par = NULL;     /* SDTv2 takes precedence, the memory goes with the document */
+    }
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 static TRDP_ERR_T readTelegramDef (
     XML_HANDLE_T        *pXML,
@@ -301,12 +509,9 @@ static TRDP_ERR_T readTelegramDef (
     CHAR8       attribute[MAX_TOK_LEN];
     CHAR8       value[MAX_TOK_LEN];
     UINT32      valueInt;
-    UINT32      countSrc;
-    UINT32      countDst;
-    UINT32      countSdtv4SrvInstParams;
     TRDP_SRC_T  *pSrc;
     TRDP_DEST_T *pDest;
-    TRDP_SDTV4_SRV_INST_PAR_T* pSdtv4SrvInstPar = NULL;
+    TRDP_SDTV4_SRV_INST_PAR_T* pSdtv4SrvInstPar;
     XML_TOKEN_T token;
 
     /* Get the attributes */
@@ -349,20 +554,13 @@ static TRDP_ERR_T readTelegramDef (
         }
     }
 
-    /* find out how many sources are defined before hand */
-    countSrc    = (UINT32) trdp_XMLCountStartTag(pXML, "source");
-    pSrc        = NULL;
-    countDst    = (UINT32) trdp_XMLCountStartTag(pXML, "destination");
-    pDest       = NULL;
-    countSdtv4SrvInstParams = (UINT32)trdp_XMLCountStartTag(pXML, "sdtv4-srv-inst-parameter");
-
-    /* Iterate thru <telegram> */
+    /* Iterate thru <telegram>, the source, destination and instance tables grow as their elements are found */
 
     while (trdp_XMLSeekStartTagAny(pXML, tag, MAX_TAG_LEN) == 0)
     {
         if (vos_strnicmp(tag, "md-parameter", MAX_TAG_LEN) == 0)
         {
-            pExchgParam->pMdPar = (TRDP_MD_PAR_T *) vos_memAlloc(sizeof(TRDP_MD_PAR_T));
+            pExchgParam->pMdPar = (TRDP_MD_PAR_T *) trdp_XMLArenaAlloc(&pXML->arena, sizeof(TRDP_MD_PAR_T));
 
             if (pExchgParam->pMdPar != NULL)
             {
@@ -418,7 +616,7 @@ static TRDP_ERR_T readTelegramDef (
         }
         else if (vos_strnicmp(tag, "pd-parameter", MAX_TAG_LEN) == 0)
         {
-            pExchgParam->pPdPar = (TRDP_PD_PAR_T *) vos_memAlloc(sizeof(TRDP_PD_PAR_T));
+            pExchgParam->pPdPar = (TRDP_PD_PAR_T *) trdp_XMLArenaAlloc(&pXML->arena, sizeof(TRDP_PD_PAR_T));
 
             if (pExchgParam->pPdPar != NULL)
             {
@@ -478,22 +676,17 @@ static TRDP_ERR_T readTelegramDef (
         }
         else if (vos_strnicmp(tag, "source", MAX_TAG_LEN) == 0)
         {
-            if (countSrc > 0u)
+            TRDP_SRC_T *pNewSrc = (TRDP_SRC_T *) growArray(&pXML->arena, pExchgParam->pSrc, 0u,
+                                                          pExchgParam->srcCnt, (UINT32) sizeof(TRDP_SRC_T));
+            if (pNewSrc == NULL)
             {
-                pExchgParam->pSrc = (TRDP_SRC_T *)vos_memAlloc(countSrc * sizeof(TRDP_SRC_T));
-
-                if (pExchgParam->pSrc == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                                 (unsigned long) (countSrc * sizeof(TRDP_SRC_T)));
-                    return TRDP_MEM_ERR;
-                }
-                pExchgParam->srcCnt = countSrc;
-                countSrc    = 0u;
-                pSrc        = pExchgParam->pSrc;
+                vos_printLogStr(VOS_LOG_ERROR, "Failed to allocate while reading XML source definitions!\n");
+                return TRDP_MEM_ERR;
             }
+            pExchgParam->pSrc   = pNewSrc;
+            pSrc                = &pNewSrc[pExchgParam->srcCnt++];
 
-            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE && pSrc != NULL)
+            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE)
             {
                 if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                 {
@@ -504,7 +697,8 @@ static TRDP_ERR_T readTelegramDef (
                     char *p = strchr(value, '@');   /* Get host part only, if no @ found */
                     if (p != NULL)
                     {
-                        pSrc->pUriUser = (TRDP_URI_USER_T *) vos_memAlloc(TRDP_MAX_URI_USER_LEN + 1u);
+                        pSrc->pUriUser = (TRDP_URI_USER_T *) trdp_XMLArenaAlloc(&pXML->arena,
+                                                                                TRDP_MAX_URI_USER_LEN + 1u);
                         if (pSrc->pUriUser == NULL)
                         {
                             vos_printLog(VOS_LOG_ERROR,
@@ -512,7 +706,7 @@ static TRDP_ERR_T readTelegramDef (
                                          (unsigned int) (TRDP_MAX_URI_USER_LEN + 1u));
                             return TRDP_MEM_ERR;
                         }
-                        memcpy(pSrc->pUriUser, value, p - value);  /* Trailing zero by vos_memAlloc    */
+                        memcpy(pSrc->pUriUser, value, p - value);  /* Trailing zero, arena memory is zeroed    */
                         p++;
                     }
                     else
@@ -520,7 +714,7 @@ static TRDP_ERR_T readTelegramDef (
                         p = value;
                     }
 
-                    pSrc->pUriHost1 = (TRDP_URI_HOST_T *) vos_memAlloc((UINT32)strlen(p) + 1u);
+                    pSrc->pUriHost1 = (TRDP_URI_HOST_T *) trdp_XMLArenaAlloc(&pXML->arena, (UINT32)strlen(p) + 1u);
                     if (pSrc->pUriHost1 == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -535,7 +729,7 @@ static TRDP_ERR_T readTelegramDef (
                     char *p = strchr(value, '@');   /* Get host part only, there is no @ */
                     p = (p == NULL) ? value : p + 1;
 
-                    pSrc->pUriHost2 = (TRDP_URI_HOST_T *) vos_memAlloc((UINT32) strlen(p) + 1u);
+                    pSrc->pUriHost2 = (TRDP_URI_HOST_T *) trdp_XMLArenaAlloc(&pXML->arena, (UINT32) strlen(p) + 1u);
                     if (pSrc->pUriHost2 == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -548,170 +742,26 @@ static TRDP_ERR_T readTelegramDef (
             }
             if (token == TOK_CLOSE)
             {
-                trdp_XMLEnter(pXML);
-                if (trdp_XMLCountStartTag(pXML, "sdt-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "sdt-parameter") == 0 &&
-                    pSrc != NULL)
+                TRDP_ERR_T err = readSdtPar(pXML, &pSrc->pSdtPar, &pSrc->pSdtv4Par, "source");
+                if (err != TRDP_NO_ERR)
                 {
-                    pSrc->pSdtPar = (TRDP_SDT_PAR_T *)vos_memAlloc(sizeof(TRDP_SDT_PAR_T));
-
-                    if (pSrc->pSdtPar == NULL)
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                                     (unsigned long) sizeof(TRDP_SDT_PAR_T));
-                        return TRDP_MEM_ERR;
-                    }
-
-                    pSrc->pSdtPar->smi2 = TRDP_SDT_DEFAULT_SMI2;
-                    pSrc->pSdtPar->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
-                    pSrc->pSdtPar->nGuard = TRDP_SDT_DEFAULT_NGUARD;
-                    pSrc->pSdtPar->cmThr = TRDP_SDT_DEFAULT_CMTHR;
-                    pSrc->pSdtPar->lmiMax = TRDP_SDT_DEFAULT_LMIMAX;
-
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->smi1 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->smi2 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "udv", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->udv = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->rxPeriod = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->txPeriod = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->nrxSafe = (UINT8) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->nGuard = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "cm-thr", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->cmThr = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "lmi-max", MAX_TOK_LEN) == 0)
-                        {
-                           pSrc->pSdtPar->lmiMax = (UINT8) valueInt;
-                        }
-                    }
-                }
-                else if (trdp_XMLCountStartTag(pXML, "sdtv4-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "sdtv4-parameter") == 0 &&
-                    pSrc != NULL)
-                {
-                    pSrc->pSdtv4Par = (TRDP_SDTV4_PAR_T*)vos_memAlloc(sizeof(TRDP_SDTV4_PAR_T));
-
-                    if (pSrc->pSdtv4Par == NULL)
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source sdtv4 parameter definitions!\n",
-                            (unsigned long)sizeof(TRDP_SDTV4_PAR_T));
-                        return TRDP_MEM_ERR;
-                    }
-
-                    pSrc->pSdtv4Par->smi2 = TRDP_SDT_DEFAULT_SMI2;
-                    pSrc->pSdtv4Par->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
-                    pSrc->pSdtv4Par->nGuard = TRDP_SDT_DEFAULT_NGUARD;
-                    pSrc->pSdtv4Par->udv_sub = TRDP_SDTV4_DEFAULT_UDV_SUB;
-                    pSrc->pSdtv4Par->proto_var = TRDP_SDTV4_DEFAULT_PROTO_VAR;
-                    pSrc->pSdtv4Par->safe_func_id = TRDP_SDTV4_DEFAULT_SAFE_FUNC_ID;
-                    pSrc->pSdtv4Par->safe_func_vers = TRDP_SDTV4_DEFAULT_SAFE_FUNC_VERS;
-                    pSrc->pSdtv4Par->safe_channel_id = TRDP_SDTV4_DEFAULT_SAFE_CHAN_ID;
-                    pSrc->pSdtv4Par->safe_channel_vers = TRDP_SDTV4_DEFAULT_SAFE_CHAN_VERS;
-
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->smi1 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->smi2 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "udv-main", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->udv_main = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "udv-sub", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->udv_sub = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->rxPeriod = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->txPeriod = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->nrxSafe = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->nGuard = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "proto-var", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->proto_var = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-func-id", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->safe_func_id = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-func-vers", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->safe_func_vers = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-channel-id", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->safe_channel_id = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-channel-vers", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtv4Par->safe_channel_vers = (UINT16)valueInt;
-                        }
-                    }
+                    return err;
                 }
-                trdp_XMLLeave(pXML);
-            }
-            if (pSrc != NULL)
-            {
-                pSrc++;
             }
         }
         else if (vos_strnicmp(tag, "destination", MAX_TAG_LEN) == 0)
         {
-            if (countDst > 0u)
+            TRDP_DEST_T *pNewDest = (TRDP_DEST_T *) growArray(&pXML->arena, pExchgParam->pDest, 0u,
+                                                              pExchgParam->destCnt, (UINT32) sizeof(TRDP_DEST_T));
+            if (pNewDest == NULL)
             {
-                pExchgParam->pDest = (TRDP_DEST_T *)vos_memAlloc(countDst * sizeof(TRDP_DEST_T));
-
-                if (pExchgParam->pDest == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                                 (unsigned long) (countDst * sizeof(TRDP_DEST_T)));
-                    return TRDP_MEM_ERR;
-                }
-                pExchgParam->destCnt = countDst;
-                countDst    = 0u;
-                pDest       = pExchgParam->pDest;
+                vos_printLogStr(VOS_LOG_ERROR, "Failed to allocate while reading XML destination definitions!\n");
+                return TRDP_MEM_ERR;
             }
+            pExchgParam->pDest  = pNewDest;
+            pDest               = &pNewDest[pExchgParam->destCnt++];
 
-            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE && pDest != NULL)
+            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE)
             {
                 if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                 {
@@ -722,7 +772,8 @@ static TRDP_ERR_T readTelegramDef (
                     char *p = strchr(value, '@');   /* Get host part only, if no @ found */
                     if (p != NULL)
                     {
-                        pDest->pUriUser = (TRDP_URI_USER_T *) vos_memAlloc(TRDP_MAX_URI_USER_LEN + 1u);
+                        pDest->pUriUser = (TRDP_URI_USER_T *) trdp_XMLArenaAlloc(&pXML->arena,
+                                                                                 TRDP_MAX_URI_USER_LEN + 1u);
                         if (pDest->pUriUser == NULL)
                         {
                             vos_printLog(VOS_LOG_ERROR,
@@ -730,7 +781,7 @@ static TRDP_ERR_T readTelegramDef (
                                          (unsigned int) (TRDP_MAX_URI_USER_LEN + 1));
                             return TRDP_MEM_ERR;
                         }
-                        memcpy(pDest->pUriUser, value, p - value);  /* Trailing zero by vos_memAlloc    */
+                        memcpy(pDest->pUriUser, value, p - value);  /* Trailing zero, arena memory is zeroed    */
                         p++; /* skip '@' */
                     }
                     else
@@ -738,7 +789,7 @@ static TRDP_ERR_T readTelegramDef (
                         p = value;
                     }
 
-                    pDest->pUriHost = (TRDP_URI_HOST_T *) vos_memAlloc((UINT32) strlen(p) + 1u);
+                    pDest->pUriHost = (TRDP_URI_HOST_T *) trdp_XMLArenaAlloc(&pXML->arena, (UINT32) strlen(p) + 1u);
                     if (pDest->pUriHost == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -751,183 +802,39 @@ static TRDP_ERR_T readTelegramDef (
             }
             if (token == TOK_CLOSE)
             {
-                trdp_XMLEnter(pXML);
-                if (trdp_XMLCountStartTag(pXML, "sdt-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "sdt-parameter") == 0 &&
-                    pDest != NULL)
-                {
-                    pDest->pSdtPar = (TRDP_SDT_PAR_T *)vos_memAlloc(sizeof(TRDP_SDT_PAR_T));
-
-                    if (pDest->pSdtPar == NULL)
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                                     (unsigned long) sizeof(TRDP_SDT_PAR_T));
-                        return TRDP_MEM_ERR;
-                    }
-
-                    pDest->pSdtPar->smi2 = TRDP_SDT_DEFAULT_SMI2;
-                    pDest->pSdtPar->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
-                    pDest->pSdtPar->nGuard = TRDP_SDT_DEFAULT_NGUARD;
-                    pDest->pSdtPar->cmThr = TRDP_SDT_DEFAULT_CMTHR;
-                    pDest->pSdtPar->lmiMax = TRDP_SDT_DEFAULT_LMIMAX;
-
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->smi1 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->smi2 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "udv", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->udv = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->rxPeriod = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->txPeriod = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->nrxSafe = (UINT8) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->nGuard = (UINT16) valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "cm-thr", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->cmThr = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "lmi-max", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->lmiMax = (UINT8)valueInt;
-                        }
-                    }
-                }
-                else if (trdp_XMLCountStartTag(pXML, "sdtv4-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "sdtv4-parameter") == 0 &&
-                    pDest != NULL)
+                TRDP_ERR_T err = readSdtPar(pXML, &pDest->pSdtPar, &pDest->pSdtv4Par, "destination");
+                if (err != TRDP_NO_ERR)
                 {
-                    pDest->pSdtv4Par = (TRDP_SDTV4_PAR_T*)vos_memAlloc(sizeof(TRDP_SDTV4_PAR_T));
-
-                    if (pDest->pSdtv4Par == NULL)
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML destination sdtv4 parameter definitions!\n",
-                            (unsigned long)sizeof(TRDP_SDTV4_PAR_T));
-                        return TRDP_MEM_ERR;
-                    }
-
-                    pDest->pSdtv4Par->smi2 = TRDP_SDT_DEFAULT_SMI2;
-                    pDest->pSdtv4Par->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
-                    pDest->pSdtv4Par->nGuard = TRDP_SDT_DEFAULT_NGUARD;
-                    pDest->pSdtv4Par->udv_sub = TRDP_SDTV4_DEFAULT_UDV_SUB;
-                    pDest->pSdtv4Par->proto_var = TRDP_SDTV4_DEFAULT_PROTO_VAR;
-                    pDest->pSdtv4Par->safe_func_id = TRDP_SDTV4_DEFAULT_SAFE_FUNC_ID;
-                    pDest->pSdtv4Par->safe_func_vers = TRDP_SDTV4_DEFAULT_SAFE_FUNC_VERS;
-                    pDest->pSdtv4Par->safe_channel_id = TRDP_SDTV4_DEFAULT_SAFE_CHAN_ID;
-                    pDest->pSdtv4Par->safe_channel_vers = TRDP_SDTV4_DEFAULT_SAFE_CHAN_VERS;
-
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->smi1 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->smi2 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "udv-main", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->udv_main = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "udv-sub", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->udv_sub = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "rx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->rxPeriod = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "tx-period", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->txPeriod = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-rxsafe", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->nrxSafe = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "n-guard", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->nGuard = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "proto-var", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->proto_var = (UINT8)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-func-id", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->safe_func_id = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-func-vers", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->safe_func_vers = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-channel-id", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->safe_channel_id = (UINT16)valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "safe-channel-vers", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtv4Par->safe_channel_vers = (UINT16)valueInt;
-                        }
-                    }
+                    return err;
                 }
-                trdp_XMLLeave(pXML);
-            }
-            if (pDest != NULL)
-            {
-                pDest++;
             }
         }
         else if (vos_strnicmp(tag, "sdtv4-srv-inst-parameter", MAX_TAG_LEN) == 0)
         {
-            if (countSdtv4SrvInstParams > 0u)
-            {
-                pExchgParam->pSdtv4SrvInstPar = (TRDP_SDTV4_SRV_INST_PAR_T*)vos_memAlloc(countSdtv4SrvInstParams * sizeof(TRDP_SDTV4_SRV_INST_PAR_T));
-
-                if (pExchgParam->pSdtv4SrvInstPar == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML sdtv4-srv-inst-parameter definitions!\n",
-                        (unsigned long)(countSdtv4SrvInstParams * sizeof(TRDP_SDTV4_SRV_INST_PAR_T)));
-                    return TRDP_MEM_ERR;
-                }
-                pExchgParam->sdtv4SrvInstParCnt = countSdtv4SrvInstParams;
-                countSdtv4SrvInstParams = 0u;
-                pSdtv4SrvInstPar = pExchgParam->pSdtv4SrvInstPar;
-            }
-
-            if (pSdtv4SrvInstPar != NULL)
+            TRDP_SDTV4_SRV_INST_PAR_T *pNewInst =
+                (TRDP_SDTV4_SRV_INST_PAR_T *) growArray(&pXML->arena, pExchgParam->pSdtv4SrvInstPar, 0u,
+                                                        pExchgParam->sdtv4SrvInstParCnt,
+                                                        (UINT32) sizeof(TRDP_SDTV4_SRV_INST_PAR_T));
+            if (pNewInst == NULL)
             {
-                pSdtv4SrvInstPar->smi2 = TRDP_SDT_DEFAULT_SMI2;
-                pSdtv4SrvInstPar->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
-                pSdtv4SrvInstPar->nGuard = TRDP_SDT_DEFAULT_NGUARD;
-                pSdtv4SrvInstPar->udv_sub = TRDP_SDTV4_DEFAULT_UDV_SUB;
-                pSdtv4SrvInstPar->proto_var = TRDP_SDTV4_DEFAULT_PROTO_VAR;
-                pSdtv4SrvInstPar->safe_func_id = TRDP_SDTV4_DEFAULT_SAFE_FUNC_ID;
-                pSdtv4SrvInstPar->safe_func_vers = TRDP_SDTV4_DEFAULT_SAFE_FUNC_VERS;
-                pSdtv4SrvInstPar->safe_channel_id = TRDP_SDTV4_DEFAULT_SAFE_CHAN_ID;
-                pSdtv4SrvInstPar->safe_channel_vers = TRDP_SDTV4_DEFAULT_SAFE_CHAN_VERS;
+                vos_printLogStr(VOS_LOG_ERROR,
+                                "Failed to allocate while reading XML sdtv4-srv-inst-parameter definitions!\n");
+                return TRDP_MEM_ERR;
             }
-
-            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE && pSdtv4SrvInstPar != NULL)
+            pExchgParam->pSdtv4SrvInstPar   = pNewInst;
+            pSdtv4SrvInstPar                = &pNewInst[pExchgParam->sdtv4SrvInstParCnt++];
+
+            pSdtv4SrvInstPar->smi2 = TRDP_SDT_DEFAULT_SMI2;
+            pSdtv4SrvInstPar->nrxSafe = TRDP_SDT_DEFAULT_NRXSAFE;
+            pSdtv4SrvInstPar->nGuard = TRDP_SDT_DEFAULT_NGUARD;
+            pSdtv4SrvInstPar->udv_sub = TRDP_SDTV4_DEFAULT_UDV_SUB;
+            pSdtv4SrvInstPar->proto_var = TRDP_SDTV4_DEFAULT_PROTO_VAR;
+            pSdtv4SrvInstPar->safe_func_id = TRDP_SDTV4_DEFAULT_SAFE_FUNC_ID;
+            pSdtv4SrvInstPar->safe_func_vers = TRDP_SDTV4_DEFAULT_SAFE_FUNC_VERS;
+            pSdtv4SrvInstPar->safe_channel_id = TRDP_SDTV4_DEFAULT_SAFE_CHAN_ID;
+            pSdtv4SrvInstPar->safe_channel_vers = TRDP_SDTV4_DEFAULT_SAFE_CHAN_VERS;
+
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
             {
                 if (vos_strnicmp(attribute, "instance-id", MAX_TOK_LEN) == 0)
                 {
@@ -986,12 +893,56 @@ static TRDP_ERR_T readTelegramDef (
                     pSdtv4SrvInstPar->safe_channel_vers = (UINT16)valueInt;
                 }
             }
-            if (pSdtv4SrvInstPar != NULL)
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**********************************************************************************************************************/
+/*
+ * Read the optional SDT parameters of a <mapped-source> or <mapped-destination> element in one scan of its children.
+ * Only the first <mapped-sdt-parameter> is read.
+ */
+static TRDP_ERR_T readMappedSdtPar (
+    XML_HANDLE_T        *pXML,
+    TRDP_SDT_PAR_T      * *ppSdtPar)
+{
+    CHAR8   tag[MAX_TAG_LEN];
+    CHAR8   attribute[MAX_TOK_LEN];
+    CHAR8   value[MAX_TOK_LEN];
+    UINT32  valueInt;
+
+    trdp_XMLEnter(pXML);
+
+    while (trdp_XMLSeekStartTagAny(pXML, tag, MAX_TAG_LEN) == 0)
+    {
+        if ((*ppSdtPar == NULL) && (vos_strnicmp(tag, "mapped-sdt-parameter", MAX_TAG_LEN) == 0))
+        {
+            *ppSdtPar = (TRDP_SDT_PAR_T *)trdp_XMLArenaAlloc(&pXML->arena, sizeof(TRDP_SDT_PAR_T));
+
+            if (*ppSdtPar == NULL)
+            {
+                vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
+                    (unsigned long) sizeof(TRDP_SDT_PAR_T));
+                return TRDP_MEM_ERR;
+            }
+
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
             {
-                pSdtv4SrvInstPar++;
+                if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->smi1 = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
+                {
+                    (*ppSdtPar)->smi2 = valueInt;
+                }
             }
         }
     }
+
+    trdp_XMLLeave(pXML);
     return TRDP_NO_ERR;
 }
 
@@ -1004,8 +955,6 @@ static TRDP_ERR_T readMappedTelegramDef(
     CHAR8       attribute[MAX_TOK_LEN];
     CHAR8       value[MAX_TOK_LEN];
     UINT32      valueInt;
-    UINT32      countSrc;
-    UINT32      countDst;
     TRDP_SRC_T  *pSrc;
     TRDP_DEST_T *pDest;
     XML_TOKEN_T token;
@@ -1020,19 +969,13 @@ static TRDP_ERR_T readMappedTelegramDef(
         }
     }
 
-    /* find out how many sources are defined before hand */
-    countSrc = (UINT32)trdp_XMLCountStartTag(pXML, "mapped-source");
-    pSrc = NULL;
-    countDst = (UINT32)trdp_XMLCountStartTag(pXML, "mapped-destination");
-    pDest = NULL;
-
-    /* Iterate thru <telegram> */
+    /* Iterate thru <telegram>, the source and destination tables grow as their elements are found */
 
     while (trdp_XMLSeekStartTagAny(pXML, tag, MAX_TAG_LEN) == 0)
     {
         if (vos_strnicmp(tag, "mapped-pd-parameter", MAX_TAG_LEN) == 0)
         {
-            pExchgParam->pPdPar = (TRDP_PD_PAR_T *)vos_memAlloc(sizeof(TRDP_PD_PAR_T));
+            pExchgParam->pPdPar = (TRDP_PD_PAR_T *)trdp_XMLArenaAlloc(&pXML->arena, sizeof(TRDP_PD_PAR_T));
 
             if (pExchgParam->pPdPar != NULL)
             {
@@ -1047,22 +990,17 @@ static TRDP_ERR_T readMappedTelegramDef(
         }
         else if (vos_strnicmp(tag, "mapped-source", MAX_TAG_LEN) == 0)
         {
-            if (countSrc > 0u)
+            TRDP_SRC_T *pNewSrc = (TRDP_SRC_T *) growArray(&pXML->arena, pExchgParam->pSrc, 0u,
+                                                          pExchgParam->srcCnt, (UINT32) sizeof(TRDP_SRC_T));
+            if (pNewSrc == NULL)
             {
-                pExchgParam->pSrc = (TRDP_SRC_T *)vos_memAlloc(countSrc * sizeof(TRDP_SRC_T));
-
-                if (pExchgParam->pSrc == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                        (unsigned long)(countSrc * sizeof(TRDP_SRC_T)));
-                    return TRDP_MEM_ERR;
-                }
-                pExchgParam->srcCnt = countSrc;
-                countSrc = 0u;
-                pSrc = pExchgParam->pSrc;
+                vos_printLogStr(VOS_LOG_ERROR, "Failed to allocate while reading XML source definitions!\n");
+                return TRDP_MEM_ERR;
             }
+            pExchgParam->pSrc   = pNewSrc;
+            pSrc                = &pNewSrc[pExchgParam->srcCnt++];
 
-            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE && pSrc != NULL)
+            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE)
             {
                 if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                 {
@@ -1073,7 +1011,8 @@ static TRDP_ERR_T readMappedTelegramDef(
                     char *p = strchr(value, '@');   /* Get host part only */
                     if (p != NULL)
                     {
-                        pSrc->pUriUser = (TRDP_URI_USER_T *)vos_memAlloc(TRDP_MAX_URI_USER_LEN + 1u);
+                        pSrc->pUriUser = (TRDP_URI_USER_T *)trdp_XMLArenaAlloc(&pXML->arena,
+                                                                               TRDP_MAX_URI_USER_LEN + 1u);
                         if (pSrc->pUriUser == NULL)
                         {
                             vos_printLog(VOS_LOG_ERROR,
@@ -1081,7 +1020,7 @@ static TRDP_ERR_T readMappedTelegramDef(
                                 (unsigned int)(TRDP_MAX_URI_USER_LEN + 1u));
                             return TRDP_MEM_ERR;
                         }
-                        memcpy(pSrc->pUriUser, value, p - value);  /* Trailing zero by vos_memAlloc    */
+                        memcpy(pSrc->pUriUser, value, p - value);  /* Trailing zero, arena memory is zeroed    */
                         p++;
                     }
                     else
@@ -1089,7 +1028,7 @@ static TRDP_ERR_T readMappedTelegramDef(
                         p = value;
                     }
 
-                    pSrc->pUriHost1 = (TRDP_URI_HOST_T *)vos_memAlloc((UINT32)strlen(p) + 1u);
+                    pSrc->pUriHost1 = (TRDP_URI_HOST_T *)trdp_XMLArenaAlloc(&pXML->arena, (UINT32)strlen(p) + 1u);
                     if (pSrc->pUriHost1 == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -1104,7 +1043,7 @@ static TRDP_ERR_T readMappedTelegramDef(
                     char *p = strchr(value, '@');   /* Get host part only */
                     p = (p == NULL) ? value : p + 1;
 
-                    pSrc->pUriHost2 = (TRDP_URI_HOST_T *)vos_memAlloc((UINT32)strlen(p) + 1u);
+                    pSrc->pUriHost2 = (TRDP_URI_HOST_T *)trdp_XMLArenaAlloc(&pXML->arena, (UINT32)strlen(p) + 1u);
                     if (pSrc->pUriHost2 == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -1121,57 +1060,26 @@ static TRDP_ERR_T readMappedTelegramDef(
             }
             else
             {
-                trdp_XMLEnter(pXML);
-                if (trdp_XMLCountStartTag(pXML, "mapped-sdt-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "mapped-sdt-parameter") == 0 &&
-                    pSrc != NULL)
+                TRDP_ERR_T err = readMappedSdtPar(pXML, &pSrc->pSdtPar);
+                if (err != TRDP_NO_ERR)
                 {
-                    pSrc->pSdtPar = (TRDP_SDT_PAR_T *)vos_memAlloc(sizeof(TRDP_SDT_PAR_T));
-
-                    if (pSrc->pSdtPar == NULL)
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                            (unsigned long) sizeof(TRDP_SDT_PAR_T));
-                        return TRDP_MEM_ERR;
-                    }
-
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->smi1 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                        {
-                            pSrc->pSdtPar->smi2 = valueInt;
-                        }
-                    }
+                    return err;
                 }
-                trdp_XMLLeave(pXML);
-            }
-            if (pSrc != NULL)
-            {
-                pSrc++;
             }
         }
         else if (vos_strnicmp(tag, "mapped-destination", MAX_TAG_LEN) == 0)
         {
-            if (countDst > 0u)
+            TRDP_DEST_T *pNewDest = (TRDP_DEST_T *) growArray(&pXML->arena, pExchgParam->pDest, 0u,
+                                                              pExchgParam->destCnt, (UINT32) sizeof(TRDP_DEST_T));
+            if (pNewDest == NULL)
             {
-                pExchgParam->pDest = (TRDP_DEST_T *)vos_memAlloc(countDst * sizeof(TRDP_DEST_T));
-
-                if (pExchgParam->pDest == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                        (unsigned long)(countDst * sizeof(TRDP_DEST_T)));
-                    return TRDP_MEM_ERR;
-                }
-                pExchgParam->destCnt = countDst;
-                countDst = 0u;
-                pDest = pExchgParam->pDest;
+                vos_printLogStr(VOS_LOG_ERROR, "Failed to allocate while reading XML destination definitions!\n");
+                return TRDP_MEM_ERR;
             }
+            pExchgParam->pDest  = pNewDest;
+            pDest               = &pNewDest[pExchgParam->destCnt++];
 
-            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE && pDest != NULL)
+            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE)
             {
                 if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                 {
@@ -1182,7 +1090,8 @@ static TRDP_ERR_T readMappedTelegramDef(
                     char *p = strchr(value, '@');   /* Get host part only */
                     if (p != NULL)
                     {
-                        pDest->pUriUser = (TRDP_URI_USER_T *)vos_memAlloc(TRDP_MAX_URI_USER_LEN + 1u);
+                        pDest->pUriUser = (TRDP_URI_USER_T *)trdp_XMLArenaAlloc(&pXML->arena,
+                                                                                TRDP_MAX_URI_USER_LEN + 1u);
                         if (pDest->pUriUser == NULL)
                         {
                             vos_printLog(VOS_LOG_ERROR,
@@ -1190,7 +1099,7 @@ static TRDP_ERR_T readMappedTelegramDef(
                                 (unsigned int)(TRDP_MAX_URI_USER_LEN + 1));
                             return TRDP_MEM_ERR;
                         }
-                        memcpy(pDest->pUriUser, value, p - value);  /* Trailing zero by vos_memAlloc    */
+                        memcpy(pDest->pUriUser, value, p - value);  /* Trailing zero, arena memory is zeroed    */
                         p++;
                     }
                     else
@@ -1198,7 +1107,7 @@ static TRDP_ERR_T readMappedTelegramDef(
                         p = value;
                     }
 
-                    pDest->pUriHost = (TRDP_URI_HOST_T *)vos_memAlloc((UINT32)strlen(p) + 1u);
+                    pDest->pUriHost = (TRDP_URI_HOST_T *)trdp_XMLArenaAlloc(&pXML->arena, (UINT32)strlen(p) + 1u);
                     if (pDest->pUriHost == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -1215,37 +1124,11 @@ static TRDP_ERR_T readMappedTelegramDef(
             }
             else
             {
-                trdp_XMLEnter(pXML);
-                if (trdp_XMLCountStartTag(pXML, "mapped-sdt-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "mapped-sdt-parameter") == 0 &&
-                    pDest != NULL)
+                TRDP_ERR_T err = readMappedSdtPar(pXML, &pDest->pSdtPar);
+                if (err != TRDP_NO_ERR)
                 {
-                    pDest->pSdtPar = (TRDP_SDT_PAR_T *)vos_memAlloc(sizeof(TRDP_SDT_PAR_T));
-
-                    if (pDest->pSdtPar == NULL)
-                    {
-                        vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                            (unsigned long) sizeof(TRDP_SDT_PAR_T));
-                        return TRDP_MEM_ERR;
-                    }
-
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "smi1", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->smi1 = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "smi2", MAX_TOK_LEN) == 0)
-                        {
-                            pDest->pSdtPar->smi2 = valueInt;
-                        }
-                    }
+                    return err;
                 }
-                trdp_XMLLeave(pXML);
-            }
-            if (pDest != NULL)
-            {
-                pDest++;
             }
         }
     }
@@ -1253,229 +1136,205 @@ static TRDP_ERR_T readMappedTelegramDef(
 }
 
 /**********************************************************************************************************************/
+/*
+ * Read the comId / dataset id pairs of all telegrams in a <bus-interface-list>.
+ */
 static TRDP_ERR_T readXmlDatasetMap (
     XML_HANDLE_T            *pXML,
     UINT32                  *pNumComId,
     TRDP_COMID_DSID_MAP_T   * *ppComIdDsIdMap)
 {
-    /* CHAR8   tag[MAX_TAG_LEN]; */
-    CHAR8   attribute[MAX_TOK_LEN];
-    CHAR8   value[MAX_TOK_LEN];
-    UINT32  valueInt;
-    UINT32  count   = 0;
-    UINT32  idx     = 0;
-
-    trdp_XMLRewind(pXML);
+    CHAR8                   attribute[MAX_TOK_LEN];
+    CHAR8                   value[MAX_TOK_LEN];
+    UINT32                  valueInt;
+    UINT32                  count   = 0u;
+    TRDP_COMID_DSID_MAP_T   *pMap   = NULL;
+    TRDP_ERR_T              err     = TRDP_NO_ERR;
 
     trdp_XMLEnter(pXML);
 
-    if (trdp_XMLSeekStartTag(pXML, "device") == 0) /* Optional */
+    while ((err == TRDP_NO_ERR) && (trdp_XMLSeekStartTag(pXML, "bus-interface") == 0))
     {
         trdp_XMLEnter(pXML);
-
-        if (trdp_XMLSeekStartTag(pXML, "bus-interface-list") == 0)
+        while (trdp_XMLSeekStartTag(pXML, "telegram") == 0)
         {
-            trdp_XMLEnter(pXML);
-
-            while (trdp_XMLSeekStartTag(pXML, "bus-interface") == 0)
+            TRDP_COMID_DSID_MAP_T *pNewMap =
+                (TRDP_COMID_DSID_MAP_T *) growArray(&pXML->arena, pMap, 0u, count,
+                                                    (UINT32) sizeof(TRDP_COMID_DSID_MAP_T));
+            if (pNewMap == NULL)
             {
-                trdp_XMLEnter(pXML);
-                count += (UINT32) trdp_XMLCountStartTag(pXML, "telegram");
-                trdp_XMLLeave(pXML);
+                vos_printLogStr(VOS_LOG_ERROR, "Failed to allocate while creating XML dataset map!\n");
+                err = TRDP_MEM_ERR;
+                break;
             }
-            trdp_XMLLeave(pXML);
-        }
+            pMap = pNewMap;
 
-        if (count > 0u)
-        {
-            *ppComIdDsIdMap = (TRDP_COMID_DSID_MAP_T *) vos_memAlloc(count * sizeof(TRDP_COMID_DSID_MAP_T));
-            if (*ppComIdDsIdMap == NULL)
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
             {
-                vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while creating XML dataset map!\n",
-                             (unsigned long) (count * sizeof(TRDP_COMID_DSID_MAP_T)));
-                return TRDP_MEM_ERR;
-            }
-            *pNumComId = count;
-        }
-    }
-
-    trdp_XMLLeave(pXML);
-
-    trdp_XMLRewind(pXML);
-
-    trdp_XMLEnter(pXML);
-
-    if (trdp_XMLSeekStartTag(pXML, "device") == 0) /* Optional */
-    {
-        trdp_XMLEnter(pXML);
-
-        if (trdp_XMLSeekStartTag(pXML, "bus-interface-list") == 0)
-        {
-            trdp_XMLEnter(pXML);
-
-            while (trdp_XMLSeekStartTag(pXML, "bus-interface") == 0)
-            {
-                trdp_XMLEnter(pXML);
-                while (trdp_XMLSeekStartTag(pXML, "telegram") == 0)
+                if (vos_strnicmp(attribute, "com-id", MAX_TOK_LEN) == 0)
                 {
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "com-id", MAX_TOK_LEN) == 0)
-                        {
-                            (*ppComIdDsIdMap)[idx].comId = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "data-set-id", MAX_TOK_LEN) == 0)
-                        {
-                            (*ppComIdDsIdMap)[idx].datasetId = valueInt;
-                        }
-                    }
-                    idx++;
+                    pMap[count].comId = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "data-set-id", MAX_TOK_LEN) == 0)
+                {
+                    pMap[count].datasetId = valueInt;
                 }
-                trdp_XMLLeave(pXML);
             }
-            trdp_XMLLeave(pXML);
+            count++;
         }
+        trdp_XMLLeave(pXML);
     }
     trdp_XMLLeave(pXML);
-    return TRDP_NO_ERR;
 
+    if (count > 0u)
+    {
+        *ppComIdDsIdMap = pMap;
+        *pNumComId      = count;
+    }
+    return err;
 }
 
 /**********************************************************************************************************************/
+/*
+ * Read the datasets of a <data-set-list>. Each dataset is allocated together with its elements.
+ */
 static TRDP_ERR_T readXmlDatasets (
     XML_HANDLE_T        *pXML,
     UINT32              *pNumDataset,
     papTRDP_DATASET_T   papDataset)
 {
-    /* CHAR8   tag[MAX_TAG_LEN]; */
-    CHAR8   attribute[MAX_TOK_LEN];
-    CHAR8   value[MAX_TOK_LEN];
-    UINT32  valueInt;
-
-    trdp_XMLRewind(pXML);
+    CHAR8               attribute[MAX_TOK_LEN];
+    CHAR8               value[MAX_TOK_LEN];
+    UINT32              valueInt;
+    UINT32              count       = 0u;
+    apTRDP_DATASET_T    apDataset   = NULL;
+    TRDP_ERR_T          err         = TRDP_NO_ERR;
 
     trdp_XMLEnter(pXML);
 
-    if (trdp_XMLSeekStartTag(pXML, "device") == 0) /* Optional */
+    while ((err == TRDP_NO_ERR) && (trdp_XMLSeekStartTag(pXML, "data-set") == 0))
     {
-        trdp_XMLEnter(pXML);
+        apTRDP_DATASET_T    apNewDataset = (apTRDP_DATASET_T) growArray(&pXML->arena, apDataset, 0u, count,
+                                                                        (UINT32) sizeof(TRDP_DATASET_T *));
+        TRDP_DATASET_T      *pDataset;
 
-        if (trdp_XMLSeekStartTag(pXML, "data-set-list") == 0)
+        if (apNewDataset == NULL)
         {
-            UINT32  count = 0;
-            UINT32  idx;
-
-            trdp_XMLEnter(pXML);
-
-            count = (UINT32) trdp_XMLCountStartTag(pXML, "data-set");
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        apDataset   = apNewDataset;
+        pDataset    = (TRDP_DATASET_T *) growArray(&pXML->arena, NULL, (UINT32) sizeof(TRDP_DATASET_T), 0u,
+                                                   (UINT32) sizeof(TRDP_DATASET_ELEMENT_T));
+        if (pDataset == NULL)
+        {
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        apDataset[count++] = pDataset;
 
-            /* Allocate an array of pointers */
-            *papDataset = (apTRDP_DATASET_T) vos_memAlloc(count * sizeof(apTRDP_DATASET_T));
+        trdp_XMLEnter(pXML);
 
-            if (papDataset == NULL)
+        while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+        {
+            if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
             {
-                vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                             (unsigned long) (count * sizeof(apTRDP_DATASET_T)));
-                return TRDP_MEM_ERR;
+                pDataset->id = valueInt;
             }
-
-            *pNumDataset = count;
-
-            /* Read the interface params */
-            for (idx = 0; idx < *pNumDataset && trdp_XMLSeekStartTag(pXML, "data-set") == 0; idx++)
+            else if (vos_strnicmp(attribute, "name", TRDP_EXTRA_LABEL_LEN) == 0)          /* #349 */
             {
-                UINT32 i = 0u;
-                trdp_XMLEnter(pXML);
-                count = (UINT32) trdp_XMLCountStartTag(pXML, "element");
-
-                /* Allocate the dataset element */
-                (*papDataset)[idx] =
-                    (TRDP_DATASET_T *)vos_memAlloc(count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T));
+               vos_strncpy(pDataset->name, value, (UINT32)strlen(value) + 1u);
+            }
+        }
 
-                if ((*papDataset)[idx] == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR,
-                                 "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                                 (unsigned long) (count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T)));
-                    return TRDP_MEM_ERR;
-                }
+        while (trdp_XMLSeekStartTag(pXML, "element") == 0)
+        {
+            TRDP_DATASET_ELEMENT_T  *pElement;
+            TRDP_DATASET_T          *pNewDataset = (TRDP_DATASET_T *) growArray(&pXML->arena, pDataset,
+                                                                                (UINT32) sizeof(TRDP_DATASET_T),
+                                                                                pDataset->numElement,
+                                                                                (UINT32) sizeof(TRDP_DATASET_ELEMENT_T));
+            if (pNewDataset == NULL)
+            {
+                err = TRDP_MEM_ERR;
+                break;
+            }
+            pDataset                = pNewDataset;
+            apDataset[count - 1u]   = pDataset;
+            pElement                = &pDataset->pElement[pDataset->numElement];
 
-                while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+            pElement->size = 1;   /* default  */
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+            {
+                if (vos_strnicmp(attribute, "type", MAX_TOK_LEN) == 0)
                 {
-                    if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
+                    if (valueInt == 0)
                     {
-                        (*papDataset)[idx]->id = valueInt;
+                        pElement->type = string2type(value);
                     }
-                    else if (vos_strnicmp(attribute, "name", TRDP_EXTRA_LABEL_LEN) == 0)          /* #349 */
+                    else
                     {
-                       vos_strncpy((*papDataset)[idx]->name, value, (UINT32)strlen(value) + 1u);
+                        pElement->type = valueInt;
                     }
                 }
-
-                while (trdp_XMLSeekStartTag(pXML, "element") == 0)
-                {
-                    (*papDataset)[idx]->pElement[i].size = 1;   /* default  */
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "type", MAX_TOK_LEN) == 0)
-                        {
-                            if (valueInt == 0)
-                            {
-                                (*papDataset)[idx]->pElement[i].type = string2type(value);
-                            }
-                            else
-                            {
-                                (*papDataset)[idx]->pElement[i].type = valueInt;
-                            }
-                        }
-                        else if (vos_strnicmp(attribute, "array-size", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].size = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "unit", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].unit = (CHAR8 *) vos_memAlloc((UINT32) strlen(value) + 1u);
-                            if ((*papDataset)[idx]->pElement[i].unit == NULL)
-                            {
-                                return TRDP_MEM_ERR;
-                            }
-                            vos_strncpy((*papDataset)[idx]->pElement[i].unit, value, (UINT32) strlen(value) + 1u);
-                        }
-                        else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].name = (CHAR8 *) vos_memAlloc((UINT32) strlen(value) + 1u);
-                            if ((*papDataset)[idx]->pElement[i].name == NULL)
-                            {
-                                return TRDP_MEM_ERR;
-                            }
-                            vos_strncpy((*papDataset)[idx]->pElement[i].name, value, (UINT32) strlen(value) + 1u);
-                        }
-                        else if (vos_strnicmp(attribute, "scale", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].scale = (REAL32) strtod(value, NULL);
-                        }
-                        else if (vos_strnicmp(attribute, "offset", MAX_TOK_LEN) == 0)
-                        {
-                            VOS_SET_ERRNO(0);
-                            (*papDataset)[idx]->pElement[i].offset = (INT32) strtol(value, NULL, 10);
-                            /* Note: The behaviour of strtol in case of overflow depends on the data model (32/64).
-                                    We check the errno for overflow and set the offset to zero, anyway */
-                            if ((errno == EINVAL) || (errno == ERANGE))
-                            {
-                                (*papDataset)[idx]->pElement[i].offset = 0;
-                            }
-                        }
+                else if (vos_strnicmp(attribute, "array-size", MAX_TOK_LEN) == 0)
+                {
+                    pElement->size = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "unit", MAX_TOK_LEN) == 0)
+                {
+                    pElement->unit = (CHAR8 *) trdp_XMLArenaAlloc(&pXML->arena, (UINT32) strlen(value) + 1u);
+                    if (pElement->unit == NULL)
+                    {
+                        err = TRDP_MEM_ERR;
+                        break;
+                    }
+                    vos_strncpy(pElement->unit, value, (UINT32) strlen(value) + 1u);
+                }
+                else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
+                {
+                    pElement->name = (CHAR8 *) trdp_XMLArenaAlloc(&pXML->arena, (UINT32) strlen(value) + 1u);
+                    if (pElement->name == NULL)
+                    {
+                        err = TRDP_MEM_ERR;
+                        break;
                     }
-                    (*papDataset)[idx]->numElement++;
-                    i++;
+                    vos_strncpy(pElement->name, value, (UINT32) strlen(value) + 1u);
                 }
-                trdp_XMLLeave(pXML);
+                else if (vos_strnicmp(attribute, "scale", MAX_TOK_LEN) == 0)
+                {
+                    pElement->scale = (REAL32) strtod(value, NULL);
+                }
+                else if (vos_strnicmp(attribute, "offset", MAX_TOK_LEN) == 0)
+                {
+                    VOS_SET_ERRNO(0);
+                    pElement->offset = (INT32) strtol(value, NULL, 10);
+                    /* Note: The behaviour of strtol in case of overflow depends on the data model (32/64).
+                            We check the errno for overflow and set the offset to zero, anyway */
+                    if ((errno == EINVAL) || (errno == ERANGE))
+                    {
+                        pElement->offset = 0;
+                    }
+                }
+            }
+            pDataset->numElement++;
+            if (err != TRDP_NO_ERR)
+            {
+                break;
             }
         }
         trdp_XMLLeave(pXML);
     }
     trdp_XMLLeave(pXML);
-    return TRDP_NO_ERR;
+
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Failed to allocate while reading XML dataset definitions!\n");
+    }
+
+    *papDataset     = apDataset;
+    *pNumDataset    = count;
+    return err;
 }
 
 /******************************************************************************
@@ -1573,6 +1432,7 @@ EXT_DECL TRDP_ERR_T tau_prepareXmlMem (
 
 /**********************************************************************************************************************/
 /**    Free all the memory allocated by tau_prepareXmlDoc
+ *  This includes the telegram, dataset and service configurations read from the document.
  *
  *
  *  @param[in]     pDocHnd           Handle of the parsed XML file
@@ -1596,7 +1456,7 @@ EXT_DECL void tau_freeXmlDoc (
 
 /**********************************************************************************************************************/
 /**    Read the interface relevant telegram parameters (except data set configuration) out of the configuration file .
- *
+ *  The telegram configurations are allocated from the document and stay valid until tau_freeXmlDoc.
  *
  *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
  *  @param[in]      pIfName           Interface name
@@ -1684,7 +1544,8 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
 
                 while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "bus-interface") == 0)
                 {
-                    UINT32 idx = 0, count = 0;
+                    UINT32              idx         = 0u;
+                    TRDP_EXCHG_PAR_T    *pExchgPar  = NULL;
 
                     /* find the interface, if its name was supplied, otherwise take the first one which was defined */
                     if (pIfName != NULL && strlen(pIfName))
@@ -1706,23 +1567,6 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
 
                     trdp_XMLEnter(pDocHnd->pXmlDocument);
 
-                    /* find out how many telegrams are defined before hand */
-
-                    count = (UINT32) trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "telegram");
-
-                    if (count > 0u)
-                    {
-                        *ppExchgPar = (TRDP_EXCHG_PAR_T *)vos_memAlloc(count * sizeof(TRDP_EXCHG_PAR_T));
-
-                        if (*ppExchgPar == NULL)
-                        {
-                            vos_printLog(VOS_LOG_ERROR,
-                                         "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                                         (unsigned long) (count * sizeof(TRDP_EXCHG_PAR_T)));
-                            return TRDP_MEM_ERR;
-                        }
-                    }
-
                     while (trdp_XMLSeekStartTagAny(pDocHnd->pXmlDocument, tag, MAX_TAG_LEN) == 0)
                     {
                         if (vos_strnicmp(tag, "pd-com-parameter", MAX_TOK_LEN) == 0)
@@ -1869,6 +1713,27 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                         pProcessConfig->options &= (TRDP_OPTION_T) ~TRDP_OPTION_TRAFFIC_SHAPING;
                                     }
                                 }
+                                else if (vos_strnicmp(attribute, "timestamping", MAX_TOK_LEN) == 0)
+                                {
+                                    if (vos_strnicmp("yes", value, TRDP_MAX_LABEL_LEN) == 0)
+                                    {
+                                        pProcessConfig->options |= TRDP_OPTION_TIMESTAMPING;
+                                    }
+                                }
+                                else if (vos_strnicmp(attribute, "txtime", MAX_TOK_LEN) == 0)
+                                {
+                                    if (vos_strnicmp("yes", value, TRDP_MAX_LABEL_LEN) == 0)
+                                    {
+                                        pProcessConfig->options |= TRDP_OPTION_TXTIME;
+                                    }
+                                }
+                                else if (vos_strnicmp(attribute, "packet-ring", MAX_TOK_LEN) == 0)
+                                {
+                                    if (vos_strnicmp("yes", value, TRDP_MAX_LABEL_LEN) == 0)
+                                    {
+                                        pProcessConfig->options |= TRDP_OPTION_PACKET_RING;
+                                    }
+                                }
                                 else if (vos_strnicmp(attribute, "priority", MAX_TOK_LEN) == 0)
                                 {
                                     pProcessConfig->priority = valueInt;
@@ -1885,22 +1750,42 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                             }
                         }
                         /* read the n-th telegram / exchange parameters */
-                        if (count > 0u && count > idx && vos_strnicmp(tag, "telegram", MAX_TAG_LEN) == 0)
+                        if (vos_strnicmp(tag, "telegram", MAX_TAG_LEN) == 0)
                         {
+                            TRDP_EXCHG_PAR_T *pNewExchgPar =
+                                (TRDP_EXCHG_PAR_T *) growArray(&pDocHnd->pXmlDocument->arena, pExchgPar, 0u, idx,
+                                                               sizeof(TRDP_EXCHG_PAR_T));
+                            if (pNewExchgPar == NULL)
+                            {
+                                vos_printLog(VOS_LOG_ERROR,
+                                             "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
+                                             (unsigned long) ((idx + 1u) * sizeof(TRDP_EXCHG_PAR_T)));
+                                if (pExchgPar != NULL)
+                                {
+                                    *ppExchgPar = pExchgPar;
+                                }
+                                return TRDP_MEM_ERR;
+                            }
+                            pExchgPar = pNewExchgPar;
                             trdp_XMLEnter(pDocHnd->pXmlDocument);
-                            result = readTelegramDef(pDocHnd->pXmlDocument, &(*ppExchgPar)[idx]);
+                            result = readTelegramDef(pDocHnd->pXmlDocument, &pExchgPar[idx]);
 #ifdef LIST_EXCH_PARAMS
-                            dbgPrint(1, &(*ppExchgPar)[idx]);
+                            dbgPrint(1, &pExchgPar[idx]);
 #endif
                             trdp_XMLLeave(pDocHnd->pXmlDocument);
                             if (result != TRDP_NO_ERR)
                             {
+                                *ppExchgPar = pExchgPar;
                                 return result;
                             }
                             idx++;
                         }
                     }
-                    *pNumExchgPar = count;
+                    if (pExchgPar != NULL)
+                    {
+                        *ppExchgPar = pExchgPar;
+                    }
+                    *pNumExchgPar = idx;
                 }
                 trdp_XMLLeave(pDocHnd->pXmlDocument);
             }
@@ -1914,6 +1799,8 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
 
 /**********************************************************************************************************************/
 /**    Free array of telegram configurations allocated by tau_readXmlInterfaceConfig
+ *  The telegram configurations are allocated from the document (or cache) they were read from and are released
+ *  with it by tau_freeXmlDoc (tau_closeXmlCache), nothing is freed here.
  *
  *  @param[in]      numExchgPar       Number of telegram configurations in the array
  *  @param[in]      pExchgPar         Pointer to array of telegram configurations
@@ -1923,86 +1810,8 @@ EXT_DECL void tau_freeTelegrams (
     UINT32              numExchgPar,
     TRDP_EXCHG_PAR_T    *pExchgPar)
 {
-    UINT32  idxEP;
-    UINT32  i;
-
-    /*  Check parameters    */
-    if (numExchgPar == 0u || pExchgPar == NULL)
-    {
-        return;
-    }
-
-    /*  Iterate over all exchange parameters    */
-    for (idxEP = 0u; idxEP < numExchgPar; idxEP++)
-    {
-        /*  Free MD and PD parameters   */
-        if (pExchgPar[idxEP].pMdPar)
-        {
-            vos_memFree(pExchgPar[idxEP].pMdPar);
-        }
-
-        if (pExchgPar[idxEP].pPdPar)
-        {
-            vos_memFree(pExchgPar[idxEP].pPdPar);
-        }
-
-        /*  vos_memFree array of destinations  */
-        if (pExchgPar[idxEP].destCnt)
-        {
-            /*  Iterate ove all destinations    */
-            for (i = 0u; i < pExchgPar[idxEP].destCnt; i++)
-            {
-                /*  vos_free URIs   */
-                if (pExchgPar[idxEP].pDest[i].pUriHost)
-                {
-                    vos_memFree(pExchgPar[idxEP].pDest[i].pUriHost);
-                }
-                if (pExchgPar[idxEP].pDest[i].pUriUser)
-                {
-                    vos_memFree(pExchgPar[idxEP].pDest[i].pUriUser);
-                }
-                /*  Free SDT parameters */
-                if (pExchgPar[idxEP].pDest[i].pSdtPar)
-                {
-                    vos_memFree(pExchgPar[idxEP].pDest[i].pSdtPar);
-                }
-            }
-            /*  Free destinations array  */
-            vos_memFree(pExchgPar[idxEP].pDest);
-        }
-        /*  Free array of sources  */
-        if (pExchgPar[idxEP].srcCnt)
-        {
-            /*  Iterate over all sources    */
-            for (i = 0u; i < pExchgPar[idxEP].srcCnt; i++)
-            {
-                /*  Free URIs   */
-                if (pExchgPar[idxEP].pSrc[i].pUriHost1)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pUriHost1);
-                }
-                if (pExchgPar[idxEP].pSrc[i].pUriHost2)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pUriHost2);
-                }
-                if (pExchgPar[idxEP].pSrc[i].pUriUser)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pUriUser);
-                }
-                /*  Free SDT parameters */
-                if (pExchgPar[idxEP].pSrc[i].pSdtPar)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pSdtPar);
-                }
-            }
-            /*  Free sources array  */
-            vos_memFree(pExchgPar[idxEP].pSrc);
-        }
-
-    }
-
-    /*  Free array of TRDP_EXCHG_PAR_T structures   */
-    vos_memFree(pExchgPar);
+    (void) numExchgPar;
+    (void) pExchgPar;
 }
 
 /**********************************************************************************************************************/
@@ -2158,87 +1967,109 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
             }
             else if (vos_strnicmp(tag, "com-parameter-list", MAX_TAG_LEN) == 0)
             {
-                UINT32 count = 0u;
+                UINT32          count       = 0u;
+                TRDP_COM_PAR_T  *pComPar    = NULL;
                 trdp_XMLEnter(pDocHnd->pXmlDocument);
 
-                count = (UINT32) trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "com-parameter");
-
-                *ppComPar = (TRDP_COM_PAR_T *)vos_memAlloc(count * sizeof(TRDP_COM_PAR_T));
-
-                if (*ppComPar != NULL)
+                /* Read the com params */
+                while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "com-parameter") == 0)
                 {
-                    UINT32 i;
-                    *pNumComPar = count;
-
-                    /* Read the com params */
-                    for (i = 0u; i < count && trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "com-parameter") == 0; i++)
+                    TRDP_COM_PAR_T *pNewComPar = (TRDP_COM_PAR_T *) growArray(NULL, pComPar, 0u, count,
+                                                                               sizeof(TRDP_COM_PAR_T));
+                    if (pNewComPar == NULL)
                     {
-                        /* Set some defaults */
-                        (*ppComPar)[i].sendParam.ttl = TRDP_MD_DEFAULT_TTL;
-                        (*ppComPar)[i].sendParam.retries = TRDP_MD_DEFAULT_RETRIES;
+                        vos_printLog(VOS_LOG_ERROR,
+                                     "%lu Bytes failed to allocate while reading XML com parameters!\n",
+                                     (unsigned long) ((count + 1u) * sizeof(TRDP_COM_PAR_T)));
+                        vos_memFree(pComPar);
+                        pComPar = NULL;
+                        break;
+                    }
+                    pComPar = pNewComPar;
 
-                        while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
-                                                    value) == TOK_ATTRIBUTE)
+                    /* Set some defaults */
+                    pComPar[count].sendParam.ttl = TRDP_MD_DEFAULT_TTL;
+                    pComPar[count].sendParam.retries = TRDP_MD_DEFAULT_RETRIES;
+
+                    while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
+                                                value) == TOK_ATTRIBUTE)
+                    {
+                        if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                         {
-                            if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].id = valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "qos", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].sendParam.qos = (UINT8) valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "ttl", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].sendParam.ttl = (UINT8) valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "retries", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].sendParam.retries = (UINT8) valueInt;
-                            }
+                            pComPar[count].id = valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "qos", MAX_TOK_LEN) == 0)
+                        {
+                            pComPar[count].sendParam.qos = (UINT8) valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "ttl", MAX_TOK_LEN) == 0)
+                        {
+                            pComPar[count].sendParam.ttl = (UINT8) valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "retries", MAX_TOK_LEN) == 0)
+                        {
+                            pComPar[count].sendParam.retries = (UINT8) valueInt;
                         }
                     }
+                    count++;
+                }
+
+                *ppComPar = pComPar;
+                if (pComPar != NULL)
+                {
+                    *pNumComPar = count;
                 }
                 trdp_XMLLeave(pDocHnd->pXmlDocument);
             }
             else if (vos_strnicmp(tag, "bus-interface-list", MAX_TAG_LEN) == 0)
             {
-                UINT32 count = 0u;
+                UINT32              count       = 0u;
+                TRDP_IF_CONFIG_T    *pIfConfig  = NULL;
                 trdp_XMLEnter(pDocHnd->pXmlDocument);
 
-                count = (UINT32) trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "bus-interface");
-
-                *ppIfConfig = (TRDP_IF_CONFIG_T *)vos_memAlloc(count * sizeof(TRDP_IF_CONFIG_T));
-
-                if (*ppIfConfig != NULL)
+                /* Read the interface params */
+                while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "bus-interface") == 0)
                 {
-                    UINT32 i;
-                    *pNumIfConfig = count;
+                    TRDP_IF_CONFIG_T *pNewIfConfig = (TRDP_IF_CONFIG_T *) growArray(NULL, pIfConfig, 0u, count,
+                                                                                     sizeof(TRDP_IF_CONFIG_T));
+                    if (pNewIfConfig == NULL)
+                    {
+                        vos_printLog(VOS_LOG_ERROR,
+                                     "%lu Bytes failed to allocate while reading XML interface parameters!\n",
+                                     (unsigned long) ((count + 1u) * sizeof(TRDP_IF_CONFIG_T)));
+                        vos_memFree(pIfConfig);
+                        pIfConfig = NULL;
+                        break;
+                    }
+                    pIfConfig = pNewIfConfig;
 
-                    /* Read the interface params */
-                    for (i = 0u; i < count && trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "bus-interface") == 0; i++)
+                    while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
+                                                value) == TOK_ATTRIBUTE)
                     {
-                        while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
-                                                    value) == TOK_ATTRIBUTE)
+                        if (vos_strnicmp(attribute, "network-id", MAX_TOK_LEN) == 0)
                         {
-                            if (vos_strnicmp(attribute, "network-id", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppIfConfig)[i].networkId = (UINT8) valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
-                            {
-                                vos_strncpy((*ppIfConfig)[i].ifName, value, TRDP_MAX_LABEL_LEN);
-                            }
-                            else if (vos_strnicmp(attribute, "host-ip", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppIfConfig)[i].hostIp = vos_dottedIP(value);
-                            }
-                            else if (vos_strnicmp(attribute, "leader-ip", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppIfConfig)[i].leaderIp = vos_dottedIP(value);
-                            }
+                            pIfConfig[count].networkId = (UINT8) valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
+                        {
+                            vos_strncpy(pIfConfig[count].ifName, value, TRDP_MAX_LABEL_LEN);
+                        }
+                        else if (vos_strnicmp(attribute, "host-ip", MAX_TOK_LEN) == 0)
+                        {
+                            pIfConfig[count].hostIp = vos_dottedIP(value);
+                        }
+                        else if (vos_strnicmp(attribute, "leader-ip", MAX_TOK_LEN) == 0)
+                        {
+                            pIfConfig[count].leaderIp = vos_dottedIP(value);
                         }
                     }
+                    count++;
+                }
+
+                *ppIfConfig = pIfConfig;
+                if (pIfConfig != NULL)
+                {
+                    *pNumIfConfig = count;
                 }
                 trdp_XMLLeave(pDocHnd->pXmlDocument);
             }
@@ -2297,31 +2128,44 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedDevices(
             trdp_XMLEnter(pDocHnd->pXmlDocument);
             if (ppProcessConfig != NULL)
             {
-                UINT32 count = 0u;
-                count = (UINT32)trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "mapped-device");
+                UINT32                  count           = 0u;
+                TRDP_PROCESS_CONFIG_T   *pProcessConfig = NULL;
 
-                *ppProcessConfig = (TRDP_PROCESS_CONFIG_T *)vos_memAlloc(count * sizeof(TRDP_PROCESS_CONFIG_T));
-
-                if (*ppProcessConfig != NULL)
+                /* Read the mapped devices */
+                while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "mapped-device") == 0)
                 {
-                    UINT32 i;
-                    *pNumProcConfig = count;
+                    TRDP_PROCESS_CONFIG_T *pNewProcessConfig =
+                        (TRDP_PROCESS_CONFIG_T *) growArray(NULL, pProcessConfig, 0u, count,
+                                                            sizeof(TRDP_PROCESS_CONFIG_T));
+                    if (pNewProcessConfig == NULL)
+                    {
+                        vos_printLog(VOS_LOG_ERROR,
+                                     "%lu Bytes failed to allocate while reading XML mapped devices!\n",
+                                     (unsigned long) ((count + 1u) * sizeof(TRDP_PROCESS_CONFIG_T)));
+                        vos_memFree(pProcessConfig);
+                        pProcessConfig = NULL;
+                        break;
+                    }
+                    pProcessConfig = pNewProcessConfig;
 
-                    /* Read the mapped devices */
-                    for (i = 0u; i < count && trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "mapped-device") == 0; i++)
+                    while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt, value) == TOK_ATTRIBUTE)
                     {
-                        while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                        if (vos_strnicmp(attribute, "host-name", MAX_TOK_LEN) == 0)
                         {
-                            if (vos_strnicmp(attribute, "host-name", MAX_TOK_LEN) == 0)
-                            {
-                                vos_strncpy((*ppProcessConfig)[i].hostName, value, TRDP_MAX_LABEL_LEN);
-                            }
-                            else if (vos_strnicmp(attribute, "leader-name", MAX_TOK_LEN) == 0)
-                            {
-                                vos_strncpy((*ppProcessConfig)[i].leaderName, value, TRDP_MAX_LABEL_LEN);
-                            }
+                            vos_strncpy(pProcessConfig[count].hostName, value, TRDP_MAX_LABEL_LEN);
+                        }
+                        else if (vos_strnicmp(attribute, "leader-name", MAX_TOK_LEN) == 0)
+                        {
+                            vos_strncpy(pProcessConfig[count].leaderName, value, TRDP_MAX_LABEL_LEN);
                         }
                     }
+                    count++;
+                }
+
+                *ppProcessConfig = pProcessConfig;
+                if (pProcessConfig != NULL)
+                {
+                    *pNumProcConfig = count;
                 }
             }
         }
@@ -2404,35 +2248,47 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedDeviceConfig(
 
                 if (ppIfConfig != NULL)
                 {
-                    UINT32 count = 0u;
-                    count = (UINT32)trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "mapped-bus-interface");
-
-                    *ppIfConfig = (TRDP_IF_CONFIG_T *)vos_memAlloc(count * sizeof(TRDP_IF_CONFIG_T));
+                    UINT32              count       = 0u;
+                    TRDP_IF_CONFIG_T    *pIfConfig  = NULL;
 
-                    if (*ppIfConfig != NULL)
+                    /* Read the com params */
+                    while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "mapped-bus-interface") == 0)
                     {
-                        UINT32 i;
-                        *pNumIfConfig = count;
+                        TRDP_IF_CONFIG_T *pNewIfConfig = (TRDP_IF_CONFIG_T *) growArray(NULL, pIfConfig, 0u, count,
+                                                                                         sizeof(TRDP_IF_CONFIG_T));
+                        if (pNewIfConfig == NULL)
+                        {
+                            vos_printLog(VOS_LOG_ERROR,
+                                         "%lu Bytes failed to allocate while reading XML mapped interfaces!\n",
+                                         (unsigned long) ((count + 1u) * sizeof(TRDP_IF_CONFIG_T)));
+                            vos_memFree(pIfConfig);
+                            pIfConfig = NULL;
+                            break;
+                        }
+                        pIfConfig = pNewIfConfig;
 
-                        /* Read the com params */
-                        for (i = 0u; i < count && trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "mapped-bus-interface") == 0; i++)
+                        while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt, value) == TOK_ATTRIBUTE)
                         {
-                            while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                            if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
                             {
-                                if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
-                                {
-                                    vos_strncpy((*ppIfConfig)[i].ifName, value, TRDP_MAX_LABEL_LEN);
-                                }
-                                else if (vos_strnicmp(attribute, "host-ip", MAX_TOK_LEN) == 0)
-                                {
-                                    (*ppIfConfig)[i].hostIp = vos_dottedIP(value);
-                                }
-                                else if (vos_strnicmp(attribute, "leader-ip", MAX_TOK_LEN) == 0)
-                                {
-                                    (*ppIfConfig)[i].leaderIp = vos_dottedIP(value);
-                                }
+                                vos_strncpy(pIfConfig[count].ifName, value, TRDP_MAX_LABEL_LEN);
+                            }
+                            else if (vos_strnicmp(attribute, "host-ip", MAX_TOK_LEN) == 0)
+                            {
+                                pIfConfig[count].hostIp = vos_dottedIP(value);
+                            }
+                            else if (vos_strnicmp(attribute, "leader-ip", MAX_TOK_LEN) == 0)
+                            {
+                                pIfConfig[count].leaderIp = vos_dottedIP(value);
                             }
                         }
+                        count++;
+                    }
+
+                    *ppIfConfig = pIfConfig;
+                    if (pIfConfig != NULL)
+                    {
+                        *pNumIfConfig = count;
                     }
                 }
             }
@@ -2447,7 +2303,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedDeviceConfig(
 /**********************************************************************************************************************/
 /**    Read the interface relevant mapped telegram parameters for a particular host and it's interface
 *  out of the configuration file .
-*
+*  The telegram configurations are allocated from the document and stay valid until tau_freeXmlDoc.
 *
 *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
 *  @param[in]      pHostname         Host name
@@ -2521,7 +2377,8 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedInterfaceConfig(
                 trdp_XMLEnter(pDocHnd->pXmlDocument);
                 while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "mapped-bus-interface") == 0)
                 {
-                    UINT32 idx = 0, count = 0;
+                    UINT32              idx         = 0u;
+                    TRDP_EXCHG_PAR_T    *pExchgPar  = NULL;
                     foundIdx = 0;
 
                     /* find the interface, if its name was supplied, otherwise take the first one which was defined */
@@ -2544,40 +2401,43 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedInterfaceConfig(
 
                     trdp_XMLEnter(pDocHnd->pXmlDocument);
 
-                    /* find out how many telegrams are defined before hand */
-
-                    count = (UINT32)trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "mapped-telegram");
-
-                    if (count > 0u)
-                    {
-                        *ppExchgPar = (TRDP_EXCHG_PAR_T *)vos_memAlloc(count * sizeof(TRDP_EXCHG_PAR_T));
-
-                        if (*ppExchgPar == NULL)
-                        {
-                            vos_printLog(VOS_LOG_ERROR,
-                                "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                                (unsigned long)(count * sizeof(TRDP_EXCHG_PAR_T)));
-                            return TRDP_MEM_ERR;
-                        }
-                    }
-
                     while (trdp_XMLSeekStartTagAny(pDocHnd->pXmlDocument, tag, MAX_TAG_LEN) == 0)
                     {
                         /* read the n-th telegram / exchange parameters */
-                        if (count > 0u && count > idx && vos_strnicmp(tag, "mapped-telegram", MAX_TAG_LEN) == 0)
+                        if (vos_strnicmp(tag, "mapped-telegram", MAX_TAG_LEN) == 0)
                         {
+                            TRDP_EXCHG_PAR_T *pNewExchgPar =
+                                (TRDP_EXCHG_PAR_T *) growArray(&pDocHnd->pXmlDocument->arena, pExchgPar, 0u, idx,
+                                                               sizeof(TRDP_EXCHG_PAR_T));
+                            if (pNewExchgPar == NULL)
+                            {
+                                vos_printLog(VOS_LOG_ERROR,
+                                    "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
+                                    (unsigned long)((idx + 1u) * sizeof(TRDP_EXCHG_PAR_T)));
+                                if (pExchgPar != NULL)
+                                {
+                                    *ppExchgPar = pExchgPar;
+                                }
+                                return TRDP_MEM_ERR;
+                            }
+                            pExchgPar = pNewExchgPar;
                             trdp_XMLEnter(pDocHnd->pXmlDocument);
-                            result = readMappedTelegramDef(pDocHnd->pXmlDocument, &(*ppExchgPar)[idx]);
+                            result = readMappedTelegramDef(pDocHnd->pXmlDocument, &pExchgPar[idx]);
 
                             trdp_XMLLeave(pDocHnd->pXmlDocument);
                             if (result != TRDP_NO_ERR)
                             {
+                                *ppExchgPar = pExchgPar;
                                 return result;
                             }
                             idx++;
                         }
                     }
-                    *pNumExchgPar = count;
+                    if (pExchgPar != NULL)
+                    {
+                        *ppExchgPar = pExchgPar;
+                    }
+                    *pNumExchgPar = idx;
                 }
                 trdp_XMLLeave(pDocHnd->pXmlDocument);
             }
@@ -2592,7 +2452,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlMappedInterfaceConfig(
 
 /**********************************************************************************************************************/
 /**    Function to read the DataSet configuration out of the XML configuration file.
- *
+ *  The DataSet configuration is allocated from the document and stays valid until tau_freeXmlDoc.
  *
  *  @param[in]      pDocHnd             Handle of the XML document prepared by tau_prepareXmlDoc
  *  @param[out]     pNumComId           Pointer to the number of entries in the ComId DatasetId mapping list
@@ -2613,18 +2473,45 @@ EXT_DECL TRDP_ERR_T tau_readXmlDatasetConfig (
     apTRDP_DATASET_T            *apDataset
     )
 {
-    TRDP_ERR_T err = readXmlDatasetMap(pDocHnd->pXmlDocument, pNumComId, ppComIdDsIdMap);
-    if (err == TRDP_NO_ERR)
+    CHAR8       tag[MAX_TAG_LEN];
+    BOOL8       mapRead         = FALSE;
+    BOOL8       datasetsRead    = FALSE;
+    TRDP_ERR_T  err             = TRDP_NO_ERR;
+
+    trdp_XMLRewind(pDocHnd->pXmlDocument);
+
+    trdp_XMLEnter(pDocHnd->pXmlDocument);
+
+    if (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "device") == 0) /* Optional */
     {
-        err = readXmlDatasets(pDocHnd->pXmlDocument, pNumDataset, apDataset);
+        trdp_XMLEnter(pDocHnd->pXmlDocument);
+
+        /* One pass thru <device>, the first telegram list and the first dataset list are read where they are found */
+        while ((err == TRDP_NO_ERR) && (trdp_XMLSeekStartTagAny(pDocHnd->pXmlDocument, tag, MAX_TAG_LEN) == 0))
+        {
+            if ((mapRead == FALSE) && (vos_strnicmp(tag, "bus-interface-list", MAX_TAG_LEN) == 0))
+            {
+                mapRead = TRUE;
+                err     = readXmlDatasetMap(pDocHnd->pXmlDocument, pNumComId, ppComIdDsIdMap);
+            }
+            else if ((datasetsRead == FALSE) && (vos_strnicmp(tag, "data-set-list", MAX_TAG_LEN) == 0))
+            {
+                datasetsRead    = TRUE;
+                err             = readXmlDatasets(pDocHnd->pXmlDocument, pNumDataset, apDataset);
+            }
+        }
+        trdp_XMLLeave(pDocHnd->pXmlDocument);
     }
+    trdp_XMLLeave(pDocHnd->pXmlDocument);
+
     return err;
 }
 
 /**********************************************************************************************************************/
 /**    Function to free the memory for the DataSet configuration
  *
- *  Free the memory for the DataSet configuration which was allocated when parsing the XML configuration file.
+ *  The DataSet configuration is allocated from the document (or cache) it was read from and is released with it
+ *  by tau_freeXmlDoc (tau_closeXmlCache), nothing is freed here.
  *
  *
  *  @param[in]      numComId            The number of entries in the ComId DatasetId mapping list
@@ -2641,45 +2528,15 @@ EXT_DECL void tau_freeXmlDatasetConfig (
     UINT32                  numDataset,
     TRDP_DATASET_T          * *ppDataset)
 {
-    UINT32  i;
-    UINT32  j;
-
-    /*  Mapping between ComId and DatasetId   */
-    if (numComId > 0u && pComIdDsIdMap != NULL)
-    {
-        vos_memFree(pComIdDsIdMap);
-        pComIdDsIdMap = NULL;
-    }
-
-    /*  Dataset definitions   */
-    if (numDataset > 0u && ppDataset != NULL)
-    {
-        for (i = 0u; i < numDataset; ++i)
-        {
-            for (j = 0u; j < ppDataset[i]->numElement; ++j)
-            {
-                if (ppDataset[i]->pElement[j].unit != NULL)
-                {
-                    vos_memFree(ppDataset[i]->pElement[j].unit);
-                    ppDataset[i]->pElement[j].unit = NULL;
-                }
-                if (ppDataset[i]->pElement[j].name != NULL)
-                {
-                    vos_memFree(ppDataset[i]->pElement[j].name);
-                    ppDataset[i]->pElement[j].name = NULL;
-                }
-            }
-            vos_memFree(ppDataset[i]);
-            ppDataset[i] = NULL;
-        }
-        vos_memFree(ppDataset);
-        ppDataset = NULL;
-    }
+    (void) numComId;
+    (void) pComIdDsIdMap;
+    (void) numDataset;
+    (void) ppDataset;
 }
 
 /**********************************************************************************************************************/
 /**    Function to read the TRDP device service definitions out of the XML configuration file.
- *  The user must release the memory for pServiceDefs (using vos_memFree)
+ *  The service definitions are allocated from the document and released by tau_freeXmlDoc.
  *
  *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
  *  @param[out]     pNumServiceDefs   Pointer to number of defined Services
@@ -2706,6 +2563,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
     TRDP_SERVICE_DEVICE_T *pServiceDevice = NULL;
     TRDP_INSTANCE_T *pInstance = NULL;
     TRDP_TELEGRAM_REF_T *pTelegramRef = NULL;
+    XML_ARENA_T *pArena;
 
     if ((pNumServiceDefs == NULL) ||
         (ppServiceDefs == NULL))
@@ -2714,6 +2572,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
     }
 
     trdp_XMLRewind(pDocHnd->pXmlDocument);
+    pArena = &pDocHnd->pXmlDocument->arena;
 
     /*  Default all parameters    */
     *pNumServiceDefs = 0u;
@@ -2735,7 +2594,8 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
 
                 count = (UINT32) trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "service");
 
-                *ppServiceDefs = (TRDP_SERVICE_DEF_T *)vos_memAlloc(count * sizeof(TRDP_SERVICE_DEF_T));
+                *ppServiceDefs = (count > 0u) ?
+                    (TRDP_SERVICE_DEF_T *)trdp_XMLArenaAlloc(pArena, count * sizeof(TRDP_SERVICE_DEF_T)) : NULL;
 
                 if (*ppServiceDefs != NULL)
                 {
@@ -2794,7 +2654,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
                         /* allocate event definitions */
                         if (eventCount > 0u)
                         {
-                            (*ppServiceDefs)[i].pEvent = (TRDP_EVENT_T *)vos_memAlloc(eventCount * sizeof(TRDP_EVENT_T));
+                            (*ppServiceDefs)[i].pEvent = (TRDP_EVENT_T *)trdp_XMLArenaAlloc(pArena, eventCount * sizeof(TRDP_EVENT_T));
 
                             if ((*ppServiceDefs)[i].pEvent == NULL)
                             {
@@ -2808,7 +2668,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
                         /* allocate field definitions */
                         if (fieldCount > 0u)
                         {
-                            (*ppServiceDefs)[i].pField = (TRDP_FIELD_T *)vos_memAlloc(fieldCount * sizeof(TRDP_FIELD_T));
+                            (*ppServiceDefs)[i].pField = (TRDP_FIELD_T *)trdp_XMLArenaAlloc(pArena, fieldCount * sizeof(TRDP_FIELD_T));
 
                             if ((*ppServiceDefs)[i].pField == NULL)
                             {
@@ -2822,7 +2682,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
                         /* allocate method definitions */
                         if (methodCount > 0u)
                         {
-                            (*ppServiceDefs)[i].pMethod = (TRDP_METHOD_T *)vos_memAlloc(methodCount * sizeof(TRDP_METHOD_T));
+                            (*ppServiceDefs)[i].pMethod = (TRDP_METHOD_T *)trdp_XMLArenaAlloc(pArena, methodCount * sizeof(TRDP_METHOD_T));
 
                             if ((*ppServiceDefs)[i].pMethod == NULL)
                             {
@@ -2836,7 +2696,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
                         /* allocate device definitions */
                         if (deviceCount > 0u)
                         {
-                            (*ppServiceDefs)[i].pDevice = (TRDP_SERVICE_DEVICE_T *)vos_memAlloc(deviceCount * sizeof(TRDP_SERVICE_DEVICE_T));
+                            (*ppServiceDefs)[i].pDevice = (TRDP_SERVICE_DEVICE_T *)trdp_XMLArenaAlloc(pArena, deviceCount * sizeof(TRDP_SERVICE_DEVICE_T));
 
                             if ((*ppServiceDefs)[i].pDevice == NULL)
                             {
@@ -2850,7 +2710,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
                         /* allocate telegram reference definitions */
                         if (telegramRefCount > 0u)
                         {
-                            (*ppServiceDefs)[i].pTelegramRef = (TRDP_TELEGRAM_REF_T *)vos_memAlloc(telegramRefCount * sizeof(TRDP_TELEGRAM_REF_T));
+                            (*ppServiceDefs)[i].pTelegramRef = (TRDP_TELEGRAM_REF_T *)trdp_XMLArenaAlloc(pArena, telegramRefCount * sizeof(TRDP_TELEGRAM_REF_T));
 
                             if ((*ppServiceDefs)[i].pTelegramRef == NULL)
                             {
@@ -2967,7 +2827,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlServiceConfig (
 
                                 if (instanceCount > 0)
                                 {
-                                    pServiceDevice->pInstance = (TRDP_INSTANCE_T *)vos_memAlloc(instanceCount * sizeof(TRDP_INSTANCE_T));
+                                    pServiceDevice->pInstance = (TRDP_INSTANCE_T *)trdp_XMLArenaAlloc(pArena, instanceCount * sizeof(TRDP_INSTANCE_T));
 
                                     if (pServiceDevice->pInstance == NULL)
                                     {
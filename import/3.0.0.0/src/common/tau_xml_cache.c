@@ -0,0 +1,1495 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_xml_cache.c
+ *
+ * @brief           Precompiled binary cache of the XML configuration
+ *
+ * @details         The image consists of a header followed by records. Records never hold pointers, references
+ *                  are 32 bit offsets from the start of the image (0 = none) and every record (but strings) starts
+ *                  8 byte aligned, so the image can be used directly from a read-only file mapping.
+ *                  Structures without pointers (e.g. TRDP_PD_PAR_T) are stored as they are; the header holds the
+ *                  byte order and a fingerprint of all stored structure sizes, an image written by a different
+ *                  build or target is treated like a stale one and recompiled.
+ *
+ *                  The image is compiled by running the tau_xml.c readers on the XML file, hence the cached
+ *                  configuration is exactly what those readers return, including their defaults.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "trdp_types.h"
+#include "trdp_utils.h"
+#include "vos_shared_mem.h"
+#include "trdp_xml.h"
+#include "tau_xml_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define XC_MAGIC        0x434D5854u                 /**< 'TXMC' */
+#define XC_BYTE_ORDER   0x01020304u
+#define XC_ALIGN        8u
+#define XC_MIN_CAPACITY 4096u
+
+#define XC_HASH_SEED    0xCBF29CE484222325ull       /**< FNV-1a offset basis and prime, processed word-wise */
+#define XC_HASH_PRIME   0x00000100000001B3ull
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Image header, at offset 0 */
+typedef struct
+{
+    UINT32  magic;
+    UINT16  version;
+    UINT16  headerSize;
+    UINT32  byteOrder;          /**< XC_BYTE_ORDER as written by the compiling host                 */
+    UINT32  layout;             /**< fingerprint of the sizes of all stored structures              */
+    UINT32  totalSize;          /**< size of the image incl. header, multiple of XC_ALIGN           */
+    UINT32  srcSize;            /**< size of the XML source                                         */
+    UINT64  srcHash;            /**< hash of the XML source                                         */
+    UINT64  checksum;           /**< hash of the image following the header                         */
+    UINT32  deviceOfs;          /**< XC_DEVICE_T                                                    */
+    UINT32  numIface;
+    UINT32  ifaceTableOfs;      /**< XC_IFACE_REF_T[numIface], one per configured interface         */
+    UINT32  anyIfaceOfs;        /**< XC_IFACE_T returned for an empty interface name                */
+    UINT32  noIfaceOfs;         /**< XC_IFACE_T returned for an unknown interface name              */
+    UINT32  datasetsOfs;        /**< XC_DATASETS_T                                                  */
+} XC_HEADER_T;
+
+typedef struct
+{
+    UINT32              memSize;
+    UINT32              prealloc[VOS_MEM_NBLOCKSIZES];
+    TRDP_DBG_CONFIG_T   dbgConfig;
+    UINT32              numComPar;
+    UINT32              comParOfs;      /**< TRDP_COM_PAR_T[numComPar]      */
+    UINT32              numIfConfig;
+    UINT32              ifConfigOfs;    /**< TRDP_IF_CONFIG_T[numIfConfig]  */
+} XC_DEVICE_T;
+
+typedef struct
+{
+    TRDP_LABEL_T    ifName;
+    UINT32          ifaceOfs;           /**< XC_IFACE_T                     */
+} XC_IFACE_REF_T;
+
+typedef struct
+{
+    TRDP_COM_PARAM_T    sendParam;
+    UINT32              flags;
+    UINT32              timeout;
+    UINT32              toBehavior;
+    UINT32              port;
+} XC_PD_CONFIG_T;
+
+typedef struct
+{
+    TRDP_COM_PARAM_T    sendParam;
+    UINT32              flags;
+    UINT32              replyTimeout;
+    UINT32              confirmTimeout;
+    UINT32              connectTimeout;
+    UINT32              sendingTimeout;
+    UINT32              udpPort;
+    UINT32              tcpPort;
+    UINT32              maxNumSessions;
+} XC_MD_CONFIG_T;
+
+typedef struct
+{
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    XC_PD_CONFIG_T          pdConfig;
+    XC_MD_CONFIG_T          mdConfig;
+    UINT32                  numExchgPar;
+    UINT32                  exchgParOfs;    /**< XC_EXCHG_T[numExchgPar]    */
+} XC_IFACE_T;
+
+typedef struct
+{
+    UINT32  id;
+    UINT32  sdtParOfs;          /**< TRDP_SDT_PAR_T         */
+    UINT32  sdtv4ParOfs;        /**< TRDP_SDTV4_PAR_T       */
+    UINT32  uriUserOfs;         /**< string                 */
+    UINT32  uriHostOfs;         /**< string                 */
+} XC_DEST_T;
+
+typedef struct
+{
+    UINT32  id;
+    UINT32  sdtParOfs;          /**< TRDP_SDT_PAR_T         */
+    UINT32  sdtv4ParOfs;        /**< TRDP_SDTV4_PAR_T       */
+    UINT32  uriUserOfs;         /**< string                 */
+    UINT32  uriHost1Ofs;        /**< string                 */
+    UINT32  uriHost2Ofs;        /**< string                 */
+} XC_SRC_T;
+
+typedef struct
+{
+    UINT32  comId;
+    UINT32  datasetId;
+    UINT32  comParId;
+    UINT32  mdParOfs;           /**< TRDP_MD_PAR_T          */
+    UINT32  pdParOfs;           /**< TRDP_PD_PAR_T          */
+    UINT32  destCnt;
+    UINT32  destOfs;            /**< XC_DEST_T[destCnt]     */
+    UINT32  srcCnt;
+    UINT32  srcOfs;             /**< XC_SRC_T[srcCnt]       */
+    UINT32  type;
+    UINT32  create;
+    UINT32  serviceId;
+    UINT32  sdtv4SrvInstParCnt;
+    UINT32  sdtv4SrvInstParOfs; /**< TRDP_SDTV4_SRV_INST_PAR_T[sdtv4SrvInstParCnt] */
+} XC_EXCHG_T;
+
+typedef struct
+{
+    UINT32  numComId;
+    UINT32  comIdMapOfs;        /**< TRDP_COMID_DSID_MAP_T[numComId]    */
+    UINT32  numDataset;
+    UINT32  datasetTableOfs;    /**< UINT32[numDataset], XC_DATASET_T   */
+} XC_DATASETS_T;
+
+typedef struct
+{
+    UINT32              id;
+    UINT32              numElement;
+    UINT32              elementOfs; /**< XC_ELEMENT_T[numElement]   */
+    TRDP_EXTRA_LABEL_T  name;
+} XC_DATASET_T;
+
+typedef struct
+{
+    UINT32  type;
+    UINT32  size;
+    UINT32  nameOfs;            /**< string                 */
+    UINT32  unitOfs;            /**< string                 */
+    REAL32  scale;
+    INT32   offset;
+} XC_ELEMENT_T;
+
+/** Growing image buffer used while compiling */
+typedef struct
+{
+    UINT8   *pBuf;
+    UINT32  size;
+    UINT32  capacity;
+    BOOL8   failed;
+} XC_BUILDER_T;
+
+/** Loaded image */
+struct TAU_XML_CACHE
+{
+    const UINT8 *pImage;
+    UINT32      size;
+    BOOL8       isMapped;       /**< pImage is a file mapping, else allocated   */
+    BOOL8       isHit;          /**< loaded from an up-to-date cache file       */
+    XML_ARENA_T arena;          /**< telegram and dataset configuration read    */
+};
+
+/***********************************************************************************************************************
+ *  LOCALS
+ */
+
+/* Interface name no <bus-interface> can have (control characters are not allowed in XML attributes) */
+static const CHAR8 cXcNoIfName[] = "\x01";
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** 64 bit hash (FNV-1a on 8 byte words), used for the source hash and the image checksum
+ */
+static UINT64 xcHash (
+    const UINT8 *pData,
+    UINT32      size)
+{
+    UINT64  hash = XC_HASH_SEED ^ (UINT64) size;
+    UINT64  word;
+
+    /* images and mapped files are 8 byte aligned; memcpy() is no builtin with -fno-builtin, keep it off the loop */
+    if (((uintptr_t) pData % sizeof(UINT64)) == 0u)
+    {
+        const UINT64 *pWord = (const UINT64 *) pData;
+
+        for (; size >= 8u; size -= 8u)
+        {
+            hash    = (hash ^ *pWord++) * XC_HASH_PRIME;
+            hash    ^= hash >> 32;
+        }
+        pData = (const UINT8 *) pWord;
+    }
+    while (size >= 8u)
+    {
+        memcpy(&word, pData, 8u);
+        hash    = (hash ^ word) * XC_HASH_PRIME;
+        hash    ^= hash >> 32;
+        pData   += 8u;
+        size    -= 8u;
+    }
+    while (size > 0u)
+    {
+        hash = (hash ^ *pData++) * XC_HASH_PRIME;
+        size--;
+    }
+    hash ^= hash >> 29;
+    hash *= XC_HASH_PRIME;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/**********************************************************************************************************************/
+/** Fingerprint of the sizes of all structures stored in an image
+ */
+static UINT32 xcLayout (void)
+{
+    const UINT32 sizes[] =
+    {
+        (UINT32) sizeof(XC_HEADER_T), (UINT32) sizeof(XC_DEVICE_T), (UINT32) sizeof(XC_IFACE_REF_T),
+        (UINT32) sizeof(XC_IFACE_T), (UINT32) sizeof(XC_EXCHG_T), (UINT32) sizeof(XC_DEST_T),
+        (UINT32) sizeof(XC_SRC_T), (UINT32) sizeof(XC_DATASETS_T), (UINT32) sizeof(XC_DATASET_T),
+        (UINT32) sizeof(XC_ELEMENT_T), (UINT32) sizeof(TRDP_DBG_CONFIG_T), (UINT32) sizeof(TRDP_COM_PAR_T),
+        (UINT32) sizeof(TRDP_IF_CONFIG_T), (UINT32) sizeof(TRDP_PROCESS_CONFIG_T), (UINT32) sizeof(TRDP_PD_PAR_T),
+        (UINT32) sizeof(TRDP_MD_PAR_T), (UINT32) sizeof(TRDP_SDT_PAR_T), (UINT32) sizeof(TRDP_SDTV4_PAR_T),
+        (UINT32) sizeof(TRDP_SDTV4_SRV_INST_PAR_T), (UINT32) sizeof(TRDP_COMID_DSID_MAP_T),
+        TRDP_MAX_URI_USER_LEN, TRDP_MAX_URI_HOST_LEN
+    };
+    UINT64 hash = xcHash((const UINT8 *) sizes, (UINT32) sizeof(sizes));
+
+    return (UINT32) (hash ^ (hash >> 32));
+}
+
+/**********************************************************************************************************************/
+/** Read a whole file, mapped if the target supports it
+ */
+static TRDP_ERR_T xcLoadFile (
+    const CHAR8 *pFileName,
+    const UINT8 **ppData,
+    UINT32      *pSize,
+    BOOL8       *pIsMapped)
+{
+    FILE    *fp;
+    long    fileSize;
+    UINT8   *pBuf;
+
+    if (vos_fileMap(pFileName, ppData, pSize) == VOS_NO_ERR)
+    {
+        *pIsMapped = TRUE;
+        return TRDP_NO_ERR;
+    }
+
+    /* not mappable on this target: read it */
+    fp = fopen(pFileName, "rb");
+    if (fp == NULL)
+    {
+        return TRDP_IO_ERR;
+    }
+    if ((fseek(fp, 0, SEEK_END) != 0) || ((fileSize = ftell(fp)) <= 0) || (fseek(fp, 0, SEEK_SET) != 0))
+    {
+        (void) fclose(fp);
+        return TRDP_IO_ERR;
+    }
+    pBuf = vos_memAlloc((UINT32) fileSize);
+    if (pBuf == NULL)
+    {
+        (void) fclose(fp);
+        return TRDP_MEM_ERR;
+    }
+    if (fread(pBuf, 1u, (size_t) fileSize, fp) != (size_t) fileSize)
+    {
+        vos_memFree(pBuf);
+        (void) fclose(fp);
+        return TRDP_IO_ERR;
+    }
+    (void) fclose(fp);
+
+    *ppData     = pBuf;
+    *pSize      = (UINT32) fileSize;
+    *pIsMapped  = FALSE;
+    return TRDP_NO_ERR;
+}
+
+static void xcUnloadFile (
+    const UINT8 *pData,
+    UINT32      size,
+    BOOL8       isMapped)
+{
+    if (isMapped == TRUE)
+    {
+        (void) vos_fileUnmap(pData, size);
+    }
+    else
+    {
+        vos_memFree((void *) pData);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check an image against the XML source it shall represent
+ */
+static BOOL8 xcIsValid (
+    const UINT8 *pImage,
+    UINT32      size,
+    UINT64      srcHash,
+    UINT32      srcSize)
+{
+    XC_HEADER_T hdr;
+
+    if ((size < sizeof(XC_HEADER_T)) || ((size % XC_ALIGN) != 0u))
+    {
+        return FALSE;
+    }
+    memcpy(&hdr, pImage, sizeof(XC_HEADER_T));
+
+    return (hdr.magic == XC_MAGIC)
+           && (hdr.version == TAU_XML_CACHE_VERSION)
+           && (hdr.headerSize == sizeof(XC_HEADER_T))
+           && (hdr.byteOrder == XC_BYTE_ORDER)
+           && (hdr.layout == xcLayout())
+           && (hdr.totalSize == size)
+           && (hdr.srcSize == srcSize)
+           && (hdr.srcHash == srcHash)
+           && (hdr.checksum == xcHash(pImage + sizeof(XC_HEADER_T), size - (UINT32) sizeof(XC_HEADER_T)));
+}
+
+/**********************************************************************************************************************/
+/** Access to records of a loaded image, NULL if the offset is none or out of bounds
+ */
+static const void *xcRecord (
+    const struct TAU_XML_CACHE  *pCache,
+    UINT32                      ofs,
+    UINT32                      count,
+    UINT32                      recSize)
+{
+    if ((ofs == 0u) || ((ofs % XC_ALIGN) != 0u) || (ofs >= pCache->size) || (count == 0u)
+        || (count > (pCache->size - ofs) / recSize))
+    {
+        return NULL;
+    }
+    return pCache->pImage + ofs;
+}
+
+static const CHAR8 *xcString (
+    const struct TAU_XML_CACHE  *pCache,
+    UINT32                      ofs)
+{
+    if ((ofs == 0u) || (ofs >= pCache->size)
+        || (memchr(pCache->pImage + ofs, 0, pCache->size - ofs) == NULL))
+    {
+        return NULL;
+    }
+    return (const CHAR8 *) (pCache->pImage + ofs);
+}
+
+/**********************************************************************************************************************/
+/** Append data to the image under construction, returns its offset (0 on error)
+ */
+static UINT32 xcAppendAligned (
+    XC_BUILDER_T    *pB,
+    const void      *pData,
+    UINT32          size,
+    UINT32          align)
+{
+    UINT32  ofs = (pB->size + align - 1u) & ~(align - 1u);
+    UINT32  needed;
+
+    if ((pB->failed == TRUE) || (size > 0xFFFFFFF0u - ofs))
+    {
+        pB->failed = TRUE;
+        return 0u;
+    }
+    needed = (ofs + size + XC_ALIGN - 1u) & ~(XC_ALIGN - 1u);
+
+    if (needed > pB->capacity)
+    {
+        UINT32  capacity = (pB->capacity < XC_MIN_CAPACITY) ? XC_MIN_CAPACITY : pB->capacity;
+        UINT8   *pNew;
+
+        while (capacity < needed)
+        {
+            capacity = (capacity > 0x7FFFFFFFu) ? needed : capacity * 2u;
+        }
+        pNew = vos_memAlloc(capacity);      /* zeroed, padding stays 0 */
+        if (pNew == NULL)
+        {
+            pB->failed = TRUE;
+            return 0u;
+        }
+        if (pB->pBuf != NULL)
+        {
+            memcpy(pNew, pB->pBuf, pB->size);
+            vos_memFree(pB->pBuf);
+        }
+        pB->pBuf        = pNew;
+        pB->capacity    = capacity;
+    }
+    if (pData != NULL)
+    {
+        memcpy(pB->pBuf + ofs, pData, size);
+    }
+    pB->size = ofs + size;
+    return ofs;
+}
+
+static UINT32 xcAppend (
+    XC_BUILDER_T    *pB,
+    const void      *pData,
+    UINT32          size)
+{
+    return xcAppendAligned(pB, pData, size, XC_ALIGN);
+}
+
+static UINT32 xcAppendString (
+    XC_BUILDER_T    *pB,
+    const CHAR8     *pStr)
+{
+    return (pStr == NULL) ? 0u : xcAppendAligned(pB, pStr, (UINT32) strlen(pStr) + 1u, 1u);
+}
+
+static UINT32 xcAppendOpt (
+    XC_BUILDER_T    *pB,
+    const void      *pData,
+    UINT32          size)
+{
+    return (pData == NULL) ? 0u : xcAppend(pB, pData, size);
+}
+
+/**********************************************************************************************************************/
+/** Compile one telegram definition
+ */
+static void xcCompileExchg (
+    XC_BUILDER_T            *pB,
+    const TRDP_EXCHG_PAR_T  *pExchg,
+    XC_EXCHG_T              *pRec)
+{
+    UINT32 i;
+
+    memset(pRec, 0, sizeof(XC_EXCHG_T));
+    pRec->comId                 = pExchg->comId;
+    pRec->datasetId             = pExchg->datasetId;
+    pRec->comParId              = pExchg->comParId;
+    pRec->type                  = (UINT32) pExchg->type;
+    pRec->create                = (UINT32) pExchg->create;
+    pRec->serviceId             = pExchg->serviceId;
+    pRec->mdParOfs              = xcAppendOpt(pB, pExchg->pMdPar, sizeof(TRDP_MD_PAR_T));
+    pRec->pdParOfs              = xcAppendOpt(pB, pExchg->pPdPar, sizeof(TRDP_PD_PAR_T));
+
+    if ((pExchg->sdtv4SrvInstParCnt > 0u) && (pExchg->pSdtv4SrvInstPar != NULL))
+    {
+        pRec->sdtv4SrvInstParCnt    = pExchg->sdtv4SrvInstParCnt;
+        pRec->sdtv4SrvInstParOfs    = xcAppend(pB, pExchg->pSdtv4SrvInstPar,
+                                               pExchg->sdtv4SrvInstParCnt * sizeof(TRDP_SDTV4_SRV_INST_PAR_T));
+    }
+
+    if ((pExchg->destCnt > 0u) && (pExchg->pDest != NULL))
+    {
+        XC_DEST_T *pDest = (XC_DEST_T *) vos_memAlloc(pExchg->destCnt * sizeof(XC_DEST_T));
+        if (pDest == NULL)
+        {
+            pB->failed = TRUE;
+            return;
+        }
+        for (i = 0u; i < pExchg->destCnt; i++)
+        {
+            pDest[i].id             = pExchg->pDest[i].id;
+            pDest[i].sdtParOfs      = xcAppendOpt(pB, pExchg->pDest[i].pSdtPar, sizeof(TRDP_SDT_PAR_T));
+            pDest[i].sdtv4ParOfs    = xcAppendOpt(pB, pExchg->pDest[i].pSdtv4Par, sizeof(TRDP_SDTV4_PAR_T));
+            pDest[i].uriUserOfs     = xcAppendString(pB, (const CHAR8 *) pExchg->pDest[i].pUriUser);
+            pDest[i].uriHostOfs     = xcAppendString(pB, (const CHAR8 *) pExchg->pDest[i].pUriHost);
+        }
+        pRec->destCnt   = pExchg->destCnt;
+        pRec->destOfs   = xcAppend(pB, pDest, pExchg->destCnt * sizeof(XC_DEST_T));
+        vos_memFree(pDest);
+    }
+
+    if ((pExchg->srcCnt > 0u) && (pExchg->pSrc != NULL))
+    {
+        XC_SRC_T *pSrc = (XC_SRC_T *) vos_memAlloc(pExchg->srcCnt * sizeof(XC_SRC_T));
+        if (pSrc == NULL)
+        {
+            pB->failed = TRUE;
+            return;
+        }
+        for (i = 0u; i < pExchg->srcCnt; i++)
+        {
+            pSrc[i].id              = pExchg->pSrc[i].id;
+            pSrc[i].sdtParOfs       = xcAppendOpt(pB, pExchg->pSrc[i].pSdtPar, sizeof(TRDP_SDT_PAR_T));
+            pSrc[i].sdtv4ParOfs     = xcAppendOpt(pB, pExchg->pSrc[i].pSdtv4Par, sizeof(TRDP_SDTV4_PAR_T));
+            pSrc[i].uriUserOfs      = xcAppendString(pB, (const CHAR8 *) pExchg->pSrc[i].pUriUser);
+            pSrc[i].uriHost1Ofs     = xcAppendString(pB, (const CHAR8 *) pExchg->pSrc[i].pUriHost1);
+            pSrc[i].uriHost2Ofs     = xcAppendString(pB, (const CHAR8 *) pExchg->pSrc[i].pUriHost2);
+        }
+        pRec->srcCnt    = pExchg->srcCnt;
+        pRec->srcOfs    = xcAppend(pB, pSrc, pExchg->srcCnt * sizeof(XC_SRC_T));
+        vos_memFree(pSrc);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Compile the configuration tau_readXmlInterfaceConfig() returns for an interface name
+ */
+static UINT32 xcCompileIface (
+    XC_BUILDER_T                *pB,
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    const CHAR8                 *pIfName,
+    TRDP_ERR_T                  *pErr)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    TRDP_PD_CONFIG_T        pdConfig;
+    TRDP_MD_CONFIG_T        mdConfig;
+    UINT32                  numExchgPar = 0u;
+    TRDP_EXCHG_PAR_T        *pExchgPar  = NULL;
+    XC_IFACE_T              iface;
+    UINT32                  i;
+
+    memset(&processConfig, 0, sizeof(processConfig));   /* stored as is, padding included */
+    memset(&pdConfig, 0, sizeof(pdConfig));             /* fields the XML does not set are stored as 0 */
+    memset(&mdConfig, 0, sizeof(mdConfig));
+    *pErr = tau_readXmlInterfaceConfig(pDocHnd, pIfName, &processConfig, &pdConfig, &mdConfig,
+                                       &numExchgPar, &pExchgPar);
+    if (*pErr != TRDP_NO_ERR)
+    {
+        return 0u;
+    }
+
+    memset(&iface, 0, sizeof(iface));
+    iface.processConfig             = processConfig;
+    iface.pdConfig.sendParam        = pdConfig.sendParam;
+    iface.pdConfig.flags            = pdConfig.flags;
+    iface.pdConfig.timeout          = pdConfig.timeout;
+    iface.pdConfig.toBehavior       = (UINT32) pdConfig.toBehavior;
+    iface.pdConfig.port             = pdConfig.port;
+    iface.mdConfig.sendParam        = mdConfig.sendParam;
+    iface.mdConfig.flags            = mdConfig.flags;
+    iface.mdConfig.replyTimeout     = mdConfig.replyTimeout;
+    iface.mdConfig.confirmTimeout   = mdConfig.confirmTimeout;
+    iface.mdConfig.connectTimeout   = mdConfig.connectTimeout;
+    iface.mdConfig.sendingTimeout   = mdConfig.sendingTimeout;
+    iface.mdConfig.udpPort          = mdConfig.udpPort;
+    iface.mdConfig.tcpPort          = mdConfig.tcpPort;
+    iface.mdConfig.maxNumSessions   = mdConfig.maxNumSessions;
+
+    if ((numExchgPar > 0u) && (pExchgPar != NULL))
+    {
+        XC_EXCHG_T *pRecs = (XC_EXCHG_T *) vos_memAlloc(numExchgPar * sizeof(XC_EXCHG_T));
+        if (pRecs == NULL)
+        {
+            pB->failed = TRUE;
+        }
+        else
+        {
+            for (i = 0u; i < numExchgPar; i++)
+            {
+                xcCompileExchg(pB, &pExchgPar[i], &pRecs[i]);
+            }
+            iface.numExchgPar   = numExchgPar;
+            iface.exchgParOfs   = xcAppend(pB, pRecs, numExchgPar * sizeof(XC_EXCHG_T));
+            vos_memFree(pRecs);
+        }
+    }
+    tau_freeTelegrams(numExchgPar, pExchgPar);
+
+    return xcAppend(pB, &iface, sizeof(iface));
+}
+
+/**********************************************************************************************************************/
+/** Compile the datasets and the comId mapping
+ */
+static UINT32 xcCompileDatasets (
+    XC_BUILDER_T                *pB,
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    TRDP_ERR_T                  *pErr)
+{
+    UINT32                  numComId        = 0u;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    UINT32                  numDataset      = 0u;
+    apTRDP_DATASET_T        apDataset       = NULL;
+    XC_DATASETS_T           datasets;
+    UINT32                  i, j;
+
+    *pErr = tau_readXmlDatasetConfig(pDocHnd, &numComId, &pComIdDsIdMap, &numDataset, &apDataset);
+    if (*pErr != TRDP_NO_ERR)
+    {
+        return 0u;
+    }
+
+    memset(&datasets, 0, sizeof(datasets));
+    if ((numComId > 0u) && (pComIdDsIdMap != NULL))
+    {
+        datasets.numComId       = numComId;
+        datasets.comIdMapOfs    = xcAppend(pB, pComIdDsIdMap, numComId * sizeof(TRDP_COMID_DSID_MAP_T));
+    }
+
+    if ((numDataset > 0u) && (apDataset != NULL))
+    {
+        UINT32 *pTable = (UINT32 *) vos_memAlloc(numDataset * sizeof(UINT32));
+        if (pTable == NULL)
+        {
+            pB->failed = TRUE;
+        }
+        else
+        {
+            for (i = 0u; i < numDataset; i++)
+            {
+                const TRDP_DATASET_T    *pDs = apDataset[i];
+                XC_DATASET_T            ds;
+
+                memset(&ds, 0, sizeof(ds));
+                ds.id           = pDs->id;
+                ds.numElement   = pDs->numElement;
+                memcpy(ds.name, pDs->name, sizeof(ds.name));
+
+                if (pDs->numElement > 0u)
+                {
+                    XC_ELEMENT_T *pElem = (XC_ELEMENT_T *) vos_memAlloc(pDs->numElement * sizeof(XC_ELEMENT_T));
+                    if (pElem == NULL)
+                    {
+                        pB->failed = TRUE;
+                        break;
+                    }
+                    for (j = 0u; j < pDs->numElement; j++)
+                    {
+                        pElem[j].type       = pDs->pElement[j].type;
+                        pElem[j].size       = pDs->pElement[j].size;
+                        pElem[j].nameOfs    = xcAppendString(pB, pDs->pElement[j].name);
+                        pElem[j].unitOfs    = xcAppendString(pB, pDs->pElement[j].unit);
+                        pElem[j].scale      = pDs->pElement[j].scale;
+                        pElem[j].offset     = pDs->pElement[j].offset;
+                    }
+                    ds.elementOfs = xcAppend(pB, pElem, pDs->numElement * sizeof(XC_ELEMENT_T));
+                    vos_memFree(pElem);
+                }
+                pTable[i] = xcAppend(pB, &ds, sizeof(ds));
+            }
+            datasets.numDataset         = numDataset;
+            datasets.datasetTableOfs    = xcAppend(pB, pTable, numDataset * sizeof(UINT32));
+            vos_memFree(pTable);
+        }
+    }
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+
+    return xcAppend(pB, &datasets, sizeof(datasets));
+}
+
+/**********************************************************************************************************************/
+/** Compile an XML file into an image
+ */
+static TRDP_ERR_T xcCompile (
+    const CHAR8     *pXmlFileName,
+    UINT64          srcHash,
+    UINT32          srcSize,
+    XC_BUILDER_T    *pB)
+{
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    UINT32                  numComPar   = 0u;
+    TRDP_COM_PAR_T          *pComPar    = NULL;
+    UINT32                  numIfConfig = 0u;
+    TRDP_IF_CONFIG_T        *pIfConfig  = NULL;
+    XC_HEADER_T             hdr;
+    XC_DEVICE_T             device;
+    XC_IFACE_REF_T          *pIfRefs    = NULL;
+    TRDP_ERR_T              err;
+    UINT32                  i;
+
+    memset(&docHnd, 0, sizeof(docHnd));
+    err = tau_prepareXmlDoc(pXmlFileName, &docHnd);
+    if (err != TRDP_NO_ERR)
+    {
+        if (docHnd.pXmlDocument != NULL)    /* not opened, tau_freeXmlDoc() would close it */
+        {
+            vos_memFree(docHnd.pXmlDocument);
+        }
+        return err;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    memset(&dbgConfig, 0, sizeof(dbgConfig));
+    (void) xcAppend(pB, &hdr, sizeof(hdr));     /* placeholder, written last */
+
+    err = tau_readXmlDeviceConfig(&docHnd, &memConfig, &dbgConfig, &numComPar, &pComPar, &numIfConfig, &pIfConfig);
+    if (err == TRDP_NO_ERR)
+    {
+        memset(&device, 0, sizeof(device));
+        device.memSize      = memConfig.size;
+        memcpy(device.prealloc, memConfig.prealloc, sizeof(device.prealloc));
+        device.dbgConfig    = dbgConfig;
+        if ((numComPar > 0u) && (pComPar != NULL))
+        {
+            device.numComPar    = numComPar;
+            device.comParOfs    = xcAppend(pB, pComPar, numComPar * sizeof(TRDP_COM_PAR_T));
+        }
+        if ((numIfConfig > 0u) && (pIfConfig != NULL))
+        {
+            device.numIfConfig  = numIfConfig;
+            device.ifConfigOfs  = xcAppend(pB, pIfConfig, numIfConfig * sizeof(TRDP_IF_CONFIG_T));
+        }
+        hdr.deviceOfs = xcAppend(pB, &device, sizeof(device));
+    }
+
+    /* one record per configured interface, plus the results for "" and for an unknown name */
+    if ((err == TRDP_NO_ERR) && (numIfConfig > 0u) && (pIfConfig != NULL))
+    {
+        pIfRefs = (XC_IFACE_REF_T *) vos_memAlloc(numIfConfig * sizeof(XC_IFACE_REF_T));
+        if (pIfRefs == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        for (i = 0u; (err == TRDP_NO_ERR) && (i < numIfConfig); i++)
+        {
+            memcpy(pIfRefs[i].ifName, pIfConfig[i].ifName, sizeof(TRDP_LABEL_T));
+            pIfRefs[i].ifaceOfs = xcCompileIface(pB, &docHnd, pIfConfig[i].ifName, &err);
+        }
+        if (err == TRDP_NO_ERR)
+        {
+            hdr.numIface        = numIfConfig;
+            hdr.ifaceTableOfs   = xcAppend(pB, pIfRefs, numIfConfig * sizeof(XC_IFACE_REF_T));
+        }
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        hdr.anyIfaceOfs = xcCompileIface(pB, &docHnd, "", &err);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        hdr.noIfaceOfs = xcCompileIface(pB, &docHnd, cXcNoIfName, &err);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        hdr.datasetsOfs = xcCompileDatasets(pB, &docHnd, &err);
+    }
+
+    if (pIfRefs != NULL)
+    {
+        vos_memFree(pIfRefs);
+    }
+    if (pComPar != NULL)
+    {
+        vos_memFree(pComPar);
+    }
+    if (pIfConfig != NULL)
+    {
+        vos_memFree(pIfConfig);
+    }
+    tau_freeXmlDoc(&docHnd);
+
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    (void) xcAppend(pB, NULL, 0u);              /* pad the image to XC_ALIGN */
+    if (pB->failed == TRUE)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    hdr.magic       = XC_MAGIC;
+    hdr.version     = TAU_XML_CACHE_VERSION;
+    hdr.headerSize  = (UINT16) sizeof(XC_HEADER_T);
+    hdr.byteOrder   = XC_BYTE_ORDER;
+    hdr.layout      = xcLayout();
+    hdr.totalSize   = pB->size;
+    hdr.srcSize     = srcSize;
+    hdr.srcHash     = srcHash;
+    hdr.checksum    = xcHash(pB->pBuf + sizeof(XC_HEADER_T), pB->size - (UINT32) sizeof(XC_HEADER_T));
+    memcpy(pB->pBuf, &hdr, sizeof(hdr));
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Store an image, the cache file is replaced atomically
+ */
+static TRDP_ERR_T xcWriteFile (
+    const CHAR8 *pCacheFileName,
+    const UINT8 *pImage,
+    UINT32      size)
+{
+    UINT32      nameLen     = (UINT32) strlen(pCacheFileName) + 5u;
+    CHAR8       *pTmpName   = (CHAR8 *) vos_memAlloc(nameLen);
+    FILE        *fp;
+    TRDP_ERR_T  err = TRDP_IO_ERR;
+
+    if (pTmpName == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    vos_strncpy(pTmpName, pCacheFileName, nameLen);
+    vos_strncat(pTmpName, nameLen, ".tmp");
+
+    fp = fopen(pTmpName, "wb");
+    if (fp != NULL)
+    {
+        BOOL8 written = (fwrite(pImage, 1u, size, fp) == size) ? TRUE : FALSE;
+
+        if ((fclose(fp) == 0) && (written == TRUE))
+        {
+            if (rename(pTmpName, pCacheFileName) != 0)
+            {
+                (void) remove(pCacheFileName);  /* rename does not replace on every target */
+                if (rename(pTmpName, pCacheFileName) == 0)
+                {
+                    err = TRDP_NO_ERR;
+                }
+            }
+            else
+            {
+                err = TRDP_NO_ERR;
+            }
+        }
+        if (err != TRDP_NO_ERR)
+        {
+            (void) remove(pTmpName);
+        }
+    }
+    vos_memFree(pTmpName);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Pick the interface record tau_readXmlInterfaceConfig() would have returned
+ */
+static const XC_IFACE_T *xcFindIface (
+    const struct TAU_XML_CACHE  *pCache,
+    const CHAR8                 *pIfName)
+{
+    const XC_HEADER_T       *pHdr = (const XC_HEADER_T *) pCache->pImage;
+    const XC_IFACE_REF_T    *pRefs;
+    UINT32                  i;
+
+    if (strlen(pIfName) == 0u)
+    {
+        return (const XC_IFACE_T *) xcRecord(pCache, pHdr->anyIfaceOfs, 1u, sizeof(XC_IFACE_T));
+    }
+    pRefs = (const XC_IFACE_REF_T *) xcRecord(pCache, pHdr->ifaceTableOfs, pHdr->numIface, sizeof(XC_IFACE_REF_T));
+    for (i = 0u; (pRefs != NULL) && (i < pHdr->numIface); i++)
+    {
+        if (vos_strnicmp(pIfName, pRefs[i].ifName, TRDP_MAX_LABEL_LEN) == 0)
+        {
+            return (const XC_IFACE_T *) xcRecord(pCache, pRefs[i].ifaceOfs, 1u, sizeof(XC_IFACE_T));
+        }
+    }
+    return (const XC_IFACE_T *) xcRecord(pCache, pHdr->noIfaceOfs, 1u, sizeof(XC_IFACE_T));
+}
+
+/**********************************************************************************************************************/
+/** Allocate a copy of an optional record from the arena (vos_memAlloc if NULL), NULL if none
+ */
+static TRDP_ERR_T xcDupRecord (
+    const struct TAU_XML_CACHE  *pCache,
+    XML_ARENA_T                 *pArena,
+    UINT32                      ofs,
+    UINT32                      count,
+    UINT32                      recSize,
+    void                        **ppCopy)
+{
+    const void *pRec;
+
+    *ppCopy = NULL;
+    if ((ofs == 0u) || (count == 0u))
+    {
+        return TRDP_NO_ERR;
+    }
+    pRec = xcRecord(pCache, ofs, count, recSize);
+    if (pRec == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *ppCopy = (pArena != NULL) ? trdp_XMLArenaAlloc(pArena, count * recSize) : vos_memAlloc(count * recSize);
+    if (*ppCopy == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    memcpy(*ppCopy, pRec, count * recSize);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Allocate a copy of an optional string from the arena, NULL if none. allocSize 0 allocates the string length.
+ */
+static TRDP_ERR_T xcDupString (
+    struct TAU_XML_CACHE        *pCache,
+    UINT32                      ofs,
+    UINT32                      allocSize,
+    CHAR8                       **ppCopy)
+{
+    const CHAR8 *pStr;
+    UINT32      len;
+
+    *ppCopy = NULL;
+    if (ofs == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+    pStr = xcString(pCache, ofs);
+    if (pStr == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    len = (UINT32) strlen(pStr) + 1u;
+    if (allocSize < len)
+    {
+        allocSize = len;
+    }
+    *ppCopy = (CHAR8 *) trdp_XMLArenaAlloc(&pCache->arena, allocSize);
+    if (*ppCopy == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    memcpy(*ppCopy, pStr, len);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Rebuild one telegram definition from the arena, the way readTelegramDef() does
+ */
+static TRDP_ERR_T xcLoadExchg (
+    struct TAU_XML_CACHE        *pCache,
+    const XC_EXCHG_T            *pRec,
+    TRDP_EXCHG_PAR_T            *pExchg)
+{
+    TRDP_ERR_T  err;
+    UINT32      i;
+
+    pExchg->comId       = pRec->comId;
+    pExchg->datasetId   = pRec->datasetId;
+    pExchg->comParId    = pRec->comParId;
+    pExchg->type        = (TRDP_EXCHG_OPTION_T) pRec->type;
+    pExchg->create      = (BOOL8) pRec->create;
+    pExchg->serviceId   = pRec->serviceId;
+
+    err = xcDupRecord(pCache, &pCache->arena, pRec->mdParOfs, 1u, sizeof(TRDP_MD_PAR_T), (void **) &pExchg->pMdPar);
+    if (err == TRDP_NO_ERR)
+    {
+        err = xcDupRecord(pCache, &pCache->arena, pRec->pdParOfs, 1u, sizeof(TRDP_PD_PAR_T),
+                          (void **) &pExchg->pPdPar);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        err = xcDupRecord(pCache, &pCache->arena, pRec->sdtv4SrvInstParOfs, pRec->sdtv4SrvInstParCnt,
+                          sizeof(TRDP_SDTV4_SRV_INST_PAR_T), (void **) &pExchg->pSdtv4SrvInstPar);
+        if (pExchg->pSdtv4SrvInstPar != NULL)
+        {
+            pExchg->sdtv4SrvInstParCnt = pRec->sdtv4SrvInstParCnt;
+        }
+    }
+
+    if ((err == TRDP_NO_ERR) && (pRec->destCnt > 0u))
+    {
+        const XC_DEST_T *pDest = (const XC_DEST_T *) xcRecord(pCache, pRec->destOfs, pRec->destCnt, sizeof(XC_DEST_T));
+        if (pDest == NULL)
+        {
+            return TRDP_PARAM_ERR;
+        }
+        pExchg->pDest = (TRDP_DEST_T *) trdp_XMLArenaAlloc(&pCache->arena, pRec->destCnt * sizeof(TRDP_DEST_T));
+        if (pExchg->pDest == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        pExchg->destCnt = pRec->destCnt;
+        for (i = 0u; (err == TRDP_NO_ERR) && (i < pRec->destCnt); i++)
+        {
+            pExchg->pDest[i].id = pDest[i].id;
+            err = xcDupRecord(pCache, &pCache->arena, pDest[i].sdtParOfs, 1u, sizeof(TRDP_SDT_PAR_T),
+                              (void **) &pExchg->pDest[i].pSdtPar);
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupRecord(pCache, &pCache->arena, pDest[i].sdtv4ParOfs, 1u, sizeof(TRDP_SDTV4_PAR_T),
+                                  (void **) &pExchg->pDest[i].pSdtv4Par);
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupString(pCache, pDest[i].uriUserOfs, TRDP_MAX_URI_USER_LEN + 1u,
+                                  (CHAR8 **) &pExchg->pDest[i].pUriUser);
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupString(pCache, pDest[i].uriHostOfs, 0u, (CHAR8 **) &pExchg->pDest[i].pUriHost);
+            }
+        }
+    }
+
+    if ((err == TRDP_NO_ERR) && (pRec->srcCnt > 0u))
+    {
+        const XC_SRC_T *pSrc = (const XC_SRC_T *) xcRecord(pCache, pRec->srcOfs, pRec->srcCnt, sizeof(XC_SRC_T));
+        if (pSrc == NULL)
+        {
+            return TRDP_PARAM_ERR;
+        }
+        pExchg->pSrc = (TRDP_SRC_T *) trdp_XMLArenaAlloc(&pCache->arena, pRec->srcCnt * sizeof(TRDP_SRC_T));
+        if (pExchg->pSrc == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        pExchg->srcCnt = pRec->srcCnt;
+        for (i = 0u; (err == TRDP_NO_ERR) && (i < pRec->srcCnt); i++)
+        {
+            pExchg->pSrc[i].id = pSrc[i].id;
+            err = xcDupRecord(pCache, &pCache->arena, pSrc[i].sdtParOfs, 1u, sizeof(TRDP_SDT_PAR_T),
+                              (void **) &pExchg->pSrc[i].pSdtPar);
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupRecord(pCache, &pCache->arena, pSrc[i].sdtv4ParOfs, 1u, sizeof(TRDP_SDTV4_PAR_T),
+                                  (void **) &pExchg->pSrc[i].pSdtv4Par);
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupString(pCache, pSrc[i].uriUserOfs, TRDP_MAX_URI_USER_LEN + 1u,
+                                  (CHAR8 **) &pExchg->pSrc[i].pUriUser);
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupString(pCache, pSrc[i].uriHost1Ofs, 0u, (CHAR8 **) &pExchg->pSrc[i].pUriHost1);
+            }
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupString(pCache, pSrc[i].uriHost2Ofs, 0u, (CHAR8 **) &pExchg->pSrc[i].pUriHost2);
+            }
+        }
+    }
+    return err;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Open the configuration cache of an XML file.
+ *
+ *  @param[in]      pXmlFileName        Path of the XML configuration file
+ *  @param[in]      pCacheFileName      Path of the cache file
+ *  @param[out]     pCache              Pointer to the returned cache handle
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error, XML file not readable
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_IO_ERR         XML parsing failed
+ */
+EXT_DECL TRDP_ERR_T tau_openXmlCache (
+    const CHAR8         *pXmlFileName,
+    const CHAR8         *pCacheFileName,
+    TAU_XML_CACHE_T     *pCache)
+{
+    const UINT8             *pSrc       = NULL;
+    UINT32                  srcSize     = 0u;
+    BOOL8                   srcMapped   = FALSE;
+    UINT64                  srcHash;
+    const UINT8             *pImage     = NULL;
+    UINT32                  imageSize   = 0u;
+    BOOL8                   imageMapped = FALSE;
+    struct TAU_XML_CACHE    *pNew;
+    XC_BUILDER_T            builder;
+    TRDP_ERR_T              err;
+
+    if ((pXmlFileName == NULL) || (pCacheFileName == NULL) || (pCache == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pCache = NULL;
+
+    err = xcLoadFile(pXmlFileName, &pSrc, &srcSize, &srcMapped);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_openXmlCache: cannot read %s\n", pXmlFileName);
+        return (err == TRDP_IO_ERR) ? TRDP_PARAM_ERR : err;
+    }
+    srcHash = xcHash(pSrc, srcSize);
+    xcUnloadFile(pSrc, srcSize, srcMapped);
+
+    pNew = (struct TAU_XML_CACHE *) vos_memAlloc(sizeof(struct TAU_XML_CACHE));
+    if (pNew == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    /* Up-to-date cache file? */
+    if (xcLoadFile(pCacheFileName, &pImage, &imageSize, &imageMapped) == TRDP_NO_ERR)
+    {
+        if (xcIsValid(pImage, imageSize, srcHash, srcSize) == TRUE)
+        {
+            pNew->pImage    = pImage;
+            pNew->size      = imageSize;
+            pNew->isMapped  = imageMapped;
+            pNew->isHit     = TRUE;
+            *pCache         = pNew;
+            return TRDP_NO_ERR;
+        }
+        xcUnloadFile(pImage, imageSize, imageMapped);
+        vos_printLog(VOS_LOG_INFO, "tau_openXmlCache: %s is stale, recompiling\n", pCacheFileName);
+    }
+
+    /* No: compile the XML file */
+    memset(&builder, 0, sizeof(builder));
+    err = xcCompile(pXmlFileName, srcHash, srcSize, &builder);
+    if (err != TRDP_NO_ERR)
+    {
+        if (builder.pBuf != NULL)
+        {
+            vos_memFree(builder.pBuf);
+        }
+        vos_memFree(pNew);
+        return err;
+    }
+
+    if (xcWriteFile(pCacheFileName, builder.pBuf, builder.size) != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_WARNING, "tau_openXmlCache: cannot write %s, using the configuration from memory\n",
+                     pCacheFileName);
+    }
+
+    pNew->pImage    = builder.pBuf;
+    pNew->size      = builder.size;
+    pNew->isMapped  = FALSE;
+    pNew->isHit     = FALSE;
+    *pCache         = pNew;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Release a configuration cache opened by tau_openXmlCache().
+ *
+ *  @param[in]      cache               Cache handle
+ */
+EXT_DECL void tau_closeXmlCache (
+    TAU_XML_CACHE_T cache)
+{
+    if (cache != NULL)
+    {
+        xcUnloadFile(cache->pImage, cache->size, cache->isMapped);
+        trdp_XMLArenaRelease(&cache->arena);
+        vos_memFree(cache);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Tell if the configuration was loaded from an up-to-date cache file.
+ *
+ *  @param[in]      cache               Cache handle
+ *
+ *  @retval         TRUE                loaded from the cache file
+ *  @retval         FALSE               compiled from the XML file
+ */
+EXT_DECL BOOL8 tau_isXmlCacheHit (
+    TAU_XML_CACHE_T cache)
+{
+    return (cache != NULL) ? cache->isHit : FALSE;
+}
+
+/**********************************************************************************************************************/
+/**    Read the TRDP device configuration parameters from the cache.
+ *
+ *  @param[in]      cache             Cache handle
+ *  @param[out]     pMemConfig        Memory configuration
+ *  @param[out]     pDbgConfig        Debug printout configuration for application use
+ *  @param[out]     pNumComPar        Number of configured com parameters
+ *  @param[out]     ppComPar          Pointer to array of com parameters
+ *  @param[out]     pNumIfConfig      Number of configured interfaces
+ *  @param[out]     ppIfConfig        Pointer to an array of interface parameter sets
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_readCachedDeviceConfig (
+    TAU_XML_CACHE_T             cache,
+    TRDP_MEM_CONFIG_T           *pMemConfig,
+    TRDP_DBG_CONFIG_T           *pDbgConfig,
+    UINT32                      *pNumComPar,
+    TRDP_COM_PAR_T              * *ppComPar,
+    UINT32                      *pNumIfConfig,
+    TRDP_IF_CONFIG_T            * *ppIfConfig)
+{
+    const XC_DEVICE_T   *pDevice;
+    TRDP_ERR_T          err;
+
+    if ((cache == NULL) || (pMemConfig == NULL) || (pDbgConfig == NULL) || (pNumComPar == NULL)
+        || (ppComPar == NULL) || (pNumIfConfig == NULL) || (ppIfConfig == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pNumComPar     = 0u;
+    *ppComPar       = NULL;
+    *pNumIfConfig   = 0u;
+    *ppIfConfig     = NULL;
+
+    pDevice = (const XC_DEVICE_T *) xcRecord(cache, ((const XC_HEADER_T *) cache->pImage)->deviceOfs, 1u,
+                                             sizeof(XC_DEVICE_T));
+    if (pDevice == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    pMemConfig->p       = NULL;
+    pMemConfig->size    = pDevice->memSize;
+    memcpy(pMemConfig->prealloc, pDevice->prealloc, sizeof(pMemConfig->prealloc));
+    *pDbgConfig         = pDevice->dbgConfig;
+
+    err = xcDupRecord(cache, NULL, pDevice->comParOfs, pDevice->numComPar, sizeof(TRDP_COM_PAR_T), (void **) ppComPar);
+    if (err == TRDP_NO_ERR)
+    {
+        err = xcDupRecord(cache, NULL, pDevice->ifConfigOfs, pDevice->numIfConfig, sizeof(TRDP_IF_CONFIG_T),
+                          (void **) ppIfConfig);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        if (*ppComPar != NULL)
+        {
+            vos_memFree(*ppComPar);
+            *ppComPar = NULL;
+        }
+        return err;
+    }
+    *pNumComPar     = (*ppComPar != NULL) ? pDevice->numComPar : 0u;
+    *pNumIfConfig   = (*ppIfConfig != NULL) ? pDevice->numIfConfig : 0u;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Read the configuration of one interface from the cache.
+ *
+ *  @param[in]      cache             Cache handle
+ *  @param[in]      pIfName           Interface name
+ *  @param[out]     pProcessConfig    TRDP main process configuration
+ *  @param[out]     pPdConfig         PD default configuration
+ *  @param[out]     pMdConfig         MD default configuration
+ *  @param[out]     pNumExchgPar      Number of configured telegrams
+ *  @param[out]     ppExchgPar        Pointer to array of telegram configurations
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_readCachedInterfaceConfig (
+    TAU_XML_CACHE_T             cache,
+    const CHAR8                 *pIfName,
+    TRDP_PROCESS_CONFIG_T       *pProcessConfig,
+    TRDP_PD_CONFIG_T            *pPdConfig,
+    TRDP_MD_CONFIG_T            *pMdConfig,
+    UINT32                      *pNumExchgPar,
+    TRDP_EXCHG_PAR_T            * *ppExchgPar)
+{
+    const XC_IFACE_T    *pIface;
+    const XC_EXCHG_T    *pRecs;
+    TRDP_EXCHG_PAR_T    *pExchgPar;
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+    UINT32              i;
+
+    if ((cache == NULL) || (pIfName == NULL) || (pNumExchgPar == NULL) || (ppExchgPar == NULL)
+        || (pPdConfig == NULL) || (pMdConfig == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pNumExchgPar   = 0u;
+    *ppExchgPar     = NULL;
+
+    pIface = xcFindIface(cache, pIfName);
+    if (pIface == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (pProcessConfig != NULL)
+    {
+        *pProcessConfig = pIface->processConfig;
+    }
+    pPdConfig->pfCbFunction     = NULL;
+    pPdConfig->pRefCon          = NULL;
+    pPdConfig->sendParam        = pIface->pdConfig.sendParam;
+    pPdConfig->flags            = (TRDP_FLAGS_T) pIface->pdConfig.flags;
+    pPdConfig->timeout          = pIface->pdConfig.timeout;
+    pPdConfig->toBehavior       = (TRDP_TO_BEHAVIOR_T) pIface->pdConfig.toBehavior;
+    pPdConfig->port             = (UINT16) pIface->pdConfig.port;
+
+    pMdConfig->pfCbFunction     = NULL;
+    pMdConfig->pRefCon          = NULL;
+    pMdConfig->sendParam        = pIface->mdConfig.sendParam;
+    pMdConfig->flags            = (TRDP_FLAGS_T) pIface->mdConfig.flags;
+    pMdConfig->replyTimeout     = pIface->mdConfig.replyTimeout;
+    pMdConfig->confirmTimeout   = pIface->mdConfig.confirmTimeout;
+    pMdConfig->connectTimeout   = pIface->mdConfig.connectTimeout;
+    pMdConfig->sendingTimeout   = pIface->mdConfig.sendingTimeout;
+    pMdConfig->udpPort          = (UINT16) pIface->mdConfig.udpPort;
+    pMdConfig->tcpPort          = (UINT16) pIface->mdConfig.tcpPort;
+    pMdConfig->maxNumSessions   = pIface->mdConfig.maxNumSessions;
+
+    if (pIface->numExchgPar == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+    pRecs = (const XC_EXCHG_T *) xcRecord(cache, pIface->exchgParOfs, pIface->numExchgPar, sizeof(XC_EXCHG_T));
+    if (pRecs == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pExchgPar = (TRDP_EXCHG_PAR_T *) trdp_XMLArenaAlloc(&cache->arena,
+                                                           pIface->numExchgPar * sizeof(TRDP_EXCHG_PAR_T));
+    if (pExchgPar == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    for (i = 0u; (err == TRDP_NO_ERR) && (i < pIface->numExchgPar); i++)
+    {
+        err = xcLoadExchg(cache, &pRecs[i], &pExchgPar[i]);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        return err;                         /* the partial copy goes with the cache */
+    }
+
+    *pNumExchgPar   = pIface->numExchgPar;
+    *ppExchgPar     = pExchgPar;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Read the dataset and comId mapping configuration from the cache.
+ *
+ *  @param[in]      cache             Cache handle
+ *  @param[out]     pNumComId         Number of entries in the ComId DatasetId mapping list
+ *  @param[out]     ppComIdDsIdMap    Pointer to an array of structures of type TRDP_COMID_DSID_MAP_T
+ *  @param[out]     pNumDataset       Number of datasets found in the configuration
+ *  @param[out]     papDataset        Pointer to an array of pointers to a structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ */
+EXT_DECL TRDP_ERR_T tau_readCachedDatasetConfig (
+    TAU_XML_CACHE_T             cache,
+    UINT32                      *pNumComId,
+    TRDP_COMID_DSID_MAP_T       * *ppComIdDsIdMap,
+    UINT32                      *pNumDataset,
+    papTRDP_DATASET_T           papDataset)
+{
+    const XC_DATASETS_T *pDatasets;
+    const UINT32        *pTable;
+    apTRDP_DATASET_T    apDataset;
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+    UINT32              i, j;
+
+    if ((cache == NULL) || (pNumComId == NULL) || (ppComIdDsIdMap == NULL) || (pNumDataset == NULL)
+        || (papDataset == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pNumComId      = 0u;
+    *ppComIdDsIdMap = NULL;
+    *pNumDataset    = 0u;
+    *papDataset     = NULL;
+
+    pDatasets = (const XC_DATASETS_T *) xcRecord(cache, ((const XC_HEADER_T *) cache->pImage)->datasetsOfs, 1u,
+                                                 sizeof(XC_DATASETS_T));
+    if (pDatasets == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    err = xcDupRecord(cache, &cache->arena, pDatasets->comIdMapOfs, pDatasets->numComId, sizeof(TRDP_COMID_DSID_MAP_T),
+                      (void **) ppComIdDsIdMap);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    *pNumComId = (*ppComIdDsIdMap != NULL) ? pDatasets->numComId : 0u;
+
+    if (pDatasets->numDataset == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+    pTable = (const UINT32 *) xcRecord(cache, pDatasets->datasetTableOfs, pDatasets->numDataset, sizeof(UINT32));
+    apDataset = (pTable == NULL) ? NULL :
+                (apTRDP_DATASET_T) trdp_XMLArenaAlloc(&cache->arena, pDatasets->numDataset * sizeof(pTRDP_DATASET_T));
+    if (apDataset == NULL)
+    {
+        *pNumComId      = 0u;
+        *ppComIdDsIdMap = NULL;
+        return (pTable == NULL) ? TRDP_PARAM_ERR : TRDP_MEM_ERR;
+    }
+
+    for (i = 0u; (err == TRDP_NO_ERR) && (i < pDatasets->numDataset); i++)
+    {
+        const XC_DATASET_T  *pDs    = (const XC_DATASET_T *) xcRecord(cache, pTable[i], 1u, sizeof(XC_DATASET_T));
+        const XC_ELEMENT_T  *pElem  = NULL;
+
+        if ((pDs == NULL) || (pDs->numElement > 0xFFFFu))
+        {
+            err = TRDP_PARAM_ERR;
+            break;
+        }
+        if (pDs->numElement > 0u)
+        {
+            pElem = (const XC_ELEMENT_T *) xcRecord(cache, pDs->elementOfs, pDs->numElement, sizeof(XC_ELEMENT_T));
+            if (pElem == NULL)
+            {
+                err = TRDP_PARAM_ERR;
+                break;
+            }
+        }
+        apDataset[i] = (TRDP_DATASET_T *) trdp_XMLArenaAlloc(&cache->arena,
+                                                             pDs->numElement * sizeof(TRDP_DATASET_ELEMENT_T)
+                                                             + sizeof(TRDP_DATASET_T));
+        if (apDataset[i] == NULL)
+        {
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        apDataset[i]->id            = pDs->id;
+        apDataset[i]->numElement    = (UINT16) pDs->numElement;
+        memcpy(apDataset[i]->name, pDs->name, sizeof(apDataset[i]->name));
+
+        for (j = 0u; (err == TRDP_NO_ERR) && (j < pDs->numElement); j++)
+        {
+            apDataset[i]->pElement[j].type      = pElem[j].type;
+            apDataset[i]->pElement[j].size      = pElem[j].size;
+            apDataset[i]->pElement[j].scale     = pElem[j].scale;
+            apDataset[i]->pElement[j].offset    = pElem[j].offset;
+            err = xcDupString(cache, pElem[j].nameOfs, 0u, &apDataset[i]->pElement[j].name);
+            if (err == TRDP_NO_ERR)
+            {
+                err = xcDupString(cache, pElem[j].unitOfs, 0u, &apDataset[i]->pElement[j].unit);
+            }
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        *pNumComId      = 0u;
+        *ppComIdDsIdMap = NULL;
+        return err;
+    }
+
+    *pNumDataset    = pDatasets->numDataset;
+    *papDataset     = apDataset;
+    return TRDP_NO_ERR;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -400,6 +400,16 @@ EXT_DECL TRDP_ERR_T tlc_init (
 #else
             vos_printLogStr(VOS_LOG_INFO, "SOA_SUPPORT: disabled\n");
 #endif
+#if defined(IO_URING_SUPPORT)
+            vos_printLogStr(VOS_LOG_INFO, "IO_URING:    enabled\n");
+#else
+            vos_printLogStr(VOS_LOG_INFO, "IO_URING:    disabled\n");
+#endif
+#if defined(PACKET_MMAP_SUPPORT)
+            vos_printLogStr(VOS_LOG_INFO, "PACKET_MMAP: enabled\n");
+#else
+            vos_printLogStr(VOS_LOG_INFO, "PACKET_MMAP: disabled\n");
+#endif
 #if defined(RT_THREADS)
             vos_printLogStr(VOS_LOG_INFO, "RT_THREADS:  enabled\n");
 #else
@@ -570,7 +580,7 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->stats.leaderIpAddr    = leaderIpAddr;
 
     /* Check the vlan interface #435 */
-    if (0 != pProcessConfig->vlanId)
+    if ((pProcessConfig != NULL) && (0 != pProcessConfig->vlanId))
     {
 #ifndef SIM
         /* This socket should bind to the (virtual) interface with the VLAN ID supplied by 'pOptions'.
@@ -789,6 +799,31 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
         pSession->stats.pd.defTimeout   = pSession->pdDefault.timeout;
     }
 
+    /*  The PD sockets drop what they receive, if the packet ring takes over (before the first one is opened).
+        Once created, the ring stays, also if a later call clears the option: the sockets opened so far can only
+        be read through it, and new ones must drop their datagrams as well  */
+#ifdef PACKET_MMAP_SUPPORT
+    if (pSession->pktRing != NULL)
+    {
+        pSession->option |= TRDP_OPTION_PACKET_RING;
+    }
+#endif
+    if (pSession->option & TRDP_OPTION_PACKET_RING)
+    {
+#ifdef PACKET_MMAP_SUPPORT
+        if ((pSession->pktRing == NULL) &&
+            (vos_pktRingCreate(pSession->realIP, pSession->pdDefault.port, &pSession->pktRing) != VOS_NO_ERR))
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "Packet ring not available, PD is read from the sockets\n");
+            pSession->pktRing   = NULL;
+            pSession->option    &= (TRDP_OPTION_T) ~TRDP_OPTION_PACKET_RING;
+        }
+#else
+        vos_printLogStr(VOS_LOG_WARNING, "TRDP_OPTION_PACKET_RING needs PACKET_MMAP_SUPPORT\n");
+        pSession->option &= (TRDP_OPTION_T) ~TRDP_OPTION_PACKET_RING;
+#endif
+    }
+
 #if MD_SUPPORT
 
     if (pMdDefault != NULL)
@@ -1079,6 +1114,14 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
             {
 #ifdef HIGH_PERF_INDEXED
                 trdp_indexDeInit(pSession);
+#endif
+#ifdef IO_URING_SUPPORT
+                vos_ringDestroy(pSession->ring);
+                pSession->ring = NULL;
+#endif
+#ifdef PACKET_MMAP_SUPPORT
+                vos_pktRingDestroy(pSession->pktRing);
+                pSession->pktRing = NULL;
 #endif
                 /*    Release all allocated sockets and memory    */
                 vos_memFree(pSession->pNewFrame);
@@ -1090,16 +1133,10 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     /*  UnPublish our packets ???
                     trdp_releaseSocket(appHandle->ifacePD, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
                      */
-                    if (pSession->pSndQueue->pSeqCntList != NULL)
-                    {
-                        vos_memFree(pSession->pSndQueue->pSeqCntList);
-                    }
-                    vos_memFree(pSession->pSndQueue->pFrame);
-
                     /*    Only close socket if not used anymore    */
                     trdp_releaseSocket(pSession->ifacePD, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
 
-                    vos_memFree(pSession->pSndQueue);
+                    trdp_pdFreeElement(pSession->pSndQueue);
                     pSession->pSndQueue = pNext;
                 }
 
@@ -1110,15 +1147,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     /*  UnPublish our statistics packet   */
                     /*    Only close socket if not used anymore    */
                     trdp_releaseSocket(pSession->ifacePD, pSession->pRcvQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
-                    if (pSession->pRcvQueue->pSeqCntList != NULL)
-                    {
-                        vos_memFree(pSession->pRcvQueue->pSeqCntList);
-                    }
-                    if (pSession->pRcvQueue->pFrame != NULL)
-                    {
-                        vos_memFree(pSession->pRcvQueue->pFrame);
-                    }
-                    vos_memFree(pSession->pRcvQueue);
+                    trdp_pdFreeElement(pSession->pRcvQueue);
                     pSession->pRcvQueue = pNext;
                 }
 
@@ -1600,6 +1629,199 @@ EXT_DECL TRDP_ERR_T tlc_process (
 #endif
 }
 
+#ifdef IO_URING_SUPPORT
+/**********************************************************************************************************************/
+/** Completion driven work loop of the TRDP handler (Linux io_uring).
+ *    Replaces tlc_getInterval(), vos_select() and tlc_process(): waits until the next PD is due or a packet arrives
+ *    (at most pMaxWait), then sends the due PDs, handles the received PDs, time outs and MD.
+ *
+ *    The subscribed PD sockets get a multishot receive on a ring of the session, created by the first call; due PDs
+ *    are queued on the ring and sent by one system call. MD sockets are polled on the same ring and handled as with
+ *    tlc_process(). Requested PDs and PDs with launch times (TRDP_OPTION_TXTIME) are sent directly.
+ *
+ *  Note:
+ *      Call from one thread only, do not mix with tlc_process() or the tlp_process*() and tlm_process() calls.
+ *
+ *  @param[in]      appHandle          The handle returned by tlc_openSession
+ *  @param[in]      pMaxWait           maximum time to wait
+ *
+ *  @retval         TRDP_NO_ERR        no error
+ *  @retval         TRDP_NOINIT_ERR    handle invalid
+ *  @retval         TRDP_PARAM_ERR     pMaxWait is NULL
+ *  @retval         TRDP_INIT_ERR      ring not available (kernel older than 6.0, TRDP_OPTION_PACKET_RING), use
+ *                                     tlc_process()
+ */
+EXT_DECL TRDP_ERR_T tlc_processRing (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_TIME_T   *pMaxWait)
+{
+#ifdef HIGH_PERF_INDEXED
+    vos_printLogStr(VOS_LOG_ERROR, "####   tlc_processRing() is not supported when using HIGH_PERF_INDEXED!  ####\n");
+    return TRDP_NOINIT_ERR;
+#else
+    TRDP_ERR_T  result      = TRDP_NO_ERR;
+    TRDP_ERR_T  err;
+    TRDP_FDS_T  recvFds;
+    TRDP_FDS_T  pollFds;
+    TRDP_SOCK_T noDesc      = VOS_INVALID_SOCKET;
+    TRDP_TIME_T interval;
+    TRDP_TIME_T now;
+    INT32       count;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pMaxWait == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+#ifdef PACKET_MMAP_SUPPORT
+    if (appHandle->pktRing != NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "tlc_processRing() does not support TRDP_OPTION_PACKET_RING\n");
+        return TRDP_INIT_ERR;
+    }
+#endif
+
+    /******************************************************
+     Arm the sockets and get the time to wait
+     ******************************************************/
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((appHandle->ring == NULL) &&
+        (vos_ringCreate(TRDP_MAX_PD_PACKET_SIZE, &appHandle->ring) != VOS_NO_ERR))
+    {
+        appHandle->ring = NULL;
+        (void) vos_mutexUnlock(appHandle->mutex);
+        return TRDP_INIT_ERR;
+    }
+
+    vos_getTime(&now);
+    FD_ZERO((VOS_FDS_T *) &recvFds);
+    FD_ZERO((VOS_FDS_T *) &pollFds);
+    trdp_pdCheckPending(appHandle, &recvFds, &noDesc, TRUE);
+#if MD_SUPPORT
+    trdp_mdCheckPending(appHandle, &pollFds, &noDesc);
+#endif
+    if (vos_ringWatch(appHandle->ring, (VOS_FDS_T *) &recvFds, (VOS_FDS_T *) &pollFds, noDesc) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "vos_ringWatch() failed, not all sockets are watched\n");
+    }
+
+    /*    Wait until the next job is due, at most pMaxWait   */
+    interval = *pMaxWait;
+    if (timerisset(&appHandle->nextJob))
+    {
+        if (timercmp(&now, &appHandle->nextJob, <))
+        {
+            vos_subTime(&appHandle->nextJob, &now);
+            if (timercmp(&appHandle->nextJob, &interval, <))
+            {
+                interval = appHandle->nextJob;
+            }
+        }
+        else
+        {
+            vos_clearTime(&interval);
+        }
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    if (vos_ringWait(appHandle->ring, (VOS_TIMEVAL_T *) &interval) == VOS_IO_ERR)
+    {
+        result = TRDP_IO_ERR;
+    }
+
+    /******************************************************
+     Send, receive, time outs
+     ******************************************************/
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    vos_clearTime(&appHandle->nextJob);
+
+    if (vos_mutexTryLock(appHandle->mutexTxPD) == VOS_NO_ERR)
+    {
+        err = trdp_pdSendQueued(appHandle);
+        if (err != TRDP_NO_ERR)
+        {
+            /*  We do not break here, only report error */
+            result = err;
+        }
+        /*  The queued frames are read now, before they can change  */
+        vos_getTime(&now);
+        if (vos_ringSubmit(appHandle->ring) != VOS_NO_ERR)
+        {
+            result = TRDP_IO_ERR;       /* the queued frames are counted with the next successful submit */
+        }
+        else
+        {
+            trdp_pdRingSent(appHandle, &now);
+        }
+        if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    if (vos_mutexLock(appHandle->mutexRxPD) == VOS_NO_ERR)
+    {
+        trdp_pdHandleTimeOuts(appHandle);
+
+        err = trdp_pdReceiveRing(appHandle);
+        if (err != TRDP_NO_ERR)
+        {
+            result = err;
+        }
+        if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+
+    /*  MD sockets found ready while reading the completions    */
+    count = vos_ringGetReady(appHandle->ring, (VOS_FDS_T *) &pollFds);
+#if MD_SUPPORT
+    if (vos_mutexLock(appHandle->mutexMD) == VOS_NO_ERR)
+    {
+        err = trdp_mdSend(appHandle);
+        if ((err != TRDP_NO_ERR) && (err != TRDP_IO_ERR))
+        {
+            result = err;
+            vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+        }
+
+        trdp_mdCheckListenSocks(appHandle, &pollFds, &count);
+
+        trdp_mdCheckTimeouts(appHandle);
+
+        if (vos_mutexUnlock(appHandle->mutexMD) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+#else
+    (void) count;
+#endif
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return result;
+#endif
+}
+#endif
+
 /**********************************************************************************************************************/
 /** Return a human readable version representation.
  *    Return string in the form 'v.r.u.b'
@@ -629,16 +629,11 @@ EXT_DECL TRDP_ERR_T tlm_delListener (
             /* cleanup instance */
             if (pDelete->socketIdx != -1)
             {
-                TRDP_IP_ADDR_T mcGroup = VOS_INADDR_ANY;
-                if (pDelete->addr.mcGroup != VOS_INADDR_ANY)
-                {
-                    mcGroup = trdp_findMCjoins(appHandle, pDelete->addr.mcGroup);
-                }
                 trdp_releaseSocket(appHandle->ifaceMD,
                                    pDelete->socketIdx,
                                    appHandle->mdDefault.connectTimeout,
                                    FALSE,
-                                   mcGroup);
+                                   pDelete->addr.mcGroup);
             }
 
             /* deletes listener sessions */
@@ -739,7 +734,7 @@ EXT_DECL TRDP_ERR_T tlm_readdListener (
                 }
             }
             /*  Find the correct socket    */
-            trdp_releaseSocket(appHandle->ifaceMD, pListener->socketIdx, 0u, FALSE, mcDestIpAddr);
+            trdp_releaseSocket(appHandle->ifaceMD, pListener->socketIdx, 0u, FALSE, pListener->addr.mcGroup);
             ret = trdp_requestSocket(appHandle->ifaceMD,
                                      appHandle->mdDefault.udpPort,
                                      &appHandle->mdDefault.sendParam,
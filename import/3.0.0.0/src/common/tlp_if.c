@@ -78,6 +78,15 @@ extern "C" {
  * TYPEDEFS
  */
 
+/** Key of a telegram of tlp_publishBulk / tlp_subscribeBulk to find duplicates    */
+typedef struct
+{
+    UINT32          comId;                      /**< comId of the telegram                                  */
+    UINT32          index;                      /**< position in the definition                             */
+    TRDP_IP_ADDR_T  destIpAddr;                 /**< destination as passed to tlp_publish / tlp_subscribe   */
+    PD_ELE_T        *pElement;                  /**< the new element                                        */
+} TRDP_BULK_KEY_T;
+
 /***********************************************************************************************************************
  * LOCALS
  */
@@ -86,6 +95,447 @@ extern "C" {
  * LOCAL FUNCTIONS
  */
 
+/**********************************************************************************************************************/
+/** Set up a new publisher: socket, frame and header.
+ *  The element is zeroed and its addresses are set. On error, the socket and frame are released again.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pNewElement         the new element
+ *  @param[in]      pDef                the parameters of tlp_publish
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_SOCK_ERR       no socket available
+ *  @retval         TRDP_NOINIT_ERR     redundancy state could not be read
+ */
+static TRDP_ERR_T setupPublisher (
+    TRDP_APP_SESSION_T      appHandle,
+    PD_ELE_T                *pNewElement,
+    const TRDP_PUB_DEF_T    *pDef)
+{
+    TRDP_TIME_T         nextTime;
+    TRDP_TIME_T         tv_interval;
+    TRDP_ERR_T          ret;
+    TRDP_MSG_T          msgType     = TRDP_MSG_PD;
+    TRDP_SOCK_TYPE_T    sockType    = TRDP_SOCK_PD;
+    UINT32              interval    = pDef->interval;
+    BOOL8               isLeader    = TRUE;
+
+    /*    Check if the redundancy group is already set as follower; if set, we need to mark this one also!
+     This will only happen, if publish() is called while we are in redundant mode */
+    if (0 != pDef->redId)
+    {
+        isLeader = FALSE; /* #355 now FALSE instead of TRUE as default */
+
+        ret = tlp_getRedundant(appHandle, pDef->redId, &isLeader);
+        if (ret != TRDP_NO_ERR)
+        {
+            return ret;
+        }
+    }
+
+    pNewElement->pktFlags = (pDef->pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pDef->pktFlags;
+
+    /* mark data as invalid, data will be set valid with tlp_put */
+    pNewElement->privFlags  |= TRDP_INVALID_DATA;
+    pNewElement->dataSize   = pDef->dataSize;
+
+#ifdef TSN_SUPPORT
+    /* check for TSN and select the right message type and socket type #435 */
+    if (pNewElement->pktFlags & TRDP_FLAGS_TSN)
+    {
+        msgType     = TRDP_MSG_PT;
+        interval    = 0u;       /* force zero interval */
+        sockType    = TRDP_SOCK_PD_TSN;
+        pNewElement->privFlags  |= TRDP_IS_TSN;
+    }
+#endif
+    /*
+     Compute the overal packet size
+     */
+    pNewElement->grossSize = trdp_packetSizePD(pDef->dataSize);
+
+    /*    Get a socket    */
+    ret = trdp_requestSocket(
+            appHandle->ifacePD,
+            appHandle->pdDefault.port,
+            &appHandle->pdDefault.sendParam, /* #435 */
+            pNewElement->addr.srcIpAddr,
+            pNewElement->addr.destIpAddr,
+            0u,
+            sockType,
+            appHandle->option,
+            FALSE,
+            VOS_INVALID_SOCKET,
+            &pNewElement->socketIdx,
+            0u);
+    if (ret != TRDP_NO_ERR)
+    {
+        return ret;
+    }
+
+    /*  Alloc the corresponding data buffer  */
+    pNewElement->pFrame = (PD_PACKET_T *) vos_memAlloc(pNewElement->grossSize);
+    if (pNewElement->pFrame == NULL)
+    {
+        trdp_releaseSocket(appHandle->ifacePD, pNewElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+        return TRDP_MEM_ERR;
+    }
+
+    /*    Update the internal data */
+    pNewElement->pullIpAddress  = 0u;
+    pNewElement->redId          = pDef->redId;
+    pNewElement->pCachedDS      = NULL;
+    pNewElement->magic          = TRDP_MAGIC_PUB_HNDL_VALUE;
+    pNewElement->pUserRef       = pDef->pUserRef;
+
+    /* PD PULL or TSN?    Packet will be sent on request only    */
+    if (0 == interval)       /* Disable interval sending of TSN packets */
+    {
+        vos_clearTime(&pNewElement->interval);
+        vos_clearTime(&pNewElement->timeToGo);
+    }
+    else
+    {
+        /*    Get the current time and compute the next time this packet should be sent.    */
+        vos_getTime(&nextTime);
+        tv_interval.tv_sec  = interval / 1000000u;
+        tv_interval.tv_usec = interval % 1000000;
+        vos_addTime(&nextTime, &tv_interval);
+        pNewElement->interval   = tv_interval;
+        pNewElement->timeToGo   = nextTime;
+    }
+
+    /* if default flags supplied and no callback func supplied, take default one */
+    if ((pDef->pktFlags == TRDP_FLAGS_DEFAULT) &&
+        (pDef->pfCbFunction == NULL))
+    {
+        pNewElement->pfCbFunction = appHandle->pdDefault.pfCbFunction;
+    }
+    else
+    {
+        pNewElement->pfCbFunction = pDef->pfCbFunction;
+    }
+
+    /*  Find a possible redundant entry in one of the other sessions and sync the sequence counter!
+     curSeqCnt holds the last sent sequence counter, therefore set the value initially to -1,
+     it will be incremented when sending...    */
+
+    pNewElement->curSeqCnt = 0xFFFFFFFFu;
+
+    /*  Get a second sequence counter in case this packet is requested as PULL. This way we will not
+     disturb the monotonic sequence for PDs  */
+    pNewElement->curSeqCnt4Pull = 0xFFFFFFFFu;
+
+    if (FALSE == isLeader)
+    {
+        pNewElement->privFlags |= TRDP_REDUNDANT;
+    }
+
+    /*    Compute the header fields */
+    trdp_pdInit(pNewElement, msgType, pDef->etbTopoCnt, pDef->opTrnTopoCnt, 0u, 0u, pDef->serviceId);
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Set the addresses of a new subscription
+ *
+ *  @param[in]      pNewElement         the new element
+ *  @param[in]      pDef                the parameters of tlp_subscribe
+ */
+static void setSubAddr (
+    PD_ELE_T                *pNewElement,
+    const TRDP_SUB_DEF_T    *pDef)
+{
+    if (vos_isMulticast(pDef->destIpAddr))
+    {
+        pNewElement->addr.mcGroup       = pDef->destIpAddr;
+        pNewElement->addr.destIpAddr    = pDef->destIpAddr;
+    }
+    else
+    {
+        pNewElement->addr.mcGroup       = 0u;
+        pNewElement->addr.destIpAddr    = 0u;
+    }
+
+    pNewElement->addr.comId         = pDef->comId;
+    pNewElement->addr.srcIpAddr     = pDef->srcIpAddr1;
+    pNewElement->addr.srcIpAddr2    = pDef->srcIpAddr2;
+    pNewElement->addr.serviceId     = pDef->serviceId;
+    pNewElement->addr.etbTopoCnt    = pDef->etbTopoCnt;
+    pNewElement->addr.opTrnTopoCnt  = pDef->opTrnTopoCnt;
+}
+
+/**********************************************************************************************************************/
+/** Set up a new subscription: socket and frame.
+ *  The element is zeroed and its addresses are set. On error, the socket is released again.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      newPD               the new element
+ *  @param[in]      pDef                the parameters of tlp_subscribe
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_SOCK_ERR       no socket available
+ */
+static TRDP_ERR_T setupSubscriber (
+    TRDP_APP_SESSION_T      appHandle,
+    PD_ELE_T                *newPD,
+    const TRDP_SUB_DEF_T    *pDef)
+{
+    TRDP_ERR_T          ret;
+    TRDP_SOCK_TYPE_T    usage   = TRDP_SOCK_PD;
+    UINT32              timeout = pDef->timeout;
+
+    if (timeout == 0u)
+    {
+        timeout = appHandle->pdDefault.timeout;
+    }
+    else if (timeout < TRDP_TIMER_GRANULARITY)
+    {
+        timeout = TRDP_TIMER_GRANULARITY;
+    }
+
+    if (pDef->pktFlags & (TRDP_FLAGS_TSN))
+    {
+        usage = TRDP_SOCK_PD_TSN;
+    }
+    /*    Find a (new) socket    */
+    ret = trdp_requestSocket(appHandle->ifacePD,
+                             appHandle->pdDefault.port,
+                             &appHandle->pdDefault.sendParam, /* '435 */
+                             appHandle->realIP,
+                             0u,
+                             newPD->addr.mcGroup,
+                             usage,
+                             appHandle->option,
+                             TRUE,                              // rcvMostly: RAW socket option not needed for receivers
+                             VOS_INVALID_SOCKET,
+                             &newPD->socketIdx,
+                             0u);
+    if (ret != TRDP_NO_ERR)
+    {
+        return ret;
+    }
+
+    /*  Alloc the corresponding data buffer  */
+    newPD->pFrame = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
+    if (newPD->pFrame == NULL)
+    {
+        trdp_releaseSocket(appHandle->ifacePD, newPD->socketIdx, 0u, FALSE, newPD->addr.mcGroup);
+        return TRDP_MEM_ERR;
+    }
+
+    /*    Initialize some fields    */
+    if (newPD->addr.mcGroup != 0u)
+    {
+        newPD->privFlags |= TRDP_MC_JOINT;
+    }
+    newPD->interval.tv_sec      = timeout / 1000000u;
+    newPD->interval.tv_usec     = timeout % 1000000u;
+    newPD->toBehavior           =
+        (pDef->toBehavior == TRDP_TO_DEFAULT) ? appHandle->pdDefault.toBehavior : pDef->toBehavior;
+    newPD->grossSize    = TRDP_MAX_PD_PACKET_SIZE;
+    newPD->pUserRef     = pDef->pUserRef;
+    newPD->privFlags    |= TRDP_INVALID_DATA;
+    newPD->pktFlags     =
+        (pDef->pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pDef->pktFlags;
+    newPD->pfCbFunction =
+        (pDef->pfCbFunction == NULL) ? appHandle->pdDefault.pfCbFunction : pDef->pfCbFunction;
+    newPD->pCachedDS    = NULL;
+    newPD->magic        = TRDP_MAGIC_SUB_HNDL_VALUE;
+
+    if (timeout == TRDP_INFINITE_TIMEOUT)
+    {
+        vos_clearTime(&newPD->timeToGo);
+        vos_clearTime(&newPD->interval);
+    }
+    else
+    {
+        vos_getTime(&newPD->timeToGo);
+        vos_addTime(&newPD->timeToGo, &newPD->interval);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Sort the keys of a bulk definition by comId, then by position
+ *
+ *  @param[in]      pKey1               pointer to first key
+ *  @param[in]      pKey2               pointer to second key
+ */
+static int compareBulkKeys (const void *pKey1, const void *pKey2)
+{
+    const TRDP_BULK_KEY_T   *p1 = (const TRDP_BULK_KEY_T *) pKey1;
+    const TRDP_BULK_KEY_T   *p2 = (const TRDP_BULK_KEY_T *) pKey2;
+
+    if (p1->comId != p2->comId)
+    {
+        return (p1->comId > p2->comId) ? 1 : -1;
+    }
+    if (p1->index != p2->index)
+    {
+        return (p1->index > p2->index) ? 1 : -1;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Check if a key of a bulk definition collides with a publisher or subscription
+ *
+ *  @param[in]      pAddr               addresses of the existing or earlier defined element
+ *  @param[in]      pKey                key of the new element
+ *  @param[in]      isSub               TRUE: subscriptions, FALSE: publishers
+ *
+ *  @retval         TRUE                the telegram collides
+ *  @retval         FALSE               no collision
+ */
+static BOOL8 matchBulkKey (
+    const TRDP_ADDRESSES_T  *pAddr,
+    const TRDP_BULK_KEY_T   *pKey,
+    BOOL8                   isSub)
+{
+    TRDP_ADDRESSES_T addr;
+
+    /*  The key as passed to trdp_queueFindPubAddr / trdp_queueFindExistingSub */
+    addr            = pKey->pElement->addr;
+    addr.destIpAddr = pKey->destIpAddr;
+
+    return (isSub == TRUE) ? trdp_matchExistingSub(pAddr, &addr) : trdp_matchPubAddr(pAddr, &addr);
+}
+
+/**********************************************************************************************************************/
+/** Check the sorted keys of a bulk definition against the elements of a list
+ *
+ *  @param[in]      pHead               first element of the list
+ *  @param[in]      pEnd                element after the last one to check, NULL for the whole list
+ *  @param[in]      pKey                keys of the new elements, sorted by comId
+ *  @param[in]      noOfKeys            number of keys
+ *  @param[in]      isSub               TRUE: subscriptions, FALSE: publishers
+ *
+ *  @retval         TRUE                a telegram collides
+ *  @retval         FALSE               no collision
+ */
+static BOOL8 findBulkCollision (
+    PD_ELE_T                *pHead,
+    const PD_ELE_T          *pEnd,
+    const TRDP_BULK_KEY_T   *pKey,
+    UINT32                  noOfKeys,
+    BOOL8                   isSub)
+{
+    PD_ELE_T *iterPD;
+
+    for (iterPD = pHead; iterPD != pEnd; iterPD = iterPD->pNext)
+    {
+        UINT32  lower = 0u;
+        UINT32  upper = noOfKeys;
+        UINT32  k;
+
+        /*  First key of this comId */
+        while (lower < upper)
+        {
+            UINT32 mid = lower + (upper - lower) / 2u;
+
+            if (pKey[mid].comId < iterPD->addr.comId)
+            {
+                lower = mid + 1u;
+            }
+            else
+            {
+                upper = mid;
+            }
+        }
+        for (k = lower; (k < noOfKeys) && (pKey[k].comId == iterPD->addr.comId); k++)
+        {
+            if (matchBulkKey(&iterPD->addr, &pKey[k], isSub) == TRUE)
+            {
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Check the new elements of a bulk definition for duplicates.
+ *  A telegram collides as with tlp_publish / tlp_subscribe with the telegrams already in the queue and with those
+ *  before it in the definition. Only elements of the same comId are compared. The keys are sorted in slices fitting
+ *  into one memory block.
+ *
+ *  @param[in]      pHead               pointer to head of queue
+ *  @param[in]      pFirst              first new element, addresses set
+ *  @param[in]      noOfElements        number of new elements
+ *  @param[in]      pSubDef             definitions of subscriptions, NULL for publishers
+ *
+ *  @retval         TRDP_NO_ERR         no duplicate
+ *  @retval         TRDP_NOPUB_ERR      a telegram is already published or defined twice
+ *  @retval         TRDP_NOSUB_ERR      a telegram is already subscribed or defined twice
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+static TRDP_ERR_T checkBulkDuplicates (
+    PD_ELE_T                *pHead,
+    PD_ELE_T                *pFirst,
+    UINT32                  noOfElements,
+    const TRDP_SUB_DEF_T    *pSubDef)
+{
+    TRDP_BULK_KEY_T *pKey;
+    PD_ELE_T        *pSlice     = pFirst;
+    PD_ELE_T        *pIter;
+    BOOL8           isSub       = (pSubDef != NULL) ? TRUE : FALSE;
+    UINT32          maxKeys     = TRDP_PD_ARENA_SIZE / sizeof(TRDP_BULK_KEY_T);
+    UINT32          done        = 0u;
+    TRDP_ERR_T      ret         = TRDP_NO_ERR;
+
+    pKey = (TRDP_BULK_KEY_T *) vos_memAlloc(((noOfElements < maxKeys) ? noOfElements : maxKeys) *
+                                            sizeof(TRDP_BULK_KEY_T));
+    if (pKey == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    while ((ret == TRDP_NO_ERR) && (done < noOfElements))
+    {
+        UINT32  noOfKeys = ((noOfElements - done) < maxKeys) ? (noOfElements - done) : maxKeys;
+        UINT32  i, k;
+
+        for (k = 0u, pIter = pSlice; k < noOfKeys; k++, pIter = pIter->pNext)
+        {
+            pKey[k].comId       = pIter->addr.comId;
+            pKey[k].index       = k;
+            pKey[k].destIpAddr  = (isSub == TRUE) ? pSubDef[done + k].destIpAddr : pIter->addr.destIpAddr;
+            pKey[k].pElement    = pIter;
+        }
+        vos_qsort(pKey, noOfKeys, sizeof(TRDP_BULK_KEY_T), compareBulkKeys);
+
+        /*  Earlier definitions of the same comId in this slice */
+        for (k = 1u; (ret == TRDP_NO_ERR) && (k < noOfKeys); k++)
+        {
+            for (i = k; (i > 0u) && (pKey[i - 1u].comId == pKey[k].comId); i--)
+            {
+                if (matchBulkKey(&pKey[i - 1u].pElement->addr, &pKey[k], isSub) == TRUE)
+                {
+                    ret = (isSub == TRUE) ? TRDP_NOSUB_ERR : TRDP_NOPUB_ERR;
+                    break;
+                }
+            }
+        }
+
+        /*  Definitions of the slices before and the queue */
+        if ((ret == TRDP_NO_ERR)
+            && ((findBulkCollision(pFirst, pSlice, pKey, noOfKeys, isSub) == TRUE)
+                || (findBulkCollision(pHead, NULL, pKey, noOfKeys, isSub) == TRUE)))
+        {
+            ret = (isSub == TRUE) ? TRDP_NOSUB_ERR : TRDP_NOPUB_ERR;
+        }
+        pSlice  = pIter;
+        done    += noOfKeys;
+    }
+
+    vos_memFree(pKey);
+    return ret;
+}
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -478,11 +928,7 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     UINT32                  dataSize)
 {
     PD_ELE_T            *pNewElement = NULL;
-    TRDP_TIME_T         nextTime;
-    TRDP_TIME_T         tv_interval;
     TRDP_ERR_T          ret         = TRDP_NO_ERR;
-    TRDP_MSG_T          msgType     = TRDP_MSG_PD;
-    TRDP_SOCK_TYPE_T    sockType    = TRDP_SOCK_PD;
 
     /*    Check params    */
     if ((interval != 0u && interval < TRDP_TIMER_GRANULARITY)
@@ -530,130 +976,37 @@ EXT_DECL TRDP_ERR_T tlp_publish (
             }
             else
             {
-                pNewElement->pktFlags = (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
-
-                /* mark data as invalid, data will be set valid with tlp_put */
-                pNewElement->privFlags  |= TRDP_INVALID_DATA;
-                pNewElement->dataSize   = dataSize;
+                TRDP_PUB_DEF_T pubDef;
+
+                pubDef.pUserRef     = pUserRef;
+                pubDef.pfCbFunction = pfCbFunction;
+                pubDef.serviceId    = serviceId;
+                pubDef.comId        = comId;
+                pubDef.etbTopoCnt   = etbTopoCnt;
+                pubDef.opTrnTopoCnt = opTrnTopoCnt;
+                pubDef.srcIpAddr    = srcIpAddr;
+                pubDef.destIpAddr   = destIpAddr;
+                pubDef.interval     = interval;
+                pubDef.redId        = redId;
+                pubDef.pktFlags     = pktFlags;
+                pubDef.pData        = pData;
+                pubDef.dataSize     = dataSize;
+
+                pNewElement->addr = pubHandle;
+                ret = setupPublisher(appHandle, pNewElement, &pubDef);
 
-#ifdef TSN_SUPPORT
-                /* check for TSN and select the right message type and socket type #435 */
-                if (pNewElement->pktFlags & TRDP_FLAGS_TSN)
-                {
-                    msgType     = TRDP_MSG_PT;
-                    interval    = 0u;       /* force zero interval */
-                    sockType    = TRDP_SOCK_PD_TSN;
-                    pNewElement->privFlags  |= TRDP_IS_TSN;
-                }
-#endif
-                /*
-                 Compute the overal packet size
-                 */
-                pNewElement->grossSize = trdp_packetSizePD(dataSize);
-
-                if (ret == TRDP_NO_ERR)
-                {
-                    /*    Get a socket    */
-                    ret = trdp_requestSocket(
-                            appHandle->ifacePD,
-                            appHandle->pdDefault.port,
-                            &appHandle->pdDefault.sendParam, /* #435 */
-                            srcIpAddr,
-                            destIpAddr,
-                            0u,
-                            sockType,
-                            appHandle->option,
-                            FALSE,
-                            VOS_INVALID_SOCKET,
-                            &pNewElement->socketIdx,
-                            0u);
-                }
                 /* If we couldn't get a socket, we release the used memory and exit */
                 if (ret != TRDP_NO_ERR)
                 {
                     vos_memFree(pNewElement);
                     pNewElement = NULL;
                 }
-                else
-                {
-                    /*  Alloc the corresponding data buffer  */
-                    pNewElement->pFrame = (PD_PACKET_T *) vos_memAlloc(pNewElement->grossSize);
-                    if (pNewElement->pFrame == NULL)
-                    {
-                        vos_memFree(pNewElement);
-                        pNewElement = NULL;
-                        ret = TRDP_MEM_ERR;
-                    }
-                }
             }
         }
 
-        /*    Get the current time and compute the next time this packet should be sent.    */
         if ((ret == TRDP_NO_ERR)
             && (pNewElement != NULL))
         {
-            /*    Update the internal data */
-            pNewElement->addr = pubHandle;
-            pNewElement->pullIpAddress  = 0u;
-            pNewElement->redId          = redId;
-            pNewElement->pCachedDS      = NULL;
-            pNewElement->magic          = TRDP_MAGIC_PUB_HNDL_VALUE;
-            pNewElement->pUserRef       = pUserRef;
-
-            /* PD PULL or TSN?    Packet will be sent on request only    */
-            if (0 == interval)       /* Disable interval sending of TSN packets */
-            {
-                vos_clearTime(&pNewElement->interval);
-                vos_clearTime(&pNewElement->timeToGo);
-            }
-            else
-            {
-                vos_getTime(&nextTime);
-                tv_interval.tv_sec  = interval / 1000000u;
-                tv_interval.tv_usec = interval % 1000000;
-                vos_addTime(&nextTime, &tv_interval);
-                pNewElement->interval   = tv_interval;
-                pNewElement->timeToGo   = nextTime;
-            }
-
-
-            /* if default flags supplied and no callback func supplied, take default one */
-            if ((pktFlags == TRDP_FLAGS_DEFAULT) &&
-                (pfCbFunction == NULL))
-            {
-                pNewElement->pfCbFunction = appHandle->pdDefault.pfCbFunction;
-            }
-            else
-            {
-                pNewElement->pfCbFunction = pfCbFunction;
-            }
-
-            /*  Find a possible redundant entry in one of the other sessions and sync the sequence counter!
-             curSeqCnt holds the last sent sequence counter, therefore set the value initially to -1,
-             it will be incremented when sending...    */
-
-            pNewElement->curSeqCnt = 0xFFFFFFFFu;
-
-            /*  Get a second sequence counter in case this packet is requested as PULL. This way we will not
-             disturb the monotonic sequence for PDs  */
-            pNewElement->curSeqCnt4Pull = 0xFFFFFFFFu;
-
-            /*    Check if the redundancy group is already set as follower; if set, we need to mark this one also!
-             This will only happen, if publish() is called while we are in redundant mode */
-            if (0 != redId)
-            {
-                BOOL8 isLeader = FALSE; /* #355 now FALSE instead of TRUE as default */
-
-                ret = tlp_getRedundant(appHandle, redId, &isLeader);
-                if (ret == TRDP_NO_ERR && FALSE == isLeader)
-                {
-                    pNewElement->privFlags |= TRDP_REDUNDANT;
-                }
-            }
-
-            /*    Compute the header fields */
-            trdp_pdInit(pNewElement, msgType, etbTopoCnt, opTrnTopoCnt, 0u, 0u, serviceId);
-
 #ifdef HIGH_PERF_INDEXED
             /*    Keep queue sorted    */
             trdp_queueInsThroughputAccending(&appHandle->pSndQueue, pNewElement);
@@ -695,6 +1048,166 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     return ret;
 }
 
+/**********************************************************************************************************************/
+/** Prepare for sending many PD messages at once.
+ *  Same as tlp_publish for each definition, but the elements are allocated in blocks, inserted into the send queue in
+ *  one pass, and the send schedule (or, after tlc_updateSession, the index tables) is computed once.
+ *  The definitions can be filled from the exchange parameters read by tau_readXmlInterfaceConfig.
+ *  Either all or none of the telegrams are published. An error of the initial tlp_put is returned, the telegrams
+ *  stay published as with tlp_publish.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pPubDef             telegrams to publish, the handles are returned in pubHandle
+ *  @param[in]      noOfPub             number of telegrams
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      a telegram is already published or defined twice
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_publishBulk (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_DEF_T      *pPubDef,
+    UINT32              noOfPub)
+{
+    PD_ELE_T    *pFirst;
+    PD_ELE_T    *pIter;
+    TRDP_ERR_T  ret;
+    UINT32      i;
+
+    /*    Check params    */
+    if ((pPubDef == NULL) || (noOfPub == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    for (i = 0u; i < noOfPub; i++)
+    {
+        if ((pPubDef[i].interval != 0u) && (pPubDef[i].interval < TRDP_TIMER_GRANULARITY))
+        {
+            return TRDP_PARAM_ERR;
+        }
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexTxPD);
+    if (ret != TRDP_NO_ERR)
+    {
+        return ret;
+    }
+
+    pFirst = trdp_pdAllocElements(noOfPub);
+    if (pFirst == NULL)
+    {
+        ret = TRDP_MEM_ERR;
+    }
+    else
+    {
+        /*    Addresses of the new publishers, as set by tlp_publish    */
+        for (i = 0u, pIter = pFirst; i < noOfPub; i++, pIter = pIter->pNext)
+        {
+            pIter->addr.comId       = pPubDef[i].comId;
+            pIter->addr.destIpAddr  = pPubDef[i].destIpAddr;
+            pIter->addr.mcGroup     = vos_isMulticast(pPubDef[i].destIpAddr) ? pPubDef[i].destIpAddr : 0u;
+            pIter->addr.srcIpAddr   = (pPubDef[i].srcIpAddr == VOS_INADDR_ANY) ?
+                appHandle->realIP : pPubDef[i].srcIpAddr;
+            pIter->addr.serviceId   = pPubDef[i].serviceId;
+        }
+        ret = checkBulkDuplicates(appHandle->pSndQueue, pFirst, noOfPub, NULL);
+    }
+
+    /*    Sockets, frames and headers    */
+    for (i = 0u, pIter = pFirst; (ret == TRDP_NO_ERR) && (i < noOfPub); i++, pIter = pIter->pNext)
+    {
+        ret = setupPublisher(appHandle, pIter, &pPubDef[i]);
+    }
+
+    if (ret != TRDP_NO_ERR)
+    {
+        /*    Release the sockets of the publishers set up so far and free all elements    */
+        while (pFirst != NULL)
+        {
+            PD_ELE_T *pNext = pFirst->pNext;
+
+            if (pFirst->magic == TRDP_MAGIC_PUB_HNDL_VALUE)
+            {
+                trdp_releaseSocket(appHandle->ifacePD, pFirst->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+                pFirst->magic = 0u;
+            }
+            trdp_pdFreeElement(pFirst);
+            pFirst = pNext;
+        }
+    }
+    else
+    {
+        for (i = 0u, pIter = pFirst; i < noOfPub; i++, pIter = pIter->pNext)
+        {
+            pPubDef[i].pubHandle = (TRDP_PUB_T) pIter;
+        }
+
+#ifdef HIGH_PERF_INDEXED
+        /*    Keep queue sorted    */
+        trdp_queueMergeThroughputAccending(&appHandle->pSndQueue, pFirst);
+#else
+        /*    Insert at front, the last definition first as with tlp_publish    */
+        while (pFirst != NULL)
+        {
+            PD_ELE_T *pNext = pFirst->pNext;
+
+            trdp_queueInsFirst(&appHandle->pSndQueue, pFirst);
+            pFirst = pNext;
+        }
+#endif
+
+        for (i = 0u; i < noOfPub; i++)
+        {
+            pIter = (PD_ELE_T *) pPubDef[i].pubHandle;
+#ifdef TSN_SUPPORT
+            if (pIter->privFlags & TRDP_IS_TSN)
+            {
+                /* We set the vlan IP as we bound the socket to */
+                pIter->addr.srcIpAddr = appHandle->ifacePD[pIter->socketIdx].bindAddr;
+            }
+            else
+#endif
+            if (pPubDef[i].dataSize != 0u)
+            {
+                TRDP_ERR_T err = tlp_put(appHandle, pPubDef[i].pubHandle, pPubDef[i].pData, pPubDef[i].dataSize);
+
+                if (ret == TRDP_NO_ERR)
+                {
+                    ret = err;
+                }
+            }
+        }
+
+#ifdef HIGH_PERF_INDEXED
+        /*    Index tables already in use (tlc_updateSession was called)? Include the new publishers    */
+        if ((ret == TRDP_NO_ERR) && (appHandle->pSlot != NULL) && (appHandle->pSlot->processCycle != 0u))
+        {
+            ret = trdp_indexCreatePubTables(appHandle);
+        }
+#else
+        if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
+        {
+            ret = trdp_pdDistribute(appHandle->pSndQueue);
+        }
+#endif
+    }
+
+    if (vos_mutexUnlock(appHandle->mutexTxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
+
 #ifdef SOA_SUPPORT
 /**********************************************************************************************************************/
 /** Prepare for sending PD messages.
@@ -844,6 +1357,7 @@ EXT_DECL TRDP_ERR_T tlp_republish (
             TRDP_COM_PARAM_T sendParams = appHandle->ifacePD[pubHandle->socketIdx].sendParam;
 
             /* Release the previously used socket for this publisher */
+            trdp_pdTxStampCancel(appHandle, pubHandle);
             trdp_releaseSocket(appHandle->ifacePD, pubHandle->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
 
             err = trdp_requestSocket(
@@ -925,14 +1439,10 @@ EXT_DECL TRDP_ERR_T  tlp_unpublish (
     {
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pSndQueue, pElement);
+        trdp_pdTxStampCancel(appHandle, pElement);
         trdp_releaseSocket(appHandle->ifacePD, pElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
         pElement->magic = 0u;
-        if (pElement->pSeqCntList != NULL)
-        {
-            vos_memFree(pElement->pSeqCntList);
-        }
-        vos_memFree(pElement->pFrame);
-        vos_memFree(pElement);
+        trdp_pdFreeElement(pElement);
 
 #ifndef HIGH_PERF_INDEXED
         /* Re-compute distribution times */
@@ -1432,10 +1942,8 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     UINT32                  timeout,
     TRDP_TO_BEHAVIOR_T      toBehavior)
 {
-    TRDP_TIME_T         now;
     TRDP_ERR_T          ret = TRDP_NO_ERR;
     TRDP_ADDRESSES_T    subHandle;
-    INT32 lIndex;
 
     /*    Check params    */
     if (pSubHandle == NULL)
@@ -1448,15 +1956,6 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
         return TRDP_NOINIT_ERR;
     }
 
-    if (timeout == 0u)
-    {
-        timeout = appHandle->pdDefault.timeout;
-    }
-    else if (timeout < TRDP_TIMER_GRANULARITY)
-    {
-        timeout = TRDP_TIMER_GRANULARITY;
-    }
-
     /*    Reserve mutual access    */
     if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
     {
@@ -1481,9 +1980,6 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
         subHandle.mcGroup = 0u;
     }
 
-    /*    Get the current time    */
-    vos_getTime(&now);
-
     /*    Look for existing element    */
     if (trdp_queueFindExistingSub(appHandle->pRcvQueue, &subHandle) != NULL)
     {
@@ -1491,107 +1987,159 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     }
     else
     {
-        TRDP_SOCK_TYPE_T usage = TRDP_SOCK_PD;
+        PD_ELE_T *newPD;
 
-        subHandle.opTrnTopoCnt  = opTrnTopoCnt; /* Set topocounts now  */
-        subHandle.etbTopoCnt    = etbTopoCnt;
+        /*    Allocate a buffer for this kind of packets    */
+        newPD = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
 
-        if (pktFlags & (TRDP_FLAGS_TSN))
+        if (newPD == NULL)
         {
-            usage = TRDP_SOCK_PD_TSN;
+            ret = TRDP_MEM_ERR;
         }
-        /*    Find a (new) socket    */
-        ret = trdp_requestSocket(appHandle->ifacePD,
-                                 appHandle->pdDefault.port,
-                                 &appHandle->pdDefault.sendParam, /* '435 */
-                                 appHandle->realIP,
-                                 0u,
-                                 subHandle.mcGroup,
-                                 usage,
-                                 appHandle->option,
-                                 TRUE,                              // rcvMostly: RAW socket option not needed for receivers
-                                 VOS_INVALID_SOCKET,
-                                 &lIndex,
-                                 0u);
-
-        if (ret == TRDP_NO_ERR)
+        else
         {
-            PD_ELE_T *newPD;
-
-            /*    buffer size is PD_ELEMENT plus max. payload size    */
-
-            /*    Allocate a buffer for this kind of packets    */
-            newPD = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
-
-            if (newPD == NULL)
+            TRDP_SUB_DEF_T subDef;
+
+            subDef.pUserRef     = pUserRef;
+            subDef.pfCbFunction = pfCbFunction;
+            subDef.serviceId    = serviceId;
+            subDef.comId        = comId;
+            subDef.etbTopoCnt   = etbTopoCnt;
+            subDef.opTrnTopoCnt = opTrnTopoCnt;
+            subDef.srcIpAddr1   = srcIpAddr1;
+            subDef.srcIpAddr2   = srcIpAddr2;
+            subDef.destIpAddr   = destIpAddr;
+            subDef.pktFlags     = pktFlags;
+            subDef.timeout      = timeout;
+            subDef.toBehavior   = toBehavior;
+
+            setSubAddr(newPD, &subDef);
+            ret = setupSubscriber(appHandle, newPD, &subDef);
+            if (ret != TRDP_NO_ERR)
             {
-                ret = TRDP_MEM_ERR;
-                trdp_releaseSocket(appHandle->ifacePD, lIndex, 0u, FALSE, VOS_INADDR_ANY);
+                vos_memFree(newPD);
             }
             else
             {
-                /*  Alloc the corresponding data buffer  */
-                newPD->pFrame = (PD_PACKET_T *) vos_memAlloc(TRDP_MAX_PD_PACKET_SIZE);
-                if (newPD->pFrame == NULL)
-                {
-                    vos_memFree(newPD);
-                    newPD   = NULL;
-                    ret     = TRDP_MEM_ERR;
-                }
-                else
-                {
-                    /*    Initialize some fields    */
-                    if (vos_isMulticast(destIpAddr))
-                    {
-                        newPD->addr.mcGroup     = destIpAddr;
-                        newPD->privFlags        |= TRDP_MC_JOINT;
-                        newPD->addr.destIpAddr  = destIpAddr;
-                    }
-                    else
-                    {
-                        newPD->addr.mcGroup     = 0u;
-                        newPD->addr.destIpAddr  = 0u;
-                    }
+                /*  append this subscription to our receive queue */
+                trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
 
-                    newPD->addr.comId           = comId;
-                    newPD->addr.srcIpAddr       = srcIpAddr1;
-                    newPD->addr.srcIpAddr2      = srcIpAddr2;
-                    newPD->addr.serviceId       = serviceId;
-                    newPD->addr.etbTopoCnt      = etbTopoCnt;
-                    newPD->addr.opTrnTopoCnt    = opTrnTopoCnt;
-                    newPD->interval.tv_sec      = timeout / 1000000u;
-                    newPD->interval.tv_usec     = timeout % 1000000u;
-                    newPD->toBehavior           =
-                        (toBehavior == TRDP_TO_DEFAULT) ? appHandle->pdDefault.toBehavior : toBehavior;
-                    newPD->grossSize    = TRDP_MAX_PD_PACKET_SIZE;
-                    newPD->pUserRef     = pUserRef;
-                    newPD->socketIdx    = lIndex;
-                    newPD->privFlags    |= TRDP_INVALID_DATA;
-                    newPD->pktFlags     =
-                        (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
-                    newPD->pfCbFunction =
-                        (pfCbFunction == NULL) ? appHandle->pdDefault.pfCbFunction : pfCbFunction;
-                    newPD->pCachedDS    = NULL;
-                    newPD->magic        = TRDP_MAGIC_SUB_HNDL_VALUE;
+                *pSubHandle = (TRDP_SUB_T) newPD;
+            }
+        }
+    } /*lint !e438 unused newPD */
 
-                    if (timeout == TRDP_INFINITE_TIMEOUT)
-                    {
-                        vos_clearTime(&newPD->timeToGo);
-                        vos_clearTime(&newPD->interval);
-                    }
-                    else
-                    {
-                        vos_getTime(&newPD->timeToGo);
-                        vos_addTime(&newPD->timeToGo, &newPD->interval);
-                    }
+    if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
 
-                    /*  append this subscription to our receive queue */
-                    trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
+/**********************************************************************************************************************/
+/** Prepare for receiving many PD messages at once.
+ *  Same as tlp_subscribe for each definition, but the elements are allocated in blocks and appended to the receive
+ *  queue in one pass. After tlc_updateSession, the index tables are computed once.
+ *  The definitions can be filled from the exchange parameters read by tau_readXmlInterfaceConfig.
+ *  Either all or none of the telegrams are subscribed.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pSubDef             telegrams to subscribe, the handles are returned in subHandle
+ *  @param[in]      noOfSub             number of telegrams
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      a telegram is already subscribed or defined twice
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_subscribeBulk (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_DEF_T      *pSubDef,
+    UINT32              noOfSub)
+{
+    PD_ELE_T    *pFirst;
+    PD_ELE_T    *pIter;
+    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    UINT32      i;
 
-                    *pSubHandle = (TRDP_SUB_T) newPD;
-                }
+    /*    Check params    */
+    if ((pSubDef == NULL) || (noOfSub == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutexRxPD) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pFirst = trdp_pdAllocElements(noOfSub);
+    if (pFirst == NULL)
+    {
+        ret = TRDP_MEM_ERR;
+    }
+    else
+    {
+        for (i = 0u, pIter = pFirst; i < noOfSub; i++, pIter = pIter->pNext)
+        {
+            setSubAddr(pIter, &pSubDef[i]);
+        }
+        ret = checkBulkDuplicates(appHandle->pRcvQueue, pFirst, noOfSub, pSubDef);
+    }
+
+    /*    Sockets and frames    */
+    for (i = 0u, pIter = pFirst; (ret == TRDP_NO_ERR) && (i < noOfSub); i++, pIter = pIter->pNext)
+    {
+        ret = setupSubscriber(appHandle, pIter, &pSubDef[i]);
+    }
+
+    if (ret != TRDP_NO_ERR)
+    {
+        /*    Release the sockets of the subscriptions set up so far and free all elements    */
+        while (pFirst != NULL)
+        {
+            PD_ELE_T *pNext = pFirst->pNext;
+
+            if (pFirst->magic == TRDP_MAGIC_SUB_HNDL_VALUE)
+            {
+                trdp_releaseSocket(appHandle->ifacePD, pFirst->socketIdx, 0u, FALSE, pFirst->addr.mcGroup);
+                pFirst->magic = 0u;
             }
-        } /*lint !e438 unused newPD */
+            trdp_pdFreeElement(pFirst);
+            pFirst = pNext;
+        }
+    }
+    else
+    {
+        PD_ELE_T * *ppLast = &appHandle->pRcvQueue;
+
+        for (i = 0u, pIter = pFirst; i < noOfSub; i++, pIter = pIter->pNext)
+        {
+            pSubDef[i].subHandle = (TRDP_SUB_T) pIter;
+        }
+
+        /*  append these subscriptions to our receive queue */
+        while (*ppLast != NULL)
+        {
+            ppLast = &(*ppLast)->pNext;
+        }
+        *ppLast = pFirst;
+
+#ifdef HIGH_PERF_INDEXED
+        /*    Index tables already in use (tlc_updateSession was called)? Include the new subscriptions    */
+        if ((appHandle->pSlot != NULL) && (appHandle->pSlot->processCycle != 0u))
+        {
+            ret = trdp_indexCreateSubTables(appHandle);
+        }
+#endif
     }
 
     if (vos_mutexUnlock(appHandle->mutexRxPD) != VOS_NO_ERR)
@@ -1640,25 +2188,12 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutexRxPD);
     if (ret == TRDP_NO_ERR)
     {
-        TRDP_IP_ADDR_T mcGroup = pElement->addr.mcGroup;
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pRcvQueue, pElement);
-        /*    if we subscribed to an MC-group, check if anyone else did too: */
-        if (mcGroup != VOS_INADDR_ANY)
-        {
-            mcGroup = trdp_findMCjoins(appHandle, mcGroup);
-        }
-        trdp_releaseSocket(appHandle->ifacePD, pElement->socketIdx, 0u, FALSE, mcGroup);
+        /*    the socket leaves an MC-group with its last subscriber    */
+        trdp_releaseSocket(appHandle->ifacePD, pElement->socketIdx, 0u, FALSE, pElement->addr.mcGroup);
         pElement->magic = 0u;
-        if (pElement->pFrame != NULL)
-        {
-            vos_memFree(pElement->pFrame);
-        }
-        if (pElement->pSeqCntList != NULL)
-        {
-            vos_memFree(pElement->pSeqCntList);
-        }
-        vos_memFree(pElement);
+        trdp_pdFreeElement(pElement);
 
 #ifdef HIGH_PERF_INDEXED
         /* We must check if this publisher is listed in our indexed arrays */
@@ -1905,6 +2440,8 @@ EXT_DECL TRDP_ERR_T tlp_get (
 				pPdInfo->replyIpAddr    = vos_ntohl(pElement->pFrame->frameHead.replyIpAddress);
 				pPdInfo->pUserRef       = pElement->pUserRef;
 				pPdInfo->resultCode     = ret;
+				pPdInfo->rxTime         = pElement->rxTime;
+				pPdInfo->rxTimeSource   = pElement->rxTimeSource;
 			}
         }
 
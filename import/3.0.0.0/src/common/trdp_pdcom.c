@@ -121,6 +121,256 @@
  *   GLOBALS
  */
 
+/******************************************************************************
+ *   LOCAL FUNCTIONS
+ */
+
+/******************************************************************************/
+/** Read the pending transmit time stamps of a PD socket
+ *  Each stamp is matched by its number to the publisher waiting for it in the socket's stamp slots.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      socketIdx           index of the socket
+ */
+static void trdp_pdReadTxStamps (
+    TRDP_SESSION_PT appHandle,
+    INT32           socketIdx)
+{
+    UINT32      id;
+    TRDP_TIME_T txTime;
+    PD_ELE_T    **ppSlot;
+
+    while (vos_sockReceiveTxTime(appHandle->ifacePD[socketIdx].sock, &id, &txTime, NULL) == VOS_NO_ERR)
+    {
+        ppSlot = &appHandle->ifacePD[socketIdx].pTxTsPending[id % TRDP_TX_STAMP_SLOTS];
+        /* A slot is only taken by a publisher waiting for a stamp, but the stamp may be an overwritten one */
+        if ((*ppSlot != NULL) && ((*ppSlot)->txTsId == id))
+        {
+            (*ppSlot)->privFlags = (TRDP_PRIV_FLAGS_T) ((*ppSlot)->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_TX_STAMP);
+            trdp_pdRecordTxLatency(*ppSlot, &txTime);
+            *ppSlot = NULL;
+        }
+    }
+}
+
+/******************************************************************************/
+/** Remember a sent PD for its transmit time stamp (TRDP_OPTION_TIMESTAMPING)
+ *  The kernel numbers the stamps of a socket in sending order; a stamp not read before the next sending of the
+ *  same publisher, or before TRDP_TX_STAMP_SLOTS further stamped sendings on the socket, is lost
+ *  (e.g. if the interface does not stamp at all).
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSentPD             publisher just sent
+ *  @param[in]      pSendStart          time before the send call
+ */
+static void trdp_pdTxStamp (
+    TRDP_SESSION_PT     appHandle,
+    PD_ELE_T            *pSentPD,
+    const TRDP_TIME_T   *pSendStart)
+{
+    PD_ELE_T **ppSlot;
+
+    if (!(appHandle->option & TRDP_OPTION_TIMESTAMPING))
+    {
+        return;
+    }
+    /* Late stamp of the previous sending? */
+    if (pSentPD->privFlags & TRDP_TX_STAMP)
+    {
+        trdp_pdReadTxStamps(appHandle, pSentPD->socketIdx);
+        trdp_pdTxStampCancel(appHandle, pSentPD);
+    }
+    pSentPD->txTsId     = appHandle->ifacePD[pSentPD->socketIdx].txTsCnt++;
+    pSentPD->txTsStart  = *pSendStart;
+    ppSlot = &appHandle->ifacePD[pSentPD->socketIdx].pTxTsPending[pSentPD->txTsId % TRDP_TX_STAMP_SLOTS];
+    if (*ppSlot != NULL)
+    {
+        trdp_pdTxStampCancel(appHandle, *ppSlot);
+    }
+    *ppSlot = pSentPD;
+    pSentPD->privFlags  |= TRDP_TX_STAMP;
+    /* Software stamps are usually taken within the send call */
+    trdp_pdReadTxStamps(appHandle, pSentPD->socketIdx);
+}
+
+/******************************************************************************/
+/** Launch time of a due cyclic PD (TRDP_OPTION_TXTIME)
+ *  The packet is handed to the kernel when due and leaves one interval later, at the send time of the next cycle.
+ *  Its data is one interval older on the wire, but the scheduling jitter of the stack does not reach the wire.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSendPD             publisher due to be sent
+ *  @param[out]     pLaunchTime         launch time
+ *
+ *  @retval         pLaunchTime         send at pLaunchTime
+ *  @retval         NULL                send at once (option not set, no cycle, requested packet)
+ */
+static const TRDP_TIME_T *trdp_pdLaunchTime (
+    TRDP_SESSION_PT appHandle,
+    const PD_ELE_T  *pSendPD,
+    TRDP_TIME_T     *pLaunchTime)
+{
+    if (!(appHandle->option & TRDP_OPTION_TXTIME) ||
+        !timerisset(&pSendPD->interval) ||
+        (pSendPD->privFlags & TRDP_REQ_2B_SENT))
+    {
+        return NULL;
+    }
+    *pLaunchTime = pSendPD->timeToGo;
+    vos_addTime(pLaunchTime, &pSendPD->interval);
+    return pLaunchTime;
+}
+
+/******************************************************************************/
+/** Destination of a PD to be sent: the requester of a pulled packet (once) or the publisher's destination
+ *
+ *  @param[in]      pPacket             packet to be sent
+ *
+ *  @retval         destination IP
+ */
+static UINT32 trdp_pdDestIp (
+    PD_ELE_T *pPacket)
+{
+    UINT32 destIp = pPacket->addr.destIpAddr;
+
+    /*  check for temporary address (PD PULL):  */
+    if (pPacket->pullIpAddress != 0u)
+    {
+        destIp = pPacket->pullIpAddress;
+        pPacket->pullIpAddress = 0u;
+    }
+    return destIp;
+}
+
+#ifdef IO_URING_SUPPORT
+/******************************************************************************/
+/** Queue a PD on the session's ring (tlc_processRing())
+ *  The frame is read when the ring is submitted after the send queue was done, so only packets which stay
+ *  unchanged until then are queued (cyclic, not requested). The packet is counted and stamped by trdp_pdRingSent().
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             packet to be sent
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         ring full
+ */
+static TRDP_ERR_T trdp_pdSendRing (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket)
+{
+    pPacket->sendSize = pPacket->grossSize;
+    if (vos_ringSendUDP(appHandle->ring,
+                        appHandle->ifacePD[pPacket->socketIdx].sock,
+                        (UINT8 *)&pPacket->pFrame->frameHead,
+                        pPacket->grossSize,
+                        trdp_pdDestIp(pPacket),
+                        appHandle->pdDefault.port) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_DBG, "trdp_pdSendRing failed\n");
+        return TRDP_IO_ERR;
+    }
+    pPacket->ringQueued = TRUE;
+    return TRDP_NO_ERR;
+}
+#endif
+
+/******************************************************************************/
+/** Allocate PD elements in blocks of up to TRDP_PD_ARENA_SIZE bytes
+ *  Used to set up many publishers or subscribers at once. The elements are zeroed and linked by pNext in
+ *  ascending order. A block is freed with its last element (trdp_pdFreeElement).
+ *
+ *  @param[in]      noOfElements    number of elements, > 0
+ *
+ *  @retval         != NULL         first element of the list
+ *  @retval         NULL            out of memory
+ */
+PD_ELE_T *trdp_pdAllocElements (
+    UINT32 noOfElements)
+{
+    PD_ELE_T    *pFirst     = NULL;
+    PD_ELE_T    * *ppLast   = &pFirst;
+    UINT32      perArena    = (TRDP_PD_ARENA_SIZE - sizeof(PD_ARENA_T)) / sizeof(PD_ELE_T) + 1u;
+
+    while (noOfElements > 0u)
+    {
+        UINT32      noInArena = (noOfElements < perArena) ? noOfElements : perArena;
+        UINT32      i;
+        PD_ARENA_T  *pArena = (PD_ARENA_T *) vos_memAlloc(sizeof(PD_ARENA_T) +
+                                                          (noInArena - 1u) * sizeof(PD_ELE_T));
+        if (pArena == NULL)
+        {
+            while (pFirst != NULL)
+            {
+                PD_ELE_T *pNext = pFirst->pNext;
+
+                trdp_pdFreeElement(pFirst);
+                pFirst = pNext;
+            }
+            return NULL;
+        }
+        pArena->noOfUsers = noInArena;
+        for (i = 0u; i < noInArena; i++)
+        {
+            pArena->element[i].pArena = pArena;
+            *ppLast = &pArena->element[i];
+            ppLast  = &pArena->element[i].pNext;
+        }
+        noOfElements -= noInArena;
+    }
+    return pFirst;
+}
+
+/******************************************************************************/
+/** Free a PD element with its frame and sequence counter list
+ *  An element of a block (trdp_pdAllocElements) frees the block with the last of its elements.
+ *
+ *  @param[in]      pElement        pointer to the element, already removed from its queue
+ */
+void    trdp_pdFreeElement (
+    PD_ELE_T *pElement)
+{
+    if (pElement->pSeqCntList != NULL)
+    {
+        vos_memFree(pElement->pSeqCntList);
+    }
+    if (pElement->pFrame != NULL)
+    {
+        vos_memFree(pElement->pFrame);
+    }
+    if (pElement->pArena == NULL)
+    {
+        vos_memFree(pElement);
+    }
+    else if (--pElement->pArena->noOfUsers == 0u)
+    {
+        vos_memFree(pElement->pArena);
+    }
+}
+
+/******************************************************************************/
+/** Stop waiting for the transmit time stamp of a publisher
+ *  Must be called before a publisher with a pending stamp is sent again or freed.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPD                 publisher
+ */
+void trdp_pdTxStampCancel (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPD)
+{
+    PD_ELE_T **ppSlot;
+
+    if (pPD->privFlags & TRDP_TX_STAMP)
+    {
+        ppSlot = &appHandle->ifacePD[pPD->socketIdx].pTxTsPending[pPD->txTsId % TRDP_TX_STAMP_SLOTS];
+        if (*ppSlot == pPD)
+        {
+            *ppSlot = NULL;
+        }
+        pPD->privFlags = (TRDP_PRIV_FLAGS_T) (pPD->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_TX_STAMP);
+    }
+}
+
 /******************************************************************************/
 /** Initialize/construct the packet
  *  Set the header infos
@@ -353,8 +603,11 @@ TRDP_ERR_T  trdp_pdSendImmediate (
     else
     {
 
+        TRDP_TIME_T sendStart;
+
         pSendPD->sendSize = pSendPD->grossSize;
 
+        vos_getTime(&sendStart);
         err = (TRDP_ERR_T) vos_sockSendUDP(appHandle->ifacePD[pSendPD->socketIdx].sock,
                                            (UINT8 *)&pFrame->frameHead,
                                            &pSendPD->sendSize,
@@ -365,6 +618,7 @@ TRDP_ERR_T  trdp_pdSendImmediate (
         {
             appHandle->stats.pd.numSend++;
             pSendPD->numRxTx++;
+            trdp_pdTxStamp(appHandle, pSendPD, &sendStart);
         }
     }
 
@@ -474,7 +728,9 @@ TRDP_ERR_T  trdp_pdSendElement (
         /*    Send the packet if it is not redundant    */
         else if (!(iterPD->privFlags & TRDP_REDUNDANT))
         {
-            TRDP_ERR_T result;
+            TRDP_ERR_T  result;
+            TRDP_TIME_T sendTime;
+
             if (iterPD->pfCbFunction != NULL)
             {
                 TRDP_PD_INFO_T theMessage;
@@ -498,11 +754,17 @@ TRDP_ERR_T  trdp_pdSendElement (
                                      vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
             }
             /* We pass the error to the application, but we keep on going    */
-            result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
+            vos_getTime(&sendTime);
+            result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port, NULL);
             if (result == TRDP_NO_ERR)
             {
                 appHandle->stats.pd.numSend++;
                 iterPD->numRxTx++;
+                if (!(iterPD->privFlags & TRDP_REQ_2B_SENT) && timerisset(&iterPD->interval))
+                {
+                    trdp_pdRecordTxTiming(iterPD, &sendTime);
+                }
+                trdp_pdTxStamp(appHandle, iterPD, &sendTime);
             }
             else
             {
@@ -554,13 +816,9 @@ TRDP_ERR_T  trdp_pdSendElement (
         pTemp = iterPD->pNext;
         /* Remove current element */
         trdp_queueDelElement(&appHandle->pSndQueue, iterPD);
+        trdp_pdTxStampCancel(appHandle, iterPD);
         iterPD->magic = 0u;
-        if (iterPD->pSeqCntList != NULL)
-        {
-            vos_memFree(iterPD->pSeqCntList);
-        }
-        vos_memFree(iterPD->pFrame);
-        vos_memFree(iterPD);
+        trdp_pdFreeElement(iterPD);
 
         /* pre-set next element */
         *ppElement = pTemp;
@@ -638,7 +896,11 @@ TRDP_ERR_T  trdp_pdSendQueued (
                 /*    Send the packet if it is not redundant    */
                 else if (!(iterPD->privFlags & TRDP_REDUNDANT))
                 {
-                    TRDP_ERR_T result;
+                    TRDP_ERR_T          result;
+                    TRDP_TIME_T         sendStart;
+                    TRDP_TIME_T         launchTime;
+                    const TRDP_TIME_T   *pLaunchTime;
+
                     if (iterPD->pfCbFunction != NULL)
                     {
                         TRDP_PD_INFO_T theMessage;
@@ -662,11 +924,34 @@ TRDP_ERR_T  trdp_pdSendQueued (
                                              vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
                     }
                     /* We pass the error to the application, but we keep on going    */
-                    result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
+                    pLaunchTime = trdp_pdLaunchTime(appHandle, iterPD, &launchTime);
+                    vos_getTime(&sendStart);
+#ifdef IO_URING_SUPPORT
+                    if ((appHandle->ring != NULL) && (pLaunchTime == NULL) &&
+                        !(iterPD->privFlags & TRDP_REQ_2B_SENT))
+                    {
+                        result = trdp_pdSendRing(appHandle, iterPD);
+                    }
+                    else
+#endif
+                    {
+                        result = trdp_pdSend(appHandle->ifacePD[iterPD->socketIdx].sock, iterPD,
+                                             appHandle->pdDefault.port, pLaunchTime);
+                    }
                     if (result == TRDP_NO_ERR)
                     {
-                        appHandle->stats.pd.numSend++;
-                        iterPD->numRxTx++;
+                        if (!(iterPD->privFlags & TRDP_REQ_2B_SENT))
+                        {
+                            trdp_pdRecordTxTiming(iterPD, &now);
+                        }
+#ifdef IO_URING_SUPPORT
+                        if (!iterPD->ringQueued)
+#endif
+                        {
+                            appHandle->stats.pd.numSend++;
+                            iterPD->numRxTx++;
+                            trdp_pdTxStamp(appHandle, iterPD, (pLaunchTime != NULL) ? pLaunchTime : &sendStart);
+                        }
                     }
                     else
                     {
@@ -709,13 +994,9 @@ TRDP_ERR_T  trdp_pdSendQueued (
                 pTemp = iterPD->pNext;
                 /* Remove current element */
                 trdp_queueDelElement(&appHandle->pSndQueue, iterPD);
+                trdp_pdTxStampCancel(appHandle, iterPD);
                 iterPD->magic = 0u;
-                if (iterPD->pSeqCntList != NULL)
-                {
-                    vos_memFree(iterPD->pSeqCntList);
-                }
-                vos_memFree(iterPD->pFrame);
-                vos_memFree(iterPD);
+                trdp_pdFreeElement(iterPD);
 
                 /* pre-set next element */
                 iterPD = pTemp;
@@ -728,15 +1009,19 @@ TRDP_ERR_T  trdp_pdSendQueued (
 }
 
 /******************************************************************************/
-/** Receiving PD messages
- *  Read the receive socket for arriving PDs, copy the packet to a new PD_ELE_T
+/** Handle a received PD frame (in appHandle->pNewFrame)
  *  Check for protocol errors and compare the received data to the data in our receive queue.
  *  If it is a new packet, check if it is a PD Request (PULL).
  *  If it is an update, exchange the existing entry with the new one
  *  Call user's callback if needed
  *
  *  @param[in]      appHandle           session pointer
- *  @param[in]      sock                the socket to read from
+ *  @param[in]      recSize             size of the frame
+ *  @param[in]      srcIpAddr           source IP
+ *  @param[in]      destIpAddr          destination IP
+ *  @param[in]      srcIfAddr           IP of the receiving interface (#322)
+ *  @param[in]      pRcvTime            receive time
+ *  @param[in]      rcvTimeSource       source of the receive time
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
@@ -745,34 +1030,27 @@ TRDP_ERR_T  trdp_pdSendQueued (
  *  @retval         TRDP_CRC_ERR        header checksum
  *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
  */
-TRDP_ERR_T  trdp_pdReceive (
-    TRDP_SESSION_PT appHandle,
-    VOS_SOCK_T      sock)
+static TRDP_ERR_T  trdp_pdReceived (
+    TRDP_SESSION_PT     appHandle,
+    UINT32              recSize,
+    TRDP_IP_ADDR_T      srcIpAddr,
+    TRDP_IP_ADDR_T      destIpAddr,
+    UINT32              srcIfAddr,
+    const TRDP_TIME_T   *pRcvTime,
+    UINT8               rcvTimeSource)
 {
     PD_HEADER_T         *pNewFrameHead      = &appHandle->pNewFrame->frameHead;
     PD_ELE_T            *pExistingElement   = NULL;
     PD_ELE_T            *pPulledElement     = NULL;
     TRDP_ERR_T          err             = TRDP_NO_ERR;
-    UINT32              recSize         = TRDP_MAX_PD_PACKET_SIZE;
     int                 informUser      = FALSE;
     int                 isTSN           = FALSE;
     TRDP_ADDRESSES_T    subAddresses    = { 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u};
-    UINT32              srcIfAddr = 0u;
     TRDP_MSG_T          msgType;
+    TRDP_TIME_T         rcvTime         = *pRcvTime;
 
-    /*  Get the packet from the wire:  */
-    err = (TRDP_ERR_T) vos_sockReceiveUDP(sock,
-                                          (UINT8 *) pNewFrameHead,
-                                          &recSize,
-                                          &subAddresses.srcIpAddr,
-                                          NULL,
-                                          &subAddresses.destIpAddr,
-                                          &srcIfAddr,   /* #322 */
-                                          FALSE);
-    if ( err != TRDP_NO_ERR)
-    {
-        return err;
-    }
+    subAddresses.srcIpAddr  = srcIpAddr;
+    subAddresses.destIpAddr = destIpAddr;
 
     /* Ticket #322 Subscriber multicast message routing in multi-home device */
     if ((appHandle->realIP != 0u) && (srcIfAddr != 0) && (appHandle->realIP != srcIfAddr))
@@ -897,7 +1175,7 @@ TRDP_ERR_T  trdp_pdReceive (
             /* find sender in our list */
             switch (trdp_checkSequenceCounter(pExistingElement,
                                               newSeqCnt,
-                                              subAddresses.srcIpAddr, msgType))
+                                              subAddresses.srcIpAddr, msgType, &rcvTime))
             {
                 case 0:                      /* Sequence counter is valid (at least 1 higher than previous one) */
                     break;
@@ -951,9 +1229,12 @@ TRDP_ERR_T  trdp_pdReceive (
                 }
             }
 
-            /*  Get the current time and compute the next time this packet should be received.  */
-            vos_getTime(&pExistingElement->timeToGo);
+            /*  Compute the next time this packet should be received.  */
+            pExistingElement->timeToGo = rcvTime;
             vos_addTime(&pExistingElement->timeToGo, &pExistingElement->interval);
+            trdp_pdRecordRxTiming(pExistingElement, &rcvTime);
+            pExistingElement->rxTime        = rcvTime;
+            pExistingElement->rxTimeSource  = rcvTimeSource;
 
             /*  Update some statistics  */
             pExistingElement->numRxTx++;
@@ -1077,6 +1358,10 @@ TRDP_ERR_T  trdp_pdReceive (
             theMessage.seqCount     = pExistingElement->curSeqCnt;
             theMessage.pUserRef     = pExistingElement->pUserRef; /* User reference given with the local subscribe? */
             theMessage.resultCode   = err;
+            theMessage.rxTime       = rcvTime;
+            theMessage.rxTimeSource = rcvTimeSource;
+
+            trdp_pdRecordCbLatency(pExistingElement, &rcvTime);
 
 #ifdef TSN_SUPPORT
             if (TRUE == isTSN)
@@ -1113,6 +1398,53 @@ TRDP_ERR_T  trdp_pdReceive (
     return err;
 }
 
+/******************************************************************************/
+/** Receiving PD messages
+ *  Read the receive socket for arriving PDs, copy the packet to a new PD_ELE_T
+ *  Check for protocol errors and compare the received data to the data in our receive queue.
+ *  If it is a new packet, check if it is a PD Request (PULL).
+ *  If it is an update, exchange the existing entry with the new one
+ *  Call user's callback if needed
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      sock                the socket to read from
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_WIRE_ERR       protocol error (late packet, version mismatch)
+ *  @retval         TRDP_QUEUE_ERR      not in queue
+ *  @retval         TRDP_CRC_ERR        header checksum
+ *  @retval         TRDP_TOPOCOUNT_ERR  invalid topocount
+ */
+TRDP_ERR_T  trdp_pdReceive (
+    TRDP_SESSION_PT appHandle,
+    VOS_SOCK_T      sock)
+{
+    TRDP_ERR_T      err;
+    UINT32          recSize         = TRDP_MAX_PD_PACKET_SIZE;
+    TRDP_IP_ADDR_T  srcIpAddr       = 0u;
+    TRDP_IP_ADDR_T  destIpAddr      = 0u;
+    UINT32          srcIfAddr       = 0u;
+    TRDP_TIME_T     rcvTime;
+    UINT8           rcvTimeSource   = TRDP_TIMESTAMP_APP;
+
+    /*  Get the packet from the wire (kernel receive time if TRDP_OPTION_TIMESTAMPING):  */
+    err = (TRDP_ERR_T) vos_sockReceiveUDPTs(sock,
+                                            (UINT8 *) &appHandle->pNewFrame->frameHead,
+                                            &recSize,
+                                            &srcIpAddr,
+                                            NULL,
+                                            &destIpAddr,
+                                            &srcIfAddr, /* #322 */
+                                            &rcvTime,
+                                            &rcvTimeSource);
+    if ( err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+    return trdp_pdReceived(appHandle, recSize, srcIpAddr, destIpAddr, srcIfAddr, &rcvTime, rcvTimeSource);
+}
+
 /******************************************************************************/
 /** Check for pending packets, set FD if non blocking
  *
@@ -1146,6 +1478,9 @@ void trdp_pdCheckPending (
 
         /*    Check and set the socket file descriptor, if not already done    */
         if (iterPD->socketIdx != -1 &&
+#ifdef PACKET_MMAP_SUPPORT
+            appHandle->pktRing == NULL &&                           /* the ring receives for all sockets */
+#endif
             appHandle->ifacePD[iterPD->socketIdx].sock != VOS_INVALID_SOCKET &&
             !VOS_FD_ISSET(appHandle->ifacePD[iterPD->socketIdx].sock, (VOS_FDS_T *)pFileDesc))     /*lint !e573 !e505
                                                                                           signed/unsigned division in macro /
@@ -1164,6 +1499,19 @@ void trdp_pdCheckPending (
         }
     }
 
+#ifdef PACKET_MMAP_SUPPORT
+    if ((appHandle->pktRing != NULL) && (appHandle->pRcvQueue != NULL))
+    {
+        VOS_SOCK_T ringSock = vos_pktRingGetSocket(appHandle->pktRing);
+
+        VOS_FD_SET(ringSock, (VOS_FDS_T *)pFileDesc);       /*lint !e573 !e505 signed/unsigned division in macro */
+        if ((vos_sockCmp(ringSock, *pNoDesc) == 1) || (*pNoDesc == VOS_INVALID_SOCKET))
+        {
+            *pNoDesc = ringSock;
+        }
+    }
+#endif
+
     if (checkSend)
     {
         /*    Find packet in send queue which evntually has to be sent earlier:    */
@@ -1277,6 +1625,50 @@ void trdp_handleTimeout (
     }
 }
 
+#ifdef PACKET_MMAP_SUPPORT
+/**********************************************************************************************************************/
+/** Handle the PDs in the session's packet ring (TRDP_OPTION_PACKET_RING)
+ *  Call user's callback if needed
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_TOPO_ERR       invalid topocount of a received packet
+ */
+static TRDP_ERR_T trdp_pdReceivePacketRing (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_ERR_T      result = TRDP_NO_ERR;
+    TRDP_ERR_T      err;
+    UINT32          recSize         = TRDP_MAX_PD_PACKET_SIZE;
+    TRDP_IP_ADDR_T  srcIpAddr;
+    UINT16          srcIpPort;
+    TRDP_IP_ADDR_T  destIpAddr;
+    UINT32          srcIfAddr;
+    TRDP_TIME_T     rcvTime;
+    UINT8           rcvTimeSource;
+
+    while (vos_pktRingReceiveUDP(appHandle->pktRing, (UINT8 *) &appHandle->pNewFrame->frameHead, &recSize,
+                                 &srcIpAddr, &srcIpPort, &destIpAddr, &srcIfAddr, &rcvTime,
+                                 &rcvTimeSource) == VOS_NO_ERR)
+    {
+        err = trdp_pdReceived(appHandle, recSize, srcIpAddr, destIpAddr, srcIfAddr, &rcvTime, rcvTimeSource);
+        switch (err)
+        {
+            case TRDP_NO_ERR:
+            case TRDP_NOSUB_ERR:        /* missing subscription should not lead to extensive error output */
+                break;
+            default:
+                result = err;
+                vos_printLog(VOS_LOG_WARNING, "trdp_pdReceive() failed (Err: %d)\n", err);
+                break;
+        }
+        recSize = TRDP_MAX_PD_PACKET_SIZE;
+    }
+    return result;
+}
+#endif
+
 /**********************************************************************************************************************/
 /** Checking receive connection requests and data
  *  Call user's callback if needed
@@ -1310,6 +1702,15 @@ TRDP_ERR_T   trdp_pdCheckListenSocks (
         TRDP_ERR_T  err;
         BOOL8       nonBlocking = !(appHandle->option & TRDP_OPTION_BLOCK);
 
+#ifdef PACKET_MMAP_SUPPORT
+        if ((appHandle->pktRing != NULL) &&
+            (VOS_FD_ISSET(vos_pktRingGetSocket(appHandle->pktRing), (VOS_FDS_T *) pRfds)))  /*lint !e573 */
+        {
+            result = trdp_pdReceivePacketRing(appHandle);
+            (*pCount)--;
+            VOS_FD_CLR(vos_pktRingGetSocket(appHandle->pktRing), (VOS_FDS_T *)pRfds); /*lint !e502 !e573 !e505 */
+        }
+#endif
         /*    Check and set the socket file descriptor by going thru the socket list    */
         for (idx = 0; idx < (UINT32) trdp_getCurrentMaxSocketCnt(TRDP_SOCK_PD); idx++)
         {
@@ -1355,6 +1756,83 @@ TRDP_ERR_T   trdp_pdCheckListenSocks (
     return result;
 }
 
+#ifdef IO_URING_SUPPORT
+/**********************************************************************************************************************/
+/** Handle the PDs received by the session's ring (tlc_processRing())
+ *  Call user's callback if needed
+ *
+ *  @param[in]      appHandle           session pointer
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_TOPO_ERR       invalid topocount of a received packet
+ */
+TRDP_ERR_T trdp_pdReceiveRing (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_ERR_T      result = TRDP_NO_ERR;
+    TRDP_ERR_T      err;
+    VOS_SOCK_T      sock;
+    UINT32          recSize         = TRDP_MAX_PD_PACKET_SIZE;
+    TRDP_IP_ADDR_T  srcIpAddr;
+    UINT16          srcIpPort;
+    TRDP_IP_ADDR_T  destIpAddr;
+    UINT32          srcIfAddr;
+    TRDP_TIME_T     rcvTime;
+    UINT8           rcvTimeSource;
+    UINT32          enters;
+    UINT32          sendErrors;
+
+    while (vos_ringReceiveUDP(appHandle->ring, &sock, (UINT8 *) &appHandle->pNewFrame->frameHead, &recSize,
+                              &srcIpAddr, &srcIpPort, &destIpAddr, &srcIfAddr, &rcvTime, &rcvTimeSource) == VOS_NO_ERR)
+    {
+        err = trdp_pdReceived(appHandle, recSize, srcIpAddr, destIpAddr, srcIfAddr, &rcvTime, rcvTimeSource);
+        switch (err)
+        {
+            case TRDP_NO_ERR:
+            case TRDP_NOSUB_ERR:        /* missing subscription should not lead to extensive error output */
+                break;
+            default:
+                result = err;
+                vos_printLog(VOS_LOG_WARNING, "trdp_pdReceive() failed (Err: %d)\n", err);
+                break;
+        }
+        recSize = TRDP_MAX_PD_PACKET_SIZE;
+    }
+
+    /*  Sends complete only if they failed: take them back out of the count of trdp_pdRingSent()  */
+    vos_ringGetStatistics(appHandle->ring, &enters, &sendErrors);
+    appHandle->stats.pd.numSend -= sendErrors - appHandle->ringSendErrors;
+    appHandle->ringSendErrors   = sendErrors;
+    return result;
+}
+
+/******************************************************************************/
+/** Account the PDs queued on the ring, after it was submitted
+ *  The datagrams have been handed to the sockets when vos_ringSubmit() returned, so they are counted and their
+ *  transmit stamps are expected from now on. Failed sends are taken out again by trdp_pdReceiveRing().
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pSubmitStart        time before the ring was submitted
+ */
+void trdp_pdRingSent (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pSubmitStart)
+{
+    PD_ELE_T *iterPD;
+
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if (iterPD->ringQueued)
+        {
+            iterPD->ringQueued = FALSE;
+            appHandle->stats.pd.numSend++;
+            iterPD->numRxTx++;
+            trdp_pdTxStamp(appHandle, iterPD, pSubmitStart);
+        }
+    }
+}
+#endif
+
 /******************************************************************************/
 /** Update the header values
  *
@@ -1486,24 +1964,19 @@ TRDP_ERR_T trdp_pdCheck (
  *  @param[in]      pdSock          socket descriptor
  *  @param[in]      pPacket         pointer to packet to be sent
  *  @param[in]      port            port on which to send
+ *  @param[in]      pTxTime         launch time, NULL to send at once
  *
  *  @retval         TRDP_NO_ERR
  *  @retval         TRDP_IO_ERR
  */
 TRDP_ERR_T  trdp_pdSend (
-    VOS_SOCK_T  pdSock,
-    PD_ELE_T    *pPacket,
-    UINT16      port)
+    VOS_SOCK_T          pdSock,
+    PD_ELE_T            *pPacket,
+    UINT16              port,
+    const TRDP_TIME_T   *pTxTime)
 {
     VOS_ERR_T   err     = VOS_NO_ERR;
-    UINT32      destIp  = pPacket->addr.destIpAddr;
-
-    /*  check for temporary address (PD PULL):  */
-    if (pPacket->pullIpAddress != 0u)
-    {
-        destIp = pPacket->pullIpAddress;
-        pPacket->pullIpAddress = 0u;
-    }
+    UINT32      destIp  = trdp_pdDestIp(pPacket);
 
     pPacket->sendSize = pPacket->grossSize;
 
@@ -1514,11 +1987,12 @@ TRDP_ERR_T  trdp_pdSend (
     }
 */
 
-    err = vos_sockSendUDP(pdSock,
-                          (UINT8 *)&pPacket->pFrame->frameHead,
-                          &pPacket->sendSize,
-                          destIp,
-                          port);
+    err = vos_sockSendUDPAt(pdSock,
+                            (UINT8 *)&pPacket->pFrame->frameHead,
+                            &pPacket->sendSize,
+                            destIp,
+                            port,
+                            pTxTime);
 
     if (err != VOS_NO_ERR)
     {
@@ -1539,16 +2013,178 @@ TRDP_ERR_T  trdp_pdSend (
 
 /* Note: This function is not necessary for the high performance version; see trdp_pdindex.c */
 
+/******************************************************************************/
+/** Hyperperiod of a set of publishers
+ *
+ *  Least common multiple of the send intervals, the pattern of send slots repeats after it.
+ *
+ *  @param[in]      pPackets        publishers
+ *  @param[in]      noOfPackets     number of publishers
+ *
+ *  @retval         hyperperiod in slots, at most TRDP_SHAPING_MAX_SLOTS
+ */
+UINT32 trdp_pdHyperperiod (
+    const TRDP_SHAPING_PKT_T    *pPackets,
+    UINT32                      noOfPackets)
+{
+    UINT64  hyperperiod = 1u;
+    UINT64  a, b, t;
+    UINT32  i;
+
+    for (i = 0u; i < noOfPackets; i++)
+    {
+        /* gcd by Euclid */
+        a = hyperperiod;
+        b = pPackets[i].period;
+        while (b != 0u)
+        {
+            t   = a % b;
+            a   = b;
+            b   = t;
+        }
+        hyperperiod = hyperperiod / a * pPackets[i].period;
+        if (hyperperiod > TRDP_SHAPING_MAX_SLOTS)
+        {
+            return TRDP_SHAPING_MAX_SLOTS;
+        }
+    }
+    return (UINT32) hyperperiod;
+}
+
+/******************************************************************************/
+/** Bytes sent per slot over the hyperperiod
+ *
+ *  @param[in]      pPackets        publishers
+ *  @param[in]      noOfPackets     number of publishers
+ *  @param[in]      hyperperiod     number of slots
+ *  @param[out]     pLoad           bytes per slot, hyperperiod entries
+ *
+ *  @retval         peak bytes per slot
+ */
+UINT32 trdp_pdSlotProfile (
+    const TRDP_SHAPING_PKT_T    *pPackets,
+    UINT32                      noOfPackets,
+    UINT32                      hyperperiod,
+    UINT32                      *pLoad)
+{
+    UINT32  i, slot;
+    UINT32  peak = 0u;
+
+    memset(pLoad, 0, hyperperiod * sizeof(UINT32));
+    for (i = 0u; i < noOfPackets; i++)
+    {
+        for (slot = pPackets[i].phase % hyperperiod; slot < hyperperiod; slot += pPackets[i].period)
+        {
+            pLoad[slot] += pPackets[i].size;
+        }
+    }
+    for (slot = 0u; slot < hyperperiod; slot++)
+    {
+        if (pLoad[slot] > peak)
+        {
+            peak = pLoad[slot];
+        }
+    }
+    return peak;
+}
+
+/******************************************************************************/
+/** Assign send slots to publishers
+ *
+ *  Greedy, largest telegrams first (then shortest intervals): every publisher gets the phase minimising the peak
+ *  bytes per slot of its send slots, given the publishers placed before it. Ties go to the phase closest to the
+ *  current one, so a balanced schedule is kept when publishers are added.
+ *  The publishers are sorted in place, pLoad holds the resulting profile.
+ *
+ *  @param[in,out]  pPackets        publishers, phase is set
+ *  @param[in]      noOfPackets     number of publishers
+ *  @param[in]      hyperperiod     number of slots, see trdp_pdHyperperiod()
+ *  @param[out]     pLoad           bytes per slot, hyperperiod entries
+ */
+void trdp_pdSlotSchedule (
+    TRDP_SHAPING_PKT_T  *pPackets,
+    UINT32              noOfPackets,
+    UINT32              hyperperiod,
+    UINT32              *pLoad)
+{
+    TRDP_SHAPING_PKT_T  packet;
+    UINT32              i, j, span, current, phase, slot, peak, dist;
+    UINT32              bestPhase, bestPeak, bestDist;
+
+    for (i = 1u; i < noOfPackets; i++)
+    {
+        packet = pPackets[i];
+        for (j = i; (j > 0u) &&
+             ((pPackets[j - 1u].size < packet.size) ||
+              ((pPackets[j - 1u].size == packet.size) && (pPackets[j - 1u].period > packet.period))); j--)
+        {
+            pPackets[j] = pPackets[j - 1u];
+        }
+        pPackets[j] = packet;
+    }
+
+    memset(pLoad, 0, hyperperiod * sizeof(UINT32));
+    for (i = 0u; i < noOfPackets; i++)
+    {
+        span        = (pPackets[i].period < hyperperiod) ? pPackets[i].period : hyperperiod;
+        current     = pPackets[i].phase % span;
+        bestPhase   = current;
+        bestPeak    = 0xFFFFFFFFu;
+        bestDist    = 0xFFFFFFFFu;
+        for (phase = 0u; phase < span; phase++)
+        {
+            peak = 0u;
+            for (slot = phase; slot < hyperperiod; slot += pPackets[i].period)
+            {
+                if (pLoad[slot] > peak)
+                {
+                    peak = pLoad[slot];
+                }
+            }
+            dist = (phase > current) ? (phase - current) : (current - phase);
+            if (dist > span - dist)
+            {
+                dist = span - dist;
+            }
+            if ((peak < bestPeak) || ((peak == bestPeak) && (dist < bestDist)))
+            {
+                bestPhase   = phase;
+                bestPeak    = peak;
+                bestDist    = dist;
+            }
+        }
+        pPackets[i].phase = bestPhase;
+        for (slot = bestPhase; slot < hyperperiod; slot += pPackets[i].period)
+        {
+            pLoad[slot] += pPackets[i].size;
+        }
+    }
+}
+
+/******************************************************************************/
+/** Interval of a publisher taking part in traffic shaping
+ *
+ *  @param[in]      pPacket         publisher
+ *
+ *  @retval         interval in us, 0 if PULL-only or sent more often than every 2 slots
+ */
+static UINT64 trdp_pdShapedInterval (
+    const PD_ELE_T *pPacket)
+{
+    UINT64 interval = (UINT64) pPacket->interval.tv_sec * 1000000u + (UINT64) pPacket->interval.tv_usec;
+
+    return (interval < 2u * TRDP_SHAPING_SLOT_US) ? 0u : interval;
+}
+
 /******************************************************************************/
 /** Distribute send time of PD packets over time
  *
- *  The duration of PD packets on a 100MBit/s network ranges from 3us to 150us max.
- *  Because a cyclic thread scheduling below 5ms would put a too heavy load on the system, and
- *  PD packets cannot get larger than 1432 (+ UDP header), we will not account for differences in packet size.
- *  Another factor is the differences in intervals for different packets: We should only change the
- *  starting times of the packets within 1/2 the interval time. Otherwise a late addition of packets
- *  could lead to timeouts of already queued packets.
- *  Scheduling will be computed based on the smallest interval time.
+ *  The send times are quantised to slots of TRDP_SHAPING_SLOT_US. Over the hyperperiod of all intervals the
+ *  publishers are assigned the slots minimising the peak bytes per slot (see trdp_pdSlotSchedule()), so both packet
+ *  size and interval are accounted for: a 1432 byte telegram every 10ms weighs more than a 64 byte one every 100ms.
+ *  A send time is moved by at most 1/2 its interval, the gap between two sends of a packet stays within 1/2 and 3/2
+ *  the interval. Otherwise a late addition of packets could lead to timeouts of already queued packets.
+ *  Packets sent more often than every 2 slots are left alone: the slot grid cannot move them within that bound.
  *
  *  @param[in]      pSndQueue       pointer to send queue
  *
@@ -1557,13 +2193,14 @@ TRDP_ERR_T  trdp_pdSend (
 TRDP_ERR_T  trdp_pdDistribute (
     PD_ELE_T *pSndQueue)
 {
-    PD_ELE_T    *pPacket    = pSndQueue;
-    TRDP_TIME_T deltaTmax   = {1000u, 0}; /*    Preset to highest value    */
-    TRDP_TIME_T tNull       = {0u, 0};
-    TRDP_TIME_T temp        = {0u, 0};
-    TRDP_TIME_T nextTime2Go;
-    UINT32      noOfPackets = 0u;
-    UINT32      packetIndex = 0u;
+    PD_ELE_T            *pPacket    = pSndQueue;
+    TRDP_SHAPING_PKT_T  *pPackets;
+    UINT32              *pLoad;
+    UINT64              tNull       = 0xFFFFFFFFFFFFFFFFull;
+    UINT64              timeToGo, offset, interval;
+    INT64               shift;
+    UINT32              noOfPackets = 0u;
+    UINT32              hyperperiod, peakBefore, peak, current, i;
 
     if (pSndQueue == NULL)
     {
@@ -1576,25 +2213,16 @@ TRDP_ERR_T  trdp_pdDistribute (
         return TRDP_NO_ERR;
     }
 
-    /*
-        Find delta tmax - the maximum time for which we will distribute the packets and the number of packets
-        to send within that time. Equals the smallest interval of any PD.
-        Find the next packet send time, as well.
-    */
-
+    /*  Count the cyclic packets and find the earliest send time as reference   */
     while (pPacket)
     {
-        /*  Do not count PULL-only packets!  */
-        if ((pPacket->interval.tv_sec != 0u) ||
-            (pPacket->interval.tv_usec != 0))
+        /*  Do not count PULL-only packets and packets below 2 slots!  */
+        if (trdp_pdShapedInterval(pPacket) != 0u)
         {
-            if (vos_cmpTime(&deltaTmax, &pPacket->interval) > 0)
+            timeToGo = (UINT64) pPacket->timeToGo.tv_sec * 1000000u + (UINT64) pPacket->timeToGo.tv_usec;
+            if (timeToGo < tNull)
             {
-                deltaTmax = pPacket->interval;
-            }
-            if (vos_cmpTime(&tNull, &pPacket->timeToGo) < 0)
-            {
-                tNull = pPacket->timeToGo;
+                tNull = timeToGo;
             }
             noOfPackets++;
         }
@@ -1602,57 +2230,88 @@ TRDP_ERR_T  trdp_pdDistribute (
     }
 
     /*  Sanity check  */
-    if ((vos_cmpTime(&deltaTmax, &temp) == 0) ||
-        (noOfPackets == 0))
+    if (noOfPackets < 2u)
     {
-        vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: no minimal interval in %d packets found!\n", noOfPackets);
+        vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: %u cyclic packets, nothing to distribute\n", noOfPackets);
         return TRDP_NO_ERR;     /* Ticket #14: Nothing to shape is not an error */
     }
 
-    /*  This is the delta time we can jitter...   */
-    vos_divTime(&deltaTmax, noOfPackets);
-
-    vos_printLog(VOS_LOG_INFO,
-                 "trdp_pdDistribute: deltaTmax   = %ld.%06u\n",
-                 (long) deltaTmax.tv_sec,
-                 (unsigned int)deltaTmax.tv_usec);
-    vos_printLog(VOS_LOG_INFO,
-                 "trdp_pdDistribute: tNull       = %ld.%06u\n",
-                 (long) tNull.tv_sec,
-                 (unsigned int)tNull.tv_usec);
-    vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: noOfPackets = %d\n", noOfPackets);
+    pPackets = (TRDP_SHAPING_PKT_T *) vos_memAlloc(noOfPackets * sizeof(TRDP_SHAPING_PKT_T));
+    if (pPackets == NULL)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "trdp_pdDistribute: out of memory, send times unchanged\n");
+        return TRDP_NO_ERR;
+    }
 
-    for ((void)(packetIndex = 0), pPacket = pSndQueue; packetIndex < noOfPackets && pPacket != NULL; )
+    for ((void)(i = 0u), pPacket = pSndQueue; i < noOfPackets && pPacket != NULL; pPacket = pPacket->pNext)
     {
-        /*  Ignore PULL-only packets!  */
-        if ((pPacket->interval.tv_sec != 0u) ||
-            (pPacket->interval.tv_usec != 0))
+        interval = trdp_pdShapedInterval(pPacket);
+        if (interval != 0u)
         {
-            nextTime2Go = tNull;
-            temp        = deltaTmax;
-            vos_mulTime(&temp, packetIndex);
+            timeToGo = (UINT64) pPacket->timeToGo.tv_sec * 1000000u + (UINT64) pPacket->timeToGo.tv_usec;
+            pPackets[i].period  = (UINT32) ((interval + TRDP_SHAPING_SLOT_US / 2u) / TRDP_SHAPING_SLOT_US);
+            pPackets[i].size    = pPacket->grossSize;
+            pPackets[i].phase   = (UINT32) (((timeToGo - tNull) / TRDP_SHAPING_SLOT_US) % pPackets[i].period);
+            pPackets[i].pRef    = pPacket;
+            i++;
+        }
+    }
 
-            vos_addTime(&nextTime2Go, &temp);
-            vos_mulTime(&temp, 2u);
+    hyperperiod = trdp_pdHyperperiod(pPackets, noOfPackets);
+    pLoad       = (UINT32 *) vos_memAlloc(hyperperiod * sizeof(UINT32));
+    if (pLoad == NULL)
+    {
+        vos_memFree(pPackets);
+        vos_printLogStr(VOS_LOG_WARNING, "trdp_pdDistribute: out of memory, send times unchanged\n");
+        return TRDP_NO_ERR;
+    }
 
-            if (vos_cmpTime(&temp, &pPacket->interval) > 0)
-            {
-                vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: packet [%d] with interval %lu.%06u could timeout...\n",
-                             packetIndex, (long) temp.tv_sec, (unsigned int)temp.tv_usec);
-                vos_printLogStr(VOS_LOG_INFO, "...no change in send time!\n");
-            }
-            else
-            {
-                pPacket->timeToGo = nextTime2Go;
-                vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: nextTime2Go[%d] = %lu.%06u\n",
-                             packetIndex, (unsigned long) nextTime2Go.tv_sec, (unsigned int)nextTime2Go.tv_usec);
+    peakBefore = trdp_pdSlotProfile(pPackets, noOfPackets, hyperperiod, pLoad);
+    trdp_pdSlotSchedule(pPackets, noOfPackets, hyperperiod, pLoad);
 
-            }
-            packetIndex++;
+    peak = 0u;
+    for (i = 0u; i < hyperperiod; i++)
+    {
+        if (pLoad[i] > peak)
+        {
+            peak = pLoad[i];
         }
-        pPacket = pPacket->pNext;
     }
 
+    /*  Move every packet to the start of its scheduled slot, by at most 1/2 its interval   */
+    for (i = 0u; i < noOfPackets; i++)
+    {
+        pPacket     = (PD_ELE_T *) pPackets[i].pRef;
+        interval    = trdp_pdShapedInterval(pPacket);
+        timeToGo    = (UINT64) pPacket->timeToGo.tv_sec * 1000000u + (UINT64) pPacket->timeToGo.tv_usec;
+        offset      = timeToGo - tNull;
+        current     = (UINT32) ((offset / TRDP_SHAPING_SLOT_US) % pPackets[i].period);
+        shift       = (INT64) ((pPackets[i].phase + pPackets[i].period - current) % pPackets[i].period);
+        if (2 * shift > (INT64) pPackets[i].period)
+        {
+            shift -= (INT64) pPackets[i].period;
+        }
+        /*  To the slot start, but not by more than 1/2 the interval (the period may be rounded up)  */
+        shift = shift * (INT64) TRDP_SHAPING_SLOT_US - (INT64) (offset % TRDP_SHAPING_SLOT_US);
+        if (2 * shift > (INT64) interval)
+        {
+            shift = (INT64) (interval / 2u);
+        }
+        else if (-2 * shift > (INT64) interval)
+        {
+            shift = -(INT64) (interval / 2u);
+        }
+        timeToGo = (UINT64) ((INT64) timeToGo + shift);
+        pPacket->timeToGo.tv_sec    = timeToGo / 1000000u;
+        pPacket->timeToGo.tv_usec   = timeToGo % 1000000u;
+    }
+
+    vos_printLog(VOS_LOG_INFO,
+                 "trdp_pdDistribute: %u packets, hyperperiod %u ms, peak %u -> %u bytes per slot\n",
+                 noOfPackets, hyperperiod * TRDP_SHAPING_SLOT_US / 1000u, peakBefore, peak);
+
+    vos_memFree(pLoad);
+    vos_memFree(pPackets);
     return TRDP_NO_ERR;
 }
 #endif
@@ -44,15 +44,36 @@
  * DEFINES
  */
 
+#define TRDP_SHAPING_SLOT_US        1000u   /**< Traffic shaping: send slot of 1 ms                             */
+#define TRDP_SHAPING_MAX_SLOTS      5000u   /**< Traffic shaping: longest hyperperiod considered (5 s)          */
 
 /*******************************************************************************
  * TYPEDEFS
  */
 
+/** Publisher as seen by the traffic shaping slot scheduler, times in slots of TRDP_SHAPING_SLOT_US */
+typedef struct
+{
+    UINT32  period;                     /**< send interval in slots, at least 1                             */
+    UINT32  size;                       /**< bytes per telegram                                             */
+    UINT32  phase;                      /**< send slot within the period (in: current, out: scheduled)      */
+    void    *pRef;                      /**< caller's reference, e.g. the PD_ELE_T                          */
+} TRDP_SHAPING_PKT_T;
+
 /*******************************************************************************
  * GLOBAL FUNCTIONS
  */
 
+PD_ELE_T    *trdp_pdAllocElements (
+    UINT32 noOfElements);
+
+void        trdp_pdFreeElement (
+    PD_ELE_T *pElement);
+
+void        trdp_pdTxStampCancel (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPD);
+
 void trdp_pdInit(
     PD_ELE_T *,
     TRDP_MSG_T,
@@ -78,9 +99,10 @@ TRDP_ERR_T trdp_pdCheck (
     int         *pIsTSN);
 
 TRDP_ERR_T trdp_pdSend (
-    VOS_SOCK_T  pdSock,
-    PD_ELE_T    *pPacket,
-    UINT16      port);
+    VOS_SOCK_T          pdSock,
+    PD_ELE_T            *pPacket,
+    UINT16              port,
+    const TRDP_TIME_T   *pTxTime);
 
 TRDP_ERR_T trdp_pdGet (
     PD_ELE_T            *pPacket,
@@ -128,9 +150,35 @@ TRDP_ERR_T  trdp_pdCheckListenSocks (
     TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
     INT32           *pCount);
+
+#ifdef IO_URING_SUPPORT
+TRDP_ERR_T  trdp_pdReceiveRing (
+    TRDP_SESSION_PT appHandle);
+
+void        trdp_pdRingSent (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TIME_T   *pSubmitStart);
+#endif
+
 #ifndef HIGH_PERF_INDEXED
 TRDP_ERR_T trdp_pdDistribute (
     PD_ELE_T *pSndQueue);
+
+UINT32      trdp_pdHyperperiod (
+    const TRDP_SHAPING_PKT_T    *pPackets,
+    UINT32                      noOfPackets);
+
+UINT32      trdp_pdSlotProfile (
+    const TRDP_SHAPING_PKT_T    *pPackets,
+    UINT32                      noOfPackets,
+    UINT32                      hyperperiod,
+    UINT32                      *pLoad);
+
+void        trdp_pdSlotSchedule (
+    TRDP_SHAPING_PKT_T          *pPackets,
+    UINT32                      noOfPackets,
+    UINT32                      hyperperiod,
+    UINT32                      *pLoad);
 #endif
 
 #endif
@@ -531,6 +531,84 @@ static int compareTimeouts (const void *pPDElement1, const void *pPDElement2)
     return vos_cmpTime(&p1->interval, &p2->interval);
 }
 
+/**********************************************************************************************************************/
+/** Order by throughput: shorter interval first, larger data size first within the same interval
+ *
+ *  @param[in]      p1                  pointer to first element
+ *  @param[in]      p2                  pointer to second element
+ *
+ *  @retval         < 0                 p1 goes first
+ *  @retval         0                   same throughput
+ *  @retval         > 0                 p2 goes first
+ */
+static int compareThroughput (const PD_ELE_T *p1, const PD_ELE_T *p2)
+{
+    int cmp = vos_cmpTime(&p1->interval, &p2->interval);
+
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    if (p1->dataSize > p2->dataSize)
+    {
+        return -1;
+    }
+    return (p1->dataSize < p2->dataSize) ? 1 : 0;
+}
+
+/**********************************************************************************************************************/
+/** Sort a list of elements by throughput (stable merge sort)
+ *
+ *  @param[in]      pList               first element of the list
+ *
+ *  @retval         first element of the sorted list
+ */
+static PD_ELE_T *sortThroughput (PD_ELE_T *pList)
+{
+    PD_ELE_T    *pSlow;
+    PD_ELE_T    *pFast;
+    PD_ELE_T    *pSecond;
+    PD_ELE_T    *pHead  = NULL;
+    PD_ELE_T    * *ppTail = &pHead;
+
+    if ((pList == NULL) || (pList->pNext == NULL))
+    {
+        return pList;
+    }
+
+    /* Split into halves */
+    pSlow   = pList;
+    pFast   = pList->pNext;
+    while ((pFast != NULL) && (pFast->pNext != NULL))
+    {
+        pSlow   = pSlow->pNext;
+        pFast   = pFast->pNext->pNext;
+    }
+    pSecond         = pSlow->pNext;
+    pSlow->pNext    = NULL;
+
+    pList   = sortThroughput(pList);
+    pSecond = sortThroughput(pSecond);
+
+    /* Merge, the first half wins on equal throughput */
+    while ((pList != NULL) && (pSecond != NULL))
+    {
+        if (compareThroughput(pSecond, pList) < 0)
+        {
+            *ppTail = pSecond;
+            pSecond = pSecond->pNext;
+        }
+        else
+        {
+            *ppTail = pList;
+            pList   = pList->pNext;
+        }
+        ppTail = &(*ppTail)->pNext;
+    }
+    *ppTail = (pList != NULL) ? pList : pSecond;
+    return pHead;
+}
+
 
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
@@ -750,6 +828,53 @@ void    trdp_queueInsThroughputAccending (
     }
 }
 
+/**********************************************************************************************************************/
+/** Insert a list of elements sorted by throughput (highest Byte/sec first)
+ *  Gives the same order as inserting the elements one by one with trdp_queueInsThroughputAccending, but sorts the
+ *  list once and passes the queue once.
+ *
+ *  @param[in]      ppHead          pointer to pointer to head of queue
+ *  @param[in]      pList           first element of the list to insert, linked by pNext
+ */
+void    trdp_queueMergeThroughputAccending (
+    PD_ELE_T    * *ppHead,
+    PD_ELE_T    *pList)
+{
+    PD_ELE_T    *pReversed = NULL;
+    PD_ELE_T    * *ppIter;
+
+    if (ppHead == NULL)
+    {
+        return;
+    }
+
+    /* An element inserted later goes before earlier ones of the same throughput */
+    while (pList != NULL)
+    {
+        PD_ELE_T *pNext = pList->pNext;
+
+        pList->pNext    = pReversed;
+        pReversed       = pList;
+        pList           = pNext;
+    }
+    pList = sortThroughput(pReversed);
+
+    ppIter = ppHead;
+    while (pList != NULL)
+    {
+        PD_ELE_T *pNext = pList->pNext;
+
+        while ((*ppIter != NULL) && (compareThroughput(pList, *ppIter) > 0))
+        {
+            ppIter = &(*ppIter)->pNext;
+        }
+        pList->pNext    = *ppIter;
+        *ppIter         = pList;
+        ppIter          = &pList->pNext;
+        pList           = pNext;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Insert an element sorted by interval
  *
@@ -180,6 +180,8 @@ void        trdp_queueInsIntervalAccending (PD_ELE_T    * *ppHead,
                                             PD_ELE_T    *pNew);
 void        trdp_queueInsThroughputAccending (PD_ELE_T  * *ppHead,
                                               PD_ELE_T  *pNew);
+void        trdp_queueMergeThroughputAccending (PD_ELE_T    * *ppHead,
+                                                PD_ELE_T    *pList);
 
 TRDP_ERR_T  trdp_pdSendIndexed (TRDP_SESSION_PT appHandle);
 void        trdp_pdHandleTimeOutsIndexed (TRDP_SESSION_PT appHandle);
@@ -109,7 +109,10 @@
 #define TRDP_MAGIC_PUB_HNDL_VALUE       0xCAFEBABEu
 #define TRDP_MAGIC_SUB_HNDL_VALUE       0xBABECAFEu
 
-#define TRDP_SEQ_CNT_START_ARRAY_SIZE   64u                         /**< This should be enough for the start          */
+#define TRDP_SEQ_CNT_START_ARRAY_SIZE   64u                         /**< This should be enough for the start (2^n)    */
+#define TRDP_SEQ_CNT_MAX_AGE_MS         60000u                      /**< Sender aging without subscription time out   */
+
+#define TRDP_PD_ARENA_SIZE              65536u                      /**< Max. size of a block of bulk PD elements     */
 
 #define TRDP_IF_WAIT_FOR_READY          120u        /**< 120 seconds (120 tries each second to bind to an IP address) */
 
@@ -154,7 +157,7 @@ typedef enum
 #define TRDP_TIMED_OUT      0x2u            /**< if set, inform the user                                */
 #define TRDP_INVALID_DATA   0x4u            /**< if set, inform the user                                */
 #define TRDP_REQ_2B_SENT    0x8u            /**< if set, the request needs to be sent                   */
-                                            /* TRDP_PULL_SUB removed, was unused */
+#define TRDP_TX_STAMP       0x10u           /**< if set, a transmit time stamp is pending (was TRDP_PULL_SUB) */
 #define TRDP_REDUNDANT      0x20u           /**< if set, packet should not be sent (redundant)          */
 #define TRDP_CHECK_COMID    0x40u           /**< if set, do filter comId (addListener)                  */
 #define TRDP_IS_TSN         0x80u           /**< if set, PD will be sent on trdp_put() only             */
@@ -189,14 +192,17 @@ typedef struct
 {
     UINT32          lastSeqCnt;                         /**< Sequence counter value for comId           */
     TRDP_IP_ADDR_T  srcIpAddr;                          /**< Source IP address                          */
-    TRDP_MSG_T      msgType;                            /**< message type                               */
+    TRDP_MSG_T      msgType;                            /**< message type, 0: free slot                 */
+    UINT32          lastRcvMs;                          /**< time of the last packet in ms (aging)      */
 } TRDP_SEQ_CNT_ENTRY_T;
 
+/** Open addressing hash table (linear probing) of the senders of a subscription, keyed by source IP and message type.
+    Senders silent for longer than the subscription time out are dropped when the table is full.  */
 typedef struct
 {
-    UINT16                  maxNoOfEntries;             /**< Max. no of entries the seq[] can hold      */
-    UINT16                  curNoOfEntries;             /**< Current no of entries in array             */
-    TRDP_SEQ_CNT_ENTRY_T    seq[1];                     /**< list of used sequence no.                  */
+    UINT16                  maxNoOfEntries;             /**< Size of seq[], power of two                */
+    UINT16                  curNoOfEntries;             /**< Current no of used slots                   */
+    TRDP_SEQ_CNT_ENTRY_T    seq[1];                     /**< hash table of senders                      */
 } TRDP_SEQ_CNT_LIST_T;
 
 /** Tuple of last used sequence counter for PD Request (PR) per comId  */
@@ -220,6 +226,11 @@ typedef struct TRDP_SOCKET_TCP
 } TRDP_SOCKET_TCP_T;
 
 
+/** Transmit time stamps a socket can wait for at a time (power of 2), the publisher is found by txTsId % slots */
+#ifndef TRDP_TX_STAMP_SLOTS
+#define TRDP_TX_STAMP_SLOTS     16u
+#endif
+
 /** Socket item    */
 typedef struct TRDP_SOCKETS
 {
@@ -231,8 +242,16 @@ typedef struct TRDP_SOCKETS
     TRDP_SOCK_TYPE_T    type;                            /**< Usage of this socket                        */
     BOOL8               rcvMostly;                       /**< Used for receiving                          */
     INT16               usage;                           /**< No. of current users of this socket         */
+    UINT32              txTsCnt;                         /**< No. of packets sent with transmit time stamp */
+    struct PD_ELE       *pTxTsPending[TRDP_TX_STAMP_SLOTS]; /**< Publishers waiting for their stamp, by txTsId */
     TRDP_SOCKET_TCP_T   tcpParams;                       /**< Params used for TCP                         */
-    TRDP_IP_ADDR_T      mcGroups[VOS_MAX_MULTICAST_CNT]; /**< List of multicast addresses for this socket */
+    UINT32              paramKey;                        /**< Hash of the parameters a request must match  */
+    INT16               keyHead;                         /**< 1 + first socket hashed to this index, 0: none */
+    INT16               keyNext;                         /**< 1 + next socket with the same hash, 0: none  */
+    INT16               keyBucket;                       /**< 1 + index this socket is hashed to, 0: none  */
+    UINT16              mcCount;                         /**< No. of multicast groups joined               */
+    TRDP_IP_ADDR_T      mcGroups[VOS_MAX_MULTICAST_CNT]; /**< Joined multicast groups, sorted, 0 if unused */
+    UINT16              mcUsers[VOS_MAX_MULTICAST_CNT];  /**< No. of subscribers/listeners of each group   */
 } TRDP_SOCKETS_T;
 
 #if (defined (WIN32) || defined (WIN64))
@@ -328,8 +347,26 @@ typedef struct PD_ELE
     const void          *pUserRef;              /**< from subscribe()                                       */
     TRDP_PD_CALLBACK_T  pfCbFunction;           /**< Pointer to PD callback function                        */
     PD_PACKET_T         *pFrame;                /**< header ... data + FCS...                               */
+    TRDP_TIME_T         lastTime;               /**< time of the last reception/cyclic sending (statistics) */
+    TRDP_TIME_T         rxTime;                 /**< receive time of the last packet (kernel time stamp)    */
+    UINT8               rxTimeSource;           /**< source of rxTime (TRDP_TIMESTAMP_...)                  */
+    UINT32              txTsId;                 /**< number of the last sent packet on its socket           */
+    TRDP_TIME_T         txTsStart;              /**< time the last packet was handed to the socket          */
+#ifdef IO_URING_SUPPORT
+    BOOL8               ringQueued;             /**< queued on the session's ring, not yet submitted        */
+#endif
+    UINT32              timingSeq;              /**< sequence lock of the timing statistics, odd: writing   */
+    TRDP_PD_TIMING_T    timing;                 /**< jitter and latency histograms (statistics)             */
+    struct PD_ARENA     *pArena;                /**< block this element is part of, NULL if allocated alone */
 } PD_ELE_T, *TRDP_PUB_PT, *TRDP_SUB_PT;
 
+/** Block of PD elements allocated at once by tlp_publishBulk / tlp_subscribeBulk, freed with its last element  */
+typedef struct PD_ARENA
+{
+    UINT32              noOfUsers;              /**< No. of elements of this block not yet freed            */
+    PD_ELE_T            element[1];             /**< the elements                                           */
+} PD_ARENA_T;
+
 #if MD_SUPPORT
 /** Queue element for MD listeners (UDP and TCP)   */
 typedef struct MD_LIS_ELE
@@ -430,6 +467,13 @@ typedef struct TRDP_SESSION
     TRDP_HP_SLOTS_T         *pSlot;             /**< pointer to a struct holding a list of slots for
                                                                         high speed access to PD telegrams   */
 #endif
+#ifdef IO_URING_SUPPORT
+    VOS_RING_T              ring;               /**< completion based I/O, created by tlc_processRing()     */
+    UINT32                  ringSendErrors;     /**< failed ring sends already taken out of stats.pd.numSend */
+#endif
+#ifdef PACKET_MMAP_SUPPORT
+    VOS_PKT_RING_T          pktRing;            /**< PD receive ring (TRDP_OPTION_PACKET_RING)              */
+#endif
 #if MD_SUPPORT
     VOS_MUTEX_T             mutexMD;            /**< protect the message data handling                      */
     TRDP_SOCKETS_T          ifaceMD[TRDP_MAX_MD_SOCKET_CNT];  /**< Collection of sockets to use             */
@@ -53,6 +53,21 @@ extern "C" {
  * DEFINES
  */
 
+/*  The timing statistics of a PD element are written by the thread processing the session and read through a
+    sequence lock. Without GNU atomics the readers take the PD queue mutex instead.   */
+#if defined(__GNUC__) || defined(__clang__)
+#define STATS_SEQ_LOAD(p)       __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define STATS_SEQ_INC(p)        ((void) __atomic_add_fetch((p), 1u, __ATOMIC_SEQ_CST))
+#define STATS_SEQ_FENCE()       __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define STATS_SEQ_LOCKED_READERS
+#define STATS_SEQ_LOAD(p)       (*(p))
+#define STATS_SEQ_INC(p)        ((void) (++(*(p))))
+#define STATS_SEQ_FENCE()
+#endif
+
+#define STATS_HIST_SUBS         (1u << TRDP_HIST_SUB_BITS)
+
 /*******************************************************************************
  * TYPEDEFS
  */
@@ -63,6 +78,141 @@ extern "C" {
 
 void trdp_UpdateStats (TRDP_APP_SESSION_T appHandle);
 
+/**********************************************************************************************************************/
+/** Difference of two times in us, limited to 0...0xFFFFFFFF
+ *
+ *  @param[in]      pLater              later time
+ *  @param[in]      pEarlier            earlier time
+ *  @retval         difference in us
+ */
+static UINT32 trdp_timeDiffUs (
+    const TRDP_TIME_T   *pLater,
+    const TRDP_TIME_T   *pEarlier)
+{
+    INT64 diff = ((INT64) pLater->tv_sec - (INT64) pEarlier->tv_sec) * 1000000 +
+        ((INT64) pLater->tv_usec - (INT64) pEarlier->tv_usec);
+
+    if (diff < 0)
+    {
+        return 0u;
+    }
+    if (diff > (INT64) 0xFFFFFFFFu)
+    {
+        return 0xFFFFFFFFu;
+    }
+    return (UINT32) diff;
+}
+
+/**********************************************************************************************************************/
+/** Bucket index of a value
+ *
+ *  @param[in]      value               time in us
+ *  @retval         bucket index
+ */
+static UINT32 trdp_histIndex (
+    UINT32 value)
+{
+    UINT32 msb;
+    UINT32 idx;
+
+    if (value < STATS_HIST_SUBS)
+    {
+        return value;
+    }
+    for (msb = TRDP_HIST_SUB_BITS; (value >> (msb + 1u)) != 0u; msb++)
+    {
+        ;
+    }
+    idx = ((msb - TRDP_HIST_SUB_BITS + 1u) << TRDP_HIST_SUB_BITS) +
+        ((value >> (msb - TRDP_HIST_SUB_BITS)) & (STATS_HIST_SUBS - 1u));
+    return (idx < TRDP_HIST_BUCKETS) ? idx : (TRDP_HIST_BUCKETS - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Smallest value of a bucket
+ *
+ *  @param[in]      idx                 bucket index
+ *  @retval         lower bound in us
+ */
+static UINT32 trdp_histLowerBound (
+    UINT32 idx)
+{
+    UINT32 msb;
+
+    if (idx < STATS_HIST_SUBS)
+    {
+        return idx;
+    }
+    msb = (idx >> TRDP_HIST_SUB_BITS) + TRDP_HIST_SUB_BITS - 1u;
+    return (STATS_HIST_SUBS + (idx & (STATS_HIST_SUBS - 1u))) << (msb - TRDP_HIST_SUB_BITS);
+}
+
+/**********************************************************************************************************************/
+/** Add a value to a histogram
+ *
+ *  @param[in,out]  pHist               histogram
+ *  @param[in]      value               time in us
+ */
+static void trdp_histRecord (
+    TRDP_HISTOGRAM_T    *pHist,
+    UINT32              value)
+{
+    if ((pHist->count == 0u) || (value < pHist->min))
+    {
+        pHist->min = value;
+    }
+    if (value > pHist->max)
+    {
+        pHist->max = value;
+    }
+    pHist->count++;
+    pHist->sum += value;
+    pHist->bucket[trdp_histIndex(value)]++;
+}
+
+/**********************************************************************************************************************/
+/** Copy the timing statistics of a PD element consistently
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pElement            subscriber or publisher
+ *  @param[in]      mutex               mutex of the queue the element belongs to
+ *  @param[out]     pTiming             copy of the timing statistics
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MUTEX_ERR      mutex error
+ */
+static TRDP_ERR_T trdp_copyTiming (
+    TRDP_APP_SESSION_T  appHandle,
+    const PD_ELE_T      *pElement,
+    VOS_MUTEX_T         mutex,
+    TRDP_PD_TIMING_T    *pTiming)
+{
+#ifdef STATS_SEQ_LOCKED_READERS
+    if (vos_mutexLock(mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    *pTiming = pElement->timing;
+    (void) vos_mutexUnlock(mutex);
+#else
+    UINT32 seq;
+
+    (void) appHandle;
+    (void) mutex;
+    do
+    {
+        seq = STATS_SEQ_LOAD(&pElement->timingSeq);
+        if ((seq & 1u) != 0u)
+        {
+            continue;               /* writer active */
+        }
+        memcpy(pTiming, &pElement->timing, sizeof(TRDP_PD_TIMING_T));
+        STATS_SEQ_FENCE();
+    }
+    while (((seq & 1u) != 0u) || (seq != STATS_SEQ_LOAD(&pElement->timingSeq)));
+#endif
+    return TRDP_NO_ERR;
+}
+
 /******************************************************************************
  *   Globals
  */
@@ -263,6 +413,111 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Return the timing statistics of a subscription.
+ *  The histograms are read without blocking the receiving thread.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by tlp_subscribe
+ *  @param[out]     pTiming             Pointer to the timing statistics
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ */
+EXT_DECL TRDP_ERR_T tlc_getSubsTiming (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_PD_TIMING_T    *pTiming)
+{
+    if ((subHandle == NULL) || (pTiming == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (subHandle->magic != TRDP_MAGIC_SUB_HNDL_VALUE)
+    {
+        return TRDP_NOSUB_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    return trdp_copyTiming(appHandle, subHandle, appHandle->mutexRxPD, pTiming);
+}
+
+/**********************************************************************************************************************/
+/** Return the timing statistics of a publisher.
+ *  The histograms are read without blocking the sending thread.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by tlp_publish
+ *  @param[out]     pTiming             Pointer to the timing statistics
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ */
+EXT_DECL TRDP_ERR_T tlc_getPubTiming (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_PD_TIMING_T    *pTiming)
+{
+    if ((pubHandle == NULL) || (pTiming == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pubHandle->magic != TRDP_MAGIC_PUB_HNDL_VALUE)
+    {
+        return TRDP_NOPUB_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    return trdp_copyTiming(appHandle, pubHandle, appHandle->mutexTxPD, pTiming);
+}
+
+/**********************************************************************************************************************/
+/** Return a percentile of a timing histogram.
+ *  The result is the upper bound of the bucket containing the percentile, but not more than the maximum value.
+ *
+ *  @param[in]      pHist               Pointer to the histogram
+ *  @param[in]      permille            Percentile in 1/1000, e.g. 990 for the 99th percentile
+ *  @retval         value in us, 0 if the histogram is empty
+ */
+EXT_DECL UINT32 tlc_getHistogramPercentile (
+    const TRDP_HISTOGRAM_T  *pHist,
+    UINT32                  permille)
+{
+    UINT64  rank;
+    UINT64  sum = 0u;
+    UINT32  idx;
+
+    if ((pHist == NULL) || (pHist->count == 0u))
+    {
+        return 0u;
+    }
+    if (permille > 1000u)
+    {
+        permille = 1000u;
+    }
+    rank = ((UINT64) pHist->count * permille + 999u) / 1000u;
+    if (rank == 0u)
+    {
+        return pHist->min;
+    }
+    for (idx = 0u; idx < (TRDP_HIST_BUCKETS - 1u); idx++)
+    {
+        sum += pHist->bucket[idx];
+        if (sum >= rank)
+        {
+            UINT32 upper = trdp_histLowerBound(idx + 1u) - 1u;
+            return (upper < pHist->max) ? upper : pHist->max;
+        }
+    }
+    return pHist->max;
+}
+
 #if MD_SUPPORT
 /**********************************************************************************************************************/
 /** Return UDP MD listener statistics.
@@ -467,7 +722,7 @@ void    trdp_UpdateStats (
     TRDP_APP_SESSION_T appHandle)
 {
     PD_ELE_T        *iter;
-    UINT16          lIndex, llIndex;
+    UINT16          lIndex;
     VOS_ERR_T       ret;
     VOS_TIMEVAL_T   temp, temp2;
     TIMEDATE32      diff;
@@ -515,26 +770,14 @@ void    trdp_UpdateStats (
     appHandle->stats.numJoin = 0u;
     for (lIndex = 0u; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_PD); lIndex++)
     {
-        for (llIndex = 0u; llIndex < VOS_MAX_MULTICAST_CNT; llIndex++)
-        {
-            if (appHandle->ifacePD[lIndex].mcGroups[llIndex] != 0u)
-            {
-                appHandle->stats.numJoin++;
-            }
-        }
+        appHandle->stats.numJoin += appHandle->ifacePD[lIndex].mcCount;
     }
 
 #if MD_SUPPORT
     /* Count the joins on MD sockets, as well */
     for (lIndex = 0u; lIndex < trdp_getCurrentMaxSocketCnt(TRDP_SOCK_MD_UDP); lIndex++)
     {
-        for (llIndex = 0u; llIndex < VOS_MAX_MULTICAST_CNT; llIndex++)
-        {
-            if (appHandle->ifaceMD[lIndex].mcGroups[llIndex] != 0u)
-            {
-                appHandle->stats.numJoin++;
-            }
-        }
+        appHandle->stats.numJoin += appHandle->ifaceMD[lIndex].mcCount;
     }
 #endif
 
@@ -640,6 +883,99 @@ void    trdp_pdPrepareStats (
     pPacket->privFlags = (TRDP_PRIV_FLAGS_T) (pPacket->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
 }
 
+/**********************************************************************************************************************/
+/** Record the arrival of a PD for a subscription
+ *
+ *  @param[in,out]  pElement            subscription
+ *  @param[in]      pNow                reception time
+ */
+void    trdp_pdRecordRxTiming (
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pNow)
+{
+    STATS_SEQ_INC(&pElement->timingSeq);
+    STATS_SEQ_FENCE();
+    if (timerisset(&pElement->lastTime))
+    {
+        UINT32  delta   = trdp_timeDiffUs(pNow, &pElement->lastTime);
+        UINT32  timeout = (UINT32) pElement->interval.tv_usec + (UINT32) pElement->interval.tv_sec * 1000000u;
+
+        trdp_histRecord(&pElement->timing.interval, delta);
+        if ((timeout != 0u) && (delta > (timeout / 2u)))
+        {
+            pElement->timing.numLate++;
+        }
+    }
+    pElement->lastTime = *pNow;
+    STATS_SEQ_FENCE();
+    STATS_SEQ_INC(&pElement->timingSeq);
+}
+
+/**********************************************************************************************************************/
+/** Record the delay between the reception of a PD and the call of its callback function
+ *
+ *  @param[in,out]  pElement            subscription
+ *  @param[in]      pRcvTime            reception time
+ */
+void    trdp_pdRecordCbLatency (
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pRcvTime)
+{
+    TRDP_TIME_T now;
+
+    vos_getTime(&now);
+    STATS_SEQ_INC(&pElement->timingSeq);
+    STATS_SEQ_FENCE();
+    trdp_histRecord(&pElement->timing.latency, trdp_timeDiffUs(&now, pRcvTime));
+    STATS_SEQ_FENCE();
+    STATS_SEQ_INC(&pElement->timingSeq);
+}
+
+/**********************************************************************************************************************/
+/** Record the cyclic sending of a PD
+ *
+ *  @param[in,out]  pElement            publisher
+ *  @param[in]      pNow                send time
+ */
+void    trdp_pdRecordTxTiming (
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pNow)
+{
+    STATS_SEQ_INC(&pElement->timingSeq);
+    STATS_SEQ_FENCE();
+    if (timerisset(&pElement->lastTime))
+    {
+        UINT32  period  = trdp_timeDiffUs(pNow, &pElement->lastTime);
+        UINT32  cycle   = (UINT32) pElement->interval.tv_usec + (UINT32) pElement->interval.tv_sec * 1000000u;
+
+        trdp_histRecord(&pElement->timing.interval, (period > cycle) ? (period - cycle) : (cycle - period));
+        if (period > (cycle + cycle / 2u))
+        {
+            pElement->timing.numLate++;
+        }
+    }
+    pElement->lastTime = *pNow;
+    STATS_SEQ_FENCE();
+    STATS_SEQ_INC(&pElement->timingSeq);
+}
+
+/**********************************************************************************************************************/
+/** Record the delay between the send call of a PD and its transmit time stamp
+ *
+ *  @param[in,out]  pElement            publisher
+ *  @param[in]      pTxTime             transmit time stamp
+ */
+void    trdp_pdRecordTxLatency (
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pTxTime)
+{
+    STATS_SEQ_INC(&pElement->timingSeq);
+    STATS_SEQ_FENCE();
+    trdp_histRecord(&pElement->timing.latency, trdp_timeDiffUs(pTxTime, &pElement->txTsStart));
+    STATS_SEQ_FENCE();
+    STATS_SEQ_INC(&pElement->timingSeq);
+}
+
 
 #ifdef __cplusplus
 }
@@ -47,6 +47,10 @@
 
 void    trdp_initStats(TRDP_APP_SESSION_T appHandle);
 void    trdp_pdPrepareStats (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pPacket);
+void    trdp_pdRecordRxTiming (PD_ELE_T *pElement, const TRDP_TIME_T *pNow);
+void    trdp_pdRecordCbLatency (PD_ELE_T *pElement, const TRDP_TIME_T *pRcvTime);
+void    trdp_pdRecordTxTiming (PD_ELE_T *pElement, const TRDP_TIME_T *pNow);
+void    trdp_pdRecordTxLatency (PD_ELE_T *pElement, const TRDP_TIME_T *pTxTime);
 
 
 #endif
@@ -104,11 +104,11 @@ static INT32 sCurrentMaxMDSocketCnt = 0;
  */
 
 void    printSocketUsage (TRDP_SOCKETS_T iface[]);
-BOOL8   trdp_SockIsJoined (const TRDP_IP_ADDR_T mcList[VOS_MAX_MULTICAST_CNT],
+BOOL8   trdp_SockIsJoined (const TRDP_SOCKETS_T *pSocket,
                            TRDP_IP_ADDR_T       mcGroup);
-BOOL8   trdp_SockAddJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
+BOOL8   trdp_SockAddJoin (TRDP_SOCKETS_T    *pSocket,
                           TRDP_IP_ADDR_T    mcGroup);
-BOOL8   trdp_SockDelJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
+BOOL8   trdp_SockDelJoin (TRDP_SOCKETS_T    *pSocket,
                           TRDP_IP_ADDR_T    mcGroup);
 
 /**********************************************************************************************************************/
@@ -147,80 +147,244 @@ void printSocketUsage (
 }
 
 /**********************************************************************************************************************/
-/** Check if a mc group is in the list
+/** Find a mc group in the sorted list of a socket
  *
- *  @param[in]      mcList              List of multicast groups
+ *  @param[in]      pSocket             socket pool entry
  *  @param[in]      mcGroup             multicast group
  *
- *  @retval         1           if found
- *                  0           if not found
+ *  @retval         >= 0        index of the group in mcGroups[]
+ *                  < 0         -1 - index the group would be inserted at
  */
-BOOL8 trdp_SockIsJoined (
-    const TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
+static INT32 trdp_SockFindJoin (
+    const TRDP_SOCKETS_T    *pSocket,
     TRDP_IP_ADDR_T          mcGroup)
 {
-    int i = 0;
+    INT32   low     = 0;
+    INT32   high    = (INT32) pSocket->mcCount - 1;
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT && mcList[i] != mcGroup; i++)
+    while (low <= high)
     {
-        ;
+        INT32 mid = (low + high) / 2;
+
+        if (pSocket->mcGroups[mid] == mcGroup)
+        {
+            return mid;
+        }
+        if (pSocket->mcGroups[mid] < mcGroup)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid - 1;
+        }
     }
+    return -1 - low;
+}
 
-    return i < VOS_MAX_MULTICAST_CNT;
+/**********************************************************************************************************************/
+/** Check if a mc group is joined by a socket
+ *
+ *  @param[in]      pSocket             socket pool entry
+ *  @param[in]      mcGroup             multicast group
+ *
+ *  @retval         1           if found
+ *                  0           if not found
+ */
+BOOL8 trdp_SockIsJoined (
+    const TRDP_SOCKETS_T    *pSocket,
+    TRDP_IP_ADDR_T          mcGroup)
+{
+    return (trdp_SockFindJoin(pSocket, mcGroup) >= 0) ? TRUE : FALSE;
 }
 
 /**********************************************************************************************************************/
-/** Add mc group to the list
+/** Add a user of a mc group to the list of a socket, add the group if it is new
  *
- *  @param[in]      mcList          List of multicast groups
+ *  @param[in,out]  pSocket         socket pool entry
  *  @param[in]      mcGroup         multicast group
  *
- *  @retval         1           if added
+ *  @retval         1           if added or counted
  *                  0           if list is full
  */
 BOOL8 trdp_SockAddJoin (
-    TRDP_IP_ADDR_T  mcList[VOS_MAX_MULTICAST_CNT],
+    TRDP_SOCKETS_T  *pSocket,
     TRDP_IP_ADDR_T  mcGroup)
 {
-    int i = 0;
+    INT32 i = trdp_SockFindJoin(pSocket, mcGroup);
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT; i++)
+    if (i >= 0)
     {
-        if (0 == mcList[i] || mcGroup == mcList[i])
-        {
-            mcList[i] = mcGroup;
-            return TRUE;
-        }
+        pSocket->mcUsers[i]++;
+        return TRUE;
+    }
+    if (pSocket->mcCount >= VOS_MAX_MULTICAST_CNT)
+    {
+        return FALSE;
     }
 
-    return FALSE;
+    /*  Keep the list sorted    */
+    i = -1 - i;
+    memmove(&pSocket->mcGroups[i + 1], &pSocket->mcGroups[i], (pSocket->mcCount - i) * sizeof(TRDP_IP_ADDR_T));
+    memmove(&pSocket->mcUsers[i + 1], &pSocket->mcUsers[i], (pSocket->mcCount - i) * sizeof(UINT16));
+    pSocket->mcGroups[i]    = mcGroup;
+    pSocket->mcUsers[i]     = 1u;
+    pSocket->mcCount++;
+    return TRUE;
 }
 
 /**********************************************************************************************************************/
-/** remove mc group from the list
+/** Remove a user of a mc group from the list of a socket, remove the group with its last user
  *
- *  @param[in]      mcList        List of multicast groups
+ *  @param[in,out]  pSocket       socket pool entry
  *  @param[in]      mcGroup       multicast group
  *
- *  @retval         1           if deleted
- *                  0           was not in list
+ *  @retval         1           if deleted, the socket should leave the group
+ *                  0           still used or was not in list
  */
 BOOL8 trdp_SockDelJoin (
-    TRDP_IP_ADDR_T  mcList[VOS_MAX_MULTICAST_CNT],
+    TRDP_SOCKETS_T  *pSocket,
     TRDP_IP_ADDR_T  mcGroup)
 {
-    int i = 0;
+    INT32 i = trdp_SockFindJoin(pSocket, mcGroup);
+
+    if (i < 0)
+    {
+        return FALSE;
+    }
+    if (pSocket->mcUsers[i] > 1u)
+    {
+        pSocket->mcUsers[i]--;
+        return FALSE;
+    }
+
+    pSocket->mcCount--;
+    memmove(&pSocket->mcGroups[i], &pSocket->mcGroups[i + 1], (pSocket->mcCount - i) * sizeof(TRDP_IP_ADDR_T));
+    memmove(&pSocket->mcUsers[i], &pSocket->mcUsers[i + 1], (pSocket->mcCount - i) * sizeof(UINT16));
+    pSocket->mcGroups[pSocket->mcCount] = 0u;
+    pSocket->mcUsers[pSocket->mcCount]  = 0u;
+    return TRUE;
+}
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT; i++)
+/**********************************************************************************************************************/
+/** Get the size of the socket pool of a socket type
+ *
+ *  @param[in]      type            socket type
+ *
+ *  @retval         number of entries, 0 if unknown
+ */
+static INT32 trdp_sockPoolSize (
+    TRDP_SOCK_TYPE_T type)
+{
+    switch (type) /* because of lint*/
     {
-        if (mcGroup == mcList[i])
+        case  TRDP_SOCK_PD:
+        case  TRDP_SOCK_PD_TSN:
+            return TRDP_MAX_PD_SOCKET_CNT;
+#if MD_SUPPORT
+        case  TRDP_SOCK_MD_TCP:
+        case  TRDP_SOCK_MD_UDP:
+            return TRDP_MAX_MD_SOCKET_CNT;
+#endif
+        default:
+            break;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Hash the parameters a socket request has to match exactly
+ *
+ *  @param[in]      type            socket type
+ *  @param[in]      bindAddr        interface address the socket is bound to
+ *  @param[in]      rcvMostly       primarily used for receiving
+ *  @param[in]      params          send parameters, not compared for receivers
+ *
+ *  @retval         hash key
+ */
+static UINT32 trdp_sockParamKey (
+    TRDP_SOCK_TYPE_T        type,
+    TRDP_IP_ADDR_T          bindAddr,
+    BOOL8                   rcvMostly,
+    const TRDP_COM_PARAM_T  *params)
+{
+    UINT32 key = bindAddr ^ ((UINT32) type << 28) ^ ((UINT32) rcvMostly << 24);
+
+    if (!rcvMostly)
+    {
+        key ^= ((UINT32) params->qos << 8) ^ ((UINT32) params->ttl << 16);
+    }
+    return key * 0x9E3779B1u;   /* spread over the upper bits */
+}
+
+/**********************************************************************************************************************/
+/** Get the pool index whose keyHead starts the hash chain of a key
+ *
+ *  @param[in]      paramKey        hash key
+ *  @param[in]      poolSize        size of the socket pool
+ *
+ *  @retval         index into the socket pool
+ */
+static INT32 trdp_sockKeyBucket (
+    UINT32  paramKey,
+    INT32   poolSize)
+{
+    return (INT32) ((paramKey >> 16) % (UINT32) poolSize);
+}
+
+/**********************************************************************************************************************/
+/** Add an opened UDP socket to the hash chain of its parameters
+ *  The chain is kept in pool order, a request takes the same socket as when looping through the whole pool.
+ *
+ *  @param[in,out]  iface           socket pool
+ *  @param[in]      lIndex          index of the socket
+ *  @param[in]      poolSize        size of the socket pool
+ */
+static void trdp_sockLinkKey (
+    TRDP_SOCKETS_T  iface[],
+    INT32           lIndex,
+    INT32           poolSize)
+{
+    INT32   bucket = trdp_sockKeyBucket(iface[lIndex].paramKey, poolSize);
+    INT16   *pLink;
+
+    for (pLink = &iface[bucket].keyHead; (*pLink != 0) && (*pLink < lIndex + 1); pLink = &iface[*pLink - 1].keyNext)
+    {
+        ;
+    }
+    iface[lIndex].keyNext   = *pLink;
+    iface[lIndex].keyBucket = (INT16) (bucket + 1);
+    *pLink = (INT16) (lIndex + 1);
+}
+
+/**********************************************************************************************************************/
+/** Remove a closed socket from its hash chain and forget its multicast groups
+ *
+ *  @param[in,out]  iface           socket pool
+ *  @param[in]      lIndex          index of the socket
+ */
+static void trdp_sockUnlinkKey (
+    TRDP_SOCKETS_T  iface[],
+    INT32           lIndex)
+{
+    INT16 *pLink;
+
+    if (iface[lIndex].keyBucket != 0)
+    {
+        for (pLink = &iface[iface[lIndex].keyBucket - 1].keyHead; *pLink != 0; pLink = &iface[*pLink - 1].keyNext)
         {
-            mcList[i] = 0;
-            return TRUE;
+            if (*pLink == lIndex + 1)
+            {
+                *pLink = iface[lIndex].keyNext;
+                break;
+            }
         }
     }
-
-    return FALSE;
+    iface[lIndex].keyNext   = 0;
+    iface[lIndex].keyBucket = 0;
+    iface[lIndex].mcCount   = 0u;
+    memset(iface[lIndex].mcGroups, 0, sizeof(iface[lIndex].mcGroups));
+    memset(iface[lIndex].mcUsers, 0, sizeof(iface[lIndex].mcUsers));
 }
 
 /**********************************************************************************************************************/
@@ -309,47 +473,6 @@ void trdp_setCurrentMaxSocketCnt (
     }
 }
 
-/**********************************************************************************************************************/
-/** Check an MC group not used by other sockets / subscribers/ listeners
- *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[in]      mcGroup             multicast group to look for
- *
- *  @retval         multi cast group if unused
- *                  VOS_INADDR_ANY if used
- */
-TRDP_IP_ADDR_T trdp_findMCjoins (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_IP_ADDR_T      mcGroup)
-{
-    int         used = FALSE;
-    PD_ELE_T    *pIter;
-    for (pIter = appHandle->pRcvQueue; pIter != NULL; pIter = pIter->pNext)
-    {
-        if ((pIter->addr.mcGroup != VOS_INADDR_ANY) &&
-            (pIter->addr.mcGroup == mcGroup))
-        {
-            used = TRUE;
-            break;
-        }
-    }
-    #if MD_SUPPORT
-    {
-        MD_LIS_ELE_T *pMDIter;
-        for (pMDIter = appHandle->pMDListenQueue; pMDIter != NULL; pMDIter = pMDIter->pNext)
-        {
-            if ((pMDIter->addr.mcGroup != VOS_INADDR_ANY) &&
-                (pMDIter->addr.mcGroup == mcGroup))
-            {
-                used = TRUE;
-                break;
-            }
-        }
-    }
-    #endif
-    return (used == TRUE) ? VOS_INADDR_ANY : mcGroup;
-}
-
 /**********************************************************************************************************************/
 /** Get the packet size from the raw data size
  *
@@ -435,6 +558,57 @@ PD_ELE_T *trdp_queueFindComId (
 }
 
 
+/**********************************************************************************************************************/
+/** Check if a publisher collides with a telegram to publish
+ *
+ *  @param[in]      pPub            addresses of the existing publisher
+ *  @param[in]      addr            Pub handle (ComID, srcIP & dest IP, mcGroup, serviceId) to publish
+ *
+ *  @retval         TRUE            same comId, serviceId and IP addresses (or wildcards)
+ *  @retval         FALSE           no collision
+ */
+BOOL8 trdp_matchPubAddr (
+    const TRDP_ADDRESSES_T  *pPub,
+    const TRDP_ADDRESSES_T  *addr)
+{
+    /*  We match if src/dst/mc/service address is zero or matches */
+    return ((pPub->comId == addr->comId)
+            && ((pPub->srcIpAddr == 0) || (pPub->srcIpAddr == addr->srcIpAddr))
+            && ((pPub->destIpAddr == 0) || (pPub->destIpAddr == addr->destIpAddr))
+            && ((pPub->mcGroup == 0) || (pPub->mcGroup == addr->mcGroup))
+            && SOA_SAME_SERVICEID_OR0(pPub->serviceId, addr->serviceId)) ? TRUE : FALSE; /*lint !e506 meant to be true, if service support is off */
+}
+
+/**********************************************************************************************************************/
+/** Check if a subscription already covers a telegram to subscribe
+ *
+ *  @param[in]      pSub            addresses of the existing subscription
+ *  @param[in]      addr            Sub handle (ComID, srcIP & dest IP, serviceId) to subscribe
+ *
+ *  @retval         TRUE            same comId, serviceId and IP addresses (or source within range)
+ *  @retval         FALSE           not covered
+ */
+BOOL8 trdp_matchExistingSub (
+    const TRDP_ADDRESSES_T  *pSub,
+    const TRDP_ADDRESSES_T  *addr)
+{
+    if ((pSub->comId != addr->comId)
+        || !SOA_SAME_SERVICEID(pSub->serviceId, addr->serviceId)) /*lint !e506 meant to be true, if service support is off */
+    {
+        return FALSE;
+    }
+    if ((pSub->srcIpAddr == addr->srcIpAddr)
+        && (pSub->destIpAddr == addr->destIpAddr))
+    {
+        return TRUE;
+    }
+    /* Check for IP range */
+    return ((pSub->srcIpAddr2 != VOS_INADDR_ANY)
+            && (addr->srcIpAddr >= pSub->srcIpAddr)
+            && (addr->srcIpAddr <= pSub->srcIpAddr2)
+            && (pSub->destIpAddr == addr->destIpAddr)) ? TRUE : FALSE;
+}
+
 /**********************************************************************************************************************/
 /** Return the element with same comId, serviceId and IP addresses
  *
@@ -457,12 +631,7 @@ PD_ELE_T *trdp_queueFindPubAddr (
 
     for (iterPD = pHead; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /*  We match if src/dst/mc/service address is zero or matches */
-        if ((iterPD->addr.comId == addr->comId)
-            && ((iterPD->addr.srcIpAddr == 0) || (iterPD->addr.srcIpAddr == addr->srcIpAddr))
-            && ((iterPD->addr.destIpAddr == 0) || (iterPD->addr.destIpAddr == addr->destIpAddr))
-            && ((iterPD->addr.mcGroup == 0) || (iterPD->addr.mcGroup == addr->mcGroup))
-            && SOA_SAME_SERVICEID_OR0(iterPD->addr.serviceId, addr->serviceId)) /*lint !e506 meant to be true, if service support is off */
+        if (trdp_matchPubAddr(&iterPD->addr, addr))
         {
             return iterPD;
         }
@@ -648,26 +817,9 @@ PD_ELE_T *trdp_queueFindExistingSub (
 
     for (iterPD = pHead; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        /*  We match if src/dst/mc address is zero or matches */
-        if ((iterPD->addr.comId == addr->comId)
-            && SOA_SAME_SERVICEID(iterPD->addr.serviceId, addr->serviceId)) /*lint !e506 meant to be true, if service support is off */
+        if (trdp_matchExistingSub(&iterPD->addr, addr))
         {
-            if ((iterPD->addr.srcIpAddr == addr->srcIpAddr)
-                && (iterPD->addr.destIpAddr == addr->destIpAddr))
-            {
-                return iterPD;
-            }
-            /* Check for IP range */
-            if (iterPD->addr.srcIpAddr2 != VOS_INADDR_ANY)
-            {
-                if ((addr->srcIpAddr >= iterPD->addr.srcIpAddr) &&
-                    (addr->srcIpAddr <= iterPD->addr.srcIpAddr2) &&
-                    (iterPD->addr.destIpAddr == addr->destIpAddr))
-                {
-                    return iterPD;
-                }
-            }
-
+            return iterPD;
         }
     }
     return NULL;
@@ -948,6 +1100,10 @@ void trdp_initSockets (
     {
         iface[lIndex].sock = VOS_INVALID_SOCKET;
         iface[lIndex].type = TRDP_SOCK_INVAL;
+        iface[lIndex].keyHead   = 0;
+        iface[lIndex].keyNext   = 0;
+        iface[lIndex].keyBucket = 0;
+        iface[lIndex].mcCount   = 0u;
     }
 }
 
@@ -956,6 +1112,8 @@ void trdp_initSockets (
  *  First we loop through the socket pool and check if there is already a socket
  *  which would suit us. If a multicast group should be joined, we do that on an otherwise suitable socket - 
  *  up to 20 multicast groups can be joined per socket.
+ *  UDP sockets are found through a hash of the parameters they must match (type, interface, direction and QoS/TTL
+ *  of senders), only requests for TCP or for any interface loop through the whole pool.
  *  If a socket for multicast publishing is requested, we also use the source IP to determine the interface for outgoing
  *  multicast traffic.
  *
@@ -992,7 +1150,9 @@ TRDP_ERR_T  trdp_requestSocket (
     VOS_SOCK_OPT_T  sock_options;
     INT32           lIndex;
     INT32           emptySockIdx = -1;    /* was emptySock, renamed to avoid confusion */
-    INT32           sockMax;
+    INT32           sockMax     = trdp_sockPoolSize(type);
+    UINT32          paramKey;
+    BOOL8           indexed;
     TRDP_ERR_T      err         = TRDP_NO_ERR;
     TRDP_IP_ADDR_T  bindAddr    = vos_determineBindAddr(srcIP, mcGroup, rcvMostly);
 
@@ -1003,13 +1163,19 @@ TRDP_ERR_T  trdp_requestSocket (
         return TRDP_PARAM_ERR;
     }
 
-    /*  We loop through the table of open/used sockets,
+    paramKey    = trdp_sockParamKey(type, bindAddr, rcvMostly, params);
+    indexed     = ((useSocket == VOS_INVALID_SOCKET) && (type != TRDP_SOCK_MD_TCP) && (sockMax > 0)
+                   && ((bindAddr != 0u) || (mcGroup != 0u))) ? TRUE : FALSE;
+
+    /*  We loop through the table of open/used sockets (or the sockets with the same parameter hash),
      if we find a usable one (with the same socket options) we take it.
      if we search for a multicast group enabled socket, we also search the list of mc groups (max. 20)
      and possibly add that group, if everything else fits.
      We remember already closed sockets on the way to be able to fill up gaps  */
 
-    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(type); lIndex++)
+    for (lIndex = (indexed == TRUE) ? (INT32) iface[trdp_sockKeyBucket(paramKey, sockMax)].keyHead - 1 : 0;
+         (lIndex >= 0) && (lIndex < trdp_getCurrentMaxSocketCnt(type));
+         lIndex = (indexed == TRUE) ? (INT32) iface[lIndex].keyNext - 1 : lIndex + 1)
     {
         /*  Check if the wanted socket is already in our list; if yes, increment usage */
         if (useSocket != VOS_INVALID_SOCKET &&
@@ -1022,6 +1188,7 @@ TRDP_ERR_T  trdp_requestSocket (
             goto err_exit;
         }
         else if ((iface[lIndex].sock != VOS_INVALID_SOCKET)
+                 && ((indexed == FALSE) || (iface[lIndex].paramKey == paramKey))
                  && !((mcGroup != 0u) && (bindAddr != iface[lIndex].bindAddr))  /* do not use if multicast and different iface specified! */
                  && ((bindAddr == 0) || (iface[lIndex].bindAddr == bindAddr))
                  && (iface[lIndex].type == type)
@@ -1036,10 +1203,10 @@ TRDP_ERR_T  trdp_requestSocket (
                          (iface[lIndex].usage == 0))))
         {
             /*  Did this socket join the required multicast group?  */
-            if (mcGroup != 0 && trdp_SockIsJoined(iface[lIndex].mcGroups, mcGroup) == FALSE)
+            if (mcGroup != 0 && trdp_SockIsJoined(&iface[lIndex], mcGroup) == FALSE)
             {
                 /*  No, but can we add it? */
-                if (trdp_SockAddJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
+                if (trdp_SockAddJoin(&iface[lIndex], mcGroup) == FALSE)
                 {
                     continue;   /* No, socket cannot join more MC groups */
                 }
@@ -1047,7 +1214,7 @@ TRDP_ERR_T  trdp_requestSocket (
                 {
                     if (vos_sockJoinMC(iface[lIndex].sock, mcGroup, srcIP) != VOS_NO_ERR)
                     {
-                        if (trdp_SockDelJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
+                        if (trdp_SockDelJoin(&iface[lIndex], mcGroup) == FALSE)
                         {
                             vos_printLogStr(VOS_LOG_ERROR, "trdp_SockDelJoin() failed!\n");
                         }
@@ -1057,6 +1224,11 @@ TRDP_ERR_T  trdp_requestSocket (
                                  vos_ipDotted(mcGroup));
                 }
             }
+            else if (mcGroup != 0)
+            {
+                /*  Already joined, count the additional user of the group  */
+                (void) trdp_SockAddJoin(&iface[lIndex], mcGroup);
+            }
 
             /* add_start TOSHIBA 0306 */
             if ((type != TRDP_SOCK_MD_TCP)
@@ -1107,20 +1279,16 @@ TRDP_ERR_T  trdp_requestSocket (
     }
 
     /* Not found, create a new socket entry */
-    switch (type) /* because of lint*/
+    if (indexed == TRUE)
     {
-    case  TRDP_SOCK_PD:
-    case  TRDP_SOCK_PD_TSN:
-        sockMax = TRDP_MAX_PD_SOCKET_CNT;
-        break;
-#if MD_SUPPORT
-    case  TRDP_SOCK_MD_TCP:
-    case  TRDP_SOCK_MD_UDP:
-        sockMax = TRDP_MAX_MD_SOCKET_CNT;
-        break;
-#endif
-    default:
-        sockMax = 0;
+        /* The hash chain did not pass the closed sockets, look for a gap now */
+        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(type); lIndex++)
+        {
+            if ((iface[lIndex].sock == VOS_INVALID_SOCKET) && (emptySockIdx == -1))
+            {
+                emptySockIdx = lIndex;
+            }
+        }
     }
     if (lIndex < sockMax)
     {
@@ -1162,7 +1330,14 @@ TRDP_ERR_T  trdp_requestSocket (
             iface[lIndex].tcpParams.addFileDesc = FALSE;
         }
 
+        iface[lIndex].paramKey  = paramKey;
+        iface[lIndex].keyNext   = 0;
+        iface[lIndex].keyBucket = 0;
+        iface[lIndex].mcCount   = 0u;
         memset(iface[lIndex].mcGroups, 0, sizeof(iface[lIndex].mcGroups));
+        memset(iface[lIndex].mcUsers, 0, sizeof(iface[lIndex].mcUsers));
+        iface[lIndex].txTsCnt = 0u;
+        memset(iface[lIndex].pTxTsPending, 0, sizeof(iface[lIndex].pTxTsPending));
 
         /* if a socket descriptor was supplied, take that one (for the TCP connection)   */
         if (useSocket != VOS_INVALID_SOCKET)
@@ -1180,6 +1355,9 @@ TRDP_ERR_T  trdp_requestSocket (
         sock_options.ttl_multicast  = (type != TRDP_SOCK_MD_TCP) ? params->ttl : 0;
         sock_options.no_mc_loop     = ((type != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_MC_LOOP_BACK)) ? 1 : 0;
         sock_options.no_udp_crc     = ((type != TRDP_SOCK_MD_TCP) && (options & TRDP_OPTION_NO_UDP_CHK)) ? 1 : 0;
+        sock_options.timestamping   = ((type == TRDP_SOCK_PD) && (options & TRDP_OPTION_TIMESTAMPING)) ? TRUE : FALSE;
+        sock_options.txTime         = ((type == TRDP_SOCK_PD) && (options & TRDP_OPTION_TXTIME)) ? TRUE : FALSE;
+        sock_options.noReceive      = ((type == TRDP_SOCK_PD) && (options & TRDP_OPTION_PACKET_RING)) ? TRUE : FALSE;
 
         switch (type)
         {
@@ -1237,7 +1415,7 @@ TRDP_ERR_T  trdp_requestSocket (
                             }
                             else
                             {
-                                if (trdp_SockAddJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
+                                if (trdp_SockAddJoin(&iface[lIndex], mcGroup) == FALSE)
                                 {
                                     vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() failed!\n");
                                 }
@@ -1297,7 +1475,7 @@ TRDP_ERR_T  trdp_requestSocket (
                             }
                             else
                             {
-                                if (trdp_SockAddJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
+                                if (trdp_SockAddJoin(&iface[lIndex], mcGroup) == FALSE)
                                 {
                                     vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() failed!\n");
                                 }
@@ -1351,6 +1529,10 @@ TRDP_ERR_T  trdp_requestSocket (
             /* Release socket in case of error */
             trdp_releaseSocket(iface, lIndex, 0, FALSE, VOS_INADDR_ANY);
         }
+        else if (type != TRDP_SOCK_MD_TCP)
+        {
+            trdp_sockLinkKey(iface, lIndex, sockMax);
+        }
     }
     else
     {
@@ -1459,16 +1641,13 @@ void  trdp_releaseSocket (
                     vos_printLog(VOS_LOG_DBG, "Closed socket %d\n", sock_id);
                 }
                 iface[lIndex].sock = VOS_INVALID_SOCKET;
+                trdp_sockUnlinkKey(iface, lIndex);
             }
             else if (mcGroupUsed != VOS_INADDR_ANY) /* Check for MC usage (close socket will unjoin MC anyway) */
             {
-                /* remove MC group from socket list:
-                    we do that only if the caller is the only user of this MC group on this socket! */
-                if (trdp_SockDelJoin(iface[lIndex].mcGroups, mcGroupUsed) == FALSE)
-                {
-                    vos_printLogStr(VOS_LOG_WARNING, "trdp_sockDelJoin() failed!\n");
-                }
-                else    /* and unjoin MC group */
+                /* remove the caller from the users of the MC group on this socket,
+                    the group is left only if the caller was its last user on this socket! */
+                if (trdp_SockDelJoin(&iface[lIndex], mcGroupUsed) == TRUE)
                 {
                     if (vos_sockLeaveMC(iface[lIndex].sock, mcGroupUsed, iface[lIndex].srcAddr) != VOS_NO_ERR)
                     {
@@ -1519,6 +1698,136 @@ void  trdp_releaseSocket (
     }
 }
 
+/**********************************************************************************************************************/
+/** Home slot of a sender in the sequence counter table
+ *
+ *  @param[in]      pList               sequence counter table
+ *  @param[in]      srcIP               Source IP address
+ *  @param[in]      msgType             message type
+ *
+ *  @retval         index into seq[]
+ */
+static UINT32 trdp_seqCntHash (
+    const TRDP_SEQ_CNT_LIST_T   *pList,
+    TRDP_IP_ADDR_T              srcIP,
+    TRDP_MSG_T                  msgType)
+{
+    UINT32 key = srcIP ^ ((UINT32) msgType << 16);
+
+    /* Fibonacci hashing, the upper bits are mixed best */
+    return ((key * 0x9E3779B1u) >> 16) & ((UINT32) pList->maxNoOfEntries - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Check if a sender was not heard of for longer than the aging time
+ *  Receive times of different sockets may be slightly out of order, an entry newer than nowMs is not aged.
+ *
+ *  @param[in]      pEntry              sender
+ *  @param[in]      nowMs               current time in ms
+ *  @param[in]      maxAgeMs            aging time in ms
+ *
+ *  @retval         TRUE if aged
+ */
+static BOOL8 trdp_seqCntAged (
+    const TRDP_SEQ_CNT_ENTRY_T  *pEntry,
+    UINT32                      nowMs,
+    UINT32                      maxAgeMs)
+{
+    return ((INT32) (nowMs - pEntry->lastRcvMs) > (INT32) maxAgeMs) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of a sender in the sequence counter table
+ *
+ *  @param[in]      pList               sequence counter table
+ *  @param[in]      srcIP               Source IP address
+ *  @param[in]      msgType             message type
+ *
+ *  @retval         slot of the sender, or the free slot to insert it
+ */
+static TRDP_SEQ_CNT_ENTRY_T *trdp_seqCntFind (
+    TRDP_SEQ_CNT_LIST_T *pList,
+    TRDP_IP_ADDR_T      srcIP,
+    TRDP_MSG_T          msgType)
+{
+    UINT32 mask     = (UINT32) pList->maxNoOfEntries - 1u;
+    UINT32 l_index  = trdp_seqCntHash(pList, srcIP, msgType);
+
+    /* The table is never full (load <= 3/4), so a free slot ends the search */
+    while ((pList->seq[l_index].msgType != 0) &&
+           ((pList->seq[l_index].srcIpAddr != srcIP) || (pList->seq[l_index].msgType != msgType)))
+    {
+        l_index = (l_index + 1u) & mask;
+    }
+    return &pList->seq[l_index];
+}
+
+/**********************************************************************************************************************/
+/** Allocate a sequence counter table and move the active senders of the old one into it
+ *  Senders not heard of for maxAgeMs are dropped. The table is doubled while it would be more than half full.
+ *
+ *  @param[in]      pOld                old table or NULL
+ *  @param[in]      nowMs               current time in ms
+ *  @param[in]      maxAgeMs            aging time in ms
+ *
+ *  @retval         new table, NULL on memory error (the old table is kept)
+ */
+static TRDP_SEQ_CNT_LIST_T *trdp_seqCntRehash (
+    TRDP_SEQ_CNT_LIST_T *pOld,
+    UINT32              nowMs,
+    UINT32              maxAgeMs)
+{
+    TRDP_SEQ_CNT_LIST_T *pNew;
+    UINT32              size    = TRDP_SEQ_CNT_START_ARRAY_SIZE;
+    UINT32              active  = 0u;
+    UINT32              l_index;
+
+    if (pOld != NULL)
+    {
+        for (l_index = 0u; l_index < pOld->maxNoOfEntries; l_index++)
+        {
+            if ((pOld->seq[l_index].msgType != 0) && !trdp_seqCntAged(&pOld->seq[l_index], nowMs, maxAgeMs))
+            {
+                active++;
+            }
+        }
+        size = pOld->maxNoOfEntries;
+    }
+    while ((2u * (active + 1u) > size) && (size < 0x8000u))
+    {
+        size *= 2u;
+    }
+    if (4u * (active + 1u) > 3u * size)
+    {
+        return NULL;    /* 24576 active senders on one subscription */
+    }
+
+    /* vos_memAlloc returns zeroed memory: all slots free */
+    pNew = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(size * sizeof(TRDP_SEQ_CNT_ENTRY_T) + sizeof(TRDP_SEQ_CNT_LIST_T));
+    if (pNew == NULL)
+    {
+        return NULL;
+    }
+    pNew->maxNoOfEntries = (UINT16) size;
+
+    if (pOld != NULL)
+    {
+        for (l_index = 0u; l_index < pOld->maxNoOfEntries; l_index++)
+        {
+            if ((pOld->seq[l_index].msgType != 0) && !trdp_seqCntAged(&pOld->seq[l_index], nowMs, maxAgeMs))
+            {
+                *trdp_seqCntFind(pNew, pOld->seq[l_index].srcIpAddr, pOld->seq[l_index].msgType) =
+                    pOld->seq[l_index];
+                pNew->curNoOfEntries++;
+            }
+        }
+        vos_printLog(VOS_LOG_DBG, "Sequence counter table: %u of %u senders active, %u slots\n",
+                     (unsigned int) active, (unsigned int) pOld->curNoOfEntries, (unsigned int) size);
+        vos_memFree(pOld);
+    }
+    return pNew;
+}
+
 /**********************************************************************************************************************/
 /** remove the sequence counter for the comID/source IP.
  *  The sequence counter should be reset if there was a packet time out.
@@ -1536,20 +1845,16 @@ void trdp_resetSequenceCounter (
     TRDP_IP_ADDR_T  srcIP,
     TRDP_MSG_T      msgType)
 {
-    int l_index;
+    TRDP_SEQ_CNT_ENTRY_T *pEntry;
 
     if (pElement == NULL || pElement->pSeqCntList == NULL)
     {
         return;
     }
-    /* Loop over entries */
-    for (l_index = 0; l_index < pElement->pSeqCntList->curNoOfEntries; ++l_index)
+    pEntry = trdp_seqCntFind(pElement->pSeqCntList, srcIP, msgType);
+    if (pEntry->msgType != 0)
     {
-        if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
-            (msgType == pElement->pSeqCntList->seq[l_index].msgType))
-        {
-            pElement->pSeqCntList->seq[l_index].lastSeqCnt = 0;
-        }
+        pEntry->lastSeqCnt = 0;
     }
 }
 
@@ -1558,11 +1863,14 @@ void trdp_resetSequenceCounter (
  *  If the comID/srcIP is not found, update it and return 0 -
  *  else if already received, return 1
  *  On memory error, return -1
+ *  A sender not heard of for longer than the subscription time out (or TRDP_SEQ_CNT_MAX_AGE_MS without time out)
+ *  is treated like a new one.
  *
  *  @param[in]      pElement            subscription element
  *  @param[in]      sequenceCounter     sequence counter to check
  *  @param[in]      srcIP               Source IP address
  *  @param[in]      msgType             type of the message
+ *  @param[in]      pNow                receive time
  *
  *  @retval         0 - no duplicate
  *                  1 - duplicate or old sequence counter
@@ -1570,89 +1878,79 @@ void trdp_resetSequenceCounter (
  */
 
 int trdp_checkSequenceCounter (
-    PD_ELE_T        *pElement,
-    UINT32          sequenceCounter,
-    TRDP_IP_ADDR_T  srcIP,
-    TRDP_MSG_T      msgType)
+    PD_ELE_T            *pElement,
+    UINT32              sequenceCounter,
+    TRDP_IP_ADDR_T      srcIP,
+    TRDP_MSG_T          msgType,
+    const TRDP_TIME_T   *pNow)
 {
-    int l_index;
+    TRDP_SEQ_CNT_ENTRY_T    *pEntry;
+    UINT32                  nowMs;
+    UINT32                  maxAgeMs;
 
-    if (pElement == NULL)
+    if ((pElement == NULL) || (pNow == NULL) || (msgType == 0))
     {
         vos_printLogStr(VOS_LOG_DBG, "Parameter error\n");
         return -1;
     }
 
+    nowMs       = (UINT32) pNow->tv_sec * 1000u + (UINT32) pNow->tv_usec / 1000u;
+    maxAgeMs    = (UINT32) pElement->interval.tv_sec * 1000u + (UINT32) pElement->interval.tv_usec / 1000u;
+    if (maxAgeMs == 0u)
+    {
+        maxAgeMs = TRDP_SEQ_CNT_MAX_AGE_MS;
+    }
+
     if (pElement->pSeqCntList == NULL)
     {
         /* Allocate some space */
-        pElement->pSeqCntList = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(TRDP_SEQ_CNT_START_ARRAY_SIZE *
-                                                                     sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-                                                                     sizeof(TRDP_SEQ_CNT_LIST_T));
+        pElement->pSeqCntList = trdp_seqCntRehash(NULL, nowMs, maxAgeMs);
         if (pElement->pSeqCntList == NULL)
         {
             return -1;
         }
-        pElement->pSeqCntList->maxNoOfEntries   = TRDP_SEQ_CNT_START_ARRAY_SIZE;
-        pElement->pSeqCntList->curNoOfEntries   = 0;
     }
-    /* Loop over entries */
-    for (l_index = 0; l_index < pElement->pSeqCntList->curNoOfEntries; ++l_index)
+
+    pEntry = trdp_seqCntFind(pElement->pSeqCntList, srcIP, msgType);
+    if (pEntry->msgType != 0)
     {
-        if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
-            (msgType == pElement->pSeqCntList->seq[l_index].msgType))
+        /*        Is this packet a duplicate?    */
+        if ((pEntry->lastSeqCnt == 0) ||                        /* first time after timeout */
+            trdp_seqCntAged(pEntry, nowMs, maxAgeMs) ||         /* sender was gone          */
+            (sequenceCounter > pEntry->lastSeqCnt))
         {
-            /*        Is this packet a duplicate?    */
-            if ((pElement->pSeqCntList->seq[l_index].lastSeqCnt == 0) ||    /* first time after timeout */
-                (sequenceCounter > pElement->pSeqCntList->seq[l_index].lastSeqCnt))
-            {
-                /*
-                 vos_printLog(VOS_LOG_DBG,
-                 "Rcv sequence: %u    last seq: %u\n",
-                 sequenceCounter,
-                 pElement->pSeqCntList->seq[l_index].lastSeqCnt);
-                 vos_printLog(VOS_LOG_DBG, "-> new PD data found (SrcIp: %s comId %u)\n", vos_ipDotted(
-                 srcIP), pElement->addr.comId);
-                 */
-                pElement->pSeqCntList->seq[l_index].lastSeqCnt = sequenceCounter;
-                return 0;
-            }
-            else
-            {
-                vos_printLog(VOS_LOG_DBG,
-                             "Rcv sequence: %u    last seq: %u\n",
-                             sequenceCounter,
-                             pElement->pSeqCntList->seq[l_index].lastSeqCnt);
-                vos_printLog(VOS_LOG_DBG, "-> duplicated PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
-                                 srcIP), pElement->addr.comId);
-                return 1;
-            }
+            pEntry->lastSeqCnt  = sequenceCounter;
+            pEntry->lastRcvMs   = nowMs;
+            return 0;
+        }
+        else
+        {
+            vos_printLog(VOS_LOG_DBG,
+                         "Rcv sequence: %u    last seq: %u\n",
+                         sequenceCounter,
+                         pEntry->lastSeqCnt);
+            vos_printLog(VOS_LOG_DBG, "-> duplicated PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
+                             srcIP), pElement->addr.comId);
+            return 1;
         }
     }
 
-    /* Not found in list, add new entry */
-    if (pElement->pSeqCntList->curNoOfEntries >= pElement->pSeqCntList->maxNoOfEntries)
+    /* Not found in table, add new entry. Keep the load at 3/4 at most, so probe sequences stay short */
+    if (4u * ((UINT32) pElement->pSeqCntList->curNoOfEntries + 1u) > 3u * pElement->pSeqCntList->maxNoOfEntries)
     {
-        /* Allocate some more space */
-        UINT16 newSize = 2 * pElement->pSeqCntList->curNoOfEntries;
-        TRDP_SEQ_CNT_LIST_T *newList = (TRDP_SEQ_CNT_LIST_T *) vos_memAlloc(newSize * sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-                                                                            sizeof(TRDP_SEQ_CNT_LIST_T));
+        TRDP_SEQ_CNT_LIST_T *newList = trdp_seqCntRehash(pElement->pSeqCntList, nowMs, maxAgeMs);
+
         if (newList == NULL)
         {
             return -1;
         }
-
-        /* Copy old data into new, larger area */
-        memcpy(newList, pElement->pSeqCntList, pElement->pSeqCntList->maxNoOfEntries *
-               sizeof(TRDP_SEQ_CNT_ENTRY_T) +
-               sizeof(TRDP_SEQ_CNT_LIST_T));
-        vos_memFree(pElement->pSeqCntList);     /* Free old area */
         pElement->pSeqCntList = newList;
-        pElement->pSeqCntList->maxNoOfEntries = newSize;
+        pEntry = trdp_seqCntFind(newList, srcIP, msgType);
     }
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].lastSeqCnt    = sequenceCounter;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].srcIpAddr     = srcIP;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].msgType       = msgType;
+    pEntry->lastSeqCnt  = sequenceCounter;
+    pEntry->srcIpAddr   = srcIP;
+    pEntry->msgType     = msgType;
+    pEntry->lastRcvMs   = nowMs;
     pElement->pSeqCntList->curNoOfEntries++;
     vos_printLog(VOS_LOG_DBG, "Rcv sequence: %u\n", sequenceCounter);
     vos_printLog(VOS_LOG_DBG, "*** new sequence entry (SrcIp: %s comId %u)\n", vos_ipDotted(
@@ -71,15 +71,15 @@ void    printSocketUsage(
     TRDP_SOCKETS_T iface[]);
 
 BOOL8   trdp_SockIsJoined (
-    const TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
+    const TRDP_SOCKETS_T    *pSocket,
     TRDP_IP_ADDR_T          mcGroup);
 
 BOOL8   trdp_SockAddJoin(
-    TRDP_IP_ADDR_T mcList[VOS_MAX_MULTICAST_CNT],
+    TRDP_SOCKETS_T *pSocket,
     TRDP_IP_ADDR_T mcGroup);
 
 BOOL8   trdp_SockDelJoin(
-    TRDP_IP_ADDR_T mcList[VOS_MAX_MULTICAST_CNT],
+    TRDP_SOCKETS_T *pSocket,
     TRDP_IP_ADDR_T mcGroup);
 
 TRDP_IP_ADDR_T  trdp_getOwnIP (void);
@@ -108,6 +108,14 @@ PD_ELE_T        *trdp_queueFindExistingSub (
     PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *pAddr);
 
+BOOL8           trdp_matchPubAddr (
+    const TRDP_ADDRESSES_T  *pPub,
+    const TRDP_ADDRESSES_T  *addr);
+
+BOOL8           trdp_matchExistingSub (
+    const TRDP_ADDRESSES_T  *pSub,
+    const TRDP_ADDRESSES_T  *addr);
+
 PD_ELE_T        *trdp_queueFindPubAddr (
     PD_ELE_T            *pHead,
     TRDP_ADDRESSES_T    *addr);
@@ -161,10 +169,6 @@ void    trdp_resetSequenceCounter (
     TRDP_IP_ADDR_T  srcIP,
     TRDP_MSG_T      msgType);
 
-TRDP_IP_ADDR_T  trdp_findMCjoins (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_IP_ADDR_T      mcGroup);
-
 TRDP_ERR_T      trdp_requestSocket(
     TRDP_SOCKETS_T iface[],
     UINT16 port,
@@ -194,10 +198,11 @@ UINT32  trdp_packetSizeMD (
     UINT32 dataSize);
 
 int trdp_checkSequenceCounter (
-    PD_ELE_T        *pElement,
-    UINT32          sequenceCounter,
-    TRDP_IP_ADDR_T  srcIP,
-    TRDP_MSG_T      msgType);
+    PD_ELE_T            *pElement,
+    UINT32              sequenceCounter,
+    TRDP_IP_ADDR_T      srcIP,
+    TRDP_MSG_T          msgType,
+    const TRDP_TIME_T   *pNow);
 
 BOOL8 trdp_isAddressed (
     const TRDP_URI_USER_T   listUri,
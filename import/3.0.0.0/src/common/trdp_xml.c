@@ -37,14 +37,17 @@
 #include <string.h>
 #include <limits.h>
 
-#include <sys/types.h>
-
 #include "trdp_xml.h"
 
 /***********************************************************************************************************************
  * DEFINES
  */
 
+#define XML_ARENA_ROUND(size)   (((size) + 7u) & ~(size_t) 7u)     /* Allocations are 8 byte aligned */
+#define XML_ARENA_HEADER_SIZE   XML_ARENA_ROUND(sizeof(XML_ARENA_CHUNK_T))
+#define XML_ARENA_LARGE_SIZE    (XML_ARENA_CHUNK_SIZE / 4u)         /* Larger tables get a chunk of their own */
+#define XML_ARENA_DATA(pChunk)  ((UINT8 *) (pChunk) + XML_ARENA_HEADER_SIZE)
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -53,6 +56,43 @@
 *  LOCAL FUNCTIONS
 */
 
+/**********************************************************************************************************************/
+/** Read the next character of the document, like fgetc().
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         next character (0..255), EOF at the end of the document
+ */
+static int trdp_XMLGetChar (
+    XML_HANDLE_T *pXML)
+{
+    if (pXML->readPos < pXML->bufSize)
+    {
+        return (unsigned char) pXML->pBuffer[pXML->readPos++];
+    }
+    pXML->eof = 1;
+    return EOF;
+}
+
+/**********************************************************************************************************************/
+/** Push back the last read character, like ungetc().
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      ch          Character returned by trdp_XMLGetChar
+ *
+ *  @retval         none
+ */
+static void trdp_XMLUngetChar (
+    XML_HANDLE_T    *pXML,
+    int             ch)
+{
+    if (ch != EOF)
+    {
+        pXML->readPos--;
+        pXML->eof = 0;
+    }
+}
+
 /***********************************************************************************************************************
 NAME:       trdp_XMLNextToken
 ABSTRACT:   Returns next XML token.
@@ -79,14 +119,13 @@ static XML_TOKEN_T trdp_XMLNextToken (
     for (;; )
     {
         /* Skip whitespace */
-        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) <= ' ') /*lint !e160 Lint objects a GNU warning
-                                                                           suppression macro - OK */
+        while (!pXML->eof && (ch = trdp_XMLGetChar(pXML)) <= ' ')
         {
             ;
         }
 
         /* Check for EOF */
-        if (feof(pXML->infile)) /*lint !e611 Lint for VxWorks gets lost in macro defintions*/
+        if (pXML->eof)
         {
             return TOK_EOF;
         }
@@ -95,8 +134,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
         if (ch == '"')
         {
             p = pXML->tokenValue;
-            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '"') /*lint !e160 Lint objects a GNU warning
-                                                                               suppression macro - OK */
+            while (!pXML->eof && (ch = trdp_XMLGetChar(pXML)) != '"')
             {
                 if (p < (pXML->tokenValue + MAX_TOK_LEN - 1))
                 {
@@ -110,22 +148,21 @@ static XML_TOKEN_T trdp_XMLNextToken (
         else if (ch == '<')
         {
             /* Tag start character */
-            ch = fgetc(pXML->infile);    /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = trdp_XMLGetChar(pXML);
 
             if (ch == '?') /* Skip processing instruction */
             {
-                while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU warning
-                                                                            suppression macro - OK */
+                while (!pXML->eof && (ch = trdp_XMLGetChar(pXML)))
                 {
                     if (ch == '?')
                     {
-                        if ((ch = fgetc(pXML->infile)) == '>')
+                        if ((ch = trdp_XMLGetChar(pXML)) == '>')
                         {
                             break;
                         }
                         else
                         {
-                            (void) ungetc(ch, pXML->infile);
+                            trdp_XMLUngetChar(pXML, ch);
                         }
                     }
                 }
@@ -133,16 +170,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
             else if (ch == '!')
             {
                 /* Is it a comment? */
-                if (!feof(pXML->infile) && (ch = fgetc(pXML->infile)))
+                if (!pXML->eof && (ch = trdp_XMLGetChar(pXML)))
                 {
                     if (ch == '-')
                     {
-                        if ((ch = fgetc(pXML->infile) == '-'))
+                        if ((ch = trdp_XMLGetChar(pXML) == '-'))
                         {
                             int endTagCnt = 0;
-                            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU
-                                                                                        warning suppression macro - OK
-                                                                                        */
+                            while (!pXML->eof && (ch = trdp_XMLGetChar(pXML)))
                             {
                                 if (ch == '-')
                                 {
@@ -159,7 +194,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
                                 }
                             }
                             /* Exit on unexpected end-of-file */
-                            if (endTagCnt != 2 && feof(pXML->infile))
+                            if (endTagCnt != 2 && pXML->eof)
                             {
                                 pXML->error = TRDP_XML_PARSER_ERR;
                                 return TOK_EOF;
@@ -168,14 +203,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
                     }
                     else
                     {
-                        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '>')
+                        while (!pXML->eof && (ch = trdp_XMLGetChar(pXML)) != '>')
                         {
                             ;
                         }
                     }
                 }
                 /* Exit on unexpected end-of-file */
-                if (feof(pXML->infile))
+                if (pXML->eof)
                 {
                     pXML->error = TRDP_XML_PARSER_ERR;
                     return TOK_EOF;
@@ -187,20 +222,20 @@ static XML_TOKEN_T trdp_XMLNextToken (
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                trdp_XMLUngetChar(pXML, ch);
                 return TOK_OPEN;
             }
         }
         else if (ch == '/')
         {
-            ch = fgetc(pXML->infile); /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = trdp_XMLGetChar(pXML);
             if (ch == '>')
             {
                 return TOK_CLOSE_EMPTY;
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                trdp_XMLUngetChar(pXML, ch);
             }
         }
         else if (ch == '>')
@@ -216,8 +251,8 @@ static XML_TOKEN_T trdp_XMLNextToken (
             /* Unquoted identifier */
             p       = pXML->tokenValue;
             *(p++)  = (char) ch;
-            while ((!feof(pXML->infile)) &&
-                   ((ch = fgetc(pXML->infile)) != '<') /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            while ((!pXML->eof) &&
+                   ((ch = trdp_XMLGetChar(pXML)) != '<')
                    && (ch != '>')
                    && (ch != '=')
                    && (ch != '/')
@@ -233,7 +268,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
 
             if ((ch == '<') || (ch == '>') || (ch == '=') || (ch == '/'))
             {
-                (void) ungetc(ch, pXML->infile);
+                trdp_XMLUngetChar(pXML, ch);
             }
 
             return TOK_ID;
@@ -308,34 +343,74 @@ static XML_TOKEN_T trdp_XMLNextTokenHl (
 
 /**********************************************************************************************************************/
 /** Opens the XML parsing.
+ *  The whole file is read into memory, rewinding and counting tags does not touch the file again.
  *
  *  @param[in]      pXML        Pointer to local data
  *  @param[in]      file        Pathname of XML file
  *
- *  @retval         none
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_IO_ERR     file could not be read
+ *  @retval         TRDP_MEM_ERR    out of memory
  */
 TRDP_ERR_T trdp_XMLOpen (
     XML_HANDLE_T    *pXML,
     const char      *file)
 {
-    if ((pXML->infile = fopen(file, "rb")) == NULL)
+    FILE    *infile;
+    char    *pBuffer    = NULL;
+    size_t  bufSize     = 0u;
+    size_t  size        = 0u;
+
+    if ((infile = fopen(file, "rb")) == NULL)
     {
         return TRDP_IO_ERR;
     }
 
-    pXML->tagDepth      = 0;
-    pXML->tagDepthSeek  = 0;
-    pXML->error         = TRDP_NO_ERR;
+    /* Read in chunks, the file size is not known for pipes and devices */
+    do
+    {
+        if (size == bufSize)
+        {
+            size_t  newSize = (bufSize == 0u) ? 0x10000u : 2u * bufSize;
+            char    *pNew   = (char *) realloc(pBuffer, newSize);
+
+            if (pNew == NULL)
+            {
+                free(pBuffer);
+                fclose(infile);
+                return TRDP_MEM_ERR;
+            }
+            bufSize = newSize;
+            pBuffer = pNew;
+        }
+        size += fread(pBuffer + size, 1u, bufSize - size, infile);
+    }
+    while (size == bufSize);
+
+    if (ferror(infile))
+    {
+        free(pBuffer);
+        fclose(infile);
+        return TRDP_IO_ERR;
+    }
+    fclose(infile);
+
+    pXML->pBuffer       = pBuffer;
+    pXML->bufSize       = size;
+    pXML->ownBuffer     = 1;
+    trdp_XMLRewind(pXML);
     return TRDP_NO_ERR;
 }
 
 /**********************************************************************************************************************/
 /** Opens the XML parsing from a buffer (string stream).
+ *  The buffer is parsed in place, it must stay valid until trdp_XMLClose.
  *
  *  @param[in]      pXML        Pointer to local data
  *  @param[in]      pBuffer     Pointer to XML stream buffer
  *  @param[in]      bufSize     Size of XML stream buffer
  *
+ *  @retval         TRDP_NO_ERR
  *  @retval         TRDP_IO_ERR
  */
 TRDP_ERR_T trdp_XMLMemOpen (
@@ -343,34 +418,17 @@ TRDP_ERR_T trdp_XMLMemOpen (
     char            *pBuffer,
     size_t          bufSize)
 {
-#ifdef HAS_FMEMOPEN
-#ifdef __APPLE__
-    if (__builtin_available(macOS 10.13, *))
-#endif
-    if ((pXML->infile = fmemopen(pBuffer, bufSize, "rb")) == NULL)
+    if (pBuffer == NULL)
     {
         vos_printLogStr(VOS_LOG_ERROR, "XML stream could not be opened for reading\n");
         return TRDP_IO_ERR;
     }
 
-    pXML->tagDepth      = 0;
-    pXML->tagDepthSeek  = 0;
-    pXML->error         = TRDP_NO_ERR;
+    pXML->pBuffer       = pBuffer;
+    pXML->bufSize       = bufSize;
+    pXML->ownBuffer     = 0;
+    trdp_XMLRewind(pXML);
     return TRDP_NO_ERR;
-#else
-    /* Create and open a temporary file */
-    pXML->infile = tmpfile();               /* Note: Needs admin rights under VISTA!    */
-    if (pXML->infile != NULL)
-    {
-        /* Write to temp file */
-        fprintf(pXML->infile, "%s", pBuffer);
-        /* prepare for reading */
-        trdp_XMLRewind(pXML);
-        return TRDP_NO_ERR;
-    }
-    vos_printLogStr(VOS_LOG_ERROR, "Temporary XML file could not be opened to write\n");
-    return TRDP_IO_ERR;
-#endif
 }
 
 /**********************************************************************************************************************/
@@ -383,16 +441,14 @@ TRDP_ERR_T trdp_XMLMemOpen (
 void trdp_XMLRewind (
     XML_HANDLE_T *pXML)
 {
-    if (pXML->infile == NULL)
+    if (pXML->pBuffer == NULL)
     {
         pXML->error = TRDP_XML_PARSER_ERR;
     }
-    else if (fseek(pXML->infile, 0, SEEK_SET) == -1)
-    {
-        pXML->error = TRDP_IO_ERR;
-    }
     else
     {
+        pXML->readPos       = 0u;
+        pXML->eof           = 0;
         pXML->tagDepth      = 0;
         pXML->tagDepthSeek  = 0;
         pXML->error         = TRDP_NO_ERR;
@@ -409,7 +465,165 @@ void trdp_XMLRewind (
 void trdp_XMLClose (
     XML_HANDLE_T *pXML)
 {
-    fclose(pXML->infile);
+    if (pXML->ownBuffer != 0)
+    {
+        free((void *) pXML->pBuffer);
+    }
+    pXML->pBuffer   = NULL;
+    pXML->bufSize   = 0u;
+    pXML->ownBuffer = 0;
+    trdp_XMLArenaRelease(&pXML->arena);
+}
+
+/**********************************************************************************************************************/
+/** Allocate from the configuration arena.
+ *  The memory is taken from the heap in chunks of XML_ARENA_CHUNK_SIZE, outside of the vos_mem pool, and is
+ *  released as a whole by trdp_XMLArenaRelease. Tables larger than a quarter chunk get a chunk of their own.
+ *
+ *  @param[in]      pArena      Pointer to the arena
+ *  @param[in]      size        Size of the allocation
+ *
+ *  @retval         pointer to zeroed, 8 byte aligned memory
+ *  @retval         NULL        out of memory
+ */
+void *trdp_XMLArenaAlloc (
+    XML_ARENA_T *pArena,
+    size_t      size)
+{
+    XML_ARENA_CHUNK_T   *pChunk = pArena->pHead;
+    UINT8               *p;
+
+    size = (size == 0u) ? XML_ARENA_ROUND(1u) : XML_ARENA_ROUND(size);
+
+    if (size > XML_ARENA_LARGE_SIZE)
+    {
+        pChunk = (XML_ARENA_CHUNK_T *) calloc(1u, XML_ARENA_HEADER_SIZE + size);
+        if (pChunk == NULL)
+        {
+            return NULL;
+        }
+        pChunk->size    = size;
+        pChunk->used    = size;
+
+        /* Keep allocating from the current chunk */
+        if (pArena->pHead != NULL)
+        {
+            pChunk->pNext           = pArena->pHead->pNext;
+            pArena->pHead->pNext    = pChunk;
+        }
+        else
+        {
+            pArena->pHead = pChunk;
+        }
+        return XML_ARENA_DATA(pChunk);
+    }
+
+    if ((pChunk == NULL) || ((pChunk->size - pChunk->used) < size))
+    {
+        pChunk = (XML_ARENA_CHUNK_T *) calloc(1u, XML_ARENA_HEADER_SIZE + XML_ARENA_CHUNK_SIZE);
+        if (pChunk == NULL)
+        {
+            return NULL;
+        }
+        pChunk->size    = XML_ARENA_CHUNK_SIZE;
+        pChunk->pNext   = pArena->pHead;
+        pArena->pHead   = pChunk;
+    }
+
+    p               = XML_ARENA_DATA(pChunk) + pChunk->used;
+    pChunk->used    += size;
+    pArena->pLast   = p;
+    return p;
+}
+
+/**********************************************************************************************************************/
+/** Grow an allocation of the configuration arena.
+ *  The last allocation grows in place if the chunk has room, a large table is moved with its chunk. Otherwise the
+ *  contents are copied to a new allocation; the old one stays allocated until the arena is released.
+ *
+ *  @param[in]      pArena      Pointer to the arena
+ *  @param[in]      pOld        Allocation to grow, may be NULL
+ *  @param[in]      oldSize     Size of pOld
+ *  @param[in]      newSize     New size
+ *
+ *  @retval         pointer to the grown allocation, the new tail is zeroed
+ *  @retval         NULL        out of memory, pOld is still valid
+ */
+void *trdp_XMLArenaRealloc (
+    XML_ARENA_T *pArena,
+    void        *pOld,
+    size_t      oldSize,
+    size_t      newSize)
+{
+    XML_ARENA_CHUNK_T   *pChunk = pArena->pHead;
+    XML_ARENA_CHUNK_T   **ppLink;
+    void                *pNew;
+    size_t              oldRound    = XML_ARENA_ROUND(oldSize);
+    size_t              newRound    = XML_ARENA_ROUND(newSize);
+
+    if (pOld == NULL)
+    {
+        return trdp_XMLArenaAlloc(pArena, newSize);
+    }
+    if (newRound <= oldRound)
+    {
+        return pOld;
+    }
+
+    if ((pOld == pArena->pLast) &&
+        (pChunk != NULL) &&
+        ((UINT8 *) pOld + oldRound == XML_ARENA_DATA(pChunk) + pChunk->used) &&
+        ((newRound - oldRound) <= (pChunk->size - pChunk->used)))
+    {
+        pChunk->used += newRound - oldRound;
+        return pOld;
+    }
+
+    if (oldRound > XML_ARENA_LARGE_SIZE)
+    {
+        for (ppLink = &pArena->pHead; *ppLink != NULL; ppLink = &(*ppLink)->pNext)
+        {
+            if (XML_ARENA_DATA(*ppLink) == (UINT8 *) pOld)
+            {
+                pChunk = (XML_ARENA_CHUNK_T *) realloc(*ppLink, XML_ARENA_HEADER_SIZE + newRound);
+                if (pChunk == NULL)
+                {
+                    return NULL;
+                }
+                memset(XML_ARENA_DATA(pChunk) + oldRound, 0, newRound - oldRound);
+                pChunk->size    = newRound;
+                pChunk->used    = newRound;
+                *ppLink         = pChunk;
+                return XML_ARENA_DATA(pChunk);
+            }
+        }
+    }
+
+    pNew = trdp_XMLArenaAlloc(pArena, newSize);
+    if (pNew != NULL)
+    {
+        memcpy(pNew, pOld, oldSize);
+    }
+    return pNew;
+}
+
+/**********************************************************************************************************************/
+/** Release all memory of the configuration arena.
+ *
+ *  @param[in]      pArena      Pointer to the arena
+ *
+ *  @retval         none
+ */
+void trdp_XMLArenaRelease (
+    XML_ARENA_T *pArena)
+{
+    while (pArena->pHead != NULL)
+    {
+        XML_ARENA_CHUNK_T *pNext = pArena->pHead->pNext;
+        free(pArena->pHead);
+        pArena->pHead = pNext;
+    }
+    pArena->pLast = NULL;
 }
 
 /**********************************************************************************************************************/
@@ -497,7 +711,6 @@ int trdp_XMLCountStartTag (
     int             count = 0;
 
     XML_HANDLE_T    safe        = *pXML;
-    off_t           last_read   = ftell(pXML->infile);
 
     do
     {
@@ -510,7 +723,7 @@ int trdp_XMLCountStartTag (
     while (ret == 0);
 
     *pXML = safe;
-    fseek(pXML->infile, (long) last_read, SEEK_SET);
+    pXML->eof = 0;
     return count;
 }
 
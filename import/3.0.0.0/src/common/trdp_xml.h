@@ -49,6 +49,8 @@
 #define MAX_TOK_LEN     124u         /* Max length of token/attribute string */
 #define MAX_TAG_LEN     132u         /* Max length of tag string */
 
+#define XML_ARENA_CHUNK_SIZE    0x10000u    /* Size of the blocks the configuration arena is carved from */
+
 /* Tokens */
 typedef enum
 {
@@ -67,14 +69,34 @@ typedef enum
     TOK_ATTRIBUTE       /* "<" character    */
 } XML_TOKEN_T;
 
+/* Block of the configuration arena, the allocations follow the header */
+typedef struct XML_ARENA_CHUNK
+{
+    struct XML_ARENA_CHUNK  *pNext;     /* Older chunk */
+    size_t                  size;       /* Usable size */
+    size_t                  used;       /* Bytes handed out */
+} XML_ARENA_CHUNK_T;
+
+/* Bump allocator for the configuration read from a document, released as a whole */
+typedef struct
+{
+    XML_ARENA_CHUNK_T   *pHead;         /* Chunk allocated from, followed by older chunks and large tables */
+    void                *pLast;         /* Last allocation from pHead, can be grown in place */
+} XML_ARENA_T;
+
 typedef struct XML_HANDLE
 {
-    FILE    *infile;
+    const char  *pBuffer;       /* The whole document, read at once by trdp_XMLOpen or supplied by the caller */
+    size_t      bufSize;        /* Size of the document */
+    size_t      readPos;        /* Position of the next character */
+    int         eof;            /* End of document was hit (like feof()) */
+    int         ownBuffer;      /* pBuffer was allocated by trdp_XMLOpen */
     char    tokenValue[MAX_TOK_LEN];
     int     tagDepth;
     int     tagDepthSeek;
     char    tokenTag[MAX_TAG_LEN + 1];
     int     error;
+    XML_ARENA_T arena;          /* Memory of the configuration read from this document */
 } XML_HANDLE_T, *TRDP_XML_HANDLE_T;
 
 /*******************************************************************************
@@ -106,4 +128,12 @@ void    trdp_XMLRewind (XML_HANDLE_T *pXML);
 void    trdp_XMLEnter (XML_HANDLE_T *pXML);
 void    trdp_XMLLeave (XML_HANDLE_T *pXML);
 
+void    *trdp_XMLArenaAlloc (XML_ARENA_T    *pArena,
+                             size_t         size);
+void    *trdp_XMLArenaRealloc (XML_ARENA_T  *pArena,
+                               void         *pOld,
+                               size_t       oldSize,
+                               size_t       newSize);
+void    trdp_XMLArenaRelease (XML_ARENA_T *pArena);
+
 #endif /* TRDP_XML_H */
@@ -54,7 +54,9 @@ typedef enum
 {
     VOS_QUEUE_POLICY_OTHER,         /*  Default for the target system    */
     VOS_QUEUE_POLICY_FIFO,          /*  First in, first out              */
-    VOS_QUEUE_POLICY_LIFO           /*  Last in, first out               */
+    VOS_QUEUE_POLICY_LIFO,          /*  Last in, first out               */
+    VOS_QUEUE_POLICY_SPSC,          /*  Lock-free FIFO, one sending and one receiving thread (Linux only)     */
+    VOS_QUEUE_POLICY_MPMC           /*  Lock-free FIFO, any number of sending and receiving threads (Linux only) */
 } VOS_QUEUE_POLICY_T;
 
 
@@ -310,7 +312,11 @@ EXT_DECL void vos_strncat (
 /** Initialize a message queue.
  *  Returns a handle for further calls
  *
- *  @param[in]      queueType       Define queue type (1 = FIFO, 2 = LIFO, 3 = PRIO)
+ *  The lock-free policies VOS_QUEUE_POLICY_SPSC and VOS_QUEUE_POLICY_MPMC take no mutex or semaphore; a receiver
+ *  blocks (futex) only while the queue is empty. Their capacity is maxNoOfMsg rounded up to a power of two.
+ *  An SPSC queue must have at most one sending and one receiving thread at a time.
+ *
+ *  @param[in]      queueType       Define queue type (FIFO, LIFO, SPSC, MPMC)
  *  @param[in]      maxNoOfMsg      Maximum number of messages
  *  @param[out]     pQueueHandle    Handle of created queue
  *
@@ -318,7 +324,7 @@ EXT_DECL void vos_strncat (
  *  @retval         VOS_INIT_ERR    module not initialised
  *  @retval         VOS_NOINIT_ERR  invalid handle
  *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
- *  @retval         VOS_INIT_ERR    not supported
+ *  @retval         VOS_INIT_ERR    not supported (lock-free policy on this target)
  *  @retval         VOS_QUEUE_ERR   error creating queue
  */
 
@@ -341,6 +347,7 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
  *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
  *  @retval         VOS_INIT_ERR    not supported
  *  @retval         VOS_QUEUE_ERR   error creating queue
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full (never blocks)
  */
 
 EXT_DECL VOS_ERR_T vos_queueSend (
@@ -100,6 +100,70 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     const UINT8 *pMemoryArea);
 
 
+/**********************************************************************************************************************/
+/** Attach read-only to an existing shared memory area.
+ *  The area must have been created by vos_sharedOpen() of another process (or thread). The mapping is released
+ *  with vos_fileUnmap() and stays valid even if the owner closes the area meanwhile.
+ *    This function is not available in each target implementation (VOS_UNKNOWN_ERR).
+ *
+ *  @param[in]      pKey            Unique identifier (file name) used by the owner
+ *  @param[out]     ppMemoryArea    Pointer to pointer to mapped memory area
+ *  @param[out]     pSize           Pointer to size of the mapped area
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      area does not exist (yet)
+ *  @retval         VOS_MEM_ERR     mapping failed
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_sharedAttach (
+    const CHAR8 *pKey,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize);
+
+
+/**********************************************************************************************************************/
+/*    Memory mapped files
+                                                                                                               */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/** Map a file read-only into memory.
+ *  The mapping stays valid until vos_fileUnmap() is called, even if the file is replaced or removed meanwhile.
+ *    This function is not available in each target implementation (VOS_UNKNOWN_ERR), callers should fall back
+ *    to reading the file.
+ *
+ *  @param[in]      pFileName       Path of the file to map
+ *  @param[out]     ppMemoryArea    Pointer to pointer to mapped memory area
+ *  @param[out]     pSize           Pointer to size of the mapped file
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      file could not be opened, is empty or too big
+ *  @retval         VOS_MEM_ERR     mapping failed
+ *  @retval         VOS_UNKNOWN_ERR not supported by the target
+ */
+
+EXT_DECL VOS_ERR_T vos_fileMap (
+    const CHAR8 *pFileName,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize);
+
+
+/**********************************************************************************************************************/
+/** Unmap a file mapped by vos_fileMap().
+ *
+ *  @param[in]      pMemoryArea      Pointer to mapped memory area
+ *  @param[in]      size             Size returned by vos_fileMap()
+ *  @retval         VOS_NO_ERR       no error
+ *  @retval         VOS_PARAM_ERR    parameter error
+ *  @retval         VOS_MEM_ERR      unmapping failed
+ */
+
+EXT_DECL VOS_ERR_T vos_fileUnmap (
+    const UINT8 *pMemoryArea,
+    UINT32      size);
+
+
 #ifdef __cplusplus
 }
 #endif
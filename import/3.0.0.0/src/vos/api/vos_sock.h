@@ -186,8 +186,15 @@ typedef struct
     BOOL8   no_udp_crc;     /**< supress udp crc computation                        */
     BOOL8   txTime;         /**< use transmit time on send, if available            */
     BOOL8   raw;            /**< use raw socket, not for receiver!                  */
+    BOOL8   timestamping;   /**< kernel receive / transmit time stamps, if available */
+    BOOL8   noReceive;      /**< drop received packets, they are read from a packet ring (Linux) */
 } VOS_SOCK_OPT_T;  /* #435 */
 
+/** Source of a packet time stamp */
+#define VOS_TS_APPLICATION  0u  /**< vos_getTime() after reading the packet                */
+#define VOS_TS_SOFTWARE     1u  /**< kernel software time stamp                            */
+#define VOS_TS_HARDWARE     2u  /**< network interface hardware time stamp                 */
+
 typedef fd_set VOS_FDS_T;
 
 typedef struct
@@ -524,6 +531,34 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
     UINT32      ipAddress,
     UINT16      port);
 
+/**********************************************************************************************************************/
+/** Send UDP data at a given time.
+ *  Like vos_sockSendUDP(). If the socket was created with the txTime option and the platform supports it, the packet
+ *  is queued in the kernel with its launch time (SO_TXTIME); a time based queueing discipline (fq, etf) on the
+ *  outgoing interface releases it then, others send it at once. A launch time not in the future sends at once.
+ *  The launch time clock is VOS_TXTIME_CLOCK (posix, default CLOCK_MONOTONIC for fq; CLOCK_TAI for etf).
+ *
+ *  @param[in]      sock               socket descriptor
+ *  @param[in]      pBuffer            pointer to data to send
+ *  @param[in,out]  pSize              In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress          destination IP
+ *  @param[in]      port               destination port
+ *  @param[in]      pTxTime            launch time (vos_getTime() time base), NULL to send at once
+ *
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter out of range/invalid
+ *  @retval         VOS_IO_ERR         data could not be sent
+ *  @retval         VOS_BLOCK_ERR      Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    VOS_SOCK_T          sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pTxTime);
+
 /**********************************************************************************************************************/
 /** Receive UDP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -559,6 +594,63 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     UINT32      *pSrcIFAddr,
     BOOL8       peek);
 
+/**********************************************************************************************************************/
+/** Receive UDP data with its receive time.
+ *  Like vos_sockReceiveUDP(), without peeking. If the socket was created with the timestamping option and the
+ *  platform supports it, the receive time is the kernel's (or the network interface's) time stamp of the packet,
+ *  converted to the vos_getTime() time base. Otherwise it is vos_getTime() after reading the packet.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[out]     pRxTime         pointer to receive time
+ *  @param[out]     pRxTimeSource   pointer to source of the receive time (VOS_TS_...), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTs (
+    VOS_SOCK_T      sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource);
+
+/**********************************************************************************************************************/
+/** Read one transmit time stamp of a socket.
+ *  Sockets created with the timestamping option get a time stamp for each sent packet, when it is handed to the
+ *  network interface. The stamps are numbered per socket in sending order, starting with 0. They have to be read
+ *  regularly, the kernel drops them when its queue is full. Never blocks.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pId             pointer to the number of the sent packet
+ *  @param[out]     pTxTime         pointer to transmit time (vos_getTime() time base)
+ *  @param[out]     pTxTimeSource   pointer to source of the transmit time (VOS_TS_...), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      time stamp returned
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_NODATA_ERR  no time stamp pending
+ *  @retval         VOS_UNKNOWN_ERR not supported on this platform
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveTxTime (
+    VOS_SOCK_T      sock,
+    UINT32          *pId,
+    VOS_TIMEVAL_T   *pTxTime,
+    UINT8           *pTxTimeSource);
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -828,6 +920,303 @@ EXT_DECL void vos_sockPrintOptions (
 /**********************************************************************************************************************/
 /**********************************************************************************************************************/
 
+#ifdef IO_URING_SUPPORT
+
+/*
+    Completion based socket I/O (Linux io_uring)
+
+    One ring serves all sockets of a session. Receive sockets get a multishot receive request, which stays armed and
+    delivers every datagram into a buffer of a ring owned pool; other sockets (MD) get a readiness poll. Sends are
+    queued and handed to the kernel in one call. All ring functions must be called from the same thread.
+*/
+
+#ifndef VOS_RING_ENTRIES
+#define VOS_RING_ENTRIES    256u    /**< Submission queue size, the completion queue is four times larger       */
+#endif
+#ifndef VOS_RING_BUFFERS
+#define VOS_RING_BUFFERS    256u    /**< Receive buffers in the pool (power of 2)                               */
+#endif
+
+typedef struct VOS_RING *VOS_RING_T;
+
+/**********************************************************************************************************************/
+/** Create a ring.
+ *
+ *  @param[in]      bufSize         size of one receive buffer (largest datagram)
+ *  @param[out]     pRing           pointer to ring handle returned
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_UNKNOWN_ERR io_uring or one of the needed features not supported by the kernel
+ */
+
+EXT_DECL VOS_ERR_T vos_ringCreate (
+    UINT32      bufSize,
+    VOS_RING_T  *pRing);
+
+/**********************************************************************************************************************/
+/** Cancel all requests and release a ring.
+ *
+ *  @param[in]      ring            ring handle
+ */
+
+EXT_DECL void vos_ringDestroy (
+    VOS_RING_T ring);
+
+/**********************************************************************************************************************/
+/** Set the sockets watched by the ring.
+ *  Sockets in the receive set get a multishot receive (UDP), sockets in the poll set a readiness poll. Requests of
+ *  sockets no longer in the sets are cancelled, ended requests are re-armed. The requests are handed to the kernel
+ *  with the next vos_ringSubmit() or vos_ringWait().
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      pRecvFds        sockets to receive from, may be NULL
+ *  @param[in]      pPollFds        sockets to poll, may be NULL
+ *  @param[in]      noDesc          highest socket descriptor in the sets
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_QUEUE_FULL_ERR  too many sockets
+ */
+
+EXT_DECL VOS_ERR_T vos_ringWatch (
+    VOS_RING_T      ring,
+    const VOS_FDS_T *pRecvFds,
+    const VOS_FDS_T *pPollFds,
+    VOS_SOCK_T      noDesc);
+
+/**********************************************************************************************************************/
+/** Queue an UDP datagram.
+ *  The data is read by the next vos_ringSubmit() or vos_ringWait() and must not change until then. The send never
+ *  blocks: if the socket buffer is full the datagram is dropped and counted.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to data to send
+ *  @param[in]      size            size of the data to send
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      submission queue full and could not be flushed
+ */
+
+EXT_DECL VOS_ERR_T vos_ringSendUDP (
+    VOS_RING_T  ring,
+    VOS_SOCK_T  sock,
+    const UINT8 *pBuffer,
+    UINT32      size,
+    UINT32      ipAddress,
+    UINT16      port);
+
+/**********************************************************************************************************************/
+/** Hand the queued requests to the kernel, without waiting.
+ *  Queued datagrams are sent when the call returns.
+ *
+ *  @param[in]      ring            ring handle
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_IO_ERR      io_uring_enter() failed
+ */
+
+EXT_DECL VOS_ERR_T vos_ringSubmit (
+    VOS_RING_T ring);
+
+/**********************************************************************************************************************/
+/** Hand the queued requests to the kernel and wait for a completion.
+ *  Returns at once if completions are pending, without a system call.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      pTimeout        maximum time to wait
+ *
+ *  @retval         VOS_NO_ERR      completion pending
+ *  @retval         VOS_TIMEOUT_ERR no completion within the time
+ *  @retval         VOS_IO_ERR      io_uring_enter() failed
+ */
+
+EXT_DECL VOS_ERR_T vos_ringWait (
+    VOS_RING_T          ring,
+    const VOS_TIMEVAL_T *pTimeout);
+
+/**********************************************************************************************************************/
+/** Get the next received UDP datagram.
+ *  Completions of sends and polls met on the way are consumed, ready polled sockets are collected for
+ *  vos_ringGetReady(). Datagrams larger than the buffer are dropped.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pSock           pointer to the receiving socket
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           In: size of the buffer, Out: size of the datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[out]     pRxTime         pointer to receive time (vos_getTime() time base)
+ *  @param[out]     pRxTimeSource   pointer to source of the receive time (VOS_TS_...)
+ *
+ *  @retval         VOS_NO_ERR      datagram returned
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_NODATA_ERR  no more completions
+ */
+
+EXT_DECL VOS_ERR_T vos_ringReceiveUDP (
+    VOS_RING_T      ring,
+    VOS_SOCK_T      *pSock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource);
+
+/**********************************************************************************************************************/
+/** Get the polled sockets which became ready, as select() would return them.
+ *  Call after vos_ringReceiveUDP() returned VOS_NODATA_ERR. The collected sockets are cleared.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pReadyFds       set of ready sockets
+ *
+ *  @retval         number of ready sockets
+ */
+
+EXT_DECL INT32 vos_ringGetReady (
+    VOS_RING_T  ring,
+    VOS_FDS_T   *pReadyFds);
+
+/**********************************************************************************************************************/
+/** Get the ring counters.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pEnters         pointer to number of io_uring_enter() calls
+ *  @param[out]     pSendErrors     pointer to number of datagrams not sent
+ */
+
+EXT_DECL void vos_ringGetStatistics (
+    VOS_RING_T  ring,
+    UINT32      *pEnters,
+    UINT32      *pSendErrors);
+
+#endif
+
+/**********************************************************************************************************************/
+/**********************************************************************************************************************/
+
+#ifdef PACKET_MMAP_SUPPORT
+
+/*
+    Memory mapped receive ring (Linux AF_PACKET, TPACKET_V3)
+
+    The kernel copies every unfragmented IPv4 UDP datagram to the given port into a ring of blocks shared with the
+    process, filtered by BPF before the copy. A block is handed over when it is full or after VOS_PKT_RING_TIMEOUT ms,
+    which is the added latency at low packet rates. The UDP sockets still bind and join the multicast groups, but are
+    opened with the noReceive option, so they do not queue the datagrams a second time. Needs CAP_NET_RAW.
+    A ring bound to an interface does not see unicast datagrams of the own host (they pass the loopback interface).
+*/
+
+#ifndef VOS_PKT_RING_BLOCK_SIZE
+#define VOS_PKT_RING_BLOCK_SIZE (1u << 18)  /**< Size of a ring block (multiple of the page size)               */
+#endif
+#ifndef VOS_PKT_RING_BLOCKS
+#define VOS_PKT_RING_BLOCKS     16u         /**< Number of ring blocks                                          */
+#endif
+#ifndef VOS_PKT_RING_TIMEOUT
+#define VOS_PKT_RING_TIMEOUT    1u          /**< ms until a partly filled block is handed over                  */
+#endif
+
+typedef struct VOS_PKT_RING *VOS_PKT_RING_T;
+
+/**********************************************************************************************************************/
+/** Create a receive ring.
+ *
+ *  @param[in]      ifAddr          IP address of the interface to receive from, VOS_INADDR_ANY: all interfaces
+ *  @param[in]      port            UDP destination port to receive
+ *  @param[out]     pRing           pointer to ring handle returned
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error or no interface with that address
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    packet socket or ring not available (no CAP_NET_RAW)
+ */
+
+EXT_DECL VOS_ERR_T vos_pktRingCreate (
+    UINT32          ifAddr,
+    UINT16          port,
+    VOS_PKT_RING_T  *pRing);
+
+/**********************************************************************************************************************/
+/** Release a receive ring.
+ *
+ *  @param[in]      ring            ring handle
+ */
+
+EXT_DECL void vos_pktRingDestroy (
+    VOS_PKT_RING_T ring);
+
+/**********************************************************************************************************************/
+/** Get the socket of a receive ring, to wait for it with vos_select().
+ *  It becomes readable when a block has been handed over.
+ *
+ *  @param[in]      ring            ring handle
+ *
+ *  @retval         socket descriptor
+ */
+
+EXT_DECL VOS_SOCK_T vos_pktRingGetSocket (
+    VOS_PKT_RING_T ring);
+
+/**********************************************************************************************************************/
+/** Get the next received UDP datagram out of the ring.
+ *  The ring block is returned to the kernel when all its datagrams are read. Sent packets (seen on the same
+ *  interface) and datagrams larger than the buffer are skipped.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           In: size of the buffer, Out: size of the datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[out]     pRxTime         pointer to receive time (vos_getTime() time base)
+ *  @param[out]     pRxTimeSource   pointer to source of the receive time (VOS_TS_...)
+ *
+ *  @retval         VOS_NO_ERR      datagram returned
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_NODATA_ERR  no more datagrams
+ */
+
+EXT_DECL VOS_ERR_T vos_pktRingReceiveUDP (
+    VOS_PKT_RING_T  ring,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource);
+
+/**********************************************************************************************************************/
+/** Get the ring counters.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pPackets        pointer to number of packets passed by the filter
+ *  @param[out]     pDrops          pointer to number of packets dropped, ring full
+ */
+
+EXT_DECL void vos_pktRingGetStatistics (
+    VOS_PKT_RING_T  ring,
+    UINT32          *pPackets,
+    UINT32          *pDrops);
+
+#endif
+
+/**********************************************************************************************************************/
+/**********************************************************************************************************************/
+
 #ifdef __cplusplus
 }
 #endif
@@ -144,6 +144,32 @@ typedef struct VOS_SEMA *VOS_SEMA_T;
 /** Hidden thread handle definition    */
 typedef void *VOS_THREAD_T;
 
+/** Catch-up policy of a cyclic thread after an overrun    */
+typedef enum
+{
+    VOS_THREAD_CATCHUP_SKIP = 0,        /*  Drop the missed cycles, continue on the next cycle boundary (default) */
+    VOS_THREAD_CATCHUP_COMPRESS         /*  Run the missed cycles back to back until the schedule is met again   */
+} VOS_THREAD_CATCHUP_T;
+
+/** Wakeup latency buckets of a cyclic thread: up to 10, 25, 50, 100, 250, 500, 1000 us and later    */
+#define VOS_THREAD_LATENCY_BUCKETS  8u
+
+/** Timing statistics of a cyclic thread, times in us    */
+typedef struct
+{
+    UINT32                  interval;           /**< cycle time                                                  */
+    VOS_THREAD_CATCHUP_T    catchUp;            /**< catch-up policy                                             */
+    UINT32                  cycles;             /**< executed cycles                                             */
+    UINT32                  overruns;           /**< cycles ending after the next cycle was due                  */
+    UINT32                  skipped;            /**< cycles dropped to catch up                                  */
+    UINT32                  execTimeMax;        /**< longest run of the thread function                          */
+    UINT32                  execTimeAvg;        /**< average run of the thread function                          */
+    UINT32                  wakeupLatencyMax;   /**< latest start of a cycle behind its due time                 */
+    UINT32                  wakeupLatency[VOS_THREAD_LATENCY_BUCKETS];  /**< cycles per wakeup latency bucket    */
+    INT64                   drift;              /**< lag of the executed cycles behind the nominal rate: start of
+                                                     the last cycle - start of the first - (cycles - 1) * interval */
+} VOS_THREAD_STATS_T;
+
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -267,6 +293,36 @@ EXT_DECL VOS_ERR_T vos_threadTerminate (
 EXT_DECL VOS_ERR_T vos_threadIsActive (
     VOS_THREAD_T thread);
 
+/**********************************************************************************************************************/
+/** Set the catch-up policy of a cyclic thread.
+ *  The policy decides what happens after an overrun, i.e. when a cycle ends after the next one was due:
+ *  VOS_THREAD_CATCHUP_SKIP (default) drops the missed cycles, VOS_THREAD_CATCHUP_COMPRESS runs them back to back.
+ *
+ *  @param[in]      thread            Handle of a cyclic thread
+ *  @param[in]      policy            Catch-up policy
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     unknown policy
+ *  @retval         VOS_NOINIT_ERR    not a cyclic thread (or no cyclic thread statistics on this target)
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetCatchUp (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CATCHUP_T    policy);
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *
+ *  @param[in]      thread            Handle of a cyclic thread
+ *  @param[out]     pStats            Pointer to returned statistics
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter error
+ *  @retval         VOS_NOINIT_ERR    not a cyclic thread (or no cyclic thread statistics on this target)
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T        thread,
+    VOS_THREAD_STATS_T  *pStats);
+
 #ifdef SIM
 /**********************************************************************************************************************/
 /** Register a existing TimeSync thread.
@@ -51,12 +51,30 @@ extern "C" {
 
 extern EXT_DECL VOS_PRINT_DBG_T gPDebugFunction; /* #413 */
 extern EXT_DECL void *gRefCon; /* #413 */
+extern EXT_DECL BOOL8 gVosLogAsync;     /**< TRUE while vos_logStart() defers the log output */
+extern EXT_DECL VOS_LOG_T gVosLogLevel; /**< Run time log level, see vos_setLogLevel() */
 
 /** String size definitions for the debug output functions */
 #define VOS_MAX_PRNT_STR_SIZE   256u         /**< Max. size of the debug/error string of debug function */
 #define VOS_MAX_FRMT_SIZE       64u          /**< Max. size of the 'format' part */
 #define VOS_MAX_ERR_STR_SIZE    (VOS_MAX_PRNT_STR_SIZE - VOS_MAX_FRMT_SIZE) /**< Max. size of the error part */
 
+/** Asynchronous log output */
+#define VOS_LOG_NUM_CATEGORIES  5u           /**< VOS_LOG_ERROR ... VOS_LOG_USR */
+#define VOS_LOG_DEFAULT_ENTRIES 256u         /**< Default number of ring entries (256 bytes each) */
+#define VOS_LOG_DEFAULT_RATE    {0u, 1000u, 1000u, 1000u, 0u} /**< Default max. entries per second and category */
+
+/** Compile time log level: output of less important categories is removed from the build.
+    E.g. -DVOS_LOG_MIN_LEVEL=VOS_LOG_WARNING keeps errors, warnings and VOS_LOG_USR output only. */
+#ifndef VOS_LOG_MIN_LEVEL
+#define VOS_LOG_MIN_LEVEL       VOS_LOG_DBG
+#endif
+
+/** TRUE if output of this category passes the compile time and the run time log level.
+    Evaluated before any formatting; constant FALSE for categories above VOS_LOG_MIN_LEVEL. */
+#define VOS_LOG_ENABLED(level)  (((level) == VOS_LOG_USR) ||                                  \
+                                 (((level) <= VOS_LOG_MIN_LEVEL) && ((level) <= gVosLogLevel)))
+
 /** This is a helper define for separating a path in debug output */
 #if (defined (WIN32) || defined (WIN64))
 #define VOS_DIR_SEP     '\\'
@@ -84,38 +102,57 @@ extern EXT_DECL void *gRefCon; /* #413 */
 #endif
 
 /** Debug output macro without formatting options */
-#define vos_printLogStr(level, string)  {if (gPDebugFunction != NULL)         \
-                                         {gPDebugFunction(gRefCon,            \
-                                                          (level),            \
-                                                          vos_getTimeStamp(), \
-                                                          (__FILE__),         \
-                                                          (UINT16)(__LINE__), \
-                                                          (string)); }}
+#define vos_printLogStr(level, string)  {if (VOS_LOG_ENABLED(level) && (gPDebugFunction != NULL)) \
+                                         {if (gVosLogAsync == TRUE)                             \
+                                          {vos_logRecord((level), (__FILE__), (UINT16)(__LINE__), \
+                                                         "%s", (string)); }                     \
+                                          else                                                  \
+                                          {gPDebugFunction(gRefCon,                             \
+                                                           (level),                             \
+                                                           vos_getTimeStamp(),                  \
+                                                           (__FILE__),                          \
+                                                           (UINT16)(__LINE__),                  \
+                                                           (string)); }}}
 
 /** Debug output macro with formatting options */
 #if (defined (WIN32) || defined (WIN64))
-    #define vos_printLog(level, format, ...)                                   \
-    {if (gPDebugFunction != NULL)                                              \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                                      \
-         (void) _snprintf_s(str, sizeof(str), _TRUNCATE, format, __VA_ARGS__); \
-         vos_printLogStr(level, str);                                          \
-     }                                                                         \
+    #define vos_printLog(level, format, ...)                                       \
+    {if (VOS_LOG_ENABLED(level) && (gPDebugFunction != NULL))                      \
+     {   if (gVosLogAsync == TRUE)                                                 \
+         {   vos_logRecord((level), (__FILE__), (UINT16)(__LINE__), format, __VA_ARGS__); \
+         }                                                                         \
+         else                                                                      \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                      \
+             (void) _snprintf_s(str, sizeof(str), _TRUNCATE, format, __VA_ARGS__); \
+             vos_printLogStr(level, str);                                          \
+         }                                                                         \
+     }                                                                             \
     }
 #elif defined(__clang__)
-    #define vos_printLog(level, format, ...)                    \
-    {if (gPDebugFunction != NULL)                               \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                       \
-         (void)snprintf(str, sizeof(str), format, __VA_ARGS__); \
-         vos_printLogStr(level, str);                           \
-     }                                                          \
+    #define vos_printLog(level, format, ...)                                                  \
+    {if (VOS_LOG_ENABLED(level) && (gPDebugFunction != NULL))                                 \
+     {   if (gVosLogAsync == TRUE)                                                            \
+         {   vos_logRecord((level), (__FILE__), (UINT16)(__LINE__), format, __VA_ARGS__);     \
+         }                                                                                    \
+         else                                                                                 \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                                 \
+             (void)snprintf(str, sizeof(str), format, __VA_ARGS__);                           \
+             vos_printLogStr(level, str);                                                     \
+         }                                                                                    \
+     }                                                                                        \
     }
 #else
-    #define vos_printLog(level, format, args ...)            \
-    {if (gPDebugFunction != NULL)                            \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                    \
-         (void) snprintf(str, sizeof(str), format, ## args); \
-         vos_printLogStr(level, str);                        \
-     }                                                       \
+    #define vos_printLog(level, format, args ...)                                         \
+    {if (VOS_LOG_ENABLED(level) && (gPDebugFunction != NULL))                             \
+     {   if (gVosLogAsync == TRUE)                                                        \
+         {   vos_logRecord((level), (__FILE__), (UINT16)(__LINE__), format, ## args);     \
+         }                                                                                \
+         else                                                                             \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                             \
+             (void) snprintf(str, sizeof(str), format, ## args);                          \
+             vos_printLogStr(level, str);                                                 \
+         }                                                                                \
+     }                                                                                    \
     }
 #endif
 
@@ -180,6 +217,21 @@ extern EXT_DECL void *gRefCon; /* #413 */
  * TYPEDEFS
  */
 
+/** Configuration of the asynchronous log output */
+typedef struct
+{
+    UINT32  numEntries;                             /**< ring entries, rounded up to a power of 2, 0 = default */
+    UINT32  maxPerSecond[VOS_LOG_NUM_CATEGORIES];   /**< max. entries per second and category, 0 = unlimited */
+} VOS_LOG_CONFIG_T;
+
+/** Statistics of the asynchronous log output */
+typedef struct
+{
+    UINT32  numRecorded;                            /**< entries recorded */
+    UINT32  numDroppedFull;                         /**< entries dropped because the ring was full */
+    UINT32  numDroppedRate[VOS_LOG_NUM_CATEGORIES]; /**< entries dropped by the rate limit, per category */
+} VOS_LOG_STATISTICS_T;
+
 /***********************************************************************************************************************
  * PROTOTYPES
  */
@@ -273,6 +325,74 @@ EXT_DECL const VOS_VERSION_T *vos_getVersion (void);
 
 EXT_DECL const CHAR8 *vos_getErrorString (VOS_ERR_T error);
 
+/**********************************************************************************************************************/
+/** Set the run time log level.
+ *  vos_printLog() and vos_printLogStr() drop output of less important categories before formatting it.
+ *  VOS_LOG_USR output is never dropped. Categories above VOS_LOG_MIN_LEVEL are removed at compile time and
+ *  cannot be enabled here.
+ *
+ *  @param[in]      level           Least important category to output, VOS_LOG_DBG (default) outputs everything
+ */
+
+EXT_DECL void vos_setLogLevel (
+    VOS_LOG_T level);
+
+/**********************************************************************************************************************/
+/** Defer the log output to a background thread.
+ *  From now on vos_printLog() and vos_printLogStr() only record the format string, the time and the raw arguments
+ *  into a lock-free ring. A background thread formats the entries and calls the debug output function passed to
+ *  vos_init(), hence that function is no longer called by the thread that logs.
+ *  Entries exceeding the rate limit of their category or finding the ring full are dropped and counted; the
+ *  output thread reports drops with a warning. Logging never blocks.
+ *  The format of vos_printLog() must be a string literal, it is referenced and not copied.
+ *    Needs GCC or clang atomics, other compilers return VOS_UNKNOWN_ERR and log synchronously.
+ *
+ *  @param[in]      pConfig         Ring size and rate limits, NULL for the defaults
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    already started
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_THREAD_ERR  output thread could not be created
+ *  @retval         VOS_UNKNOWN_ERR not supported by the compiler
+ */
+
+EXT_DECL VOS_ERR_T vos_logStart (
+    const VOS_LOG_CONFIG_T *pConfig);
+
+/**********************************************************************************************************************/
+/** Output the recorded entries and return to synchronous log output.
+ *  Also called by vos_terminate().
+ */
+
+EXT_DECL void vos_logStop (void);
+
+/**********************************************************************************************************************/
+/** Return the counters of the asynchronous log output (kept until the next vos_logStart()).
+ *
+ *  @param[out]     pStatistics     Pointer to the statistics
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+
+EXT_DECL VOS_ERR_T vos_logGetStatistics (
+    VOS_LOG_STATISTICS_T *pStatistics);
+
+/**********************************************************************************************************************/
+/** Record a log entry, used by vos_printLog() while the output is asynchronous.
+ *
+ *  @param[in]      category        Log category
+ *  @param[in]      pFile           Source file (string literal)
+ *  @param[in]      line            Source line
+ *  @param[in]      pFormat         printf format (string literal)
+ *  @param[in]      ...             Arguments
+ */
+
+EXT_DECL void vos_logRecord (
+    VOS_LOG_T   category,
+    const CHAR8 *pFile,
+    UINT16      line,
+    const CHAR8 *pFormat,
+    ...);
+
 
 
 #ifdef __cplusplus
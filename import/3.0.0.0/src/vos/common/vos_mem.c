@@ -61,6 +61,15 @@
 #define PTHREAD_MUTEX_INITIALIZER  0 /* Dummy */
 #endif
 
+/* Lock-free queues need the GCC atomic builtins and futexes */
+#if defined(__linux__) && defined(__GNUC__)
+#define VOS_QUEUE_LOCKFREE
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <sched.h>
+#endif
+
 #include "vos_types.h"
 #include "vos_utils.h"
 #include "vos_mem.h"
@@ -119,6 +128,25 @@ typedef struct
     UINT32  queuReadErrCnt;      /* No of queue read errors */
 } VOS_STATISTIC;
 
+#ifdef VOS_QUEUE_LOCKFREE
+#define VOS_QUEUE_CACHE_LINE    64u     /* keeps the producer and consumer positions apart */
+
+/* Position of the producers or the consumers of a lock-free queue, on its own cache line (see vos_queueAlloc) */
+typedef struct
+{
+    UINT32  pos;                        /* next message to send / receive */
+    UINT32  cached;                     /* SPSC: last seen position of the other side */
+} __attribute__ ((aligned (VOS_QUEUE_CACHE_LINE))) VOS_QUEUE_POS_T;
+
+/* Cell of a lock-free queue */
+typedef struct
+{
+    UINT32  seq;                        /* MPMC: position the cell is ready for (send: pos, receive: pos + 1) */
+    UINT32  size;
+    UINT8   *pData;
+} VOS_QUEUE_CELL_T;
+#endif
+
 /* Queue header struct */
 struct VOS_QUEUE
 {
@@ -130,6 +158,16 @@ struct VOS_QUEUE
     VOS_SEMA_T              semaphore;
     VOS_MUTEX_T             mutex;
     struct VOS_QUEUE_ELEM   *pQueue;
+#ifdef VOS_QUEUE_LOCKFREE
+    /* Lock-free ring (VOS_QUEUE_POLICY_SPSC, VOS_QUEUE_POLICY_MPMC), no mutex and semaphore */
+    void                    *pAlloc;    /* memory block the header was placed in */
+    UINT32                  mask;       /* capacity - 1, capacity is a power of two */
+    VOS_QUEUE_CELL_T        *pCell;
+    UINT32                  sleeping;   /* set by receivers about to wait, cleared by the sender waking them */
+    UINT32                  event;      /* futex word, bumped when a sender wakes the receivers */
+    VOS_QUEUE_POS_T         tail;       /* producers */
+    VOS_QUEUE_POS_T         head;       /* consumers */
+#endif
 };
 
 /* Queue element struct */
@@ -150,6 +188,270 @@ const UINT32    cQueueMagic = 0xE5E1E5E1;
 
 static MEM_CONTROL_T gMem;
 
+/**********************************************************************************************************************/
+/** Allocate a queue header.
+ *  The header is placed on a cache line boundary, vos_memAlloc() does not align that far.
+ *
+ *  @retval         queue header or NULL
+ */
+static VOS_QUEUE_T vos_queueAlloc (void)
+{
+#ifdef VOS_QUEUE_LOCKFREE
+    UINT8       *pMem = (UINT8 *) vos_memAlloc(sizeof(struct VOS_QUEUE) + VOS_QUEUE_CACHE_LINE);
+    VOS_QUEUE_T pQueue;
+
+    if (pMem == NULL)
+    {
+        return NULL;
+    }
+    pQueue = (VOS_QUEUE_T) (pMem + VOS_QUEUE_CACHE_LINE - ((size_t) pMem % VOS_QUEUE_CACHE_LINE));
+    pQueue->pAlloc = pMem;
+    return pQueue;
+#else
+    return (VOS_QUEUE_T) vos_memAlloc(sizeof(struct VOS_QUEUE));
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Free a queue header allocated by vos_queueAlloc().
+ *
+ *  @param[in]      pQueue          queue header
+ */
+static void vos_queueFree (VOS_QUEUE_T pQueue)
+{
+#ifdef VOS_QUEUE_LOCKFREE
+    vos_memFree(pQueue->pAlloc);
+#else
+    vos_memFree(pQueue);
+#endif
+}
+
+#ifdef VOS_QUEUE_LOCKFREE
+/**********************************************************************************************************************/
+/** Put a message into a lock-free queue.
+ *  SPSC: the producer owns tail, the consumer head; a slot is published by the release store of tail.
+ *  MPMC: bounded ring of D. Vyukov; a producer claims a position with CAS on tail if the cell's sequence shows it
+ *  free, and publishes the message by setting the sequence to position + 1.
+ *
+ *  @param[in]      pQueue          Queue
+ *  @param[in]      pData           Pointer to data
+ *  @param[in]      size            Size of data
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full
+ */
+static VOS_ERR_T vos_queueRingPut (
+    struct VOS_QUEUE    *pQueue,
+    UINT8               *pData,
+    UINT32              size)
+{
+    VOS_QUEUE_CELL_T    *pCell;
+    UINT32              pos = __atomic_load_n(&pQueue->tail.pos, __ATOMIC_RELAXED);
+    UINT32              seq;
+    INT32               diff;
+
+    if (pQueue->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        if ((pos - pQueue->tail.cached) > pQueue->mask)
+        {
+            /* Looks full, fetch the consumer position */
+            pQueue->tail.cached = __atomic_load_n(&pQueue->head.pos, __ATOMIC_ACQUIRE);
+            if ((pos - pQueue->tail.cached) > pQueue->mask)
+            {
+                return VOS_QUEUE_FULL_ERR;
+            }
+        }
+        pCell           = &pQueue->pCell[pos & pQueue->mask];
+        pCell->pData    = pData;
+        pCell->size     = size;
+        __atomic_store_n(&pQueue->tail.pos, pos + 1u, __ATOMIC_RELEASE);
+        return VOS_NO_ERR;
+    }
+
+    for (;; )
+    {
+        pCell   = &pQueue->pCell[pos & pQueue->mask];
+        seq     = __atomic_load_n(&pCell->seq, __ATOMIC_ACQUIRE);
+        diff    = (INT32) (seq - pos);
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&pQueue->tail.pos, &pos, pos + 1u, TRUE,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+            /* pos was reloaded by the failed exchange */
+        }
+        else if (diff < 0)
+        {
+            return VOS_QUEUE_FULL_ERR;  /* the cell still holds the message of the previous round */
+        }
+        else
+        {
+            pos = __atomic_load_n(&pQueue->tail.pos, __ATOMIC_RELAXED);
+        }
+    }
+    pCell->pData    = pData;
+    pCell->size     = size;
+    __atomic_store_n(&pCell->seq, pos + 1u, __ATOMIC_RELEASE);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Take a message from a lock-free queue, counterpart of vos_queueRingPut().
+ *
+ *  @param[in]      pQueue          Queue
+ *  @param[out]     ppData          Pointer to data pointer
+ *  @param[out]     pSize           Size of data
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+static VOS_ERR_T vos_queueRingTake (
+    struct VOS_QUEUE    *pQueue,
+    UINT8               * *ppData,
+    UINT32              *pSize)
+{
+    VOS_QUEUE_CELL_T    *pCell;
+    UINT32              pos = __atomic_load_n(&pQueue->head.pos, __ATOMIC_RELAXED);
+    UINT32              seq;
+    INT32               diff;
+
+    if (pQueue->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        if (pos == pQueue->head.cached)
+        {
+            /* Looks empty, fetch the producer position */
+            pQueue->head.cached = __atomic_load_n(&pQueue->tail.pos, __ATOMIC_ACQUIRE);
+            if (pos == pQueue->head.cached)
+            {
+                return VOS_QUEUE_ERR;
+            }
+        }
+        pCell   = &pQueue->pCell[pos & pQueue->mask];
+        *ppData = pCell->pData;
+        *pSize  = pCell->size;
+        __atomic_store_n(&pQueue->head.pos, pos + 1u, __ATOMIC_RELEASE);
+        return VOS_NO_ERR;
+    }
+
+    for (;; )
+    {
+        pCell   = &pQueue->pCell[pos & pQueue->mask];
+        seq     = __atomic_load_n(&pCell->seq, __ATOMIC_ACQUIRE);
+        diff    = (INT32) (seq - (pos + 1u));
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&pQueue->head.pos, &pos, pos + 1u, TRUE,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return VOS_QUEUE_ERR;       /* nothing sent to this cell yet */
+        }
+        else
+        {
+            pos = __atomic_load_n(&pQueue->head.pos, __ATOMIC_RELAXED);
+        }
+    }
+    *ppData = pCell->pData;
+    *pSize  = pCell->size;
+    __atomic_store_n(&pCell->seq, pos + pQueue->mask + 1u, __ATOMIC_RELEASE);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait for a message on an empty lock-free queue.
+ *  A receiver sets sleeping before it checks the queue a last time; a sender clears it after publishing (both behind
+ *  a full barrier), so either the receiver finds the message or the sender bumps event and wakes it. Only the first
+ *  send after a receiver went to sleep pays for the wakeup. Before that the receiver yields once, so senders ready
+ *  to run (on the same CPU) can fill the queue instead of waking the receiver for every message.
+ *
+ *  @param[in]      pQueue          Queue
+ *  @param[out]     ppData          Pointer to data pointer
+ *  @param[out]     pSize           Size of data
+ *  @param[in]      usTimeout       Maximum time to wait in usec, VOS_SEMA_WAIT_FOREVER: no limit
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_QUEUE_ERR   no message within the timeout
+ */
+static VOS_ERR_T vos_queueRingWait (
+    struct VOS_QUEUE    *pQueue,
+    UINT8               * *ppData,
+    UINT32              *pSize,
+    UINT32              usTimeout)
+{
+    VOS_ERR_T       retVal = VOS_QUEUE_ERR;
+    struct timespec deadline;
+    struct timespec now;
+    struct timespec remaining;
+    UINT32          event;
+
+    (void) sched_yield();
+    (void) clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec     += (time_t) (usTimeout / 1000000u);
+    deadline.tv_nsec    += (long) (usTimeout % 1000000u) * 1000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    for (;; )
+    {
+        event = __atomic_load_n(&pQueue->event, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&pQueue->sleeping, 1u, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        retVal = vos_queueRingTake(pQueue, ppData, pSize);
+        if (retVal == VOS_NO_ERR)
+        {
+            break;
+        }
+        if (usTimeout == VOS_SEMA_WAIT_FOREVER)
+        {
+            (void) syscall(SYS_futex, &pQueue->event, FUTEX_WAIT_PRIVATE, event, NULL, NULL, 0);
+            continue;
+        }
+        (void) clock_gettime(CLOCK_MONOTONIC, &now);
+        remaining.tv_sec    = deadline.tv_sec - now.tv_sec;
+        remaining.tv_nsec   = deadline.tv_nsec - now.tv_nsec;
+        if (remaining.tv_nsec < 0)
+        {
+            remaining.tv_sec--;
+            remaining.tv_nsec += 1000000000;
+        }
+        if (remaining.tv_sec < 0)
+        {
+            break;
+        }
+        (void) syscall(SYS_futex, &pQueue->event, FUTEX_WAIT_PRIVATE, event, &remaining, NULL, 0);
+    }
+    return retVal;
+}
+
+/**********************************************************************************************************************/
+/** Wake the receivers waiting on a lock-free queue after a message was sent.
+ *
+ *  @param[in]      pQueue          Queue
+ *
+ *  @retval         none
+ */
+static void vos_queueRingWake (
+    struct VOS_QUEUE *pQueue)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if ((__atomic_load_n(&pQueue->sleeping, __ATOMIC_RELAXED) != 0u)
+        && (__atomic_exchange_n(&pQueue->sleeping, 0u, __ATOMIC_SEQ_CST) != 0u))
+    {
+        (void) __atomic_fetch_add(&pQueue->event, 1u, __ATOMIC_SEQ_CST);
+        (void) syscall(SYS_futex, &pQueue->event, FUTEX_WAKE_PRIVATE, INT32_MAX, NULL, NULL, 0);
+    }
+}
+#endif
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -788,16 +1090,61 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
 
     /* Check parameters */
     if ((queueType < VOS_QUEUE_POLICY_OTHER)
-        || (queueType > VOS_QUEUE_POLICY_LIFO)
+        || (queueType > VOS_QUEUE_POLICY_MPMC)
         || (pQueueHandle == NULL)
-        || (maxNoOfMsg == 0))
+        || (maxNoOfMsg == 0)
+        || (maxNoOfMsg > 0x80000000u))
     {
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if ((queueType == VOS_QUEUE_POLICY_SPSC) || (queueType == VOS_QUEUE_POLICY_MPMC))
+    {
+#ifdef VOS_QUEUE_LOCKFREE
+        UINT32 capacity = 1u;
+        UINT32 i;
+
+        while (capacity < maxNoOfMsg)
+        {
+            capacity <<= 1;
+        }
+        (*pQueueHandle) = vos_queueAlloc();
+        if (*pQueueHandle == NULL)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR could not allocate memory\n");
+            retVal = VOS_MEM_ERR;
+        }
+        else
+        {
+            (*pQueueHandle)->pCell = (VOS_QUEUE_CELL_T *) vos_memAlloc(capacity * sizeof(VOS_QUEUE_CELL_T));
+            if ((*pQueueHandle)->pCell == NULL)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR could not allocate memory\n");
+                vos_queueFree(*pQueueHandle);
+                *pQueueHandle   = NULL;
+                retVal          = VOS_MEM_ERR;
+            }
+            else
+            {
+                for (i = 0u; i < capacity; i++)
+                {
+                    (*pQueueHandle)->pCell[i].seq = i;
+                }
+                (*pQueueHandle)->queueType      = queueType;
+                (*pQueueHandle)->maxNoOfMsg     = capacity;
+                (*pQueueHandle)->mask           = capacity - 1u;
+                (*pQueueHandle)->magicNumber    = cQueueMagic;
+                retVal = VOS_NO_ERR;
+            }
+        }
+#else
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR lock-free queues not supported\n");
+        retVal = VOS_INIT_ERR;
+#endif
+    }
     else
     {
-        (*pQueueHandle) = (VOS_QUEUE_T) vos_memAlloc(sizeof(struct VOS_QUEUE));
+        (*pQueueHandle) = vos_queueAlloc();
         if (*pQueueHandle == NULL)
         {
             vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreate() ERROR could not allocate memory\n");
@@ -898,6 +1245,16 @@ EXT_DECL VOS_ERR_T vos_queueSend (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueSend() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+#ifdef VOS_QUEUE_LOCKFREE
+    else if (queueHandle->pCell != NULL)
+    {
+        retVal = vos_queueRingPut(queueHandle, pData, size);
+        if (retVal == VOS_NO_ERR)
+        {
+            vos_queueRingWake(queueHandle);
+        }
+    }
+#endif
     else
     {
         err = vos_mutexLock(queueHandle->mutex);
@@ -1009,6 +1366,21 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+#ifdef VOS_QUEUE_LOCKFREE
+    else if (queueHandle->pCell != NULL)
+    {
+        retVal = vos_queueRingTake(queueHandle, ppData, pSize);
+        if ((retVal != VOS_NO_ERR) && (usTimeout != 0u))
+        {
+            retVal = vos_queueRingWait(queueHandle, ppData, pSize, usTimeout);
+        }
+        if (retVal != VOS_NO_ERR)
+        {
+            *ppData = NULL;
+            *pSize  = 0;
+        }
+    }
+#endif
     else
     {
         /* wait for semaphore indicating new message in queue */
@@ -1093,6 +1465,16 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueDestroy() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+#ifdef VOS_QUEUE_LOCKFREE
+    else if (queueHandle->pCell != NULL)
+    {
+        /* No receiver may be waiting any more */
+        queueHandle->magicNumber = 0;
+        vos_memFree(queueHandle->pCell);
+        vos_queueFree(queueHandle);
+        retVal = VOS_NO_ERR;
+    }
+#endif
     else
     {
         err = vos_mutexLock(queueHandle->mutex);
@@ -1117,7 +1499,7 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
         else
         {
             vos_mutexDelete(queueHandle->mutex);
-            vos_memFree(queueHandle);
+            vos_queueFree(queueHandle);
             retVal = VOS_NO_ERR;
         }
     }
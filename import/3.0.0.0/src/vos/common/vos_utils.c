@@ -6,6 +6,15 @@
  *
  * @details         Common functions of the abstraction layer. Mainly debugging support.
  *
+ *                  While vos_logStart() is active, vos_printLog() does not format on the calling thread. It records
+ *                  a binary entry, consisting of the format string pointer (the format is a literal and identifies
+ *                  the message), the time and the raw arguments, into a bounded multi-producer ring. A background
+ *                  thread formats the entries and calls the debug output function. Producers never wait: an entry
+ *                  beyond the rate limit of its category, or finding the ring full, is dropped and counted.
+ *                  The arguments are stored in format order: int (also for '*' width and precision), 64 bit for
+ *                  l, ll, j, z, t integers, double, pointer and copied strings. Entries are 256 bytes, arguments
+ *                  not fitting are cut and the message ends with "...".
+ *
  * @note            Project: TCNOpen TRDP prototype stack
  *
  * @author          Bernd Loehr, NewTec GmbH
@@ -34,6 +43,10 @@
  */
 
 #include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
 
 #include "vos_utils.h"
 #include "vos_sock.h"
@@ -52,12 +65,91 @@
 
 #define NO_OF_ERROR_STRINGS  52u
 
+/* The asynchronous log output relies on the compiler's atomic builtins */
+#if defined(__GNUC__) || defined(__clang__)
+#define VOS_LOG_ASYNC_SUPPORT
+#define VOS_LOG_LOAD(p)         __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define VOS_LOG_STORE(p, v)     __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define VOS_LOG_CAS(p, pOld, v) __atomic_compare_exchange_n((p), (pOld), (v), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define VOS_LOG_INC(p)          __atomic_add_fetch((p), 1u, __ATOMIC_SEQ_CST)
+#define VOS_LOG_DEC(p)          __atomic_sub_fetch((p), 1u, __ATOMIC_SEQ_CST)
+#endif
+
+#define VOS_LOG_ENTRY_SIZE      256u        /**< Size of a ring entry                                          */
+#define VOS_LOG_MIN_ENTRIES     16u         /**< Smallest ring                                                 */
+#define VOS_LOG_IDLE_DELAY      10000u      /**< Poll interval of the output thread on an empty ring [us]      */
+#define VOS_LOG_STOP_LOOPS      200u        /**< Idle delays vos_logStop() waits for the output thread         */
+#define VOS_LOG_SPEC_SIZE       32u         /**< Max. size of a single conversion specification                */
+
+/** Kind of the argument of a conversion */
+typedef enum
+{
+    VOS_LOG_ARG_NONE,                       /**< "%%"                                  */
+    VOS_LOG_ARG_INT,                        /**< int, also hh and h                    */
+    VOS_LOG_ARG_INT64,                      /**< l, ll, j, z, t integers, stored 64 bit */
+    VOS_LOG_ARG_DOUBLE,                     /**< floating point, L is stored as double */
+    VOS_LOG_ARG_PTR,                        /**< %p, %n (never written)                */
+    VOS_LOG_ARG_STR,                        /**< %s, copied                            */
+    VOS_LOG_ARG_INVALID                     /**< unsupported, ends the message         */
+} VOS_LOG_ARG_T;
+
+/** One conversion specification of a format */
+typedef struct
+{
+    UINT32          len;                    /**< length including the '%'              */
+    UINT32          modOfs;                 /**< offset of the length modifier         */
+    UINT32          modLen;                 /**< length of the length modifier         */
+    UINT32          precOfs;                /**< offset of the precision's '.', 0: none */
+    CHAR8           conv;                   /**< conversion character                  */
+    VOS_LOG_ARG_T   kind;
+} VOS_LOG_SPEC_T;
+
+/** Header of a ring entry */
+typedef struct
+{
+    UINT32          seq;                    /**< ring position + 1 when filled, + size when free */
+    UINT16          line;
+    UINT8           category;
+    UINT8           truncated;              /**< arguments were cut                    */
+    UINT32          argSize;                /**< bytes used in args                    */
+    const CHAR8     *pFile;
+    const CHAR8     *pFormat;
+    VOS_TIMEVAL_T   time;
+} VOS_LOG_HEADER_T;
+
+/** Ring entry */
+typedef struct
+{
+    VOS_LOG_HEADER_T    hdr;
+    UINT8               args[VOS_LOG_ENTRY_SIZE - sizeof(VOS_LOG_HEADER_T)];
+} VOS_LOG_ENTRY_T;
+
+/** Ring and output thread */
+typedef struct
+{
+    VOS_LOG_ENTRY_T         *pRing;
+    UINT32                  mask;                                   /**< number of entries - 1         */
+    UINT32                  head;                                   /**< next position to record       */
+    UINT32                  tail;                                   /**< next position to output       */
+    UINT32                  writers;                                /**< producers inside vos_logRecord */
+    UINT32                  maxPerSecond[VOS_LOG_NUM_CATEGORIES];
+    UINT32                  window[VOS_LOG_NUM_CATEGORIES];         /**< second of the counts below    */
+    UINT32                  count[VOS_LOG_NUM_CATEGORIES];          /**< entries in that second        */
+    UINT32                  reported;                               /**< drops already reported        */
+    VOS_LOG_STATISTICS_T    stats;
+    VOS_THREAD_T            thread;
+    BOOL8                   stop;
+    BOOL8                   stopped;
+} VOS_LOG_RING_T;
+
 /***********************************************************************************************************************
  * GLOBALS
  */
 
 VOS_PRINT_DBG_T gPDebugFunction = NULL;
 void *gRefCon = NULL;
+BOOL8 gVosLogAsync = FALSE;
+VOS_LOG_T gVosLogLevel = VOS_LOG_DBG;
 
 /***********************************************************************************************************************
  *  LOCALS
@@ -448,6 +540,556 @@ static VOS_ERR_T vos_initRuntimeConsts (void)
 #endif
 }
 
+#ifdef VOS_LOG_ASYNC_SUPPORT
+
+static VOS_LOG_RING_T gLog;
+
+/**********************************************************************************************************************/
+/** Parse the conversion specification starting at pFmt ('%')
+ */
+static void vosLogParseSpec (
+    const CHAR8     *pFmt,
+    VOS_LOG_SPEC_T  *pSpec)
+{
+    const CHAR8 *p = pFmt + 1;
+    const CHAR8 *pMod;
+
+    while ((*p != '\0') && (strchr("-+ #0'", *p) != NULL))
+    {
+        p++;
+    }
+    pSpec->precOfs = 0u;
+    while (((*p >= '0') && (*p <= '9')) || (*p == '*') || (*p == '.'))
+    {
+        if (*p == '.')
+        {
+            pSpec->precOfs = (UINT32) (p - pFmt);
+        }
+        p++;
+    }
+    pMod = p;
+    while ((*p != '\0') && (strchr("hlLqjzt", *p) != NULL))
+    {
+        p++;
+    }
+    pSpec->modOfs   = (UINT32) (pMod - pFmt);
+    pSpec->modLen   = (UINT32) (p - pMod);
+    pSpec->conv     = *p;
+    pSpec->len      = (UINT32) (p - pFmt) + ((*p != '\0') ? 1u : 0u);
+
+    switch (pSpec->conv)
+    {
+        case '%':
+            pSpec->kind = VOS_LOG_ARG_NONE;
+            break;
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            pSpec->kind = ((pSpec->modLen > 0u) && (strchr("lqjzt", *pMod) != NULL)) ?
+                VOS_LOG_ARG_INT64 : VOS_LOG_ARG_INT;
+            break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            pSpec->kind = VOS_LOG_ARG_DOUBLE;
+            break;
+        case 'p':
+        case 'n':
+            pSpec->kind = VOS_LOG_ARG_PTR;
+            break;
+        case 's':
+            pSpec->kind = (pSpec->modLen == 0u) ? VOS_LOG_ARG_STR : VOS_LOG_ARG_INVALID;
+            break;
+        default:
+            pSpec->kind = VOS_LOG_ARG_INVALID;
+            break;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Fetch an integer argument of at least 64 bit size
+ */
+static UINT64 vosLogIntArg (
+    const VOS_LOG_SPEC_T    *pSpec,
+    const CHAR8             *pFmt,
+    va_list                 *pAp)
+{
+    BOOL8       isSigned    = ((pSpec->conv == 'd') || (pSpec->conv == 'i')) ? TRUE : FALSE;
+    const CHAR8 *pMod       = pFmt + pSpec->modOfs;
+
+    switch (*pMod)
+    {
+        case 'j':
+            return (isSigned == TRUE) ? (UINT64) va_arg(*pAp, intmax_t) : (UINT64) va_arg(*pAp, uintmax_t);
+        case 'z':
+            return (UINT64) va_arg(*pAp, size_t);
+        case 't':
+            return (UINT64) va_arg(*pAp, ptrdiff_t);
+        case 'l':
+            if (pSpec->modLen == 1u)
+            {
+                return (isSigned == TRUE) ? (UINT64) va_arg(*pAp, long) : (UINT64) va_arg(*pAp, unsigned long);
+            }
+            /* "ll" */
+            return (UINT64) va_arg(*pAp, long long);
+        default:    /* 'q' */
+            return (UINT64) va_arg(*pAp, long long);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Append a value to the arguments of an entry
+ */
+static BOOL8 vosLogPut (
+    VOS_LOG_ENTRY_T *pEntry,
+    const void      *pValue,
+    UINT32          size)
+{
+    if (pEntry->hdr.argSize + size > sizeof(pEntry->args))
+    {
+        pEntry->hdr.truncated = TRUE;
+        return FALSE;
+    }
+    memcpy(&pEntry->args[pEntry->hdr.argSize], pValue, size);
+    pEntry->hdr.argSize += size;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Take the next value from the arguments of an entry
+ */
+static BOOL8 vosLogGet (
+    const VOS_LOG_ENTRY_T   *pEntry,
+    UINT32                  *pOfs,
+    void                    *pValue,
+    UINT32                  size)
+{
+    if (*pOfs + size > pEntry->hdr.argSize)
+    {
+        return FALSE;
+    }
+    memcpy(pValue, &pEntry->args[*pOfs], size);
+    *pOfs += size;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Store the arguments of a format into an entry
+ */
+static void vosLogPack (
+    VOS_LOG_ENTRY_T *pEntry,
+    const CHAR8     *pFormat,
+    va_list         *pAp)
+{
+    const CHAR8     *p = pFormat;
+    VOS_LOG_SPEC_T  spec;
+    BOOL8           ok = TRUE;
+    UINT32          i;
+    int             star = 0;
+
+    while ((ok == TRUE) && ((p = strchr(p, '%')) != NULL))
+    {
+        vosLogParseSpec(p, &spec);
+        for (i = 0u; (ok == TRUE) && (i < spec.len); i++)
+        {
+            if (p[i] == '*')
+            {
+                star = va_arg(*pAp, int);
+                ok = vosLogPut(pEntry, &star, sizeof(star));
+            }
+        }
+        if (ok == FALSE)
+        {
+            break;
+        }
+        switch (spec.kind)
+        {
+            case VOS_LOG_ARG_NONE:
+                break;
+            case VOS_LOG_ARG_INT:
+            {
+                int value = va_arg(*pAp, int);
+                ok = vosLogPut(pEntry, &value, sizeof(value));
+                break;
+            }
+            case VOS_LOG_ARG_INT64:
+            {
+                UINT64 value = vosLogIntArg(&spec, p, pAp);
+                ok = vosLogPut(pEntry, &value, sizeof(value));
+                break;
+            }
+            case VOS_LOG_ARG_DOUBLE:
+            {
+                double value = (p[spec.modOfs] == 'L') ? (double) va_arg(*pAp, long double) : va_arg(*pAp, double);
+                ok = vosLogPut(pEntry, &value, sizeof(value));
+                break;
+            }
+            case VOS_LOG_ARG_PTR:
+            {
+                void *value = va_arg(*pAp, void *);
+                ok = vosLogPut(pEntry, &value, sizeof(value));
+                break;
+            }
+            case VOS_LOG_ARG_STR:
+            {
+                const CHAR8 *pStr   = va_arg(*pAp, const CHAR8 *);
+                UINT32      avail   = (UINT32) sizeof(pEntry->args) - pEntry->hdr.argSize;
+                UINT32      maxLen  = 0xFFFFFFFFu;
+                UINT32      len;
+
+                /* With a precision the string need not be terminated: do not read beyond it */
+                if ((spec.precOfs != 0u) && (p[spec.precOfs + 1u] != '*'))
+                {
+                    maxLen = (UINT32) strtoul(&p[spec.precOfs + 1u], NULL, 10);
+                }
+                else if ((spec.precOfs != 0u) && (star >= 0))   /* the last '*', a negative one is none */
+                {
+                    maxLen = (UINT32) star;
+                }
+                if (pStr == NULL)
+                {
+                    pStr = "(null)";
+                }
+                len = 0u;
+                while ((len < maxLen) && (pStr[len] != '\0'))
+                {
+                    len++;
+                }
+                if (len >= avail)
+                {
+                    if (avail == 0u)
+                    {
+                        pEntry->hdr.truncated = TRUE;
+                        ok = FALSE;
+                        break;
+                    }
+                    len = avail - 1u;
+                    pEntry->hdr.truncated = TRUE;
+                    ok = FALSE;     /* keep the cut string, drop the rest */
+                }
+                memcpy(&pEntry->args[pEntry->hdr.argSize], pStr, len);
+                pEntry->args[pEntry->hdr.argSize + len] = '\0';
+                pEntry->hdr.argSize += len + 1u;
+                break;
+            }
+            default:
+                pEntry->hdr.truncated = TRUE;
+                ok = FALSE;
+                break;
+        }
+        p += spec.len;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Append n characters to the output string
+ */
+static void vosLogAppend (
+    CHAR8       *pStr,
+    UINT32      strSize,
+    UINT32      *pPos,
+    const CHAR8 *pText,
+    UINT32      n)
+{
+    if (*pPos + n >= strSize)
+    {
+        n = strSize - 1u - *pPos;
+    }
+    memcpy(&pStr[*pPos], pText, n);
+    *pPos += n;
+    pStr[*pPos] = '\0';
+}
+
+/**********************************************************************************************************************/
+/** Format an entry, like snprintf() would have done on the calling thread
+ */
+static void vosLogFormat (
+    const VOS_LOG_ENTRY_T   *pEntry,
+    CHAR8                   *pStr,
+    UINT32                  strSize)
+{
+    const CHAR8     *p      = pEntry->hdr.pFormat;
+    UINT32          pos     = 0u;
+    UINT32          ofs     = 0u;
+    VOS_LOG_SPEC_T  spec;
+    CHAR8           fmt[VOS_LOG_SPEC_SIZE];
+    UINT32          i, n;
+    int             written = 0;
+
+    pStr[0] = '\0';
+    while ((*p != '\0') && (pos + 1u < strSize))
+    {
+        const CHAR8 *pPct = strchr(p, '%');
+
+        if (pPct == NULL)
+        {
+            vosLogAppend(pStr, strSize, &pos, p, (UINT32) strlen(p));
+            return;
+        }
+        vosLogAppend(pStr, strSize, &pos, p, (UINT32) (pPct - p));
+        vosLogParseSpec(pPct, &spec);
+        p = pPct + spec.len;
+        if (spec.kind == VOS_LOG_ARG_NONE)
+        {
+            vosLogAppend(pStr, strSize, &pos, "%", 1u);
+            continue;
+        }
+        if ((spec.kind == VOS_LOG_ARG_INVALID) || (spec.len + 2u > VOS_LOG_SPEC_SIZE))
+        {
+            break;
+        }
+
+        /* Rebuild the specification: '*' replaced by the recorded value, 64 bit integers as "ll" */
+        n = 0u;
+        for (i = 0u; i < spec.modOfs; i++)
+        {
+            if (pPct[i] == '*')
+            {
+                int star;
+                if (vosLogGet(pEntry, &ofs, &star, sizeof(star)) == FALSE)
+                {
+                    break;
+                }
+                written = vos_snprintf(&fmt[n], VOS_LOG_SPEC_SIZE - 4u - n, "%d", star);
+                n += ((written > 0) && ((UINT32) written < VOS_LOG_SPEC_SIZE - 4u - n)) ? (UINT32) written : 0u;
+            }
+            else if (n < VOS_LOG_SPEC_SIZE - 5u)
+            {
+                fmt[n++] = pPct[i];
+            }
+        }
+        if (i < spec.modOfs)
+        {
+            break;
+        }
+        if (spec.kind == VOS_LOG_ARG_INT64)
+        {
+            fmt[n++] = 'l';
+            fmt[n++] = 'l';
+        }
+        else if (spec.kind == VOS_LOG_ARG_INT)
+        {
+            for (i = 0u; (i < spec.modLen) && (n < VOS_LOG_SPEC_SIZE - 2u); i++)
+            {
+                fmt[n++] = pPct[spec.modOfs + i];
+            }
+        }
+        fmt[n++]    = spec.conv;
+        fmt[n]      = '\0';
+
+        written = 0;
+        switch (spec.kind)
+        {
+            case VOS_LOG_ARG_INT:
+            {
+                int value;
+                if (vosLogGet(pEntry, &ofs, &value, sizeof(value)) == FALSE)
+                {
+                    written = -1;
+                    break;
+                }
+                written = vos_snprintf(&pStr[pos], strSize - pos, fmt, value);
+                break;
+            }
+            case VOS_LOG_ARG_INT64:
+            {
+                UINT64 value;
+                if (vosLogGet(pEntry, &ofs, &value, sizeof(value)) == FALSE)
+                {
+                    written = -1;
+                    break;
+                }
+                if ((spec.conv == 'd') || (spec.conv == 'i'))
+                {
+                    written = vos_snprintf(&pStr[pos], strSize - pos, fmt, (long long) value);
+                }
+                else
+                {
+                    written = vos_snprintf(&pStr[pos], strSize - pos, fmt, (unsigned long long) value);
+                }
+                break;
+            }
+            case VOS_LOG_ARG_DOUBLE:
+            {
+                double value;
+                if (vosLogGet(pEntry, &ofs, &value, sizeof(value)) == FALSE)
+                {
+                    written = -1;
+                    break;
+                }
+                written = vos_snprintf(&pStr[pos], strSize - pos, fmt, value);
+                break;
+            }
+            case VOS_LOG_ARG_PTR:
+            {
+                void *value;
+                if (vosLogGet(pEntry, &ofs, &value, sizeof(value)) == FALSE)
+                {
+                    written = -1;
+                    break;
+                }
+                if (spec.conv == 'p')
+                {
+                    written = vos_snprintf(&pStr[pos], strSize - pos, fmt, value);
+                }
+                break;
+            }
+            case VOS_LOG_ARG_STR:
+            {
+                const CHAR8 *pArg = (const CHAR8 *) &pEntry->args[ofs];
+                if ((ofs >= pEntry->hdr.argSize) || (memchr(pArg, '\0', pEntry->hdr.argSize - ofs) == NULL))
+                {
+                    written = -1;
+                    break;
+                }
+                ofs += (UINT32) strlen(pArg) + 1u;
+                written = vos_snprintf(&pStr[pos], strSize - pos, fmt, pArg);
+                break;
+            }
+            default:
+                break;
+        }
+        if (written < 0)
+        {
+            break;
+        }
+        pos += ((UINT32) written < strSize - pos) ? (UINT32) written : strSize - pos - 1u;
+    }
+    if (*p != '\0')
+    {
+        vosLogAppend(pStr, strSize, &pos, "...\n", 4u);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check and count the rate limit of a category (approximate, the window is reset by the first entry of a second)
+ */
+static BOOL8 vosLogRateExceeded (
+    UINT32  category,
+    UINT32  sec)
+{
+    UINT32 window;
+
+    if (gLog.maxPerSecond[category] == 0u)
+    {
+        return FALSE;
+    }
+    window = VOS_LOG_LOAD(&gLog.window[category]);
+    if ((window != sec) && VOS_LOG_CAS(&gLog.window[category], &window, sec))
+    {
+        VOS_LOG_STORE(&gLog.count[category], 0u);
+    }
+    return (VOS_LOG_INC(&gLog.count[category]) > gLog.maxPerSecond[category]) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Output one entry
+ */
+static void vosLogOutput (
+    const VOS_LOG_ENTRY_T *pEntry)
+{
+    CHAR8       str[VOS_MAX_PRNT_STR_SIZE];
+    CHAR8       timeStr[32] = {0};
+    struct tm   curTimeTM;
+    time_t      sec = (time_t) pEntry->hdr.time.tv_sec;
+
+#if (defined (WIN32) || defined (WIN64))
+    if (localtime_s(&curTimeTM, &sec) == 0)
+#else
+    if (localtime_r(&sec, &curTimeTM) != NULL)
+#endif
+    {
+        (void) vos_snprintf(timeStr, sizeof(timeStr), "%04d%02d%02d-%02d:%02d:%02d.%06ld ",
+                            curTimeTM.tm_year + 1900,
+                            curTimeTM.tm_mon + 1,
+                            curTimeTM.tm_mday,
+                            curTimeTM.tm_hour,
+                            curTimeTM.tm_min,
+                            curTimeTM.tm_sec,
+                            (long) pEntry->hdr.time.tv_usec);
+    }
+    vosLogFormat(pEntry, str, sizeof(str));
+    gPDebugFunction(gRefCon, (VOS_LOG_T) pEntry->hdr.category, timeStr, pEntry->hdr.pFile, pEntry->hdr.line, str);
+}
+
+/**********************************************************************************************************************/
+/** Output all recorded entries and report new drops
+ *
+ *  @retval         number of entries output
+ */
+static UINT32 vosLogDrain (void)
+{
+    VOS_LOG_ENTRY_T *pEntry;
+    UINT32          count = 0u;
+    UINT32          dropped;
+    UINT32          i;
+
+    for (;; )
+    {
+        pEntry = &gLog.pRing[gLog.tail & gLog.mask];
+        if (VOS_LOG_LOAD(&pEntry->hdr.seq) != gLog.tail + 1u)
+        {
+            break;
+        }
+        if (gPDebugFunction != NULL)
+        {
+            vosLogOutput(pEntry);
+        }
+        VOS_LOG_STORE(&pEntry->hdr.seq, gLog.tail + gLog.mask + 1u);
+        gLog.tail++;
+        count++;
+    }
+
+    dropped = VOS_LOG_LOAD(&gLog.stats.numDroppedFull);
+    for (i = 0u; i < VOS_LOG_NUM_CATEGORIES; i++)
+    {
+        dropped += VOS_LOG_LOAD(&gLog.stats.numDroppedRate[i]);
+    }
+    if ((dropped != gLog.reported) && (gPDebugFunction != NULL))
+    {
+        CHAR8 str[VOS_MAX_PRNT_STR_SIZE];
+
+        (void) vos_snprintf(str, sizeof(str), "%u log messages dropped (ring full: %u)\n",
+                            dropped - gLog.reported, VOS_LOG_LOAD(&gLog.stats.numDroppedFull));
+        gPDebugFunction(gRefCon, VOS_LOG_WARNING, vos_getTimeStamp(), __FILE__, (UINT16) __LINE__, str);
+        gLog.reported = dropped;
+    }
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Output thread
+ */
+static void vosLogThread (
+    void *pArg)
+{
+    (void) pArg;
+
+    for (;; )
+    {
+        if (vosLogDrain() == 0u)
+        {
+            if (VOS_LOG_LOAD(&gLog.stop) == TRUE)
+            {
+                break;
+            }
+            (void) vos_threadDelay(VOS_LOG_IDLE_DELAY);
+        }
+    }
+    VOS_LOG_STORE(&gLog.stopped, TRUE);
+}
+
+#endif /* VOS_LOG_ASYNC_SUPPORT */
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -496,6 +1138,7 @@ VOS_ERR_T vos_init (
  */
 EXT_DECL void vos_terminate (void)
 {
+    vos_logStop();
     vos_sockTerm();
     vos_threadTerm();
     vos_memDelete(NULL);
@@ -603,3 +1246,221 @@ EXT_DECL const CHAR8 *vos_getErrorString (VOS_ERR_T error)
 #endif
     return buf;
 }
+
+/**********************************************************************************************************************/
+/** Set the run time log level.
+ *
+ *  @param[in]      level           Least important category to output
+ */
+EXT_DECL void vos_setLogLevel (
+    VOS_LOG_T level)
+{
+    gVosLogLevel = level;
+}
+
+/**********************************************************************************************************************/
+/** Defer the log output to a background thread.
+ *
+ *  @param[in]      pConfig         Ring size and rate limits, NULL for the defaults
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    already started
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_THREAD_ERR  output thread could not be created
+ *  @retval         VOS_UNKNOWN_ERR not supported by the compiler
+ */
+EXT_DECL VOS_ERR_T vos_logStart (
+    const VOS_LOG_CONFIG_T *pConfig)
+{
+#ifdef VOS_LOG_ASYNC_SUPPORT
+    static const UINT32 defaultRate[VOS_LOG_NUM_CATEGORIES] = VOS_LOG_DEFAULT_RATE;
+    UINT32              numEntries  = VOS_LOG_MIN_ENTRIES;
+    UINT32              i;
+    VOS_ERR_T           err;
+
+    if (gLog.pRing != NULL)
+    {
+        return VOS_INIT_ERR;
+    }
+    memset(&gLog, 0, sizeof(gLog));
+
+    while (numEntries < (((pConfig != NULL) && (pConfig->numEntries != 0u)) ?
+                         pConfig->numEntries : VOS_LOG_DEFAULT_ENTRIES))
+    {
+        numEntries <<= 1u;
+    }
+    gLog.pRing = (VOS_LOG_ENTRY_T *) vos_memAlloc(numEntries * (UINT32) sizeof(VOS_LOG_ENTRY_T));
+    if (gLog.pRing == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    for (i = 0u; i < numEntries; i++)
+    {
+        gLog.pRing[i].hdr.seq = i;
+    }
+    gLog.mask = numEntries - 1u;
+    memcpy(gLog.maxPerSecond, (pConfig != NULL) ? pConfig->maxPerSecond : defaultRate, sizeof(gLog.maxPerSecond));
+
+    err = vos_threadCreate(&gLog.thread, "vosLog", VOS_THREAD_POLICY_OTHER, VOS_THREAD_PRIORITY_DEFAULT, 0u, 0u,
+                           vosLogThread, NULL);
+    if (err != VOS_NO_ERR)
+    {
+        vos_memFree(gLog.pRing);
+        gLog.pRing = NULL;
+        return VOS_THREAD_ERR;
+    }
+    VOS_LOG_STORE(&gVosLogAsync, TRUE);
+    return VOS_NO_ERR;
+#else
+    (void) pConfig;
+    return VOS_UNKNOWN_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Output the recorded entries and return to synchronous log output.
+ */
+EXT_DECL void vos_logStop (void)
+{
+#ifdef VOS_LOG_ASYNC_SUPPORT
+    UINT32 i;
+
+    if (gLog.pRing == NULL)
+    {
+        return;
+    }
+    /* New entries are output synchronously, wait for the producers still recording */
+    VOS_LOG_STORE(&gVosLogAsync, FALSE);
+    while (VOS_LOG_LOAD(&gLog.writers) != 0u)
+    {
+        (void) vos_threadDelay(0u);
+    }
+    VOS_LOG_STORE(&gLog.stop, TRUE);
+    for (i = 0u; (i < VOS_LOG_STOP_LOOPS) && (VOS_LOG_LOAD(&gLog.stopped) == FALSE); i++)
+    {
+        (void) vos_threadDelay(VOS_LOG_IDLE_DELAY);
+    }
+    if (VOS_LOG_LOAD(&gLog.stopped) == FALSE)
+    {
+        /* stuck in the debug output function */
+        (void) vos_threadTerminate(gLog.thread);
+    }
+    vos_memFree(gLog.pRing);
+    gLog.pRing = NULL;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Return the counters of the asynchronous log output.
+ *
+ *  @param[out]     pStatistics     Pointer to the statistics
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ */
+EXT_DECL VOS_ERR_T vos_logGetStatistics (
+    VOS_LOG_STATISTICS_T *pStatistics)
+{
+    if (pStatistics == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+#ifdef VOS_LOG_ASYNC_SUPPORT
+    {
+        UINT32 i;
+
+        pStatistics->numRecorded    = VOS_LOG_LOAD(&gLog.stats.numRecorded);
+        pStatistics->numDroppedFull = VOS_LOG_LOAD(&gLog.stats.numDroppedFull);
+        for (i = 0u; i < VOS_LOG_NUM_CATEGORIES; i++)
+        {
+            pStatistics->numDroppedRate[i] = VOS_LOG_LOAD(&gLog.stats.numDroppedRate[i]);
+        }
+    }
+#else
+    memset(pStatistics, 0, sizeof(VOS_LOG_STATISTICS_T));
+#endif
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Record a log entry.
+ *
+ *  @param[in]      category        Log category
+ *  @param[in]      pFile           Source file (string literal)
+ *  @param[in]      line            Source line
+ *  @param[in]      pFormat         printf format (string literal)
+ *  @param[in]      ...             Arguments
+ */
+EXT_DECL void vos_logRecord (
+    VOS_LOG_T   category,
+    const CHAR8 *pFile,
+    UINT16      line,
+    const CHAR8 *pFormat,
+    ...)
+{
+#ifdef VOS_LOG_ASYNC_SUPPORT
+    VOS_LOG_ENTRY_T *pEntry;
+    VOS_TIMEVAL_T   now;
+    UINT32          cat = ((UINT32) category < VOS_LOG_NUM_CATEGORIES) ? (UINT32) category : (UINT32) VOS_LOG_USR;
+    UINT32          pos, seq;
+    va_list         ap;
+
+    (void) VOS_LOG_INC(&gLog.writers);
+    if ((VOS_LOG_LOAD(&gVosLogAsync) == FALSE) || (pFormat == NULL))
+    {
+        (void) VOS_LOG_DEC(&gLog.writers);
+        return;
+    }
+
+    vos_getRealTime(&now);
+    if (vosLogRateExceeded(cat, (UINT32) now.tv_sec) == TRUE)
+    {
+        (void) VOS_LOG_INC(&gLog.stats.numDroppedRate[cat]);
+        (void) VOS_LOG_DEC(&gLog.writers);
+        return;
+    }
+
+    /* Claim the next free entry, give up if the ring is full */
+    pos = VOS_LOG_LOAD(&gLog.head);
+    for (;; )
+    {
+        pEntry  = &gLog.pRing[pos & gLog.mask];
+        seq     = VOS_LOG_LOAD(&pEntry->hdr.seq);
+        if (seq == pos)
+        {
+            if (VOS_LOG_CAS(&gLog.head, &pos, pos + 1u))
+            {
+                break;
+            }
+        }
+        else if ((INT32) (seq - pos) < 0)
+        {
+            (void) VOS_LOG_INC(&gLog.stats.numDroppedFull);
+            (void) VOS_LOG_DEC(&gLog.writers);
+            return;
+        }
+        else
+        {
+            pos = VOS_LOG_LOAD(&gLog.head);
+        }
+    }
+
+    pEntry->hdr.line        = line;
+    pEntry->hdr.category    = (UINT8) cat;
+    pEntry->hdr.truncated   = FALSE;
+    pEntry->hdr.argSize     = 0u;
+    pEntry->hdr.pFile       = pFile;
+    pEntry->hdr.pFormat     = pFormat;
+    pEntry->hdr.time        = now;
+    va_start(ap, pFormat);
+    vosLogPack(pEntry, pFormat, &ap);
+    va_end(ap);
+
+    VOS_LOG_STORE(&pEntry->hdr.seq, pos + 1u);
+    (void) VOS_LOG_INC(&gLog.stats.numRecorded);
+    (void) VOS_LOG_DEC(&gLog.writers);
+#else
+    (void) category;
+    (void) pFile;
+    (void) line;
+    (void) pFormat;
+#endif
+}
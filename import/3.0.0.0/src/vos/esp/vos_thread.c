@@ -397,6 +397,42 @@ EXT_DECL VOS_ERR_T vos_threadIsActive (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Set the catch-up policy of a cyclic thread.
+ *  Cyclic thread statistics are not kept on this target.
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[in]      policy          Catch-up policy
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetCatchUp (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CATCHUP_T    policy)
+{
+    (void) thread;
+    (void) policy;
+    return VOS_NOINIT_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *  Cyclic thread statistics are not kept on this target.
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[out]     pStats          Pointer to returned statistics
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T        thread,
+    VOS_THREAD_STATS_T  *pStats)
+{
+    (void) thread;
+    (void) pStats;
+    return VOS_NOINIT_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Return thread handle of calling task
  *
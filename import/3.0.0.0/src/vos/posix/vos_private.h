@@ -124,6 +124,18 @@ void        vos_mutexLocalDelete (struct VOS_MUTEX *pMutex);
 
 EXT_DECL    VOS_ERR_T   vos_sockSetBuffer (VOS_SOCK_T sock);
 
+extern UINT32   gVosSockCloseCnt;
+
+UINT32      vos_getInterfaceIP (UINT32 ifIndex);
+
+struct cmsghdr;
+
+void        vos_sockRxStamp (struct cmsghdr *pCmsg, VOS_TIMEVAL_T *pTime, UINT8 *pSource);
+
+struct timespec;
+
+BOOL8       vos_sockStampToTime (const struct timespec *pStamp, VOS_TIMEVAL_T *pTime);
+
 #ifdef __cplusplus
 }
 #endif
@@ -169,8 +169,12 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     VOS_SHRD_T  handle,
     const UINT8 *pMemoryArea)
 {
-    (void)pMemoryArea;
+    struct stat sharedMemoryStat;
 
+    if ((pMemoryArea != NULL) && (fstat(handle->fd, &sharedMemoryStat) == 0))
+    {
+        (void) munmap((void *) pMemoryArea, (size_t) sharedMemoryStat.st_size);
+    }
     if (close(handle->fd) == -1)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory file close failed\n");
@@ -185,5 +189,140 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     {
         vos_memFree(handle->sharedMemoryName);
     }
+    vos_memFree(handle);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Attach read-only to an existing shared memory area.
+ *  The mapping is released with vos_fileUnmap() and stays valid even if the owner closes the area meanwhile.
+ *
+ *  @param[in]      pKey               Unique identifier (file name) used by the owner
+ *  @param[out]     ppMemoryArea       Pointer to pointer to mapped memory area
+ *  @param[out]     pSize              Pointer to size of the mapped area
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter error
+ *  @retval         VOS_IO_ERR         area does not exist (yet)
+ *  @retval         VOS_MEM_ERR        mapping failed
+ */
+EXT_DECL VOS_ERR_T vos_sharedAttach (
+    const CHAR8 *pKey,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize)
+{
+    int         fd;
+    struct stat sharedMemoryStat;
+    void        *pArea;
+
+    if ((pKey == NULL) || (ppMemoryArea == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    fd = shm_open(pKey, O_RDONLY, 0);
+    if (fd == -1)
+    {
+        return VOS_IO_ERR;
+    }
+    if ((fstat(fd, &sharedMemoryStat) == -1)
+        || (sharedMemoryStat.st_size <= 0)
+        || ((UINT64) sharedMemoryStat.st_size > 0xFFFFFFFFu))
+    {
+        (void) close(fd);
+        return VOS_IO_ERR;
+    }
+
+    pArea = mmap(NULL, (size_t) sharedMemoryStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void) close(fd);                       /* the mapping keeps its own reference to the object */
+    if (pArea == MAP_FAILED)
+    {
+        vos_printLog(VOS_LOG_WARNING, "vos_sharedAttach() mapping %s failed (%s)\n", pKey, strerror(errno));
+        return VOS_MEM_ERR;
+    }
+
+    *ppMemoryArea   = (const UINT8 *) pArea;
+    *pSize          = (UINT32) sharedMemoryStat.st_size;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/*    Memory mapped files
+                                                                                                               */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/** Map a file read-only into memory.
+ *  The mapping stays valid until vos_fileUnmap() is called, even if the file is replaced or removed meanwhile.
+ *
+ *  @param[in]      pFileName          Path of the file to map
+ *  @param[out]     ppMemoryArea       Pointer to pointer to mapped memory area
+ *  @param[out]     pSize              Pointer to size of the mapped file
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter error
+ *  @retval         VOS_IO_ERR         file could not be opened, is empty or too big
+ *  @retval         VOS_MEM_ERR        mapping failed
+ */
+EXT_DECL VOS_ERR_T vos_fileMap (
+    const CHAR8 *pFileName,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize)
+{
+    int         fd;
+    struct stat fileStat;
+    void        *pArea;
+
+    if ((pFileName == NULL) || (ppMemoryArea == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    fd = open(pFileName, O_RDONLY);
+    if (fd == -1)
+    {
+        return VOS_IO_ERR;
+    }
+    if ((fstat(fd, &fileStat) == -1)
+        || (fileStat.st_size <= 0)
+        || ((UINT64) fileStat.st_size > 0xFFFFFFFFu))
+    {
+        (void) close(fd);
+        return VOS_IO_ERR;
+    }
+
+    pArea = mmap(NULL, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void) close(fd);                       /* the mapping keeps its own reference to the file */
+    if (pArea == MAP_FAILED)
+    {
+        vos_printLog(VOS_LOG_WARNING, "vos_fileMap() mapping %s failed (%s)\n", pFileName, strerror(errno));
+        return VOS_MEM_ERR;
+    }
+
+    *ppMemoryArea   = (const UINT8 *) pArea;
+    *pSize          = (UINT32) fileStat.st_size;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Unmap a file mapped by vos_fileMap().
+ *
+ *  @param[in]      pMemoryArea        Pointer to mapped memory area
+ *  @param[in]      size               Size returned by vos_fileMap()
+ *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter error
+ *  @retval         VOS_MEM_ERR        unmapping failed
+ */
+EXT_DECL VOS_ERR_T vos_fileUnmap (
+    const UINT8 *pMemoryArea,
+    UINT32      size)
+{
+    if ((pMemoryArea == NULL) || (size == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (munmap((void *) pMemoryArea, (size_t) size) == -1)
+    {
+        vos_printLog(VOS_LOG_ERROR, "vos_fileUnmap() failed (%s)\n", strerror(errno));
+        return VOS_MEM_ERR;
+    }
     return VOS_NO_ERR;
 }
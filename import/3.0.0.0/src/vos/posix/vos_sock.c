@@ -75,6 +75,9 @@
 #   include <byteswap.h>
 #   include <linux/if_vlan.h>
 #   include <linux/sockios.h>
+#   include <linux/errqueue.h>
+#   include <linux/net_tstamp.h>
+#   include <linux/filter.h>
 #else
 #   include <net/if.h>
 #   include <net/if_types.h>
@@ -108,11 +111,27 @@ const CHAR8 *cDefaultIface = "eth0";
 #warning "SOL_IP undeclared"
 #endif
 
+/* Numbered transmit time stamps without payload (SOF_TIMESTAMPING_OPT_ID/OPT_TSONLY) need Linux 4.0 or later */
+#if defined(__linux) && defined(SO_TIMESTAMPING) && defined(SOF_TIMESTAMPING_TX_RECORD_MASK)
+#define VOS_SO_TIMESTAMPING
+#endif
+
+/* Launch times of sent packets (SO_TXTIME, struct sock_txtime) need Linux 4.19 or later */
+#if defined(__linux) && defined(SOF_TXTIME_DEADLINE_MODE)
+#define VOS_SO_TXTIME
+#endif
+
+/* Clock of the launch times: the fq qdisc uses CLOCK_MONOTONIC, etf is usually set up with CLOCK_TAI */
+#ifndef VOS_TXTIME_CLOCK
+#define VOS_TXTIME_CLOCK    CLOCK_MONOTONIC
+#endif
+
 /***********************************************************************************************************************
  *  LOCALS
  */
 
 BOOL8           gVosSockInitialised = FALSE;
+UINT32          gVosSockCloseCnt    = 0u;       /* sockets closed, a ring re-arms its requests when it changes */
 
 struct ifreq    gIfr;
 
@@ -936,6 +955,7 @@ EXT_DECL VOS_ERR_T vos_sockOpenTCP (
 EXT_DECL VOS_ERR_T vos_sockClose (
     VOS_SOCK_T sock)
 {
+    gVosSockCloseCnt++;
     if (close(sock) == -1)
     {
         vos_printLog(VOS_LOG_ERROR,
@@ -1114,6 +1134,72 @@ EXT_DECL VOS_ERR_T vos_sockSetOptions (
             }
         }
 #endif
+        if (pOptions->timestamping != FALSE)
+        {
+#ifdef VOS_SO_TIMESTAMPING
+            /*  Software receive and transmit time stamps, hardware receive time stamps if the interface has been
+                set up for them (SIOCSHWTSTAMP, e.g. by ptp4l). Transmit stamps are numbered and carry no payload. */
+            sockOptValue = (int) (SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE |
+                                  SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_SOFTWARE |
+                                  SOF_TIMESTAMPING_RAW_HARDWARE | SOF_TIMESTAMPING_OPT_ID |
+                                  SOF_TIMESTAMPING_OPT_TSONLY);
+            if (setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPING, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_TIMESTAMPING failed (Err: %s)\n", buff);
+            }
+#elif defined(SO_TIMESTAMPNS)
+            sockOptValue = 1;
+            if (setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPNS, &sockOptValue,
+                           sizeof(sockOptValue)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_TIMESTAMPNS failed (Err: %s)\n", buff);
+            }
+#else
+            vos_printLogStr(VOS_LOG_WARNING, "Kernel time stamps are not available on platform!\n");
+#endif
+        }
+        if (pOptions->txTime != FALSE)
+        {
+#ifdef VOS_SO_TXTIME
+            struct sock_txtime txTimeOpt;
+
+            txTimeOpt.clockid   = VOS_TXTIME_CLOCK;
+            txTimeOpt.flags     = 0u;
+            if (setsockopt(sock, SOL_SOCKET, SO_TXTIME, &txTimeOpt,
+                           sizeof(txTimeOpt)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_TXTIME failed (Err: %s)\n", buff);
+            }
+#else
+            vos_printLogStr(VOS_LOG_WARNING, "Launch times (SO_TXTIME) are not available on platform!\n");
+#endif
+        }
+        if (pOptions->noReceive != FALSE)
+        {
+#if defined(__linux) && defined(SO_ATTACH_FILTER)
+            /*  Accept nothing: the datagrams are read from a packet ring, the socket only binds and joins  */
+            struct sock_filter  dropAll = BPF_STMT(BPF_RET | BPF_K, 0);
+            struct sock_fprog   prog;
+
+            prog.len    = 1u;
+            prog.filter = &dropAll;
+            if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == -1)
+            {
+                char buff[VOS_MAX_ERR_STR_SIZE];
+                STRING_ERR(buff);
+                vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_ATTACH_FILTER failed (Err: %s)\n", buff);
+            }
+#else
+            vos_printLogStr(VOS_LOG_WARNING, "Socket filters are not available on platform!\n");
+#endif
+        }
     }
     /*  Include struct in_pktinfo in the message "ancilliary" control data.
         This way we can get the destination IP address for received UDP packets */
@@ -1364,44 +1450,224 @@ EXT_DECL VOS_ERR_T vos_sockSendUDP (
 }
 
 /**********************************************************************************************************************/
-/** Receive UDP data.
- *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
- *  will reflect the number of copied bytes and the call should be repeated until *pSize is 0 (zero).
- *  If the socket was created in blocking-mode (default), then this call will block and will only return if data has
- *  been received or the socket was closed or an error occured.
- *  If called in non-blocking mode, and no data is available, VOS_NODATA_ERR will be returned.
- *  If pointers are provided, source IP, source port and destination IP will be reported on return.
+/** Send UDP data at a given time.
+ *  If the socket was created with the txTime option, the packet is queued in the kernel with its launch time
+ *  (SO_TXTIME, clock VOS_TXTIME_CLOCK); a time based queueing discipline (fq, etf) on the outgoing interface releases
+ *  it then, others send it at once. A launch time not in the future, or a socket without the option, sends at once.
  *
  *  @param[in]      sock            socket descriptor
- *  @param[out]     pBuffer         pointer to applications data buffer
- *  @param[in,out]  pSize           pointer to the received data size
- *  @param[out]     pSrcIPAddr      pointer to source IP
- *  @param[out]     pSrcIPPort      pointer to source port
- *  @param[out]     pDstIPAddr      pointer to dest IP
- *  @param[out]     pSrcIFAddr      pointer to source network interface IP
- *  @param[in]      peek            if true, leave data in queue
+ *  @param[in]      pBuffer         pointer to data to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *  @param[in]      pTxTime         launch time (vos_getTime() time base), NULL to send at once
  *
  *  @retval         VOS_NO_ERR      no error
  *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
- *  @retval         VOS_IO_ERR      data could not be read
- *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_IO_ERR      data could not be sent
  *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
  */
 
-EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
-    VOS_SOCK_T sock,
-    UINT8      *pBuffer,
-    UINT32     *pSize,
-    UINT32     *pSrcIPAddr,
-    UINT16     *pSrcIPPort,
-    UINT32     *pDstIPAddr,
-    UINT32     *pSrcIFAddr,
-    BOOL8      peek)
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    VOS_SOCK_T          sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pTxTime)
+{
+#ifdef VOS_SO_TXTIME
+    char                control[CMSG_SPACE(sizeof(UINT64))];
+    struct sockaddr_in  destAddr;
+    struct iovec        iov;
+    struct msghdr       msg;
+    struct cmsghdr      *pCmsg;
+    struct timespec     clockNow;
+    VOS_TIMEVAL_T       now;
+    INT64               aheadUs;
+    UINT64              launchTime;
+    ssize_t             sendSize;
+
+    if (pTxTime == NULL)
+    {
+        return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+    }
+    if (sock == -1 || pBuffer == NULL || pSize == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /*  The launch time is as far ahead on the socket's clock as in the vos_getTime() time base  */
+    (void) clock_gettime(VOS_TXTIME_CLOCK, &clockNow);
+    vos_getTime(&now);
+    aheadUs = ((INT64) pTxTime->tv_sec - (INT64) now.tv_sec) * 1000000 +
+              ((INT64) pTxTime->tv_usec - (INT64) now.tv_usec);
+    if (aheadUs <= 0)
+    {
+        return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+    }
+    launchTime = (UINT64) clockNow.tv_sec * 1000000000u + (UINT64) clockNow.tv_nsec + (UINT64) aheadUs * 1000u;
+
+    memset(&destAddr, 0, sizeof(destAddr));
+    destAddr.sin_family         = AF_INET;
+    destAddr.sin_addr.s_addr    = vos_htonl(ipAddress);
+    destAddr.sin_port           = vos_htons(port);
+
+    iov.iov_base    = (void *) pBuffer;
+    iov.iov_len     = *pSize;
+
+    memset(&msg, 0, sizeof(msg));
+    memset(control, 0, sizeof(control));
+    msg.msg_name        = &destAddr;
+    msg.msg_namelen     = sizeof(destAddr);
+    msg.msg_iov         = &iov;
+    msg.msg_iovlen      = 1;
+    msg.msg_control     = control;
+    msg.msg_controllen  = sizeof(control);
+
+    pCmsg = CMSG_FIRSTHDR(&msg);
+    pCmsg->cmsg_level   = SOL_SOCKET;
+    pCmsg->cmsg_type    = SCM_TXTIME;
+    pCmsg->cmsg_len     = CMSG_LEN(sizeof(UINT64));
+    memcpy(CMSG_DATA(pCmsg), &launchTime, sizeof(launchTime));
+
+    *pSize = 0;
+    do
+    {
+        sendSize = sendmsg(sock, &msg, 0);
+
+        if ((sendSize == -1) && ((errno == EWOULDBLOCK) || (errno == EAGAIN)))
+        {
+            return VOS_BLOCK_ERR;
+        }
+    }
+    while (sendSize == -1 && errno == EINTR);
+
+    if ((sendSize == -1) && (errno == EINVAL))
+    {
+        /*  Socket without SO_TXTIME    */
+        *pSize = (UINT32) iov.iov_len;
+        return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+    }
+    if (sendSize == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_WARNING, "sendmsg() to %s:%u failed (Err: %s)\n",
+                     inet_ntoa(destAddr.sin_addr), (unsigned int)port, buff);
+        return VOS_IO_ERR;
+    }
+    *pSize = (UINT32) sendSize;
+    return VOS_NO_ERR;
+#else
+    (void) pTxTime;
+    return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Convert a kernel time stamp (CLOCK_REALTIME) to the vos_getTime() time base.
+ *  The age of the stamp is subtracted from the current time, so clocks with a different epoch still work.
+ *
+ *  @param[in]      pStamp          kernel time stamp
+ *  @param[out]     pTime           converted time
+ *
+ *  @retval         TRUE            stamp plausible (not in the future, less than a second old)
+ *  @retval         FALSE           stamp from another clock (e.g. an unsynchronised NIC), pTime is the current time
+ */
+BOOL8 vos_sockStampToTime (
+    const struct timespec   *pStamp,
+    VOS_TIMEVAL_T           *pTime)
+{
+    struct timespec now;
+    INT64           ageNs;
+
+    (void) clock_gettime(CLOCK_REALTIME, &now);
+    vos_getTime(pTime);
+
+    ageNs = ((INT64) now.tv_sec - (INT64) pStamp->tv_sec) * 1000000000
+            + ((INT64) now.tv_nsec - (INT64) pStamp->tv_nsec);
+    if ((ageNs < 0) || (ageNs >= 1000000000))
+    {
+        return FALSE;
+    }
+    else
+    {
+        VOS_TIMEVAL_T age;
+
+        age.tv_sec  = 0;
+        age.tv_usec = (suseconds_t) (ageNs / 1000);
+        vos_subTime(pTime, &age);
+        return TRUE;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Take the receive time out of the control data of a received packet.
+ *
+ *  @param[in]      pCmsg           SOL_SOCKET control message
+ *  @param[out]     pTime           receive time
+ *  @param[out]     pSource         source of the receive time
+ */
+void vos_sockRxStamp (
+    struct cmsghdr  *pCmsg,
+    VOS_TIMEVAL_T   *pTime,
+    UINT8           *pSource)
+{
+#ifdef VOS_SO_TIMESTAMPING
+    if (pCmsg->cmsg_type == SCM_TIMESTAMPING)
+    {
+        struct timespec stamps[3];      /* software, deprecated, raw hardware */
+
+        memcpy(stamps, CMSG_DATA(pCmsg), sizeof(stamps));
+        if (((stamps[2].tv_sec != 0) || (stamps[2].tv_nsec != 0)) && vos_sockStampToTime(&stamps[2], pTime))
+        {
+            *pSource = VOS_TS_HARDWARE;
+        }
+        else if (((stamps[0].tv_sec != 0) || (stamps[0].tv_nsec != 0)) && vos_sockStampToTime(&stamps[0], pTime))
+        {
+            *pSource = VOS_TS_SOFTWARE;
+        }
+    }
+#endif
+#if defined(SO_TIMESTAMPNS)
+    if (pCmsg->cmsg_type == SCM_TIMESTAMPNS)
+    {
+        struct timespec stamp;
+
+        memcpy(&stamp, CMSG_DATA(pCmsg), sizeof(stamp));
+        if (vos_sockStampToTime(&stamp, pTime))
+        {
+            *pSource = VOS_TS_SOFTWARE;
+        }
+    }
+#else
+    (void) pCmsg;
+    (void) pTime;
+    (void) pSource;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP data, common part of vos_sockReceiveUDP() and vos_sockReceiveUDPTs().
+ *  The receive time is only returned if pRxTime is not NULL.
+ */
+static VOS_ERR_T sockReceiveUDP (
+    VOS_SOCK_T      sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    BOOL8           peek,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource)
 {
     union
     {
         struct cmsghdr  cm;
-        char            raw[32];
+        char            raw[128];   /* IP_PKTINFO and SCM_TIMESTAMPING */
     } control_un;
     struct sockaddr_in  srcAddr;
     socklen_t           sockLen = sizeof(srcAddr);
@@ -1444,6 +1710,24 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
 
         if (rcvSize != -1)
         {
+            UINT8 rxTimeSource = VOS_TS_APPLICATION;
+
+            if (pRxTime != NULL)
+            {
+                vos_getTime(pRxTime);
+                for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+                {
+                    if (cmsg->cmsg_level == SOL_SOCKET)
+                    {
+                        vos_sockRxStamp(cmsg, pRxTime, &rxTimeSource);
+                    }
+                }
+                if (pRxTimeSource != NULL)
+                {
+                    *pRxTimeSource = rxTimeSource;
+                }
+            }
+
             if (pDstIPAddr != NULL)
             {
                 for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
@@ -1517,6 +1801,191 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
     }
 }
 
+/**********************************************************************************************************************/
+/** Receive UDP data.
+ *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
+ *  will reflect the number of copied bytes and the call should be repeated until *pSize is 0 (zero).
+ *  If the socket was created in blocking-mode (default), then this call will block and will only return if data has
+ *  been received or the socket was closed or an error occured.
+ *  If called in non-blocking mode, and no data is available, VOS_NODATA_ERR will be returned.
+ *  If pointers are provided, source IP, source port and destination IP will be reported on return.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[in]      peek            if true, leave data in queue
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
+    VOS_SOCK_T sock,
+    UINT8      *pBuffer,
+    UINT32     *pSize,
+    UINT32     *pSrcIPAddr,
+    UINT16     *pSrcIPPort,
+    UINT32     *pDstIPAddr,
+    UINT32     *pSrcIFAddr,
+    BOOL8      peek)
+{
+    return sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, pSrcIFAddr, peek, NULL, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP data with its receive time.
+ *  Like vos_sockReceiveUDP(), without peeking. If the socket was created with the timestamping option, the receive
+ *  time is the kernel's (or the network interface's) time stamp of the packet, converted to the vos_getTime()
+ *  time base. Otherwise it is vos_getTime() after reading the packet.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[out]     pRxTime         pointer to receive time
+ *  @param[out]     pRxTimeSource   pointer to source of the receive time (VOS_TS_...), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTs (
+    VOS_SOCK_T      sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource)
+{
+    if (pRxTime == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    return sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, pSrcIFAddr, FALSE,
+                          pRxTime, pRxTimeSource);
+}
+
+/**********************************************************************************************************************/
+/** Read one transmit time stamp of a socket.
+ *  Sockets created with the timestamping option get a time stamp for each sent packet, when it is handed to the
+ *  network interface. The stamps are numbered per socket in sending order, starting with 0. They have to be read
+ *  regularly, the kernel drops them when its queue is full. Never blocks.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pId             pointer to the number of the sent packet
+ *  @param[out]     pTxTime         pointer to transmit time (vos_getTime() time base)
+ *  @param[out]     pTxTimeSource   pointer to source of the transmit time (VOS_TS_...), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      time stamp returned
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_NODATA_ERR  no time stamp pending
+ *  @retval         VOS_UNKNOWN_ERR not supported on this platform
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveTxTime (
+    VOS_SOCK_T      sock,
+    UINT32          *pId,
+    VOS_TIMEVAL_T   *pTxTime,
+    UINT8           *pTxTimeSource)
+{
+#ifdef VOS_SO_TIMESTAMPING
+    union
+    {
+        struct cmsghdr  cm;
+        char            raw[256];   /* SCM_TIMESTAMPING and IP_RECVERR (with offender address) */
+    } control_un;
+    struct msghdr   msg;
+    struct cmsghdr  *cmsg;
+    BOOL8           haveId      = FALSE;
+    BOOL8           haveStamp   = FALSE;
+
+    if ((sock == -1) || (pId == NULL) || (pTxTime == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    for (;;)
+    {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control     = &control_un.cm;
+        msg.msg_controllen  = sizeof(control_un);
+
+        /* OPT_TSONLY: no payload is looped back, only the control data */
+        if (recvmsg(sock, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+        {
+            return VOS_NODATA_ERR;
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPING))
+            {
+                struct timespec stamps[3];      /* software, deprecated, raw hardware */
+
+                memcpy(stamps, CMSG_DATA(cmsg), sizeof(stamps));
+                if ((stamps[0].tv_sec != 0) || (stamps[0].tv_nsec != 0))
+                {
+                    haveStamp = vos_sockStampToTime(&stamps[0], pTxTime);
+                    if (pTxTimeSource != NULL)
+                    {
+                        *pTxTimeSource = VOS_TS_SOFTWARE;
+                    }
+                }
+                else if ((stamps[2].tv_sec != 0) || (stamps[2].tv_nsec != 0))
+                {
+                    haveStamp = vos_sockStampToTime(&stamps[2], pTxTime);
+                    if (pTxTimeSource != NULL)
+                    {
+                        *pTxTimeSource = VOS_TS_HARDWARE;
+                    }
+                }
+            }
+            else if ((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR))
+            {
+                struct sock_extended_err serr;
+
+                memcpy(&serr, CMSG_DATA(cmsg), sizeof(serr));
+                if ((serr.ee_errno == ENOMSG) && (serr.ee_origin == SO_EE_ORIGIN_TIMESTAMPING))
+                {
+                    *pId    = serr.ee_data;
+                    haveId  = TRUE;
+                }
+            }
+        }
+
+        if ((haveId == TRUE) && (haveStamp == TRUE))
+        {
+            return VOS_NO_ERR;
+        }
+        /* not a (plausible) time stamp, e.g. an ICMP error: read on */
+        haveId      = FALSE;
+        haveStamp   = FALSE;
+    }
+#else
+    (void) sock;
+    (void) pId;
+    (void) pTxTime;
+    (void) pTxTimeSource;
+    return VOS_UNKNOWN_ERR;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
@@ -0,0 +1,497 @@
+/**********************************************************************************************************************/
+/**
+ * @file            posix/vos_sockPacket.c
+ *
+ * @brief           Memory mapped receive ring
+ *
+ * @details         OS abstraction of a packet capture ring for high receive rates (Linux AF_PACKET, TPACKET_V3).
+ *                  A cooked packet socket (SOCK_DGRAM, the link header is removed) with a BPF filter on the UDP
+ *                  destination port fills a ring of blocks shared with the process. All datagrams of a block are read
+ *                  without a system call; select() only wakes up once per block.
+ *
+ *                  Block layout: struct tpacket_block_desc, then the packets, each as struct tpacket3_hdr, struct
+ *                  sockaddr_ll and the IP packet (at tp_net).
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+* $Id$
+*
+*/
+
+#ifndef PACKET_MMAP_SUPPORT
+#error \
+    "You are trying to add packet ring support to vos_sock.c - either define PACKET_MMAP_SUPPORT or exclude this file!"
+#else
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <net/if.h>              /* before vos_sock.h, sets VOS_MAX_IF_NAME_SIZE as in vos_sock.c */
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/filter.h>
+#include <linux/net_tstamp.h>
+
+#include "vos_utils.h"
+#include "vos_sock.h"
+#include "vos_mem.h"
+#include "vos_private.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define PKT_FRAME_SIZE          2048u       /* not used by TPACKET_V3, must divide the block size */
+#define PKT_IP_HEADER_SIZE      20u
+#define PKT_UDP_HEADER_SIZE     8u
+
+#if (VOS_PKT_RING_BLOCK_SIZE % PKT_FRAME_SIZE) != 0u
+#error "VOS_PKT_RING_BLOCK_SIZE must be a multiple of 2048"
+#endif
+
+struct VOS_PKT_RING
+{
+    int                 sock;
+    UINT8               *pMap;
+    size_t              mapSize;
+    UINT32              ifAddr;         /* interface bound to, VOS_INADDR_ANY: all */
+    UINT32              block;          /* block read */
+    BOOL8               inBlock;        /* block is owned by the process */
+    UINT32              pktLeft;        /* packets left in the block */
+    UINT8               *pPkt;          /* next packet in the block */
+    UINT32              packets;
+    UINT32              drops;
+};
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Get the index of the interface with the given IP address
+ *
+ *  @param[in]      ifAddr          interface IP address
+ *
+ *  @retval         interface index, 0 if not found
+ */
+static int pktIfIndex (
+    UINT32 ifAddr)
+{
+    VOS_IF_REC_T    ifRec[VOS_MAX_NUM_IF];
+    UINT32          ifCnt = VOS_MAX_NUM_IF;
+    UINT32          i;
+
+    if (vos_getInterfaces(&ifCnt, ifRec) != VOS_NO_ERR)
+    {
+        return 0;
+    }
+    for (i = 0u; i < ifCnt; i++)
+    {
+        if (ifRec[i].ipAddr == ifAddr)
+        {
+            return (int) ifRec[i].ifIndex;
+        }
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Add data to an internet checksum (RFC 1071)
+ *
+ *  @param[in]      pData           data, 16 bit words in network byte order
+ *  @param[in]      size            size of the data in bytes
+ *  @param[in]      sum             checksum so far
+ *
+ *  @retval         ones' complement sum, folded to 16 bits; 0xFFFF if data including its checksum field is valid
+ */
+static UINT32 pktChecksum (
+    const UINT8 *pData,
+    UINT32      size,
+    UINT32      sum)
+{
+    UINT32 i;
+
+    for (i = 0u; i + 1u < size; i += 2u)
+    {
+        sum += ((UINT32) pData[i] << 8) | pData[i + 1u];
+    }
+    if (i < size)
+    {
+        sum += (UINT32) pData[i] << 8;
+    }
+    while (sum > 0xFFFFu)
+    {
+        sum = (sum & 0xFFFFu) + (sum >> 16);
+    }
+    return sum;
+}
+
+/**********************************************************************************************************************/
+/** Read the kernel counters of the ring (the kernel resets them on each read)
+ *
+ *  @param[in]      ring            ring handle
+ */
+static void pktReadStatistics (
+    VOS_PKT_RING_T ring)
+{
+    struct tpacket_stats_v3 stats;
+    socklen_t               len = sizeof(stats);
+
+    if (getsockopt(ring->sock, SOL_PACKET, PACKET_STATISTICS, &stats, &len) == 0)
+    {
+        ring->packets   += stats.tp_packets;
+        ring->drops     += stats.tp_drops;
+    }
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Create a receive ring.
+ *
+ *  @param[in]      ifAddr          IP address of the interface to receive from, VOS_INADDR_ANY: all interfaces
+ *  @param[in]      port            UDP destination port to receive
+ *  @param[out]     pRing           pointer to ring handle returned
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error or no interface with that address
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    packet socket or ring not available (no CAP_NET_RAW)
+ */
+EXT_DECL VOS_ERR_T vos_pktRingCreate (
+    UINT32          ifAddr,
+    UINT16          port,
+    VOS_PKT_RING_T  *pRing)
+{
+    /*  Unfragmented UDP to the port; offsets relative to the IP header (cooked socket)    */
+    struct sock_filter  filter[] =
+    {
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 9),                  /* IP protocol                      */
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, 6),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 6),                  /* more fragments, fragment offset  */
+        BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x3fff, 4, 0),
+        BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 0),                 /* X = IP header length             */
+        BPF_STMT(BPF_LD | BPF_H | BPF_IND, 2),                  /* UDP destination port             */
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0xFFFF),
+        BPF_STMT(BPF_RET | BPF_K, 0)
+    };
+    struct sock_fprog   prog;
+    struct tpacket_req3 req;
+    struct sockaddr_ll  addr;
+    VOS_PKT_RING_T      ring;
+    int                 ifIndex = 0;
+    int                 optValue;
+    char                buff[VOS_MAX_ERR_STR_SIZE];
+
+    if ((pRing == NULL) || (port == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (ifAddr != VOS_INADDR_ANY)
+    {
+        ifIndex = pktIfIndex(ifAddr);
+        if (ifIndex == 0)
+        {
+            vos_printLog(VOS_LOG_ERROR, "no interface with address %s\n", vos_ipDotted(ifAddr));
+            return VOS_PARAM_ERR;
+        }
+    }
+    ring = (VOS_PKT_RING_T) vos_memAlloc(sizeof(struct VOS_PKT_RING));
+    if (ring == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    ring->pMap      = MAP_FAILED;
+    ring->ifAddr    = ifAddr;
+
+    /*  No protocol yet: nothing is captured before the filter and the ring are in place   */
+    ring->sock = socket(AF_PACKET, SOCK_DGRAM, 0);
+    if (ring->sock == -1)
+    {
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "socket(AF_PACKET) failed (Err: %s)\n", buff);
+        vos_pktRingDestroy(ring);
+        return VOS_SOCK_ERR;
+    }
+
+    filter[6].k = port;
+    prog.len    = (unsigned short) (sizeof(filter) / sizeof(filter[0]));
+    prog.filter = filter;
+    optValue    = TPACKET_V3;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size       = VOS_PKT_RING_BLOCK_SIZE;
+    req.tp_block_nr         = VOS_PKT_RING_BLOCKS;
+    req.tp_frame_size       = PKT_FRAME_SIZE;
+    req.tp_frame_nr         = (VOS_PKT_RING_BLOCK_SIZE / PKT_FRAME_SIZE) * VOS_PKT_RING_BLOCKS;
+    req.tp_retire_blk_tov   = VOS_PKT_RING_TIMEOUT;
+    if ((setsockopt(ring->sock, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == -1) ||
+        (setsockopt(ring->sock, SOL_PACKET, PACKET_VERSION, &optValue, sizeof(optValue)) == -1) ||
+        (setsockopt(ring->sock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) == -1))
+    {
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "setsockopt() of packet ring failed (Err: %s)\n", buff);
+        vos_pktRingDestroy(ring);
+        return VOS_SOCK_ERR;
+    }
+
+    /*  Hardware receive time stamps if the interface has been set up for them, software otherwise  */
+    optValue = SOF_TIMESTAMPING_RAW_HARDWARE;
+    (void) setsockopt(ring->sock, SOL_PACKET, PACKET_TIMESTAMP, &optValue, sizeof(optValue));
+
+    ring->mapSize   = (size_t) VOS_PKT_RING_BLOCK_SIZE * VOS_PKT_RING_BLOCKS;
+    ring->pMap      = (UINT8 *) mmap(NULL, ring->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, ring->sock, 0);
+    if (ring->pMap == MAP_FAILED)
+    {
+        vos_pktRingDestroy(ring);
+        return VOS_MEM_ERR;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family     = AF_PACKET;
+    addr.sll_protocol   = htons(ETH_P_IP);
+    addr.sll_ifindex    = ifIndex;
+    if (bind(ring->sock, (struct sockaddr *) &addr, sizeof(addr)) == -1)
+    {
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "bind() of packet ring failed (Err: %s)\n", buff);
+        vos_pktRingDestroy(ring);
+        return VOS_SOCK_ERR;
+    }
+
+    *pRing = ring;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release a receive ring.
+ *
+ *  @param[in]      ring            ring handle
+ */
+EXT_DECL void vos_pktRingDestroy (
+    VOS_PKT_RING_T ring)
+{
+    if (ring == NULL)
+    {
+        return;
+    }
+    if (ring->pMap != MAP_FAILED)
+    {
+        (void) munmap(ring->pMap, ring->mapSize);
+    }
+    if (ring->sock != -1)
+    {
+        (void) close(ring->sock);
+    }
+    vos_memFree(ring);
+}
+
+/**********************************************************************************************************************/
+/** Get the socket of a receive ring, to wait for it with vos_select().
+ *  It becomes readable when a block has been handed over.
+ *
+ *  @param[in]      ring            ring handle
+ *
+ *  @retval         socket descriptor
+ */
+EXT_DECL VOS_SOCK_T vos_pktRingGetSocket (
+    VOS_PKT_RING_T ring)
+{
+    return (ring != NULL) ? (VOS_SOCK_T) ring->sock : VOS_INVALID_SOCKET;
+}
+
+/**********************************************************************************************************************/
+/** Get the next received UDP datagram out of the ring.
+ *  The ring block is returned to the kernel when all its datagrams are read. Sent packets (seen on the same
+ *  interface) and datagrams larger than the buffer are skipped.
+ *  The kernel UDP stack is bypassed, so its checks are done here: IP fragments and datagrams with a wrong IP header
+ *  checksum or UDP checksum are skipped as well.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           In: size of the buffer, Out: size of the datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[out]     pRxTime         pointer to receive time (vos_getTime() time base)
+ *  @param[out]     pRxTimeSource   pointer to source of the receive time (VOS_TS_...)
+ *
+ *  @retval         VOS_NO_ERR      datagram returned
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_NODATA_ERR  no more datagrams
+ */
+EXT_DECL VOS_ERR_T vos_pktRingReceiveUDP (
+    VOS_PKT_RING_T  ring,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource)
+{
+    struct tpacket_block_desc   *pBlock;
+    struct tpacket3_hdr         *pHdr;
+    const struct sockaddr_ll    *pAddr;
+    const UINT8                 *pIp;
+    struct timespec             stamp;
+    UINT32                      ipSize;
+    UINT32                      ipHdrSize;
+    UINT32                      udpSize;
+    UINT32                      sum;
+
+    if ((ring == NULL) || (pBuffer == NULL) || (pSize == NULL) || (pSrcIPAddr == NULL) || (pSrcIPPort == NULL) ||
+        (pDstIPAddr == NULL) || (pSrcIFAddr == NULL) || (pRxTime == NULL) || (pRxTimeSource == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    for (;;)
+    {
+        pBlock = (struct tpacket_block_desc *) (ring->pMap + (size_t) ring->block * VOS_PKT_RING_BLOCK_SIZE);
+        if (ring->pktLeft == 0u)
+        {
+            if (ring->inBlock == TRUE)
+            {
+                /*  All read: hand the block back and go on with the next one  */
+                __sync_synchronize();
+                pBlock->hdr.bh1.block_status = TP_STATUS_KERNEL;
+                ring->inBlock   = FALSE;
+                ring->block     = (ring->block + 1u) % VOS_PKT_RING_BLOCKS;
+                continue;
+            }
+            if ((pBlock->hdr.bh1.block_status & TP_STATUS_USER) == 0u)
+            {
+                return VOS_NODATA_ERR;
+            }
+            __sync_synchronize();
+            ring->inBlock   = TRUE;
+            ring->pktLeft   = pBlock->hdr.bh1.num_pkts;
+            ring->pPkt      = (UINT8 *) pBlock + pBlock->hdr.bh1.offset_to_first_pkt;
+            continue;
+        }
+
+        pHdr = (struct tpacket3_hdr *) ring->pPkt;
+        ring->pktLeft--;
+        ring->pPkt += pHdr->tp_next_offset;
+
+        pAddr   = (const struct sockaddr_ll *) ((UINT8 *) pHdr + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+        pIp     = (const UINT8 *) pHdr + pHdr->tp_net;
+        ipSize  = pHdr->tp_snaplen - (UINT32) (pHdr->tp_net - pHdr->tp_mac);
+        if ((pAddr->sll_pkttype == PACKET_OUTGOING) || (pAddr->sll_pkttype == PACKET_OTHERHOST) ||
+            (pHdr->tp_snaplen != pHdr->tp_len))
+        {
+            continue;
+        }
+        ipHdrSize = (UINT32) (pIp[0] & 0x0Fu) * 4u;
+        if ((ipSize < PKT_IP_HEADER_SIZE) || ((pIp[0] >> 4) != 4u) || (ipHdrSize < PKT_IP_HEADER_SIZE) ||
+            (ipSize < ipHdrSize + PKT_UDP_HEADER_SIZE))
+        {
+            continue;
+        }
+
+        /*  IP header: fragments (more fragments flag or offset set) and damaged headers are dropped,
+            link layer padding is cut off  */
+        if ((((pIp[6] & 0x3Fu) | pIp[7]) != 0u) || (pktChecksum(pIp, ipHdrSize, 0u) != 0xFFFFu))
+        {
+            continue;
+        }
+        if ((((UINT32) pIp[2] << 8) | pIp[3]) > ipSize)
+        {
+            continue;
+        }
+        ipSize = ((UINT32) pIp[2] << 8) | pIp[3];
+        if (ipSize < ipHdrSize + PKT_UDP_HEADER_SIZE)
+        {
+            continue;
+        }
+
+        udpSize = ((UINT32) pIp[ipHdrSize + 4u] << 8) | pIp[ipHdrSize + 5u];
+        if ((udpSize < PKT_UDP_HEADER_SIZE) || (udpSize > ipSize - ipHdrSize) ||
+            (udpSize - PKT_UDP_HEADER_SIZE > *pSize))
+        {
+            continue;
+        }
+
+        /*  UDP checksum, if the sender computed one (not 0) and neither the NIC verified it nor the packet was
+            sent by this host with checksum offload (not computed yet)  */
+        if (((pIp[ipHdrSize + 6u] | pIp[ipHdrSize + 7u]) != 0u) &&
+            !(pHdr->tp_status & (TP_STATUS_CSUM_VALID | TP_STATUS_CSUMNOTREADY)))
+        {
+            sum = pktChecksum(pIp + 12u, 8u, IPPROTO_UDP + udpSize);        /* pseudo header: addresses   */
+            if (pktChecksum(pIp + ipHdrSize, udpSize, sum) != 0xFFFFu)
+            {
+                continue;
+            }
+        }
+
+        *pSize = udpSize - PKT_UDP_HEADER_SIZE;
+        memcpy(pBuffer, pIp + ipHdrSize + PKT_UDP_HEADER_SIZE, *pSize);
+        *pSrcIPAddr = ((UINT32) pIp[12] << 24) | ((UINT32) pIp[13] << 16) | ((UINT32) pIp[14] << 8) | pIp[15];
+        *pDstIPAddr = ((UINT32) pIp[16] << 24) | ((UINT32) pIp[17] << 16) | ((UINT32) pIp[18] << 8) | pIp[19];
+        *pSrcIPPort = (UINT16) (((UINT32) pIp[ipHdrSize] << 8) | pIp[ipHdrSize + 1u]);
+        *pSrcIFAddr = (ring->ifAddr != VOS_INADDR_ANY) ? ring->ifAddr : vos_getInterfaceIP((UINT32) pAddr->sll_ifindex);
+
+        stamp.tv_sec    = (time_t) pHdr->tp_sec;
+        stamp.tv_nsec   = (long) pHdr->tp_nsec;
+        if (vos_sockStampToTime(&stamp, pRxTime))      /* taken by the kernel on reception, if not by the NIC */
+        {
+            *pRxTimeSource = (pHdr->tp_status & TP_STATUS_TS_RAW_HARDWARE) ? VOS_TS_HARDWARE : VOS_TS_SOFTWARE;
+        }
+        else
+        {
+            vos_getTime(pRxTime);
+            *pRxTimeSource = VOS_TS_APPLICATION;
+        }
+        return VOS_NO_ERR;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get the ring counters.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pPackets        pointer to number of packets passed by the filter
+ *  @param[out]     pDrops          pointer to number of packets dropped, ring full
+ */
+EXT_DECL void vos_pktRingGetStatistics (
+    VOS_PKT_RING_T  ring,
+    UINT32          *pPackets,
+    UINT32          *pDrops)
+{
+    if (ring == NULL)
+    {
+        return;
+    }
+    pktReadStatistics(ring);
+    if (pPackets != NULL)
+    {
+        *pPackets = ring->packets;
+    }
+    if (pDrops != NULL)
+    {
+        *pDrops = ring->drops;
+    }
+}
+
+#endif
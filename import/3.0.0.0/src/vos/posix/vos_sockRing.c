@@ -0,0 +1,893 @@
+/**********************************************************************************************************************/
+/**
+ * @file            posix/vos_sockRing.c
+ *
+ * @brief           Completion based socket I/O
+ *
+ * @details         OS abstraction of batched, completion based socket I/O with Linux io_uring (kernel 6.0 or later:
+ *                  multishot recvmsg, provided buffer rings). Uses the system calls directly, liburing is not needed.
+ *
+ *                  Sends are queued as sendmsg requests with MSG_DONTWAIT and IOSQE_CQE_SKIP_SUCCESS: they are
+ *                  executed while the kernel consumes the submission queue and complete only if they fail, so the
+ *                  caller's data is read before vos_ringSubmit() returns.
+ *                  Each received datagram lands in a buffer of the pool, laid out as struct io_uring_recvmsg_out,
+ *                  source address, control data and payload. It is copied out and the buffer is returned at once.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ */
+/*
+* $Id$
+*
+*/
+
+#ifndef IO_URING_SUPPORT
+#error \
+    "You are trying to add io_uring support to vos_sock.c - either define IO_URING_SUPPORT or exclude this file!"
+#else
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stddef.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <netinet/in.h>
+#include <linux/io_uring.h>
+
+#include "vos_utils.h"
+#include "vos_sock.h"
+#include "vos_mem.h"
+#include "vos_private.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define RING_MAX_WATCH          VOS_MAX_SOCKET_CNT
+#define RING_CONTROL_SIZE       128u        /* IP_PKTINFO and SCM_TIMESTAMPING */
+#define RING_BUF_GROUP          0u
+
+/* user_data of the requests: kind, generation and index of the watched socket */
+#define RING_UD_SEND            1u
+#define RING_UD_RECV            2u
+#define RING_UD_POLL            3u
+#define RING_UD_CANCEL          4u
+#define RING_UD(kind, gen, idx) (((UINT64) (kind) << 56) | ((UINT64) (gen) << 16) | (UINT64) (idx))
+#define RING_UD_KIND(ud)        ((UINT32) ((ud) >> 56))
+#define RING_UD_GEN(ud)         ((UINT32) (((ud) >> 16) & 0xFFFFFFFFu))
+#define RING_UD_IDX(ud)         ((UINT32) ((ud) & 0xFFFFu))
+
+#if (VOS_RING_BUFFERS & (VOS_RING_BUFFERS - 1u)) != 0u
+#error "VOS_RING_BUFFERS must be a power of 2"
+#endif
+
+typedef struct
+{
+    VOS_SOCK_T  sock;               /* VOS_INVALID_SOCKET: entry free */
+    UINT32      kind;               /* RING_UD_RECV or RING_UD_POLL */
+    UINT32      gen;                /* generation of the current request */
+    BOOL8       armed;              /* request is in the kernel */
+    BOOL8       wanted;             /* still in the sets (vos_ringWatch) */
+} RING_WATCH_T;
+
+typedef struct
+{
+    struct msghdr       msg;
+    struct iovec        iov;
+    struct sockaddr_in  addr;
+} RING_SEND_T;
+
+struct VOS_RING
+{
+    int                         fd;
+    UINT8                       *pRingMem;      /* submission and completion queue (one mapping) */
+    size_t                      ringMemSize;
+    struct io_uring_sqe         *pSqes;
+    size_t                      sqesSize;
+    UINT32                      *pSqHead;
+    UINT32                      *pSqTail;
+    UINT32                      *pSqArray;
+    UINT32                      sqMask;
+    UINT32                      sqEntries;
+    UINT32                      sqTail;         /* filled entries */
+    UINT32                      sqFlushed;      /* entries handed to the kernel */
+    UINT32                      *pCqHead;
+    UINT32                      *pCqTail;
+    UINT32                      cqMask;
+    struct io_uring_cqe         *pCqes;
+    struct io_uring_buf_ring    *pBufRing;
+    size_t                      bufRingSize;
+    UINT8                       *pBufs;
+    size_t                      bufsSize;
+    UINT32                      bufStride;
+    UINT16                      bufTail;
+    struct msghdr               recvMsg;        /* template of the multishot receives */
+    RING_SEND_T                 *pSend;         /* one per submission queue entry */
+    RING_WATCH_T                watch[RING_MAX_WATCH];
+    UINT32                      closeCnt;       /* gVosSockCloseCnt when the requests were armed */
+    VOS_FDS_T                   readyFds;
+    INT32                       readyCnt;
+    UINT32                      enters;
+    UINT32                      sendErrors;
+};
+
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Hand the filled submission queue entries to the kernel, optionally wait for a completion
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      pTimeout        maximum time to wait, NULL: do not wait
+ *
+ *  @retval         VOS_NO_ERR      no error (or timeout, interrupted)
+ *  @retval         VOS_IO_ERR      io_uring_enter() failed
+ */
+static VOS_ERR_T ringEnter (
+    VOS_RING_T          ring,
+    const VOS_TIMEVAL_T *pTimeout)
+{
+    struct io_uring_getevents_arg   arg;
+    struct __kernel_timespec        ts;
+    UINT32                          toSubmit    = ring->sqTail - ring->sqFlushed;
+    UINT32                          flags       = 0u;
+    long                            ret;
+
+    __atomic_store_n(ring->pSqTail, ring->sqTail, __ATOMIC_RELEASE);
+    ring->sqFlushed = ring->sqTail;
+
+    memset(&arg, 0, sizeof(arg));
+    if (pTimeout != NULL)
+    {
+        ts.tv_sec   = pTimeout->tv_sec;
+        ts.tv_nsec  = (long long) pTimeout->tv_usec * 1000;
+        arg.ts      = (UINT64) (size_t) &ts;
+        flags       = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    }
+
+    ring->enters++;
+    ret = syscall(__NR_io_uring_enter, ring->fd, toSubmit, (pTimeout != NULL) ? 1u : 0u, flags,
+                  (pTimeout != NULL) ? &arg : NULL, sizeof(arg));
+    if ((ret == -1) && (errno != ETIME) && (errno != EINTR) && (errno != EBUSY))
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "io_uring_enter() failed (Err: %s)\n", buff);
+        return VOS_IO_ERR;
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get a cleared submission queue entry, flush the queue if it is full
+ *
+ *  @param[in]      ring            ring handle
+ *
+ *  @retval         entry, NULL if the queue stays full
+ */
+static struct io_uring_sqe *ringGetSqe (
+    VOS_RING_T ring)
+{
+    struct io_uring_sqe *pSqe;
+    UINT32              idx;
+
+    if ((ring->sqTail - __atomic_load_n(ring->pSqHead, __ATOMIC_ACQUIRE)) >= ring->sqEntries)
+    {
+        (void) ringEnter(ring, NULL);
+        if ((ring->sqTail - __atomic_load_n(ring->pSqHead, __ATOMIC_ACQUIRE)) >= ring->sqEntries)
+        {
+            return NULL;
+        }
+    }
+    idx     = ring->sqTail & ring->sqMask;
+    pSqe    = &ring->pSqes[idx];
+    memset(pSqe, 0, sizeof(*pSqe));
+    ring->pSqArray[idx] = idx;
+    ring->sqTail++;
+    return pSqe;
+}
+
+/**********************************************************************************************************************/
+/** Return a receive buffer to the pool
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      bid             buffer id
+ */
+static void ringAddBuffer (
+    VOS_RING_T  ring,
+    UINT16      bid)
+{
+    struct io_uring_buf *pBuf = &ring->pBufRing->bufs[ring->bufTail & (VOS_RING_BUFFERS - 1u)];
+
+    pBuf->addr  = (UINT64) (size_t) (ring->pBufs + (size_t) bid * ring->bufStride);
+    pBuf->len   = ring->bufStride;
+    pBuf->bid   = bid;
+    ring->bufTail++;
+    __atomic_store_n(&ring->pBufRing->tail, ring->bufTail, __ATOMIC_RELEASE);
+}
+
+/**********************************************************************************************************************/
+/** Arm the request of a watched socket
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      idx             index of the watched socket
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_IO_ERR      submission queue full
+ */
+static VOS_ERR_T ringArm (
+    VOS_RING_T  ring,
+    UINT32      idx)
+{
+    RING_WATCH_T        *pWatch = &ring->watch[idx];
+    struct io_uring_sqe *pSqe   = ringGetSqe(ring);
+
+    if (pSqe == NULL)
+    {
+        return VOS_IO_ERR;
+    }
+    pWatch->gen++;
+    pSqe->fd        = pWatch->sock;
+    pSqe->user_data = RING_UD(pWatch->kind, pWatch->gen, idx);
+    if (pWatch->kind == RING_UD_RECV)
+    {
+        pSqe->opcode    = IORING_OP_RECVMSG;
+        pSqe->addr      = (UINT64) (size_t) &ring->recvMsg;
+        pSqe->len       = 1u;
+        pSqe->ioprio    = IORING_RECV_MULTISHOT;
+        pSqe->flags     = IOSQE_BUFFER_SELECT;
+        pSqe->buf_group = RING_BUF_GROUP;
+    }
+    else
+    {
+        pSqe->opcode        = IORING_OP_POLL_ADD;
+        pSqe->poll32_events = POLLIN;
+    }
+    pWatch->armed = TRUE;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Cancel the request of a watched socket
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      idx             index of the watched socket
+ */
+static void ringCancel (
+    VOS_RING_T  ring,
+    UINT32      idx)
+{
+    RING_WATCH_T        *pWatch = &ring->watch[idx];
+    struct io_uring_sqe *pSqe;
+
+    if (pWatch->armed == TRUE)
+    {
+        pSqe = ringGetSqe(ring);
+        if (pSqe != NULL)
+        {
+            pSqe->opcode    = IORING_OP_ASYNC_CANCEL;
+            pSqe->fd        = -1;
+            pSqe->addr      = RING_UD(pWatch->kind, pWatch->gen, idx);
+            pSqe->user_data = RING_UD(RING_UD_CANCEL, 0u, 0u);
+        }
+        pWatch->armed = FALSE;
+    }
+    pWatch->gen++;              /* completions of the cancelled request are stale */
+    pWatch->sock = VOS_INVALID_SOCKET;
+}
+
+/**********************************************************************************************************************/
+/** Take a received datagram out of its buffer
+ *
+ *  @retval         VOS_NO_ERR      datagram returned
+ *  @retval         VOS_NODATA_ERR  truncated or larger than the caller's buffer
+ */
+static VOS_ERR_T ringTakeDatagram (
+    VOS_RING_T      ring,
+    const UINT8     *pBuf,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource)
+{
+    const struct io_uring_recvmsg_out   *pOut   = (const struct io_uring_recvmsg_out *) pBuf;
+    const UINT8                         *pName  = pBuf + sizeof(*pOut);
+    const UINT8                         *pControl;
+    struct sockaddr_in                  srcAddr;
+    struct msghdr                       msg;
+    struct cmsghdr                      *cmsg;
+
+    pControl = pName + ring->recvMsg.msg_namelen;
+    if (((pOut->flags & MSG_TRUNC) != 0) || (pOut->payloadlen > *pSize))
+    {
+        return VOS_NODATA_ERR;
+    }
+    memcpy(pBuffer, pControl + ring->recvMsg.msg_controllen, pOut->payloadlen);
+    *pSize = pOut->payloadlen;
+
+    memset(&srcAddr, 0, sizeof(srcAddr));
+    memcpy(&srcAddr, pName, (pOut->namelen < sizeof(srcAddr)) ? pOut->namelen : sizeof(srcAddr));
+    *pSrcIPAddr = (UINT32) vos_ntohl(srcAddr.sin_addr.s_addr);
+    *pSrcIPPort = (UINT16) vos_ntohs(srcAddr.sin_port);
+    *pDstIPAddr = 0u;
+    *pSrcIFAddr = 0u;
+
+    vos_getTime(pRxTime);
+    *pRxTimeSource = VOS_TS_APPLICATION;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control     = (void *) pControl;
+    msg.msg_controllen  = (pOut->controllen < RING_CONTROL_SIZE) ? pOut->controllen : RING_CONTROL_SIZE;
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET)
+        {
+            vos_sockRxStamp(cmsg, pRxTime, pRxTimeSource);
+        }
+        else if ((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_PKTINFO))
+        {
+            struct in_pktinfo pktInfo;
+
+            memcpy(&pktInfo, CMSG_DATA(cmsg), sizeof(pktInfo));
+            *pDstIPAddr = (UINT32) vos_ntohl(pktInfo.ipi_addr.s_addr);
+            *pSrcIFAddr = vos_getInterfaceIP((UINT32) pktInfo.ipi_ifindex);   /* #322 */
+        }
+    }
+    return VOS_NO_ERR;
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Create a ring.
+ *
+ *  @param[in]      bufSize         size of one receive buffer (largest datagram)
+ *  @param[out]     pRing           pointer to ring handle returned
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_UNKNOWN_ERR io_uring or one of the needed features not supported by the kernel
+ */
+EXT_DECL VOS_ERR_T vos_ringCreate (
+    UINT32      bufSize,
+    VOS_RING_T  *pRing)
+{
+    struct io_uring_params  params;
+    struct io_uring_buf_reg bufReg;
+    VOS_RING_T              ring;
+    size_t                  cqSize;
+    UINT32                  i;
+
+    if ((pRing == NULL) || (bufSize == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    ring = (VOS_RING_T) vos_memAlloc(sizeof(struct VOS_RING));
+    if (ring == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+    ring->pRingMem  = MAP_FAILED;
+    ring->pSqes     = MAP_FAILED;
+    ring->pBufRing  = MAP_FAILED;
+    ring->pBufs     = MAP_FAILED;
+    for (i = 0u; i < RING_MAX_WATCH; i++)
+    {
+        ring->watch[i].sock = VOS_INVALID_SOCKET;
+    }
+    ring->closeCnt = gVosSockCloseCnt;
+
+    memset(&params, 0, sizeof(params));
+    params.flags        = IORING_SETUP_CQSIZE;
+    params.cq_entries   = 4u * VOS_RING_ENTRIES;
+    ring->fd = (int) syscall(__NR_io_uring_setup, VOS_RING_ENTRIES, &params);
+    if ((ring->fd < 0) ||
+        ((params.features & (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)) !=
+         (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG)))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "io_uring not available\n");
+        vos_ringDestroy(ring);
+        return VOS_UNKNOWN_ERR;
+    }
+
+    /*  Submission and completion queue share one mapping   */
+    ring->ringMemSize   = params.sq_off.array + params.sq_entries * sizeof(UINT32);
+    cqSize              = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (cqSize > ring->ringMemSize)
+    {
+        ring->ringMemSize = cqSize;
+    }
+    ring->sqesSize  = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->pRingMem  = (UINT8 *) mmap(NULL, ring->ringMemSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     ring->fd, IORING_OFF_SQ_RING);
+    ring->pSqes     = (struct io_uring_sqe *) mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE,
+                                                   MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    ring->pSend     = (RING_SEND_T *) vos_memAlloc(params.sq_entries * sizeof(RING_SEND_T));
+    if ((ring->pRingMem == MAP_FAILED) || (ring->pSqes == MAP_FAILED) || (ring->pSend == NULL))
+    {
+        vos_ringDestroy(ring);
+        return VOS_MEM_ERR;
+    }
+    ring->pSqHead   = (UINT32 *) (ring->pRingMem + params.sq_off.head);
+    ring->pSqTail   = (UINT32 *) (ring->pRingMem + params.sq_off.tail);
+    ring->pSqArray  = (UINT32 *) (ring->pRingMem + params.sq_off.array);
+    ring->sqMask    = *(UINT32 *) (ring->pRingMem + params.sq_off.ring_mask);
+    ring->sqEntries = params.sq_entries;
+    ring->sqTail    = *ring->pSqTail;
+    ring->sqFlushed = ring->sqTail;
+    ring->pCqHead   = (UINT32 *) (ring->pRingMem + params.cq_off.head);
+    ring->pCqTail   = (UINT32 *) (ring->pRingMem + params.cq_off.tail);
+    ring->cqMask    = *(UINT32 *) (ring->pRingMem + params.cq_off.ring_mask);
+    ring->pCqes     = (struct io_uring_cqe *) (ring->pRingMem + params.cq_off.cqes);
+
+    /*  Receive buffer pool: struct io_uring_recvmsg_out, source address, control data, payload  */
+    ring->recvMsg.msg_namelen       = sizeof(struct sockaddr_in);
+    ring->recvMsg.msg_controllen    = RING_CONTROL_SIZE;
+    ring->bufStride     = (UINT32) ((sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_in) +
+                                     RING_CONTROL_SIZE + bufSize + 63u) & ~(size_t) 63u);
+    ring->bufRingSize   = VOS_RING_BUFFERS * sizeof(struct io_uring_buf);
+    ring->bufsSize      = (size_t) VOS_RING_BUFFERS * ring->bufStride;
+    ring->pBufRing      = (struct io_uring_buf_ring *) mmap(NULL, ring->bufRingSize, PROT_READ | PROT_WRITE,
+                                                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ring->pBufs         = (UINT8 *) mmap(NULL, ring->bufsSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                         -1, 0);
+    if ((ring->pBufRing == MAP_FAILED) || (ring->pBufs == MAP_FAILED))
+    {
+        vos_ringDestroy(ring);
+        return VOS_MEM_ERR;
+    }
+    memset(&bufReg, 0, sizeof(bufReg));
+    bufReg.ring_addr    = (UINT64) (size_t) ring->pBufRing;
+    bufReg.ring_entries = VOS_RING_BUFFERS;
+    bufReg.bgid         = RING_BUF_GROUP;
+    if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PBUF_RING, &bufReg, 1) != 0)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "io_uring provided buffer rings not available\n");
+        vos_ringDestroy(ring);
+        return VOS_UNKNOWN_ERR;
+    }
+    for (i = 0u; i < VOS_RING_BUFFERS; i++)
+    {
+        ringAddBuffer(ring, (UINT16) i);
+    }
+
+    *pRing = ring;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Cancel all requests and release a ring.
+ *
+ *  @param[in]      ring            ring handle
+ */
+EXT_DECL void vos_ringDestroy (
+    VOS_RING_T ring)
+{
+    if (ring == NULL)
+    {
+        return;
+    }
+    /*  Closing the ring cancels the requests still in the kernel    */
+    if (ring->fd >= 0)
+    {
+        (void) close(ring->fd);
+    }
+    if (ring->pRingMem != MAP_FAILED)
+    {
+        (void) munmap(ring->pRingMem, ring->ringMemSize);
+    }
+    if (ring->pSqes != MAP_FAILED)
+    {
+        (void) munmap(ring->pSqes, ring->sqesSize);
+    }
+    if (ring->pBufRing != MAP_FAILED)
+    {
+        (void) munmap(ring->pBufRing, ring->bufRingSize);
+    }
+    if (ring->pBufs != MAP_FAILED)
+    {
+        (void) munmap(ring->pBufs, ring->bufsSize);
+    }
+    if (ring->pSend != NULL)
+    {
+        vos_memFree(ring->pSend);
+    }
+    vos_memFree(ring);
+}
+
+/**********************************************************************************************************************/
+/** Set the sockets watched by the ring.
+ *  Sockets in the receive set get a multishot receive (UDP), sockets in the poll set a readiness poll. Requests of
+ *  sockets no longer in the sets are cancelled, ended requests are re-armed. The requests are handed to the kernel
+ *  with the next vos_ringSubmit() or vos_ringWait().
+ *  A request keeps its socket open in the kernel, so after any vos_sockClose() all requests are cancelled and armed
+ *  again: a new socket may have got the number of a closed one.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      pRecvFds        sockets to receive from, may be NULL
+ *  @param[in]      pPollFds        sockets to poll, may be NULL
+ *  @param[in]      noDesc          highest socket descriptor in the sets
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_QUEUE_FULL_ERR  too many sockets
+ */
+EXT_DECL VOS_ERR_T vos_ringWatch (
+    VOS_RING_T      ring,
+    const VOS_FDS_T *pRecvFds,
+    const VOS_FDS_T *pPollFds,
+    VOS_SOCK_T      noDesc)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    VOS_SOCK_T  sock;
+    UINT32      kind;
+    UINT32      i, freeIdx;
+
+    if (ring == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (ring->closeCnt != gVosSockCloseCnt)
+    {
+        ring->closeCnt = gVosSockCloseCnt;
+        for (i = 0u; i < RING_MAX_WATCH; i++)
+        {
+            ringCancel(ring, i);
+        }
+    }
+
+    for (i = 0u; i < RING_MAX_WATCH; i++)
+    {
+        ring->watch[i].wanted = FALSE;
+    }
+    for (sock = 0; (sock <= noDesc) && (sock < FD_SETSIZE); sock++)
+    {
+        if ((pRecvFds != NULL) && FD_ISSET(sock, pRecvFds))
+        {
+            kind = RING_UD_RECV;
+        }
+        else if ((pPollFds != NULL) && FD_ISSET(sock, pPollFds))
+        {
+            kind = RING_UD_POLL;
+        }
+        else
+        {
+            continue;
+        }
+        freeIdx = RING_MAX_WATCH;
+        for (i = 0u; i < RING_MAX_WATCH; i++)
+        {
+            if ((ring->watch[i].sock == sock) && (ring->watch[i].kind == kind))
+            {
+                break;
+            }
+            if ((ring->watch[i].sock == VOS_INVALID_SOCKET) && (freeIdx == RING_MAX_WATCH))
+            {
+                freeIdx = i;
+            }
+        }
+        if (i == RING_MAX_WATCH)
+        {
+            if (freeIdx == RING_MAX_WATCH)
+            {
+                err = VOS_QUEUE_FULL_ERR;
+                continue;
+            }
+            i = freeIdx;
+            ring->watch[i].sock     = sock;
+            ring->watch[i].kind     = kind;
+            ring->watch[i].armed    = FALSE;
+        }
+        ring->watch[i].wanted = TRUE;
+    }
+
+    for (i = 0u; i < RING_MAX_WATCH; i++)
+    {
+        if (ring->watch[i].sock == VOS_INVALID_SOCKET)
+        {
+            continue;
+        }
+        if (ring->watch[i].wanted == FALSE)
+        {
+            ringCancel(ring, i);
+        }
+        else if ((ring->watch[i].armed == FALSE) && (ringArm(ring, i) != VOS_NO_ERR))
+        {
+            err = VOS_QUEUE_FULL_ERR;
+        }
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Queue an UDP datagram.
+ *  The data is read by the next vos_ringSubmit() or vos_ringWait() and must not change until then. The send never
+ *  blocks: if the socket buffer is full the datagram is dropped and counted.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to data to send
+ *  @param[in]      size            size of the data to send
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_IO_ERR      submission queue full and could not be flushed
+ */
+EXT_DECL VOS_ERR_T vos_ringSendUDP (
+    VOS_RING_T  ring,
+    VOS_SOCK_T  sock,
+    const UINT8 *pBuffer,
+    UINT32      size,
+    UINT32      ipAddress,
+    UINT16      port)
+{
+    struct io_uring_sqe *pSqe;
+    RING_SEND_T         *pSend;
+
+    if ((ring == NULL) || (sock == VOS_INVALID_SOCKET) || (pBuffer == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    pSqe = ringGetSqe(ring);
+    if (pSqe == NULL)
+    {
+        return VOS_IO_ERR;
+    }
+    pSend = &ring->pSend[pSqe - ring->pSqes];
+    memset(pSend, 0, sizeof(*pSend));
+    pSend->addr.sin_family      = AF_INET;
+    pSend->addr.sin_addr.s_addr = vos_htonl(ipAddress);
+    pSend->addr.sin_port        = vos_htons(port);
+    pSend->iov.iov_base         = (void *) pBuffer;
+    pSend->iov.iov_len          = size;
+    pSend->msg.msg_name         = &pSend->addr;
+    pSend->msg.msg_namelen      = sizeof(pSend->addr);
+    pSend->msg.msg_iov          = &pSend->iov;
+    pSend->msg.msg_iovlen       = 1;
+
+    pSqe->opcode    = IORING_OP_SENDMSG;
+    pSqe->fd        = sock;
+    pSqe->addr      = (UINT64) (size_t) &pSend->msg;
+    pSqe->len       = 1u;
+    pSqe->msg_flags = MSG_DONTWAIT;             /* never parked in the kernel, the data is read at once */
+    pSqe->flags     = IOSQE_CQE_SKIP_SUCCESS;
+    pSqe->user_data = RING_UD(RING_UD_SEND, 0u, 0u);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Hand the queued requests to the kernel, without waiting.
+ *  Queued datagrams are sent when the call returns.
+ *
+ *  @param[in]      ring            ring handle
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_IO_ERR      io_uring_enter() failed
+ */
+EXT_DECL VOS_ERR_T vos_ringSubmit (
+    VOS_RING_T ring)
+{
+    if ((ring == NULL) || (ring->sqTail == ring->sqFlushed))
+    {
+        return VOS_NO_ERR;
+    }
+    return ringEnter(ring, NULL);
+}
+
+/**********************************************************************************************************************/
+/** Hand the queued requests to the kernel and wait for a completion.
+ *  Returns at once if completions are pending, without a system call.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[in]      pTimeout        maximum time to wait
+ *
+ *  @retval         VOS_NO_ERR      completion pending
+ *  @retval         VOS_TIMEOUT_ERR no completion within the time
+ *  @retval         VOS_IO_ERR      io_uring_enter() failed
+ */
+EXT_DECL VOS_ERR_T vos_ringWait (
+    VOS_RING_T          ring,
+    const VOS_TIMEVAL_T *pTimeout)
+{
+    VOS_ERR_T err;
+
+    if ((ring == NULL) || (pTimeout == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (*ring->pCqHead != __atomic_load_n(ring->pCqTail, __ATOMIC_ACQUIRE))
+    {
+        return vos_ringSubmit(ring);
+    }
+    err = ringEnter(ring, pTimeout);
+    if (err != VOS_NO_ERR)
+    {
+        return err;
+    }
+    return (*ring->pCqHead != __atomic_load_n(ring->pCqTail, __ATOMIC_ACQUIRE)) ? VOS_NO_ERR : VOS_TIMEOUT_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the next received UDP datagram.
+ *  Completions of sends and polls met on the way are consumed, ready polled sockets are collected for
+ *  vos_ringGetReady(). Datagrams larger than the buffer are dropped.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pSock           pointer to the receiving socket
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           In: size of the buffer, Out: size of the datagram
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[out]     pRxTime         pointer to receive time (vos_getTime() time base)
+ *  @param[out]     pRxTimeSource   pointer to source of the receive time (VOS_TS_...)
+ *
+ *  @retval         VOS_NO_ERR      datagram returned
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_NODATA_ERR  no more completions
+ */
+EXT_DECL VOS_ERR_T vos_ringReceiveUDP (
+    VOS_RING_T      ring,
+    VOS_SOCK_T      *pSock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource)
+{
+    UINT32  head;
+    UINT64  userData;
+    INT32   res;
+    UINT32  flags;
+
+    if ((ring == NULL) || (pSock == NULL) || (pBuffer == NULL) || (pSize == NULL) || (pSrcIPAddr == NULL) ||
+        (pSrcIPPort == NULL) || (pDstIPAddr == NULL) || (pSrcIFAddr == NULL) || (pRxTime == NULL) ||
+        (pRxTimeSource == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    for (head = *ring->pCqHead; head != __atomic_load_n(ring->pCqTail, __ATOMIC_ACQUIRE); )
+    {
+        const struct io_uring_cqe   *pCqe = &ring->pCqes[head & ring->cqMask];
+        RING_WATCH_T                *pWatch;
+        VOS_ERR_T                   err = VOS_NODATA_ERR;
+
+        userData    = pCqe->user_data;
+        res         = pCqe->res;
+        flags       = pCqe->flags;
+        head++;
+        __atomic_store_n(ring->pCqHead, head, __ATOMIC_RELEASE);
+
+        /*  Completion of the current request of a watched socket?  */
+        pWatch = NULL;
+        if ((RING_UD_IDX(userData) < RING_MAX_WATCH) &&
+            (ring->watch[RING_UD_IDX(userData)].gen == RING_UD_GEN(userData)) &&
+            (ring->watch[RING_UD_IDX(userData)].sock != VOS_INVALID_SOCKET))
+        {
+            pWatch = &ring->watch[RING_UD_IDX(userData)];
+        }
+
+        switch (RING_UD_KIND(userData))
+        {
+            case RING_UD_SEND:
+                if (ring->sendErrors++ == 0u)
+                {
+                    vos_printLog(VOS_LOG_WARNING, "ring send failed (Err: %d)\n", (int) -res);
+                }
+                break;
+            case RING_UD_POLL:
+                if (pWatch != NULL)
+                {
+                    pWatch->armed = FALSE;
+                    if ((res > 0) && !FD_ISSET(pWatch->sock, &ring->readyFds))
+                    {
+                        FD_SET(pWatch->sock, &ring->readyFds);
+                        ring->readyCnt++;
+                    }
+                }
+                break;
+            case RING_UD_RECV:
+                if ((pWatch != NULL) && ((flags & IORING_CQE_F_MORE) == 0u))
+                {
+                    pWatch->armed = FALSE;      /* ended (e.g. pool empty), armed again by vos_ringWatch() */
+                }
+                if ((flags & IORING_CQE_F_BUFFER) != 0u)
+                {
+                    UINT16 bid = (UINT16) (flags >> IORING_CQE_BUFFER_SHIFT);
+
+                    if ((pWatch != NULL) && (res > 0))
+                    {
+                        err = ringTakeDatagram(ring, ring->pBufs + (size_t) bid * ring->bufStride, pBuffer, pSize,
+                                               pSrcIPAddr, pSrcIPPort, pDstIPAddr, pSrcIFAddr, pRxTime,
+                                               pRxTimeSource);
+                        *pSock = pWatch->sock;
+                    }
+                    ringAddBuffer(ring, bid);
+                    if (err == VOS_NO_ERR)
+                    {
+                        return VOS_NO_ERR;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return VOS_NODATA_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the polled sockets which became ready, as select() would return them.
+ *  Call after vos_ringReceiveUDP() returned VOS_NODATA_ERR. The collected sockets are cleared.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pReadyFds       set of ready sockets
+ *
+ *  @retval         number of ready sockets
+ */
+EXT_DECL INT32 vos_ringGetReady (
+    VOS_RING_T  ring,
+    VOS_FDS_T   *pReadyFds)
+{
+    INT32 count;
+
+    if ((ring == NULL) || (pReadyFds == NULL))
+    {
+        return 0;
+    }
+    *pReadyFds      = ring->readyFds;
+    count           = ring->readyCnt;
+    FD_ZERO(&ring->readyFds);
+    ring->readyCnt  = 0;
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Get the ring counters.
+ *
+ *  @param[in]      ring            ring handle
+ *  @param[out]     pEnters         pointer to number of io_uring_enter() calls
+ *  @param[out]     pSendErrors     pointer to number of datagrams not sent
+ */
+EXT_DECL void vos_ringGetStatistics (
+    VOS_RING_T  ring,
+    UINT32      *pEnters,
+    UINT32      *pSendErrors)
+{
+    if ((ring == NULL) || (pEnters == NULL) || (pSendErrors == NULL))
+    {
+        return;
+    }
+    *pEnters        = ring->enters;
+    *pSendErrors    = ring->sendErrors;
+}
+
+#endif
@@ -63,6 +63,7 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <sched.h>
+#include <string.h>
 
 #ifdef HAS_UUID
 #include <uuid/uuid.h>
@@ -303,27 +304,161 @@ static int clock_nanosleep (
 #define MSECS_PER_SEC   1000u
 #define NSECS_PER_SEC   1000000000uLL;
 
-/* This define holds the max amount os seconds to get stored in 32bit holding micro seconds        */
-/* It is the result when using the common time struct with tv_sec and tv_usec as on a 32 bit value */
-/* so far 0..999999 gets used for the tv_usec field as per definition, then 0xFFF0BDC0 usec        */
-/* are remaining to represent the seconds, which in turn give 0x10C5 seconds or in decimal 4293    */
-#define MAXSEC_FOR_USECPRESENTATION  4293
+#define USECS_PER_SEC   1000000u
+
+#ifndef VOS_MAX_CYCLIC_THREADS
+#define VOS_MAX_CYCLIC_THREADS  32u     /**< Cyclic threads with statistics at the same time                         */
+#endif
+
+/* A lag of more than this is taken as a step of the real time clock: resynchronise, whatever the catch-up policy */
+#define VOS_CYCLIC_MAX_LAG_US   1000000u
+
+/* Upper bounds of the wakeup latency buckets in us, the last bucket is open */
+static const UINT32 cLatencyBounds[VOS_THREAD_LATENCY_BUCKETS - 1u] = {10u, 25u, 50u, 100u, 250u, 500u, 1000u};
 
 typedef struct
 {
-    const CHAR8         *pName;
+    BOOL8               inUse;
+    pthread_t           thread;         /* set by the creator after pthread_create()                             */
+    CHAR8               name[16];
     VOS_TIMEVAL_T       startTime;
     UINT32              interval;
     VOS_THREAD_FUNC_T   pFunction;
     void                *pArguments;
+    VOS_THREAD_STATS_T  stats;          /* statistics and catch-up policy, protected by sCyclicMutex             */
+    UINT64              execTimeSum;
+    UINT64              firstStart;
 } VOS_THREAD_CYC_T;
 
+/* Cyclic threads; an entry is reserved by vos_threadCreateSync() and released when its thread is cancelled */
+static VOS_THREAD_CYC_T sCyclicThreads[VOS_MAX_CYCLIC_THREADS];
+static pthread_mutex_t  sCyclicMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**********************************************************************************************************************/
+/** Release the entry of a cyclic thread (cancellation clean-up handler).
+ *
+ *  @param[in]      pArg            Pointer to the entry
+ *
+ *  @retval         none
+ */
+static void vos_cyclicRelease (
+    void *pArg)
+{
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    ((VOS_THREAD_CYC_T *) pArg)->inUse = FALSE;
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+}
+
+/**********************************************************************************************************************/
+/** Find the entry of a cyclic thread, sCyclicMutex must be held.
+ *
+ *  @param[in]      thread          Thread handle
+ *
+ *  @retval         entry or NULL
+ */
+static VOS_THREAD_CYC_T *vos_cyclicFind (
+    VOS_THREAD_T thread)
+{
+    UINT32 i;
+
+    for (i = 0u; i < VOS_MAX_CYCLIC_THREADS; i++)
+    {
+        if ((sCyclicThreads[i].inUse == TRUE) && (thread != NULL) &&
+            pthread_equal(sCyclicThreads[i].thread, (pthread_t) thread))
+        {
+            return &sCyclicThreads[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Record one cycle and compute the due time of the next one.
+ *  A cycle ending after the next one was due is an overrun. With VOS_THREAD_CATCHUP_SKIP the next cycle is due on
+ *  the first cycle boundary after the end, with VOS_THREAD_CATCHUP_COMPRESS it stays due at once, so the missed
+ *  cycles run back to back.
+ *
+ *  @param[in]      pCyc            Cyclic thread
+ *  @param[in]      due             Due time of the cycle in us
+ *  @param[in]      start           Start time of the cycle (wakeup) in us
+ *  @param[in]      end             End time of the cycle in us
+ *
+ *  @retval         due time of the next cycle in us
+ */
+static UINT64 vos_cyclicRecord (
+    VOS_THREAD_CYC_T    *pCyc,
+    UINT64              due,
+    UINT64              start,
+    UINT64              end)
+{
+    UINT64  interval    = pCyc->interval;
+    UINT64  next        = due + interval;
+    UINT64  missed      = 0u;
+    UINT32  latency     = 0u;
+    UINT32  execTime    = 0u;
+    UINT32  bucket      = 0u;
+
+    /* The real time clock may have been set back meanwhile */
+    if (start > due)
+    {
+        latency = ((start - due) > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) (start - due);
+    }
+    if (end > start)
+    {
+        execTime = ((end - start) > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) (end - start);
+    }
+    while ((bucket < (VOS_THREAD_LATENCY_BUCKETS - 1u)) && (latency > cLatencyBounds[bucket]))
+    {
+        bucket++;
+    }
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    if (pCyc->stats.cycles == 0u)
+    {
+        pCyc->firstStart = start;
+    }
+    pCyc->stats.cycles++;
+    pCyc->execTimeSum += execTime;
+    pCyc->stats.execTimeAvg = (UINT32) (pCyc->execTimeSum / pCyc->stats.cycles);
+    if (execTime > pCyc->stats.execTimeMax)
+    {
+        pCyc->stats.execTimeMax = execTime;
+    }
+    if (latency > pCyc->stats.wakeupLatencyMax)
+    {
+        pCyc->stats.wakeupLatencyMax = latency;
+    }
+    pCyc->stats.wakeupLatency[bucket]++;
+
+    if (end > next)
+    {
+        pCyc->stats.overruns++;
+        if ((pCyc->stats.catchUp == VOS_THREAD_CATCHUP_SKIP) || ((end - next) > VOS_CYCLIC_MAX_LAG_US))
+        {
+            missed  = (end - next) / interval + 1u;
+            next    += missed * interval;
+            pCyc->stats.skipped += (UINT32) missed;
+        }
+    }
+    pCyc->stats.drift = (INT64) (start - pCyc->firstStart) - (INT64) (pCyc->stats.cycles - 1u) * (INT64) interval;
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+
+    if (missed > 0u)
+    {
+        vos_printLog(VOS_LOG_WARNING,
+                     "cyclic thread %s with interval %u usec was running %u usec, %u cycles skipped\n",
+                     pCyc->name, (unsigned int) interval, (unsigned int) execTime, (unsigned int) missed);
+    }
+    return next;
+}
+
 /**********************************************************************************************************************/
 /** Execute a cyclic thread function.
  *  This function blocks by cyclically executing the provided user function. If supported by the OS,
  *  uses real-time threads and tries to sync to the supplied start time.
+ *  The timing of every cycle is recorded in the thread's entry, which is released when the thread is cancelled.
  *
- *  @param[in]      pParameters     Pointer to the thread function parameters
+ *  @param[in]      pParameters     Pointer to the thread's entry
  *
  *  @retval         none
  */
@@ -333,24 +468,21 @@ static void vos_runCyclicThread (
 #if defined(SCHED_DEADLINE) && (defined(RT_THREADS) || defined(TSN_SUPPORT))
     struct timespec     deadline;
     struct timespec     now;
-    struct timespec nowMono;
+    struct timespec     nowMono;
+    UINT64              startUs;
+    const CHAR8         *name       = pParameters->name;
 #else
     VOS_TIMEVAL_T       now;
-    VOS_TIMEVAL_T       priorCall;
-    VOS_TIMEVAL_T       afterCall;
-    UINT32              execTime;
-    UINT32              waitingTime;
+    UINT64              nowUs;
+    UINT64              startUs;
+    UINT64              due;
 #endif
     UINT32              interval    = pParameters->interval;
     VOS_THREAD_FUNC_T   pFunction   = pParameters->pFunction;
     void                *pArguments = pParameters->pArguments;
     VOS_TIMEVAL_T       startTime   = pParameters->startTime;
-    CHAR8               name[16];
 
-    vos_strncpy(name, pParameters->pName, 16);      /* for logging */
-
-    vos_printLog(VOS_LOG_DBG, "thread parameters freed: %p\n", (void *) pParameters);
-    vos_memFree(pParameters);
+    pthread_cleanup_push(vos_cyclicRelease, pParameters);
 
 #if defined(SCHED_DEADLINE) && (defined(RT_THREADS) || defined(TSN_SUPPORT))
 
@@ -385,7 +517,7 @@ static void vos_runCyclicThread (
                          name,
                          (int)rt_attribs.sched_policy,
                          (int)errno);
-            return;
+            pthread_exit(NULL);     /* releases the entry */
         }
     }
 
@@ -412,14 +544,23 @@ static void vos_runCyclicThread (
                              name);
             }
         }
+        (void)clock_gettime(CLOCK_MONOTONIC, &nowMono);
+        startUs = (UINT64) nowMono.tv_sec * USECS_PER_SEC + (UINT64) nowMono.tv_nsec / NSECS_PER_USEC;
+
         pFunction(pArguments);
 
+        /* The kernel schedules the deadline task, the catch-up policy does not apply */
+        (void)clock_gettime(CLOCK_MONOTONIC, &nowMono);
+        (void) vos_cyclicRecord(pParameters,
+                                (UINT64) deadline.tv_sec * USECS_PER_SEC + (UINT64) deadline.tv_nsec / NSECS_PER_USEC,
+                                startUs,
+                                (UINT64) nowMono.tv_sec * USECS_PER_SEC + (UINT64) nowMono.tv_nsec / NSECS_PER_USEC);
+
         /* calculate next deadline */
         deadline.tv_nsec    += interval_ns;
         deadline.tv_sec     += deadline.tv_nsec / NSECS_PER_SEC;
         deadline.tv_nsec    = deadline.tv_nsec % NSECS_PER_SEC;
 
-        (void)clock_gettime(CLOCK_MONOTONIC, &nowMono);
         if (nowMono.tv_sec > deadline.tv_sec || (nowMono.tv_sec == deadline.tv_sec && nowMono.tv_nsec > deadline.tv_nsec))
         {
             UINT32 too_late = (1000 * 1000 * (nowMono.tv_sec - deadline.tv_sec)) + ((nowMono.tv_nsec - deadline.tv_nsec) / 1000);
@@ -437,64 +578,43 @@ static void vos_runCyclicThread (
     }
 
 #else
-    for (;; )
+    /* Synchronize with starttime: the first cycle is due on the next multiple of interval after it */
+    /* See: https://stackoverflow.com/questions/54241080/how-to-schedule-a-real-time-task-with-absolute-start-time */
+    /* use CLOCK_REALTIME: in most environments the realtime clock runs synchronized to TSN- / PTP-time */
+    (void)vos_getRealTime(&now);
+    nowUs   = (UINT64) now.tv_sec * USECS_PER_SEC + (UINT64) now.tv_usec;
+    startUs = (UINT64) startTime.tv_sec * USECS_PER_SEC + (UINT64) startTime.tv_usec;
+    if (nowUs < startUs)
     {
-        /* Synchronize with starttime */
-        /* See: https://stackoverflow.com/questions/54241080/how-to-schedule-a-real-time-task-with-absolute-start-time */
-        /* use CLOCK_REALTIME: in most environments the realtime clock runs synchronized to TSN- / PTP-time */
-        (void)vos_getRealTime(&now);             /* get initial time */
-
-        vos_subTime(&now, &startTime);
-
-        /* Wait for multiples of interval */
+        due = startUs;
+    }
+    else
+    {
+        due = nowUs + interval - ((nowUs - startUs) % interval);
+    }
 
-        execTime    = ((UINT32)now.tv_usec % interval);
-        waitingTime = interval - execTime;
-        if (waitingTime > interval)
+    for (;; )
+    {
+        /* Idle until the cycle is due (not at all while catching up) */
+        (void)vos_getRealTime(&now);
+        nowUs = (UINT64) now.tv_sec * USECS_PER_SEC + (UINT64) now.tv_usec;
+        if (due > nowUs)
         {
-            vos_printLog(VOS_LOG_ERROR,
-                         "waiting time > interval:  %u > %u usec!\n",
-                         (unsigned int) waitingTime, (unsigned int) interval);
+            (void) vos_threadDelay((UINT32) (due - nowUs));
+            (void)vos_getRealTime(&now);
+            nowUs = (UINT64) now.tv_sec * USECS_PER_SEC + (UINT64) now.tv_usec;
         }
+        startUs = nowUs;
 
-        /* Idle for the difference */
-        (void) vos_threadDelay(waitingTime);
-
-        (void)vos_getRealTime(&priorCall);       /* get initial time */
         pFunction(pArguments);                   /* perform thread function */
-        (void)vos_getRealTime(&afterCall);       /* get time after function has returned */
 
-        /* subtract in the pattern after - prior to get the runtime of function() */
-        vos_subTime(&afterCall, &priorCall);
-
-        /* afterCall holds now the time difference within a structure not compatible with interval */
-        /* check if UINT32 fits to hold the waiting time value */
-        if (afterCall.tv_sec <= MAXSEC_FOR_USECPRESENTATION)
-        {
-            /*           sec to usec conversion value normalized from 0 .. 999999*/
-            execTime =
-                ((UINT32) ((UINT32)afterCall.tv_sec * MSECS_PER_SEC * USECS_PER_MSEC) + (UINT32)afterCall.tv_usec);
-            if (execTime > interval)
-            {
-                /*  Log the runtime violation */
-                vos_printLog(VOS_LOG_WARNING,
-                             "cyclic thread with interval %u usec was running  %u usec\n",
-                             (unsigned int)interval, (unsigned int)execTime);
-            }
-        }
-        else
-        {
-            /* seems a very critical overflow has happened - or simply a misconfiguration */
-            /* as a rough first guess use zero waiting time here */
-            /* waitingTime = 0U; */
-            /* Have this value range violation logged */
-            vos_printLog(VOS_LOG_ERROR,
-                         "cyclic thread with interval %u usec exceeded time out by running %ld sec\n",
-                         (unsigned int)interval, (long)afterCall.tv_sec);
-        }
+        (void)vos_getRealTime(&now);
+        nowUs   = (UINT64) now.tv_sec * USECS_PER_SEC + (UINT64) now.tv_usec;
+        due     = vos_cyclicRecord(pParameters, due, startUs, nowUs);
         pthread_testcancel();
     }
 #endif
+    pthread_cleanup_pop(1);         /*lint !e527 not reached, pairs pthread_cleanup_push */
 }
 
 /***********************************************************************************************************************
@@ -706,32 +826,58 @@ EXT_DECL VOS_ERR_T vos_threadCreateSync (
     }
     if (interval > 0u)
     {
-        /* malloc freed in vos_runCyclicThread */
-        VOS_THREAD_CYC_T *p_params = (VOS_THREAD_CYC_T *) vos_memAlloc(sizeof(VOS_THREAD_CYC_T));
+        /* Reserve an entry for the parameters and statistics, released when the thread is cancelled */
+        VOS_THREAD_CYC_T    *p_params = NULL;
+        UINT32              i;
+
+        (void) pthread_mutex_lock(&sCyclicMutex);
+        for (i = 0u; i < VOS_MAX_CYCLIC_THREADS; i++)
+        {
+            if (sCyclicThreads[i].inUse == FALSE)
+            {
+                p_params = &sCyclicThreads[i];
+                memset(p_params, 0, sizeof(VOS_THREAD_CYC_T));
+                p_params->inUse = TRUE;
+                break;
+            }
+        }
+        (void) pthread_mutex_unlock(&sCyclicMutex);
 
         if (p_params == NULL)
         {
+            vos_printLog(VOS_LOG_ERROR, "%s more than %u cyclic threads\n", pName, (unsigned int) VOS_MAX_CYCLIC_THREADS);
             return VOS_MEM_ERR;
         }
         else
         {
-			p_params->pName = pName;
-			p_params->startTime.tv_sec  = 0;
-			p_params->startTime.tv_usec = 0;
-			p_params->interval      = interval;
-			p_params->pFunction     = pFunction;
-			p_params->pArguments    = pArguments;
-			vos_printLog(VOS_LOG_DBG, "thread parameters alloc: %p\n", (void *) p_params);
-
-			if (pStartTime != NULL)
-			{
-				p_params->startTime = *pStartTime;
-			}
-				
-			/* Create a cyclic thread */
-			retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(void *))vos_runCyclicThread, p_params);
-			(void) vos_threadDelay(10000u);
-		}
+            vos_strncpy(p_params->name, pName, sizeof(p_params->name) - 1u);
+            p_params->startTime.tv_sec  = 0;
+            p_params->startTime.tv_usec = 0;
+            p_params->interval          = interval;
+            p_params->pFunction         = pFunction;
+            p_params->pArguments        = pArguments;
+            p_params->stats.interval    = interval;
+            p_params->stats.catchUp     = VOS_THREAD_CATCHUP_SKIP;
+
+            if (pStartTime != NULL)
+            {
+                p_params->startTime = *pStartTime;
+            }
+
+            /* Create a cyclic thread */
+            (void) pthread_mutex_lock(&sCyclicMutex);
+            retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(void *))vos_runCyclicThread, p_params);
+            if (retCode == 0)
+            {
+                p_params->thread = hThread;
+            }
+            else
+            {
+                p_params->inUse = FALSE;
+            }
+            (void) pthread_mutex_unlock(&sCyclicMutex);
+            (void) vos_threadDelay(10000u);
+        }
     }
     else
     {
@@ -848,6 +994,73 @@ EXT_DECL VOS_ERR_T vos_threadIsActive (
     return (retValue == 0 ? VOS_NO_ERR : VOS_PARAM_ERR);
 }
 
+/**********************************************************************************************************************/
+/** Set the catch-up policy of a cyclic thread.
+ *  The policy decides what happens after an overrun, i.e. when a cycle ends after the next one was due:
+ *  VOS_THREAD_CATCHUP_SKIP (default) drops the missed cycles, VOS_THREAD_CATCHUP_COMPRESS runs them back to back.
+ *  A lag of more than a second is always skipped. Not applied to SCHED_DEADLINE threads (RT_THREADS).
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[in]      policy          Catch-up policy
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   unknown policy
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetCatchUp (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CATCHUP_T    policy)
+{
+    VOS_THREAD_CYC_T    *pCyc;
+    VOS_ERR_T           err = VOS_NOINIT_ERR;
+
+    if ((policy != VOS_THREAD_CATCHUP_SKIP) && (policy != VOS_THREAD_CATCHUP_COMPRESS))
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyc = vos_cyclicFind(thread);
+    if (pCyc != NULL)
+    {
+        pCyc->stats.catchUp = policy;
+        err = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *
+ *  @param[in]      thread          Handle of a cyclic thread
+ *  @param[out]     pStats          Pointer to returned statistics
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetStatistics (
+    VOS_THREAD_T        thread,
+    VOS_THREAD_STATS_T  *pStats)
+{
+    VOS_THREAD_CYC_T    *pCyc;
+    VOS_ERR_T           err = VOS_NOINIT_ERR;
+
+    if (pStats == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCyc = vos_cyclicFind(thread);
+    if (pCyc != NULL)
+    {
+        *pStats = pCyc->stats;
+        err     = VOS_NO_ERR;
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Return thread handle of calling task
  *
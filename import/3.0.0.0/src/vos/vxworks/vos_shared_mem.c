@@ -180,3 +180,60 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     }
     return VOS_NO_ERR;
 }
+
+/**********************************************************************************************************************/
+/** Attach read-only to an existing shared memory area.
+ *  Not available for this target.
+ *
+ *  @param[in]      pKey               Unique identifier (file name) used by the owner
+ *  @param[out]     ppMemoryArea       Pointer to pointer to mapped memory area
+ *  @param[out]     pSize              Pointer to size of the mapped area
+ *  @retval         VOS_UNKNOWN_ERR    not supported
+ */
+EXT_DECL VOS_ERR_T vos_sharedAttach (
+    const CHAR8 *pKey,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize)
+{
+    (void)pKey;
+    (void)ppMemoryArea;
+    (void)pSize;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Map a file read-only into memory.
+ *  Not available for this target, callers fall back to reading the file.
+ *
+ *  @param[in]      pFileName          Path of the file to map
+ *  @param[out]     ppMemoryArea       Pointer to pointer to mapped memory area
+ *  @param[out]     pSize              Pointer to size of the mapped file
+ *  @retval         VOS_UNKNOWN_ERR    not supported
+ */
+EXT_DECL VOS_ERR_T vos_fileMap (
+    const CHAR8 *pFileName,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize)
+{
+    (void)pFileName;
+    (void)ppMemoryArea;
+    (void)pSize;
+    return VOS_UNKNOWN_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Unmap a file mapped by vos_fileMap().
+ *  Not available for this target.
+ *
+ *  @param[in]      pMemoryArea        Pointer to mapped memory area
+ *  @param[in]      size               Size returned by vos_fileMap()
+ *  @retval         VOS_UNKNOWN_ERR    not supported
+ */
+EXT_DECL VOS_ERR_T vos_fileUnmap (
+    const UINT8 *pMemoryArea,
+    UINT32      size)
+{
+    (void)pMemoryArea;
+    (void)size;
+    return VOS_UNKNOWN_ERR;
+}
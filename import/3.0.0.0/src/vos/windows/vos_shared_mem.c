@@ -244,3 +244,149 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     }
     return retVal;
 }
+
+/**********************************************************************************************************************/
+/** Attach read-only to an existing shared memory area.
+*  The mapping is released with vos_fileUnmap() and stays valid even if the owner closes the area meanwhile.
+*
+*  @param[in]      pKey               Unique identifier (file name) used by the owner
+*  @param[out]     ppMemoryArea       Pointer to pointer to mapped memory area
+*  @param[out]     pSize              Pointer to size of the mapped area (rounded up to pages)
+*  @retval         VOS_NO_ERR         no error
+*  @retval         VOS_PARAM_ERR      parameter error
+*  @retval         VOS_IO_ERR         area does not exist (yet)
+*  @retval         VOS_MEM_ERR        mapping failed
+*/
+
+EXT_DECL VOS_ERR_T vos_sharedAttach (
+    const CHAR8 *pKey,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize)
+{
+    HANDLE                      hMap;
+    LPVOID                      pArea;
+    MEMORY_BASIC_INFORMATION    info;
+
+    if ((pKey == NULL) || (ppMemoryArea == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    hMap = OpenFileMappingA(FILE_MAP_READ, FALSE, pKey);
+    if (hMap == NULL)
+    {
+        return VOS_IO_ERR;
+    }
+
+    pArea = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+    (void) CloseHandle(hMap);               /* the view keeps its own reference to the mapping */
+    if ((pArea == NULL) || (VirtualQuery(pArea, &info, sizeof(info)) == 0))
+    {
+        vos_printLog(VOS_LOG_WARNING, "vos_sharedAttach() ERROR Could not map view of file (%d).\n",
+                     (int) GetLastError());
+        if (pArea != NULL)
+        {
+            (void) UnmapViewOfFile(pArea);
+        }
+        return VOS_MEM_ERR;
+    }
+
+    *ppMemoryArea   = (const UINT8 *) pArea;
+    *pSize          = (UINT32) info.RegionSize;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/*    Memory mapped files
+                                                                                                               */
+/**********************************************************************************************************************/
+
+/**********************************************************************************************************************/
+/** Map a file read-only into memory.
+*  The mapping stays valid until vos_fileUnmap() is called.
+*
+*  @param[in]      pFileName          Path of the file to map
+*  @param[out]     ppMemoryArea       Pointer to pointer to mapped memory area
+*  @param[out]     pSize              Pointer to size of the mapped file
+*  @retval         VOS_NO_ERR         no error
+*  @retval         VOS_PARAM_ERR      parameter error
+*  @retval         VOS_IO_ERR         file could not be opened, is empty or too big
+*  @retval         VOS_MEM_ERR        mapping failed
+*/
+
+EXT_DECL VOS_ERR_T vos_fileMap (
+    const CHAR8 *pFileName,
+    const UINT8 **ppMemoryArea,
+    UINT32      *pSize)
+{
+    HANDLE          hFile;
+    HANDLE          hMap;
+    LARGE_INTEGER   fileSize;
+    LPVOID          pArea;
+
+    if ((pFileName == NULL) || (ppMemoryArea == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    hFile = CreateFileA(pFileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return VOS_IO_ERR;
+    }
+    if ((GetFileSizeEx(hFile, &fileSize) == 0)
+        || (fileSize.QuadPart <= 0)
+        || (fileSize.QuadPart > 0xFFFFFFFF))
+    {
+        (void) CloseHandle(hFile);
+        return VOS_IO_ERR;
+    }
+
+    hMap = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    (void) CloseHandle(hFile);
+    if (hMap == NULL)
+    {
+        vos_printLog(VOS_LOG_WARNING, "vos_fileMap() ERROR Could not create file mapping object (%d).\n",
+                     (int) GetLastError());
+        return VOS_MEM_ERR;
+    }
+
+    pArea = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+    (void) CloseHandle(hMap);               /* the view keeps its own reference to the mapping */
+    if (pArea == NULL)
+    {
+        vos_printLog(VOS_LOG_WARNING, "vos_fileMap() ERROR Could not map view of file (%d).\n",
+                     (int) GetLastError());
+        return VOS_MEM_ERR;
+    }
+
+    *ppMemoryArea   = (const UINT8 *) pArea;
+    *pSize          = (UINT32) fileSize.QuadPart;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Unmap a file mapped by vos_fileMap().
+*
+*  @param[in]      pMemoryArea        Pointer to mapped memory area
+*  @param[in]      size               Size returned by vos_fileMap()
+*  @retval         VOS_NO_ERR         no error
+*  @retval         VOS_PARAM_ERR      parameter error
+*  @retval         VOS_MEM_ERR        unmapping failed
+*/
+
+EXT_DECL VOS_ERR_T vos_fileUnmap (
+    const UINT8 *pMemoryArea,
+    UINT32      size)
+{
+    if ((pMemoryArea == NULL) || (size == 0u))
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (UnmapViewOfFile(pMemoryArea) == 0)
+    {
+        return VOS_MEM_ERR;
+    }
+    return VOS_NO_ERR;
+}
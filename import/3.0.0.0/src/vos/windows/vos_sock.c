@@ -1487,6 +1487,107 @@ EXT_DECL VOS_ERR_T vos_sockReceiveUDP (
 
 }
 
+/**********************************************************************************************************************/
+/** Send UDP data at a given time.
+ *  Launch times are not supported on this platform, the packet is sent at once.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pBuffer         pointer to data to send
+ *  @param[in,out]  pSize           In: size of the data to send, Out: no of bytes sent
+ *  @param[in]      ipAddress       destination IP
+ *  @param[in]      port            destination port
+ *  @param[in]      pTxTime         launch time, ignored
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendUDPAt (
+    VOS_SOCK_T          sock,
+    const UINT8         *pBuffer,
+    UINT32              *pSize,
+    UINT32              ipAddress,
+    UINT16              port,
+    const VOS_TIMEVAL_T *pTxTime)
+{
+    (void) pTxTime;
+    return vos_sockSendUDP(sock, pBuffer, pSize, ipAddress, port);
+}
+
+/**********************************************************************************************************************/
+/** Receive UDP data with its receive time.
+ *  Kernel time stamps are not supported on this platform, the receive time is taken after reading the packet.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pBuffer         pointer to applications data buffer
+ *  @param[in,out]  pSize           pointer to the received data size
+ *  @param[out]     pSrcIPAddr      pointer to source IP
+ *  @param[out]     pSrcIPPort      pointer to source port
+ *  @param[out]     pDstIPAddr      pointer to dest IP
+ *  @param[out]     pSrcIFAddr      pointer to source network interface IP
+ *  @param[out]     pRxTime         pointer to receive time
+ *  @param[out]     pRxTimeSource   pointer to source of the receive time (VOS_TS_...), may be NULL
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be read
+ *  @retval         VOS_NODATA_ERR  no data
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveUDPTs (
+    VOS_SOCK_T      sock,
+    UINT8           *pBuffer,
+    UINT32          *pSize,
+    UINT32          *pSrcIPAddr,
+    UINT16          *pSrcIPPort,
+    UINT32          *pDstIPAddr,
+    UINT32          *pSrcIFAddr,
+    VOS_TIMEVAL_T   *pRxTime,
+    UINT8           *pRxTimeSource)
+{
+    VOS_ERR_T err;
+
+    if (pRxTime == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    err = vos_sockReceiveUDP(sock, pBuffer, pSize, pSrcIPAddr, pSrcIPPort, pDstIPAddr, pSrcIFAddr, FALSE);
+    vos_getTime(pRxTime);
+    if (pRxTimeSource != NULL)
+    {
+        *pRxTimeSource = VOS_TS_APPLICATION;
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Read one transmit time stamp of a socket.
+ *  Not supported on this platform.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pId             pointer to the number of the sent packet
+ *  @param[out]     pTxTime         pointer to transmit time
+ *  @param[out]     pTxTimeSource   pointer to source of the transmit time, may be NULL
+ *
+ *  @retval         VOS_UNKNOWN_ERR not supported on this platform
+ */
+
+EXT_DECL VOS_ERR_T vos_sockReceiveTxTime (
+    VOS_SOCK_T      sock,
+    UINT32          *pId,
+    VOS_TIMEVAL_T   *pTxTime,
+    UINT8           *pTxTimeSource)
+{
+    (void) sock;
+    (void) pId;
+    (void) pTxTime;
+    (void) pTxTimeSource;
+    return VOS_UNKNOWN_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Bind a socket to an address and port.
  *
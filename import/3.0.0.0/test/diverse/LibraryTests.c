@@ -337,6 +337,144 @@ int testInterfaces()
     return 0; /* all time tests succeeded */
 }
 
+static UINT32 cyclicCalls = 0u;
+
+/* Cyclic thread function: every fourth cycle runs for two and a half intervals */
+static void cyclicFunc (void *pArg)
+{
+    (void) pArg;
+    if ((++cyclicCalls % 4u) == 0u)
+    {
+        (void) vos_threadDelay(25000u);
+    }
+}
+
+int testCyclicThreadStats()
+{
+    VOS_THREAD_T        thread = NULL;
+    VOS_THREAD_T        self = NULL;
+    VOS_THREAD_STATS_T  stats;
+    UINT32              skipped;
+    UINT32              overruns;
+
+    if (vos_threadCreateSync(&thread, "cycTest", VOS_THREAD_POLICY_OTHER, 0, 10000u, NULL, 0u,
+                             cyclicFunc, NULL) != VOS_NO_ERR)
+    {
+        printf("Cyclic thread not created\n");
+        return 1;
+    }
+    (void) vos_threadDelay(400000u);
+    if (vos_threadGetStatistics(thread, &stats) == VOS_NOINIT_ERR)
+    {
+        printf("No cyclic thread statistics on this target\n");
+        (void) vos_threadTerminate(thread);
+        return 0;
+    }
+    printf("cyclic thread\tcycles %u overruns %u skipped %u exec avg/max %u/%u us latency max %u us drift %lld us\n",
+           stats.cycles, stats.overruns, stats.skipped, stats.execTimeAvg, stats.execTimeMax,
+           stats.wakeupLatencyMax, (long long) stats.drift);
+    if ((stats.interval != 10000u) || (stats.cycles == 0u) || (stats.overruns == 0u) ||
+        (stats.skipped < stats.overruns) || (stats.execTimeMax < 25000u))
+    {
+        (void) vos_threadTerminate(thread);
+        return 1;
+    }
+
+    /* Compressing: overrunning cycles are caught up, none skipped */
+    if (vos_threadSetCatchUp(thread, VOS_THREAD_CATCHUP_COMPRESS) != VOS_NO_ERR)
+    {
+        (void) vos_threadTerminate(thread);
+        return 1;
+    }
+    (void) vos_threadGetStatistics(thread, &stats);
+    skipped     = stats.skipped;
+    overruns    = stats.overruns;
+    (void) vos_threadDelay(400000u);
+    (void) vos_threadGetStatistics(thread, &stats);
+    (void) vos_threadTerminate(thread);
+    if ((stats.catchUp != VOS_THREAD_CATCHUP_COMPRESS) || (stats.overruns == overruns) || (stats.skipped != skipped))
+    {
+        return 1;
+    }
+
+    /* Only cyclic threads keep statistics */
+    (void) vos_threadSelf(&self);
+    if ((vos_threadGetStatistics(self, &stats) != VOS_NOINIT_ERR) ||
+        (vos_threadSetCatchUp(self, VOS_THREAD_CATCHUP_SKIP) != VOS_NOINIT_ERR))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/* Sends one message to the queue passed after 20ms */
+static void queueSender (void *pArg)
+{
+    (void) vos_threadDelay(20000u);
+    (void) vos_queueSend((VOS_QUEUE_T) pArg, (UINT8 *) 0x1234, 0x12u);
+}
+
+int testLockFreeQueues()
+{
+    const VOS_QUEUE_POLICY_T policies[2] = {VOS_QUEUE_POLICY_SPSC, VOS_QUEUE_POLICY_MPMC};
+    VOS_QUEUE_T     queue;
+    VOS_THREAD_T    thread;
+    UINT8           *pData;
+    UINT32          size;
+    UINT32          i, j;
+
+    for (i = 0u; i < 2u; i++)
+    {
+        /* 3 messages rounded up to 4 */
+        if (vos_queueCreate(policies[i], 3u, &queue) != VOS_NO_ERR)
+        {
+            printf("Lock-free queue not created\n");
+            return 1;
+        }
+        for (j = 1u; j <= 4u; j++)
+        {
+            if (vos_queueSend(queue, (UINT8 *) (size_t) j, j) != VOS_NO_ERR)
+            {
+                return 1;
+            }
+        }
+        if (vos_queueSend(queue, (UINT8 *) 5, 5u) != VOS_QUEUE_FULL_ERR)
+        {
+            return 1;
+        }
+        for (j = 1u; j <= 4u; j++)
+        {
+            if ((vos_queueReceive(queue, &pData, &size, 0u) != VOS_NO_ERR)
+                || (pData != (UINT8 *) (size_t) j) || (size != j))
+            {
+                return 1;
+            }
+        }
+        if ((vos_queueReceive(queue, &pData, &size, 0u) != VOS_QUEUE_ERR)
+            || (vos_queueReceive(queue, &pData, &size, 10000u) != VOS_QUEUE_ERR)
+            || (pData != NULL))
+        {
+            return 1;
+        }
+
+        /* Blocked receiver woken by the sender */
+        if (vos_threadCreate(&thread, "qSender", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, queueSender, queue) != VOS_NO_ERR)
+        {
+            return 1;
+        }
+        if ((vos_queueReceive(queue, &pData, &size, 1000000u) != VOS_NO_ERR) || (pData != (UINT8 *) 0x1234))
+        {
+            return 1;
+        }
+        (void) vos_threadDelay(1000u);
+        if (vos_queueDestroy(queue) != VOS_NO_ERR)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     /*    Init the library  */
@@ -385,6 +523,18 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if(testCyclicThreadStats())
+    {
+        printf("Cyclic thread statistics test failed\n");
+        return 1;
+    }
+
+    if(testLockFreeQueues())
+    {
+        printf("Lock-free queue test failed\n");
+        return 1;
+    }
+
     printf("All tests successfully finished.\n");
     return 0;
 }
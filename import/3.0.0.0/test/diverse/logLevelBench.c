@@ -0,0 +1,235 @@
+/**********************************************************************************************************************/
+/**
+ * @file            logLevelBench.c
+ *
+ * @brief           Benchmark of the log level filtering
+ *
+ * @details         Sends and receives PDs over the loopback interface and measures the time per packet, first with
+ *                  all log output enabled and discarded by the debug output function (as an application filtering
+ *                  by category does), then with the run time log level set to errors only.
+ *                  Each PD is sent a second time from a plain UDP socket, as a redundant path would deliver it. The
+ *                  duplicate is dropped by the sequence counter check, which logs it at debug and info level.
+ *                  Build the library with 'make LOG_MIN_LEVEL=1' to measure the compile time filtering.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "vos_sock.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "0.1"
+
+#define BENCH_COMID         1000u
+#define BENCH_DATA_SIZE     32u
+#define BENCH_TIMEOUT       1000000u
+#define BENCH_PACKETS       100000u
+#define BENCH_CHUNK         1000u
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT32   gLogCalls;
+
+/**********************************************************************************************************************/
+/** Debug output, discards everything but errors
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    gLogCalls++;
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Send and receive a number of PDs, each one twice
+ *
+ *  @param[in]      appHandle       session
+ *  @param[in]      pubHandle       publication to send
+ *  @param[in]      dupSock         socket sending the duplicates
+ *  @param[in]      packets         number of PDs
+ *
+ *  @retval         time per packet in ns, 0 on error
+ */
+static UINT32 benchRun (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    VOS_SOCK_T          dupSock,
+    UINT32              packets)
+{
+    UINT8           data[BENCH_DATA_SIZE];
+    VOS_TIMEVAL_T   start, end;
+    UINT32          i, copy, size;
+
+    memset(data, 0x55, sizeof(data));
+    vos_getTime(&start);
+    for (i = 0u; i < packets; i++)
+    {
+        memcpy(data, &i, sizeof(i));
+        size = pubHandle->grossSize;
+        if ((tlp_putImmediate(appHandle, pubHandle, data, sizeof(data), NULL) != TRDP_NO_ERR) ||
+            (vos_sockSendUDP(dupSock, (UINT8 *) pubHandle->pFrame, &size, pubHandle->addr.destIpAddr,
+                             TRDP_PD_UDP_PORT) != VOS_NO_ERR))
+        {
+            return 0u;
+        }
+        /* both copies are queued on loopback already: wait for the first, then only poll for the second */
+        for (copy = 0u; copy < 2u; copy++)
+        {
+            TRDP_FDS_T      rfds;
+            TRDP_SOCK_T     noDesc = 0;
+            INT32           rv;
+            TRDP_TIME_T     tv = {0, 100000};
+
+            FD_ZERO(&rfds);
+            (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+            tv.tv_sec   = 0;
+            tv.tv_usec  = (copy == 0u) ? 100000 : 0;
+            rv = vos_select(noDesc, &rfds, NULL, NULL, &tv);
+            (void) tlp_processReceive(appHandle, &rfds, &rv);
+        }
+    }
+    vos_getTime(&end);
+    vos_subTime(&end, &start);
+    return (UINT32) (((UINT64) end.tv_sec * 1000000000u + (UINT64) end.tv_usec * 1000u) / packets);
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PUB_T              pubHandle;
+    TRDP_SUB_T              subHandle;
+    VOS_SOCK_T              dupSock;
+    TRDP_PD_CONFIG_T        pdConfiguration = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE,
+                                               BENCH_TIMEOUT, TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_MEM_CONFIG_T       dynamicConfig = {NULL, 1000000u, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig = {"logLevelBench", "", "", 0u, 0u, TRDP_OPTION_NONE, 0u};
+    UINT32                  ownIP   = vos_dottedIP("127.0.0.1");
+    UINT32                  packets = BENCH_PACKETS;
+    const VOS_LOG_T         level[2] = {VOS_LOG_DBG, VOS_LOG_ERROR};
+    UINT64                  total[2]    = {0u, 0u};
+    UINT32                  logCalls[2] = {0u, 0u};
+    UINT32                  calls, ns, chunk, i;
+    int                     ch;
+
+    while ((ch = getopt(argc, argv, "o:n:h?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+               ownIP = vos_dottedIP(optarg);
+               break;
+           case 'n':
+               if ((sscanf(optarg, "%u", &packets) < 1) || (packets == 0u))
+               {
+                   printf("invalid number of packets\n");
+                   return 1;
+               }
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               printf("usage: %s [-o <own IP>] [-n <packets>]\n", argv[0]);
+               return 1;
+        }
+    }
+
+    if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+    if ((tlc_openSession(&appHandle, ownIP, 0u, NULL, &pdConfiguration, NULL, &processConfig) != TRDP_NO_ERR) ||
+        (tlp_subscribe(appHandle, &subHandle, NULL, NULL, 0u, BENCH_COMID, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_DEFAULT,
+                       BENCH_TIMEOUT, TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR) ||
+        (tlp_publish(appHandle, &pubHandle, NULL, NULL, 0u, BENCH_COMID, 0u, 0u, 0u, ownIP, 0u, 0u,
+                     TRDP_FLAGS_DEFAULT, NULL, BENCH_DATA_SIZE) != TRDP_NO_ERR) ||
+        (vos_sockOpenUDP(&dupSock, NULL) != VOS_NO_ERR))
+    {
+        printf("Session, subscription, publication or socket failed\n");
+        (void) tlc_terminate();
+        return 1;
+    }
+
+    printf("Compile time log level %d, %u packets\n", (int) VOS_LOG_MIN_LEVEL, packets);
+
+    if (benchRun(appHandle, pubHandle, dupSock, packets / 10u + 1u) == 0u)     /* warm up */
+    {
+        printf("Sending failed\n");
+        (void) vos_sockClose(dupSock);
+        (void) tlc_terminate();
+        return 1;
+    }
+
+    /* alternate the levels in short chunks, and which one runs first, so the noise of the loopback traffic hits
+       both alike */
+    for (chunk = 0u; chunk < (packets + BENCH_CHUNK - 1u) / BENCH_CHUNK; chunk++)
+    {
+        for (i = chunk % 2u; i < chunk % 2u + 2u; i++)
+        {
+            vos_setLogLevel(level[i % 2u]);
+            calls = gLogCalls;
+            ns    = benchRun(appHandle, pubHandle, dupSock, BENCH_CHUNK);
+            logCalls[i % 2u] += gLogCalls - calls;
+            total[i % 2u]    += (UINT64) ns * BENCH_CHUNK;
+        }
+    }
+    packets = chunk * BENCH_CHUNK;
+    printf("run time level DBG:   %6u ns/packet, %.1f log calls/packet\n", (UINT32) (total[0] / packets),
+           (double) logCalls[0] / packets);
+    printf("run time level ERROR: %6u ns/packet, %.1f log calls/packet\n", (UINT32) (total[1] / packets),
+           (double) logCalls[1] / packets);
+
+    vos_setLogLevel(VOS_LOG_DBG);
+    (void) vos_sockClose(dupSock);
+    (void) tlp_unpublish(appHandle, pubHandle);
+    (void) tlp_unsubscribe(appHandle, subHandle);
+    (void) tlc_closeSession(appHandle);
+    (void) tlc_terminate();
+    return 0;
+}
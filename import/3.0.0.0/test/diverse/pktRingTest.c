@@ -0,0 +1,529 @@
+/**********************************************************************************************************************/
+/**
+ * @file            pktRingTest.c
+ *
+ * @brief           Receive throughput of PD through the packet ring (TRDP_OPTION_PACKET_RING) and the UDP sockets
+ *
+ * @details         Sender (-t): publishes a number of telegrams with the given cycle time to a (multicast) address.
+ *                  Receiver (-r): subscribes to them for some seconds, reading from the UDP sockets or, with -p, from
+ *                  the packet ring, and prints the telegrams received and the CPU time per telegram.
+ *                  Check (-k): sends hand made frames from the peer interface of a veth pair to the own one and checks
+ *                  that the packet ring drops damaged ones (checksums, fragments).
+ *                  pktRingTest.sh runs all of them on veth pairs.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef PACKET_MMAP_SUPPORT
+#include <sys/socket.h>
+#include <net/if.h>              /* before vos_sock.h, sets VOS_MAX_IF_NAME_SIZE as in vos_sock.c */
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#endif
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "0.1"
+
+#define TEST_COMID          4000u
+#define TEST_DATA_SIZE      256u
+#define TEST_MAX_TELEGRAMS  1000u
+#define RESERVED_MEMORY     4000000u
+#define CHECK_FRAMES        7u
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT32 gReceived = 0u;
+
+/**********************************************************************************************************************/
+/** Debug output, errors only
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    if (category <= VOS_LOG_WARNING)
+    {
+        printf("%s %s:%u %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Count the received telegrams
+ */
+static void rxCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        gReceived++;
+    }
+}
+
+/**********************************************************************************************************************/
+/** CPU time (user and system) of the process in us
+ */
+static UINT64 cpuTime (void)
+{
+    struct rusage usage;
+
+    (void) getrusage(RUSAGE_SELF, &usage);
+    return (UINT64) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000u +
+           (UINT64) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+#ifdef PACKET_MMAP_SUPPORT
+/**********************************************************************************************************************/
+/** Internet checksum (RFC 1071), folded but not complemented
+ */
+static UINT32 checksum (
+    const UINT8 *pData,
+    UINT32      size,
+    UINT32      sum)
+{
+    UINT32 i;
+
+    for (i = 0u; i + 1u < size; i += 2u)
+    {
+        sum += ((UINT32) pData[i] << 8) | pData[i + 1u];
+    }
+    if (i < size)
+    {
+        sum += (UINT32) pData[i] << 8;
+    }
+    while (sum > 0xFFFFu)
+    {
+        sum = (sum & 0xFFFFu) + (sum >> 16);
+    }
+    return sum;
+}
+
+/**********************************************************************************************************************/
+/** Build an IPv4/UDP frame to the PD port
+ *
+ *  @retval         size of the frame
+ */
+static UINT32 buildFrame (
+    UINT8       *pFrame,
+    UINT32      srcIP,
+    UINT32      destIP,
+    const CHAR8 *pPayload,
+    UINT8       fragFlags,
+    BOOL8       udpChecksum)
+{
+    UINT32  size    = (UINT32) strlen(pPayload);
+    UINT32  udpSize = 8u + size;
+    UINT32  ipSize  = 20u + udpSize;
+    UINT32  sum;
+
+    memset(pFrame, 0, ipSize);
+    pFrame[0]   = 0x45u;
+    pFrame[2]   = (UINT8) (ipSize >> 8);
+    pFrame[3]   = (UINT8) ipSize;
+    pFrame[6]   = fragFlags;
+    pFrame[8]   = 64u;
+    pFrame[9]   = 17u;                          /* UDP */
+    for (sum = 0u; sum < 4u; sum++)
+    {
+        pFrame[12u + sum]   = (UINT8) (srcIP >> (24u - 8u * sum));
+        pFrame[16u + sum]   = (UINT8) (destIP >> (24u - 8u * sum));
+    }
+    pFrame[20]  = (UINT8) (TRDP_PD_UDP_PORT >> 8);
+    pFrame[21]  = (UINT8) TRDP_PD_UDP_PORT;
+    pFrame[22]  = (UINT8) (TRDP_PD_UDP_PORT >> 8);
+    pFrame[23]  = (UINT8) TRDP_PD_UDP_PORT;
+    pFrame[24]  = (UINT8) (udpSize >> 8);
+    pFrame[25]  = (UINT8) udpSize;
+    memcpy(pFrame + 28, pPayload, size);
+
+    sum         = 0xFFFFu - checksum(pFrame, 20u, 0u);
+    pFrame[10]  = (UINT8) (sum >> 8);
+    pFrame[11]  = (UINT8) sum;
+    if (udpChecksum == TRUE)
+    {
+        sum = 0xFFFFu - checksum(pFrame + 20, udpSize, checksum(pFrame + 12, 8u, 17u + udpSize));
+        sum = (sum == 0u) ? 0xFFFFu : sum;
+        pFrame[26]  = (UINT8) (sum >> 8);
+        pFrame[27]  = (UINT8) sum;
+    }
+    return ipSize;
+}
+
+/**********************************************************************************************************************/
+/** Send damaged and intact frames from the peer interface to the own one and read them from a packet ring.
+ *  Only the intact ones must come out of the ring.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int checkRing (
+    UINT32 ownIP,
+    UINT32 peerIP)
+{
+    static const CHAR8  *cFrames[CHECK_FRAMES] =
+    {
+        "intact", "corrupted payload", "no UDP checksum", "damaged IP header", "fragment", "padded", "end"
+    };
+    static const CHAR8  *cExpected[] = {"intact", "no UDP checksum", "padded", "end"};
+    VOS_IF_REC_T        ifRec[VOS_MAX_NUM_IF];
+    UINT32              ifCnt = VOS_MAX_NUM_IF;
+    VOS_PKT_RING_T      ring;
+    struct sockaddr_ll  addr;
+    UINT8               frame[256];
+    UINT8               buffer[256];
+    UINT32              size, srcIP, destIP, ifAddr;
+    UINT16              srcPort;
+    UINT8               tsSource;
+    VOS_TIMEVAL_T       rxTime;
+    TRDP_TIME_T         end, now;
+    UINT32              i;
+    UINT32              received    = 0u;
+    int                 sock;
+    int                 result      = 0;
+
+    memset(&addr, 0, sizeof(addr));
+    if (vos_getInterfaces(&ifCnt, ifRec) == VOS_NO_ERR)
+    {
+        for (i = 0u; i < ifCnt; i++)
+        {
+            if (ifRec[i].ipAddr == peerIP)
+            {
+                addr.sll_ifindex = (int) ifRec[i].ifIndex;
+            }
+        }
+    }
+    if (addr.sll_ifindex == 0)
+    {
+        printf("no interface with the peer address\n");
+        return 1;
+    }
+    addr.sll_family     = AF_PACKET;
+    addr.sll_protocol   = htons(ETH_P_IP);
+    addr.sll_halen      = ETH_ALEN;
+    memset(addr.sll_addr, 0xFF, ETH_ALEN);     /* broadcast */
+
+    sock = socket(AF_PACKET, SOCK_DGRAM, htons(ETH_P_IP));
+    if (sock == -1)
+    {
+        printf("packet socket not available\n");
+        return 1;
+    }
+    if (vos_pktRingCreate(ownIP, TRDP_PD_UDP_PORT, &ring) != VOS_NO_ERR)
+    {
+        printf("packet ring not available\n");
+        (void) close(sock);
+        return 1;
+    }
+
+    for (i = 0u; i < CHECK_FRAMES; i++)
+    {
+        size = buildFrame(frame, peerIP, ownIP, cFrames[i], (i == 4u) ? 0x20u : 0u,  /* more fragments */
+                          (i == 2u) ? FALSE : TRUE);
+        switch (i)
+        {
+           case 1u:
+               frame[30] ^= 0x01u;             /* after the checksum was computed */
+               break;
+           case 3u:
+               frame[8]--;                     /* TTL */
+               break;
+           case 5u:
+               memset(frame + size, 0xA5, 16u); /* link layer padding */
+               size += 16u;
+               break;
+           default:
+               break;
+        }
+        if (sendto(sock, frame, size, 0, (struct sockaddr *) &addr, sizeof(addr)) != (ssize_t) size)
+        {
+            printf("sending frame %u failed\n", i);
+            result = 1;
+        }
+    }
+
+    /*  The ring hands a block over when it is full or after its timeout  */
+    vos_getTime(&end);
+    end.tv_sec += 2;
+    do
+    {
+        size = sizeof(buffer) - 1u;
+        if (vos_pktRingReceiveUDP(ring, buffer, &size, &srcIP, &srcPort, &destIP, &ifAddr, &rxTime,
+                                  &tsSource) == VOS_NO_ERR)
+        {
+            buffer[size] = 0u;
+            if ((received >= sizeof(cExpected) / sizeof(cExpected[0])) ||
+                (strcmp((const char *) buffer, cExpected[received]) != 0))
+            {
+                printf("unexpected datagram '%s'\n", (const char *) buffer);
+                result = 1;
+            }
+            received++;
+        }
+        else
+        {
+            vos_threadDelay(10000u);
+        }
+        vos_getTime(&now);
+    }
+    while ((vos_cmpTime(&now, &end) < 0) &&
+           ((received == 0u) || (strcmp((const char *) buffer, "end") != 0)));
+
+    if (received != sizeof(cExpected) / sizeof(cExpected[0]))
+    {
+        printf("%u of %u intact datagrams received\n", received, (UINT32) (sizeof(cExpected) / sizeof(cExpected[0])));
+        result = 1;
+    }
+    printf("packet ring check: %s\n", (result == 0) ? "OK" : "FAILED");
+    vos_pktRingDestroy(ring);
+    (void) close(sock);
+    return result;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PUB_T              pubHandle;
+    TRDP_SUB_T              subHandle;
+    TRDP_PD_CONFIG_T        pdConfiguration = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 1000000u,
+                                               TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, RESERVED_MEMORY, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"pktRingTest", "", "", 0, 0, TRDP_OPTION_NONE, 0u};
+    UINT8                   data[TEST_DATA_SIZE];
+    TRDP_TIME_T             end, now;
+    unsigned int            ip[4];
+    UINT32                  ownIP       = 0u;
+    UINT32                  destIP      = 0u;
+    UINT32                  telegrams   = 500u;
+    UINT32                  cycle       = 10000u;   /* us, at least TRDP_TIMER_GRANULARITY */
+    UINT32                  seconds     = 5u;
+    UINT32                  packets     = 0u;
+    UINT32                  drops       = 0u;
+    UINT32                  i;
+    UINT64                  cpu;
+    BOOL8                   receiver    = FALSE;
+    BOOL8                   packetRing  = FALSE;
+    BOOL8                   check       = FALSE;
+    TRDP_ERR_T              err         = TRDP_NO_ERR;
+    int                     ch;
+
+    while ((ch = getopt(argc, argv, "o:t:r:k:n:c:s:ph?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+           case 't':
+           case 'r':
+           case 'k':
+               if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+               {
+                   printf("invalid IP address\n");
+                   return 1;
+               }
+               if (ch == 'o')
+               {
+                   ownIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               }
+               else
+               {
+                   destIP   = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+                   receiver = (ch == 'r') ? TRUE : FALSE;
+                   check    = (ch == 'k') ? TRUE : FALSE;
+               }
+               break;
+           case 'n':
+               if ((sscanf(optarg, "%u", &telegrams) < 1) || (telegrams == 0u) || (telegrams > TEST_MAX_TELEGRAMS))
+               {
+                   printf("invalid number of telegrams\n");
+                   return 1;
+               }
+               break;
+           case 'c':
+               if ((sscanf(optarg, "%u", &cycle) < 1) || (cycle == 0u))
+               {
+                   printf("invalid cycle time\n");
+                   return 1;
+               }
+               break;
+           case 's':
+               if ((sscanf(optarg, "%u", &seconds) < 1) || (seconds == 0u))
+               {
+                   printf("invalid run time\n");
+                   return 1;
+               }
+               break;
+           case 'p':
+               packetRing = TRUE;
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               printf("usage: %s -r <dest IP> [-o <own IP>] [-n <telegrams>] [-s <seconds>] [-p]\n"
+                      "       %s -t <dest IP> [-o <own IP>] [-n <telegrams>] [-c <cycle us>] [-s <seconds>]\n"
+                      "       %s -k <peer IP> -o <own IP>\n"
+                      "-r receive the telegrams sent to <dest IP> (multicast group or own IP)\n"
+                      "-t send the telegrams to <dest IP>\n"
+                      "-p receive through the packet ring (TRDP_OPTION_PACKET_RING)\n"
+                      "-k check that the packet ring drops damaged frames sent from <peer IP> (same host)\n",
+                      argv[0], argv[0], argv[0]);
+               return 1;
+        }
+    }
+    if (destIP == 0u)
+    {
+        printf("either -r <dest IP>, -t <dest IP> or -k <peer IP> needed\n");
+        return 1;
+    }
+    if (check == TRUE)
+    {
+#ifdef PACKET_MMAP_SUPPORT
+        if (ownIP == 0u)
+        {
+            printf("-o <own IP> needed\n");
+            return 1;
+        }
+        if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+        {
+            printf("Initialization error\n");
+            return 1;
+        }
+        ch = checkRing(ownIP, destIP);
+        (void) tlc_terminate();
+        return ch;
+#else
+        printf("packet ring needs PACKET_MMAP_SUPPORT\n");
+        return 1;
+#endif
+    }
+
+    /*  Non-blocking sockets: the receiver reads each socket until it is empty   */
+    processConfig.options |= (packetRing == TRUE) ? TRDP_OPTION_PACKET_RING : TRDP_OPTION_NONE;
+    if ((tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, ownIP, 0u, NULL, &pdConfiguration, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+    vos_setLogLevel(VOS_LOG_WARNING);
+    if ((packetRing == TRUE) && !(appHandle->option & TRDP_OPTION_PACKET_RING))
+    {
+        printf("packet ring not available\n");
+        (void) tlc_terminate();
+        return 1;
+    }
+
+    memset(data, 0, sizeof(data));
+    for (i = 0u; (i < telegrams) && (err == TRDP_NO_ERR); i++)
+    {
+        if (receiver == TRUE)
+        {
+            err = tlp_subscribe(appHandle, &subHandle, NULL, rxCallback, 0u, TEST_COMID + i, 0u, 0u,
+                                VOS_INADDR_ANY, VOS_INADDR_ANY, destIP, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                                1000000u, TRDP_TO_SET_TO_ZERO);
+        }
+        else
+        {
+            err = tlp_publish(appHandle, &pubHandle, NULL, NULL, 0u, TEST_COMID + i, 0u, 0u, 0u, destIP, cycle, 0u,
+                              TRDP_FLAGS_NONE, data, TEST_DATA_SIZE);
+        }
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        printf("publish / subscribe error %d\n", err);
+        (void) tlc_terminate();
+        return 1;
+    }
+
+    cpu = cpuTime();
+    vos_getTime(&end);
+    end.tv_sec += (INT32) seconds;
+    do
+    {
+        VOS_FDS_T       rfds;
+        TRDP_SOCK_T     noDesc;
+        VOS_TIMEVAL_T   tv;
+        VOS_TIMEVAL_T   maxTv = {0, 100000};
+        INT32           rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, (TRDP_TIME_T *) &tv, (TRDP_FDS_T *) &rfds, &noDesc);
+        if (vos_cmpTime((TRDP_TIME_T *) &tv, (TRDP_TIME_T *) &maxTv) > 0)
+        {
+            tv = maxTv;
+        }
+        rv = vos_select((int)noDesc, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(appHandle, (TRDP_FDS_T *) &rfds, &rv);
+        vos_getTime(&now);
+    }
+    while (vos_cmpTime(&now, &end) < 0);
+    cpu = cpuTime() - cpu;
+
+    if (receiver == TRUE)
+    {
+#ifdef PACKET_MMAP_SUPPORT
+        if (appHandle->pktRing != NULL)
+        {
+            vos_pktRingGetStatistics(appHandle->pktRing, &packets, &drops);
+        }
+#endif
+        if (gReceived == 0u)
+        {
+            printf("no telegrams received\n");
+            (void) tlc_terminate();
+            return 1;
+        }
+        printf("%-12s %8u telegrams in %u s (%u/s), %.2f cpu us per telegram, ring: %u packets, %u drops\n",
+               (packetRing == TRUE) ? "packet ring:" : "sockets:", gReceived, seconds, gReceived / seconds,
+               (double) cpu / gReceived, packets, drops);
+    }
+    (void) tlc_terminate();
+    return 0;
+}
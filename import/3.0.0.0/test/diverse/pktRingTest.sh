@@ -0,0 +1,52 @@
+#!/bin/sh
+#
+# Receive throughput of multicast PD through the UDP sockets and through the packet ring (TRDP_OPTION_PACKET_RING),
+# measured on a veth pair. The sender runs in network namespace pktA, the receiver in pktB. Then checks that damaged
+# frames are dropped by the ring (pktRingTest -k). Needs root and a build with PACKET_MMAP_SUPPORT = 1.
+#
+# usage: pktRingTest.sh [pktRingTest binary] [telegrams] [cycle us] [seconds]
+#
+
+BIN=${1:-bld/output/linux-rel/pktRingTest}
+TELEGRAMS=${2:-500}
+CYCLE=${3:-10000}
+RUNTIME=${4:-5}
+GROUP=239.199.0.1
+
+cleanup()
+{
+    kill $TX 2>/dev/null
+    ip netns del pktA 2>/dev/null
+    ip netns del pktB 2>/dev/null
+    ip netns del pktC 2>/dev/null
+}
+
+cleanup
+trap cleanup EXIT
+ip netns add pktA || exit 1
+ip netns add pktB || exit 1
+ip link add pktA0 netns pktA type veth peer name pktB0 netns pktB || exit 1
+ip -n pktA addr add 10.199.1.1/24 dev pktA0
+ip -n pktB addr add 10.199.1.2/24 dev pktB0
+ip -n pktA link set pktA0 up
+ip -n pktB link set pktB0 up
+ip -n pktA link set lo up
+ip -n pktB link set lo up
+
+echo "$TELEGRAMS telegrams every $CYCLE us to $GROUP"
+ip netns exec pktA "$BIN" -o 10.199.1.1 -t $GROUP -n "$TELEGRAMS" -c "$CYCLE" -s $((2 * RUNTIME + 10)) &
+TX=$!
+sleep 1
+
+for MODE in "" "-p"; do
+    ip netns exec pktB "$BIN" -o 10.199.1.2 -r $GROUP -n "$TELEGRAMS" -s "$RUNTIME" $MODE
+done
+
+# Damaged frames (checksums, fragments) must not come out of the packet ring: both ends of a veth pair in pktC
+ip netns add pktC || exit 1
+ip link add pktC0 netns pktC type veth peer name pktC1 netns pktC || exit 1
+ip -n pktC addr add 10.199.2.1/24 dev pktC0
+ip -n pktC addr add 10.199.2.2/24 dev pktC1
+ip -n pktC link set pktC0 up
+ip -n pktC link set pktC1 up
+ip netns exec pktC "$BIN" -k 10.199.2.1 -o 10.199.2.2
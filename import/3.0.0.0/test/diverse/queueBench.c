@@ -0,0 +1,257 @@
+/**********************************************************************************************************************/
+/**
+ * @file            queueBench.c
+ *
+ * @brief           Contention benchmark of the VOS message queues
+ *
+ * @details         1, 2, 4 and 8 producer threads send messages to one consumer (the main thread) through a mutex
+ *                  queue (VOS_QUEUE_POLICY_FIFO) and a lock-free queue (VOS_QUEUE_POLICY_MPMC, with one producer also
+ *                  VOS_QUEUE_POLICY_SPSC). A producer finding the queue full yields and retries, the consumer blocks
+ *                  while the queue is empty. Prints the time per message.
+ *                  Run it pinned to two cores (taskset -c 0,1) to see the cache line traffic between the producers
+ *                  and the consumer; on a single CPU the threads only take turns.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include "trdp_if_light.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "0.1"
+
+#define BENCH_MESSAGES      1000000u
+#define BENCH_QUEUE_SIZE    256u
+#define BENCH_MAX_PRODUCERS 8u
+#define BENCH_TIMEOUT_US    1000000u
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+typedef struct
+{
+    VOS_QUEUE_T queue;
+    UINT32      first;              /* first message number */
+    UINT32      count;              /* messages to send */
+    UINT32      full;               /* sends finding the queue full */
+} PRODUCER_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static PRODUCER_T gProducer[BENCH_MAX_PRODUCERS];
+static BOOL8      gQuiet = FALSE;      /* the mutex queue logs every send finding it full */
+
+/**********************************************************************************************************************/
+/** Debug output, errors only, none while benchmarking
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    if ((category == VOS_LOG_ERROR) && (gQuiet == FALSE))
+    {
+        printf("%s %s:%u %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Producer thread: send its messages, the message number is passed as data pointer
+ */
+static void producer (
+    void *pArg)
+{
+    PRODUCER_T  *pProducer = (PRODUCER_T *) pArg;
+    UINT32      i;
+
+    for (i = 0u; i < pProducer->count; i++)
+    {
+        while (vos_queueSend(pProducer->queue, (UINT8 *) (size_t) (pProducer->first + i + 1u), 1u)
+               == VOS_QUEUE_FULL_ERR)
+        {
+            pProducer->full++;
+            (void) sched_yield();
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Pass a number of messages from a number of producers to the calling thread
+ *
+ *  @param[in]      policy          queue policy
+ *  @param[in]      producers       number of producer threads
+ *  @param[in]      messages        number of messages
+ *  @param[out]     pFull           sends finding the queue full
+ *
+ *  @retval         time per message in ns, 0 on error
+ */
+static UINT32 benchRun (
+    VOS_QUEUE_POLICY_T  policy,
+    UINT32              producers,
+    UINT32              messages,
+    UINT32              *pFull)
+{
+    VOS_THREAD_T    thread[BENCH_MAX_PRODUCERS];
+    VOS_QUEUE_T     queue;
+    VOS_TIMEVAL_T   start, end;
+    UINT8           *pData;
+    UINT32          size;
+    UINT64          sum     = 0u;
+    UINT32          i;
+    UINT32          count   = messages / producers;
+
+    if (vos_queueCreate(policy, BENCH_QUEUE_SIZE, &queue) != VOS_NO_ERR)
+    {
+        printf("queue not created\n");
+        return 0u;
+    }
+
+    gQuiet = TRUE;
+    vos_getTime(&start);
+    for (i = 0u; i < producers; i++)
+    {
+        gProducer[i].queue  = queue;
+        gProducer[i].first  = i * count;
+        gProducer[i].count  = count;
+        gProducer[i].full   = 0u;
+        if (vos_threadCreate(&thread[i], "producer", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u,
+                             producer, &gProducer[i]) != VOS_NO_ERR)
+        {
+            printf("producer not created\n");
+            return 0u;
+        }
+    }
+    for (i = 0u; i < count * producers; i++)
+    {
+        if (vos_queueReceive(queue, &pData, &size, BENCH_TIMEOUT_US) != VOS_NO_ERR)
+        {
+            printf("message %u lost\n", i);
+            return 0u;
+        }
+        sum += (size_t) pData;
+    }
+    vos_getTime(&end);
+    gQuiet = FALSE;
+
+    (void) vos_threadDelay(10000u);         /* producers have returned */
+    (void) vos_queueDestroy(queue);
+
+    /* Every message received once: sum of 1 .. count * producers */
+    if (sum != (UINT64) count * producers * (count * producers + 1u) / 2u)
+    {
+        printf("messages corrupted\n");
+        return 0u;
+    }
+    *pFull = 0u;
+    for (i = 0u; i < producers; i++)
+    {
+        *pFull += gProducer[i].full;
+    }
+    vos_subTime(&end, &start);
+    return (UINT32) (((UINT64) end.tv_sec * 1000000000u + (UINT64) end.tv_usec * 1000u) / (count * producers));
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_MEM_CONFIG_T           dynamicConfig   = {NULL, 1000000u, {0}};
+    const UINT32                producers[4]    = {1u, 2u, 4u, BENCH_MAX_PRODUCERS};
+    const VOS_QUEUE_POLICY_T    policies[3]     = {VOS_QUEUE_POLICY_FIFO, VOS_QUEUE_POLICY_MPMC, VOS_QUEUE_POLICY_SPSC};
+    UINT32                      messages        = BENCH_MESSAGES;
+    UINT32                      ns[3], full[3];
+    UINT32                      i, j;
+    int                         ch;
+
+    while ((ch = getopt(argc, argv, "n:h?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'n':
+               if ((sscanf(optarg, "%u", &messages) < 1) || (messages < BENCH_MAX_PRODUCERS))
+               {
+                   printf("invalid number of messages\n");
+                   return 1;
+               }
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               printf("usage: %s [-n <messages>]\n", argv[0]);
+               return 1;
+        }
+    }
+
+    if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+    vos_setLogLevel(VOS_LOG_ERROR);
+
+    printf("%u messages, queue of %u\n", messages, BENCH_QUEUE_SIZE);
+    printf("producers   mutex ns/msg (full)   mpmc ns/msg (full)   spsc ns/msg (full)\n");
+    for (i = 0u; i < 4u; i++)
+    {
+        for (j = 0u; j < 3u; j++)
+        {
+            ns[j]   = 0u;
+            full[j] = 0u;
+            if ((j == 2u) && (producers[i] != 1u))
+            {
+                continue;               /* single producer only */
+            }
+            ns[j] = benchRun(policies[j], producers[i], messages, &full[j]);
+            if (ns[j] == 0u)
+            {
+                (void) tlc_terminate();
+                return 1;
+            }
+        }
+        printf("%9u   %8u (%8u)   %7u (%8u)", producers[i], ns[0], full[0], ns[1], full[1]);
+        if (producers[i] == 1u)
+        {
+            printf("   %7u (%8u)", ns[2], full[2]);
+        }
+        printf("\n");
+    }
+
+    (void) tlc_terminate();
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**********************************************************************************************************************/
+/**
+ * @file            ringBench.c
+ *
+ * @brief           Benchmark of the completion based work loop tlc_processRing() against tlc_process()
+ *
+ * @details         One session publishes a number of telegrams to its own address and subscribes to them. The loop
+ *                  runs for some seconds with tlc_getInterval(), vos_select() and tlc_process(), then with
+ *                  tlc_processRing(). Prints the telegrams sent and received, the loop passes, the CPU time per
+ *                  telegram and the system calls per telegram (select path: at least one select, send and receive
+ *                  per pass and telegram, ring path: io_uring_enter() calls).
+ *                  Only with IO_URING_SUPPORT the ring path is measured.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "0.1"
+
+#define BENCH_COMID         3000u
+#define BENCH_DATA_SIZE     256u
+#define BENCH_MAX_TELEGRAMS 1000u
+#define RESERVED_MEMORY     4000000u
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT32 gReceived = 0u;
+
+/**********************************************************************************************************************/
+/** Debug output, errors only
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Count the received telegrams
+ */
+static void rxCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        gReceived++;
+    }
+}
+
+/**********************************************************************************************************************/
+/** CPU time (user and system) of the process in us
+ */
+static UINT64 cpuTime (void)
+{
+    struct rusage usage;
+
+    (void) getrusage(RUSAGE_SELF, &usage);
+    return (UINT64) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000u +
+           (UINT64) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/**********************************************************************************************************************/
+/** Run one work loop for some seconds and print its figures
+ *
+ *  @param[in]      appHandle       session
+ *  @param[in]      ring            TRUE: tlc_processRing(), FALSE: tlc_process()
+ *  @param[in]      seconds         run time
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int benchRun (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               ring,
+    UINT32              seconds)
+{
+    TRDP_STATISTICS_T   stats;
+    TRDP_TIME_T         end, now;
+    TRDP_TIME_T         maxWait = {0, 100000};
+    UINT32              sent, received;
+    UINT32              loops   = 0u;
+    UINT32              enters  = 0u;
+    UINT32              errors  = 0u;
+    UINT64              cpu;
+    TRDP_ERR_T          err;
+
+    (void) tlc_getStatistics(appHandle, &stats);
+    sent        = stats.pd.numSend;
+    received    = gReceived;
+    cpu         = cpuTime();
+
+    vos_getTime(&end);
+    end.tv_sec += (INT32) seconds;
+    do
+    {
+        if (ring == TRUE)
+        {
+#ifdef IO_URING_SUPPORT
+            err = tlc_processRing(appHandle, &maxWait);
+            if (err == TRDP_INIT_ERR)
+            {
+                printf("io_uring not available\n");
+                return 1;
+            }
+#else
+            err = TRDP_NOINIT_ERR;
+#endif
+        }
+        else
+        {
+            VOS_FDS_T       rfds;
+            TRDP_SOCK_T     noDesc;
+            VOS_TIMEVAL_T   tv;
+            INT32           rv;
+
+            FD_ZERO(&rfds);
+            (void) tlc_getInterval(appHandle, (TRDP_TIME_T *) &tv, (TRDP_FDS_T *) &rfds, &noDesc);
+            if (vos_cmpTime((TRDP_TIME_T *) &tv, &maxWait) > 0)
+            {
+                tv = *(VOS_TIMEVAL_T *) &maxWait;
+            }
+            rv  = vos_select((int)noDesc, &rfds, NULL, NULL, &tv);
+            err = tlc_process(appHandle, (TRDP_FDS_T *) &rfds, &rv);
+        }
+        errors += (err != TRDP_NO_ERR) ? 1u : 0u;
+        loops++;
+        vos_getTime(&now);
+    }
+    while (vos_cmpTime(&now, &end) < 0);
+
+    cpu = cpuTime() - cpu;
+    (void) tlc_getStatistics(appHandle, &stats);
+    sent        = stats.pd.numSend - sent;
+    received    = gReceived - received;
+#ifdef IO_URING_SUPPORT
+    if (ring == TRUE)
+    {
+        vos_ringGetStatistics(appHandle->ring, &enters, &errors);
+    }
+#endif
+    if (received == 0u)
+    {
+        printf("no telegrams received\n");
+        return 1;
+    }
+
+    printf("%-7s %8u %8u %8u %10u %12.2f %10.2f %6u\n",
+           (ring == TRUE) ? "ring" : "select", sent, received, loops, (unsigned int) cpu,
+           (double) cpu / (sent + received),
+           (ring == TRUE) ? (double) enters / (sent + received) : (double) (loops + sent + received) / (sent + received),
+           errors);
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PUB_T              pubHandle;
+    TRDP_SUB_T              subHandle;
+    TRDP_PD_CONFIG_T        pdConfiguration = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 1000000u,
+                                               TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, RESERVED_MEMORY, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"ringBench", "", "", 0, 0, TRDP_OPTION_BLOCK, 0u};
+    UINT8                   data[BENCH_DATA_SIZE];
+    unsigned int            ip[4];
+    UINT32                  ownIP       = 0u;
+    UINT32                  telegrams   = 100u;
+    UINT32                  cycle       = 10000u;   /* us, at least TRDP_TIMER_GRANULARITY */
+    UINT32                  seconds     = 5u;
+    UINT32                  i;
+    int                     rv;
+    int                     ch;
+
+    while ((ch = getopt(argc, argv, "o:n:c:s:h?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+               if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+               {
+                   printf("invalid IP address\n");
+                   return 1;
+               }
+               ownIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               break;
+           case 'n':
+               if ((sscanf(optarg, "%u", &telegrams) < 1) || (telegrams == 0u) || (telegrams > BENCH_MAX_TELEGRAMS))
+               {
+                   printf("invalid number of telegrams\n");
+                   return 1;
+               }
+               break;
+           case 'c':
+               if ((sscanf(optarg, "%u", &cycle) < 1) || (cycle == 0u))
+               {
+                   printf("invalid cycle time\n");
+                   return 1;
+               }
+               break;
+           case 's':
+               if ((sscanf(optarg, "%u", &seconds) < 1) || (seconds == 0u))
+               {
+                   printf("invalid run time\n");
+                   return 1;
+               }
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               printf("usage: %s -o <own IP> [-n <telegrams>] [-c <cycle us>] [-s <seconds per run>]\n", argv[0]);
+               return 1;
+        }
+    }
+    if (ownIP == 0u)
+    {
+        printf("-o <own IP> needed, the telegrams are sent to it\n");
+        return 1;
+    }
+
+    if ((tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, ownIP, 0u, NULL, &pdConfiguration, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+    vos_setLogLevel(VOS_LOG_ERROR);
+
+    memset(data, 0, sizeof(data));
+    for (i = 0u; i < telegrams; i++)
+    {
+        if ((tlp_publish(appHandle, &pubHandle, NULL, NULL, 0u, BENCH_COMID + i, 0u, 0u, 0u, ownIP, cycle, 0u,
+                         TRDP_FLAGS_NONE, data, BENCH_DATA_SIZE) != TRDP_NO_ERR) ||
+            (tlp_subscribe(appHandle, &subHandle, NULL, rxCallback, 0u, BENCH_COMID + i, 0u, 0u,
+                           VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                           1000000u, TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR))
+        {
+            printf("publish / subscribe error\n");
+            (void) tlc_terminate();
+            return 1;
+        }
+    }
+
+    printf("%u telegrams of %u bytes every %u us, %u s per run\n", telegrams, BENCH_DATA_SIZE, cycle, seconds);
+    printf("loop        sent  received  passes  cpu us  cpu us/tlg  syscalls/tlg errors\n");
+    rv = benchRun(appHandle, FALSE, seconds);
+#ifdef IO_URING_SUPPORT
+    if (rv == 0)
+    {
+        rv = benchRun(appHandle, TRUE, seconds);
+    }
+#else
+    printf("ring    built without IO_URING_SUPPORT\n");
+#endif
+
+    (void) tlc_terminate();
+    return rv;
+}
@@ -0,0 +1,244 @@
+/**********************************************************************************************************************/
+/**
+ * @file            seqCntBench.c
+ *
+ * @brief           Benchmark of the duplicate check of received PDs
+ *
+ * @details         Calls trdp_checkSequenceCounter() for a wildcard subscription receiving from 1, 16 and 256 senders
+ *                  (round robin, every packet new) and compares the time per packet with a linear search of the
+ *                  senders, as done before the sequence counters were hashed.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "trdp_utils.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "0.1"
+
+#define BENCH_PACKETS       1000000u
+#define BENCH_ROUNDS        5u
+#define BENCH_MAX_SENDERS   256u
+#define BENCH_TIMEOUT_US    1000000u
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+/** Linear list of senders, the former implementation */
+static TRDP_SEQ_CNT_ENTRY_T gLinear[BENCH_MAX_SENDERS];
+static UINT32               gLinearCnt;
+
+/**********************************************************************************************************************/
+/** Debug output, errors only
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Duplicate check by linear search
+ *
+ *  @retval         0 - no duplicate, 1 - duplicate
+ */
+static int linearCheck (
+    UINT32          sequenceCounter,
+    TRDP_IP_ADDR_T  srcIP,
+    TRDP_MSG_T      msgType)
+{
+    UINT32 i;
+
+    for (i = 0u; i < gLinearCnt; i++)
+    {
+        if ((gLinear[i].srcIpAddr == srcIP) && (gLinear[i].msgType == msgType))
+        {
+            if ((gLinear[i].lastSeqCnt == 0u) || (sequenceCounter > gLinear[i].lastSeqCnt))
+            {
+                gLinear[i].lastSeqCnt = sequenceCounter;
+                return 0;
+            }
+            return 1;
+        }
+    }
+    gLinear[gLinearCnt].lastSeqCnt  = sequenceCounter;
+    gLinear[gLinearCnt].srcIpAddr   = srcIP;
+    gLinear[gLinearCnt].msgType     = msgType;
+    gLinearCnt++;
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Check a number of packets from a number of senders
+ *
+ *  @param[in]      pElement        subscription, NULL for the linear search
+ *  @param[in]      senders         number of senders
+ *  @param[in]      packets         number of packets
+ *
+ *  @retval         time per packet in ns, 0 on error
+ */
+static UINT32 benchRun (
+    PD_ELE_T    *pElement,
+    UINT32      senders,
+    UINT32      packets)
+{
+    VOS_TIMEVAL_T   start, end;
+    UINT32          i;
+    int             dup = 0;
+
+    if (pElement != NULL)
+    {
+        if (pElement->pSeqCntList != NULL)
+        {
+            vos_memFree(pElement->pSeqCntList);
+            pElement->pSeqCntList = NULL;
+        }
+    }
+    else
+    {
+        memset(gLinear, 0, sizeof(gLinear));
+        gLinearCnt = 0u;
+    }
+
+    vos_getTime(&start);
+    for (i = 0u; i < packets; i++)
+    {
+        /* scattered addresses of one subnet, sequence counter i / senders + 1 */
+        TRDP_IP_ADDR_T srcIP = 0x0A000000u | ((i % senders) * 2654435761u >> 8);
+
+        if (pElement != NULL)
+        {
+            dup |= trdp_checkSequenceCounter(pElement, i / senders + 1u, srcIP, TRDP_MSG_PD, &start);
+        }
+        else
+        {
+            dup |= linearCheck(i / senders + 1u, srcIP, TRDP_MSG_PD);
+        }
+    }
+    vos_getTime(&end);
+    if (dup != 0)
+    {
+        printf("unexpected duplicate or memory error\n");
+        return 0u;
+    }
+    vos_subTime(&end, &start);
+    return (UINT32) (((UINT64) end.tv_sec * 1000000000u + (UINT64) end.tv_usec * 1000u) / packets);
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_MEM_CONFIG_T   dynamicConfig   = {NULL, 1000000u, {0}};
+    const UINT32        senders[3]      = {1u, 16u, BENCH_MAX_SENDERS};
+    PD_ELE_T            element;
+    UINT32              packets = BENCH_PACKETS;
+    UINT32              best[2];
+    UINT32              ns, round, i, j;
+    int                 ch;
+
+    while ((ch = getopt(argc, argv, "n:h?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'n':
+               if ((sscanf(optarg, "%u", &packets) < 1) || (packets < BENCH_MAX_SENDERS))
+               {
+                   printf("invalid number of packets\n");
+                   return 1;
+               }
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               printf("usage: %s [-n <packets>]\n", argv[0]);
+               return 1;
+        }
+    }
+
+    if (tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+    vos_setLogLevel(VOS_LOG_ERROR);
+
+    memset(&element, 0, sizeof(element));
+    element.addr.comId          = 1000u;
+    element.interval.tv_sec     = BENCH_TIMEOUT_US / 1000000u;
+    element.interval.tv_usec    = BENCH_TIMEOUT_US % 1000000u;
+
+    printf("%u packets, best of %u rounds\n", packets, BENCH_ROUNDS);
+    printf("senders   hashed ns/packet   linear ns/packet\n");
+    for (i = 0u; i < 3u; i++)
+    {
+        for (round = 0u; round < BENCH_ROUNDS; round++)
+        {
+            for (j = 0u; j < 2u; j++)
+            {
+                ns = benchRun((j == 0u) ? &element : NULL, senders[i], packets);
+                if (ns == 0u)
+                {
+                    (void) tlc_terminate();
+                    return 1;
+                }
+                if ((round == 0u) || (ns < best[j]))
+                {
+                    best[j] = ns;
+                }
+            }
+        }
+        printf("%7u   %16u   %16u\n", senders[i], best[0], best[1]);
+    }
+
+    if (element.pSeqCntList != NULL)
+    {
+        vos_memFree(element.pSeqCntList);
+    }
+    (void) tlc_terminate();
+    return 0;
+}
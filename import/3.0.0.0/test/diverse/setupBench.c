@@ -0,0 +1,244 @@
+/**********************************************************************************************************************/
+/**
+ * @file            setupBench.c
+ *
+ * @brief           Set-up time of a session with many telegrams
+ *
+ * @details         Publishes and subscribes a number of telegrams (multicast, spread over a number of groups), then
+ *                  unsubscribes and unpublishes them. Prints the time of each phase and per telegram.
+ *                  With -b, publishes and subscribes with tlp_publishBulk / tlp_subscribeBulk.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "trdp_if_light.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "0.1"
+
+#define BENCH_COMID         10000u
+#define BENCH_DATA_SIZE     32u
+#define BENCH_MAX_TELEGRAMS 20000u
+#define BENCH_MC_BASE       0xEFC80000u     /* 239.200.0.0 */
+#define RESERVED_MEMORY     64000000u
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static TRDP_PUB_T gPub[BENCH_MAX_TELEGRAMS];
+static TRDP_SUB_T gSub[BENCH_MAX_TELEGRAMS];
+static TRDP_PUB_DEF_T gPubDef[BENCH_MAX_TELEGRAMS];
+static TRDP_SUB_DEF_T gSubDef[BENCH_MAX_TELEGRAMS];
+
+/**********************************************************************************************************************/
+/** Debug output, errors only
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Print the time since start and per telegram, restart the time
+ */
+static void printPhase (
+    const CHAR8 *pPhase,
+    UINT32      telegrams,
+    TRDP_TIME_T *pStart)
+{
+    TRDP_TIME_T now;
+    UINT64      us;
+
+    vos_getTime(&now);
+    vos_subTime(&now, pStart);
+    us = (UINT64) now.tv_sec * 1000000u + (UINT64) now.tv_usec;
+    printf("%-12s %10.1f ms %10.2f us/telegram\n", pPhase, (double) us / 1000.0, (double) us / telegrams);
+    vos_getTime(pStart);
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PD_CONFIG_T        pdConfiguration = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 1000000u,
+                                               TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, RESERVED_MEMORY, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"setupBench", "", "", 0, 0, TRDP_OPTION_BLOCK, 0u};
+    UINT8                   data[BENCH_DATA_SIZE];
+    TRDP_TIME_T             start;
+    const CHAR8             *pPhase = "publish";
+    unsigned int            ip[4];
+    UINT32                  ownIP       = 0u;
+    UINT32                  telegrams   = 5000u;
+    UINT32                  groups      = 200u;
+    UINT32                  i;
+    BOOL8                   bulk    = FALSE;
+    TRDP_ERR_T              err     = TRDP_NO_ERR;
+    int                     ch;
+
+    while ((ch = getopt(argc, argv, "o:n:g:bh?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+               if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+               {
+                   printf("invalid IP address\n");
+                   return 1;
+               }
+               ownIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               break;
+           case 'n':
+               if ((sscanf(optarg, "%u", &telegrams) < 1) || (telegrams == 0u) || (telegrams > BENCH_MAX_TELEGRAMS))
+               {
+                   printf("invalid number of telegrams\n");
+                   return 1;
+               }
+               break;
+           case 'g':
+               if ((sscanf(optarg, "%u", &groups) < 1) || (groups == 0u) || (groups > 0xFFFFu))
+               {
+                   printf("invalid number of multicast groups\n");
+                   return 1;
+               }
+               break;
+           case 'b':
+               bulk = TRUE;
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               printf("usage: %s [-o <own IP>] [-n <telegrams>] [-g <multicast groups>] [-b]\n"
+                      "-b publish and subscribe with tlp_publishBulk / tlp_subscribeBulk\n", argv[0]);
+               return 1;
+        }
+    }
+
+    if ((tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, ownIP, 0u, NULL, &pdConfiguration, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+    vos_setLogLevel(VOS_LOG_ERROR);
+    memset(data, 0, sizeof(data));
+
+    for (i = 0u; i < telegrams; i++)
+    {
+        gPubDef[i].comId        = BENCH_COMID + i;
+        gPubDef[i].destIpAddr   = BENCH_MC_BASE + i % groups;
+        gPubDef[i].interval     = 100000u;
+        gPubDef[i].pktFlags     = TRDP_FLAGS_NONE;
+        gPubDef[i].pData        = data;
+        gPubDef[i].dataSize     = BENCH_DATA_SIZE;
+        gSubDef[i].comId        = BENCH_COMID + telegrams + i;
+        gSubDef[i].destIpAddr   = BENCH_MC_BASE + i % groups;
+        gSubDef[i].pktFlags     = TRDP_FLAGS_NONE;
+        gSubDef[i].timeout      = 1000000u;
+        gSubDef[i].toBehavior   = TRDP_TO_SET_TO_ZERO;
+    }
+
+    printf("%u telegrams, %u multicast groups%s\n", telegrams, groups, (bulk == TRUE) ? ", bulk" : "");
+    vos_getTime(&start);
+    if (bulk == TRUE)
+    {
+        err = tlp_publishBulk(appHandle, gPubDef, telegrams);
+        for (i = 0u; (i < telegrams) && (err == TRDP_NO_ERR); i++)
+        {
+            gPub[i] = gPubDef[i].pubHandle;
+        }
+    }
+    for (i = 0u; (i < telegrams) && (err == TRDP_NO_ERR) && (bulk == FALSE); i++)
+    {
+        err = tlp_publish(appHandle, &gPub[i], NULL, NULL, 0u, gPubDef[i].comId, 0u, 0u, 0u,
+                          gPubDef[i].destIpAddr, 100000u, 0u, TRDP_FLAGS_NONE, data, BENCH_DATA_SIZE);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        printPhase(pPhase, telegrams, &start);
+        pPhase = "subscribe";
+    }
+    if ((err == TRDP_NO_ERR) && (bulk == TRUE))
+    {
+        err = tlp_subscribeBulk(appHandle, gSubDef, telegrams);
+        for (i = 0u; (i < telegrams) && (err == TRDP_NO_ERR); i++)
+        {
+            gSub[i] = gSubDef[i].subHandle;
+        }
+    }
+    for (i = 0u; (i < telegrams) && (err == TRDP_NO_ERR) && (bulk == FALSE); i++)
+    {
+        err = tlp_subscribe(appHandle, &gSub[i], NULL, NULL, 0u, gSubDef[i].comId, 0u, 0u,
+                            VOS_INADDR_ANY, VOS_INADDR_ANY, gSubDef[i].destIpAddr, TRDP_FLAGS_NONE,
+                            1000000u, TRDP_TO_SET_TO_ZERO);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        printPhase(pPhase, telegrams, &start);
+        pPhase = "unsubscribe";
+    }
+    for (i = 0u; (i < telegrams) && (err == TRDP_NO_ERR); i++)
+    {
+        err = tlp_unsubscribe(appHandle, gSub[i]);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        printPhase(pPhase, telegrams, &start);
+        pPhase = "unpublish";
+    }
+    for (i = 0u; (i < telegrams) && (err == TRDP_NO_ERR); i++)
+    {
+        err = tlp_unpublish(appHandle, gPub[i]);
+    }
+    if (err == TRDP_NO_ERR)
+    {
+        printPhase(pPhase, telegrams, &start);
+    }
+    else
+    {
+        printf("%s failed (Err: %d)\n", pPhase, err);
+    }
+
+    (void) tlc_terminate();
+    return (err == TRDP_NO_ERR) ? 0 : 1;
+}
@@ -4,6 +4,10 @@
  *
  * @brief           Test application for TRDP traffic shaping
  *
+ * @details         Publishes some PDs with traffic shaping on, or (-x) prints the bytes sent per millisecond by the
+ *                  publishers of an XML configuration, with the former and the current distribution of send times,
+ *                  or (-s) checks that trdp_pdDistribute() moves no send time by more than half its interval.
+ *
  * @note            Project: TCNOpen TRDP prototype stack
  *
  * @author          Bernd Loehr, NewTec GmbH
@@ -32,6 +36,9 @@
 #include "getopt.h"
 #endif
 #include "trdp_if_light.h"
+#include "tau_xml.h"
+#include "trdp_pdcom.h"
+#include "trdp_utils.h"
 #include "vos_thread.h"
 
 /***********************************************************************************************************************
@@ -69,6 +76,11 @@
 /* We use dynamic memory    */
 #define RESERVED_MEMORY  200000
 
+#define PROFILE_MAX_PACKETS     1000u   /* publishers evaluated from an XML configuration */
+#define PROFILE_MAX_NESTING     8u
+
+#define CHECK_ROUNDS            100u    /* send time patterns tried by shapingCheck() */
+
 
 typedef struct testData {
     UINT32    comID;
@@ -89,11 +101,22 @@ TESTDATA_T    gPD[NoOfPackets] =
     {1008, 5000000, 1000}
 };
 
+/* Wire size of the elementary types, index TRDP_DATA_TYPE_T */
+static const UINT32 gTypeSize[TRDP_TIMEDATE64 + 1u] = {0u, 1u, 1u, 2u, 1u, 2u, 4u, 8u, 1u, 2u, 4u, 8u, 4u, 8u, 4u, 6u, 8u};
+
+static TRDP_SHAPING_PKT_T   gBefore[PROFILE_MAX_PACKETS];
+static TRDP_SHAPING_PKT_T   gAfter[PROFILE_MAX_PACKETS];
+static UINT32               gLoadBefore[TRDP_SHAPING_MAX_SLOTS];
+static UINT32               gLoadAfter[TRDP_SHAPING_MAX_SLOTS];
+
 /***********************************************************************************************************************
  * PROTOTYPES
  */
 void dbgOut (void *, TRDP_LOG_T , const CHAR8 *, const CHAR8 *, UINT16 , const CHAR8 *);
 void usage (const char *);
+static UINT32 datasetSize (UINT32, UINT32, apTRDP_DATASET_T, UINT32);
+static int xmlProfile (const char *, BOOL8);
+static int shapingCheck (void);
 
 /* Print a sensible usage message */
 void usage (const char *appName)
@@ -104,10 +127,253 @@ void usage (const char *appName)
            "Arguments are:\n"
            "-o own IP address in dotted decimal\n"
            "-t target IP address in dotted decimal\n"
+           "-x XML configuration: print the bytes per ms of its publishers before and after shaping, send nothing\n"
+           "-q with -x: print the summary only\n"
+           "-s check the send time shift of trdp_pdDistribute(), send nothing\n"
            "-v print version and quit\n"
            );
 }
 
+/**********************************************************************************************************************/
+/** Wire size of a dataset, variable sized arrays count as empty
+ *
+ *  @param[in]      datasetId       dataset to size
+ *  @param[in]      numDataset      number of datasets
+ *  @param[in]      apDataset       datasets of the configuration
+ *  @param[in]      depth           nesting level
+ *
+ *  @retval         size in bytes, 0 if unknown
+ */
+static UINT32 datasetSize (
+    UINT32              datasetId,
+    UINT32              numDataset,
+    apTRDP_DATASET_T    apDataset,
+    UINT32              depth)
+{
+    UINT32  i, j, type;
+    UINT32  size = 0u;
+
+    for (i = 0u; i < numDataset; i++)
+    {
+        if (apDataset[i]->id != datasetId)
+        {
+            continue;
+        }
+        for (j = 0u; j < apDataset[i]->numElement; j++)
+        {
+            type = apDataset[i]->pElement[j].type;
+            if (type <= TRDP_TIMEDATE64)
+            {
+                size += gTypeSize[type] * apDataset[i]->pElement[j].size;
+            }
+            else if ((type > TRDP_TYPE_MAX) && (depth < PROFILE_MAX_NESTING))
+            {
+                size += datasetSize(type, numDataset, apDataset, depth + 1u) * apDataset[i]->pElement[j].size;
+            }
+        }
+        break;
+    }
+    return size;
+}
+
+/**********************************************************************************************************************/
+/** Print the bytes sent per ms by the publishers of an XML configuration
+ *
+ *  All publishers start together. Before: the former trdp_pdDistribute(), spreading them evenly over the smallest
+ *  interval unless this moves a packet by more than 1/2 its interval. After: trdp_pdSlotSchedule().
+ *
+ *  @param[in]      pFileName       XML configuration
+ *  @param[in]      quiet           summary only
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int xmlProfile (
+    const char  *pFileName,
+    BOOL8       quiet)
+{
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    TRDP_PD_CONFIG_T        pdConfig;
+    TRDP_MD_CONFIG_T        mdConfig;
+    TRDP_COM_PAR_T          *pComPar        = NULL;
+    TRDP_IF_CONFIG_T        *pIfConfig      = NULL;
+    TRDP_EXCHG_PAR_T        *pExchgPar      = NULL;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    apTRDP_DATASET_T        apDataset       = NULL;
+    UINT32                  numComPar       = 0u;
+    UINT32                  numIfConfig     = 0u;
+    UINT32                  numExchgPar     = 0u;
+    UINT32                  numComId        = 0u;
+    UINT32                  numDataset      = 0u;
+    UINT32                  noOfPackets     = 0u;
+    UINT32                  minInterval     = 0xFFFFFFFFu;
+    UINT32                  hyperperiod, peakBefore, peakAfter, delta, i, j, k;
+    UINT64                  bytes           = 0u;
+    int                     rv              = 0;
+
+    if (tau_prepareXmlDoc(pFileName, &docHnd) != TRDP_NO_ERR)
+    {
+        printf("%s: cannot read the configuration\n", pFileName);
+        return 1;
+    }
+    if ((tau_readXmlDeviceConfig(&docHnd, &memConfig, &dbgConfig, &numComPar, &pComPar,
+                                 &numIfConfig, &pIfConfig) != TRDP_NO_ERR) ||
+        (tau_readXmlDatasetConfig(&docHnd, &numComId, &pComIdDsIdMap, &numDataset, &apDataset) != TRDP_NO_ERR))
+    {
+        printf("%s: cannot read the configuration\n", pFileName);
+        rv = 1;
+        numIfConfig = 0u;
+    }
+
+    for (i = 0u; i < numIfConfig; i++)
+    {
+        if (tau_readXmlInterfaceConfig(&docHnd, pIfConfig[i].ifName, &processConfig, &pdConfig, &mdConfig,
+                                       &numExchgPar, &pExchgPar) != TRDP_NO_ERR)
+        {
+            printf("%s: cannot read interface %s\n", pFileName, pIfConfig[i].ifName);
+            rv = 1;
+            break;
+        }
+        /*  One publisher per destination, telegrams without type are published if they have destinations  */
+        for (j = 0u; j < numExchgPar; j++)
+        {
+            if (((pExchgPar[j].type != TRDP_EXCHG_SOURCE) && (pExchgPar[j].type != TRDP_EXCHG_SOURCESINK) &&
+                 (pExchgPar[j].type != TRDP_EXCHG_UNSET)) ||
+                (pExchgPar[j].pPdPar == NULL) || (pExchgPar[j].pPdPar->cycle == 0u))
+            {
+                continue;
+            }
+            for (k = 0u; (k < pExchgPar[j].destCnt) && (noOfPackets < PROFILE_MAX_PACKETS); k++)
+            {
+                gBefore[noOfPackets].period = (pExchgPar[j].pPdPar->cycle + TRDP_SHAPING_SLOT_US / 2u) /
+                                              TRDP_SHAPING_SLOT_US;
+                if (gBefore[noOfPackets].period == 0u)
+                {
+                    gBefore[noOfPackets].period = 1u;
+                }
+                gBefore[noOfPackets].size   = trdp_packetSizePD(datasetSize(pExchgPar[j].datasetId, numDataset,
+                                                                            apDataset, 0u));
+                gBefore[noOfPackets].phase  = 0u;
+                gBefore[noOfPackets].pRef   = NULL;
+                if (pExchgPar[j].pPdPar->cycle < minInterval)
+                {
+                    minInterval = pExchgPar[j].pPdPar->cycle;
+                }
+                noOfPackets++;
+            }
+        }
+        tau_freeTelegrams(numExchgPar, pExchgPar);
+        pExchgPar = NULL;
+    }
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    tau_freeXmlDoc(&docHnd);
+    if (pComPar != NULL)
+    {
+        vos_memFree(pComPar);
+    }
+    if (pIfConfig != NULL)
+    {
+        vos_memFree(pIfConfig);
+    }
+
+    if (rv != 0)
+    {
+        return rv;
+    }
+    if (noOfPackets == 0u)
+    {
+        printf("%s: no cyclic publishers\n", pFileName);
+        return 1;
+    }
+
+    /*  Former distribution: n packets evenly over the smallest interval    */
+    delta = minInterval / noOfPackets;
+    for (i = 0u; i < noOfPackets; i++)
+    {
+        if (2u * i * delta <= gBefore[i].period * TRDP_SHAPING_SLOT_US)
+        {
+            gBefore[i].phase = (i * delta / TRDP_SHAPING_SLOT_US) % gBefore[i].period;
+        }
+        gAfter[i]       = gBefore[i];
+        gAfter[i].phase = 0u;
+    }
+
+    hyperperiod = trdp_pdHyperperiod(gBefore, noOfPackets);
+    peakBefore  = trdp_pdSlotProfile(gBefore, noOfPackets, hyperperiod, gLoadBefore);
+    trdp_pdSlotSchedule(gAfter, noOfPackets, hyperperiod, gLoadAfter);
+    peakAfter   = trdp_pdSlotProfile(gAfter, noOfPackets, hyperperiod, gLoadAfter);
+    for (i = 0u; i < hyperperiod; i++)
+    {
+        bytes += gLoadAfter[i];
+    }
+
+    printf("%s: %u publishers, hyperperiod %u ms\n", pFileName, noOfPackets, hyperperiod);
+    printf("bytes per ms: mean %u, peak before %u, peak after %u\n",
+           (unsigned int) (bytes / hyperperiod), peakBefore, peakAfter);
+    if (quiet == FALSE)
+    {
+        printf("    ms     before      after\n");
+        for (i = 0u; i < hyperperiod; i++)
+        {
+            printf("%6u %10u %10u\n", i, gLoadBefore[i], gLoadAfter[i]);
+        }
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Check the send times set by trdp_pdDistribute()
+ *
+ *  Publishers with intervals below, at and above 2 slots start at varying offsets. Every send time must be moved by
+ *  at most 1/2 its interval, and not at all below 2 slots.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int shapingCheck (void)
+{
+    static const UINT32 interval[] = {500u, 1000u, 1500u, 2000u, 2400u, 2500u, 3000u, 10000u, 20000u, 100000u};
+    PD_ELE_T            packet[sizeof(interval) / sizeof(interval[0])];
+    UINT64              before[sizeof(interval) / sizeof(interval[0])];
+    UINT64              after;
+    INT64               moved;
+    UINT32              noOfPackets = sizeof(interval) / sizeof(interval[0]);
+    UINT32              round, i;
+    int                 rv = 0;
+
+    for (round = 0u; round < CHECK_ROUNDS; round++)
+    {
+        memset(packet, 0, sizeof(packet));
+        for (i = 0u; i < noOfPackets; i++)
+        {
+            packet[i].pNext             = (i + 1u < noOfPackets) ? &packet[i + 1u] : NULL;
+            packet[i].interval.tv_sec   = interval[i] / 1000000u;
+            packet[i].interval.tv_usec  = interval[i] % 1000000u;
+            packet[i].grossSize         = 1000u;
+            before[i]                   = 1000000000ull + (UINT64) ((round * 173u + i * 337u) % interval[i]);
+            packet[i].timeToGo.tv_sec   = (UINT32) (before[i] / 1000000u);
+            packet[i].timeToGo.tv_usec  = (UINT32) (before[i] % 1000000u);
+        }
+        (void) trdp_pdDistribute(packet);
+        for (i = 0u; i < noOfPackets; i++)
+        {
+            after   = (UINT64) packet[i].timeToGo.tv_sec * 1000000u + (UINT64) packet[i].timeToGo.tv_usec;
+            moved   = (INT64) (after - before[i]);
+            if (((interval[i] < 2u * TRDP_SHAPING_SLOT_US) && (moved != 0)) ||
+                (2 * ((moved < 0) ? -moved : moved) > (INT64) interval[i]))
+            {
+                printf("round %u: interval %u us moved by %lld us\n", round, interval[i], (long long) moved);
+                rv = 1;
+            }
+        }
+    }
+    printf("send time shift check %s\n", (rv == 0) ? "passed" : "FAILED");
+    return rv;
+}
+
 /**********************************************************************************************************************/
 /** callback routine for TRDP logging/error output
  *
@@ -169,6 +435,9 @@ int main (int argc, char *argv[])
     UINT8               exampleData[DATA_MAX]   = "Hello World";
     int                 i;
     int                 ch;
+    const char          *pXmlFile = NULL;
+    BOOL8               quiet = FALSE;
+    BOOL8               check = FALSE;
     
     outputBuffer = exampleData;
     
@@ -178,7 +447,7 @@ int main (int argc, char *argv[])
         return 1;
     }
 
-    while ((ch = getopt(argc, argv, "t:o:h?v")) != -1)
+    while ((ch = getopt(argc, argv, "t:o:x:qsh?v")) != -1)
     {
         switch (ch)
         {
@@ -204,6 +473,15 @@ int main (int argc, char *argv[])
                 destIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
                 break;
             }
+            case 'x':
+                pXmlFile = optarg;
+                break;
+            case 'q':
+                quiet = TRUE;
+                break;
+            case 's':
+                check = TRUE;
+                break;
             case 'v':   /*  version */
                 printf("%s: Version %s\t(%s - %s)\n",
                        argv[0], APP_VERSION, __DATE__, __TIME__);
@@ -217,6 +495,18 @@ int main (int argc, char *argv[])
         }
     }
 
+    if ((pXmlFile != NULL) || check)
+    {
+        if (tlc_init(NULL, NULL, &dynamicConfig) != TRDP_NO_ERR)
+        {
+            printf("Initialization error\n");
+            return 1;
+        }
+        rv = (pXmlFile != NULL) ? xmlProfile(pXmlFile, quiet) : shapingCheck();
+        (void) tlc_terminate();
+        return rv;
+    }
+
     if (destIP == 0)
     {
         fprintf(stderr, "No destination address given!\n");
@@ -0,0 +1,312 @@
+/**********************************************************************************************************************/
+/**
+ * @file            txTimeTest.c
+ *
+ * @brief           Measurement of PD send jitter with and without launch times (TRDP_OPTION_TXTIME)
+ *
+ * @details         Sender (-t): publishes one telegram with the given cycle time. Before each tlc_process() it waits a
+ *                  random time of up to the given jitter, emulating a loaded system. With -l the session runs with
+ *                  TRDP_OPTION_TXTIME: cyclic PD is queued one cycle ahead with its launch time.
+ *                  Receiver (-r): subscribes to the telegram with kernel receive time stamps and prints the deviation
+ *                  of the inter-arrival times from the cycle time.
+ *                  txTimeTest.sh runs both on a veth pair, with the fq qdisc on the sending side.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          TCNOpen TRDP contributors
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Alstom SA or its subsidiaries and others, 2013-2023. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "0.1"
+
+#define TEST_COMID          2046u
+#define TEST_DATA_SIZE      64u
+#define TEST_MAX_PACKETS    100000u
+#define RESERVED_MEMORY     1000000u
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT32       gCycle      = 10000u;   /* us, at least TRDP_TIMER_GRANULARITY */
+static UINT32       gPackets    = 1000u;
+static UINT32       gReceived   = 0u;
+static TRDP_TIME_T  gLastRx;
+static UINT32       gDeviation[TEST_MAX_PACKETS];   /* |inter-arrival - cycle| in us */
+
+/**********************************************************************************************************************/
+/** Debug output, errors only
+ */
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    if (category == VOS_LOG_ERROR)
+    {
+        printf("%s %s:%u %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Receiver: record the inter-arrival time of each telegram
+ */
+static void rxCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_TIME_T period;
+    UINT32      periodUs;
+
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (gReceived > gPackets))
+    {
+        return;
+    }
+    if (gReceived > 0u)
+    {
+        period = pMsg->rxTime;
+        vos_subTime(&period, &gLastRx);
+        periodUs = (UINT32) period.tv_sec * 1000000u + (UINT32) period.tv_usec;
+        gDeviation[gReceived - 1u] = (periodUs > gCycle) ? (periodUs - gCycle) : (gCycle - periodUs);
+    }
+    gLastRx = pMsg->rxTime;
+    gReceived++;
+}
+
+/**********************************************************************************************************************/
+/** Sort helper
+ */
+static int cmpUInt32 (
+    const void  *pA,
+    const void  *pB)
+{
+    UINT32  a   = *(const UINT32 *) pA;
+    UINT32  b   = *(const UINT32 *) pB;
+
+    return (a > b) - (a < b);
+}
+
+/**********************************************************************************************************************/
+/** Print the deviations of the inter-arrival times from the cycle time
+ */
+static void printDeviation (void)
+{
+    UINT64  sum = 0u;
+    UINT32  n   = gReceived - 1u;
+    UINT32  i;
+
+    qsort(gDeviation, n, sizeof(UINT32), cmpUInt32);
+    for (i = 0u; i < n; i++)
+    {
+        sum += gDeviation[i];
+    }
+    printf("%u inter-arrivals, cycle %u us, deviation in us: mean %u, median %u, p99 %u, p99.9 %u, max %u\n",
+           n, gCycle, (unsigned int) (sum / n), gDeviation[n / 2u], gDeviation[n - 1u - n / 100u],
+           gDeviation[n - 1u - n / 1000u], gDeviation[n - 1u]);
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_PUB_T              pubHandle;
+    TRDP_SUB_T              subHandle;
+    TRDP_PD_CONFIG_T        pdConfiguration = {NULL, NULL, TRDP_PD_DEFAULT_SEND_PARAM, TRDP_FLAGS_NONE, 1000000u,
+                                               TRDP_TO_SET_TO_ZERO, TRDP_PD_UDP_PORT};
+    TRDP_MEM_CONFIG_T       dynamicConfig   = {NULL, RESERVED_MEMORY, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"txTimeTest", "", "", 0, 0, TRDP_OPTION_BLOCK, 0u};
+    UINT8                   data[TEST_DATA_SIZE];
+    TRDP_TIME_T             start, end, now;
+    unsigned int            ip[4];
+    UINT32                  ownIP       = 0u;
+    UINT32                  destIP      = 0u;
+    UINT32                  jitter      = 0u;
+    BOOL8                   receiver    = FALSE;
+    BOOL8                   launchTime  = FALSE;
+    TRDP_ERR_T              err;
+    int                     ch;
+
+    while ((ch = getopt(argc, argv, "o:t:c:n:j:rlh?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+           case 't':
+               if (sscanf(optarg, "%u.%u.%u.%u", &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+               {
+                   printf("invalid IP address\n");
+                   return 1;
+               }
+               if (ch == 'o')
+               {
+                   ownIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               }
+               else
+               {
+                   destIP = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               }
+               break;
+           case 'c':
+               if ((sscanf(optarg, "%u", &gCycle) < 1) || (gCycle == 0u))
+               {
+                   printf("invalid cycle time\n");
+                   return 1;
+               }
+               break;
+           case 'n':
+               if ((sscanf(optarg, "%u", &gPackets) < 1) || (gPackets < 2u) || (gPackets > TEST_MAX_PACKETS))
+               {
+                   printf("invalid number of packets\n");
+                   return 1;
+               }
+               break;
+           case 'j':
+               if (sscanf(optarg, "%u", &jitter) < 1)
+               {
+                   printf("invalid jitter\n");
+                   return 1;
+               }
+               break;
+           case 'r':
+               receiver = TRUE;
+               break;
+           case 'l':
+               launchTime = TRUE;
+               break;
+           case 'v':
+               printf("%s: Version %s\t(%s - %s)\n", argv[0], APP_VERSION, __DATE__, __TIME__);
+               return 0;
+           case 'h':
+           case '?':
+           default:
+               printf("usage: %s -r [-o <own IP>] [-c <cycle us>] [-n <packets>]\n"
+                      "       %s -t <target IP> [-o <own IP>] [-c <cycle us>] [-n <packets>] [-j <jitter us>] [-l]\n"
+                      "-r receive and print the inter-arrival deviation\n"
+                      "-t send to the target, waiting up to <jitter> us before each tlc_process()\n"
+                      "-l send with launch times (TRDP_OPTION_TXTIME)\n",
+                      argv[0], argv[0]);
+               return 1;
+        }
+    }
+    if ((receiver == FALSE) && (destIP == 0u))
+    {
+        printf("either -r or -t <target IP> needed\n");
+        return 1;
+    }
+
+    processConfig.options |= (receiver == TRUE) ? TRDP_OPTION_TIMESTAMPING : TRDP_OPTION_NONE;
+    processConfig.options |= (launchTime == TRUE) ? TRDP_OPTION_TXTIME : TRDP_OPTION_NONE;
+    if ((tlc_init(dbgOut, NULL, &dynamicConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, ownIP, 0u, NULL, &pdConfiguration, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+
+    memset(data, 0, sizeof(data));
+    if (receiver == TRUE)
+    {
+        err = tlp_subscribe(appHandle, &subHandle, NULL, rxCallback, 0u, TEST_COMID, 0u, 0u,
+                            VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                            1000000u, TRDP_TO_SET_TO_ZERO);
+    }
+    else
+    {
+        err = tlp_publish(appHandle, &pubHandle, NULL, NULL, 0u, TEST_COMID, 0u, 0u, 0u, destIP, gCycle, 0u,
+                          TRDP_FLAGS_NONE, data, TEST_DATA_SIZE);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        printf("publish / subscribe error %d\n", err);
+        (void) tlc_terminate();
+        return 1;
+    }
+
+    /*  The receiver waits for its packets (or 10s for the first), the sender sends for gPackets cycles   */
+    vos_getTime(&start);
+    end = start;
+    end.tv_sec += (receiver == TRUE) ? 10 : 0;
+    now.tv_sec  = (gPackets * gCycle) / 1000000u;
+    now.tv_usec = (gPackets * gCycle) % 1000000u;
+    vos_addTime(&end, &now);
+    srand(1u);
+
+    do
+    {
+        VOS_FDS_T       rfds;
+        TRDP_SOCK_T     noDesc;
+        VOS_TIMEVAL_T   tv;
+        VOS_TIMEVAL_T   maxTv = {0, 10000};
+        INT32           rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, (TRDP_TIME_T *) &tv, (TRDP_FDS_T *) &rfds, &noDesc);
+        if (vos_cmpTime((TRDP_TIME_T *) &tv, (TRDP_TIME_T *) &maxTv) > 0)
+        {
+            tv = maxTv;
+        }
+        rv = vos_select((int)noDesc, &rfds, NULL, NULL, &tv);
+        if ((jitter > 0u) && (receiver == FALSE))
+        {
+            (void) vos_threadDelay((UINT32) rand() % jitter);
+        }
+        (void) tlc_process(appHandle, (TRDP_FDS_T *) &rfds, &rv);
+        vos_getTime(&now);
+    }
+    while ((vos_cmpTime(&now, &end) < 0) && ((receiver == FALSE) || (gReceived <= gPackets)));
+
+    if (receiver == TRUE)
+    {
+        if (gReceived < 2u)
+        {
+            printf("no packets received\n");
+            (void) tlc_terminate();
+            return 1;
+        }
+        if (gReceived > gPackets)
+        {
+            gReceived = gPackets;
+        }
+        printDeviation();
+    }
+    (void) tlc_terminate();
+    return 0;
+}
@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# Send jitter of cyclic PD with and without launch times (TRDP_OPTION_TXTIME), measured on a veth pair.
+# The sender runs in network namespace txtA with the fq qdisc (releases packets at their launch time), the
+# receiver in txtB with kernel receive time stamps. Needs root.
+#
+# usage: txTimeTest.sh [txTimeTest binary] [cycle us] [jitter us] [packets]
+#
+
+BIN=${1:-bld/output/linux-rel/txTimeTest}
+CYCLE=${2:-10000}
+JITTER=${3:-2000}
+PACKETS=${4:-1000}
+
+cleanup()
+{
+    ip netns del txtA 2>/dev/null
+    ip netns del txtB 2>/dev/null
+}
+
+cleanup
+trap cleanup EXIT
+ip netns add txtA || exit 1
+ip netns add txtB || exit 1
+ip link add txtA0 netns txtA type veth peer name txtB0 netns txtB || exit 1
+ip -n txtA addr add 10.199.0.1/24 dev txtA0
+ip -n txtB addr add 10.199.0.2/24 dev txtB0
+ip -n txtA link set txtA0 up
+ip -n txtB link set txtB0 up
+ip -n txtA link set lo up
+ip -n txtB link set lo up
+
+if ip netns exec txtA tc qdisc replace dev txtA0 root fq 2>/dev/null; then
+    echo "sender qdisc: fq"
+else
+    echo "sender qdisc: $(ip netns exec txtA tc qdisc show dev txtA0 | cut -d' ' -f2) - fq not available," \
+         "launch times are ignored"
+fi
+echo "cycle $CYCLE us, up to $JITTER us scheduling delay before each tlc_process()"
+
+for MODE in "" "-l"; do
+    ip netns exec txtB "$BIN" -r -o 10.199.0.2 -c "$CYCLE" -n "$PACKETS" > /tmp/txTimeTest.$$ &
+    RX=$!
+    sleep 1
+    ip netns exec txtA "$BIN" -o 10.199.0.1 -t 10.199.0.2 -c "$CYCLE" -n $((PACKETS + 200)) -j "$JITTER" $MODE
+    wait $RX
+    if [ -z "$MODE" ]; then printf "sent when due:    "; else printf "with launch time: "; fi
+    cat /tmp/txTimeTest.$$
+    rm -f /tmp/txTimeTest.$$
+done
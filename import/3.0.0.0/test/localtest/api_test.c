@@ -37,6 +37,7 @@
 
 #if defined (POSIX)
 #include <unistd.h>
+#include <sys/wait.h>
 #elif (defined (WIN32) || defined (WIN64))
 #include "getopt.h"
 #endif
@@ -46,6 +47,9 @@
 #include "vos_utils.h"
 
 #include "tau_xml.h"
+#include "tau_mdcq.h"
+#include "tau_xml_cache.h"
+#include "tau_tstore.h"
 #include "vos_shared_mem.h"
 
 /***********************************************************************************************************************
@@ -73,6 +77,9 @@ typedef struct
 TRDP_THREAD_SESSION_T   gSession1 = {NULL, 0x0A000364u, 0, 0};
 TRDP_THREAD_SESSION_T   gSession2 = {NULL, 0x0A000365u, 0, 0};
 
+/* Process configuration of the sessions opened by test_init(), NULL for the defaults */
+static const TRDP_PROCESS_CONFIG_T *gpProcessConfig = NULL;
+
 /* Data buffers to play with (Content is borrowed from Douglas Adams, "The Hitchhiker's Guide to the Galaxy") */
 static uint8_t          dataBuffer1[64 * 1024] =
 {
@@ -555,7 +562,7 @@ static TRDP_APP_SESSION_T test_init (
     }
     if (err == TRDP_NO_ERR)                 /* We ignore double init here */
     {
-        tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, NULL, NULL);
+        tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, NULL, gpProcessConfig);
         /* On error the handle will be NULL... */
     }
 
@@ -2245,8 +2252,918 @@ static int test18 ()
     CLEANUP;
 }
 
+/**********************************************************************************************************************/
+/** test19 MD request completion queue
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define TEST19_COMID        1019u
+#define TEST19_IN_FLIGHT    16u
+#define TEST19_REQUESTS     64u
+
+static void  test19CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    UINT32 echo = 0u;
+
+    /* Echo the request (copy first, the request buffer is reused for the reply) */
+    if ((pMsg->msgType == TRDP_MSG_MR) && (pMsg->resultCode == TRDP_NO_ERR) && (dataSize == sizeof(echo)))
+    {
+        memcpy(&echo, pData, sizeof(echo));
+        if (tlm_reply(appHandle, &pMsg->sessionId, TEST19_COMID, 0u, NULL, (UINT8 *)&echo, sizeof(echo), NULL)
+            != TRDP_NO_ERR)
+        {
+            gFailed = 1;
+        }
+    }
+}
+
+static int test19 ()
+{
+    PREPARE("MD request completion queue", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_LIS_T          listenHandle;
+        TAU_MDCQ_T          cq = NULL;
+        TAU_MDCQ_ENTRY_T    entries[8];
+        UINT32              numEntries;
+        UINT32              sent = 0u;
+        UINT32              done = 0u;
+        UINT32              i, payload;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test19CBFunction,
+                              TRUE,
+                              TEST19_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tau_mdcqCreate(appHandle1, TEST19_IN_FLIGHT, &cq);
+        IF_ERROR("tau_mdcqCreate");
+
+        while (done < TEST19_REQUESTS)
+        {
+            /* Keep the pipe full */
+            while (sent < TEST19_REQUESTS)
+            {
+                payload = vos_htonl(sent + 1u);
+                err     = tau_mdcqRequest(cq, (const void *)(size_t)(sent + 1u), NULL,
+                                          TEST19_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                                          TRDP_FLAGS_CALLBACK, 1u, 1000000u, NULL,
+                                          (UINT8 *)&payload, sizeof(payload), NULL, NULL);
+                if (err == TRDP_QUEUE_FULL_ERR)
+                {
+                    if (tau_mdcqInFlight(cq) != TEST19_IN_FLIGHT)
+                    {
+                        tau_mdcqDestroy(cq);
+                        FAILED("queue full reported too early");
+                    }
+                    break;
+                }
+                if (err != TRDP_NO_ERR)
+                {
+                    tau_mdcqDestroy(cq);
+                }
+                IF_ERROR("tau_mdcqRequest");
+                sent++;
+            }
+
+            err = tau_mdcqReap(cq, entries, 8u, 2000000u, &numEntries);
+            if (err != TRDP_NO_ERR)
+            {
+                tau_mdcqDestroy(cq);
+            }
+            IF_ERROR("tau_mdcqReap");
+
+            for (i = 0u; i < numEntries; i++)
+            {
+                if ((entries[i].resultCode != TRDP_NO_ERR) ||
+                    (entries[i].isFinal != TRUE) ||
+                    (entries[i].dataSize != sizeof(payload)) ||
+                    (vos_ntohl(*(UINT32 *)entries[i].pData) != (UINT32)(size_t)entries[i].pToken))
+                {
+                    fprintf(gFp, "### completion %u: result %d, token %u\n", i, entries[i].resultCode,
+                            (UINT32)(size_t)entries[i].pToken);
+                    gFailed = 1;
+                }
+            }
+            tau_mdcqRelease(entries, numEntries);
+            done += numEntries;
+        }
+        fprintf(gFp, "->> %u requests completed\n", done);
+
+        if (tau_mdcqInFlight(cq) != 0u)
+        {
+            gFailed = 1;
+        }
+
+        err = tau_mdcqDestroy(cq);
+        IF_ERROR("tau_mdcqDestroy");
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
 
+/**********************************************************************************************************************/
+/** test20 XML configuration cache
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST20_XML_FILE     "localtest20.xml"
+#define TEST20_CACHE_FILE   "localtest20.xml.bin"
+
+static int test20Compare (
+    TAU_XML_CACHE_T         cache,
+    TRDP_XML_DOC_HANDLE_T   *pDocHnd,
+    const CHAR8             *pIfName)
+{
+    TRDP_MEM_CONFIG_T       memConfig[2];
+    TRDP_DBG_CONFIG_T       dbgConfig[2];
+    UINT32                  numComPar[2];
+    TRDP_COM_PAR_T          *pComPar[2];
+    UINT32                  numIfConfig[2];
+    TRDP_IF_CONFIG_T        *pIfConfig[2];
+    TRDP_PROCESS_CONFIG_T   processConfig[2];
+    TRDP_PD_CONFIG_T        pdConfig[2];
+    TRDP_MD_CONFIG_T        mdConfig[2];
+    UINT32                  numExchgPar[2];
+    TRDP_EXCHG_PAR_T        *pExchgPar[2];
+    UINT32                  numComId[2];
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap[2];
+    UINT32                  numDataset[2];
+    apTRDP_DATASET_T        apDataset[2];
+    int                     diff = 0;
+    UINT32                  i, j;
+
+    memset(memConfig, 0, sizeof(memConfig));
+    memset(dbgConfig, 0, sizeof(dbgConfig));
+    memset(processConfig, 0, sizeof(processConfig));
+    memset(pdConfig, 0, sizeof(pdConfig));
+    memset(mdConfig, 0, sizeof(mdConfig));
+
+    if ((tau_readXmlDeviceConfig(pDocHnd, &memConfig[0], &dbgConfig[0], &numComPar[0], &pComPar[0],
+                                 &numIfConfig[0], &pIfConfig[0]) != TRDP_NO_ERR) ||
+        (tau_readCachedDeviceConfig(cache, &memConfig[1], &dbgConfig[1], &numComPar[1], &pComPar[1],
+                                    &numIfConfig[1], &pIfConfig[1]) != TRDP_NO_ERR))
+    {
+        return 1;
+    }
+    diff |= memcmp(&memConfig[0], &memConfig[1], sizeof(TRDP_MEM_CONFIG_T));
+    diff |= memcmp(&dbgConfig[0], &dbgConfig[1], sizeof(TRDP_DBG_CONFIG_T));
+    diff |= (numComPar[0] != numComPar[1]) || (numIfConfig[0] != numIfConfig[1]);
+    if (diff == 0)
+    {
+        diff |= memcmp(pComPar[0], pComPar[1], numComPar[0] * sizeof(TRDP_COM_PAR_T));
+        diff |= memcmp(pIfConfig[0], pIfConfig[1], numIfConfig[0] * sizeof(TRDP_IF_CONFIG_T));
+    }
+    for (i = 0u; i < 2u; i++)
+    {
+        vos_memFree(pComPar[i]);
+        vos_memFree(pIfConfig[i]);
+    }
 
+    if ((tau_readXmlInterfaceConfig(pDocHnd, pIfName, &processConfig[0], &pdConfig[0], &mdConfig[0],
+                                    &numExchgPar[0], &pExchgPar[0]) != TRDP_NO_ERR) ||
+        (tau_readCachedInterfaceConfig(cache, pIfName, &processConfig[1], &pdConfig[1], &mdConfig[1],
+                                       &numExchgPar[1], &pExchgPar[1]) != TRDP_NO_ERR))
+    {
+        return 1;
+    }
+    diff |= memcmp(&processConfig[0], &processConfig[1], sizeof(TRDP_PROCESS_CONFIG_T));
+    diff |= memcmp(&pdConfig[0], &pdConfig[1], sizeof(TRDP_PD_CONFIG_T));
+    diff |= memcmp(&mdConfig[0], &mdConfig[1], sizeof(TRDP_MD_CONFIG_T));
+    diff |= (numExchgPar[0] != numExchgPar[1]);
+    for (i = 0u; (diff == 0) && (i < numExchgPar[0]); i++)
+    {
+        const TRDP_EXCHG_PAR_T *pA = &pExchgPar[0][i];
+        const TRDP_EXCHG_PAR_T *pB = &pExchgPar[1][i];
+
+        diff |= (pA->comId != pB->comId) || (pA->datasetId != pB->datasetId) || (pA->srcCnt != pB->srcCnt)
+                || (pA->destCnt != pB->destCnt) || ((pA->pPdPar == NULL) != (pB->pPdPar == NULL));
+        if ((diff == 0) && (pA->pPdPar != NULL))
+        {
+            diff |= memcmp(pA->pPdPar, pB->pPdPar, sizeof(TRDP_PD_PAR_T));
+        }
+        for (j = 0u; (diff == 0) && (j < pA->srcCnt); j++)
+        {
+            diff |= (pA->pSrc[j].id != pB->pSrc[j].id)
+                    || ((pA->pSrc[j].pSdtPar == NULL) != (pB->pSrc[j].pSdtPar == NULL))
+                    || ((pA->pSrc[j].pUriHost1 == NULL) != (pB->pSrc[j].pUriHost1 == NULL));
+            if ((diff == 0) && (pA->pSrc[j].pSdtPar != NULL))
+            {
+                diff |= memcmp(pA->pSrc[j].pSdtPar, pB->pSrc[j].pSdtPar, sizeof(TRDP_SDT_PAR_T));
+            }
+            if ((diff == 0) && (pA->pSrc[j].pUriHost1 != NULL))
+            {
+                diff |= strcmp(*pA->pSrc[j].pUriHost1, *pB->pSrc[j].pUriHost1);
+            }
+        }
+    }
+    tau_freeTelegrams(numExchgPar[0], pExchgPar[0]);
+    tau_freeTelegrams(numExchgPar[1], pExchgPar[1]);
+
+    if ((tau_readXmlDatasetConfig(pDocHnd, &numComId[0], &pComIdDsIdMap[0], &numDataset[0], &apDataset[0])
+         != TRDP_NO_ERR) ||
+        (tau_readCachedDatasetConfig(cache, &numComId[1], &pComIdDsIdMap[1], &numDataset[1], &apDataset[1])
+         != TRDP_NO_ERR))
+    {
+        return 1;
+    }
+    diff |= (numComId[0] != numComId[1]) || (numDataset[0] != numDataset[1]);
+    for (i = 0u; (diff == 0) && (i < numDataset[0]); i++)
+    {
+        diff |= (apDataset[0][i]->id != apDataset[1][i]->id)
+                || (apDataset[0][i]->numElement != apDataset[1][i]->numElement)
+                || strcmp(apDataset[0][i]->name, apDataset[1][i]->name);
+        for (j = 0u; (diff == 0) && (j < apDataset[0][i]->numElement); j++)
+        {
+            diff |= (apDataset[0][i]->pElement[j].type != apDataset[1][i]->pElement[j].type)
+                    || strcmp(apDataset[0][i]->pElement[j].name, apDataset[1][i]->pElement[j].name);
+        }
+    }
+    tau_freeXmlDatasetConfig(numComId[0], pComIdDsIdMap[0], numDataset[0], apDataset[0]);
+    tau_freeXmlDatasetConfig(numComId[1], pComIdDsIdMap[1], numDataset[1], apDataset[1]);
+
+    return (diff != 0) ? 1 : 0;
+}
+
+static int test20 ()
+{
+    PREPARE1("XML configuration cache"); /* allocates appHandle1, failed = 0, err = TRDP_NO_ERR */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_XML_DOC_HANDLE_T   docHnd;
+        TAU_XML_CACHE_T         cache = NULL;
+        FILE                    *fp;
+        int                     pass;
+
+        fp = fopen(TEST20_XML_FILE, "wb");
+        if (fp == NULL)
+        {
+            FAILED("cannot write " TEST20_XML_FILE);
+        }
+        (void) fwrite(xmlBuffer, 1u, strlen(xmlBuffer), fp);
+        (void) fclose(fp);
+        (void) remove(TEST20_CACHE_FILE);
+
+        err = tau_prepareXmlDoc(TEST20_XML_FILE, &docHnd);
+        IF_ERROR("tau_prepareXmlDoc");
+
+        /* 1st: compiled from XML, 2nd: mapped cache file, 3rd: XML changed -> recompiled */
+        for (pass = 0; pass < 3; pass++)
+        {
+            if (pass == 2)
+            {
+                fp = fopen(TEST20_XML_FILE, "ab");
+                if (fp != NULL)
+                {
+                    (void) fputs("\n<!-- changed -->\n", fp);
+                    (void) fclose(fp);
+                }
+            }
+
+            err = tau_openXmlCache(TEST20_XML_FILE, TEST20_CACHE_FILE, &cache);
+            if (err != TRDP_NO_ERR)
+            {
+                tau_freeXmlDoc(&docHnd);
+            }
+            IF_ERROR("tau_openXmlCache");
+
+            fprintf(gFp, "->> pass %d: %s\n", pass, tau_isXmlCacheHit(cache) ? "cache hit" : "compiled");
+            if (tau_isXmlCacheHit(cache) != ((pass == 1) ? TRUE : FALSE))
+            {
+                fprintf(gFp, "### unexpected cache state in pass %d\n", pass);
+                gFailed = 1;
+            }
+            if ((test20Compare(cache, &docHnd, "enp0s3:1") != 0) ||
+                (test20Compare(cache, &docHnd, "") != 0) ||
+                (test20Compare(cache, &docHnd, "unknown") != 0))
+            {
+                fprintf(gFp, "### cached configuration differs from XML in pass %d\n", pass);
+                gFailed = 1;
+            }
+            tau_closeXmlCache(cache);
+        }
+        tau_freeXmlDoc(&docHnd);
+        (void) remove(TEST20_CACHE_FILE);
+        (void) remove(TEST20_XML_FILE);
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+
+
+/**********************************************************************************************************************/
+/** test21 Asynchronous log output
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST21_THREADS      4u
+#define TEST21_MESSAGES     50u
+#define TEST21_MARKER       "test21 "
+#define TEST21_PREC_MARKER  "test21p "
+#define TEST21_PREC_RESULT  TEST21_PREC_MARKER "abcd|he|  ab\n"
+
+static VOS_THREAD_T gTest21Caller;
+static UINT32       gTest21Received;
+static UINT32       gTest21Prec;
+static UINT32       gTest21Wrong;
+static UINT32       gTest21Done;
+
+static void test21DbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      lineNumber,
+    const CHAR8 *pMsgStr)
+{
+    VOS_THREAD_T    self = 0;
+    unsigned int    thread, msg;
+    CHAR8           expected[64];
+
+    if (strncmp(pMsgStr, TEST21_PREC_MARKER, strlen(TEST21_PREC_MARKER)) == 0)
+    {
+        if (strcmp(pMsgStr, TEST21_PREC_RESULT) == 0)
+        {
+            gTest21Prec++;
+        }
+        else
+        {
+            fprintf(gFp, "->> got %s", pMsgStr);
+            gTest21Wrong++;
+        }
+        return;
+    }
+    if (strncmp(pMsgStr, TEST21_MARKER, strlen(TEST21_MARKER)) != 0)
+    {
+        dbgOut(pRefCon, category, pTime, pFile, lineNumber, pMsgStr);
+        return;
+    }
+    /* messages must be formatted by the log thread, not by the caller */
+    (void) vos_threadSelf(&self);
+    if ((self == gTest21Caller) ||
+        (sscanf(pMsgStr, TEST21_MARKER "%u %u", &thread, &msg) != 2))
+    {
+        gTest21Wrong++;
+        return;
+    }
+    (void) vos_snprintf(expected, sizeof(expected), TEST21_MARKER "%u %u %-6s|%04x|%lld\n",
+                        thread, msg, "abc", msg, (long long) msg * 1000000000000ll);
+    if (strcmp(pMsgStr, expected) != 0)
+    {
+        gTest21Wrong++;
+    }
+    gTest21Received++;
+}
+
+static void test21Logger (void *pArg)
+{
+    unsigned int    thread = (unsigned int) (size_t) pArg;
+    unsigned int    msg;
+
+    for (msg = 0u; msg < TEST21_MESSAGES; msg++)
+    {
+        vos_printLog(VOS_LOG_USR, TEST21_MARKER "%u %u %-6s|%04x|%lld\n",
+                     thread, msg, "abc", msg, (long long) msg * 1000000000000ll);
+    }
+    gTest21Done++;
+}
+
+static int test21 ()
+{
+    PREPARE1("Asynchronous log output"); /* allocates appHandle1, failed = 0, err = TRDP_NO_ERR */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        VOS_LOG_CONFIG_T        logConfig = {512u, VOS_LOG_DEFAULT_RATE};
+        VOS_LOG_STATISTICS_T    logStats;
+        VOS_THREAD_T            threads[TEST21_THREADS];
+        unsigned int            i;
+
+        gTest21Received = 0u;
+        gTest21Wrong    = 0u;
+        gTest21Done     = 0u;
+        (void) vos_threadSelf(&gTest21Caller);
+        gPDebugFunction = test21DbgOut;
+
+        err = (TRDP_ERR_T) vos_logStart(&logConfig);
+        IF_ERROR("vos_logStart");
+
+        fprintf(gFp, "->> pass 0: %u threads logging\n", TEST21_THREADS);
+        for (i = 0u; i < TEST21_THREADS; i++)
+        {
+            err = (TRDP_ERR_T) vos_threadCreate(&threads[i], "test21", VOS_THREAD_POLICY_OTHER,
+                                                VOS_THREAD_PRIORITY_DEFAULT, 0u, 0u,
+                                                test21Logger, (void *) (size_t) i);
+            IF_ERROR("vos_threadCreate");
+        }
+        for (i = 0u; (gTest21Done < TEST21_THREADS) && (i < 500u); i++)
+        {
+            vos_threadDelay(10000u);
+        }
+        vos_logStop();
+        gPDebugFunction = dbgOut;
+
+        err = (TRDP_ERR_T) vos_logGetStatistics(&logStats);
+        IF_ERROR("vos_logGetStatistics");
+        fprintf(gFp, "->> recorded %u, received %u, dropped %u\n",
+                logStats.numRecorded, gTest21Received, logStats.numDroppedFull);
+        if ((gTest21Done != TEST21_THREADS) || (gTest21Wrong != 0u) ||
+            (gTest21Received == 0u) || (gTest21Received + logStats.numDroppedFull != TEST21_THREADS * TEST21_MESSAGES))
+        {
+            FAILED("messages lost or garbled");
+        }
+
+        /* rate limit of the user category */
+        fprintf(gFp, "->> pass 1: rate limit\n");
+        logConfig.maxPerSecond[VOS_LOG_USR] = 10u;
+        gTest21Received = 0u;
+        gPDebugFunction = test21DbgOut;
+        err = (TRDP_ERR_T) vos_logStart(&logConfig);
+        IF_ERROR("vos_logStart");
+        test21Logger((void *) 0);
+        vos_logStop();
+        gPDebugFunction = dbgOut;
+        (void) vos_logGetStatistics(&logStats);
+        fprintf(gFp, "->> received %u, dropped by rate %u\n", gTest21Received, logStats.numDroppedRate[VOS_LOG_USR]);
+        if ((gTest21Wrong != 0u) || (gTest21Received != 10u) ||
+            (logStats.numDroppedRate[VOS_LOG_USR] != TEST21_MESSAGES - 10u))
+        {
+            FAILED("rate limit not applied");
+        }
+
+        /* precision of strings, a label need not be terminated: copying what follows it would not fit */
+        fprintf(gFp, "->> pass 2: string precision\n");
+        {
+            struct
+            {
+                CHAR8   text[4];
+                CHAR8   next[512];
+            } label;
+
+            memcpy(label.text, "abcd", sizeof(label.text));
+            memset(label.next, 'X', sizeof(label.next) - 1u);
+            label.next[sizeof(label.next) - 1u] = '\0';
+            gTest21Prec     = 0u;
+            gPDebugFunction = test21DbgOut;
+            err = (TRDP_ERR_T) vos_logStart(&logConfig);
+            IF_ERROR("vos_logStart");
+            vos_printLog(VOS_LOG_USR, TEST21_PREC_MARKER "%.*s|%.2s|%4.2s\n",
+                         (int) sizeof(label.text), label.text, "hello", "abc");
+            vos_logStop();
+            gPDebugFunction = dbgOut;
+        }
+        if ((gTest21Wrong != 0u) || (gTest21Prec != 1u))
+        {
+            FAILED("string precision not applied");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+
+
+/**********************************************************************************************************************/
+/** test22 PD timing statistics
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static void test22PDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pMsg;
+    (void) pData;
+    (void) dataSize;
+}
+
+static int test22 ()
+{
+    PREPARE("PD timing statistics", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_PD_TIMING_T    subTiming;
+        TRDP_PD_TIMING_T    pubTiming;
+        char                data1[32u];
+
+#define TEST22_COMID     1000u
+#define TEST22_INTERVAL  10000u
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL,  0u, TEST22_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST22_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, 0u);
+        IF_ERROR("tlp_publish");
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test22PDcallBack, 0u,
+                            TEST22_COMID, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                            TEST22_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        memset(data1, 0x55, sizeof(data1));
+        err = tlp_put(gSession1.appHandle, pubHandle, (UINT8 *) data1, sizeof(data1));
+        IF_ERROR("tlp_put");
+
+        usleep(500000u);
+
+        err = tlc_getSubsTiming(gSession2.appHandle, subHandle, &subTiming);
+        IF_ERROR("tlc_getSubsTiming");
+        err = tlc_getPubTiming(gSession1.appHandle, pubHandle, &pubTiming);
+        IF_ERROR("tlc_getPubTiming");
+
+        fprintf(gFp, "received %u, inter-arrival p50 %uus p99 %uus max %uus, late %u\n",
+                subTiming.interval.count,
+                tlc_getHistogramPercentile(&subTiming.interval, 500u),
+                tlc_getHistogramPercentile(&subTiming.interval, 990u),
+                subTiming.interval.max, subTiming.numLate);
+        fprintf(gFp, "callback latency p50 %uus max %uus\n",
+                tlc_getHistogramPercentile(&subTiming.latency, 500u), subTiming.latency.max);
+        fprintf(gFp, "sent %u, send jitter p50 %uus p99 %uus, overruns %u\n",
+                pubTiming.interval.count,
+                tlc_getHistogramPercentile(&pubTiming.interval, 500u),
+                tlc_getHistogramPercentile(&pubTiming.interval, 990u), pubTiming.numLate);
+
+        if ((subTiming.interval.count < 10u) || (pubTiming.interval.count < 10u))
+        {
+            FAILED("too few timing samples");
+        }
+        if (subTiming.latency.count != subTiming.interval.count + 1u)
+        {
+            FAILED("callback latency not recorded for every packet");
+        }
+        if ((tlc_getHistogramPercentile(&subTiming.interval, 1000u) != subTiming.interval.max) ||
+            (tlc_getHistogramPercentile(&subTiming.interval, 500u) < subTiming.interval.min))
+        {
+            FAILED("percentile out of range");
+        }
+        if (tlc_getSubsTiming(gSession2.appHandle, (TRDP_SUB_T) pubHandle, &subTiming) != TRDP_NOSUB_ERR)
+        {
+            FAILED("publisher accepted as subscriber");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test23 Shared memory traffic store
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST23_STORE     "/trdp_test23_ts"
+#define TEST23_COMID     1000u
+#define TEST23_SIZE      1024u
+#define TEST23_WRITES    200000u
+
+static TAU_TSTORE_T     gTest23Owner;
+static UINT32           gTest23Slot;
+static volatile UINT32  gTest23Done;
+
+static void test23Writer (void *pArg)
+{
+    UINT8   data[TEST23_SIZE];
+    UINT32  i;
+
+    (void) pArg;
+    for (i = 0u; i < TEST23_WRITES; i++)
+    {
+        memset(data, (int) (i & 0xFFu), sizeof(data));
+        (void) tau_tsWrite(gTest23Owner, gTest23Slot, NULL, data, sizeof(data));
+        if ((i % 16u) == 0u)
+        {
+            (void) vos_threadDelay(0u);
+        }
+    }
+    gTest23Done = 1u;
+}
+
+#if defined (POSIX)
+/* Reader in a second process: attaches by name and checks every copy until the writer's updates are done.
+   Exit status 0: ok, 1: torn read, 2: attach or read failed, 3: nothing read */
+static int test23Reader (UINT32 lastUpdate)
+{
+    TAU_TSTORE_T    reader;
+    TAU_TS_INFO_T   info;
+    UINT8           data[TEST23_SIZE];
+    UINT32          dataSize;
+    UINT32          slot;
+    UINT32          reads   = 0u;
+    UINT32          i;
+
+    if ((tau_tsAttach(&reader, TEST23_STORE) != TRDP_NO_ERR)
+        || (tau_tsFindSlot(reader, TEST23_COMID, 0u, &slot) != TRDP_NO_ERR))
+    {
+        return 2;
+    }
+    do
+    {
+        dataSize = sizeof(data);
+        if (tau_tsRead(reader, slot, &info, data, &dataSize) != TRDP_NO_ERR)
+        {
+            return 2;
+        }
+        reads++;
+        for (i = 1u; i < dataSize; i++)
+        {
+            if (data[i] != data[0])
+            {
+                return 1;
+            }
+        }
+    }
+    while (info.updates < lastUpdate);
+    (void) tau_tsClose(reader);
+    return (reads > 1u) ? 0 : 3;
+}
+#endif
+
+static int test23 ()
+{
+    PREPARE("Shared memory traffic store", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TAU_TSTORE_T    reader      = NULL;
+        TRDP_PUB_T      pubHandle;
+        TRDP_SUB_T      subHandle;
+        TAU_TS_INFO_T   info;
+        VOS_THREAD_T    thread;
+        UINT8           data[TEST23_SIZE];
+        UINT32          dataSize;
+        UINT32          slot;
+        UINT32          reads       = 0u;
+        UINT32          torn        = 0u;
+        UINT32          i;
+#if defined (POSIX)
+        pid_t           child;
+        int             status      = 0;
+#endif
+
+        gTest23Owner = NULL;
+        err = tau_tsCreate(&gTest23Owner, TEST23_STORE, 4u, TEST23_SIZE);
+        IF_ERROR("tau_tsCreate");
+        err = tau_tsAddSlot(gTest23Owner, TEST23_COMID, 0u, &gTest23Slot);
+        IF_ERROR("tau_tsAddSlot");
+        err = tau_tsAttach(&reader, TEST23_STORE);
+        IF_ERROR("tau_tsAttach");
+
+        fprintf(gFp, "->> pass 0: PD callback of the owner, reader mapping\n");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, 0u, TEST23_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, 10000u, 0u, TRDP_FLAGS_DEFAULT, NULL, 0u);
+        IF_ERROR("tlp_publish");
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, (const void *) gTest23Owner, tau_tsPdCallback, 0u,
+                            TEST23_COMID, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK,
+                            30000u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        memset(data, 0x55, 64u);
+        err = tlp_put(gSession1.appHandle, pubHandle, data, 64u);
+        IF_ERROR("tlp_put");
+        vos_threadDelay(100000u);
+
+        err = tau_tsFindSlot(reader, TEST23_COMID, 0u, &slot);
+        IF_ERROR("tau_tsFindSlot");
+        memset(data, 0, sizeof(data));
+        dataSize = sizeof(data);
+        err = tau_tsRead(reader, slot, &info, data, &dataSize);
+        IF_ERROR("tau_tsRead");
+        fprintf(gFp, "updates %u, size %u, seqCount %u, result %d\n",
+                info.updates, dataSize, info.seqCount, info.resultCode);
+        if ((info.updates == 0u) || (dataSize != 64u) || (data[0] != 0x55u) || (data[63] != 0x55u)
+            || (info.resultCode != TRDP_NO_ERR))
+        {
+            FAILED("received telegram not in store");
+        }
+        dataSize = 16u;
+        if ((tau_tsRead(reader, slot, NULL, data, &dataSize) != TRDP_PARAM_ERR) || (dataSize != 64u))
+        {
+            FAILED("small buffer accepted");
+        }
+        if ((tau_tsFindSlot(reader, TEST23_COMID + 1u, 0u, &slot) != TRDP_COMID_ERR)
+            || (tau_tsWrite(reader, gTest23Slot, NULL, data, 64u) != TRDP_PARAM_ERR))
+        {
+            FAILED("unknown ComId found or reader allowed to write");
+        }
+        (void) tlp_unsubscribe(gSession2.appHandle, subHandle);
+        (void) tlp_unpublish(gSession1.appHandle, pubHandle);
+
+        fprintf(gFp, "->> pass 1: consistency while the owner writes, read here and in a second process\n");
+#if defined (POSIX)
+        dataSize = sizeof(data);
+        err = tau_tsRead(reader, gTest23Slot, &info, data, &dataSize);
+        IF_ERROR("tau_tsRead");
+        fflush(NULL);
+        child = fork();
+        if (child == 0)
+        {
+            _exit(test23Reader(info.updates + TEST23_WRITES));
+        }
+        if (child < 0)
+        {
+            FAILED("fork");
+        }
+#endif
+        gTest23Done = 0u;
+        err = (TRDP_ERR_T) vos_threadCreate(&thread, "test23", VOS_THREAD_POLICY_OTHER,
+                                            VOS_THREAD_PRIORITY_DEFAULT, 0u, 0u, test23Writer, NULL);
+        IF_ERROR("vos_threadCreate");
+        while (gTest23Done == 0u)
+        {
+            dataSize = sizeof(data);
+            err = tau_tsRead(reader, gTest23Slot, NULL, data, &dataSize);
+            IF_ERROR("tau_tsRead");
+            reads++;
+            for (i = 1u; i < dataSize; i++)
+            {
+                if (data[i] != data[0])
+                {
+                    torn++;
+                    break;
+                }
+            }
+        }
+        fprintf(gFp, "%u reads, %u torn\n", reads, torn);
+        if (torn != 0u)
+        {
+            FAILED("torn read");
+        }
+#if defined (POSIX)
+        if ((waitpid(child, &status, 0) != child) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+        {
+            fprintf(gFp, "reader process status %d\n", status);
+            FAILED("second process");
+        }
+#endif
+
+        fprintf(gFp, "->> pass 2: owner closes\n");
+        (void) tau_tsClose(gTest23Owner);
+        gTest23Owner = NULL;
+        dataSize = sizeof(data);
+        if (tau_tsRead(reader, gTest23Slot, NULL, data, &dataSize) != TRDP_NOINIT_ERR)
+        {
+            FAILED("closed store still readable");
+        }
+        (void) tau_tsClose(reader);
+        if (tau_tsAttach(&reader, TEST23_STORE) != TRDP_IO_ERR)
+        {
+            FAILED("closed store still attachable");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test24 Kernel time stamps (TRDP_OPTION_TIMESTAMPING)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST24_COMID     1000u
+#define TEST24_INTERVAL  10000u
+
+static TRDP_PD_INFO_T   gTest24Info;
+static UINT32           gTest24Received;
+static UINT32           gTest24Future;
+
+static void test24PDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_TIME_T now;
+
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        vos_getTime(&now);
+        if (timercmp(&pMsg->rxTime, &now, >))
+        {
+            gTest24Future++;
+        }
+        gTest24Info = *pMsg;
+        gTest24Received++;
+    }
+}
+
+static int test24 ()
+{
+    TRDP_PROCESS_CONFIG_T processConfig = {"", "", "", 0u, 0u, TRDP_OPTION_TIMESTAMPING, 0u};
+
+    gpProcessConfig = &processConfig;
+    PREPARE("Kernel time stamps", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+    gpProcessConfig = NULL;
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_PD_TIMING_T    pubTiming;
+        TRDP_PD_INFO_T      pdInfo;
+        UINT8               data[32u];
+        UINT32              dataSize = sizeof(data);
+
+        gTest24Received = 0u;
+        gTest24Future   = 0u;
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, 0u, TEST24_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST24_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, 0u);
+        IF_ERROR("tlp_publish");
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test24PDcallBack, 0u,
+                            TEST24_COMID, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB,
+                            TEST24_INTERVAL * 3, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        memset(data, 0x55, sizeof(data));
+        err = tlp_put(gSession1.appHandle, pubHandle, data, sizeof(data));
+        IF_ERROR("tlp_put");
+
+        usleep(300000u);
+
+        err = tlp_get(gSession2.appHandle, subHandle, &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get");
+        err = tlc_getPubTiming(gSession1.appHandle, pubHandle, &pubTiming);
+        IF_ERROR("tlc_getPubTiming");
+
+        fprintf(gFp, "received %u, rx time source %u (tlp_get %u), %u in the future\n",
+                gTest24Received, gTest24Info.rxTimeSource, pdInfo.rxTimeSource, gTest24Future);
+        fprintf(gFp, "sent %u, tx stamps %u, tx latency p50 %uus max %uus\n",
+                pubTiming.interval.count + 1u, pubTiming.latency.count,
+                tlc_getHistogramPercentile(&pubTiming.latency, 500u), pubTiming.latency.max);
+
+        if (gTest24Received < 10u)
+        {
+            FAILED("too few packets");
+        }
+#ifdef __linux
+        if ((gTest24Info.rxTimeSource == TRDP_TIMESTAMP_APP) || (pdInfo.rxTimeSource != gTest24Info.rxTimeSource))
+        {
+            FAILED("no kernel receive time stamp");
+        }
+        if (pubTiming.latency.count < pubTiming.interval.count / 2u)
+        {
+            FAILED("transmit time stamps missing");
+        }
+#endif
+        if ((gTest24Future != 0u) || !timerisset(&pdInfo.rxTime))
+        {
+            FAILED("receive time out of range");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+
+    CLEANUP;
+}
 
 /**********************************************************************************************************************/
 /* This array holds pointers to the m-th test (m = 1 will execute test1...)                                           */
@@ -2272,6 +3189,12 @@ test_func_t *testArray[] =
     test16,     /* MD Request - Reply / UDP */
     test17,     /* CRC */
     test18,     /* XML stream */
+    test19,     /* MD request completion queue */
+    test20,     /* XML configuration cache */
+    test21,     /* Asynchronous log output */
+    test22,     /* PD timing statistics */
+    test23,     /* Shared memory traffic store */
+    test24,     /* Kernel time stamps */
     NULL
 };
 
@@ -1405,6 +1405,26 @@ static int test3()
 
         IF_ERROR("tau_getTTI");
 
+        /* the received consist info must be in the snapshot as well */
+        {
+            const TAU_TTI_SNAPSHOT_T    *pSnapshot = tau_acquireTTISnapshot(gSession1.appHandle);
+            const TRDP_CONSIST_INFO_T   *pSnapCstInfo;
+            TRDP_LABEL_T                cstLabel;
+
+            memset(cstLabel, 0, sizeof(cstLabel));
+            vos_strncpy(cstLabel, CST_1_ID, sizeof(cstLabel) - 1u);
+            pSnapCstInfo = tau_findCstInfoByLabel(pSnapshot, cstLabel);
+
+            if ((pSnapCstInfo == NULL) ||
+                (tau_findCstInfoByUUID(pSnapshot, pSnapCstInfo->cstUUID) != pSnapCstInfo) ||
+                (memcmp(pSnapCstInfo->cstUUID, pConsistInfo->cstUUID, sizeof(TRDP_UUID_T)) != 0))
+            {
+                tau_releaseTTISnapshot(gSession1.appHandle, pSnapshot);
+                FAILED("consist info not found in TTI snapshot")
+            }
+            tau_releaseTTISnapshot(gSession1.appHandle, pSnapshot);
+        }
+
         if ((0x04u | 0x08u) != callbackFlags)
         {
             FAILED("incorrect or not all required callbacks triggered")
@@ -1909,6 +1929,104 @@ static int test6 ()
     CLEANUP;
 
 }
+/**********************************************************************************************************************/
+/** test7
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test7 ()
+{
+    PREPARE("DNR: non-blocking resolution and negative caching", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST7_URI_KNOWN     "devKnown.car01.lCst.lClTrn.lTrn"
+#define TEST7_URI_UNKNOWN   "devUnknown.car01.lCst.lClTrn.lTrn"
+#define TEST7_IP_ADDRESS    (0x0A000107u)
+
+        TRDP_LIS_T          dnsListener;
+        TRDP_IP_ADDR_T      testIpAddr;
+        TRDP_DNS_REPLY_T    dnsReply;
+        TRDP_URI_T          uriKnown;
+        TRDP_URI_T          uriUnknown;
+        VOS_TIMEVAL_T       start, end;
+        const VOS_TIMEVAL_T maxTime = {0, 10000};
+        int                 i;
+
+        memset(uriKnown, 0, sizeof(uriKnown));
+        memset(uriUnknown, 0, sizeof(uriUnknown));
+        vos_strncpy(uriKnown, TEST7_URI_KNOWN, sizeof(uriKnown) - 1u);
+        vos_strncpy(uriUnknown, TEST7_URI_UNKNOWN, sizeof(uriUnknown) - 1u);
+
+        memset(&dnsReply, 0, sizeof(dnsReply));
+        dnsReply.version.ver = 1;
+        vos_strncpy(dnsReply.deviceName, "testDns", sizeof(dnsReply.deviceName));
+        dnsReply.tcnUriCnt    = 2u;
+
+        vos_strncpy(dnsReply.tcnUriList[0].tcnUriStr, TEST7_URI_KNOWN, TRDP_MAX_URI_HOST_LEN - 1);
+        dnsReply.tcnUriList[0].tcnUriIpAddr  = vos_htonl(TEST7_IP_ADDRESS);
+        vos_strncpy(dnsReply.tcnUriList[1].tcnUriStr, TEST7_URI_UNKNOWN, TRDP_MAX_URI_HOST_LEN - 1);
+        dnsReply.tcnUriList[1].resolvState   = -1;
+
+        err = tlm_addListener(gSession1.appHandle, &dnsListener, (UINT8 *)&dnsReply, dnsMdCallback,
+                              TRUE, TCN_DNS_REQ_COMID, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("adding Listener");
+
+        err = tau_initDnr(gSession2.appHandle, gSession1.ifaceIP, 0, NULL, TRDP_DNR_COMMON_THREAD, FALSE);
+        IF_ERROR("tau_initDnr");
+
+        /* The first call must not wait for the name server */
+        err = tau_uri2AddrNoWait(gSession2.appHandle, &testIpAddr, uriKnown);
+        if (err != TRDP_BLOCK_ERR)
+        {
+            FAILED("tau_uri2AddrNoWait did not return TRDP_BLOCK_ERR");
+        }
+
+        for (i = 0; (i < 200) && (err == TRDP_BLOCK_ERR); i++)
+        {
+            vos_threadDelay(10000u);
+            err = tau_uri2AddrNoWait(gSession2.appHandle, &testIpAddr, uriKnown);
+        }
+        IF_ERROR("translating URI in the background");
+        if (testIpAddr != TEST7_IP_ADDRESS)
+        {
+            FAILED("resolved wrong address");
+        }
+        fprintf(gFp, "resolved %s after %d polls\n", TEST7_URI_KNOWN, i);
+
+        /* An unknown URI fails once ... */
+        err = tau_uri2Addr(gSession2.appHandle, &testIpAddr, uriUnknown);
+        if (err != TRDP_UNRESOLVED_ERR)
+        {
+            FAILED("unknown URI was resolved");
+        }
+
+        /* ... and is then answered from the cache */
+        vos_getTime(&start);
+        err = tau_uri2Addr(gSession2.appHandle, &testIpAddr, uriUnknown);
+        vos_getTime(&end);
+        vos_subTime(&end, &start);
+        if (err != TRDP_UNRESOLVED_ERR)
+        {
+            FAILED("unknown URI was resolved");
+        }
+        if (vos_cmpTime(&end, &maxTime) > 0)
+        {
+            FAILED("unknown URI was asked for again");
+        }
+        err = TRDP_NO_ERR;
+
+        tau_deInitDnr(gSession2.appHandle);
+        (void) tlm_delListener(gSession1.appHandle, dnsListener);
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
 /**********************************************************************************************************************/
 /* This array holds pointers to the m-th test (m = 1 will execute test2...)                                           */
 /**********************************************************************************************************************/
@@ -1920,7 +2038,7 @@ test_func_t *testArray[] = {
     test4, /* Ticket #356: PD: Conflicting tau_ctrl_types packed definitions with marshalling */
     test5, /* Ticket #347: Allow dynamic sized arrays for PD */
 	test6,  /* Ticket #355: Redundancy group shall not send directly after publish but only after group is set to leader */
-    NULL,  /*  */
+    test7,  /* DNR: non-blocking resolution and negative caching */
     NULL,  /*  */
     NULL,  /*  */
     NULL,  /*  */
@@ -324,25 +324,10 @@ static void freeParameters()
         free(pIfConfig);
         pIfConfig = NULL; numIfConfig = 0;
     }
-    if (pComIdDsIdMap)
-    {
-        free(pComIdDsIdMap);
-        pComIdDsIdMap = NULL; numComId = 0;
-    }
-    if (apDataset)
-    {
-        /*  Free dataset structures */
-        pTRDP_DATASET_T pDataset;
-        UINT32 i;
-        for (i=0; i < numDataset; i++)
-        {
-            pDataset = apDataset[i];
-            free(pDataset);
-        }
-        /*  Free array of pointers to dataset structures    */
-        free(apDataset);
-        apDataset = NULL; numDataset = 0;
-    }
+    /*  Dataset configuration is released with the document */
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    pComIdDsIdMap = NULL; numComId = 0;
+    apDataset = NULL; numDataset = 0;
 }
 
 /*********************************************************************************************************************/
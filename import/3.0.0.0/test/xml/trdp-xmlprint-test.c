@@ -43,15 +43,17 @@
 ***********************************************************************************************************************/
 static void printProcessConfig(TRDP_PROCESS_CONFIG_T  * pProcessConfig)
 {
-    UINT32  procOptions[2] = {TRDP_OPTION_BLOCK, TRDP_OPTION_TRAFFIC_SHAPING};
-    const char * strProcOptions[2] = {"TRDP_OPTION_BLOCK", "TRDP_OPTION_TRAFFIC_SHAPING"};
+    UINT32  procOptions[4] = {TRDP_OPTION_BLOCK, TRDP_OPTION_TRAFFIC_SHAPING, TRDP_OPTION_TIMESTAMPING,
+                              TRDP_OPTION_TXTIME};
+    const char * strProcOptions[4] = {"TRDP_OPTION_BLOCK", "TRDP_OPTION_TRAFFIC_SHAPING", "TRDP_OPTION_TIMESTAMPING",
+                                      "TRDP_OPTION_TXTIME"};
     UINT32  i;
     printf("  Process (session) configuration\n");
     printf("    Host: %s, Leader: %s Type: %s\n", pProcessConfig->hostName, pProcessConfig->leaderName, pProcessConfig->type);
     printf("    Priority: %u, CycleTime: %u\n",
         pProcessConfig->priority, pProcessConfig->cycleTime);
     printf("    Options:");
-    for (i=0; i < 2; i++)
+    for (i=0; i < 4; i++)
         if (pProcessConfig->options & procOptions[i])
             printf(" %s", strProcOptions[i]);
     printf("\n");
@@ -502,6 +504,11 @@ int main(int argc, char * argv[])
         }
     }
 
+    /*  Free dataset configuration, released with the document */
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    pComIdDsIdMap = NULL; numComId = 0;
+    apDataset = NULL; numDataset = 0;
+
     /*  Free parsed document    */
     tau_freeXmlDoc(&docHandle);
 
@@ -516,25 +523,6 @@ int main(int argc, char * argv[])
         free(pIfConfig);
         pIfConfig = NULL; numIfConfig = 0;
     }
-    if (pComIdDsIdMap)
-    {
-        free(pComIdDsIdMap);
-        pComIdDsIdMap = NULL; numComId = 0;
-    }
-    if (apDataset)
-    {
-        /*  Free dataset structures */
-        pTRDP_DATASET_T pDataset;
-        UINT32 i;
-        for (i=0; i < numDataset; i++)
-        {
-            pDataset = apDataset[i];
-            free(pDataset);
-        }
-        /*  Free array of pointers to dataset structures    */
-        free(apDataset);
-        apDataset = NULL; numDataset = 0;
-    }
 
     return 0;
 }
@@ -256,7 +256,11 @@ namespace crow
                 }
                 if (complete_request_handler_)
                 {
-                    complete_request_handler_();
+                    // The handler holds the connection (and so this response). Keep it alive until we are done
+                    // here: when the response is completed later, outside the route handler, it is the last owner.
+                    auto handler = std::move(complete_request_handler_);
+                    complete_request_handler_ = nullptr;
+                    handler();
                     manual_length_header = false;
                     skip_body = false;
                 }
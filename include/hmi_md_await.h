@@ -0,0 +1,211 @@
+#ifndef HMI_MD_AWAIT_H
+#define HMI_MD_AWAIT_H
+
+/*
+ * C++20 coroutine facade over TRDP MD request/reply
+ *
+ *   MdResult r = co_await MdRequest(appHandle, comId, destIp, &req, sizeof(req));
+ *
+ * The awaiter sends the request with tlm_request() and suspends. The TRDP
+ * thread resumes it from inside tlc_process(), when the MD session ends:
+ *   - the last expected reply arrived (aboutToDie),
+ *   - the reply timeout expired (TRDP_REPLYTO_ERR), or
+ *   - some other error was reported by the stack.
+ * A replyTimeout of 0 uses the session default (TRDP_MD_CONFIG_T.replyTimeout).
+ * With numReplies == 0 (unknown number of repliers) the session always ends
+ * with TRDP_REPLYTO_ERR; the replies collected until then are still returned.
+ * Reply-queries (Mq) are confirmed automatically with userStatus 0.
+ *
+ * A pending request costs one coroutine frame, not a thread, so thousands of
+ * requests can be in flight at once (bounded by the TRDP memory pool).
+ *
+ * Threading:
+ *   - co_await may be issued from any thread, the coroutine continues on the
+ *     TRDP thread with the session locked, like an MD callback. Do not block
+ *     there; hand results to other threads (e.g. via std::promise).
+ *   - pUserRef is a call id, not a pointer: events of a session arriving after
+ *     its coroutine was resumed are dropped instead of touching a dead frame.
+ */
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hmi_trdp.h"
+
+/* ===================================================================
+ * Results
+ * =================================================================== */
+struct MdReply
+{
+    TRDP_MD_INFO_T       info;      /* as passed to an MD callback    */
+    std::vector<uint8_t> data;      /* copy of the reply payload      */
+};
+
+struct MdResult
+{
+    TRDP_ERR_T           err = TRDP_NO_ERR;
+    std::vector<MdReply> replies;
+};
+
+/* ===================================================================
+ * Detached coroutine: starts at once, frees its frame when done
+ * =================================================================== */
+struct MdTask
+{
+    struct promise_type
+    {
+        MdTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/* ===================================================================
+ * Awaitable MD request
+ * =================================================================== */
+class MdRequest
+{
+public:
+    MdRequest(TRDP_APP_SESSION_T appHandle,
+              UINT32 comId,
+              TRDP_IP_ADDR_T destIpAddr,
+              const void *pData,
+              UINT32 dataSize,
+              UINT32 numReplies = 1u,
+              UINT32 replyTimeout = 0u,
+              TRDP_FLAGS_T pktFlags = TRDP_FLAGS_CALLBACK)
+        : m_appHandle(appHandle), m_comId(comId), m_destIpAddr(destIpAddr),
+          m_pData(static_cast<const UINT8 *>(pData)), m_dataSize(dataSize),
+          m_numReplies(numReplies), m_replyTimeout(replyTimeout),
+          m_pktFlags(static_cast<TRDP_FLAGS_T>(pktFlags | TRDP_FLAGS_CALLBACK))
+    {
+    }
+
+    MdRequest(const MdRequest &) = delete;
+    MdRequest &operator=(const MdRequest &) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        m_handle = handle;
+        const uintptr_t callId = attach(this);
+        TRDP_UUID_T sessionId;
+
+        TRDP_ERR_T err = tlm_request(m_appHandle, reinterpret_cast<const void *>(callId), md_cb,
+                                     &sessionId, m_comId, 0u, 0u, 0u, m_destIpAddr,
+                                     m_pktFlags, m_numReplies, m_replyTimeout, nullptr,
+                                     m_pData, m_dataSize, nullptr, nullptr);
+        if (err != TRDP_NO_ERR)
+        {
+            detach(callId);
+            m_result.err = err;
+            return false;           /* continue without suspending */
+        }
+        /* From here on the TRDP thread may already have resumed us: don't touch *this */
+        return true;
+    }
+
+    MdResult await_resume() noexcept { return std::move(m_result); }
+
+private:
+    /* --- call id registry, shared by all requests --- */
+    static std::mutex &registry_mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    static std::unordered_map<uintptr_t, MdRequest *> &registry()
+    {
+        static std::unordered_map<uintptr_t, MdRequest *> r;
+        return r;
+    }
+
+    static uintptr_t attach(MdRequest *pReq)
+    {
+        static uintptr_t nextId = 0u;
+        std::lock_guard<std::mutex> lk(registry_mutex());
+        uintptr_t id = ++nextId;
+        if (id == 0u) id = ++nextId;    /* 0 would be read as "no user ref" */
+        registry().emplace(id, pReq);
+        return id;
+    }
+
+    static MdRequest *lookup(uintptr_t id)
+    {
+        std::lock_guard<std::mutex> lk(registry_mutex());
+        auto it = registry().find(id);
+        return (it != registry().end()) ? it->second : nullptr;
+    }
+
+    static void detach(uintptr_t id)
+    {
+        std::lock_guard<std::mutex> lk(registry_mutex());
+        registry().erase(id);
+    }
+
+    /* --- runs in the TRDP thread, inside tlc_process() --- */
+    static void md_cb(void *pRefCon,
+                      TRDP_APP_SESSION_T appHandle,
+                      const TRDP_MD_INFO_T *pMsg,
+                      UINT8 *pData,
+                      UINT32 dataSize)
+    {
+        (void)pRefCon;
+        const uintptr_t callId = reinterpret_cast<uintptr_t>(pMsg->pUserRef);
+        MdRequest *self = lookup(callId);
+        if (self == nullptr)
+            return;                 /* already resumed (or never ours) */
+
+        bool done = (pMsg->aboutToDie == TRUE) || (pMsg->resultCode != TRDP_NO_ERR);
+
+        if (pMsg->resultCode != TRDP_NO_ERR)
+        {
+            self->m_result.err = pMsg->resultCode;
+        }
+        else if (pMsg->msgType == TRDP_MSG_MP || pMsg->msgType == TRDP_MSG_MQ)
+        {
+            MdReply reply;
+            reply.info = *pMsg;
+            if (pData != nullptr && dataSize > 0u)
+                reply.data.assign(pData, pData + dataSize);
+            self->m_result.replies.push_back(std::move(reply));
+
+            if (pMsg->msgType == TRDP_MSG_MQ)
+            {
+                (void)tlm_confirm(appHandle, &pMsg->sessionId, 0u, nullptr);
+                /* A confirmed session ends silently, so count the replies ourselves */
+                if (self->m_numReplies != 0u &&
+                    self->m_result.replies.size() >= self->m_numReplies)
+                    done = true;
+            }
+        }
+
+        if (done)
+        {
+            detach(callId);
+            self->m_handle.resume();
+        }
+    }
+
+    TRDP_APP_SESSION_T       m_appHandle;
+    UINT32                   m_comId;
+    TRDP_IP_ADDR_T           m_destIpAddr;
+    const UINT8             *m_pData;
+    UINT32                   m_dataSize;
+    UINT32                   m_numReplies;
+    UINT32                   m_replyTimeout;
+    TRDP_FLAGS_T             m_pktFlags;
+    std::coroutine_handle<>  m_handle;
+    MdResult                 m_result;
+};
+
+#endif /* HMI_MD_AWAIT_H */
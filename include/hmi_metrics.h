@@ -0,0 +1,371 @@
+#ifndef HMI_METRICS_H
+#define HMI_METRICS_H
+
+/*
+ * Prometheus / OpenMetrics export of TRDP statistics (GET /metrics)
+ *
+ * The TRDP thread calls MetricsStore::refresh() every HMI_METRICS_REFRESH_US.
+ * It copies tlc_getStatistics() (including the vos_memCount() pool usage),
+ * tlc_getSubsStatistics(), tlc_getPubStatistics() and the timing histograms
+ * of the watched telegrams into an immutable snapshot and publishes it
+ * through an atomic shared_ptr.
+ *
+ * Threading:
+ *   - refresh() and watch*() run on the TRDP thread only.
+ *   - render() may run on any web thread. It reads the last published
+ *     snapshot and never calls into the TRDP stack, so a scrape never waits
+ *     for a TRDP session mutex, and TRDP never waits for a scrape.
+ *   - The loop cycle and web request histograms are updated with relaxed
+ *     atomics from their own threads.
+ *   - Without std::atomic<std::shared_ptr> (libstdc++ < 12) the snapshot
+ *     pointer is swapped under a store-local mutex, held only for the copy.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hmi_trdp.h"
+
+#define HMI_METRICS_REFRESH_US      1000000u /* 1 s - TRDP statistics snapshot period */
+
+/* ===================================================================
+ * Fixed-bucket latency histogram (Prometheus cumulative buckets)
+ * =================================================================== */
+class LatencyHistogram
+{
+public:
+    /* Upper bucket bounds in us; the +Inf bucket is implicit */
+    static constexpr std::array<uint64_t, 12> kBoundsUs = {
+        100u, 250u, 500u, 1000u, 2500u, 5000u, 10000u, 25000u,
+        50000u, 100000u, 250000u, 1000000u
+    };
+
+    void observe(uint64_t us)
+    {
+        size_t i = 0u;
+        while (i < kBoundsUs.size() && us > kBoundsUs[i])
+            ++i;
+        counts_[i].fetch_add(1u, std::memory_order_relaxed);
+        sumUs_.fetch_add(us, std::memory_order_relaxed);
+    }
+
+    void render(std::ostringstream &out, const char *name, const char *help) const
+    {
+        out << "# HELP " << name << " " << help << "\n"
+            << "# TYPE " << name << " histogram\n";
+        renderSeries(out, name, "");
+    }
+
+    /* Samples only, for one labelled series of a family (labels: e.g. "path=\"x\",") */
+    void renderSeries(std::ostringstream &out, const char *name, const std::string &labels) const
+    {
+        uint64_t cumulative = 0u;
+        for (size_t i = 0u; i <= kBoundsUs.size(); ++i)
+        {
+            cumulative += counts_[i].load(std::memory_order_relaxed);
+            out << name << "_bucket{" << labels << "le=\"";
+            if (i < kBoundsUs.size())
+                out << static_cast<double>(kBoundsUs[i]) / 1e6;
+            else
+                out << "+Inf";
+            out << "\"} " << cumulative << "\n";
+        }
+        const std::string sel = labels.empty() ? std::string() : "{" + labels.substr(0u, labels.size() - 1u) + "}";
+        out << name << "_sum" << sel << " " << static_cast<double>(sumUs_.load(std::memory_order_relaxed)) / 1e6 << "\n"
+            << name << "_count" << sel << " " << cumulative << "\n";
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBoundsUs.size() + 1u> counts_{};
+    std::atomic<uint64_t> sumUs_{0u};
+};
+
+/* ===================================================================
+ * Snapshot of the TRDP statistics (immutable once published)
+ * =================================================================== */
+struct TrdpMetricsSnapshot
+{
+    struct Timing
+    {
+        UINT32           comId;
+        std::string      tag;
+        bool             isSub;
+        TRDP_PD_TIMING_T timing;
+    };
+
+    std::chrono::steady_clock::time_point    taken;
+    TRDP_STATISTICS_T                        stats;
+    std::vector<TRDP_SUBS_STATISTICS_T>      subs;
+    std::vector<TRDP_PUB_STATISTICS_T>       pubs;
+    std::vector<Timing>                      timings;
+};
+
+/* ===================================================================
+ * Metrics store
+ * =================================================================== */
+class MetricsStore
+{
+public:
+    LatencyHistogram loopCycle;     /* period of the TRDP loop            */
+    LatencyHistogram webRequest;    /* duration of the Crow route handlers */
+
+    /* Export the timing histograms of a telegram (TRDP thread, before the loop) */
+    void watchSubscription(TRDP_SUB_T handle, UINT32 comId, const char *tag)
+    {
+        watched_.push_back({handle, nullptr, comId, tag});
+    }
+
+    void watchPublication(TRDP_PUB_T handle, UINT32 comId, const char *tag)
+    {
+        watched_.push_back({nullptr, handle, comId, tag});
+    }
+
+    /* Take a new snapshot (TRDP thread) */
+    void refresh(TRDP_APP_SESSION_T appHandle)
+    {
+        auto snap = std::make_shared<TrdpMetricsSnapshot>();
+        snap->taken = std::chrono::steady_clock::now();
+        if (tlc_getStatistics(appHandle, &snap->stats) != TRDP_NO_ERR)
+            return;
+
+        snap->subs.resize(snap->stats.pd.numSubs);
+        if (!snap->subs.empty())
+        {
+            UINT16 num = static_cast<UINT16>(snap->subs.size());
+            if (tlc_getSubsStatistics(appHandle, &num, snap->subs.data()) == TRDP_PARAM_ERR)
+                num = 0u;
+            snap->subs.resize(num);
+        }
+        snap->pubs.resize(snap->stats.pd.numPub);
+        if (!snap->pubs.empty())
+        {
+            UINT16 num = static_cast<UINT16>(snap->pubs.size());
+            if (tlc_getPubStatistics(appHandle, &num, snap->pubs.data()) == TRDP_PARAM_ERR)
+                num = 0u;
+            snap->pubs.resize(num);
+        }
+
+        for (const Watched &w : watched_)
+        {
+            TrdpMetricsSnapshot::Timing t{w.comId, w.tag, w.sub != nullptr, {}};
+            TRDP_ERR_T err = t.isSub ? tlc_getSubsTiming(appHandle, w.sub, &t.timing)
+                                     : tlc_getPubTiming(appHandle, w.pub, &t.timing);
+            if (err == TRDP_NO_ERR)
+                snap->timings.push_back(std::move(t));
+        }
+
+        publish(std::move(snap));
+    }
+
+    /* Drop the snapshot when the session closes (TRDP thread) */
+    void clear()
+    {
+        publish(nullptr);
+        watched_.clear();
+    }
+
+    /* Render the Prometheus text format (any thread) */
+    std::string render() const
+    {
+        std::shared_ptr<const TrdpMetricsSnapshot> snap = current();
+        std::ostringstream out;
+
+        out << "# HELP hmi_trdp_up TRDP session running and statistics available\n"
+            << "# TYPE hmi_trdp_up gauge\n"
+            << "hmi_trdp_up " << (snap ? 1 : 0) << "\n";
+        if (snap)
+            renderSnapshot(out, *snap);
+
+        loopCycle.render(out, "hmi_trdp_loop_cycle_seconds", "Period of the TRDP processing loop");
+        webRequest.render(out, "hmi_web_request_duration_seconds", "Time to handle an HTTP request");
+        return out.str();
+    }
+
+private:
+    struct Watched
+    {
+        TRDP_SUB_T  sub;
+        TRDP_PUB_T  pub;
+        UINT32      comId;
+        const char *tag;
+    };
+
+    /* vos_ipDotted() uses a static buffer, not safe on the web threads */
+    static std::string ipLabel(TRDP_IP_ADDR_T ip)
+    {
+        return std::to_string(ip >> 24) + "." + std::to_string((ip >> 16) & 0xFFu) + "." +
+               std::to_string((ip >> 8) & 0xFFu) + "." + std::to_string(ip & 0xFFu);
+    }
+
+    static void metric(std::ostringstream &out, const char *name, const char *type, const char *help)
+    {
+        out << "# HELP " << name << " " << help << "\n"
+            << "# TYPE " << name << " " << type << "\n";
+    }
+
+    static void quantiles(std::ostringstream &out, const char *name, const TrdpMetricsSnapshot::Timing &t,
+                          const TRDP_HISTOGRAM_T &hist)
+    {
+        static const UINT32 permille[] = {500u, 990u, 1000u};
+        if (hist.count == 0u)
+            return;
+        for (UINT32 p : permille)
+        {
+            out << name << "{comid=\"" << t.comId << "\",tag=\"" << t.tag
+                << "\",quantile=\"" << static_cast<double>(p) / 1000.0 << "\"} "
+                << static_cast<double>(tlc_getHistogramPercentile(&hist, p)) / 1e6 << "\n";
+        }
+        out << name << "_sum{comid=\"" << t.comId << "\",tag=\"" << t.tag << "\"} "
+            << static_cast<double>(hist.sum) / 1e6 << "\n"
+            << name << "_count{comid=\"" << t.comId << "\",tag=\"" << t.tag << "\"} " << hist.count << "\n";
+    }
+
+    static void renderSnapshot(std::ostringstream &out, const TrdpMetricsSnapshot &s)
+    {
+        const double age = std::chrono::duration<double>(std::chrono::steady_clock::now() - s.taken).count();
+
+        metric(out, "hmi_trdp_snapshot_age_seconds", "gauge", "Age of the TRDP statistics snapshot");
+        out << "hmi_trdp_snapshot_age_seconds " << age << "\n";
+        metric(out, "hmi_trdp_uptime_seconds", "gauge", "Time since TRDP initialisation");
+        out << "hmi_trdp_uptime_seconds " << s.stats.upTime << "\n";
+
+        /* --- Session PD counters --- */
+        const struct { const char *name; const char *help; UINT32 value; } pd[] = {
+            {"hmi_trdp_pd_received_total",        "Received PD packets",                        s.stats.pd.numRcv},
+            {"hmi_trdp_pd_sent_total",            "Sent PD packets",                            s.stats.pd.numSend},
+            {"hmi_trdp_pd_crc_errors_total",      "Received PD packets with CRC error",         s.stats.pd.numCrcErr},
+            {"hmi_trdp_pd_protocol_errors_total", "Received PD packets with protocol error",    s.stats.pd.numProtErr},
+            {"hmi_trdp_pd_topo_errors_total",     "Received PD packets with wrong topo count",  s.stats.pd.numTopoErr},
+            {"hmi_trdp_pd_no_subscriber_total",   "Received PD packets without subscription",   s.stats.pd.numNoSubs},
+            {"hmi_trdp_pd_no_publisher_total",    "Received PD pull requests without publisher", s.stats.pd.numNoPub},
+            {"hmi_trdp_pd_timeouts_total",        "PD subscription timeouts",                   s.stats.pd.numTimeout},
+            {"hmi_trdp_pd_missed_total",          "PD packets skipped (sequence counter gaps)", s.stats.pd.numMissed},
+        };
+        for (const auto &c : pd)
+        {
+            metric(out, c.name, "counter", c.help);
+            out << c.name << " " << c.value << "\n";
+        }
+
+        /* --- Session MD counters, UDP and TCP --- */
+        const struct { const char *name; const char *help; UINT32 TRDP_MD_STATISTICS_T::*field; } md[] = {
+            {"hmi_trdp_md_received_total",         "Received MD packets",                        &TRDP_MD_STATISTICS_T::numRcv},
+            {"hmi_trdp_md_sent_total",             "Sent MD packets",                            &TRDP_MD_STATISTICS_T::numSend},
+            {"hmi_trdp_md_crc_errors_total",       "Received MD packets with CRC error",         &TRDP_MD_STATISTICS_T::numCrcErr},
+            {"hmi_trdp_md_protocol_errors_total",  "Received MD packets with protocol error",    &TRDP_MD_STATISTICS_T::numProtErr},
+            {"hmi_trdp_md_topo_errors_total",      "Received MD packets with wrong topo count",  &TRDP_MD_STATISTICS_T::numTopoErr},
+            {"hmi_trdp_md_no_listener_total",      "Received MD packets without listener",       &TRDP_MD_STATISTICS_T::numNoListener},
+            {"hmi_trdp_md_reply_timeouts_total",   "MD reply timeouts",                          &TRDP_MD_STATISTICS_T::numReplyTimeout},
+            {"hmi_trdp_md_confirm_timeouts_total", "MD confirm timeouts",                        &TRDP_MD_STATISTICS_T::numConfirmTimeout},
+        };
+        for (const auto &c : md)
+        {
+            metric(out, c.name, "counter", c.help);
+            out << c.name << "{transport=\"udp\"} " << s.stats.udpMd.*c.field << "\n"
+                << c.name << "{transport=\"tcp\"} " << s.stats.tcpMd.*c.field << "\n";
+        }
+
+        /* --- Memory pool (vos_memCount) --- */
+        metric(out, "hmi_trdp_mem_total_bytes", "gauge", "Size of the TRDP memory area");
+        out << "hmi_trdp_mem_total_bytes " << s.stats.mem.total << "\n";
+        metric(out, "hmi_trdp_mem_free_bytes", "gauge", "Free TRDP memory");
+        out << "hmi_trdp_mem_free_bytes " << s.stats.mem.free << "\n";
+        metric(out, "hmi_trdp_mem_min_free_bytes", "gauge", "Lowest free TRDP memory since start");
+        out << "hmi_trdp_mem_min_free_bytes " << s.stats.mem.minFree << "\n";
+        metric(out, "hmi_trdp_mem_allocated_blocks", "gauge", "Allocated TRDP memory blocks");
+        out << "hmi_trdp_mem_allocated_blocks " << s.stats.mem.numAllocBlocks << "\n";
+        metric(out, "hmi_trdp_mem_alloc_errors_total", "counter", "Failed TRDP memory allocations");
+        out << "hmi_trdp_mem_alloc_errors_total " << s.stats.mem.numAllocErr << "\n";
+        metric(out, "hmi_trdp_mem_free_errors_total", "counter", "Failed TRDP memory releases");
+        out << "hmi_trdp_mem_free_errors_total " << s.stats.mem.numFreeErr << "\n";
+        metric(out, "hmi_trdp_mem_used_blocks", "gauge", "Used TRDP memory blocks per block size");
+        for (UINT32 i = 0u; i < VOS_MEM_NBLOCKSIZES; ++i)
+        {
+            if (s.stats.mem.blockSize[i] != 0u)
+                out << "hmi_trdp_mem_used_blocks{size=\"" << s.stats.mem.blockSize[i] << "\"} "
+                    << s.stats.mem.usedBlockSize[i] << "\n";
+        }
+
+        /* --- Per subscription / publisher counters --- */
+        metric(out, "hmi_trdp_sub_received_total", "counter", "PD packets received per subscription");
+        for (const auto &sub : s.subs)
+            out << "hmi_trdp_sub_received_total{comid=\"" << sub.comId << "\",joined=\"" << ipLabel(sub.joinedAddr)
+                << "\",filter=\"" << ipLabel(sub.filterAddr) << "\"} " << sub.numRecv << "\n";
+        metric(out, "hmi_trdp_sub_missed_total", "counter", "PD packets skipped per subscription");
+        for (const auto &sub : s.subs)
+            out << "hmi_trdp_sub_missed_total{comid=\"" << sub.comId << "\",joined=\"" << ipLabel(sub.joinedAddr)
+                << "\",filter=\"" << ipLabel(sub.filterAddr) << "\"} " << sub.numMissed << "\n";
+        metric(out, "hmi_trdp_sub_status", "gauge", "Last receive status per subscription (0 = ok, TRDP_ERR_T)");
+        for (const auto &sub : s.subs)
+            out << "hmi_trdp_sub_status{comid=\"" << sub.comId << "\",joined=\"" << ipLabel(sub.joinedAddr)
+                << "\",filter=\"" << ipLabel(sub.filterAddr) << "\"} " << static_cast<INT32>(sub.status) << "\n";
+        metric(out, "hmi_trdp_pub_sent_total", "counter", "PD packets sent per publisher");
+        for (const auto &pub : s.pubs)
+            out << "hmi_trdp_pub_sent_total{comid=\"" << pub.comId << "\",dest=\"" << ipLabel(pub.destAddr)
+                << "\"} " << pub.numSend << "\n";
+        metric(out, "hmi_trdp_pub_put_total", "counter", "PD data updates per publisher");
+        for (const auto &pub : s.pubs)
+            out << "hmi_trdp_pub_put_total{comid=\"" << pub.comId << "\",dest=\"" << ipLabel(pub.destAddr)
+                << "\"} " << pub.numPut << "\n";
+
+        /* --- Timing of the watched telegrams --- */
+        metric(out, "hmi_trdp_sub_interarrival_seconds", "summary", "PD inter-arrival time quantiles");
+        for (const auto &t : s.timings)
+            if (t.isSub)
+                quantiles(out, "hmi_trdp_sub_interarrival_seconds", t, t.timing.interval);
+        metric(out, "hmi_trdp_sub_callback_latency_seconds", "summary",
+               "PD reception (kernel time stamp) to callback latency quantiles");
+        for (const auto &t : s.timings)
+            if (t.isSub)
+                quantiles(out, "hmi_trdp_sub_callback_latency_seconds", t, t.timing.latency);
+        metric(out, "hmi_trdp_sub_late_total", "counter", "PD arrivals later than half the timeout");
+        for (const auto &t : s.timings)
+            if (t.isSub)
+                out << "hmi_trdp_sub_late_total{comid=\"" << t.comId << "\",tag=\"" << t.tag << "\"} "
+                    << t.timing.numLate << "\n";
+        metric(out, "hmi_trdp_pub_jitter_seconds", "summary", "PD send period deviation quantiles");
+        for (const auto &t : s.timings)
+            if (!t.isSub)
+                quantiles(out, "hmi_trdp_pub_jitter_seconds", t, t.timing.interval);
+        metric(out, "hmi_trdp_pub_overruns_total", "counter", "PD send periods overrunning the cycle by more than half");
+        for (const auto &t : s.timings)
+            if (!t.isSub)
+                out << "hmi_trdp_pub_overruns_total{comid=\"" << t.comId << "\",tag=\"" << t.tag << "\"} "
+                    << t.timing.numLate << "\n";
+        metric(out, "hmi_trdp_pub_tx_latency_seconds", "summary", "PD send call to kernel transmit time stamp quantiles");
+        for (const auto &t : s.timings)
+            if (!t.isSub)
+                quantiles(out, "hmi_trdp_pub_tx_latency_seconds", t, t.timing.latency);
+    }
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+    void publish(std::shared_ptr<const TrdpMetricsSnapshot> snap) { snapshot_.store(std::move(snap)); }
+    std::shared_ptr<const TrdpMetricsSnapshot> current() const { return snapshot_.load(); }
+
+    std::atomic<std::shared_ptr<const TrdpMetricsSnapshot>> snapshot_;
+#else
+    void publish(std::shared_ptr<const TrdpMetricsSnapshot> snap)
+    {
+        std::lock_guard<std::mutex> lk(snapshotMutex_);
+        snapshot_.swap(snap);
+    }
+    std::shared_ptr<const TrdpMetricsSnapshot> current() const
+    {
+        std::lock_guard<std::mutex> lk(snapshotMutex_);
+        return snapshot_;
+    }
+
+    mutable std::mutex                          snapshotMutex_;
+    std::shared_ptr<const TrdpMetricsSnapshot>  snapshot_;
+#endif
+    std::vector<Watched>                        watched_;
+};
+
+#endif /* HMI_METRICS_H */
@@ -0,0 +1,229 @@
+#ifndef HMI_PATH_MERGE_H
+#define HMI_PATH_MERGE_H
+
+/*
+ * Redundant-path receive of one PD telegram (first arrival wins)
+ *
+ * The gateway sends the door status on several paths: unicast, multicast A
+ * and multicast B, and with a second NIC also on the second network (ladder
+ * topology, see import/3.0.0.0/ladder/tau_ladder.h). Each path is a TRDP
+ * subscription whose callback hands every arrival to the merger:
+ *
+ *   - sequence counter newer than the last accepted one -> accepted
+ *     (first arrival), becomes the consolidated snapshot
+ *   - same sequence counter                             -> duplicate, its
+ *     lag behind the first arrival goes into the path's latency histogram
+ *   - older                                             -> stale, dropped
+ *
+ * Counters are compared as serial numbers (signed 32-bit difference), so a
+ * wrap-around is just the next telegram. The merge assumes the gateway sends
+ * the same sequence counter on all paths, as a ladder publisher does. The
+ * merger resynchronises on an older counter when
+ *   - it is more than HMI_MERGE_SEQ_WINDOW behind (publisher restart), or
+ *   - the path of the last accepted telegram has timed out.
+ *
+ * A path is healthy from its first arrival until its subscription times
+ * out. The consolidated snapshot is taken once per accepted sequence number.
+ *
+ * Threading:
+ *   - add(), the callback and take() run on the TRDP thread only.
+ *   - render() may run on any web thread; it reads relaxed atomics only.
+ *     Paths are added before the TRDP loop and never removed.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "hmi_metrics.h"
+#include "hmi_trdp.h"
+
+#define HMI_MERGE_MAX_PATHS         6u      /* subscriptions merged into one telegram  */
+#define HMI_MERGE_SEQ_WINDOW        64u     /* larger backward jump: publisher restart */
+
+class PathMerger
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Path
+    {
+        PathMerger            *owner = nullptr;
+        const char            *tag   = "";
+        uint32_t               nic   = 0u;      /* 0 = NIC A, 1 = NIC B */
+        std::atomic<uint64_t>  received{0u};
+        std::atomic<uint64_t>  accepted{0u};    /* first arrivals            */
+        std::atomic<uint64_t>  duplicates{0u};
+        std::atomic<uint64_t>  stale{0u};
+        std::atomic<uint64_t>  timeouts{0u};
+        std::atomic<bool>      healthy{false};
+        LatencyHistogram       lag;             /* duplicate behind the first arrival */
+    };
+
+    /* Consolidated state of one sequence number */
+    struct Snapshot
+    {
+        TRDP_PD_INFO_T    info;                 /* receive info of the first arrival */
+        uint8_t           data[HMI_AGGREGATED_PD_SIZE];
+        const Path       *path;                 /* path of the first arrival         */
+        Clock::time_point arrival;
+    };
+
+    PathMerger(const char *name, uint32_t dataSize)
+        : name_(name), dataSize_(dataSize)
+    {
+    }
+
+    /* Register a path (TRDP thread, before subscribing); pass the result as pUserRef */
+    Path *add(const char *tag, uint32_t nic)
+    {
+        const uint32_t n = count_.load(std::memory_order_relaxed);
+        if (n >= paths_.size())
+            return nullptr;
+        Path &p = paths_[n];
+        p.owner = this;
+        p.tag   = tag;
+        p.nic   = nic;
+        count_.store(n + 1u, std::memory_order_release);
+        return &p;
+    }
+
+    /* TRDP PD callback of every path subscription (TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB) */
+    static void pdCallback(void *pRefCon, TRDP_APP_SESSION_T appHandle, const TRDP_PD_INFO_T *pMsg,
+                           UINT8 *pData, UINT32 dataSize)
+    {
+        (void)pRefCon;
+        (void)appHandle;
+        Path *p = static_cast<Path *>(const_cast<void *>(pMsg->pUserRef));
+        if (p == nullptr || p->owner == nullptr)
+            return;
+        if (pMsg->resultCode == TRDP_NO_ERR && pData != nullptr)
+            p->owner->onReceive(*p, *pMsg, pData, dataSize, Clock::now());
+        else if (pMsg->resultCode == TRDP_TIMEOUT_ERR)
+            p->owner->onTimeout(*p);
+    }
+
+    /* Latest consolidated snapshot, true once per accepted sequence number (TRDP thread) */
+    bool take(Snapshot &out)
+    {
+        if (!fresh_)
+            return false;
+        fresh_ = false;
+        out = current_;
+        return true;
+    }
+
+    /* At least one path healthy (TRDP thread) */
+    bool alive() const
+    {
+        for (uint32_t i = 0u; i < count_.load(std::memory_order_relaxed); ++i)
+            if (paths_[i].healthy.load(std::memory_order_relaxed))
+                return true;
+        return false;
+    }
+
+    /* At least one path of a NIC healthy (TRDP thread) */
+    bool nicHealthy(uint32_t nic) const
+    {
+        for (uint32_t i = 0u; i < count_.load(std::memory_order_relaxed); ++i)
+            if (paths_[i].nic == nic && paths_[i].healthy.load(std::memory_order_relaxed))
+                return true;
+        return false;
+    }
+
+    /* Prometheus text format of the per-path statistics (any thread) */
+    void render(std::ostringstream &out) const
+    {
+        const uint32_t n = count_.load(std::memory_order_acquire);
+        const struct { const char *name; const char *help; std::atomic<uint64_t> Path::*value; } counters[] = {
+            {"hmi_path_received_total",   "Telegrams received per path",                 &Path::received},
+            {"hmi_path_first_total",      "Telegrams first to arrive on this path",      &Path::accepted},
+            {"hmi_path_duplicate_total",  "Telegrams already received on another path",  &Path::duplicates},
+            {"hmi_path_stale_total",      "Telegrams older than the merged state",       &Path::stale},
+            {"hmi_path_timeout_total",    "Subscription timeouts per path",              &Path::timeouts},
+        };
+        for (const auto &c : counters)
+        {
+            out << "# HELP " << c.name << " " << c.help << "\n"
+                << "# TYPE " << c.name << " counter\n";
+            for (uint32_t i = 0u; i < n; ++i)
+                out << c.name << "{telegram=\"" << name_ << "\",path=\"" << paths_[i].tag << "\"} "
+                    << (paths_[i].*c.value).load(std::memory_order_relaxed) << "\n";
+        }
+        out << "# HELP hmi_path_healthy Path received within its timeout\n"
+            << "# TYPE hmi_path_healthy gauge\n";
+        for (uint32_t i = 0u; i < n; ++i)
+            out << "hmi_path_healthy{telegram=\"" << name_ << "\",path=\"" << paths_[i].tag << "\"} "
+                << (paths_[i].healthy.load(std::memory_order_relaxed) ? 1 : 0) << "\n";
+        out << "# HELP hmi_path_resync_total Merges restarted on an older sequence counter\n"
+            << "# TYPE hmi_path_resync_total counter\n"
+            << "hmi_path_resync_total{telegram=\"" << name_ << "\"} "
+            << resyncs_.load(std::memory_order_relaxed) << "\n";
+
+        out << "# HELP hmi_path_lag_seconds Arrival of a duplicate behind the first arrival\n"
+            << "# TYPE hmi_path_lag_seconds histogram\n";
+        for (uint32_t i = 0u; i < n; ++i)
+            paths_[i].lag.renderSeries(out, "hmi_path_lag_seconds",
+                                       std::string("telegram=\"") + name_ + "\",path=\"" + paths_[i].tag + "\",");
+    }
+
+private:
+    void onReceive(Path &p, const TRDP_PD_INFO_T &info, const UINT8 *pData, UINT32 dataSize,
+                   Clock::time_point now)
+    {
+        p.received.fetch_add(1u, std::memory_order_relaxed);
+        p.healthy.store(true, std::memory_order_relaxed);
+        if (dataSize != dataSize_ || dataSize > sizeof(current_.data))
+            return;
+
+        if (current_.path != nullptr)
+        {
+            const int32_t diff = static_cast<int32_t>(info.seqCount - current_.info.seqCount);
+            if (diff == 0)
+            {
+                p.duplicates.fetch_add(1u, std::memory_order_relaxed);
+                p.lag.observe(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - current_.arrival).count()));
+                return;
+            }
+            if (diff < 0)
+            {
+                const bool restart    = static_cast<uint32_t>(-static_cast<int64_t>(diff)) > HMI_MERGE_SEQ_WINDOW;
+                const bool winnerLost = !current_.path->healthy.load(std::memory_order_relaxed);
+                if (!restart && !winnerLost)
+                {
+                    p.stale.fetch_add(1u, std::memory_order_relaxed);
+                    return;
+                }
+                resyncs_.fetch_add(1u, std::memory_order_relaxed);
+            }
+        }
+
+        p.accepted.fetch_add(1u, std::memory_order_relaxed);
+        current_.info    = info;
+        current_.path    = &p;
+        current_.arrival = now;
+        std::memcpy(current_.data, pData, dataSize);
+        fresh_ = true;
+    }
+
+    void onTimeout(Path &p)
+    {
+        p.timeouts.fetch_add(1u, std::memory_order_relaxed);
+        p.healthy.store(false, std::memory_order_relaxed);
+    }
+
+    const char                            *name_;
+    uint32_t                               dataSize_;
+    std::array<Path, HMI_MERGE_MAX_PATHS>  paths_;
+    std::atomic<uint32_t>                  count_{0u};
+    std::atomic<uint64_t>                  resyncs_{0u};
+    Snapshot                               current_{};
+    bool                                   fresh_ = false;
+};
+
+#endif /* HMI_PATH_MERGE_H */
@@ -0,0 +1,120 @@
+#ifndef HMI_REDUNDANCY_H
+#define HMI_REDUNDANCY_H
+
+/*
+ * Leader election between the two hot-standby HMIs of a cab
+ *
+ * Both HMIs publish the door command telegram (ComId 2010) in redundancy
+ * group HMI_RED_GROUP_ID; only the leader actually sends it, the follower's
+ * publisher is switched off with tlp_setRedundant().
+ *
+ * Each HMI sends an HmiPeerStatus_T (ComId 2002, like the gateway heartbeat)
+ * to its peer every HMI_PEER_CYCLE_US. It carries the role and, from the
+ * leader, the complete command state (door commands with their
+ * alive_counters, speed, emergency). The follower mirrors that state and
+ * keeps putting it into its own (silent) publisher, so a takeover continues
+ * the same command stream without a jump in alive_counter.
+ *
+ * Election (evaluated every TRDP loop):
+ *   - no peer configured             -> leader
+ *   - peer silent for HMI_PEER_TIMEOUT_US (after the start-up window)
+ *                                     -> leader
+ *   - peer leader, we follower       -> stay follower
+ *   - peer follower, we leader       -> stay leader (no preemption)
+ *   - both leader or both follower   -> the lower IP address leads
+ * The peer timeout is shorter than one PD cycle (HMI_PD_CYCLE_US), so the
+ * follower takes over before the gateway misses more than one command.
+ */
+
+#include <chrono>
+#include <cstdint>
+
+#include "hmi_trdp.h"
+
+/* ---------- Redundancy configuration ---------- */
+#define HMI_RED_GROUP_ID            1u      /* redId of the door command publisher     */
+#define HMI_PEER_CYCLE_US           25000u  /* 25 ms - peer heartbeat cycle            */
+#define HMI_PEER_TIMEOUT_US         75000u  /* 75 ms - peer considered lost            */
+
+/* ---------- HMI roles (HmiStatus_T.role) ---------- */
+#define HMI_ROLE_FOLLOWER           0u
+#define HMI_ROLE_LEADER             1u
+
+/*
+ * Peer telegram (HMI -> peer HMI, ComId HMI_PD_HMI_STATUS_COMID).
+ * Starts with the 8-byte gateway heartbeat, followed by the command state.
+ * speed is big-endian (network order).
+ */
+typedef struct __attribute__((packed))
+{
+    HmiStatus_T             status;         /* B0-7:  heartbeat, role                */
+    uint8_t                 emergency;      /* B8:    0=NO, 1=YES                    */
+    uint8_t                 reserved9;      /* B9:    always 0                       */
+    uint8_t                 reserved10;     /* B10:   always 0                       */
+    uint8_t                 reserved11;     /* B11:   always 0                       */
+    uint32_t                speed;          /* B12-15: train speed in km/h           */
+    AggregatedDoorCommand_T cmd;            /* B16-79: door commands (leader state)  */
+} HmiPeerStatus_T;
+
+#define HMI_PEER_STATUS_PD_SIZE     ((uint32_t) sizeof(HmiPeerStatus_T))   /* 80 */
+
+/* ===================================================================
+ * Election state machine (TRDP thread only)
+ * =================================================================== */
+class HmiRedundancy
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /* peerIp == 0: no peer, this HMI always leads */
+    HmiRedundancy(UINT32 ownIp, UINT32 peerIp)
+        : ownIp_(ownIp), peerIp_(peerIp),
+          leader_(peerIp == 0u),
+          startupEnd_(Clock::now() + std::chrono::microseconds(2u * HMI_PEER_TIMEOUT_US))
+    {
+    }
+
+    bool enabled() const { return peerIp_ != 0u; }
+    bool leader() const { return leader_; }
+
+    /*
+     * Evaluate the election rules.
+     *   pPeer: last status of the peer, nullptr if it timed out / never received
+     * Returns true if the role changed.
+     */
+    bool update(const HmiStatus_T *pPeer, Clock::time_point now)
+    {
+        if (!enabled())
+            return false;
+
+        bool leader = leader_;
+        if (pPeer == nullptr)
+        {
+            /* Wait for the peer after start-up, so two HMIs powered up
+               together do not both lead until they hear each other */
+            if (now >= startupEnd_)
+                leader = true;
+        }
+        else
+        {
+            const bool peerLeads = (pPeer->role == HMI_ROLE_LEADER);
+            if (peerLeads == leader_)
+                leader = (ownIp_ < peerIp_);    /* tie: lower IP address leads */
+            else
+                leader = !peerLeads;
+        }
+
+        if (leader == leader_)
+            return false;
+        leader_ = leader;
+        return true;
+    }
+
+private:
+    UINT32            ownIp_;
+    UINT32            peerIp_;
+    bool              leader_;
+    Clock::time_point startupEnd_;
+};
+
+#endif /* HMI_REDUNDANCY_H */
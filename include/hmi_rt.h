@@ -0,0 +1,242 @@
+#ifndef HMI_RT_H
+#define HMI_RT_H
+
+/*
+ * Real-time TRDP loop (option -r <cpu>)
+ *
+ * By default the TRDP loop is a std::thread at normal priority waiting in
+ * select(). With -r the loop body runs as a VOS cyclic thread
+ * (vos_threadCreateSync) every HMI_RT_CYCLE_US under SCHED_FIFO, pinned to
+ * the given CPU, ideally one isolated from the scheduler (isolcpus=,
+ * nohz_full=). All other threads (Crow workers, VOS log thread) are kept off
+ * that CPU: main() removes it from its own affinity mask before any thread
+ * starts, and every thread inherits that mask.
+ *
+ * Before any thread starts, rt_lock_memory() locks the process memory
+ * (mlockall), stops malloc from returning freed memory to the kernel and
+ * pre-faults a heap reserve. The TRDP memory pool allocated by tlc_init()
+ * and the thread stacks are locked (and so faulted in) when mapped.
+ *
+ * The VOS cyclic thread wakes at multiples of the cycle time on
+ * CLOCK_REALTIME, so the wakeup latency of a cycle is the clock's phase when
+ * the cycle starts; a gap of more than one cycle between two wakeups counts
+ * as missed cycles. The cycle time must divide one second.
+ *
+ * Without the privilege for SCHED_FIFO (CAP_SYS_NICE or RLIMIT_RTPRIO) the
+ * cyclic thread runs at normal priority; without the privilege to lock
+ * memory (CAP_IPC_LOCK or RLIMIT_MEMLOCK) memory stays unlocked. Both are
+ * reported at startup and in /api/status.
+ *
+ * Threading:
+ *   - start() and stop() run on the TRDP thread; the cycle function runs on
+ *     the cyclic thread only, never concurrently with the code around
+ *     start()/stop().
+ *   - json() may run on any web thread; it reads relaxed atomics only.
+ */
+
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+#include "hmi_trdp.h"
+
+#define HMI_RT_CYCLE_US             2000u   /* 2 ms - cyclic TRDP tick in RT mode      */
+#define HMI_RT_PRIORITY             80u     /* SCHED_FIFO priority of the TRDP thread  */
+#define HMI_RT_STACK_SIZE           (256u * 1024u)
+#define HMI_RT_HEAP_RESERVE         (4u * 1024u * 1024u)  /* pre-faulted heap          */
+
+static_assert(1000000u % HMI_RT_CYCLE_US == 0u, "RT cycle time must divide one second");
+
+/* Lock current and future memory and pre-fault a heap reserve; false if not permitted */
+static inline bool rt_lock_memory()
+{
+    /* Keep freed memory in the (locked) heap instead of returning it to the kernel */
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    const bool locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+
+    char *reserve = static_cast<char *>(std::malloc(HMI_RT_HEAP_RESERVE));
+    if (reserve != nullptr)
+    {
+        std::memset(reserve, 0, HMI_RT_HEAP_RESERVE);
+        std::free(reserve);
+    }
+    return locked;
+}
+
+/* Restrict the calling thread to one CPU (exclude == false), or remove an allowed CPU from its
+   mask (exclude == true; fails if it is not allowed, the mask is kept if it is the only one) */
+static inline bool rt_set_affinity(int cpu, bool exclude)
+{
+    cpu_set_t set;
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+    if (exclude)
+    {
+        if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0 || !CPU_ISSET(cpu, &set))
+            return false;
+        CPU_CLR(cpu, &set);
+        if (CPU_COUNT(&set) == 0)
+            return true;
+    }
+    else
+    {
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+class RtLoop
+{
+public:
+    using Cycle = std::function<void()>;
+
+    /* CPU (-1: RT mode off), priority and result of rt_lock_memory() (main, before any thread starts) */
+    void configure(int cpu, uint32_t priority, bool memLocked)
+    {
+        cpu_       = cpu;
+        priority_  = priority;
+        memLocked_ = memLocked;
+    }
+
+    bool enabled() const { return cpu_ >= 0; }
+    int  cpu() const { return cpu_; }
+
+    /* Start the cyclic thread (TRDP thread); false if it could not be created */
+    bool start(Cycle cycle)
+    {
+        cycle_ = std::move(cycle);
+        stop_.store(false);
+        stopped_.store(false);
+        if (vos_threadCreateSync(&thread_, "TRDP-RT", VOS_THREAD_POLICY_FIFO,
+                                 static_cast<VOS_THREAD_PRIORITY_T>(priority_), HMI_RT_CYCLE_US,
+                                 nullptr, HMI_RT_STACK_SIZE, entry, this) == VOS_NO_ERR)
+        {
+            fifo_.store(true, std::memory_order_relaxed);
+            running_.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        /* No SCHED_FIFO privilege: keep the cycle, at normal priority */
+        if (vos_threadCreateSync(&thread_, "TRDP-RT", VOS_THREAD_POLICY_OTHER, 0u, HMI_RT_CYCLE_US,
+                                 nullptr, HMI_RT_STACK_SIZE, entry, this) == VOS_NO_ERR)
+        {
+            running_.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        thread_ = nullptr;
+        return false;
+    }
+
+    /* Wait for the running cycle to finish and end the cyclic thread (TRDP thread) */
+    void stop()
+    {
+        if (thread_ == nullptr)
+            return;
+        stop_.store(true);
+        for (uint32_t i = 0u; i < 1000u && !stopped_.load(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        vos_threadTerminate(thread_);
+        thread_ = nullptr;
+        running_.store(false, std::memory_order_relaxed);
+    }
+
+    bool fifo() const { return fifo_.load(std::memory_order_relaxed); }
+
+    /* Loop mode and wakeup statistics for /api/status (any thread) */
+    void json(std::ostringstream &js) const
+    {
+        if (!running_.load(std::memory_order_relaxed))
+        {
+            js << "{\"mode\":\"select\"}";
+            return;
+        }
+        const uint64_t cycles = cycles_.load(std::memory_order_relaxed);
+        const bool     fifo   = fifo_.load(std::memory_order_relaxed);
+        js << "{\"mode\":\"rt\""
+           << ",\"cpu\":" << cpu_
+           << ",\"pinned\":" << (pinned_.load(std::memory_order_relaxed) ? "true" : "false")
+           << ",\"sched_fifo\":" << (fifo ? "true" : "false")
+           << ",\"priority\":" << (fifo ? priority_ : 0u)
+           << ",\"mem_locked\":" << (memLocked_ ? "true" : "false")
+           << ",\"cycle_us\":" << HMI_RT_CYCLE_US
+           << ",\"cycles\":" << cycles
+           << ",\"missed\":" << missed_.load(std::memory_order_relaxed)
+           << ",\"wakeup_us\":{\"last\":" << lastUs_.load(std::memory_order_relaxed)
+           << ",\"mean\":" << (cycles ? sumUs_.load(std::memory_order_relaxed) / cycles : 0u)
+           << ",\"max\":" << maxUs_.load(std::memory_order_relaxed) << "}}";
+    }
+
+private:
+    static void entry(void *arg)
+    {
+        static_cast<RtLoop *>(arg)->onWakeup();
+    }
+
+    void onWakeup()
+    {
+        if (stop_.load())
+        {
+            stopped_.store(true);
+            return;
+        }
+
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        const uint64_t nowUs = static_cast<uint64_t>(now.tv_sec) * 1000000u +
+                               static_cast<uint64_t>(now.tv_nsec) / 1000u;
+        const uint64_t latencyUs = nowUs % HMI_RT_CYCLE_US;
+
+        if (prevUs_ == 0u)
+        {
+            pinned_.store(rt_set_affinity(cpu_, false), std::memory_order_relaxed);
+        }
+        else
+        {
+            /* Wakeups are one cycle apart, rounded to the nearest cycle */
+            const uint64_t cyclesApart = (nowUs - prevUs_ + HMI_RT_CYCLE_US / 2u) / HMI_RT_CYCLE_US;
+            if (cyclesApart > 1u)
+                missed_.fetch_add(cyclesApart - 1u, std::memory_order_relaxed);
+        }
+        prevUs_ = nowUs;
+
+        cycles_.fetch_add(1u, std::memory_order_relaxed);
+        sumUs_.fetch_add(latencyUs, std::memory_order_relaxed);
+        lastUs_.store(latencyUs, std::memory_order_relaxed);
+        if (latencyUs > maxUs_.load(std::memory_order_relaxed))
+            maxUs_.store(latencyUs, std::memory_order_relaxed);     /* single writer */
+
+        cycle_();
+    }
+
+    int                    cpu_       = -1;
+    uint32_t               priority_  = HMI_RT_PRIORITY;
+    bool                   memLocked_ = false;
+    std::atomic<bool>      fifo_{false};
+    std::atomic<bool>      running_{false};
+    VOS_THREAD_T           thread_    = nullptr;
+    Cycle                  cycle_;
+    std::atomic<bool>      stop_{false};
+    std::atomic<bool>      stopped_{false};
+    std::atomic<bool>      pinned_{false};
+    uint64_t               prevUs_    = 0u;     /* cyclic thread only */
+    std::atomic<uint64_t>  cycles_{0u};
+    std::atomic<uint64_t>  missed_{0u};
+    std::atomic<uint64_t>  lastUs_{0u};
+    std::atomic<uint64_t>  maxUs_{0u};
+    std::atomic<uint64_t>  sumUs_{0u};
+};
+
+#endif /* HMI_RT_H */
@@ -31,6 +31,7 @@ extern "C" {
 #define HMI_PD_HMI_STATUS_COMID     2002u   /* HMI -> Gateway: HMI heartbeat          */
 #define HMI_PD_DOOR_CMD_COMID       2010u   /* HMI -> Gateway: aggregated door command */
 #define HMI_MD_RX_COMID             2201u   /* Gateway -> HMI: message data (optional) */
+#define HMI_MD_FAULT_LOG_COMID      2202u   /* HMI -> Gateway: door fault log request/reply */
 
 /* ---------- Door configuration ---------- */
 #define HMI_DOOR_COUNT              8u
@@ -40,6 +41,14 @@ extern "C" {
 #define HMI_PD_TIMEOUT_US           300000u /* 300 ms - matches CAN ICD cmd timeout    */
 #define HMI_TRDP_LOOP_SLEEP_US     10000u  /* 10 ms TRDP processing tick              */
 #define HMI_WEB_PORT                8080u   /* Crow web server port                    */
+#define HMI_FAULT_LOG_TIMEOUT_US    1000000u /* 1 s - fault log MD reply timeout per try */
+
+/* ---------- Second network (ladder topology, tau_ladder.h) ---------- */
+#define HMI_LADDER_SUBNET2          0x00002000u /* gateway on NIC B: gw_ip | subnet 2 bit  */
+
+/* ---------- Shared-memory traffic store (tau_tstore.h) ---------- */
+#define HMI_TS_NAME                 "/hmi_trdp_ts" /* read-only for local diagnostic processes */
+#define HMI_TS_SLOTS                4u      /* door status, door command, peer status  */
 
 /*
  * ---------- Payload structures ----------
@@ -98,6 +107,47 @@ typedef struct __attribute__((packed))
     DoorCommandEntry_T doors[HMI_DOOR_COUNT];
 } AggregatedDoorCommand_T;
 
+/*
+ * HMI heartbeat (HMI -> Gateway, ComId HMI_PD_HMI_STATUS_COMID), 8 bytes.
+ * With a hot-standby peer, role tells the gateway which HMI is in command.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t alive;            /* B0: incremented every TRDP loop           */
+    uint8_t role;             /* B1: 0=FOLLOWER (standby), 1=LEADER        */
+    uint8_t reserved2;        /* B2: always 0                               */
+    uint8_t reserved3;        /* B3: always 0                               */
+    uint8_t reserved4;        /* B4: always 0                               */
+    uint8_t reserved5;        /* B5: always 0                               */
+    uint8_t reserved6;        /* B6: always 0                               */
+    uint8_t reserved7;        /* B7: always 0                               */
+} HmiStatus_T;
+
+/*
+ * Door fault log (MD request/reply, ComId HMI_MD_FAULT_LOG_COMID).
+ * Request: one DoorFaultLogRequest_T.
+ * Reply:   0..HMI_FAULT_LOG_MAX_ENTRIES DoorFaultLogEntry_T, newest first.
+ * Multi-byte fields are big-endian (network order).
+ */
+#define HMI_FAULT_LOG_MAX_ENTRIES   16u
+
+typedef struct __attribute__((packed))
+{
+    uint8_t door_id;          /* B0: 0..HMI_DOOR_COUNT-1                   */
+    uint8_t max_entries;      /* B1: 1..HMI_FAULT_LOG_MAX_ENTRIES          */
+    uint8_t reserved2;        /* B2: always 0                               */
+    uint8_t reserved3;        /* B3: always 0                               */
+} DoorFaultLogRequest_T;
+
+typedef struct __attribute__((packed))
+{
+    uint32_t timestamp;       /* B0-3: seconds since gateway start         */
+    uint8_t  fault_code;      /* B4: DCU fault code                         */
+    uint8_t  door_state;      /* B5: door state when the fault was logged   */
+    uint8_t  reserved6;       /* B6: always 0                               */
+    uint8_t  reserved7;       /* B7: always 0                               */
+} DoorFaultLogEntry_T;
+
 /* ---------- CAN ICD command values ---------- */
 #define DOOR_CMD_NONE               0u
 #define DOOR_CMD_OPEN               1u
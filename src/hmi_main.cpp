@@ -4,6 +4,18 @@
  * Architecture:
  *   Thread 1: Crow web server (HTTP REST API + static page)
  *   Thread 2: TRDP communication loop (PD publish/subscribe + MD listener)
+ *             MD requests are C++20 coroutines (hmi_md_await.h), resumed
+ *             from tlc_process() in this thread
+ *             Refreshes the TRDP statistics snapshot served by /metrics
+ *             (hmi_metrics.h)
+ *             Elects the leader of a hot-standby HMI pair (hmi_redundancy.h)
+ *             Mirrors the latest PD payloads into a shared-memory traffic
+ *             store (tau_tstore.h), read by local diagnostic processes
+ *             Merges the door status of all receive paths, first arrival
+ *             wins (hmi_path_merge.h); optionally a second NIC takes over
+ *             sending when the first one loses the gateway
+ *             Optionally a SCHED_FIFO cyclic thread pinned to its own CPU
+ *             (hmi_rt.h), with all other threads kept off that CPU
  *
  * Business Rules (derived from CAN ICD + requirements):
  *   - Speed == 0 km/h  -> doors may be commanded OPEN (cmd=1)
@@ -11,8 +23,11 @@
  *   - Emergency         -> all doors commanded OPEN regardless of speed
  *   - Obstruction       -> CLOSE button greyed out; door remains OPEN
  *   - alive_counter increments only when HMI command intent changes (per ICD §7a.iii)
+ *   - Standby HMI       -> mirrors the leader's commands, rejects web commands
  */
 
+#include <unistd.h>     /* getopt */
+
 #include <atomic>
 #include <chrono>
 #include <cstdio>
@@ -20,13 +35,21 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <utility>     /* before crow.h: Boost.Asio awaitable.hpp needs std::exchange under C++20 */
 
 #include "crow.h"       /* Crow headers from import/Crow-master/include */
 #include "hmi_trdp.h"
+#include "hmi_md_await.h"
+#include "hmi_metrics.h"
+#include "hmi_path_merge.h"
+#include "hmi_redundancy.h"
+#include "hmi_rt.h"
+#include "tau_tstore.h"
 
 /* ===================================================================
  * Shared application state (protected by g_mutex)
@@ -49,8 +72,32 @@ static bool     g_emergency    = false;
 /* Flag to stop TRDP thread */
 static std::atomic<bool> g_running{true};
 
-/* TRDP session handle (used only in TRDP thread, set once at init) */
+/* TRDP session handle (set once at init; web threads only use it for MD
+ * requests, and only while g_trdpReady is set) */
 static TRDP_APP_SESSION_T g_appHandle = nullptr;
+static std::atomic<bool>  g_trdpReady{false};
+
+/* Gateway address (set once in main before any thread starts) */
+static UINT32 g_gatewayIp = 0u;
+
+/* Leader of the HMI pair (written by TRDP thread, read by web); true without a peer */
+static std::atomic<bool> g_leader{true};
+
+/* Statistics for /metrics (snapshot written by TRDP thread, read lock-free by web) */
+static MetricsStore g_metrics;
+
+/* Door status of all receive paths (merged by TRDP thread, path statistics read by web) */
+static PathMerger g_doorMerge("door_status", HMI_AGGREGATED_PD_SIZE);
+
+/* Path and sequence counter of the door status shown (protected by g_mutex) */
+static const char *g_statusPath = "none";
+static UINT32      g_statusSeq  = 0u;
+
+/* NIC sending the door command (written by TRDP thread, read by web): 0 = A, 1 = B */
+static std::atomic<uint32_t> g_activeNic{0u};
+
+/* Real-time TRDP loop (configured in main, run by TRDP thread, statistics read by web) */
+static RtLoop g_rtLoop;
 
 /* ===================================================================
  * TRDP Callbacks
@@ -114,17 +161,51 @@ static void apply_business_rules()
     }
 }
 
+/* ===================================================================
+ * Traffic store: latest state of one telegram for local readers
+ * =================================================================== */
+struct StoreSlot
+{
+    UINT32 slot     = 0u;
+    bool   valid    = false;    /* last write carried data (no timeout)  */
+    UINT32 seqCount = 0u;
+};
+
+/* Write a received telegram once per sequence counter, or its timeout (pData == nullptr) once */
+static void store_pd(TAU_TSTORE_T store, StoreSlot &s,
+                     const TRDP_PD_INFO_T *pInfo, const UINT8 *pData, UINT32 dataSize)
+{
+    if (store == nullptr)
+        return;
+    if (pData != nullptr)
+    {
+        if (s.valid && pInfo->seqCount == s.seqCount)
+            return;
+        s.valid    = true;
+        s.seqCount = pInfo->seqCount;
+        tau_tsWrite(store, s.slot, pInfo, pData, dataSize);
+    }
+    else if (s.valid)
+    {
+        TRDP_PD_INFO_T timeout{};
+        timeout.resultCode = TRDP_TIMEOUT_ERR;
+        s.valid = false;
+        tau_tsWrite(store, s.slot, &timeout, nullptr, 0u);
+    }
+}
+
 /* ===================================================================
  * TRDP Communication Thread
  * =================================================================== */
 static void trdp_thread_func(UINT32 ownIp, UINT32 gatewayIp,
-                              UINT32 multicastA, UINT32 multicastB)
+                              UINT32 multicastA, UINT32 multicastB,
+                              UINT32 peerIp, UINT32 ownIpB, UINT32 gatewayIpB)
 {
     /* --- TRDP stack init --- */
     TRDP_MEM_CONFIG_T memConfig = {nullptr, 512000u, {0}};
     TRDP_PROCESS_CONFIG_T processConfig = {
         "HMI", "HMI TRDP WebApp", "",
-        TRDP_PROCESS_DEFAULT_CYCLE_TIME, 0u, TRDP_OPTION_TRAFFIC_SHAPING, 0u
+        TRDP_PROCESS_DEFAULT_CYCLE_TIME, 0u, TRDP_OPTION_TRAFFIC_SHAPING | TRDP_OPTION_TIMESTAMPING, 0u
     };
     TRDP_PD_CONFIG_T pdConfig = {
         nullptr, nullptr, TRDP_PD_DEFAULT_SEND_PARAM,
@@ -142,6 +223,11 @@ static void trdp_thread_func(UINT32 ownIp, UINT32 gatewayIp,
         return;
     }
 
+    /* Defer formatting and printing of TRDP log messages to the VOS log thread,
+       so the cyclic TRDP loop never blocks on stdout */
+    if (vos_logStart(nullptr) != VOS_NO_ERR)
+        printf("[TRDP] Asynchronous logging unavailable, logging synchronously\n");
+
     if (tlc_openSession(&g_appHandle, ownIp, 0u, nullptr,
                          &pdConfig, &mdConfig, &processConfig) != TRDP_NO_ERR)
     {
@@ -151,47 +237,72 @@ static void trdp_thread_func(UINT32 ownIp, UINT32 gatewayIp,
         return;
     }
 
-    /* --- PD Subscriptions: aggregated door status --- */
+    /* --- Optional second NIC (network B of a ladder topology) --- */
+    TRDP_APP_SESSION_T appHandleB = nullptr;
+    if (ownIpB != 0u &&
+        tlc_openSession(&appHandleB, ownIpB, 0u, nullptr,
+                        &pdConfig, nullptr, &processConfig) != TRDP_NO_ERR)
+    {
+        std::cerr << "TRDP session on NIC B failed, continuing on NIC A only\n";
+        appHandleB = nullptr;
+    }
+    TRDP_APP_SESSION_T mcastBSession = appHandleB ? appHandleB : g_appHandle;
+
+    /* --- PD Subscriptions: aggregated door status on every path,
+           merged in the callback (first arrival wins) --- */
     struct {
+        TRDP_APP_SESSION_T session;
         TRDP_SUB_T handle;
+        TRDP_IP_ADDR_T src;
         TRDP_IP_ADDR_T dest;
         const char *tag;
+        uint32_t nic;
     } subs[] = {
-        {nullptr, ownIp,      "unicast"},
-        {nullptr, multicastA, "mcast-A"},
-        {nullptr, multicastB, "mcast-B"},
+        {g_appHandle,   nullptr, gatewayIp,  ownIp,      "unicast",   0u},
+        {g_appHandle,   nullptr, gatewayIp,  multicastA, "mcast-A",   0u},
+        {mcastBSession, nullptr, appHandleB ? gatewayIpB : gatewayIp,
+                                             multicastB, "mcast-B",   appHandleB ? 1u : 0u},
+        {appHandleB,    nullptr, gatewayIpB, ownIpB,     "unicast-B", 1u},
     };
-    const uint32_t subCount = sizeof(subs) / sizeof(subs[0]);
+    const uint32_t subCount = appHandleB ? 4u : 3u;
 
     for (uint32_t i = 0; i < subCount; ++i)
     {
-        if (tlp_subscribe(g_appHandle, &subs[i].handle, nullptr, nullptr, 0u,
+        if (tlp_subscribe(subs[i].session, &subs[i].handle,
+                          g_doorMerge.add(subs[i].tag, subs[i].nic), PathMerger::pdCallback, 0u,
                           HMI_PD_DOOR_STATUS_COMID, 0u, 0u,
-                          gatewayIp, gatewayIp, subs[i].dest,
-                          TRDP_FLAGS_NONE, HMI_PD_TIMEOUT_US,
+                          subs[i].src, subs[i].src, subs[i].dest,
+                          TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, HMI_PD_TIMEOUT_US,
                           TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR)
         {
             std::cerr << "PD subscribe failed: " << subs[i].tag << "\n";
+            if (appHandleB) tlc_closeSession(appHandleB);
             tlc_closeSession(g_appHandle);
             tlc_terminate();
             g_running = false;
             return;
         }
+        /* The statistics snapshot covers session A */
+        if (subs[i].session == g_appHandle)
+            g_metrics.watchSubscription(subs[i].handle, HMI_PD_DOOR_STATUS_COMID, subs[i].tag);
     }
 
-    /* --- PD Publisher: aggregated door command (HMI -> Gateway) --- */
+    /* --- PD Publisher: aggregated door command (HMI -> Gateway),
+           sent by the leader of the redundancy group only --- */
     TRDP_PUB_T doorCmdPub = nullptr;
     if (tlp_publish(g_appHandle, &doorCmdPub, nullptr, nullptr, 0u,
                     HMI_PD_DOOR_CMD_COMID, 0u, 0u,
-                    ownIp, gatewayIp, HMI_PD_CYCLE_US, 0u,
+                    ownIp, gatewayIp, HMI_PD_CYCLE_US, HMI_RED_GROUP_ID,
                     TRDP_FLAGS_NONE, nullptr, 0u) != TRDP_NO_ERR)
     {
         std::cerr << "PD publish (door cmd) failed\n";
+        if (appHandleB) tlc_closeSession(appHandleB);
         tlc_closeSession(g_appHandle);
         tlc_terminate();
         g_running = false;
         return;
     }
+    g_metrics.watchPublication(doorCmdPub, HMI_PD_DOOR_CMD_COMID, "door-cmd");
 
     /* --- PD Publisher: HMI heartbeat status --- */
     TRDP_PUB_T hmiStatusPub = nullptr;
@@ -202,28 +313,159 @@ static void trdp_thread_func(UINT32 ownIp, UINT32 gatewayIp,
     {
         std::cerr << "PD publish (HMI status) failed\n";
         tlp_unpublish(g_appHandle, doorCmdPub);
+        if (appHandleB) tlc_closeSession(appHandleB);
+        tlc_closeSession(g_appHandle);
+        tlc_terminate();
+        g_running = false;
+        return;
+    }
+    g_metrics.watchPublication(hmiStatusPub, HMI_PD_HMI_STATUS_COMID, "heartbeat");
+
+    /* --- NIC B: the same door command (same redundancy group) and heartbeat
+           towards the gateway's network B address --- */
+    TRDP_PUB_T doorCmdPubB = nullptr;
+    TRDP_PUB_T hmiStatusPubB = nullptr;
+    if (appHandleB != nullptr &&
+        (tlp_publish(appHandleB, &doorCmdPubB, nullptr, nullptr, 0u,
+                     HMI_PD_DOOR_CMD_COMID, 0u, 0u,
+                     ownIpB, gatewayIpB, HMI_PD_CYCLE_US, HMI_RED_GROUP_ID,
+                     TRDP_FLAGS_NONE, nullptr, 0u) != TRDP_NO_ERR ||
+         tlp_publish(appHandleB, &hmiStatusPubB, nullptr, nullptr, 0u,
+                     HMI_PD_HMI_STATUS_COMID, 0u, 0u,
+                     ownIpB, gatewayIpB, HMI_PD_CYCLE_US, 0u,
+                     TRDP_FLAGS_NONE, nullptr, 0u) != TRDP_NO_ERR))
+    {
+        std::cerr << "PD publish on NIC B failed\n";
+        tlp_unpublish(g_appHandle, hmiStatusPub);
+        tlp_unpublish(g_appHandle, doorCmdPub);
+        tlc_closeSession(appHandleB);
         tlc_closeSession(g_appHandle);
         tlc_terminate();
         g_running = false;
         return;
     }
 
+    /* --- Hot-standby peer: status + command state in both directions --- */
+    HmiRedundancy redundancy(ownIp, peerIp);
+    TRDP_SUB_T peerSub = nullptr;
+    TRDP_PUB_T peerPub = nullptr;
+    if (redundancy.enabled())
+    {
+        if (tlp_subscribe(g_appHandle, &peerSub, nullptr, nullptr, 0u,
+                          HMI_PD_HMI_STATUS_COMID, 0u, 0u,
+                          peerIp, peerIp, ownIp,
+                          TRDP_FLAGS_NONE, HMI_PEER_TIMEOUT_US,
+                          TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR ||
+            tlp_publish(g_appHandle, &peerPub, nullptr, nullptr, 0u,
+                        HMI_PD_HMI_STATUS_COMID, 0u, 0u,
+                        ownIp, peerIp, HMI_PEER_CYCLE_US, 0u,
+                        TRDP_FLAGS_NONE, nullptr, 0u) != TRDP_NO_ERR)
+        {
+            std::cerr << "PD peer subscribe/publish failed\n";
+            if (peerSub) tlp_unsubscribe(g_appHandle, peerSub);
+            tlp_unpublish(g_appHandle, hmiStatusPub);
+            tlp_unpublish(g_appHandle, doorCmdPub);
+            if (appHandleB) tlc_closeSession(appHandleB);
+            tlc_closeSession(g_appHandle);
+            tlc_terminate();
+            g_running = false;
+            return;
+        }
+        g_metrics.watchSubscription(peerSub, HMI_PD_HMI_STATUS_COMID, "peer");
+
+        /* Start as follower until the peer was heard or the start-up window expired */
+        g_leader = false;
+        printf("[RED] Peer %s, waiting for election\n", vos_ipDotted(peerIp));
+    }
+
+    /* Only the leader sends the door command, and only on the active NIC.
+       A failed switchover is retried every cycle; until it succeeds the HMI
+       does not act as leader (g_leader), whatever the election says. */
+    uint32_t activeNic = 0u;
+    bool     sendersOk = true;
+    auto set_senders = [&]()
+    {
+        const bool       leads = redundancy.leader();
+        const TRDP_ERR_T errA  = tlp_setRedundant(g_appHandle, HMI_RED_GROUP_ID,
+                                                  (leads && activeNic == 0u) ? TRUE : FALSE);
+        const TRDP_ERR_T errB  = (appHandleB != nullptr)
+                                     ? tlp_setRedundant(appHandleB, HMI_RED_GROUP_ID,
+                                                        (leads && activeNic == 1u) ? TRUE : FALSE)
+                                     : TRDP_NO_ERR;
+        if (errA != TRDP_NO_ERR || errB != TRDP_NO_ERR)
+        {
+            if (sendersOk)
+                std::cerr << "[RED] tlp_setRedundant failed (NIC A: " << errA << ", NIC B: " << errB
+                          << "), retrying\n";
+            sendersOk = false;
+        }
+        else if (!sendersOk)
+        {
+            printf("[RED] Door command senders switched\n");
+            sendersOk = true;
+        }
+        g_leader = leads && sendersOk;
+    };
+    set_senders();
+
     /* --- MD Listener: optional gateway commands to HMI --- */
     TRDP_LIS_T mdListener = nullptr;
     tlm_addListener(g_appHandle, &mdListener, nullptr, trdp_md_cb, TRUE,
                     HMI_MD_RX_COMID, 0u, 0u, gatewayIp, gatewayIp,
                     VOS_INADDR_ANY, TRDP_FLAGS_NONE, nullptr, nullptr);
 
-    printf("[TRDP] Running: own=%s gw=%s\n",
-           vos_ipDotted(ownIp), vos_ipDotted(gatewayIp));
+    /* vos_ipDotted() returns a static buffer: one address per call */
+    printf("[TRDP] Running: own=%s", vos_ipDotted(ownIp));
+    printf(" gw=%s\n", vos_ipDotted(gatewayIp));
+    if (appHandleB != nullptr)
+    {
+        printf("[TRDP] NIC B: own=%s", vos_ipDotted(ownIpB));
+        printf(" gw=%s\n", vos_ipDotted(gatewayIpB));
+    }
+    /* --- Traffic store: one receive here, any number of local readers --- */
+    TAU_TSTORE_T tsStore = nullptr;
+    StoreSlot tsDoorStatus, tsDoorCmd, tsPeer;
+    AggregatedDoorCommand_T tsLastCmd;
+    std::memset(&tsLastCmd, 0xFF, sizeof(tsLastCmd));   /* forces the first write */
+    if (tau_tsCreate(&tsStore, HMI_TS_NAME, HMI_TS_SLOTS, TRDP_MAX_PD_DATA_SIZE) == TRDP_NO_ERR)
+    {
+        tau_tsAddSlot(tsStore, HMI_PD_DOOR_STATUS_COMID, gatewayIp, &tsDoorStatus.slot);
+        tau_tsAddSlot(tsStore, HMI_PD_DOOR_CMD_COMID, ownIp, &tsDoorCmd.slot);
+        if (redundancy.enabled())
+            tau_tsAddSlot(tsStore, HMI_PD_HMI_STATUS_COMID, peerIp, &tsPeer.slot);
+        printf("[TRDP] Traffic store %s\n", HMI_TS_NAME);
+    }
+    else
+    {
+        std::cerr << "Traffic store " << HMI_TS_NAME << " not available\n";
+        tsStore = nullptr;
+    }
+
+    g_trdpReady = true;
 
     /* --- Main TRDP loop --- */
-    uint8_t rxBuf[HMI_AGGREGATED_PD_SIZE];
-    uint8_t hmiStatusBuf[HMI_HMI_STATUS_PD_SIZE];
+    PathMerger::Snapshot doorStatus;
+    HmiStatus_T hmiStatus;
+    HmiPeerStatus_T peerStatus;
     static uint8_t hmiAlive = 0u;
+    auto lastCycle   = std::chrono::steady_clock::now();
+    auto nextMetrics = lastCycle;
 
-    while (g_running)
+    /* One pass of the loop: wait for the sockets (select mode) or poll them (RT mode),
+       process, merge, elect and publish */
+    auto cycle = [&](bool poll)
     {
+        /* --- Loop cycle time and statistics snapshot for /metrics --- */
+        const auto cycleStart = std::chrono::steady_clock::now();
+        g_metrics.loopCycle.observe(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(cycleStart - lastCycle).count()));
+        lastCycle = cycleStart;
+        if (cycleStart >= nextMetrics)
+        {
+            g_metrics.refresh(g_appHandle);
+            nextMetrics = cycleStart + std::chrono::microseconds(HMI_METRICS_REFRESH_US);
+        }
+
         TRDP_TIME_T tv = {0u, HMI_TRDP_LOOP_SLEEP_US};
         TRDP_FDS_T rfds;
         TRDP_SOCK_T noDesc = 0;
@@ -231,50 +473,185 @@ static void trdp_thread_func(UINT32 ownIp, UINT32 gatewayIp,
 
         VOS_FD_ZERO(&rfds);
         tlc_getInterval(g_appHandle, &tv, &rfds, &noDesc);
+        if (appHandleB != nullptr)
+        {
+            TRDP_TIME_T tvB = {0u, HMI_TRDP_LOOP_SLEEP_US};
+            tlc_getInterval(appHandleB, &tvB, &rfds, &noDesc);
+            if (vos_cmpTime(&tvB, &tv) < 0)
+                tv = tvB;
+        }
+        if (poll)
+            tv = {0u, 0u};
         if (noDesc > 0)
         {
             count = vos_select(noDesc, &rfds, nullptr, nullptr, &tv);
             if (count < 0) count = 0;
         }
+        INT32 countB = count;
         tlc_process(g_appHandle, &rfds, &count);
+        if (appHandleB != nullptr)
+            tlc_process(appHandleB, &rfds, &countB);
 
-        /* --- Receive aggregated door status --- */
-        for (uint32_t i = 0; i < subCount; ++i)
+        /* --- Door status: one consolidated snapshot per sequence counter,
+               from whichever path delivered it first --- */
+        if (g_doorMerge.take(doorStatus))
+        {
+            {
+                std::lock_guard<std::mutex> lk(g_mutex);
+                std::memcpy(&g_doorStatus, doorStatus.data, sizeof(g_doorStatus));
+                g_statusPath = doorStatus.path->tag;
+                g_statusSeq  = doorStatus.info.seqCount;
+            }
+            store_pd(tsStore, tsDoorStatus, &doorStatus.info, doorStatus.data, HMI_AGGREGATED_PD_SIZE);
+        }
+        else if (!g_doorMerge.alive())
+        {
+            store_pd(tsStore, tsDoorStatus, nullptr, nullptr, 0u);
+        }
+
+        /* --- Second NIC: send on a NIC that still hears the gateway --- */
+        bool nicSwitched = false;
+        if (appHandleB != nullptr &&
+            !g_doorMerge.nicHealthy(activeNic) && g_doorMerge.nicHealthy(1u - activeNic))
+        {
+            activeNic   = 1u - activeNic;
+            nicSwitched = true;
+            g_activeNic = activeNic;
+            set_senders();
+            printf("[NIC] Gateway lost on NIC %c, sending on NIC %c\n",
+                   activeNic ? 'A' : 'B', activeNic ? 'B' : 'A');
+        }
+
+        /* --- Redundancy: elect leader, mirror the leader's command state --- */
+        bool tookOver = false;
+        if (!sendersOk && !nicSwitched)
+            set_senders();
+        if (redundancy.enabled())
         {
             TRDP_PD_INFO_T pdInfo;
-            UINT32 dataSize = sizeof(rxBuf);
-            if (tlp_get(g_appHandle, subs[i].handle, &pdInfo,
-                        rxBuf, &dataSize) == TRDP_NO_ERR &&
-                dataSize == HMI_AGGREGATED_PD_SIZE)
+            UINT32 dataSize = sizeof(peerStatus);
+            const bool peerAlive =
+                tlp_get(g_appHandle, peerSub, &pdInfo,
+                        reinterpret_cast<UINT8 *>(&peerStatus), &dataSize) == TRDP_NO_ERR &&
+                dataSize == HMI_PEER_STATUS_PD_SIZE;
+            store_pd(tsStore, tsPeer, &pdInfo,
+                     peerAlive ? reinterpret_cast<const UINT8 *>(&peerStatus) : nullptr, dataSize);
+
+            if (redundancy.update(peerAlive ? &peerStatus.status : nullptr,
+                                  std::chrono::steady_clock::now()))
+            {
+                set_senders();
+                tookOver = redundancy.leader();
+                printf("[RED] %s\n", redundancy.leader() ? "Leader, sending door commands"
+                                                         : "Follower, mirroring peer");
+            }
+
+            if (!redundancy.leader() && peerAlive && peerStatus.status.role == HMI_ROLE_LEADER)
             {
                 std::lock_guard<std::mutex> lk(g_mutex);
-                std::memcpy(&g_doorStatus, rxBuf, sizeof(g_doorStatus));
+                g_doorCmd    = peerStatus.cmd;
+                g_trainSpeed = vos_ntohl(peerStatus.speed);
+                g_emergency  = (peerStatus.emergency != 0u);
+                for (uint32_t i = 0u; i < HMI_DOOR_COUNT; ++i)
+                    g_prevCmd[i] = g_doorCmd.doors[i].cmd;
             }
         }
 
-        /* --- Apply business rules and publish door commands --- */
+        /* --- Apply business rules and publish door commands
+               (the follower's publisher is silent, but kept up to date) --- */
         {
             std::lock_guard<std::mutex> lk(g_mutex);
-            apply_business_rules();
-            tlp_put(g_appHandle, doorCmdPub,
-                    reinterpret_cast<const UINT8 *>(&g_doorCmd),
-                    static_cast<UINT32>(sizeof(g_doorCmd)));
+            if (redundancy.leader())
+                apply_business_rules();
+            TRDP_PUB_T activePub = activeNic ? doorCmdPubB : doorCmdPub;
+            if ((tookOver || nicSwitched) && redundancy.leader())
+            {
+                /* Do not wait for the next cycle of the new leader / NIC */
+                tlp_putImmediate(activeNic ? appHandleB : g_appHandle, activePub,
+                                 reinterpret_cast<const UINT8 *>(&g_doorCmd),
+                                 static_cast<UINT32>(sizeof(g_doorCmd)), nullptr);
+            }
+            else
+            {
+                tlp_put(activeNic ? appHandleB : g_appHandle, activePub,
+                        reinterpret_cast<const UINT8 *>(&g_doorCmd),
+                        static_cast<UINT32>(sizeof(g_doorCmd)));
+            }
+            /* The standby NIC's publisher is silent, but kept up to date */
+            if (appHandleB != nullptr)
+            {
+                tlp_put(activeNic ? g_appHandle : appHandleB, activeNic ? doorCmdPub : doorCmdPubB,
+                        reinterpret_cast<const UINT8 *>(&g_doorCmd),
+                        static_cast<UINT32>(sizeof(g_doorCmd)));
+            }
+
+            if (tsStore != nullptr && std::memcmp(&tsLastCmd, &g_doorCmd, sizeof(g_doorCmd)) != 0)
+            {
+                tsLastCmd = g_doorCmd;
+                tau_tsWrite(tsStore, tsDoorCmd.slot, nullptr,
+                            reinterpret_cast<const UINT8 *>(&g_doorCmd),
+                            static_cast<UINT32>(sizeof(g_doorCmd)));
+            }
+
+            std::memset(&peerStatus, 0, sizeof(peerStatus));
+            peerStatus.emergency = g_emergency ? 1u : 0u;
+            peerStatus.speed     = vos_htonl(g_trainSpeed);
+            peerStatus.cmd       = g_doorCmd;
         }
 
-        /* --- Publish HMI heartbeat --- */
-        std::memset(hmiStatusBuf, 0, sizeof(hmiStatusBuf));
-        hmiStatusBuf[0] = ++hmiAlive;
+        /* --- Publish HMI heartbeat (gateway and peer) --- */
+        std::memset(&hmiStatus, 0, sizeof(hmiStatus));
+        hmiStatus.alive = ++hmiAlive;
+        /* A leader that cannot send lets the peer take over */
+        hmiStatus.role  = (redundancy.leader() && sendersOk) ? HMI_ROLE_LEADER : HMI_ROLE_FOLLOWER;
         tlp_put(g_appHandle, hmiStatusPub,
-                hmiStatusBuf, static_cast<UINT32>(sizeof(hmiStatusBuf)));
+                reinterpret_cast<const UINT8 *>(&hmiStatus), static_cast<UINT32>(sizeof(hmiStatus)));
+        if (hmiStatusPubB)
+            tlp_put(appHandleB, hmiStatusPubB,
+                    reinterpret_cast<const UINT8 *>(&hmiStatus), static_cast<UINT32>(sizeof(hmiStatus)));
+        if (peerPub)
+        {
+            peerStatus.status = hmiStatus;
+            tlp_put(g_appHandle, peerPub,
+                    reinterpret_cast<const UINT8 *>(&peerStatus), HMI_PEER_STATUS_PD_SIZE);
+        }
+    };
+
+    if (g_rtLoop.enabled() && g_rtLoop.start([&]() { cycle(true); }))
+    {
+        printf("[TRDP] Cyclic thread every %u us on CPU %d, %s\n", HMI_RT_CYCLE_US, g_rtLoop.cpu(),
+               g_rtLoop.fifo() ? "SCHED_FIFO" : "normal priority (SCHED_FIFO not permitted)");
+        while (g_running)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        g_rtLoop.stop();
+    }
+    else
+    {
+        if (g_rtLoop.enabled())
+            std::cerr << "TRDP cyclic thread failed, running the select loop\n";
+        while (g_running)
+            cycle(false);
     }
 
     /* --- Cleanup --- */
+    g_trdpReady = false;
+    g_metrics.clear();
+    if (tsStore) tau_tsClose(tsStore);
     if (mdListener) tlm_delListener(g_appHandle, mdListener);
     tlp_unpublish(g_appHandle, doorCmdPub);
     tlp_unpublish(g_appHandle, hmiStatusPub);
+    if (peerPub) tlp_unpublish(g_appHandle, peerPub);
+    if (peerSub) tlp_unsubscribe(g_appHandle, peerSub);
     for (uint32_t i = 0; i < subCount; ++i)
-        tlp_unsubscribe(g_appHandle, subs[i].handle);
+        tlp_unsubscribe(subs[i].session, subs[i].handle);
+    if (appHandleB)
+    {
+        tlp_unpublish(appHandleB, doorCmdPubB);
+        tlp_unpublish(appHandleB, hmiStatusPubB);
+        tlc_closeSession(appHandleB);
+    }
     tlc_closeSession(g_appHandle);
+    vos_logStop();          /* flush pending log messages */
     tlc_terminate();
     printf("[TRDP] Stopped\n");
 }
@@ -303,7 +680,13 @@ static std::string build_status_json()
     std::ostringstream js;
     js << "{\"speed\":" << g_trainSpeed
        << ",\"emergency\":" << (g_emergency ? "true" : "false")
-       << ",\"doors\":[";
+       << ",\"leader\":" << (g_leader ? "true" : "false")
+       << ",\"status_path\":\"" << g_statusPath << "\""
+       << ",\"status_seq\":" << g_statusSeq
+       << ",\"nic\":\"" << (g_activeNic ? 'B' : 'A') << "\""
+       << ",\"trdp_loop\":";
+    g_rtLoop.json(js);
+    js << ",\"doors\":[";
     for (uint32_t i = 0; i < HMI_DOOR_COUNT; ++i)
     {
         const auto &d = g_doorStatus.doors[i];
@@ -323,6 +706,156 @@ static std::string build_status_json()
     return js.str();
 }
 
+/* ===================================================================
+ * MD: door fault log fetch
+ *
+ * One coroutine per door. It suspends in co_await and is resumed by the
+ * TRDP thread inside tlc_process(), so it must not block; it stores its
+ * JSON result in the FaultLogFetch of the HTTP request. The last one
+ * completes the HTTP response in the connection's io_context, so no web
+ * worker thread waits for the gateway.
+ * =================================================================== */
+static std::string build_fault_log_json(uint32_t doorId, const MdResult &r)
+{
+    std::ostringstream js;
+    js << "{\"id\":" << doorId;
+
+    if (r.err != TRDP_NO_ERR || r.replies.empty())
+    {
+        js << ",\"ok\":false,\"error\":" << (int)(r.err != TRDP_NO_ERR ? r.err : TRDP_NODATA_ERR) << "}";
+        return js.str();
+    }
+
+    const std::vector<uint8_t> &data = r.replies.front().data;
+    const size_t count = data.size() / sizeof(DoorFaultLogEntry_T);
+    js << ",\"ok\":true,\"entries\":[";
+    for (size_t i = 0; i < count && i < HMI_FAULT_LOG_MAX_ENTRIES; ++i)
+    {
+        DoorFaultLogEntry_T e;
+        std::memcpy(&e, data.data() + i * sizeof(e), sizeof(e));
+        if (i > 0) js << ",";
+        js << "{\"timestamp\":" << vos_ntohl(e.timestamp)
+           << ",\"fault_code\":" << (int)e.fault_code
+           << ",\"door_state\":" << (int)e.door_state
+           << "}";
+    }
+    js << "]}";
+    return js.str();
+}
+
+/* Fault log requests of one HTTP request, shared by its coroutines, the
+ * deadline timer and the completion in the connection's io_context */
+struct FaultLogFetch
+{
+    explicit FaultLogFetch(crow::asio::io_context &io) : deadline(io) {}
+
+    std::mutex               mutex;         /* doors, pending (TRDP thread) */
+    std::vector<std::string> doors;         /* JSON per door, empty: no result */
+    uint32_t                 first   = 0u;
+    uint32_t                 pending = 0u;
+    bool                     array   = false;   /* all doors: JSON array */
+    bool                     done    = false;   /* response sent (io_context only) */
+    crow::response          *pRes    = nullptr;
+    crow::asio::steady_timer deadline;
+};
+
+/* Send the response; runs in the connection's io_context, once */
+static void finish_fault_logs(const std::shared_ptr<FaultLogFetch> &f)
+{
+    if (f->done)
+        return;
+    f->done = true;
+    f->deadline.cancel();
+
+    std::ostringstream js;
+    {
+        std::lock_guard<std::mutex> lk(f->mutex);
+        if (f->array) js << "[";
+        for (uint32_t i = 0; i < f->doors.size(); ++i)
+        {
+            if (i > 0) js << ",";
+            if (!f->doors[i].empty())
+                js << f->doors[i];
+            else
+                js << "{\"id\":" << f->first + i << ",\"ok\":false,\"error\":" << (int)TRDP_TIMEOUT_ERR << "}";
+        }
+        if (f->array) js << "]";
+    }
+    f->pRes->set_header("Content-Type", "application/json");
+    f->pRes->end(js.str());
+}
+
+static MdTask fetch_fault_log(std::shared_ptr<FaultLogFetch> f, uint32_t doorId)
+{
+    DoorFaultLogRequest_T req;
+    std::memset(&req, 0, sizeof(req));
+    req.door_id     = static_cast<uint8_t>(doorId);
+    req.max_entries = HMI_FAULT_LOG_MAX_ENTRIES;
+
+    MdResult r = co_await MdRequest(g_appHandle, HMI_MD_FAULT_LOG_COMID, g_gatewayIp,
+                                    &req, static_cast<UINT32>(sizeof(req)),
+                                    1u, HMI_FAULT_LOG_TIMEOUT_US);
+
+    bool last;
+    {
+        std::lock_guard<std::mutex> lk(f->mutex);
+        f->doors[doorId - f->first] = build_fault_log_json(doorId, r);
+        last = (--f->pending == 0u);
+    }
+    if (last)
+        crow::asio::post(f->deadline.get_executor(), [f]() { finish_fault_logs(f); });
+}
+
+/* Start fault log requests for doors [first, last]; the response is sent
+ * when all of them are done. Replies time out in the TRDP stack after
+ * HMI_FAULT_LOG_TIMEOUT_US per try (1 + TRDP_MD_DEFAULT_RETRIES tries);
+ * the deadline timer adds a margin for a session closed meanwhile and
+ * bounds the response time to 3.5 s. */
+static void start_fault_logs(const crow::request &req, crow::response &res,
+                             uint32_t first, uint32_t last, bool array)
+{
+    auto f = std::make_shared<FaultLogFetch>(*req.io_context);
+    f->doors.resize(last - first + 1u);
+    f->first   = first;
+    f->pending = last - first + 1u;
+    f->array   = array;
+    f->pRes    = &res;
+
+    f->deadline.expires_after(std::chrono::microseconds(
+        HMI_FAULT_LOG_TIMEOUT_US * (1u + TRDP_MD_DEFAULT_RETRIES) + 500000u));
+    f->deadline.async_wait([f](const crow::error_code &ec)
+    {
+        if (!ec)
+            finish_fault_logs(f);
+    });
+
+    for (uint32_t id = first; id <= last; ++id)
+        fetch_fault_log(f, id);
+}
+
+/* ===================================================================
+ * Crow middleware: web request latency for /metrics
+ * =================================================================== */
+struct RequestLatency
+{
+    struct context
+    {
+        std::chrono::steady_clock::time_point start;
+    };
+
+    void before_handle(crow::request &, crow::response &, context &ctx)
+    {
+        ctx.start = std::chrono::steady_clock::now();
+    }
+
+    void after_handle(crow::request &, crow::response &, context &ctx)
+    {
+        g_metrics.webRequest.observe(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - ctx.start).count()));
+    }
+};
+
 /* ===================================================================
  * Main
  * =================================================================== */
@@ -335,19 +868,46 @@ int main(int argc, char **argv)
     UINT32 multicastB = vos_dottedIP("239.192.0.2");
     uint16_t webPort  = HMI_WEB_PORT;
     std::string webDir = "web";
+    UINT32 peerIp     = 0u;     /* hot-standby peer HMI, none by default */
+    UINT32 ownIpB     = 0u;     /* second NIC, none by default */
+    UINT32 gatewayIpB = 0u;
+    int rtCpu         = -1;     /* RT mode off by default */
+    uint32_t rtPrio   = HMI_RT_PRIORITY;
+    bool usage        = false;
 
-    if (argc > 1) ownIp      = vos_dottedIP(argv[1]);
-    if (argc > 2) gatewayIp  = vos_dottedIP(argv[2]);
-    if (argc > 3) multicastA = vos_dottedIP(argv[3]);
-    if (argc > 4) multicastB = vos_dottedIP(argv[4]);
-    if (argc > 5) webPort    = static_cast<uint16_t>(std::stoi(argv[5]));
-    if (argc > 6) webDir     = argv[6];
+    int ch;
+    while ((ch = getopt(argc, argv, "r:p:")) != -1)
+    {
+        if (ch == 'r')
+            rtCpu = std::atoi(optarg);
+        else if (ch == 'p')
+            rtPrio = static_cast<uint32_t>(std::atoi(optarg));
+        else
+            usage = true;
+    }
+    const int nArgs = argc - optind;
+    char **args     = argv + optind;
 
-    if (argc > 7)
+    if (nArgs > 0) ownIp      = vos_dottedIP(args[0]);
+    if (nArgs > 1) gatewayIp  = vos_dottedIP(args[1]);
+    if (nArgs > 2) multicastA = vos_dottedIP(args[2]);
+    if (nArgs > 3) multicastB = vos_dottedIP(args[3]);
+    if (nArgs > 4) webPort    = static_cast<uint16_t>(std::stoi(args[4]));
+    if (nArgs > 5) webDir     = args[5];
+    if (nArgs > 6) peerIp     = vos_dottedIP(args[6]);
+    if (nArgs > 7) ownIpB     = vos_dottedIP(args[7]);
+    if (nArgs > 8) gatewayIpB = vos_dottedIP(args[8]);
+
+    if (usage || nArgs > 9 || (optind > 1 && rtCpu < 0) || rtPrio < 1u || rtPrio > 99u)
     {
-        printf("Usage: %s [own_ip] [gw_ip] [mc_a] [mc_b] [web_port] [web_dir]\n", argv[0]);
+        printf("Usage: %s [-r rt_cpu [-p rt_prio]] [own_ip] [gw_ip] [mc_a] [mc_b] [web_port] [web_dir] "
+               "[peer_ip|0.0.0.0] [own_ip_b] [gw_ip_b]\n", argv[0]);
         return 1;
     }
+    /* Gateway on network B: by default its network A address in subnet 2 (ladder addressing) */
+    if (ownIpB != 0u && gatewayIpB == 0u)
+        gatewayIpB = gatewayIp | HMI_LADDER_SUBNET2;
+    g_gatewayIp = gatewayIp;
 
     /* --- Initialize shared state --- */
     std::memset(&g_doorStatus, 0, sizeof(g_doorStatus));
@@ -357,11 +917,29 @@ int main(int argc, char **argv)
     for (uint32_t i = 0; i < HMI_DOOR_COUNT; ++i)
         g_doorStatus.doors[i].door_state = DOOR_STATE_CLOSED;
 
+    /* --- RT mode: lock memory and keep every other thread off the TRDP CPU,
+           before any thread starts (threads inherit the affinity mask) --- */
+    if (rtCpu >= 0)
+    {
+        if (!rt_set_affinity(rtCpu, true))
+        {
+            std::cerr << "CPU " << rtCpu << " not available for the TRDP thread\n";
+            return 1;
+        }
+        if (std::thread::hardware_concurrency() < 2u)
+            std::cerr << "Single CPU, the TRDP thread shares it with the web threads\n";
+        const bool locked = rt_lock_memory();
+        if (!locked)
+            std::cerr << "mlockall failed, memory not locked\n";
+        g_rtLoop.configure(rtCpu, rtPrio, locked);
+    }
+
     /* --- Start TRDP thread --- */
-    std::thread trdpThread(trdp_thread_func, ownIp, gatewayIp, multicastA, multicastB);
+    std::thread trdpThread(trdp_thread_func, ownIp, gatewayIp, multicastA, multicastB, peerIp,
+                           ownIpB, gatewayIpB);
 
     /* --- Crow web server setup --- */
-    crow::SimpleApp app;
+    crow::App<RequestLatency> app;
 
     /* Serve main page */
     std::string indexHtml = load_web_file(webDir + "/index.html");
@@ -389,6 +967,8 @@ int main(int argc, char **argv)
         auto body = crow::json::load(req.body);
         if (!body || !body.has("speed"))
             return crow::response(400, "Missing speed");
+        if (!g_leader)
+            return crow::response(409, "{\"error\":\"Standby HMI, not in command\"}");
 
         uint32_t speed = static_cast<uint32_t>(body["speed"].i());
         {
@@ -406,6 +986,8 @@ int main(int argc, char **argv)
         auto body = crow::json::load(req.body);
         if (!body || !body.has("active"))
             return crow::response(400, "Missing active");
+        if (!g_leader)
+            return crow::response(409, "{\"error\":\"Standby HMI, not in command\"}");
 
         bool active = body["active"].b();
         {
@@ -428,6 +1010,8 @@ int main(int argc, char **argv)
     {
         if (doorId >= HMI_DOOR_COUNT)
             return crow::response(400, "Invalid door ID");
+        if (!g_leader)
+            return crow::response(409, "{\"error\":\"Standby HMI, not in command\"}");
 
         std::lock_guard<std::mutex> lk(g_mutex);
 
@@ -446,6 +1030,8 @@ int main(int argc, char **argv)
     {
         if (doorId >= HMI_DOOR_COUNT)
             return crow::response(400, "Invalid door ID");
+        if (!g_leader)
+            return crow::response(409, "{\"error\":\"Standby HMI, not in command\"}");
 
         std::lock_guard<std::mutex> lk(g_mutex);
 
@@ -458,6 +1044,49 @@ int main(int argc, char **argv)
         return crow::response(200, "{\"ok\":true}");
     });
 
+    /* GET /api/door/<id>/faults — fault log of one door via MD (async response) */
+    CROW_ROUTE(app, "/api/door/<uint>/faults")
+    ([](const crow::request &req, crow::response &res, uint32_t doorId)
+    {
+        if (doorId >= HMI_DOOR_COUNT)
+        {
+            res.code = 400;
+            res.end("Invalid door ID");
+            return;
+        }
+        if (!g_trdpReady)
+        {
+            res.code = 503;
+            res.end("{\"error\":\"TRDP not running\"}");
+            return;
+        }
+        start_fault_logs(req, res, doorId, doorId, false);
+    });
+
+    /* GET /api/faults — fault logs of all doors, requested concurrently (async response) */
+    CROW_ROUTE(app, "/api/faults")
+    ([](const crow::request &req, crow::response &res)
+    {
+        if (!g_trdpReady)
+        {
+            res.code = 503;
+            res.end("{\"error\":\"TRDP not running\"}");
+            return;
+        }
+        start_fault_logs(req, res, 0u, HMI_DOOR_COUNT - 1u, true);
+    });
+
+    /* GET /metrics — Prometheus text format, served from the TRDP statistics snapshot */
+    CROW_ROUTE(app, "/metrics")
+    ([]()
+    {
+        std::ostringstream paths;
+        g_doorMerge.render(paths);
+        crow::response resp(g_metrics.render() + paths.str());
+        resp.set_header("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+        return resp;
+    });
+
     printf("[WEB] Starting on port %u, serving from %s/\n", webPort, webDir.c_str());
     app.port(webPort).multithreaded().run();
 